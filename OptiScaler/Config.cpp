@@ -1,6 +1,7 @@
 #include "pch.h"
 
 #include "Config.h"
+#include "ConfigSchema.h"
 
 #include "Util.h"
 
@@ -22,24 +23,6 @@ static inline int64_t GetTicks()
     return ticks.QuadPart;
 }
 
-static inline bool isInteger(const std::string& str, int& value)
-{
-    std::istringstream iss(str);
-    return (iss >> value) && iss.eof();
-}
-
-static inline bool isUInt(const std::string& str, uint32_t& value)
-{
-    std::istringstream iss(str);
-    return (iss >> value) && iss.eof();
-}
-
-static inline bool isFloat(const std::string& str, float& value)
-{
-    std::istringstream iss(str);
-    return (iss >> value) && iss.eof();
-}
-
 Config::Config()
 {
     absoluteFileName = Util::DllPath().parent_path() / fileName;
@@ -56,18 +39,14 @@ bool Config::Reload(std::filesystem::path iniPath)
         State::Instance().nvngxIniDetected = exists(iniPath.parent_path() / "nvngx.ini");
         _log.clear();
 
-        // Upscalers
-        {
-            Dx11Upscaler.set_from_config(readString("Upscalers", "Dx11Upscaler", true));
-            Dx12Upscaler.set_from_config(readString("Upscalers", "Dx12Upscaler", true));
-            VulkanUpscaler.set_from_config(readString("Upscalers", "VulkanUpscaler", true));
-        }
+        // Values are passed as written, only options flagged ConfigOption_Lowercase are lowercased by the schema
+        ConfigSchema::Load(this,
+                           [this](const char* section, const char* key) { return readString(section, key, false); });
+
+        // Options with custom parsing or validation, everything else is in ConfigSchema
 
         // Frame Generation
         {
-            FGEnabled.set_from_config(readBool("FrameGen", "Enabled"));
-            FGDebugView.set_from_config(readBool("FrameGen", "DebugView"));
-
             if (auto FGInputString = readString("FrameGen", "FGInput"); FGInputString.has_value())
             {
                 if (lstrcmpiA(FGInputString.value().c_str(), "nofg") == 0)
@@ -99,504 +78,63 @@ bool Config::Reload(std::filesystem::path iniPath)
                 else if (lstrcmpiA(FGOutputString.value().c_str(), "xefg") == 0)
                     FGOutput.set_from_config(FGOutput::XeFG);
             }
-
-            FGDrawUIOverFG.set_from_config(readBool("FrameGen", "DrawUIOverFG"));
-            FGUIPremultipliedAlpha.set_from_config(readBool("FrameGen", "UIPremultipliedAlpha"));
-            FGDisableHudless.set_from_config(readBool("FrameGen", "DisableHudless"));
-            FGDisableUI.set_from_config(readBool("FrameGen", "DisableUI"));
-            FGSkipReset.set_from_config(readBool("FrameGen", "SkipReset"));
-            FGRectLeft.set_from_config(readInt("FrameGen", "RectLeft"));
-            FGRectTop.set_from_config(readInt("FrameGen", "RectTop"));
-            FGRectWidth.set_from_config(readInt("FrameGen", "RectWidth"));
-            FGRectHeight.set_from_config(readInt("FrameGen", "RectHeight"));
-
-            FGAllowedFrameAhead.set_from_config(readInt("FrameGen", "AllowedFrameAhead"));
-            if (FGAllowedFrameAhead.has_value() && (FGAllowedFrameAhead.value() < 1 || FGAllowedFrameAhead.value() > 3))
-                FGAllowedFrameAhead.reset();
-
-            FGDepthValidNow.set_from_config(readBool("FrameGen", "DepthValidNow"));
-            FGVelocityValidNow.set_from_config(readBool("FrameGen", "VelocityValidNow"));
-            FGHudlessValidNow.set_from_config(readBool("FrameGen", "HudlessValidNow"));
-            FGOnlyAcceptFirstHudless.set_from_config(readBool("FrameGen", "OnlyAcceptFirstHudless"));
-        }
-
-        // FSR FG
-        {
-            FGDebugTearLines.set_from_config(readBool("FSRFG", "DebugTearLines"));
-            FGDebugResetLines.set_from_config(readBool("FSRFG", "DebugResetLines"));
-            FGDebugPacingLines.set_from_config(readBool("FSRFG", "DebugPacingLines"));
-            FGAsync.set_from_config(readBool("FSRFG", "AllowAsync"));
-            FGUseMutexForSwapchain.set_from_config(readBool("FSRFG", "UseMutexForSwapchain"));
-            FGFramePacingTuning.set_from_config(readBool("FSRFG", "FramePacingTuning"));
-            FGFPTSafetyMarginInMs.set_from_config(readFloat("FSRFG", "FPTSafetyMarginInMs"));
-            FGFPTVarianceFactor.set_from_config(readFloat("FSRFG", "FPTVarianceFactor"));
-            FGFPTAllowHybridSpin.set_from_config(readBool("FSRFG", "FPTHybridSpin"));
-            FGFPTHybridSpinTime.set_from_config(readInt("FSRFG", "FPTHybridSpinTime"));
-            FGFPTAllowWaitForSingleObjectOnFence.set_from_config(readInt("FSRFG", "FPTWaitForSingleObjectOnFence"));
-            FSRFGEnableWatermark.set_from_config(readBool("FSRFG", "EnableWatermark"));
-        }
-
-        // OptiFG
-        {
-            FGHUDFix.set_from_config(readBool("OptiFG", "HUDFix"));
-            FGHUDLimit.set_from_config(readInt("OptiFG", "HUDLimit"));
-            FGHUDFixExtended.set_from_config(readBool("OptiFG", "HUDFixExtended"));
-            FGImmediateCapture.set_from_config(readBool("OptiFG", "HUDFixImmediate"));
-            FGUseShards.set_from_config(readBool("OptiFG", "UseShards"));
-            FGAlwaysTrackHeaps.set_from_config(readBool("OptiFG", "AlwaysTrackHeaps"));
-            FGResourceBlocking.set_from_config(readBool("OptiFG", "ResourceBlocking"));
-            FGMakeDepthCopy.set_from_config(readBool("OptiFG", "MakeDepthCopy"));
-            FGMakeMVCopy.set_from_config(readBool("OptiFG", "MakeMVCopy"));
-            FGHudfixDisableRTV.set_from_config(readBool("OptiFG", "HudfixDisableRTV"));
-            FGHudfixDisableSRV.set_from_config(readBool("OptiFG", "HudfixDisableSRV"));
-            FGHudfixDisableUAV.set_from_config(readBool("OptiFG", "HudfixDisableUAV"));
-            FGHudfixDisableOM.set_from_config(readBool("OptiFG", "HudfixDisableOM"));
-            FGHudfixDisableDispatch.set_from_config(readBool("OptiFG", "HudfixDisableDispatch"));
-            FGHudfixDisableDI.set_from_config(readBool("OptiFG", "HudfixDisableDI"));
-            FGHudfixDisableDII.set_from_config(readBool("OptiFG", "HudfixDisableDII"));
-            FGHudfixDisableSCR.set_from_config(readBool("OptiFG", "HudfixDisableSCR"));
-            FGHudfixDisableSGR.set_from_config(readBool("OptiFG", "HudfixDisableSGR"));
-
-            FGEnableDepthScale.set_from_config(readBool("OptiFG", "EnableDepthScale"));
-            FGDepthScaleMax.set_from_config(readFloat("OptiFG", "DepthScaleMax"));
-
-            FGDontUseSwapchainBuffers.set_from_config(readBool("OptiFG", "HUDFixDontUseSwapchainBuffers"));
-            FGRelaxedResolutionCheck.set_from_config(readBool("OptiFG", "HUDFixRelaxedResolutionCheck"));
-
-            FGResourceFlip.set_from_config(readBool("OptiFG", "ResourceFlip"));
-            FGResourceFlipOffset.set_from_config(readBool("OptiFG", "ResourceFlipOffset"));
-
-            FGAlwaysCaptureFSRFGSwapchain.set_from_config(readBool("OptiFG", "AlwaysCaptureFSRFGSwapchain"));
-        }
-
-        {
-            FGXeFGInterpolationCount.set_from_config(readInt("XeFG", "InterpolationCount"));
-            if (FGXeFGInterpolationCount.has_value() &&
-                (FGXeFGInterpolationCount.value() < 1 || FGXeFGInterpolationCount.value() > 3))
-                FGXeFGInterpolationCount.reset();
-            FGXeFGIgnoreInitChecks.set_from_config(readBool("XeFG", "IgnoreInitChecks"));
-            FGXeFGDepthInverted.set_from_config(readBool("XeFG", "DepthInverted"));
-            FGXeFGJitteredMV.set_from_config(readBool("XeFG", "JitteredMV"));
-            FGXeFGHighResMV.set_from_config(readBool("XeFG", "HighResMV"));
-            FGXeFGDebugView.set_from_config(readBool("XeFG", "DebugView"));
-            FGXeFGForceBorderless.set_from_config(readBool("XeFG", "ForceBorderless"));
-            FGXeFGSkipResizeBuffers.set_from_config(readBool("XeFG", "SkipResizeBuffers"));
-            FGXeFGModifyBufferState.set_from_config(readBool("XeFG", "ModifyBufferState"));
-            FGXeFGModifySCIndex.set_from_config(readBool("XeFG", "ModifySCIndex"));
-        }
-
-        // FSR FG Inputs
-        {
-            FSRFGSkipConfigForHudless.set_from_config(readBool("FSRFGInputs", "SkipConfigForHudless"));
-            FSRFGSkipDispatchForHudless.set_from_config(readBool("FSRFGInputs", "SkipDispatchForHudless"));
-        }
-
-        // Framerate
-        {
-            FramerateLimit.set_from_config(readFloat("Framerate", "FramerateLimit"));
-        }
-
-        // FSR Common
-        {
-            FsrVerticalFov.set_from_config(readFloat("FSR", "VerticalFov"));
-            FsrHorizontalFov.set_from_config(readFloat("FSR", "HorizontalFov"));
-            FsrCameraNear.set_from_config(readFloat("FSR", "CameraNear"));
-            FsrCameraFar.set_from_config(readFloat("FSR", "CameraFar"));
-            FsrUseFsrInputValues.set_from_config(readBool("FSR", "UseFsrInputValues"));
-
-            FfxDx12Path.set_from_config(readWString("FSR", "FfxDx12Path"));
-            FfxVkPath.set_from_config(readWString("FSR", "FfxVkPath"));
         }
 
         // FSR
         {
-            FsrVelocity.set_from_config(readFloat("FSR", "VelocityFactor"));
-            FsrReactiveScale.set_from_config(readFloat("FSR", "ReactiveScale"));
-            FsrShadingScale.set_from_config(readFloat("FSR", "ShadingScale"));
-            FsrAccAddPerFrame.set_from_config(readFloat("FSR", "AccAddPerFrame"));
-            FsrMinDisOccAcc.set_from_config(readFloat("FSR", "MinDisOccAcc"));
-            FsrDebugView.set_from_config(readBool("FSR", "DebugView"));
-            FfxUpscalerIndex.set_from_config(readInt("FSR", "UpscalerIndex"));
-            FfxFGIndex.set_from_config(readInt("FSR", "FGIndex"));
-            FsrUseMaskForTransparency.set_from_config(readBool("FSR", "UseReactiveMaskForTransparency"));
-            DlssReactiveMaskBias.set_from_config(readFloat("FSR", "DlssReactiveMaskBias"));
-            Fsr4Update.set_from_config(readBool("FSR", "Fsr4Update"));
-            Fsr4EnableDebugView.set_from_config(readBool("FSR", "Fsr4EnableDebugView"));
-            Fsr4EnableWatermark.set_from_config(readBool("FSR", "Fsr4EnableWatermark"));
-
-            if (auto setting = readInt("FSR", "Fsr4Model"); setting.has_value() && setting >= 0 && setting <= 5)
-                Fsr4Model.set_from_config(setting);
-
-            FsrNonLinearColorSpace.set_from_config(readBool("FSR", "FsrNonLinearColorSpace"));
-            FsrNonLinearPQ.set_from_config(readBool("FSR", "FsrNonLinearPQ"));
-            FsrNonLinearSRGB.set_from_config(readBool("FSR", "FsrNonLinearSRGB"));
-            FsrAgilitySDKUpgrade.set_from_config(readBool("FSR", "FsrAgilitySDKUpgrade"));
-
             // Only sRGB or PQ should be enabled
             if (FsrNonLinearPQ.has_value() && FsrNonLinearPQ.value())
                 FsrNonLinearSRGB.reset();
             else if (FsrNonLinearSRGB.has_value() && FsrNonLinearSRGB.value())
                 FsrNonLinearPQ.reset();
 
-            if (FsrNonLinearPQ.has_value() || FsrNonLinearPQ.has_value())
+            if (FsrNonLinearPQ.value_or_default() || FsrNonLinearSRGB.value_or_default())
                 FsrNonLinearColorSpace.set_volatile_value(true);
         }
 
-        // XeSS
-        {
-            BuildPipelines.set_from_config(readBool("XeSS", "BuildPipelines"));
-            NetworkModel.set_from_config(readInt("XeSS", "NetworkModel"));
-            CreateHeaps.set_from_config(readBool("XeSS", "CreateHeaps"));
-            XeSSLibrary.set_from_config(readWString("XeSS", "LibraryPath"));
-            XeSSDx11Library.set_from_config(readWString("XeSS", "Dx11LibraryPath"));
-        }
-
-        // DLSS
-        {
-            // Don't enable again if set false because of no nvngx found
-            DLSSEnabled.set_from_config(readBool("DLSS", "Enabled"));
-            NvngxPath.set_from_config(readWString("DLSS", "LibraryPath"));
-            DLSSFeaturePath.set_from_config(readWString("DLSS", "FeaturePath"));
-            NVNGX_DLSS_Library.set_from_config(readWString("DLSS", "NVNGX_DLSS_Path"));
-            UseGenericAppIdWithDlss.set_from_config(readBool("DLSS", "UseGenericAppIdWithDlss"));
-
-            RenderPresetOverride.set_from_config(readBool("DLSS", "RenderPresetOverride"));
-
-            constexpr size_t presetCount = 17;
-
-            if (auto setting = readInt("DLSS", "RenderPresetForAll");
-                setting.has_value() && setting >= 0 && (setting < presetCount || setting == 0x00FFFFFF))
-                RenderPresetForAll.set_from_config(setting);
-
-            if (auto setting = readInt("DLSS", "RenderPresetDLAA");
-                setting.has_value() && setting >= 0 && (setting < presetCount || setting == 0x00FFFFFF))
-                RenderPresetDLAA.set_from_config(setting);
-
-            if (auto setting = readInt("DLSS", "RenderPresetUltraQuality");
-                setting.has_value() && setting >= 0 && (setting < presetCount || setting == 0x00FFFFFF))
-                RenderPresetUltraQuality.set_from_config(setting);
-
-            if (auto setting = readInt("DLSS", "RenderPresetQuality");
-                setting.has_value() && setting >= 0 && (setting < presetCount || setting == 0x00FFFFFF))
-                RenderPresetQuality.set_from_config(setting);
-
-            if (auto setting = readInt("DLSS", "RenderPresetBalanced");
-                setting.has_value() && setting >= 0 && (setting < presetCount || setting == 0x00FFFFFF))
-                RenderPresetBalanced.set_from_config(setting);
-
-            if (auto setting = readInt("DLSS", "RenderPresetPerformance");
-                setting.has_value() && setting >= 0 && (setting < presetCount || setting == 0x00FFFFFF))
-                RenderPresetPerformance.set_from_config(setting);
-
-            if (auto setting = readInt("DLSS", "RenderPresetUltraPerformance");
-                setting.has_value() && setting >= 0 && (setting < presetCount || setting == 0x00FFFFFF))
-                RenderPresetUltraPerformance.set_from_config(setting);
-        }
-        // DLSSD
-        {
-            // Don't enable again if set false because of no nvngx found
-            DLSSDRenderPresetOverride.set_from_config(readBool("DLSSD", "RenderPresetOverride"));
-
-            constexpr size_t presetCount = 6;
-
-            if (auto setting = readInt("DLSSD", "RenderPresetForAll");
-                setting.has_value() && setting >= 0 && (setting < presetCount || setting == 0x00FFFFFF))
-                DLSSDRenderPresetForAll.set_from_config(setting);
-
-            if (auto setting = readInt("DLSSD", "RenderPresetDLAA");
-                setting.has_value() && setting >= 0 && (setting < presetCount || setting == 0x00FFFFFF))
-                DLSSDRenderPresetDLAA.set_from_config(setting);
-
-            if (auto setting = readInt("DLSSD", "RenderPresetUltraQuality");
-                setting.has_value() && setting >= 0 && (setting < presetCount || setting == 0x00FFFFFF))
-                DLSSDRenderPresetUltraQuality.set_from_config(setting);
-
-            if (auto setting = readInt("DLSSD", "RenderPresetQuality");
-                setting.has_value() && setting >= 0 && (setting < presetCount || setting == 0x00FFFFFF))
-                DLSSDRenderPresetQuality.set_from_config(setting);
-
-            if (auto setting = readInt("DLSSD", "RenderPresetBalanced");
-                setting.has_value() && setting >= 0 && (setting < presetCount || setting == 0x00FFFFFF))
-                DLSSDRenderPresetBalanced.set_from_config(setting);
-
-            if (auto setting = readInt("DLSSD", "RenderPresetPerformance");
-                setting.has_value() && setting >= 0 && (setting < presetCount || setting == 0x00FFFFFF))
-                DLSSDRenderPresetPerformance.set_from_config(setting);
-
-            if (auto setting = readInt("DLSSD", "RenderPresetUltraPerformance");
-                setting.has_value() && setting >= 0 && (setting < presetCount || setting == 0x00FFFFFF))
-                DLSSDRenderPresetUltraPerformance.set_from_config(setting);
-        }
-
-        // Nukems
-        {
-            MakeDepthCopy.set_from_config(readBool("Nukems", "MakeDepthCopy"));
-        }
-
         // Logging
         {
-            LogLevel.set_from_config(readInt("Log", "LogLevel"));
-            LogToConsole.set_from_config(readBool("Log", "LogToConsole"));
-            LogToDebug.set_from_config(readBool("Log", "LogToDebug"));
-            LogToFile.set_from_config(readBool("Log", "LogToFile"));
-            LogToNGX.set_from_config(readBool("Log", "LogToNGX"));
-            OpenConsole.set_from_config(readBool("Log", "OpenConsole"));
-            DebugWait.set_from_config(readBool("Log", "DebugWait"));
-            LogSingleFile.set_from_config(readBool("Log", "SingleFile"));
-            LogAsync.set_from_config(readBool("Log", "LogAsync"));
-            LogAsyncThreads.set_from_config(readInt("Log", "LogAsyncThreads"));
+            auto setting = readString("Log", "LogFile", false);
 
-            {
-                auto setting = readString("Log", "LogFile", false);
+            if (setting.has_value() && setting.value().empty())
+                setting = std::nullopt;
 
-                if (setting.has_value() && setting.value().empty())
-                    setting = std::nullopt;
+            auto path = std::filesystem::path(setting.value_or(wstring_to_string(LogFileName.value_or_default())));
+            auto filenameStem = path.stem();
 
-                auto path = std::filesystem::path(setting.value_or(wstring_to_string(LogFileName.value_or_default())));
-                auto filenameStem = path.stem();
+            auto filename =
+                std::filesystem::path(LogSingleFile.value_or_default()
+                                          ? filenameStem.wstring() + L".log"
+                                          : filenameStem.wstring() + L"_" + std::to_wstring(GetTicks()) + L".log");
 
-                auto filename =
-                    std::filesystem::path(LogSingleFile.value_or_default()
-                                              ? filenameStem.wstring() + L".log"
-                                              : filenameStem.wstring() + L"_" + std::to_wstring(GetTicks()) + L".log");
-
-                if (setting.has_value())
-                {
-                    if (path.has_root_path())
-                        LogFileName.set_from_config((path.parent_path() / filename).wstring());
-                    else
-                        LogFileName.set_from_config((Util::DllPath().parent_path() / filename).wstring());
-                }
+            if (setting.has_value())
+            {
+                if (path.has_root_path())
+                    LogFileName.set_from_config((path.parent_path() / filename).wstring());
                 else
-                {
-                    if (path.has_root_path())
-                        LogFileName.set_volatile_value((path.parent_path() / filename).wstring());
-                    else
-                        LogFileName.set_volatile_value((Util::DllPath().parent_path() / filename).wstring());
-                }
+                    LogFileName.set_from_config((Util::DllPath().parent_path() / filename).wstring());
+            }
+            else
+            {
+                if (path.has_root_path())
+                    LogFileName.set_volatile_value((path.parent_path() / filename).wstring());
+                else
+                    LogFileName.set_volatile_value((Util::DllPath().parent_path() / filename).wstring());
             }
-        }
-
-        // Sharpness
-        {
-            OverrideSharpness.set_from_config(readBool("Sharpness", "OverrideSharpness"));
-
-            if (auto setting = readFloat("Sharpness", "Sharpness"); setting.has_value())
-                Sharpness.set_from_config(std::clamp(setting.value(), 0.0f, 1.3f));
         }
 
         // Menu
         {
-            if (auto setting = readFloat("Menu", "Scale"); setting.has_value())
-                MenuScale.set_from_config(std::clamp(setting.value(), 0.5f, 2.0f));
-
-            // Don't enable again if set false because of Linux issue
-            OverlayMenu.set_from_config(readBool("Menu", "OverlayMenu"));
-            ShortcutKey.set_from_config(readInt("Menu", "ShortcutKey"));
-            ExtendedLimits.set_from_config(readBool("Menu", "ExtendedLimits"));
-            ShowFps.set_from_config(readBool("Menu", "ShowFps"));
-            UseHQFont.set_from_config(readBool("Menu", "UseHQFont"));
-            DisableSplash.set_from_config(readBool("Menu", "DisableSplash"));
-
-            if (auto setting = readInt("Menu", "FpsOverlayPos"); setting.has_value())
-                FpsOverlayPos.set_from_config(std::clamp(setting.value(), 0, 3));
-
             if (auto setting = readUInt("Menu", "FpsOverlayType"); setting.has_value())
             {
                 FpsOverlayType.set_from_config(
                     (FpsOverlay) std::clamp(setting.value(), (uint32_t) FpsOverlay_JustFPS, FpsOverlay_COUNT - 1));
             }
-
-            FpsShortcutKey.set_from_config(readInt("Menu", "FpsShortcutKey"));
-            FpsCycleShortcutKey.set_from_config(readInt("Menu", "FpsCycleShortcutKey"));
-            FpsOverlayHorizontal.set_from_config(readBool("Menu", "FpsOverlayHorizontal"));
-
-            if (auto setting = readFloat("Menu", "FpsOverlayAlpha"); setting.has_value())
-                FpsOverlayAlpha.set_from_config(std::clamp(setting.value(), 0.0f, 1.0f));
-
-            if (auto setting = readFloat("Menu", "FpsScale"); setting.has_value())
-                FpsScale.set_from_config(std::clamp(setting.value(), 0.5f, 2.0f));
-
-            TTFFontPath.set_from_config(readWString("Menu", "TTFFontPath"));
-
-            FGShortcutKey.set_from_config(readInt("Menu", "FGShortcutKey"));
-        }
-
-        // Hooks
-        {
-            HookOriginalNvngxOnly.set_from_config(readBool("Hooks", "HookOriginalNvngxOnly"));
-            EarlyHooking.set_from_config(readBool("Hooks", "EarlyHooking"));
-            UseNtdllHooks.set_from_config(readBool("Hooks", "UseNtdllHooks"));
-        }
-
-        // RCAS
-        {
-            RcasEnabled.set_from_config(readBool("CAS", "Enabled"));
-            MotionSharpnessEnabled.set_from_config(readBool("CAS", "MotionSharpnessEnabled"));
-            MotionSharpnessDebug.set_from_config(readBool("CAS", "MotionSharpnessDebug"));
-
-            if (auto setting = readFloat("CAS", "MotionSharpness"); setting.has_value())
-                MotionSharpness.set_from_config(std::clamp(setting.value(), -1.3f, 1.3f));
-
-            if (auto setting = readFloat("CAS", "MotionThreshold"); setting.has_value())
-                MotionThreshold.set_from_config(std::clamp(setting.value(), 0.0f, 100.0f));
-
-            if (auto setting = readFloat("CAS", "MotionScaleLimit"); setting.has_value())
-                MotionScaleLimit.set_from_config(std::clamp(setting.value(), 0.01f, 100.0f));
-
-            ContrastEnabled.set_from_config(readBool("CAS", "ContrastEnabled"));
-            if (auto setting = readFloat("CAS", "Contrast"); setting.has_value())
-                Contrast.set_from_config(std::clamp(setting.value(), -2.0f, 2.0f));
-        }
-
-        // Output Scaling
-        {
-            OutputScalingEnabled.set_from_config(readBool("OutputScaling", "Enabled"));
-            OutputScalingUseFsr.set_from_config(readBool("OutputScaling", "UseFsr"));
-            OutputScalingDownscaler.set_from_config(readInt("OutputScaling", "Downscaler"));
-
-            if (auto setting = readFloat("OutputScaling", "Multiplier"); setting.has_value())
-                OutputScalingMultiplier.set_from_config(std::clamp(setting.value(), 0.5f, 3.0f));
-        }
-
-        // Init Flags
-        {
-            AutoExposure.set_from_config(readBool("InitFlags", "AutoExposure"));
-            HDR.set_from_config(readBool("InitFlags", "HDR"));
-            DepthInverted.set_from_config(readBool("InitFlags", "DepthInverted"));
-            JitterCancellation.set_from_config(readBool("InitFlags", "JitterCancellation"));
-            DisplayResolution.set_from_config(readBool("InitFlags", "DisplayResolution"));
-            DisableReactiveMask.set_from_config(readBool("InitFlags", "DisableReactiveMask"));
-        }
-
-        // DRS
-        {
-            DrsMinOverrideEnabled.set_from_config(readBool("DRS", "DrsMinOverrideEnabled"));
-            DrsMaxOverrideEnabled.set_from_config(readBool("DRS", "DrsMaxOverrideEnabled"));
-        }
-
-        // Upscale Ratio Override
-        {
-            UpscaleRatioOverrideEnabled.set_from_config(readBool("UpscaleRatio", "UpscaleRatioOverrideEnabled"));
-            UpscaleRatioOverrideValue.set_from_config(readFloat("UpscaleRatio", "UpscaleRatioOverrideValue"));
-        }
-
-        // Quality Overrides
-        {
-            QualityRatioOverrideEnabled.set_from_config(readBool("QualityOverrides", "QualityRatioOverrideEnabled"));
-            QualityRatio_DLAA.set_from_config(readFloat("QualityOverrides", "QualityRatioDLAA"));
-            QualityRatio_UltraQuality.set_from_config(readFloat("QualityOverrides", "QualityRatioUltraQuality"));
-            QualityRatio_Quality.set_from_config(readFloat("QualityOverrides", "QualityRatioQuality"));
-            QualityRatio_Balanced.set_from_config(readFloat("QualityOverrides", "QualityRatioBalanced"));
-            QualityRatio_Performance.set_from_config(readFloat("QualityOverrides", "QualityRatioPerformance"));
-            QualityRatio_UltraPerformance.set_from_config(
-                readFloat("QualityOverrides", "QualityRatioUltraPerformance"));
-        }
-
-        // Anisotropy
-        {
-            if (auto setting = readInt("Anisotropy", "AnisotropyOverride");
-                setting.has_value() && setting.value() <= 16 && setting.value() >= 1)
-                AnisotropyOverride.set_from_config(setting);
-
-            if (AnisotropyOverride.has_value() && (AnisotropyOverride.value() > 16 || AnisotropyOverride.value() < 1))
-                AnisotropyOverride.reset();
-
-            AnisotropySkipPointFilter.set_from_config(readBool("Anisotropy", "SkipPointFilter"));
-            AnisotropyModifyComp.set_from_config(readBool("Anisotropy", "AFModifyComparison"));
-            AnisotropyModifyMinMax.set_from_config(readBool("Anisotropy", "AFModifyMinMax"));
-        }
-
-        // Mipmap
-        {
-            if (auto setting = readFloat("Mipmap", "MipmapBiasOverride");
-                setting.has_value() && setting.value() <= 15.0 && setting.value() >= -15.0)
-                MipmapBiasOverride.set_from_config(setting);
-
-            // Unsure if that's needed but it resets invalid MipmapBiasOverride on config reload
-            // Unexpected place for it but could be playing a role
-            if (MipmapBiasOverride.has_value() &&
-                (MipmapBiasOverride.value() > 15.0 || MipmapBiasOverride.value() < -15.0))
-                MipmapBiasOverride.reset();
-
-            MipmapBiasFixedOverride.set_from_config(readBool("Mipmap", "MipmapBiasFixedOverride"));
-            MipmapBiasScaleOverride.set_from_config(readBool("Mipmap", "MipmapBiasScaleOverride"));
-            MipmapBiasOverrideAll.set_from_config(readBool("Mipmap", "MipmapBiasOverrideAll"));
-        }
-
-        // Hotfixes
-        {
-            CheckForUpdate.set_from_config(readBool("Hotfix", "CheckForUpdate"));
-            DisableOverlays.set_from_config(readBool("Hotfix", "DisableOverlays"));
-
-            RoundInternalResolution.set_from_config(readInt("Hotfix", "RoundInternalResolution"));
-
-            RestoreComputeSignature.set_from_config(readBool("Hotfix", "RestoreComputeSignature"));
-            RestoreGraphicSignature.set_from_config(readBool("Hotfix", "RestoreGraphicSignature"));
-            PreferDedicatedGpu.set_from_config(readBool("Hotfix", "PreferDedicatedGpu"));
-            PreferFirstDedicatedGpu.set_from_config(readBool("Hotfix", "PreferFirstDedicatedGpu"));
-            SkipFirstFrames.set_from_config(readInt("Hotfix", "SkipFirstFrames"));
-            UsePrecompiledShaders.set_from_config(readBool("Hotfix", "UsePrecompiledShaders"));
-            ColorResourceBarrier.set_from_config(readInt("Hotfix", "ColorResourceBarrier"));
-            MVResourceBarrier.set_from_config(readInt("Hotfix", "MotionVectorResourceBarrier"));
-            DepthResourceBarrier.set_from_config(readInt("Hotfix", "DepthResourceBarrier"));
-            MaskResourceBarrier.set_from_config(readInt("Hotfix", "ColorMaskResourceBarrier"));
-            ExposureResourceBarrier.set_from_config(readInt("Hotfix", "ExposureResourceBarrier"));
-            OutputResourceBarrier.set_from_config(readInt("Hotfix", "OutputResourceBarrier"));
-            DontCreateD3D12DeviceForLuma.set_from_config(readBool("Hotfix", "DontCreateD3D12DeviceForLuma"));
-        }
-
-        // Dx11 with Dx12
-        {
-            Dx11DelayedInit.set_from_config(readInt("Dx11withDx12", "UseDelayedInit"));
-            DontUseNTShared.set_from_config(readBool("Dx11withDx12", "DontUseNTShared"));
-        }
-
-        // NvApi
-        {
-            OverrideNvapiDll.set_from_config(readBool("NvApi", "OverrideNvapiDll"));
-            NvapiDllPath.set_from_config(readWString("NvApi", "NvapiDllPath", true));
-            DisableFlipMetering.set_from_config(readBool("NvApi", "DisableFlipMetering"));
         }
 
         // Spoofing
         {
             DxgiSpoofing.set_from_config(readBool("Spoofing", "Dxgi"));
-            DxgiFactoryWrapping.set_from_config(readBool("Spoofing", "DxgiFactoryWrapping"));
-            DxgiBlacklist.set_from_config(readString("Spoofing", "DxgiBlacklist"));
-            DxgiVRAM.set_from_config(readInt("Spoofing", "DxgiVRAM"));
-            VulkanSpoofing.set_from_config(readBool("Spoofing", "Vulkan"));
-            VulkanExtensionSpoofing.set_from_config(readBool("Spoofing", "VulkanExtensionSpoofing"));
-            VulkanVRAM.set_from_config(readInt("Spoofing", "VulkanVRAM"));
-            SpoofedGPUName.set_from_config(readWString("Spoofing", "SpoofedGPUName"));
-            StreamlineSpoofing.set_from_config(readBool("Spoofing", "StreamlineSpoofing"));
-            SpoofHAGS.set_from_config(readBool("Spoofing", "SpoofHAGS"));
-            SpoofFeatureLevel.set_from_config(readBool("Spoofing", "D3DFeatureLevel"));
-            SpoofedVendorId.set_from_config(readUInt("Spoofing", "SpoofedVendorId"));
-            SpoofedDeviceId.set_from_config(readUInt("Spoofing", "SpoofedDeviceId"));
-            TargetVendorId.set_from_config(readUInt("Spoofing", "TargetVendorId"));
-            TargetDeviceId.set_from_config(readUInt("Spoofing", "TargetDeviceId"));
-            UESpoofIntelAtomics64.set_from_config(readBool("Spoofing", "UEIntelAtomics"));
-        }
-
-        // Inputs
-        {
-            EnableDlssInputs.set_from_config(readBool("Inputs", "EnableDlssInputs"));
-            EnableXeSSInputs.set_from_config(readBool("Inputs", "EnableXeSSInputs"));
-
-            EnableFsr2Inputs.set_from_config(readBool("Inputs", "EnableFsr2Inputs"));
-            UseFsr2Inputs.set_from_config(readBool("Inputs", "UseFsr2Inputs"));
-            UseFsr2Dx11Inputs.set_from_config(readBool("Inputs", "UseFsr2Dx11Inputs"));
-            UseFsr2VulkanInputs.set_from_config(readBool("Inputs", "UseFsr2VulkanInputs"));
-            Fsr2Pattern.set_from_config(readBool("Inputs", "Fsr2Pattern"));
-
-            EnableFsr3Inputs.set_from_config(readBool("Inputs", "EnableFsr3Inputs"));
-            UseFsr3Inputs.set_from_config(readBool("Inputs", "UseFsr3Inputs"));
-            Fsr3Pattern.set_from_config(readBool("Inputs", "Fsr3Pattern"));
-
-            EnableFfxInputs.set_from_config(readBool("Inputs", "EnableFfxInputs"));
-            UseFfxInputs.set_from_config(readBool("Inputs", "UseFfxInputs"));
-            EnableHotSwapping.set_from_config(readBool("Inputs", "EnableHotSwapping"));
         }
 
         // Plugins
@@ -623,24 +161,6 @@ bool Config::Reload(std::filesystem::path iniPath)
                 else
                     PluginPath.set_volatile_value((Util::DllPath().parent_path() / path).wstring());
             }
-
-            LoadSpecialK.set_from_config(readBool("Plugins", "LoadSpecialK"));
-            LoadReShade.set_from_config(readBool("Plugins", "LoadReShade"));
-            LoadAsiPlugins.set_from_config(readBool("Plugins", "LoadAsiPlugins"));
-        }
-
-        // HDR
-        {
-            ForceHDR.set_from_config(readBool("HDR", "ForceHDR"));
-            UseHDR10.set_from_config(readBool("HDR", "UseHDR10"));
-            SkipColorSpace.set_from_config(readBool("HDR", "SkipColorSpace"));
-        }
-
-        // V-Sync
-        {
-            OverrideVsync.set_from_config(readBool("V-Sync", "OverrideVsync"));
-            ForceVsync.set_from_config(readBool("V-Sync", "ForceVsync"));
-            VsyncInterval.set_from_config(readInt("V-Sync", "SyncInterval"));
         }
 
         if (fakenvapi::isUsingFakenvapi())
@@ -685,27 +205,13 @@ std::string GetIntValue(std::optional<int> value, bool getHex = false)
     return std::to_string(value.value());
 }
 
-std::string GetFloatValue(std::optional<float> value)
-{
-    if (!value.has_value())
-        return "auto";
-
-    return std::to_string(value.value());
-}
-
 bool Config::SaveIni()
 {
-    // Upscalers
-    {
-        ini.SetValue("Upscalers", "Dx11Upscaler", Instance()->Dx11Upscaler.value_for_config_or("auto").c_str());
-        ini.SetValue("Upscalers", "Dx12Upscaler", Instance()->Dx12Upscaler.value_for_config_or("auto").c_str());
-        ini.SetValue("Upscalers", "VulkanUpscaler", Instance()->VulkanUpscaler.value_for_config_or("auto").c_str());
-    }
+    ConfigSchema::Save(Instance(), [](const char* section, const char* key, const std::string& value)
+                       { ini.SetValue(section, key, value.c_str()); });
 
     // Frame Generation
     {
-        ini.SetValue("FrameGen", "Enabled", GetBoolValue(Instance()->FGEnabled.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "DebugView", GetBoolValue(Instance()->FGDebugView.value_for_config()).c_str());
         std::string FGInputString = "auto";
         if (auto FGInputHeld = Instance()->FGInput.value_for_config(); FGInputHeld.has_value())
         {
@@ -737,458 +243,16 @@ bool Config::SaveIni()
                 FGOutputString = "XeFG";
         }
         ini.SetValue("FrameGen", "FGOutput", FGOutputString.c_str());
-        ini.SetValue("FrameGen", "DrawUIOverFG", GetBoolValue(Instance()->FGDrawUIOverFG.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "UIPremultipliedAlpha",
-                     GetBoolValue(Instance()->FGUIPremultipliedAlpha.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "DisableHudless",
-                     GetBoolValue(Instance()->FGDisableHudless.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "DisableUI", GetBoolValue(Instance()->FGDisableUI.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "SkipReset", GetBoolValue(Instance()->FGSkipReset.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "RectLeft", GetIntValue(Instance()->FGRectLeft.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "RectTop", GetIntValue(Instance()->FGRectTop.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "RectWidth", GetIntValue(Instance()->FGRectWidth.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "RectHeight", GetIntValue(Instance()->FGRectHeight.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "AllowedFrameAhead",
-                     GetIntValue(Instance()->FGAllowedFrameAhead.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "DepthValidNow", GetBoolValue(Instance()->FGDepthValidNow.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "VelocityValidNow",
-                     GetBoolValue(Instance()->FGVelocityValidNow.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "HudlessValidNow",
-                     GetBoolValue(Instance()->FGHudlessValidNow.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "OnlyAcceptFirstHudless",
-                     GetBoolValue(Instance()->FGOnlyAcceptFirstHudless.value_for_config()).c_str());
-    }
-
-    // FSR FG output
-    {
-        ini.SetValue("FSRFG", "DebugTearLines", GetBoolValue(Instance()->FGDebugTearLines.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "DebugResetLines",
-                     GetBoolValue(Instance()->FGDebugResetLines.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "DebugPacingLines",
-                     GetBoolValue(Instance()->FGDebugPacingLines.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "AllowAsync", GetBoolValue(Instance()->FGAsync.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "UseMutexForSwapchain",
-                     GetBoolValue(Instance()->FGUseMutexForSwapchain.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "FramePacingTuning",
-                     GetBoolValue(Instance()->FGFramePacingTuning.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "FPTSafetyMarginInMs",
-                     GetFloatValue(Instance()->FGFPTSafetyMarginInMs.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "FPTVarianceFactor",
-                     GetFloatValue(Instance()->FGFPTVarianceFactor.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "FPTHybridSpin",
-                     GetBoolValue(Instance()->FGFPTAllowHybridSpin.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "FPTHybridSpinTime",
-                     GetIntValue(Instance()->FGFPTHybridSpinTime.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "FPTWaitForSingleObjectOnFence",
-                     GetBoolValue(Instance()->FGFPTAllowWaitForSingleObjectOnFence.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "EnableWatermark",
-                     GetBoolValue(Instance()->FSRFGEnableWatermark.value_for_config()).c_str());
-    }
-
-    // XeFG output
-    {
-        ini.SetValue("XeFG", "InterpolationCount",
-                     GetIntValue(Instance()->FGXeFGInterpolationCount.value_for_config()).c_str());
-        ini.SetValue("XeFG", "IgnoreInitChecks",
-                     GetBoolValue(Instance()->FGXeFGIgnoreInitChecks.value_for_config()).c_str());
-        ini.SetValue("XeFG", "DepthInverted", GetBoolValue(Instance()->FGXeFGDepthInverted.value_for_config()).c_str());
-        ini.SetValue("XeFG", "JitteredMV", GetBoolValue(Instance()->FGXeFGJitteredMV.value_for_config()).c_str());
-        ini.SetValue("XeFG", "HighResMV", GetBoolValue(Instance()->FGXeFGHighResMV.value_for_config()).c_str());
-        ini.SetValue("XeFG", "DebugView", GetBoolValue(Instance()->FGXeFGDebugView.value_for_config()).c_str());
-        ini.SetValue("XeFG", "ForceBorderless",
-                     GetBoolValue(Instance()->FGXeFGForceBorderless.value_for_config()).c_str());
-        ini.SetValue("XeFG", "SkipResizeBuffers",
-                     GetBoolValue(Instance()->FGXeFGSkipResizeBuffers.value_for_config()).c_str());
-        ini.SetValue("XeFG", "ModifyBufferState",
-                     GetBoolValue(Instance()->FGXeFGModifyBufferState.value_for_config()).c_str());
-        ini.SetValue("XeFG", "ModifySCIndex", GetBoolValue(Instance()->FGXeFGModifySCIndex.value_for_config()).c_str());
-    }
-
-    // OptiFG
-    {
-        ini.SetValue("OptiFG", "HUDFix", GetBoolValue(Instance()->FGHUDFix.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HUDLimit", GetIntValue(Instance()->FGHUDLimit.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HUDFixExtended", GetBoolValue(Instance()->FGHUDFixExtended.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HUDFixImmediate",
-                     GetBoolValue(Instance()->FGImmediateCapture.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "UseShards", GetBoolValue(Instance()->FGUseShards.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "AlwaysTrackHeaps",
-                     GetBoolValue(Instance()->FGAlwaysTrackHeaps.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "ResourceBlocking",
-                     GetBoolValue(Instance()->FGResourceBlocking.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "MakeDepthCopy", GetBoolValue(Instance()->FGMakeDepthCopy.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "MakeMVCopy", GetBoolValue(Instance()->FGMakeMVCopy.value_for_config()).c_str());
-
-        ini.SetValue("OptiFG", "HudfixDisableRTV",
-                     GetBoolValue(Instance()->FGHudfixDisableRTV.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HudfixDisableSRV",
-                     GetBoolValue(Instance()->FGHudfixDisableSRV.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HudfixDisableUAV",
-                     GetBoolValue(Instance()->FGHudfixDisableUAV.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HudfixDisableOM",
-                     GetBoolValue(Instance()->FGHudfixDisableOM.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HudfixDisableDispatch",
-                     GetBoolValue(Instance()->FGHudfixDisableDispatch.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HudfixDisableDI",
-                     GetBoolValue(Instance()->FGHudfixDisableDI.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HudfixDisableDII",
-                     GetBoolValue(Instance()->FGHudfixDisableDII.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HudfixDisableSCR",
-                     GetBoolValue(Instance()->FGHudfixDisableSCR.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HudfixDisableSGR",
-                     GetBoolValue(Instance()->FGHudfixDisableSGR.value_for_config()).c_str());
-
-        ini.SetValue("OptiFG", "EnableDepthScale",
-                     GetBoolValue(Instance()->FGEnableDepthScale.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "DepthScaleMax", GetFloatValue(Instance()->FGDepthScaleMax.value_for_config()).c_str());
-
-        ini.SetValue("OptiFG", "HUDFixDontUseSwapchainBuffers",
-                     GetBoolValue(Instance()->FGDontUseSwapchainBuffers.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HUDFixRelaxedResolutionCheck",
-                     GetBoolValue(Instance()->FGRelaxedResolutionCheck.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "ResourceFlip", GetBoolValue(Instance()->FGResourceFlip.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "ResourceFlipOffset",
-                     GetBoolValue(Instance()->FGResourceFlipOffset.value_for_config()).c_str());
-
-        ini.SetValue("OptiFG", "AlwaysCaptureFSRFGSwapchain",
-                     GetBoolValue(Instance()->FGAlwaysCaptureFSRFGSwapchain.value_for_config()).c_str());
-    }
-
-    // FSR FG Inputs
-    {
-        ini.SetValue("FSRFGInputs", "SkipConfigForHudless",
-                     GetBoolValue(Instance()->FSRFGSkipConfigForHudless.value_for_config()).c_str());
-        ini.SetValue("FSRFGInputs", "SkipDispatchForHudless",
-                     GetBoolValue(Instance()->FSRFGSkipDispatchForHudless.value_for_config()).c_str());
-    }
-
-    // Framerate
-    {
-        ini.SetValue("Framerate", "FramerateLimit",
-                     GetFloatValue(Instance()->FramerateLimit.value_for_config()).c_str());
-    }
-
-    // Output Scaling
-    {
-        ini.SetValue("OutputScaling", "Enabled",
-                     GetBoolValue(Instance()->OutputScalingEnabled.value_for_config()).c_str());
-        ini.SetValue("OutputScaling", "Multiplier",
-                     GetFloatValue(Instance()->OutputScalingMultiplier.value_for_config()).c_str());
-        ini.SetValue("OutputScaling", "UseFsr",
-                     GetBoolValue(Instance()->OutputScalingUseFsr.value_for_config()).c_str());
-        ini.SetValue("OutputScaling", "Downscaler", GetIntValue(Instance()->OutputScalingDownscaler).c_str());
-    }
-
-    // FSR common
-    {
-        ini.SetValue("FSR", "VerticalFov", GetFloatValue(Instance()->FsrVerticalFov.value_for_config()).c_str());
-        ini.SetValue("FSR", "HorizontalFov", GetFloatValue(Instance()->FsrHorizontalFov.value_for_config()).c_str());
-        ini.SetValue("FSR", "CameraNear", GetFloatValue(Instance()->FsrCameraNear.value_for_config()).c_str());
-        ini.SetValue("FSR", "CameraFar", GetFloatValue(Instance()->FsrCameraFar.value_for_config()).c_str());
-        ini.SetValue("FSR", "UseFsrInputValues",
-                     GetBoolValue(Instance()->FsrUseFsrInputValues.value_for_config()).c_str());
-
-        ini.SetValue("FSR", "FfxDx12Path",
-                     wstring_to_string(Instance()->FfxDx12Path.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("FSR", "FfxVkPath", wstring_to_string(Instance()->FfxVkPath.value_for_config_or(L"auto")).c_str());
-    }
-
-    // FSR
-    {
-        ini.SetValue("FSR", "VelocityFactor", GetFloatValue(Instance()->FsrVelocity.value_for_config()).c_str());
-        ini.SetValue("FSR", "ReactiveScale", GetFloatValue(Instance()->FsrReactiveScale.value_for_config()).c_str());
-        ini.SetValue("FSR", "ShadingScale", GetFloatValue(Instance()->FsrShadingScale.value_for_config()).c_str());
-        ini.SetValue("FSR", "AccAddPerFrame", GetFloatValue(Instance()->FsrAccAddPerFrame.value_for_config()).c_str());
-        ini.SetValue("FSR", "MinDisOccAcc", GetFloatValue(Instance()->FsrMinDisOccAcc.value_for_config()).c_str());
-        ini.SetValue("FSR", "DebugView", GetBoolValue(Instance()->FsrDebugView.value_for_config()).c_str());
-        ini.SetValue("FSR", "UpscalerIndex", GetIntValue(Instance()->FfxUpscalerIndex.value_for_config()).c_str());
-        ini.SetValue("FSR", "FGIndex", GetIntValue(Instance()->FfxFGIndex.value_for_config()).c_str());
-        ini.SetValue("FSR", "UseReactiveMaskForTransparency",
-                     GetBoolValue(Instance()->FsrUseMaskForTransparency.value_for_config()).c_str());
-        ini.SetValue("FSR", "DlssReactiveMaskBias",
-                     GetFloatValue(Instance()->DlssReactiveMaskBias.value_for_config()).c_str());
-        ini.SetValue("FSR", "Fsr4Update",
-                     GetBoolValue(Instance()->Fsr4Update.value_for_config_ignore_default()).c_str());
-        ini.SetValue("FSR", "Fsr4Model", GetIntValue(Instance()->Fsr4Model.value_for_config()).c_str());
-        ini.SetValue("FSR", "Fsr4EnableDebugView",
-                     GetBoolValue(Instance()->Fsr4EnableDebugView.value_for_config()).c_str());
-        ini.SetValue("FSR", "Fsr4EnableWatermark",
-                     GetBoolValue(Instance()->Fsr4EnableWatermark.value_for_config()).c_str());
-        ini.SetValue("FSR", "FsrNonLinearColorSpace",
-                     GetBoolValue(Instance()->FsrNonLinearColorSpace.value_for_config()).c_str());
-        ini.SetValue("FSR", "FsrNonLinearPQ", GetBoolValue(Instance()->FsrNonLinearPQ.value_for_config()).c_str());
-        ini.SetValue("FSR", "FsrNonLinearSRGB", GetBoolValue(Instance()->FsrNonLinearSRGB.value_for_config()).c_str());
-        ini.SetValue("FSR", "FsrAgilitySDKUpgrade",
-                     GetBoolValue(Instance()->FsrAgilitySDKUpgrade.value_for_config()).c_str());
-    }
-
-    // XeSS
-    {
-        ini.SetValue("XeSS", "BuildPipelines", GetBoolValue(Instance()->BuildPipelines.value_for_config()).c_str());
-        ini.SetValue("XeSS", "CreateHeaps", GetBoolValue(Instance()->CreateHeaps.value_for_config()).c_str());
-        ini.SetValue("XeSS", "NetworkModel", GetIntValue(Instance()->NetworkModel.value_for_config()).c_str());
-        ini.SetValue("XeSS", "LibraryPath",
-                     wstring_to_string(Instance()->XeSSLibrary.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("XeSS", "Dx11LibraryPath",
-                     wstring_to_string(Instance()->XeSSDx11Library.value_for_config_or(L"auto")).c_str());
-    }
-
-    // DLSS
-    {
-        ini.SetValue("DLSS", "Enabled", GetBoolValue(Instance()->DLSSEnabled.value_for_config()).c_str());
-        ini.SetValue("DLSS", "LibraryPath",
-                     wstring_to_string(Instance()->NvngxPath.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("DLSS", "FeaturePath",
-                     wstring_to_string(Instance()->DLSSFeaturePath.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("DLSS", "NVNGX_DLSS_Path",
-                     wstring_to_string(Instance()->NVNGX_DLSS_Library.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("DLSS", "RenderPresetOverride",
-                     GetBoolValue(Instance()->RenderPresetOverride.value_for_config()).c_str());
-        ini.SetValue("DLSS", "RenderPresetForAll",
-                     GetIntValue(Instance()->RenderPresetForAll.value_for_config()).c_str());
-        ini.SetValue("DLSS", "RenderPresetDLAA", GetIntValue(Instance()->RenderPresetDLAA.value_for_config()).c_str());
-        ini.SetValue("DLSS", "RenderPresetUltraQuality",
-                     GetIntValue(Instance()->RenderPresetUltraQuality.value_for_config()).c_str());
-        ini.SetValue("DLSS", "RenderPresetQuality",
-                     GetIntValue(Instance()->RenderPresetQuality.value_for_config()).c_str());
-        ini.SetValue("DLSS", "RenderPresetBalanced",
-                     GetIntValue(Instance()->RenderPresetBalanced.value_for_config()).c_str());
-        ini.SetValue("DLSS", "RenderPresetPerformance",
-                     GetIntValue(Instance()->RenderPresetPerformance.value_for_config()).c_str());
-        ini.SetValue("DLSS", "RenderPresetUltraPerformance",
-                     GetIntValue(Instance()->RenderPresetUltraPerformance.value_for_config()).c_str());
-        ini.SetValue("DLSS", "UseGenericAppIdWithDlss",
-                     GetBoolValue(Instance()->UseGenericAppIdWithDlss.value_for_config()).c_str());
-    }
-
-    // DLSSD
-    {
-        ini.SetValue("DLSSD", "RenderPresetOverride",
-                     GetBoolValue(Instance()->DLSSDRenderPresetOverride.value_for_config()).c_str());
-        ini.SetValue("DLSSD", "RenderPresetForAll",
-                     GetIntValue(Instance()->DLSSDRenderPresetForAll.value_for_config()).c_str());
-        ini.SetValue("DLSSD", "RenderPresetDLAA",
-                     GetIntValue(Instance()->DLSSDRenderPresetDLAA.value_for_config()).c_str());
-        ini.SetValue("DLSSD", "RenderPresetUltraQuality",
-                     GetIntValue(Instance()->DLSSDRenderPresetUltraQuality.value_for_config()).c_str());
-        ini.SetValue("DLSSD", "RenderPresetQuality",
-                     GetIntValue(Instance()->DLSSDRenderPresetQuality.value_for_config()).c_str());
-        ini.SetValue("DLSSD", "RenderPresetBalanced",
-                     GetIntValue(Instance()->DLSSDRenderPresetBalanced.value_for_config()).c_str());
-        ini.SetValue("DLSSD", "RenderPresetPerformance",
-                     GetIntValue(Instance()->DLSSDRenderPresetPerformance.value_for_config()).c_str());
-        ini.SetValue("DLSSD", "RenderPresetUltraPerformance",
-                     GetIntValue(Instance()->DLSSDRenderPresetUltraPerformance.value_for_config()).c_str());
-    }
-
-    // Nukems
-    {
-        ini.SetValue("Nukems", "MakeDepthCopy", GetBoolValue(Instance()->MakeDepthCopy.value_for_config()).c_str());
-    }
-
-    // Sharpness
-    {
-        ini.SetValue("Sharpness", "OverrideSharpness",
-                     GetBoolValue(Instance()->OverrideSharpness.value_for_config()).c_str());
-        ini.SetValue("Sharpness", "Sharpness", GetFloatValue(Instance()->Sharpness.value_for_config()).c_str());
     }
 
     // Menu
     {
-        ini.SetValue("Menu", "Scale", GetFloatValue(Instance()->MenuScale.value_for_config(true)).c_str());
-        ini.SetValue("Menu", "OverlayMenu", GetBoolValue(Instance()->OverlayMenu.value_for_config()).c_str());
-
-        auto setting = Instance()->ShortcutKey.value_for_config();
-        ini.SetValue("Menu", "ShortcutKey",
-                     GetIntValue(Instance()->ShortcutKey.value_for_config(), setting > 0).c_str());
-
-        ini.SetValue("Menu", "ExtendedLimits", GetBoolValue(Instance()->ExtendedLimits.value_for_config()).c_str());
-        ini.SetValue("Menu", "ShowFps", GetBoolValue(Instance()->ShowFps.value_for_config()).c_str());
-        ini.SetValue("Menu", "UseHQFont", GetBoolValue(Instance()->UseHQFont.value_for_config()).c_str());
-        ini.SetValue("Menu", "DisableSplash", GetBoolValue(Instance()->DisableSplash.value_for_config()).c_str());
-
-        setting = Instance()->FGShortcutKey.value_for_config();
-        ini.SetValue("Menu", "FGShortcutKey",
-                     GetIntValue(Instance()->FGShortcutKey.value_for_config(), setting > 0).c_str());
-
-        setting = Instance()->FpsShortcutKey.value_for_config();
-        ini.SetValue("Menu", "FpsShortcutKey",
-                     GetIntValue(Instance()->FpsShortcutKey.value_for_config(), setting > 0).c_str());
-
-        setting = Instance()->FpsCycleShortcutKey.value_for_config();
-        ini.SetValue("Menu", "FpsCycleShortcutKey",
-                     GetIntValue(Instance()->FpsCycleShortcutKey.value_for_config(), setting > 0).c_str());
-
-        ini.SetValue("Menu", "FpsOverlayPos", GetIntValue(Instance()->FpsOverlayPos.value_for_config()).c_str());
         ini.SetValue("Menu", "FpsOverlayType", GetIntValue(Instance()->FpsOverlayType.value_for_config()).c_str());
-        ini.SetValue("Menu", "FpsOverlayHorizontal",
-                     GetBoolValue(Instance()->FpsOverlayHorizontal.value_for_config()).c_str());
-        ini.SetValue("Menu", "FpsOverlayAlpha", GetFloatValue(Instance()->FpsOverlayAlpha.value_for_config()).c_str());
-        ini.SetValue("Menu", "FpsScale", GetFloatValue(Instance()->FpsScale.value_for_config()).c_str());
-        ini.SetValue("Menu", "TTFFontPath",
-                     wstring_to_string(Instance()->TTFFontPath.value_for_config_or(L"auto")).c_str());
-    }
-
-    // Hooks
-    {
-        ini.SetValue("Hooks", "HookOriginalNvngxOnly",
-                     GetBoolValue(Instance()->HookOriginalNvngxOnly.value_for_config()).c_str());
-        ini.SetValue("Hooks", "EarlyHooking", GetBoolValue(Instance()->EarlyHooking.value_for_config()).c_str());
-        ini.SetValue("Hooks", "UseNtdllHooks", GetBoolValue(Instance()->UseNtdllHooks.value_for_config()).c_str());
-    }
-
-    // CAS
-    {
-        ini.SetValue("CAS", "Enabled",
-                     Instance()->RcasEnabled.has_value() ? (Instance()->RcasEnabled.value() ? "true" : "false")
-                                                         : "auto");
-        ini.SetValue("CAS", "MotionSharpnessEnabled",
-                     GetBoolValue(Instance()->MotionSharpnessEnabled.value_for_config()).c_str());
-        ini.SetValue("CAS", "MotionSharpnessDebug",
-                     GetBoolValue(Instance()->MotionSharpnessDebug.value_for_config()).c_str());
-        ini.SetValue("CAS", "MotionSharpness", GetFloatValue(Instance()->MotionSharpness.value_for_config()).c_str());
-        ini.SetValue("CAS", "MotionThreshold", GetFloatValue(Instance()->MotionThreshold.value_for_config()).c_str());
-        ini.SetValue("CAS", "MotionScaleLimit", GetFloatValue(Instance()->MotionScaleLimit.value_for_config()).c_str());
-        ini.SetValue("CAS", "ContrastEnabled", GetBoolValue(Instance()->ContrastEnabled.value_for_config()).c_str());
-        ini.SetValue("CAS", "Contrast", GetFloatValue(Instance()->Contrast.value_for_config()).c_str());
-    }
-
-    // InitFlags
-    {
-        ini.SetValue("InitFlags", "AutoExposure", GetBoolValue(Instance()->AutoExposure.value_for_config()).c_str());
-        ini.SetValue("InitFlags", "HDR", GetBoolValue(Instance()->HDR.value_for_config()).c_str());
-        ini.SetValue("InitFlags", "DepthInverted", GetBoolValue(Instance()->DepthInverted.value_for_config()).c_str());
-        ini.SetValue("InitFlags", "JitterCancellation",
-                     GetBoolValue(Instance()->JitterCancellation.value_for_config()).c_str());
-        ini.SetValue("InitFlags", "DisplayResolution",
-                     GetBoolValue(Instance()->DisplayResolution.value_for_config()).c_str());
-        ini.SetValue("InitFlags", "DisableReactiveMask",
-                     GetBoolValue(Instance()->DisableReactiveMask.value_for_config()).c_str());
-    }
-
-    // Upscale Ratio Override
-    {
-        ini.SetValue("UpscaleRatio", "UpscaleRatioOverrideEnabled",
-                     GetBoolValue(Instance()->UpscaleRatioOverrideEnabled.value_for_config()).c_str());
-        ini.SetValue("UpscaleRatio", "UpscaleRatioOverrideValue",
-                     GetFloatValue(Instance()->UpscaleRatioOverrideValue.value_for_config()).c_str());
-    }
-
-    // Quality Overrides
-    {
-        ini.SetValue("QualityOverrides", "QualityRatioOverrideEnabled",
-                     GetBoolValue(Instance()->QualityRatioOverrideEnabled.value_for_config()).c_str());
-        ini.SetValue("QualityOverrides", "QualityRatioDLAA",
-                     GetFloatValue(Instance()->QualityRatio_DLAA.value_for_config()).c_str());
-        ini.SetValue("QualityOverrides", "QualityRatioUltraQuality",
-                     GetFloatValue(Instance()->QualityRatio_UltraQuality.value_for_config()).c_str());
-        ini.SetValue("QualityOverrides", "QualityRatioQuality",
-                     GetFloatValue(Instance()->QualityRatio_Quality.value_for_config()).c_str());
-        ini.SetValue("QualityOverrides", "QualityRatioBalanced",
-                     GetFloatValue(Instance()->QualityRatio_Balanced.value_for_config()).c_str());
-        ini.SetValue("QualityOverrides", "QualityRatioPerformance",
-                     GetFloatValue(Instance()->QualityRatio_Performance.value_for_config()).c_str());
-        ini.SetValue("QualityOverrides", "QualityRatioUltraPerformance",
-                     GetFloatValue(Instance()->QualityRatio_UltraPerformance.value_for_config()).c_str());
-    }
-
-    // Anisotropy
-    {
-        ini.SetValue("Anisotropy", "AnisotropyOverride",
-                     GetIntValue(Instance()->AnisotropyOverride.value_for_config()).c_str());
-        ini.SetValue("Anisotropy", "ModifyComparison",
-                     GetBoolValue(Instance()->AnisotropyModifyComp.value_for_config()).c_str());
-        ini.SetValue("Anisotropy", "ModifyMinMax",
-                     GetBoolValue(Instance()->AnisotropyModifyMinMax.value_for_config()).c_str());
-        ini.SetValue("Anisotropy", "SkipPointFilter",
-                     GetBoolValue(Instance()->AnisotropySkipPointFilter.value_for_config()).c_str());
-    }
-
-    // Mipmap
-    {
-        ini.SetValue("Mipmap", "MipmapBiasOverride",
-                     GetFloatValue(Instance()->MipmapBiasOverride.value_for_config()).c_str());
-        ini.SetValue("Mipmap", "MipmapBiasOverrideAll",
-                     GetBoolValue(Instance()->MipmapBiasOverrideAll.value_for_config()).c_str());
-        ini.SetValue("Mipmap", "MipmapBiasFixedOverride",
-                     GetBoolValue(Instance()->MipmapBiasFixedOverride.value_for_config()).c_str());
-        ini.SetValue("Mipmap", "MipmapBiasScaleOverride",
-                     GetBoolValue(Instance()->MipmapBiasScaleOverride.value_for_config()).c_str());
-    }
-
-    // Hotfixes
-    {
-        ini.SetValue("Hotfix", "DontCreateD3D12DeviceForLuma",
-                     GetBoolValue(Instance()->DontCreateD3D12DeviceForLuma.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "CheckForUpdate", GetBoolValue(Instance()->CheckForUpdate.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "DisableOverlays", GetBoolValue(Instance()->DisableOverlays.value_for_config()).c_str());
-
-        ini.SetValue("Hotfix", "RoundInternalResolution",
-                     GetIntValue(Instance()->RoundInternalResolution.value_for_config()).c_str());
-
-        ini.SetValue("Hotfix", "RestoreComputeSignature",
-                     GetBoolValue(Instance()->RestoreComputeSignature.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "RestoreGraphicSignature",
-                     GetBoolValue(Instance()->RestoreGraphicSignature.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "SkipFirstFrames", GetIntValue(Instance()->SkipFirstFrames.value_for_config()).c_str());
-
-        ini.SetValue("Hotfix", "UsePrecompiledShaders",
-                     GetBoolValue(Instance()->UsePrecompiledShaders.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "PreferDedicatedGpu",
-                     GetBoolValue(Instance()->PreferDedicatedGpu.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "PreferFirstDedicatedGpu",
-                     GetBoolValue(Instance()->PreferFirstDedicatedGpu.value_for_config()).c_str());
-
-        ini.SetValue("Hotfix", "ColorResourceBarrier",
-                     GetIntValue(Instance()->ColorResourceBarrier.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "MotionVectorResourceBarrier",
-                     GetIntValue(Instance()->MVResourceBarrier.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "DepthResourceBarrier",
-                     GetIntValue(Instance()->DepthResourceBarrier.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "ColorMaskResourceBarrier",
-                     GetIntValue(Instance()->MaskResourceBarrier.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "ExposureResourceBarrier",
-                     GetIntValue(Instance()->ExposureResourceBarrier.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "OutputResourceBarrier",
-                     GetIntValue(Instance()->OutputResourceBarrier.value_for_config()).c_str());
-    }
-
-    // Dx11 with Dx12
-    {
-        ini.SetValue("Dx11withDx12", "DontUseNTShared",
-                     GetBoolValue(Instance()->DontUseNTShared.value_for_config()).c_str());
     }
 
     // Logging
     {
-        ini.SetValue("Log", "LogLevel", GetIntValue(Instance()->LogLevel.value_for_config()).c_str());
-        ini.SetValue("Log", "LogToConsole", GetBoolValue(Instance()->LogToConsole.value_for_config()).c_str());
-        ini.SetValue("Log", "LogToDebug", GetBoolValue(Instance()->LogToDebug.value_for_config()).c_str());
-        ini.SetValue("Log", "LogToFile", GetBoolValue(Instance()->LogToFile.value_for_config()).c_str());
-        ini.SetValue("Log", "LogToNGX", GetBoolValue(Instance()->LogToNGX.value_for_config()).c_str());
-        ini.SetValue("Log", "OpenConsole", GetBoolValue(Instance()->OpenConsole.value_for_config()).c_str());
         ini.SetValue("Log", "LogFile", wstring_to_string(Instance()->LogFileName.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Log", "SingleFile", GetBoolValue(Instance()->LogSingleFile.value_for_config()).c_str());
-        ini.SetValue("Log", "LogAsync", GetBoolValue(Instance()->LogAsync.value_for_config()).c_str());
-        ini.SetValue("Log", "LogAsyncThreads", GetIntValue(Instance()->LogAsyncThreads.value_for_config()).c_str());
-    }
-
-    // NvApi
-    {
-        ini.SetValue("NvApi", "OverrideNvapiDll",
-                     GetBoolValue(Instance()->OverrideNvapiDll.value_for_config()).c_str());
-        ini.SetValue("NvApi", "NvapiDllPath",
-                     wstring_to_string(Instance()->NvapiDllPath.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("NvApi", "DisableFlipMetering",
-                     GetBoolValue(Instance()->DisableFlipMetering.value_for_config()).c_str());
-    }
-
-    // DRS
-    {
-        ini.SetValue("DRS", "DrsMinOverrideEnabled",
-                     GetBoolValue(Instance()->DrsMinOverrideEnabled.value_for_config()).c_str());
-        ini.SetValue("DRS", "DrsMaxOverrideEnabled",
-                     GetBoolValue(Instance()->DrsMaxOverrideEnabled.value_for_config()).c_str());
     }
 
     // Spoofing
@@ -1200,73 +264,15 @@ bool Config::SaveIni()
 
         ini.SetValue("Spoofing", "Dxgi",
                      GetBoolValue(Instance()->DxgiSpoofing.value_for_config(forceSaveDxgi)).c_str());
-        ini.SetValue("Spoofing", "DxgiFactoryWrapping",
-                     GetBoolValue(Instance()->DxgiFactoryWrapping.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "DxgiBlacklist", Instance()->DxgiBlacklist.value_for_config_or("auto").c_str());
-        ini.SetValue("Spoofing", "Vulkan", GetBoolValue(Instance()->VulkanSpoofing.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "VulkanExtensionSpoofing",
-                     GetBoolValue(Instance()->VulkanExtensionSpoofing.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "VulkanVRAM", GetIntValue(Instance()->VulkanVRAM.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "DxgiVRAM", GetIntValue(Instance()->DxgiVRAM.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "SpoofedGPUName",
-                     wstring_to_string(Instance()->SpoofedGPUName.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Spoofing", "StreamlineSpoofing",
-                     GetBoolValue(Instance()->StreamlineSpoofing.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "SpoofHAGS", GetBoolValue(Instance()->SpoofHAGS.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "D3DFeatureLevel",
-                     GetBoolValue(Instance()->SpoofFeatureLevel.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "UEIntelAtomics",
-                     GetBoolValue(Instance()->UESpoofIntelAtomics64.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "SpoofedVendorId",
-                     GetIntValue(Instance()->SpoofedVendorId.value_for_config(), true).c_str());
-        ini.SetValue("Spoofing", "SpoofedDeviceId",
-                     GetIntValue(Instance()->SpoofedDeviceId.value_for_config(), true).c_str());
-        ini.SetValue("Spoofing", "TargetVendorId",
-                     GetIntValue(Instance()->TargetVendorId.value_for_config(), true).c_str());
-        ini.SetValue("Spoofing", "TargetDeviceId",
-                     GetIntValue(Instance()->TargetDeviceId.value_for_config(), true).c_str());
     }
 
     // Plugins
     {
-
         ini.SetValue("Plugins", "Path", wstring_to_string(Instance()->PluginPath.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Plugins", "LoadSpecialK", GetBoolValue(Instance()->LoadSpecialK.value_for_config()).c_str());
-        ini.SetValue("Plugins", "LoadReShade", GetBoolValue(Instance()->LoadReShade.value_for_config()).c_str());
-        ini.SetValue("Plugins", "LoadAsiPlugins", GetBoolValue(Instance()->LoadAsiPlugins.value_for_config()).c_str());
-    }
-
-    // inputs
-    {
-        ini.SetValue("Inputs", "EnableDlssInputs",
-                     GetBoolValue(Instance()->EnableDlssInputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "EnableXeSSInputs",
-                     GetBoolValue(Instance()->EnableXeSSInputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "UseFsr2Inputs", GetBoolValue(Instance()->UseFsr2Inputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "UseFsr2Dx11Inputs",
-                     GetBoolValue(Instance()->UseFsr2Dx11Inputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "UseFsr2VulkanInputs",
-                     GetBoolValue(Instance()->UseFsr2VulkanInputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "Fsr2Pattern", GetBoolValue(Instance()->Fsr2Pattern.value_for_config()).c_str());
-        ini.SetValue("Inputs", "UseFsr3Inputs", GetBoolValue(Instance()->UseFsr3Inputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "Fsr3Pattern", GetBoolValue(Instance()->Fsr3Pattern.value_for_config()).c_str());
-        ini.SetValue("Inputs", "UseFfxInputs", GetBoolValue(Instance()->UseFfxInputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "EnableHotSwapping",
-                     GetBoolValue(Instance()->EnableHotSwapping.value_for_config()).c_str());
-
-        ini.SetValue("Inputs", "EnableFsr2Inputs",
-                     GetBoolValue(Instance()->EnableFsr2Inputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "EnableFsr3Inputs",
-                     GetBoolValue(Instance()->EnableFsr3Inputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "EnableFfxInputs", GetBoolValue(Instance()->EnableFfxInputs.value_for_config()).c_str());
     }
 
     // V-Sync
     {
-        ini.SetValue("V-Sync", "OverrideVsync", GetBoolValue(Instance()->OverrideVsync.value_for_config()).c_str());
-        ini.SetValue("V-Sync", "ForceVsync", GetBoolValue(Instance()->ForceVsync.value_for_config()).c_str());
-        ini.SetValue("V-Sync", "SyncInterval", GetIntValue(Instance()->VsyncInterval.value_for_config()).c_str());
-
         if (Instance()->VsyncInterval.has_value())
         {
             if (Instance()->VsyncInterval.value() < 0 || Instance()->VsyncInterval.value() > 3)
@@ -1387,156 +393,41 @@ void Config::CheckUpscalerFiles()
 
 std::vector<std::string> Config::GetConfigLog() { return _log; }
 
+std::filesystem::path Config::IniPath() const { return absoluteFileName; }
+
 std::optional<std::string> Config::readString(std::string section, std::string key, bool lowercase)
 {
     std::string value = ini.GetValue(section.c_str(), key.c_str(), "auto");
 
-    std::string lower = value;
-    std::ranges::transform(lower, lower.begin(), [](unsigned char c) { return std::tolower(c); });
-
-    if (lower == "auto")
+    if (_stricmp(value.c_str(), "auto") == 0)
         return std::nullopt;
 
     _log.push_back(std::format("{}.{}: {}", section, key, value));
 
-    return lowercase ? lower : value;
-}
-
-std::optional<std::wstring> Config::readWString(std::string section, std::string key, bool lowercase)
-{
-    std::string value = ini.GetValue(section.c_str(), key.c_str(), "auto");
-
-    std::string lower = value;
-    std::ranges::transform(lower, lower.begin(), [](unsigned char c) { return std::tolower(c); });
-
-    if (lower == "auto")
-        return std::nullopt;
-
-    _log.push_back(std::format("{}.{}: {}", section, key, value));
+    if (lowercase)
+        std::ranges::transform(value, value.begin(), [](unsigned char c) { return std::tolower(c); });
 
-    return lowercase ? string_to_wstring(lower) : string_to_wstring(value);
+    return value;
 }
 
-std::optional<float> Config::readFloat(std::string section, std::string key)
+std::optional<uint32_t> Config::readUInt(std::string section, std::string key)
 {
     auto value = readString(section, key);
 
-    try
-    {
-        float result;
-
-        if (value.has_value() && isFloat(value.value(), result))
-            return result;
-
-        return std::nullopt;
-    }
-    catch (const std::bad_optional_access&) // missing or auto value
-    {
-        return std::nullopt;
-    }
-    catch (const std::invalid_argument&) // invalid float string for std::stof
-    {
-        return std::nullopt;
-    }
-    catch (const std::out_of_range&) // out of range for 32 bit float
-    {
-        return std::nullopt;
-    }
-}
-
-std::optional<int> Config::readInt(std::string section, std::string key)
-{
-    auto value = readString(section, key);
     if (!value.has_value())
         return std::nullopt;
 
-    const auto& s = *value;
-    try
-    {
-        size_t idx = 0;
-        int result;
-
-        // detect hex prefix
-        if (s.size() > 2 && (s[0] == '0') && (s[1] == 'x' || s[1] == 'X'))
-        {
-            result = std::stoi(s, &idx, 16);
-        }
-        else
-        {
-            result = std::stoi(s, &idx, 10);
-        }
-
-        // ensure we consumed the whole string
-        if (idx == s.size())
-            return result;
-        else
-            return std::nullopt;
-    }
-    catch (const std::bad_optional_access&) // missing or auto value
-    {
-        return std::nullopt;
-    }
-    catch (const std::invalid_argument&) // invalid float string for std::stof
-    {
-        return std::nullopt;
-    }
-    catch (const std::out_of_range&) // out// out of range for 32 bit float
-    {
-        return std::nullopt;
-    }
+    return ConfigSchema::ParseUInt(value.value());
 }
 
-std::optional<uint32_t> Config::readUInt(std::string section, std::string key)
+std::optional<bool> Config::readBool(std::string section, std::string key)
 {
     auto value = readString(section, key);
-    if (!value.has_value())
-        return std::nullopt;
-
-    const auto& s = *value;
-    try
-    {
-        size_t idx = 0;
-        int result;
-
-        // detect hex prefix
-        if (s.size() > 2 && (s[0] == '0') && (s[1] == 'x' || s[1] == 'X'))
-        {
-            result = std::stoi(s, &idx, 16);
-        }
-        else
-        {
-            result = std::stoi(s, &idx, 10);
-        }
 
-        // ensure we consumed the whole string
-        if (idx == s.size())
-            return result;
-        else
-            return std::nullopt;
-    }
-    catch (const std::bad_optional_access&) // missing or auto value
-    {
-        return std::nullopt;
-    }
-    catch (const std::invalid_argument&) // invalid float string for std::stof
-    {
-        return std::nullopt;
-    }
-    catch (const std::out_of_range&) // out// out of range for 32 bit float
-    {
+    if (!value.has_value())
         return std::nullopt;
-    }
-}
-
-std::optional<bool> Config::readBool(std::string section, std::string key)
-{
-    auto value = readString(section, key, true);
-    if (value == "true")
-        return true;
-    else if (value == "false")
-        return false;
 
-    return std::nullopt;
+    return ConfigSchema::ParseBool(value.value());
 }
 
 Config* Config::Instance()
@@ -1,8 +1,8 @@
 #pragma once
 
-#include "pch.h"
+#include <pch.h>
 
-#include "State.h"
+#include <State.h>
 
 #include <optional>
 #include <filesystem>
@@ -263,11 +263,13 @@ class Config
     CustomOptional<int> FpsCycleShortcutKey { VK_NEXT };
     CustomOptional<bool> FpsOverlayHorizontal { false };
     CustomOptional<float> FpsOverlayAlpha { 0.4f };
+    CustomOptional<float> FpsOverlayRefreshRate { 10.0f }; // Rebuilds per second while menu is closed, 0 every frame
     CustomOptional<float, NoDefault> FpsScale; // No value means same as MenuScale
     CustomOptional<bool> UseHQFont { true };
     CustomOptional<bool> DisableSplash { false };
     CustomOptional<std::wstring, NoDefault> TTFFontPath;
     CustomOptional<int> FGShortcutKey { VK_END };
+    CustomOptional<bool> HotReloadIni { true };
 
     // Hooks
     CustomOptional<bool> HookOriginalNvngxOnly { false };
@@ -281,6 +283,10 @@ class Config
     // DRS
     CustomOptional<bool> DrsMinOverrideEnabled { false };
     CustomOptional<bool> DrsMaxOverrideEnabled { false };
+    CustomOptional<bool> DrsControllerEnabled { false };
+    CustomOptional<float> DrsTargetFrameTime { 16.667f };
+    CustomOptional<float> DrsControllerMinRatio { 1.0f };
+    CustomOptional<float> DrsControllerMaxRatio { 2.0f };
 
     // Quality Overrides
     CustomOptional<bool> QualityRatioOverrideEnabled { false };
@@ -309,8 +315,9 @@ class Config
     CustomOptional<int, NoDefault> RoundInternalResolution; // disabled by default
 
     CustomOptional<int, NoDefault> SkipFirstFrames; // disabled by default
-    CustomOptional<bool> RestoreComputeSignature { false };
-    CustomOptional<bool> RestoreGraphicSignature { false };
+    CustomOptional<bool> RestoreComputeSignature { true };
+    CustomOptional<bool> RestoreGraphicSignature { true };
+    CustomOptional<bool> JitterAutoCorrect { false };
 
     CustomOptional<bool> UsePrecompiledShaders { true };
 
@@ -326,11 +333,14 @@ class Config
     CustomOptional<int32_t, NoDefault> OutputResourceBarrier;   // disabled by default
 
     CustomOptional<bool> DontCreateD3D12DeviceForLuma { false };
+    CustomOptional<bool> UseEnhancedBarriers { false };
 
     // Upscalers
     CustomOptional<std::string, SoftDefault> Dx11Upscaler { "fsr22" };
     CustomOptional<std::string, SoftDefault> Dx12Upscaler { "xess" };
     CustomOptional<std::string, SoftDefault> VulkanUpscaler { "fsr21" };
+    CustomOptional<int32_t> UpscalerStandbyCount { 0 };
+    CustomOptional<int32_t> UpscalerStandbyBudget { 512 }; // MB
 
     // Output Scaling
     CustomOptional<bool> OutputScalingEnabled { false };
@@ -401,8 +411,8 @@ class Config
     CustomOptional<bool> LoadAsiPlugins { false };
 
     // Frame Generation
-    CustomOptional<FGInput> FGInput { FGInput::NoFG };
-    CustomOptional<FGOutput> FGOutput { FGOutput::NoFG };
+    CustomOptional<::FGInput> FGInput { ::FGInput::NoFG };
+    CustomOptional<::FGOutput> FGOutput { ::FGOutput::NoFG };
     CustomOptional<bool> FGDrawUIOverFG { false };
     CustomOptional<bool> FGUIPremultipliedAlpha { true };
     CustomOptional<bool> FGDisableHudless { false };
@@ -528,6 +538,7 @@ class Config
     void CheckUpscalerFiles();
 
     std::vector<std::string> GetConfigLog();
+    std::filesystem::path IniPath() const;
 
     static Config* Instance();
 
@@ -541,9 +552,6 @@ class Config
     bool Reload(std::filesystem::path iniPath);
 
     std::optional<std::string> readString(std::string section, std::string key, bool lowercase = false);
-    std::optional<std::wstring> readWString(std::string section, std::string key, bool lowercase = false);
-    std::optional<float> readFloat(std::string section, std::string key);
-    std::optional<int> readInt(std::string section, std::string key);
     std::optional<uint32_t> readUInt(std::string section, std::string key);
     std::optional<bool> readBool(std::string section, std::string key);
 };
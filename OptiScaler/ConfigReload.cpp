@@ -0,0 +1,210 @@
+#include "ConfigReload.h"
+
+#include <hooks/FG_Hooks.h>
+
+#include <fstream>
+#include <thread>
+
+// Wait after a change notification, editors might write the file in a few steps
+static constexpr DWORD DebounceMs = 250;
+
+// Upper limit for the watcher to notice the stop event on shutdown
+static constexpr DWORD StopTimeoutMs = 1000;
+
+void ConfigReload::Dispatch(uint32_t actions)
+{
+    auto& state = State::Instance();
+    auto config = Config::Instance();
+
+    if (actions != ConfigReload_None)
+        FGHooks::InvalidatePresentPipeline();
+
+    if (actions & ConfigReload_Constants)
+    {
+        // Log level is only applied by the menu otherwise
+        if (config->LogToConsole.value_or_default() || config->LogToFile.value_or_default() ||
+            config->LogToNGX.value_or_default())
+            LogGate::SetGlobal(config->LogLevel.value_or_default());
+    }
+
+    if ((actions & ConfigReload_FrameGen) && config->FGEnabled.value_or_default())
+    {
+        LOG_DEBUG("Rebuilding FG context, swapchain: {}", (actions & ConfigReload_Swapchain) != 0);
+
+        state.FGchanged = true;
+
+        if (actions & ConfigReload_Swapchain)
+            state.SCchanged = true;
+    }
+
+    if ((actions & ConfigReload_Upscaler) && state.currentFeature != nullptr)
+    {
+        LOG_DEBUG("Recreating upscaler");
+
+        // Empty backend makes the provider use the one in config, which might be the changed option
+        if (state.currentFeature->Name() == "DLSSD")
+            state.newBackend = "dlssd";
+        else
+            state.newBackend = "";
+
+        for (auto& changeBackend : state.changeBackend)
+            changeBackend.second = true;
+    }
+
+    if (actions & ConfigReload_Restart)
+        LOG_WARN("Some of the changed options need a game restart");
+}
+
+std::optional<std::string> ConfigReload::ReadText(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file.is_open())
+        return std::nullopt;
+
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void ConfigReload::WatchThread(std::filesystem::path iniPath, HANDLE stopEvent, HANDLE exitedEvent)
+{
+    auto changeHandle = FindFirstChangeNotificationW(iniPath.parent_path().c_str(), FALSE,
+                                                     FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+
+    if (changeHandle == INVALID_HANDLE_VALUE)
+    {
+        LOG_ERROR("FindFirstChangeNotificationW error: {:X}", GetLastError());
+        SetEvent(exitedEvent);
+        return;
+    }
+
+    std::error_code ec;
+    auto lastWriteTime = std::filesystem::last_write_time(iniPath, ec);
+
+    HANDLE handles[] = { stopEvent, changeHandle };
+
+    while (WaitForMultipleObjects(2, handles, FALSE, INFINITE) == WAIT_OBJECT_0 + 1)
+    {
+        if (!FindNextChangeNotification(changeHandle))
+        {
+            LOG_ERROR("FindNextChangeNotification error: {:X}", GetLastError());
+            break;
+        }
+
+        if (WaitForSingleObject(stopEvent, DebounceMs) == WAIT_OBJECT_0)
+            break;
+
+        // Whole folder is watched, log files and others trigger it too
+        auto writeTime = std::filesystem::last_write_time(iniPath, ec);
+
+        if (ec || writeTime == lastWriteTime)
+            continue;
+
+        lastWriteTime = writeTime;
+
+        auto text = ReadText(iniPath);
+
+        if (!text.has_value() || text.value().empty() || text.value() == _lastText)
+            continue;
+
+        auto changeSet = Diff(_lastText, text.value());
+        _lastText = std::move(text.value());
+
+        if (changeSet.empty())
+            continue;
+
+        LOG_INFO("Ini changed, {} options will be applied on next present", changeSet.changes.size());
+
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        Merge(_pending, changeSet);
+        _hasPending.store(!_pending.empty(), std::memory_order_release);
+    }
+
+    FindCloseChangeNotification(changeHandle);
+
+    // Nothing of ours is touched after this
+    SetEvent(exitedEvent);
+}
+
+void ConfigReload::Start(std::filesystem::path iniPath)
+{
+    if (_stopEvent != nullptr)
+        return;
+
+    auto text = ReadText(iniPath);
+
+    if (!text.has_value())
+    {
+        LOG_WARN("Can't read {}, ini hot reload disabled", iniPath.string());
+        return;
+    }
+
+    _stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    _exitedEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+    if (_stopEvent == nullptr || _exitedEvent == nullptr)
+    {
+        LOG_ERROR("CreateEventW error: {:X}", GetLastError());
+
+        if (_stopEvent != nullptr)
+            CloseHandle(_stopEvent);
+
+        if (_exitedEvent != nullptr)
+            CloseHandle(_exitedEvent);
+
+        _stopEvent = nullptr;
+        _exitedEvent = nullptr;
+        return;
+    }
+
+    _lastText = std::move(text.value());
+
+    // Stop is called from DLL_PROCESS_DETACH, a join would wait for the thread's own detach
+    // notification which needs the loader lock. The thread signals when it's done instead
+    std::thread(WatchThread, iniPath, _stopEvent, _exitedEvent).detach();
+
+    LOG_INFO("Watching {} for changes", iniPath.string());
+}
+
+void ConfigReload::Stop(bool processTerminating)
+{
+    if (_stopEvent == nullptr)
+        return;
+
+    // Other threads are already terminated, the exited event will never be set
+    if (processTerminating)
+        return;
+
+    SetEvent(_stopEvent);
+
+    if (WaitForSingleObject(_exitedEvent, StopTimeoutMs) != WAIT_OBJECT_0)
+    {
+        // Handles are left to the thread in case it still wakes up
+        LOG_WARN("Watcher thread didn't stop in {} ms", StopTimeoutMs);
+        _stopEvent = nullptr;
+        _exitedEvent = nullptr;
+        return;
+    }
+
+    CloseHandle(_stopEvent);
+    CloseHandle(_exitedEvent);
+
+    _stopEvent = nullptr;
+    _exitedEvent = nullptr;
+}
+
+void ConfigReload::OnPresent()
+{
+    if (!_hasPending.load(std::memory_order_acquire))
+        return;
+
+    ConfigChangeSet changeSet {};
+
+    {
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        changeSet = std::move(_pending);
+        _pending = {};
+        _hasPending.store(false, std::memory_order_release);
+    }
+
+    Dispatch(Apply(Config::Instance(), changeSet));
+}
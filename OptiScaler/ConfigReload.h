@@ -0,0 +1,90 @@
+#pragma once
+
+#include <pch.h>
+
+#include <Config.h>
+#include <ConfigSchema.h>
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// What needs to happen for a set of changed options to take effect
+enum ConfigReloadActions : uint32_t
+{
+    ConfigReload_None = 0,
+    ConfigReload_Constants = 1 << 0, // Values are read on use, nothing to rebuild
+    ConfigReload_FrameGen = 1 << 1,  // FG context rebuild
+    ConfigReload_Swapchain = 1 << 2, // FG swapchain rebuild
+    ConfigReload_Upscaler = 1 << 3,  // Upscaler feature recreate
+    ConfigReload_Restart = 1 << 4,   // Can't be applied while running
+};
+
+struct ConfigChange
+{
+    const char* section = nullptr;
+    const char* key = nullptr;
+
+    // Null for the options which are parsed by Config itself
+    const ConfigOption* option = nullptr;
+    ConfigScope scope = ConfigScope::Live;
+
+    // Normalized ini values, nullopt is auto
+    std::optional<std::string> oldValue;
+    std::optional<std::string> newValue;
+};
+
+struct ConfigChangeSet
+{
+    std::vector<ConfigChange> changes;
+    uint32_t actions = ConfigReload_None;
+
+    bool empty() const { return changes.empty(); }
+};
+
+// Watches the ini and applies the edits while the game is running.
+// The file is parsed and diffed on the watcher thread, changes are applied on the
+// next present and each one only triggers the rebuild its scope needs.
+class ConfigReload
+{
+  public:
+    static uint32_t ScopeActions(ConfigScope scope);
+
+    // Compares two ini texts, only the options Config knows about are checked
+    static ConfigChangeSet Diff(std::string_view oldIni, std::string_view newIni);
+
+    // Merges a newer diff into a pending one, the oldest old value is kept
+    static void Merge(ConfigChangeSet& pending, const ConfigChangeSet& newer);
+
+    // Writes the changed values to the config and returns the actions needed for the ones
+    // which really changed, so re-saving the current values doesn't rebuild anything
+    static uint32_t Apply(Config* config, const ConfigChangeSet& changeSet);
+
+    // Requests the rebuilds, they are done by their owners on the next frame
+    static void Dispatch(uint32_t actions);
+
+    static void Start(std::filesystem::path iniPath);
+
+    // Returns once the watcher thread is done. When the process is terminating it's already gone
+    static void Stop(bool processTerminating = false);
+
+    // Called on present, applies the pending changes if there are any
+    static void OnPresent();
+
+  private:
+    inline static std::string _lastText;
+
+    inline static std::mutex _pendingMutex;
+    inline static ConfigChangeSet _pending;
+    inline static std::atomic<bool> _hasPending = false;
+
+    inline static HANDLE _stopEvent = nullptr;
+    inline static HANDLE _exitedEvent = nullptr;
+
+    static std::optional<std::string> ReadText(const std::filesystem::path& path);
+    static void WatchThread(std::filesystem::path iniPath, HANDLE stopEvent, HANDLE exitedEvent);
+};
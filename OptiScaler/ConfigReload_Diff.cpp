@@ -0,0 +1,201 @@
+#include "ConfigReload.h"
+
+#include <SimpleIni.h>
+
+struct ConfigCustomKey
+{
+    const char* section;
+    const char* key;
+    ConfigScope scope;
+};
+
+// Options which are parsed by Config instead of ConfigSchema
+static const ConfigCustomKey ConfigCustomKeys[] = {
+    { "FrameGen", "FGInput", ConfigScope::Restart },
+    { "FrameGen", "FGOutput", ConfigScope::Restart },
+    { "Log", "LogFile", ConfigScope::Restart },
+    { "Menu", "FpsOverlayType", ConfigScope::Live },
+    { "Spoofing", "Dxgi", ConfigScope::Restart },
+    { "Plugins", "Path", ConfigScope::Restart },
+};
+
+// Upscaler selections of the other APIs are stored but don't need a recreate
+static bool IsOtherApiUpscaler(const ConfigChange& change)
+{
+    if (std::string_view(change.section) != "Upscalers")
+        return false;
+
+    std::string_view key(change.key);
+
+    switch (State::Instance().api)
+    {
+    case DX11:
+        return key == "Dx12Upscaler" || key == "VulkanUpscaler";
+
+    case DX12:
+        return key == "Dx11Upscaler" || key == "VulkanUpscaler";
+
+    case Vulkan:
+        return key == "Dx11Upscaler" || key == "Dx12Upscaler";
+
+    default:
+        return false;
+    }
+}
+
+static std::optional<std::string> NormalizeCustom(std::string value)
+{
+    std::ranges::transform(value, value.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    if (value == "auto")
+        return std::nullopt;
+
+    return value;
+}
+
+uint32_t ConfigReload::ScopeActions(ConfigScope scope)
+{
+    switch (scope)
+    {
+    case ConfigScope::Live:
+        return ConfigReload_Constants;
+
+    case ConfigScope::FrameGen:
+        return ConfigReload_FrameGen;
+
+    case ConfigScope::Swapchain:
+        return ConfigReload_FrameGen | ConfigReload_Swapchain;
+
+    case ConfigScope::Reinit:
+        return ConfigReload_Upscaler;
+
+    default:
+        return ConfigReload_Restart;
+    }
+}
+
+ConfigChangeSet ConfigReload::Diff(std::string_view oldIni, std::string_view newIni)
+{
+    ConfigChangeSet result {};
+
+    CSimpleIniA oldParsed;
+    CSimpleIniA newParsed;
+
+    if (oldParsed.LoadData(oldIni.data(), oldIni.size()) < 0 || newParsed.LoadData(newIni.data(), newIni.size()) < 0)
+    {
+        LOG_WARN("Can't parse ini");
+        return result;
+    }
+
+    for (const auto& option : ConfigSchema::Options())
+    {
+        auto oldValue = ConfigSchema::Normalize(option, oldParsed.GetValue(option.section, option.key, "auto"));
+        auto newValue = ConfigSchema::Normalize(option, newParsed.GetValue(option.section, option.key, "auto"));
+
+        if (oldValue == newValue)
+            continue;
+
+        result.changes.push_back({ option.section, option.key, &option, option.scope, oldValue, newValue });
+        result.actions |= ScopeActions(option.scope);
+    }
+
+    for (const auto& custom : ConfigCustomKeys)
+    {
+        auto oldValue = NormalizeCustom(oldParsed.GetValue(custom.section, custom.key, "auto"));
+        auto newValue = NormalizeCustom(newParsed.GetValue(custom.section, custom.key, "auto"));
+
+        if (oldValue == newValue)
+            continue;
+
+        result.changes.push_back({ custom.section, custom.key, nullptr, custom.scope, oldValue, newValue });
+        result.actions |= ScopeActions(custom.scope);
+    }
+
+    return result;
+}
+
+void ConfigReload::Merge(ConfigChangeSet& pending, const ConfigChangeSet& newer)
+{
+    for (const auto& change : newer.changes)
+    {
+        auto it = std::ranges::find_if(pending.changes,
+                                       [&change](const ConfigChange& existing)
+                                       {
+                                           return std::string_view(existing.section) == change.section &&
+                                                  std::string_view(existing.key) == change.key;
+                                       });
+
+        if (it == pending.changes.end())
+        {
+            pending.changes.push_back(change);
+            continue;
+        }
+
+        it->newValue = change.newValue;
+
+        // Reverted before it was applied
+        if (it->oldValue == it->newValue)
+            pending.changes.erase(it);
+    }
+
+    pending.actions = ConfigReload_None;
+
+    for (const auto& change : pending.changes)
+        pending.actions |= ScopeActions(change.scope);
+}
+
+uint32_t ConfigReload::Apply(Config* config, const ConfigChangeSet& changeSet)
+{
+    uint32_t actions = ConfigReload_None;
+
+    for (const auto& change : changeSet.changes)
+    {
+        auto newValue = change.newValue.value_or("auto");
+
+        if (change.scope == ConfigScope::Restart)
+        {
+            LOG_WARN("{}.{} changed to {}, needs a restart to apply", change.section, change.key, newValue);
+            actions |= ConfigReload_Restart;
+            continue;
+        }
+
+        bool changed = false;
+
+        if (change.option != nullptr)
+        {
+            changed = ConfigSchema::Apply(config, *change.option, change.newValue);
+        }
+        else if (std::string_view(change.section) == "Menu" && std::string_view(change.key) == "FpsOverlayType")
+        {
+            auto before = config->FpsOverlayType.value_or_default();
+            auto value = change.newValue.has_value() ? ConfigSchema::ParseUInt(change.newValue.value()) : std::nullopt;
+
+            if (value.has_value())
+                config->FpsOverlayType =
+                    (FpsOverlay) std::clamp(value.value(), (uint32_t) FpsOverlay_JustFPS, FpsOverlay_COUNT - 1);
+            else
+                config->FpsOverlayType = std::optional<FpsOverlay> {};
+
+            changed = config->FpsOverlayType.value_or_default() != before;
+        }
+
+        if (!changed)
+            continue;
+
+        LOG_INFO("{}.{} changed to {}", change.section, change.key, newValue);
+
+        if (!IsOtherApiUpscaler(change))
+            actions |= ScopeActions(change.scope);
+    }
+
+    // Same as Config::Reload, only sRGB or PQ should be enabled and either one needs the non-linear color space
+    if (config->FsrNonLinearPQ.value_or_default())
+        config->FsrNonLinearSRGB.reset();
+    else if (config->FsrNonLinearSRGB.value_or_default())
+        config->FsrNonLinearPQ.reset();
+
+    if (config->FsrNonLinearPQ.value_or_default() || config->FsrNonLinearSRGB.value_or_default())
+        config->FsrNonLinearColorSpace.set_volatile_value(true);
+
+    return actions;
+}
@@ -0,0 +1,744 @@
+#include "ConfigSchema.h"
+
+#include <algorithm>
+#include <charconv>
+
+static ConfigRange Clamp(double min, double max) { return { ConfigRangeMode::Clamp, min, max }; }
+
+static ConfigRange Reject(double min, double max, std::optional<double> alsoAllowed = std::nullopt)
+{
+    return { ConfigRangeMode::Reject, min, max, alsoAllowed };
+}
+
+// DLSS presets are accepted up to the preset count, 0x00FFFFFF is the default preset
+static constexpr double DlssPresetDefault = 0x00FFFFFF;
+static constexpr double DlssPresetMax = 16;
+static constexpr double DlssdPresetMax = 5;
+
+using enum ConfigScope;
+
+// clang-format off
+static const ConfigOption ConfigOptions[] = {
+    // Upscalers
+    { "Upscalers", "Dx11Upscaler", &Config::Dx11Upscaler, Reinit, {}, ConfigOption_Lowercase },
+    { "Upscalers", "Dx12Upscaler", &Config::Dx12Upscaler, Reinit, {}, ConfigOption_Lowercase },
+    { "Upscalers", "VulkanUpscaler", &Config::VulkanUpscaler, Reinit, {}, ConfigOption_Lowercase },
+    { "Upscalers", "StandbyCount", &Config::UpscalerStandbyCount, Live, Clamp(0, 16) },
+    { "Upscalers", "StandbyBudget", &Config::UpscalerStandbyBudget, Live, Clamp(0, 16384) },
+
+    // Frame Generation
+    { "FrameGen", "Enabled", &Config::FGEnabled, FrameGen },
+    { "FrameGen", "DebugView", &Config::FGDebugView, FrameGen },
+    { "FrameGen", "DrawUIOverFG", &Config::FGDrawUIOverFG },
+    { "FrameGen", "UIPremultipliedAlpha", &Config::FGUIPremultipliedAlpha },
+    { "FrameGen", "DisableHudless", &Config::FGDisableHudless },
+    { "FrameGen", "DisableUI", &Config::FGDisableUI },
+    { "FrameGen", "SkipReset", &Config::FGSkipReset },
+    { "FrameGen", "RectLeft", &Config::FGRectLeft },
+    { "FrameGen", "RectTop", &Config::FGRectTop },
+    { "FrameGen", "RectWidth", &Config::FGRectWidth },
+    { "FrameGen", "RectHeight", &Config::FGRectHeight },
+    { "FrameGen", "AllowedFrameAhead", &Config::FGAllowedFrameAhead, Live, Reject(1, 3) },
+    { "FrameGen", "DepthValidNow", &Config::FGDepthValidNow },
+    { "FrameGen", "VelocityValidNow", &Config::FGVelocityValidNow },
+    { "FrameGen", "HudlessValidNow", &Config::FGHudlessValidNow },
+    { "FrameGen", "OnlyAcceptFirstHudless", &Config::FGOnlyAcceptFirstHudless },
+
+    // FSR FG
+    { "FSRFG", "DebugTearLines", &Config::FGDebugTearLines },
+    { "FSRFG", "DebugResetLines", &Config::FGDebugResetLines },
+    { "FSRFG", "DebugPacingLines", &Config::FGDebugPacingLines },
+    { "FSRFG", "AllowAsync", &Config::FGAsync, Swapchain },
+    { "FSRFG", "UseMutexForSwapchain", &Config::FGUseMutexForSwapchain },
+    { "FSRFG", "FramePacingTuning", &Config::FGFramePacingTuning },
+    { "FSRFG", "FPTSafetyMarginInMs", &Config::FGFPTSafetyMarginInMs },
+    { "FSRFG", "FPTVarianceFactor", &Config::FGFPTVarianceFactor },
+    { "FSRFG", "FPTHybridSpin", &Config::FGFPTAllowHybridSpin },
+    { "FSRFG", "FPTHybridSpinTime", &Config::FGFPTHybridSpinTime },
+    { "FSRFG", "FPTWaitForSingleObjectOnFence", &Config::FGFPTAllowWaitForSingleObjectOnFence },
+    { "FSRFG", "EnableWatermark", &Config::FSRFGEnableWatermark },
+
+    // XeFG
+    { "XeFG", "InterpolationCount", &Config::FGXeFGInterpolationCount, Restart, Reject(1, 3) },
+    { "XeFG", "IgnoreInitChecks", &Config::FGXeFGIgnoreInitChecks, Restart },
+    { "XeFG", "DepthInverted", &Config::FGXeFGDepthInverted, Restart },
+    { "XeFG", "JitteredMV", &Config::FGXeFGJitteredMV, Restart },
+    { "XeFG", "HighResMV", &Config::FGXeFGHighResMV, Restart },
+    { "XeFG", "DebugView", &Config::FGXeFGDebugView, FrameGen },
+    { "XeFG", "ForceBorderless", &Config::FGXeFGForceBorderless, Restart },
+    { "XeFG", "SkipResizeBuffers", &Config::FGXeFGSkipResizeBuffers, Restart },
+    { "XeFG", "ModifyBufferState", &Config::FGXeFGModifyBufferState, Restart },
+    { "XeFG", "ModifySCIndex", &Config::FGXeFGModifySCIndex, Restart },
+
+    // OptiFG
+    { "OptiFG", "HUDFix", &Config::FGHUDFix, FrameGen },
+    { "OptiFG", "HUDLimit", &Config::FGHUDLimit },
+    { "OptiFG", "HUDFixExtended", &Config::FGHUDFixExtended },
+    { "OptiFG", "HUDFixImmediate", &Config::FGImmediateCapture },
+    { "OptiFG", "UseShards", &Config::FGUseShards, Restart },
+    { "OptiFG", "AlwaysTrackHeaps", &Config::FGAlwaysTrackHeaps, Restart },
+    { "OptiFG", "ResourceBlocking", &Config::FGResourceBlocking },
+    { "OptiFG", "MakeDepthCopy", &Config::FGMakeDepthCopy },
+    { "OptiFG", "MakeMVCopy", &Config::FGMakeMVCopy },
+    { "OptiFG", "HudfixDisableRTV", &Config::FGHudfixDisableRTV },
+    { "OptiFG", "HudfixDisableSRV", &Config::FGHudfixDisableSRV },
+    { "OptiFG", "HudfixDisableUAV", &Config::FGHudfixDisableUAV },
+    { "OptiFG", "HudfixDisableOM", &Config::FGHudfixDisableOM },
+    { "OptiFG", "HudfixDisableDispatch", &Config::FGHudfixDisableDispatch },
+    { "OptiFG", "HudfixDisableDI", &Config::FGHudfixDisableDI },
+    { "OptiFG", "HudfixDisableDII", &Config::FGHudfixDisableDII },
+    { "OptiFG", "HudfixDisableSCR", &Config::FGHudfixDisableSCR },
+    { "OptiFG", "HudfixDisableSGR", &Config::FGHudfixDisableSGR },
+    { "OptiFG", "EnableDepthScale", &Config::FGEnableDepthScale },
+    { "OptiFG", "DepthScaleMax", &Config::FGDepthScaleMax },
+    { "OptiFG", "HUDFixDontUseSwapchainBuffers", &Config::FGDontUseSwapchainBuffers },
+    { "OptiFG", "HUDFixRelaxedResolutionCheck", &Config::FGRelaxedResolutionCheck },
+    { "OptiFG", "ResourceFlip", &Config::FGResourceFlip },
+    { "OptiFG", "ResourceFlipOffset", &Config::FGResourceFlipOffset },
+    { "OptiFG", "AlwaysCaptureFSRFGSwapchain", &Config::FGAlwaysCaptureFSRFGSwapchain },
+
+    // FSR FG Inputs
+    { "FSRFGInputs", "SkipConfigForHudless", &Config::FSRFGSkipConfigForHudless },
+    { "FSRFGInputs", "SkipDispatchForHudless", &Config::FSRFGSkipDispatchForHudless },
+
+    // Framerate
+    { "Framerate", "FramerateLimit", &Config::FramerateLimit },
+
+    // FSR Common
+    { "FSR", "VerticalFov", &Config::FsrVerticalFov },
+    { "FSR", "HorizontalFov", &Config::FsrHorizontalFov },
+    { "FSR", "CameraNear", &Config::FsrCameraNear },
+    { "FSR", "CameraFar", &Config::FsrCameraFar },
+    { "FSR", "UseFsrInputValues", &Config::FsrUseFsrInputValues },
+    { "FSR", "FfxDx12Path", &Config::FfxDx12Path, Restart },
+    { "FSR", "FfxVkPath", &Config::FfxVkPath, Restart },
+
+    // FSR
+    { "FSR", "VelocityFactor", &Config::FsrVelocity },
+    { "FSR", "ReactiveScale", &Config::FsrReactiveScale },
+    { "FSR", "ShadingScale", &Config::FsrShadingScale },
+    { "FSR", "AccAddPerFrame", &Config::FsrAccAddPerFrame },
+    { "FSR", "MinDisOccAcc", &Config::FsrMinDisOccAcc },
+    { "FSR", "DebugView", &Config::FsrDebugView },
+    { "FSR", "UpscalerIndex", &Config::FfxUpscalerIndex, Reinit },
+    { "FSR", "FGIndex", &Config::FfxFGIndex, Swapchain },
+    { "FSR", "UseReactiveMaskForTransparency", &Config::FsrUseMaskForTransparency },
+    { "FSR", "DlssReactiveMaskBias", &Config::DlssReactiveMaskBias },
+    { "FSR", "Fsr4Update", &Config::Fsr4Update, Restart, {}, ConfigOption_IgnoreDefault },
+    { "FSR", "Fsr4Model", &Config::Fsr4Model, Reinit, Reject(0, 5) },
+    { "FSR", "Fsr4EnableDebugView", &Config::Fsr4EnableDebugView },
+    { "FSR", "Fsr4EnableWatermark", &Config::Fsr4EnableWatermark },
+    { "FSR", "FsrNonLinearColorSpace", &Config::FsrNonLinearColorSpace, Reinit },
+    { "FSR", "FsrNonLinearPQ", &Config::FsrNonLinearPQ, Reinit },
+    { "FSR", "FsrNonLinearSRGB", &Config::FsrNonLinearSRGB, Reinit },
+    { "FSR", "FsrAgilitySDKUpgrade", &Config::FsrAgilitySDKUpgrade, Restart },
+
+    // XeSS
+    { "XeSS", "BuildPipelines", &Config::BuildPipelines, Reinit },
+    { "XeSS", "NetworkModel", &Config::NetworkModel, Reinit },
+    { "XeSS", "CreateHeaps", &Config::CreateHeaps, Reinit },
+    { "XeSS", "LibraryPath", &Config::XeSSLibrary, Restart },
+    { "XeSS", "Dx11LibraryPath", &Config::XeSSDx11Library, Restart },
+
+    // DLSS
+    { "DLSS", "Enabled", &Config::DLSSEnabled, Restart },
+    { "DLSS", "LibraryPath", &Config::NvngxPath, Restart },
+    { "DLSS", "FeaturePath", &Config::DLSSFeaturePath, Restart },
+    { "DLSS", "NVNGX_DLSS_Path", &Config::NVNGX_DLSS_Library, Restart },
+    { "DLSS", "UseGenericAppIdWithDlss", &Config::UseGenericAppIdWithDlss, Restart },
+    { "DLSS", "RenderPresetOverride", &Config::RenderPresetOverride, Reinit },
+    { "DLSS", "RenderPresetForAll", &Config::RenderPresetForAll, Reinit, Reject(0, DlssPresetMax, DlssPresetDefault) },
+    { "DLSS", "RenderPresetDLAA", &Config::RenderPresetDLAA, Reinit, Reject(0, DlssPresetMax, DlssPresetDefault) },
+    { "DLSS", "RenderPresetUltraQuality", &Config::RenderPresetUltraQuality, Reinit,
+      Reject(0, DlssPresetMax, DlssPresetDefault) },
+    { "DLSS", "RenderPresetQuality", &Config::RenderPresetQuality, Reinit,
+      Reject(0, DlssPresetMax, DlssPresetDefault) },
+    { "DLSS", "RenderPresetBalanced", &Config::RenderPresetBalanced, Reinit,
+      Reject(0, DlssPresetMax, DlssPresetDefault) },
+    { "DLSS", "RenderPresetPerformance", &Config::RenderPresetPerformance, Reinit,
+      Reject(0, DlssPresetMax, DlssPresetDefault) },
+    { "DLSS", "RenderPresetUltraPerformance", &Config::RenderPresetUltraPerformance, Reinit,
+      Reject(0, DlssPresetMax, DlssPresetDefault) },
+
+    // DLSSD
+    { "DLSSD", "RenderPresetOverride", &Config::DLSSDRenderPresetOverride, Reinit },
+    { "DLSSD", "RenderPresetForAll", &Config::DLSSDRenderPresetForAll, Reinit,
+      Reject(0, DlssdPresetMax, DlssPresetDefault) },
+    { "DLSSD", "RenderPresetDLAA", &Config::DLSSDRenderPresetDLAA, Reinit,
+      Reject(0, DlssdPresetMax, DlssPresetDefault) },
+    { "DLSSD", "RenderPresetUltraQuality", &Config::DLSSDRenderPresetUltraQuality, Reinit,
+      Reject(0, DlssdPresetMax, DlssPresetDefault) },
+    { "DLSSD", "RenderPresetQuality", &Config::DLSSDRenderPresetQuality, Reinit,
+      Reject(0, DlssdPresetMax, DlssPresetDefault) },
+    { "DLSSD", "RenderPresetBalanced", &Config::DLSSDRenderPresetBalanced, Reinit,
+      Reject(0, DlssdPresetMax, DlssPresetDefault) },
+    { "DLSSD", "RenderPresetPerformance", &Config::DLSSDRenderPresetPerformance, Reinit,
+      Reject(0, DlssdPresetMax, DlssPresetDefault) },
+    { "DLSSD", "RenderPresetUltraPerformance", &Config::DLSSDRenderPresetUltraPerformance, Reinit,
+      Reject(0, DlssdPresetMax, DlssPresetDefault) },
+
+    // Nukems
+    { "Nukems", "MakeDepthCopy", &Config::MakeDepthCopy },
+
+    // Logging
+    { "Log", "LogLevel", &Config::LogLevel },
+    { "Log", "LogToConsole", &Config::LogToConsole, Restart },
+    { "Log", "LogToDebug", &Config::LogToDebug, Restart },
+    { "Log", "LogToFile", &Config::LogToFile, Restart },
+    { "Log", "LogToNGX", &Config::LogToNGX, Restart },
+    { "Log", "OpenConsole", &Config::OpenConsole, Restart },
+    { "Log", "DebugWait", &Config::DebugWait, Restart, {}, ConfigOption_NotSaved },
+    { "Log", "SingleFile", &Config::LogSingleFile, Restart },
+    { "Log", "LogAsync", &Config::LogAsync, Restart },
+    { "Log", "LogAsyncThreads", &Config::LogAsyncThreads, Restart },
+
+    // Sharpness
+    { "Sharpness", "OverrideSharpness", &Config::OverrideSharpness },
+    { "Sharpness", "Sharpness", &Config::Sharpness, Live, Clamp(0.0, 1.3) },
+
+    // Menu
+    { "Menu", "Scale", &Config::MenuScale, Live, Clamp(0.5, 2.0), ConfigOption_ForceSave },
+    { "Menu", "OverlayMenu", &Config::OverlayMenu, Restart },
+    { "Menu", "ShortcutKey", &Config::ShortcutKey, Live, {}, ConfigOption_HexWhenPositive },
+    { "Menu", "ExtendedLimits", &Config::ExtendedLimits },
+    { "Menu", "ShowFps", &Config::ShowFps },
+    { "Menu", "UseHQFont", &Config::UseHQFont, Restart },
+    { "Menu", "DisableSplash", &Config::DisableSplash, Restart },
+    { "Menu", "FpsOverlayPos", &Config::FpsOverlayPos, Live, Clamp(0, 3) },
+    { "Menu", "FpsShortcutKey", &Config::FpsShortcutKey, Live, {}, ConfigOption_HexWhenPositive },
+    { "Menu", "FpsCycleShortcutKey", &Config::FpsCycleShortcutKey, Live, {}, ConfigOption_HexWhenPositive },
+    { "Menu", "FpsOverlayHorizontal", &Config::FpsOverlayHorizontal },
+    { "Menu", "FpsOverlayAlpha", &Config::FpsOverlayAlpha, Live, Clamp(0.0, 1.0) },
+    { "Menu", "FpsOverlayRefreshRate", &Config::FpsOverlayRefreshRate, Live, Clamp(0.0, 240.0) },
+    { "Menu", "FpsScale", &Config::FpsScale, Live, Clamp(0.5, 2.0) },
+    { "Menu", "TTFFontPath", &Config::TTFFontPath, Restart },
+    { "Menu", "FGShortcutKey", &Config::FGShortcutKey, Live, {}, ConfigOption_HexWhenPositive },
+    { "Menu", "HotReloadIni", &Config::HotReloadIni, Restart },
+
+    // Hooks
+    { "Hooks", "HookOriginalNvngxOnly", &Config::HookOriginalNvngxOnly, Restart },
+    { "Hooks", "EarlyHooking", &Config::EarlyHooking, Restart },
+    { "Hooks", "UseNtdllHooks", &Config::UseNtdllHooks, Restart },
+
+    // RCAS
+    { "CAS", "Enabled", &Config::RcasEnabled, Live, {}, ConfigOption_ForceSave },
+    { "CAS", "MotionSharpnessEnabled", &Config::MotionSharpnessEnabled },
+    { "CAS", "MotionSharpnessDebug", &Config::MotionSharpnessDebug },
+    { "CAS", "MotionSharpness", &Config::MotionSharpness, Live, Clamp(-1.3, 1.3) },
+    { "CAS", "MotionThreshold", &Config::MotionThreshold, Live, Clamp(0.0, 100.0) },
+    { "CAS", "MotionScaleLimit", &Config::MotionScaleLimit, Live, Clamp(0.01, 100.0) },
+    { "CAS", "ContrastEnabled", &Config::ContrastEnabled },
+    { "CAS", "Contrast", &Config::Contrast, Live, Clamp(-2.0, 2.0) },
+
+    // Output Scaling
+    { "OutputScaling", "Enabled", &Config::OutputScalingEnabled, Reinit },
+    { "OutputScaling", "UseFsr", &Config::OutputScalingUseFsr, Reinit },
+    { "OutputScaling", "Downscaler", &Config::OutputScalingDownscaler, Reinit },
+    { "OutputScaling", "Multiplier", &Config::OutputScalingMultiplier, Reinit, Clamp(0.5, 3.0) },
+
+    // Init Flags
+    { "InitFlags", "AutoExposure", &Config::AutoExposure, Reinit },
+    { "InitFlags", "HDR", &Config::HDR, Reinit },
+    { "InitFlags", "DepthInverted", &Config::DepthInverted, Reinit },
+    { "InitFlags", "JitterCancellation", &Config::JitterCancellation, Reinit },
+    { "InitFlags", "DisplayResolution", &Config::DisplayResolution, Reinit },
+    { "InitFlags", "DisableReactiveMask", &Config::DisableReactiveMask, Reinit },
+
+    // DRS
+    { "DRS", "DrsMinOverrideEnabled", &Config::DrsMinOverrideEnabled },
+    { "DRS", "DrsMaxOverrideEnabled", &Config::DrsMaxOverrideEnabled },
+    { "DRS", "ControllerEnabled", &Config::DrsControllerEnabled },
+    { "DRS", "TargetFrameTime", &Config::DrsTargetFrameTime, Live, Clamp(1.0, 100.0) },
+    { "DRS", "ControllerMinRatio", &Config::DrsControllerMinRatio, Live, Clamp(0.5, 3.0) },
+    { "DRS", "ControllerMaxRatio", &Config::DrsControllerMaxRatio, Live, Clamp(0.5, 3.0) },
+
+    // Upscale Ratio Override
+    { "UpscaleRatio", "UpscaleRatioOverrideEnabled", &Config::UpscaleRatioOverrideEnabled },
+    { "UpscaleRatio", "UpscaleRatioOverrideValue", &Config::UpscaleRatioOverrideValue },
+
+    // Quality Overrides
+    { "QualityOverrides", "QualityRatioOverrideEnabled", &Config::QualityRatioOverrideEnabled },
+    { "QualityOverrides", "QualityRatioDLAA", &Config::QualityRatio_DLAA },
+    { "QualityOverrides", "QualityRatioUltraQuality", &Config::QualityRatio_UltraQuality },
+    { "QualityOverrides", "QualityRatioQuality", &Config::QualityRatio_Quality },
+    { "QualityOverrides", "QualityRatioBalanced", &Config::QualityRatio_Balanced },
+    { "QualityOverrides", "QualityRatioPerformance", &Config::QualityRatio_Performance },
+    { "QualityOverrides", "QualityRatioUltraPerformance", &Config::QualityRatio_UltraPerformance },
+
+    // Anisotropy
+    { "Anisotropy", "AnisotropyOverride", &Config::AnisotropyOverride, Live, Reject(1, 16) },
+    { "Anisotropy", "SkipPointFilter", &Config::AnisotropySkipPointFilter },
+    { "Anisotropy", "ModifyComparison", &Config::AnisotropyModifyComp },
+    { "Anisotropy", "ModifyMinMax", &Config::AnisotropyModifyMinMax },
+
+    // Mipmap
+    { "Mipmap", "MipmapBiasOverride", &Config::MipmapBiasOverride, Live, Reject(-15.0, 15.0) },
+    { "Mipmap", "MipmapBiasFixedOverride", &Config::MipmapBiasFixedOverride },
+    { "Mipmap", "MipmapBiasScaleOverride", &Config::MipmapBiasScaleOverride },
+    { "Mipmap", "MipmapBiasOverrideAll", &Config::MipmapBiasOverrideAll },
+
+    // Hotfixes
+    { "Hotfix", "CheckForUpdate", &Config::CheckForUpdate, Restart },
+    { "Hotfix", "DisableOverlays", &Config::DisableOverlays, Restart },
+    { "Hotfix", "RoundInternalResolution", &Config::RoundInternalResolution },
+    { "Hotfix", "RestoreComputeSignature", &Config::RestoreComputeSignature },
+    { "Hotfix", "RestoreGraphicSignature", &Config::RestoreGraphicSignature },
+    { "Hotfix", "JitterAutoCorrect", &Config::JitterAutoCorrect },
+    { "Hotfix", "PreferDedicatedGpu", &Config::PreferDedicatedGpu, Restart },
+    { "Hotfix", "PreferFirstDedicatedGpu", &Config::PreferFirstDedicatedGpu, Restart },
+    { "Hotfix", "SkipFirstFrames", &Config::SkipFirstFrames },
+    { "Hotfix", "UsePrecompiledShaders", &Config::UsePrecompiledShaders, Restart },
+    { "Hotfix", "ColorResourceBarrier", &Config::ColorResourceBarrier },
+    { "Hotfix", "MotionVectorResourceBarrier", &Config::MVResourceBarrier },
+    { "Hotfix", "DepthResourceBarrier", &Config::DepthResourceBarrier },
+    { "Hotfix", "ColorMaskResourceBarrier", &Config::MaskResourceBarrier },
+    { "Hotfix", "ExposureResourceBarrier", &Config::ExposureResourceBarrier },
+    { "Hotfix", "OutputResourceBarrier", &Config::OutputResourceBarrier },
+    { "Hotfix", "DontCreateD3D12DeviceForLuma", &Config::DontCreateD3D12DeviceForLuma, Restart },
+    { "Hotfix", "UseEnhancedBarriers", &Config::UseEnhancedBarriers, Restart },
+
+    // Dx11 with Dx12
+    { "Dx11withDx12", "UseDelayedInit", &Config::Dx11DelayedInit, Reinit },
+    { "Dx11withDx12", "DontUseNTShared", &Config::DontUseNTShared, Reinit },
+
+    // NvApi
+    { "NvApi", "OverrideNvapiDll", &Config::OverrideNvapiDll, Restart },
+    { "NvApi", "NvapiDllPath", &Config::NvapiDllPath, Restart, {}, ConfigOption_Lowercase },
+    { "NvApi", "DisableFlipMetering", &Config::DisableFlipMetering, Restart },
+
+    // Spoofing, Dxgi is saved by Config as it depends on the GPU vendor
+    { "Spoofing", "DxgiFactoryWrapping", &Config::DxgiFactoryWrapping, Restart },
+    { "Spoofing", "DxgiBlacklist", &Config::DxgiBlacklist, Restart },
+    { "Spoofing", "DxgiVRAM", &Config::DxgiVRAM, Restart },
+    { "Spoofing", "Vulkan", &Config::VulkanSpoofing, Restart },
+    { "Spoofing", "VulkanExtensionSpoofing", &Config::VulkanExtensionSpoofing, Restart },
+    { "Spoofing", "VulkanVRAM", &Config::VulkanVRAM, Restart },
+    { "Spoofing", "SpoofedGPUName", &Config::SpoofedGPUName, Restart },
+    { "Spoofing", "StreamlineSpoofing", &Config::StreamlineSpoofing, Restart },
+    { "Spoofing", "SpoofHAGS", &Config::SpoofHAGS, Restart },
+    { "Spoofing", "D3DFeatureLevel", &Config::SpoofFeatureLevel, Restart },
+    { "Spoofing", "SpoofedVendorId", &Config::SpoofedVendorId, Restart, {}, ConfigOption_Hex },
+    { "Spoofing", "SpoofedDeviceId", &Config::SpoofedDeviceId, Restart, {}, ConfigOption_Hex },
+    { "Spoofing", "TargetVendorId", &Config::TargetVendorId, Restart, {}, ConfigOption_Hex },
+    { "Spoofing", "TargetDeviceId", &Config::TargetDeviceId, Restart, {}, ConfigOption_Hex },
+    { "Spoofing", "UEIntelAtomics", &Config::UESpoofIntelAtomics64, Restart },
+
+    // Inputs
+    { "Inputs", "EnableDlssInputs", &Config::EnableDlssInputs, Restart },
+    { "Inputs", "EnableXeSSInputs", &Config::EnableXeSSInputs, Restart },
+    { "Inputs", "EnableFsr2Inputs", &Config::EnableFsr2Inputs, Restart },
+    { "Inputs", "UseFsr2Inputs", &Config::UseFsr2Inputs, Restart },
+    { "Inputs", "UseFsr2Dx11Inputs", &Config::UseFsr2Dx11Inputs, Restart },
+    { "Inputs", "UseFsr2VulkanInputs", &Config::UseFsr2VulkanInputs, Restart },
+    { "Inputs", "Fsr2Pattern", &Config::Fsr2Pattern, Restart },
+    { "Inputs", "EnableFsr3Inputs", &Config::EnableFsr3Inputs, Restart },
+    { "Inputs", "UseFsr3Inputs", &Config::UseFsr3Inputs, Restart },
+    { "Inputs", "Fsr3Pattern", &Config::Fsr3Pattern, Restart },
+    { "Inputs", "EnableFfxInputs", &Config::EnableFfxInputs, Restart },
+    { "Inputs", "UseFfxInputs", &Config::UseFfxInputs, Restart },
+    { "Inputs", "EnableHotSwapping", &Config::EnableHotSwapping, Restart },
+
+    // Plugins
+    { "Plugins", "LoadSpecialK", &Config::LoadSpecialK, Restart },
+    { "Plugins", "LoadReShade", &Config::LoadReShade, Restart },
+    { "Plugins", "LoadAsiPlugins", &Config::LoadAsiPlugins, Restart },
+
+    // HDR
+    { "HDR", "ForceHDR", &Config::ForceHDR, Restart },
+    { "HDR", "UseHDR10", &Config::UseHDR10, Restart },
+    { "HDR", "SkipColorSpace", &Config::SkipColorSpace, Restart },
+
+    // V-Sync
+    { "V-Sync", "OverrideVsync", &Config::OverrideVsync },
+    { "V-Sync", "ForceVsync", &Config::ForceVsync },
+    { "V-Sync", "SyncInterval", &Config::VsyncInterval, Live, Reject(0, 3) },
+};
+// clang-format on
+
+// Resolved value of a field, the same one CurrentValue formats
+template <typename TField> static auto EffectiveValue(TField& field)
+{
+    using T = typename std::remove_cvref_t<TField>::value_type;
+
+    std::optional<T> value = field;
+
+    if constexpr (requires { field.value_or_default(); })
+        value = field.value_or_default();
+
+    return value;
+}
+
+template <typename T> static std::optional<T> ApplyRange(T value, const ConfigRange& range)
+{
+    auto number = (double) value;
+
+    switch (range.mode)
+    {
+    case ConfigRangeMode::Clamp:
+        return (T) std::clamp(number, range.min, range.max);
+
+    case ConfigRangeMode::Reject:
+        if (range.alsoAllowed.has_value() && number == range.alsoAllowed.value())
+            return value;
+
+        if (number < range.min || number > range.max)
+            return std::nullopt;
+
+        return value;
+
+    default:
+        return value;
+    }
+}
+
+template <typename T> static std::optional<T> ParseValue(const std::string& raw, const ConfigOption& option)
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        return ConfigSchema::ParseBool(raw);
+    }
+    else if constexpr (std::is_same_v<T, int> || std::is_same_v<T, uint32_t> || std::is_same_v<T, float>)
+    {
+        std::optional<T> value;
+
+        if constexpr (std::is_same_v<T, int>)
+            value = ConfigSchema::ParseInt(raw);
+        else if constexpr (std::is_same_v<T, uint32_t>)
+            value = ConfigSchema::ParseUInt(raw);
+        else
+            value = ConfigSchema::ParseFloat(raw);
+
+        if (!value.has_value())
+            return std::nullopt;
+
+        return ApplyRange(value.value(), option.range);
+    }
+    else
+    {
+        std::string value = raw;
+
+        if (option.flags & ConfigOption_Lowercase)
+            std::ranges::transform(value, value.begin(), [](unsigned char c) { return std::tolower(c); });
+
+        if constexpr (std::is_same_v<T, std::wstring>)
+            return string_to_wstring(value);
+        else
+            return value;
+    }
+}
+
+// Same output as std::format("{:#x}")
+template <typename T> static std::string FormatHex(T value)
+{
+    if constexpr (std::is_signed_v<T>)
+    {
+        if (value < 0)
+            return "-" + FormatHex(0 - (uint64_t) (int64_t) value);
+    }
+
+    char digits[16];
+    auto result = std::to_chars(digits, std::end(digits), (uint64_t) value, 16);
+    return "0x" + std::string(digits, result.ptr);
+}
+
+template <typename T> static std::string FormatValue(const std::optional<T>& value, const ConfigOption& option)
+{
+    if (!value.has_value())
+        return "auto";
+
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        return value.value() ? "true" : "false";
+    }
+    else if constexpr (std::is_same_v<T, int> || std::is_same_v<T, uint32_t>)
+    {
+        auto hex = (option.flags & ConfigOption_Hex) ||
+                   ((option.flags & ConfigOption_HexWhenPositive) && value.value() > 0);
+
+        if (hex)
+            return FormatHex(value.value());
+
+        return std::to_string(value.value());
+    }
+    else if constexpr (std::is_same_v<T, float>)
+    {
+        return std::to_string(value.value());
+    }
+    else if constexpr (std::is_same_v<T, std::wstring>)
+    {
+        return wstring_to_string(value.value());
+    }
+    else
+    {
+        return value.value();
+    }
+}
+
+std::span<const ConfigOption> ConfigSchema::Options() { return ConfigOptions; }
+
+const ConfigOption* ConfigSchema::Find(std::string_view section, std::string_view key)
+{
+    for (const auto& option : ConfigOptions)
+    {
+        if (section == option.section && key == option.key)
+            return &option;
+    }
+
+    return nullptr;
+}
+
+void ConfigSchema::Load(Config* config, const ReadFunction& read)
+{
+    for (const auto& option : ConfigOptions)
+    {
+        std::visit(
+            [&](auto member)
+            {
+                auto& field = config->*member;
+                using T = typename std::remove_cvref_t<decltype(field)>::value_type;
+
+                std::optional<T> value;
+
+                if (auto raw = read(option.section, option.key); raw.has_value())
+                {
+                    value = ParseValue<T>(raw.value(), option);
+
+                    if (!value.has_value())
+                        LOG_WARN("Invalid value for {}.{}: {}", option.section, option.key, raw.value());
+                }
+
+                field.set_from_config(value);
+            },
+            option.field);
+    }
+
+    _loadedValues.clear();
+    _loadedValues.reserve(std::size(ConfigOptions));
+
+    // Typed, only the few string options keep a copy
+    for (const auto& option : ConfigOptions)
+    {
+        std::visit(
+            [&](auto member)
+            {
+                auto value = EffectiveValue(config->*member);
+                _loadedValues.emplace_back(std::in_place_type<decltype(value)>, std::move(value));
+            },
+            option.field);
+    }
+}
+
+void ConfigSchema::Save(Config* config, const WriteFunction& write)
+{
+    for (const auto& option : ConfigOptions)
+    {
+        if (option.flags & ConfigOption_NotSaved)
+            continue;
+
+        std::visit(
+            [&](auto member)
+            {
+                auto& field = config->*member;
+                using T = typename std::remove_cvref_t<decltype(field)>::value_type;
+
+                std::optional<T> value;
+
+                if constexpr (requires { field.value_for_config(true); })
+                {
+                    if (option.flags & ConfigOption_IgnoreDefault)
+                        value = field.value_for_config_ignore_default();
+                    else
+                        value = field.value_for_config((option.flags & ConfigOption_ForceSave) != 0);
+                }
+                else
+                {
+                    value = field.value_for_config();
+                }
+
+                write(option.section, option.key, FormatValue(value, option));
+            },
+            option.field);
+    }
+}
+
+std::string ConfigSchema::CurrentValue(Config* config, const ConfigOption& option)
+{
+    return std::visit([&](auto member) { return FormatValue(EffectiveValue(config->*member), option); },
+                      option.field);
+}
+
+std::optional<std::string> ConfigSchema::Normalize(const ConfigOption& option, std::string_view raw)
+{
+    if (raw.size() == 4 && _strnicmp(raw.data(), "auto", 4) == 0)
+        return std::nullopt;
+
+    return std::visit(
+        [&](auto member) -> std::optional<std::string>
+        {
+            using T = typename std::remove_cvref_t<decltype(std::declval<Config>().*member)>::value_type;
+
+            auto value = ParseValue<T>(std::string(raw), option);
+
+            if (!value.has_value())
+                return std::nullopt;
+
+            return FormatValue(value, option);
+        },
+        option.field);
+}
+
+bool ConfigSchema::Apply(Config* config, const ConfigOption& option, const std::optional<std::string>& raw)
+{
+    auto before = CurrentValue(config, option);
+
+    std::visit(
+        [&](auto member)
+        {
+            auto& field = config->*member;
+            using T = typename std::remove_cvref_t<decltype(field)>::value_type;
+
+            std::optional<T> value;
+
+            if (raw.has_value())
+                value = ParseValue<T>(raw.value(), option);
+
+            field = value;
+        },
+        option.field);
+
+    return CurrentValue(config, option) != before;
+}
+
+std::vector<const ConfigOption*> ConfigSchema::ChangedSinceLoad(Config* config, ConfigScope scope)
+{
+    std::vector<const ConfigOption*> result;
+
+    if (_loadedValues.size() != std::size(ConfigOptions))
+        return result;
+
+    for (size_t i = 0; i < std::size(ConfigOptions); i++)
+    {
+        const auto& option = ConfigOptions[i];
+
+        if (option.scope != scope)
+            continue;
+
+        auto changed = std::visit(
+            [&](auto member)
+            {
+                auto current = EffectiveValue(config->*member);
+                auto loaded = std::get_if<decltype(current)>(&_loadedValues[i]);
+
+                return loaded == nullptr || *loaded != current;
+            },
+            option.field);
+
+        if (changed)
+            result.push_back(&option);
+    }
+
+    return result;
+}
+
+static std::string_view TrimLeadingSpaces(std::string_view value)
+{
+    while (!value.empty() && std::isspace((unsigned char) value.front()))
+        value.remove_prefix(1);
+
+    return value;
+}
+
+std::optional<int> ConfigSchema::ParseInt(std::string_view value)
+{
+    value = TrimLeadingSpaces(value);
+
+    int base = 10;
+    bool negative = false;
+
+    // Signs are only taken for decimal values, std::stoi doesn't allow them after the 0x prefix
+    if (value.size() > 2 && value[0] == '0' && (value[1] == 'x' || value[1] == 'X'))
+    {
+        base = 16;
+        value.remove_prefix(2);
+    }
+    else if (!value.empty() && (value[0] == '-' || value[0] == '+'))
+    {
+        negative = value[0] == '-';
+        value.remove_prefix(1);
+    }
+
+    // from_chars would take a second sign
+    if (value.empty() || value[0] == '-' || value[0] == '+')
+        return std::nullopt;
+
+    int64_t result = 0;
+    auto end = value.data() + value.size();
+    auto [ptr, ec] = std::from_chars(value.data(), end, result, base);
+
+    if (ec != std::errc() || ptr != end)
+        return std::nullopt;
+
+    if (negative)
+        result = -result;
+
+    // Hex values are limited to the int range too, like std::stoi
+    if (result < INT32_MIN || result > INT32_MAX)
+        return std::nullopt;
+
+    return (int) result;
+}
+
+std::optional<uint32_t> ConfigSchema::ParseUInt(std::string_view value)
+{
+    // Unsigned options were always read as int, negative values wrap as they did
+    auto result = ParseInt(value);
+
+    if (!result.has_value())
+        return std::nullopt;
+
+    return (uint32_t) result.value();
+}
+
+std::optional<float> ConfigSchema::ParseFloat(std::string_view value)
+{
+    value = TrimLeadingSpaces(value);
+
+    auto digits = value;
+
+    if (!digits.empty() && (digits[0] == '-' || digits[0] == '+'))
+        digits.remove_prefix(1);
+
+    // Stream extraction only reads decimal numbers, from_chars would also take inf and nan
+    if (digits.empty() || !(std::isdigit((unsigned char) digits[0]) || digits[0] == '.'))
+        return std::nullopt;
+
+    // from_chars doesn't take a plus sign
+    if (value[0] == '+')
+        value.remove_prefix(1);
+
+    float result = 0.0f;
+    auto end = value.data() + value.size();
+    auto [ptr, ec] = std::from_chars(value.data(), end, result);
+
+    if (ec != std::errc() || ptr != end)
+        return std::nullopt;
+
+    return result;
+}
+
+std::optional<bool> ConfigSchema::ParseBool(std::string_view value)
+{
+    auto equals = [](std::string_view a, std::string_view b)
+    {
+        return std::ranges::equal(a, b, [](unsigned char x, unsigned char y)
+                                  { return std::tolower(x) == std::tolower(y); });
+    };
+
+    if (equals(value, "true"))
+        return true;
+
+    if (equals(value, "false"))
+        return false;
+
+    return std::nullopt;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <pch.h>
+
+#include <Config.h>
+
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+// What is needed for a change of the option to take effect
+enum class ConfigScope : uint8_t
+{
+    Live,      // Read every frame or on use
+    FrameGen,  // FG context needs to be recreated
+    Swapchain, // FG context and swapchain need to be recreated
+    Reinit,    // Upscaler needs to be recreated
+    Restart,   // Only read during startup
+};
+
+enum class ConfigRangeMode : uint8_t
+{
+    None,
+    Clamp,  // Out of range values are clamped
+    Reject, // Out of range values are treated as auto
+};
+
+struct ConfigRange
+{
+    ConfigRangeMode mode = ConfigRangeMode::None;
+    double min = 0.0;
+    double max = 0.0;
+
+    // Accepted even when it's out of range, like DLSS preset default
+    std::optional<double> alsoAllowed;
+};
+
+enum ConfigOptionFlags : uint32_t
+{
+    ConfigOption_None = 0,
+    ConfigOption_Lowercase = 1 << 0,       // String value is lowercased while loading
+    ConfigOption_Hex = 1 << 1,             // Saved as hex
+    ConfigOption_HexWhenPositive = 1 << 2, // Saved as hex unless it's negative, used for key codes
+    ConfigOption_ForceSave = 1 << 3,       // Saved even when it's the default value
+    ConfigOption_IgnoreDefault = 1 << 4,   // Saved even when it's the default value, volatile values too
+    ConfigOption_NotSaved = 1 << 5,        // Only read from the ini
+};
+
+using ConfigField =
+    std::variant<CustomOptional<bool> Config::*, CustomOptional<bool, NoDefault> Config::*,
+                 CustomOptional<int> Config::*, CustomOptional<int, NoDefault> Config::*,
+                 CustomOptional<uint32_t> Config::*, CustomOptional<uint32_t, NoDefault> Config::*,
+                 CustomOptional<float> Config::*, CustomOptional<float, NoDefault> Config::*,
+                 CustomOptional<std::string, SoftDefault> Config::*, CustomOptional<std::string, NoDefault> Config::*,
+                 CustomOptional<std::wstring> Config::*, CustomOptional<std::wstring, NoDefault> Config::*>;
+
+struct ConfigOption
+{
+    const char* section = nullptr;
+    const char* key = nullptr;
+    ConfigField field;
+    ConfigScope scope = ConfigScope::Live;
+    ConfigRange range {};
+    uint32_t flags = ConfigOption_None;
+};
+
+// Table of the ini options which are a plain value of a Config field.
+// Loading, saving and change tracking are generated from it, options with
+// custom parsing (FGInput, LogFile, Plugins path etc.) are still handled in Config.
+class ConfigSchema
+{
+  public:
+    // Returns the raw ini value, nullopt for missing or auto
+    typedef std::function<std::optional<std::string>(const char* section, const char* key)> ReadFunction;
+    typedef std::function<void(const char* section, const char* key, const std::string& value)> WriteFunction;
+
+    static std::span<const ConfigOption> Options();
+    static const ConfigOption* Find(std::string_view section, std::string_view key);
+
+    static void Load(Config* config, const ReadFunction& read);
+    static void Save(Config* config, const WriteFunction& write);
+
+    // Current value as it would be shown in the ini, defaults are resolved
+    static std::string CurrentValue(Config* config, const ConfigOption& option);
+
+    // Raw ini value in the format Save writes it, nullopt for auto and invalid values
+    static std::optional<std::string> Normalize(const ConfigOption& option, std::string_view raw);
+
+    // Overwrites the field with an ini value, unlike Load. Returns true if the effective value changed
+    static bool Apply(Config* config, const ConfigOption& option, const std::optional<std::string>& raw);
+
+    // Options changed since the last Load, filtered by scope
+    static std::vector<const ConfigOption*> ChangedSinceLoad(Config* config, ConfigScope scope);
+
+    // Accept the same input as the std::stoi and stream based readers they replaced
+    static std::optional<int> ParseInt(std::string_view value);
+    static std::optional<uint32_t> ParseUInt(std::string_view value);
+    static std::optional<float> ParseFloat(std::string_view value);
+    static std::optional<bool> ParseBool(std::string_view value);
+
+  private:
+    using LoadedValue = std::variant<std::optional<bool>, std::optional<int>, std::optional<uint32_t>,
+                                     std::optional<float>, std::optional<std::string>, std::optional<std::wstring>>;
+
+    inline static std::vector<LoadedValue> _loadedValues;
+};
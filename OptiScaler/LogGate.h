@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// Only pointers to the loggers are kept here, so the gate builds without spdlog
+namespace spdlog
+{
+class logger;
+}
+
+// Log categories with their own runtime levels. A file logs to one by redefining
+// LOG_CATEGORY after its includes, everything else logs as General
+enum class LogCategory : uint32_t
+{
+    General,
+    ResTrack,
+    Hudfix,
+    FG,
+    Spoofing,
+    Loader,
+    Menu,
+
+    Count
+};
+
+// Checked by the log macros before any argument is evaluated, so a disabled
+// call site only costs a relaxed load and a compare
+class LogGate
+{
+    static constexpr int Inherit = -1;
+
+    inline static std::atomic<int> _levels[(size_t) LogCategory::Count] { 2, 2, 2, 2, 2, 2, 2 };
+    inline static std::atomic<int> _overrides[(size_t) LogCategory::Count] { -1, -1, -1, -1, -1, -1, -1 };
+    inline static std::atomic<int> _global = 2;
+
+    // Shares the sinks of the default logger and passes everything the gate let through
+    inline static std::shared_ptr<spdlog::logger> _gatedLogger;
+    inline static std::atomic<spdlog::logger*> _gated = nullptr;
+
+    static void Apply();
+    static spdlog::logger* DefaultLogger();
+
+  public:
+    static bool Enabled(LogCategory category, int level)
+    {
+        return level >= _levels[(size_t) category].load(std::memory_order_relaxed);
+    }
+
+    // Logger of the macros, the default logger stays at the General level for direct spdlog calls
+    static spdlog::logger* Logger()
+    {
+        auto logger = _gated.load(std::memory_order_relaxed);
+        return logger != nullptr ? logger : DefaultLogger();
+    }
+
+    // Call after replacing the default logger
+    static void Attach();
+
+    // spdlog level
+    static void SetGlobal(int level);
+
+    // Inherit follows the global level
+    static void SetCategory(LogCategory category, int level);
+    static int CategoryLevel(LogCategory category) { return _overrides[(size_t) category].load(); }
+
+    static const char* Name(LogCategory category);
+};
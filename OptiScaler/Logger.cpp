@@ -158,10 +158,11 @@ void PrepareLogger()
                 shared_logger = std::make_shared<spdlog::logger>(logger);
             }
 
-            shared_logger->set_level((spdlog::level::level_enum) Config::Instance()->LogLevel.value_or_default());
             shared_logger->flush_on(spdlog::level::trace);
 
             spdlog::set_default_logger(shared_logger);
+            LogGate::Attach();
+            LogGate::SetGlobal(Config::Instance()->LogLevel.value_or_default());
         }
     }
     catch (const spdlog::spdlog_ex& ex)
@@ -170,8 +171,9 @@ void PrepareLogger()
 
         auto logger = spdlog::stdout_color_mt("xess");
         logger->set_pattern("[%H:%M:%S.%f] [%L] %v");
-        logger->set_level((spdlog::level::level_enum) 2);
         spdlog::set_default_logger(logger);
+        LogGate::Attach();
+        LogGate::SetGlobal(2);
     }
 }
 
@@ -179,4 +181,85 @@ void CloseLogger()
 {
     spdlog::default_logger()->flush();
     spdlog::shutdown();
+    LogGate::Attach();
+}
+
+void LogGate::Apply()
+{
+    auto global = _global.load();
+    auto lowest = global;
+
+    for (size_t i = 0; i < (size_t) LogCategory::Count; i++)
+    {
+        auto level = _overrides[i].load();
+
+        // Off turns every category off
+        if (level == Inherit || global == SPDLOG_LEVEL_OFF)
+            level = global;
+
+        _levels[i].store(level, std::memory_order_relaxed);
+        lowest = (std::min)(lowest, level);
+    }
+
+    // Gate filters per category, its logger only needs to pass the lowest one. Direct spdlog
+    // calls have no category and log as General.
+    if (auto gated = _gated.load())
+        gated->set_level((spdlog::level::level_enum) lowest);
+
+    spdlog::default_logger()->set_level(
+        (spdlog::level::level_enum) _levels[(size_t) LogCategory::General].load(std::memory_order_relaxed));
+}
+
+spdlog::logger* LogGate::DefaultLogger() { return spdlog::default_logger_raw(); }
+
+void LogGate::Attach()
+{
+    // Raw pointer like spdlog::default_logger_raw, loggers are only replaced while preparing or closing
+    if (spdlog::default_logger_raw() == nullptr)
+    {
+        _gated.store(nullptr);
+        _gatedLogger.reset();
+        return;
+    }
+
+    auto logger = spdlog::default_logger()->clone("gated");
+    _gated.store(logger.get());
+    _gatedLogger = logger;
+
+    Apply();
+}
+
+void LogGate::SetGlobal(int level)
+{
+    _global.store(level);
+    Apply();
+}
+
+void LogGate::SetCategory(LogCategory category, int level)
+{
+    _overrides[(size_t) category].store(level);
+    Apply();
+}
+
+const char* LogGate::Name(LogCategory category)
+{
+    switch (category)
+    {
+    case LogCategory::General:
+        return "General";
+    case LogCategory::ResTrack:
+        return "Resource Tracking";
+    case LogCategory::Hudfix:
+        return "Hudfix";
+    case LogCategory::FG:
+        return "Frame Generation";
+    case LogCategory::Spoofing:
+        return "Spoofing";
+    case LogCategory::Loader:
+        return "Loader";
+    case LogCategory::Menu:
+        return "Menu";
+    default:
+        return "Unknown";
+    }
 }
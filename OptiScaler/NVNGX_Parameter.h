@@ -3,6 +3,8 @@
 
 #include "Config.h"
 
+#include <misc/DynamicResolution.h>
+
 #include <ankerl/unordered_dense.h>
 
 // Use real NVNGX params encapsulated in custom one
@@ -22,6 +24,10 @@ inline static std::optional<float> GetQualityOverrideRatio(const NVSDK_NGX_PerfQ
 {
     std::optional<float> output;
 
+    // Dynamic resolution controller picks the ratio itself
+    if (auto dynamicRatio = DynamicResolution::Ratio(); dynamicRatio.has_value())
+        return dynamicRatio;
+
     auto sliderLimit = Config::Instance()->ExtendedLimits.value_or_default() ? 0.1f : 1.0f;
 
     if (Config::Instance()->UpscaleRatioOverrideEnabled.value_or_default() &&
@@ -169,8 +175,20 @@ inline static NVSDK_NGX_Result NVSDK_CONV NVSDK_NGX_DLSS_GetOptimalSettingsCallb
     InParams->Set(NVSDK_NGX_Parameter_OutWidth, OutWidth);
     InParams->Set(NVSDK_NGX_Parameter_OutHeight, OutHeight);
 
+    // Games which query once and pick their own size in the DRS range would be stuck at the size
+    // of that query, the controller's whole range is given to them instead
+    auto controllerRange = DynamicResolution::RatioRange();
+
     // DRS minimum resolution
-    if (Config::Instance()->DrsMinOverrideEnabled.value_or_default() || enumPQValue == NVSDK_NGX_PerfQuality_Value_DLAA)
+    if (controllerRange.has_value())
+    {
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Min_Render_Width,
+                      (unsigned int) ((float) Width / controllerRange->second));
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Min_Render_Height,
+                      (unsigned int) ((float) Height / controllerRange->second));
+    }
+    else if (Config::Instance()->DrsMinOverrideEnabled.value_or_default() ||
+             enumPQValue == NVSDK_NGX_PerfQuality_Value_DLAA)
     {
         InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Min_Render_Width, OutWidth);
         InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Min_Render_Height, OutHeight);
@@ -202,8 +220,14 @@ inline static NVSDK_NGX_Result NVSDK_CONV NVSDK_NGX_DLSS_GetOptimalSettingsCallb
     }
 
     // DRS maximum resolution
-
-    if (Config::Instance()->DrsMaxOverrideEnabled.value_or_default())
+    if (controllerRange.has_value())
+    {
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Width,
+                      (unsigned int) ((float) Width / controllerRange->first));
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Height,
+                      (unsigned int) ((float) Height / controllerRange->first));
+    }
+    else if (Config::Instance()->DrsMaxOverrideEnabled.value_or_default())
     {
         InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Width, OutWidth);
         InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Height, OutHeight);
@@ -323,8 +347,18 @@ inline static NVSDK_NGX_Result NVSDK_CONV NVSDK_NGX_DLSSD_GetOptimalSettingsCall
     InParams->Set(NVSDK_NGX_Parameter_OutWidth, OutWidth);
     InParams->Set(NVSDK_NGX_Parameter_OutHeight, OutHeight);
 
+    // Whole range of the controller, see NVSDK_NGX_DLSS_GetOptimalSettingsCallback
+    auto controllerRange = DynamicResolution::RatioRange();
+
     // DRS minimum resolution
-    if (Config::Instance()->DrsMinOverrideEnabled.value_or_default())
+    if (controllerRange.has_value())
+    {
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Min_Render_Width,
+                      (unsigned int) ((float) Width / controllerRange->second));
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Min_Render_Height,
+                      (unsigned int) ((float) Height / controllerRange->second));
+    }
+    else if (Config::Instance()->DrsMinOverrideEnabled.value_or_default())
     {
         InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Min_Render_Width, OutWidth);
         InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Min_Render_Height, OutHeight);
@@ -353,7 +387,14 @@ inline static NVSDK_NGX_Result NVSDK_CONV NVSDK_NGX_DLSSD_GetOptimalSettingsCall
     }
 
     // DRS maximum resolution
-    if (Config::Instance()->DrsMaxOverrideEnabled.value_or_default())
+    if (controllerRange.has_value())
+    {
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Width,
+                      (unsigned int) ((float) Width / controllerRange->first));
+        InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Height,
+                      (unsigned int) ((float) Height / controllerRange->first));
+    }
+    else if (Config::Instance()->DrsMaxOverrideEnabled.value_or_default())
     {
         InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Width, OutWidth);
         InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Height, OutHeight);
@@ -52,6 +52,8 @@ typedef struct CapturedHudlessInfo
     UINT64 usageCount = 1;
     UINT captureInfo = 0;
     bool enabled = true;
+    // ResourceLifetime_Dx12 id of the resource the entry was made for, the address can be reused
+    uint64_t watchId = 0;
 } captured_hudless_info;
 
 class State
@@ -3,6 +3,9 @@
 #include "Util.h"
 #include "Config.h"
 
+#include <misc/ModuleMap.h>
+#include <misc/ModuleVersionCache.h>
+
 #include <shlobj.h>
 
 typedef LONG(WINAPI* RtlGetVersionPtr)(PRTL_OSVERSIONINFOW);
@@ -20,10 +23,11 @@ static IID streamlineRiid {};
 /// <returns>Caller module filename</returns>
 std::string Util::WhoIsTheCaller(void* returnAddress)
 {
-    char callerPath[MAX_PATH] = { 0 };
+    // Lowercase, CheckDllName and the other callers compare case insensitive
+    if (auto name = ModuleMap::NameOf(returnAddress); !name.empty())
+        return std::string(name);
 
-    // Get the return address from the current function call.
-    // void* returnAddress = _ReturnAddress();
+    char callerPath[MAX_PATH] = { 0 };
 
     // Get the base address of the module containing the return address.
     if (HMODULE hModule = GetCallerModule(returnAddress); hModule != nullptr)
@@ -40,6 +44,9 @@ std::string Util::WhoIsTheCaller(void* returnAddress)
 
 HMODULE Util::GetCallerModule(void* returnAddress)
 {
+    if (auto hModule = ModuleMap::ModuleOf(returnAddress); hModule != nullptr)
+        return hModule;
+
     HMODULE hModule = NULL;
 
     GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
@@ -299,6 +306,20 @@ static inline std::string LogLastError()
 
 bool Util::GetDLLVersion(std::wstring dllPath, version_t* versionOut)
 {
+    // Read from the file or the cache of the previous launches, version.dll is the fallback
+    if (auto version = ModuleVersionCache::FileVersion(dllPath); version.has_value())
+    {
+        if (versionOut != nullptr)
+        {
+            versionOut->major = version->major;
+            versionOut->minor = version->minor;
+            versionOut->patch = version->patch;
+            versionOut->reserved = version->build;
+        }
+
+        return true;
+    }
+
     // Step 1: Get the size of the version information
     DWORD handle = 0;
     DWORD versionSize = GetFileVersionInfoSizeW(dllPath.c_str(), &handle);
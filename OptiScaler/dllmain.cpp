@@ -41,6 +41,11 @@
 
 #include <cwctype>
 #include <version_check.h>
+#include <ConfigReload.h>
+#include <misc/StartupScheduler.h>
+#include <misc/ModuleMap.h>
+#include <misc/GpuInventory.h>
+#include <misc/ModuleVersionCache.h>
 
 static std::vector<HMODULE> _asiHandles;
 
@@ -999,6 +1004,9 @@ static void CheckWorkingMode()
             // Version check
             if (Config::Instance()->CheckForUpdate.value_or_default())
                 VersionCheck::Start();
+
+            if (Config::Instance()->HotReloadIni.value_or_default())
+                ConfigReload::Start(Config::Instance()->IniPath());
         }
 
         return;
@@ -1494,6 +1502,7 @@ static void CheckQuirks()
     }
 
     State::Instance().gameQuirks = quirks;
+    VulkanHooks::UpdateBarrierRules();
 
     printQuirks(quirks);
 }
@@ -1502,6 +1511,14 @@ bool isNvidia()
 {
     bool nvidiaDetected = false;
     bool loadedHere = false;
+
+    // No need to load nvapi when D3DKMT already listed every adapter
+    if (auto gpus = GpuInventory::Capabilities(); gpus.known && !gpus.nvidiaPresent)
+    {
+        LOG_DEBUG("No Nvidia adapter, detected: {}", nvidiaDetected);
+        return nvidiaDetected;
+    }
+
     auto nvapiModule = GetDllNameWModule(&nvapiNamesW);
 
     if (!nvapiModule)
@@ -1570,9 +1587,275 @@ bool isNvidia()
     return nvidiaDetected;
 }
 
-BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserved)
+// Recursive searches of the game folder, can take a while on big installs
+static void FindDlssFiles()
+{
+    if (!State::Instance().isRunningOnNvidia || !Config::Instance()->DLSSEnabled.value_or_default())
+        return;
+
+    auto exePath = Util::ExePath().remove_filename();
+    State::Instance().NVNGX_DLSS_Path = Util::FindFilePath(exePath, "nvngx_dlss.dll");
+    State::Instance().NVNGX_DLSSD_Path = Util::FindFilePath(exePath, "nvngx_dlssd.dll");
+    State::Instance().NVNGX_DLSSG_Path = Util::FindFilePath(exePath, "nvngx_dlssg.dll");
+
+    if (State::Instance().NVNGX_DLSS_Path.has_value())
+    {
+        spdlog::info("Enabling DLSS");
+        Config::Instance()->DLSSEnabled.set_volatile_value(true);
+    }
+    else
+    {
+        spdlog::warn("nvngx_dlss.dll not found, disabling DLSS");
+        Config::Instance()->DLSSEnabled.set_volatile_value(false);
+    }
+}
+
+static void CheckNvidia()
+{
+    // Check if real DLSS available
+    if (Config::Instance()->DLSSEnabled.value_or_default())
+    {
+        spdlog::info("");
+        State::Instance().isRunningOnNvidia = isNvidia();
+
+        if (State::Instance().isRunningOnNvidia)
+        {
+            spdlog::info("Running on Nvidia");
+
+            // Until the game asks nvapi for the arch info
+            if (GpuInventory::Capabilities().pascalOrOlder)
+                State::Instance().isPascalOrOlder = true;
+
+            VulkanHooks::UpdateBarrierRules();
+
+            if (!Config::Instance()->DxgiSpoofing.has_value())
+            {
+                spdlog::info("Disabling DxgiSpoofing");
+                Config::Instance()->DxgiSpoofing.set_volatile_value(false);
+            }
+
+            // StreamlineSpoofing is more selective on Nvidia now
+            // if (!Config::Instance()->StreamlineSpoofing.has_value())
+            //    Config::Instance()->StreamlineSpoofing.set_volatile_value(false);
+        }
+        else
+        {
+            spdlog::info("Not running on Nvidia, disabling DLSS");
+            Config::Instance()->DLSSEnabled.set_volatile_value(false);
+        }
+    }
+    else
+    {
+        spdlog::info("Not running on Nvidia, disabling DLSS");
+        Config::Instance()->DLSSEnabled.set_volatile_value(false);
+    }
+}
+
+static void SetEnvironment()
+{
+    // OptiFG & Overlay Checks
+    // TODO: Either FGInput == FGInput::Upscaler or FGOutput == FGOutput::FSRFG
+    if ((Config::Instance()->FGInput.value_or_default() == FGInput::Upscaler) &&
+        !Config::Instance()->DisableOverlays.has_value())
+        Config::Instance()->DisableOverlays.set_volatile_value(true);
+
+    if (Config::Instance()->DisableOverlays.value_or_default())
+    {
+        _wputenv_s(L"SteamNoOverlayUIDrawing", L"1");
+        SetEnvironmentVariableW(L"SteamNoOverlayUIDrawing", L"1");
+    }
+
+    // FSR4 Watermark, overrides environment variable only if set in config
+    if (Config::Instance()->Fsr4EnableWatermark.has_value())
+    {
+        if (Config::Instance()->Fsr4EnableWatermark.value())
+        {
+            _wputenv_s(L"MLSR-WATERMARK", L"1");
+            SetEnvironmentVariableW(L"MLSR-WATERMARK", L"1");
+
+            if (!Config::Instance()->FpsOverlayPos.has_value())
+                Config::Instance()->FpsOverlayPos.set_volatile_value(1); // Top right
+        }
+        else
+        {
+            _wputenv_s(L"MLSR-WATERMARK", L"0");
+            SetEnvironmentVariableW(L"MLSR-WATERMARK", L"0");
+        }
+    }
+
+    if (Config::Instance()->FSRFGEnableWatermark.has_value())
+    {
+        if (Config::Instance()->FSRFGEnableWatermark.value())
+        {
+            _wputenv_s(L"MLFI-WATERMARK", L"1");
+            SetEnvironmentVariableW(L"MLFI-WATERMARK", L"1");
+
+            if (!Config::Instance()->FpsOverlayPos.has_value())
+                Config::Instance()->FpsOverlayPos.set_volatile_value(1); // Top right
+        }
+        else
+        {
+            _wputenv_s(L"MLFI-WATERMARK", L"0");
+            SetEnvironmentVariableW(L"MLFI-WATERMARK", L"0");
+        }
+    }
+}
+
+static void CheckWineAndNvapi()
+{
+    // Check for Wine
+    spdlog::info("");
+    State::Instance().isRunningOnLinux = IsRunningOnWine();
+    State::Instance().isRunningOnDXVK = State::Instance().isRunningOnLinux;
+
+    if (!Config::Instance()->OverrideNvapiDll.has_value())
+    {
+        spdlog::info("OverrideNvapiDll not set, setting it to: {}",
+                     !State::Instance().isRunningOnNvidia ? "true" : "false");
+        Config::Instance()->OverrideNvapiDll.set_volatile_value(!State::Instance().isRunningOnNvidia);
+
+        // Try to load fakenvapi.dll as the main nvapi if not on Nvidia
+        if (!State::Instance().isRunningOnNvidia && !Config::Instance()->NvapiDllPath.has_value())
+            Config::Instance()->NvapiDllPath.set_volatile_value(L"fakenvapi.dll");
+    }
+}
+
+static void CheckNvngxReplacement()
+{
+    if (!Config::Instance()->DxgiSpoofing.has_value() && !State::Instance().nvngxReplacement.has_value())
+    {
+        LOG_WARN("Nvngx replacement not found!");
+
+        if (!State::Instance().nvngxExists)
+        {
+            LOG_WARN("nvngx.dll not found! - disabling spoofing");
+            Config::Instance()->DxgiSpoofing.set_volatile_value(false);
+        }
+    }
+}
+
+// Export lookups and opt-in pattern scans, they stay in DllMain
+// because Detours transactions can't run on two threads at once
+static void HookExeInputs()
 {
     HMODULE handle = nullptr;
+
+    if (Config::Instance()->EnableFsr2Inputs.value_or_default())
+    {
+        spdlog::info("");
+
+        if (Config::Instance()->UseFsr2VulkanInputs.value_or_default())
+            HookFSR2VkExeInputs();
+        else if (Config::Instance()->UseFsr2Dx11Inputs.value_or_default())
+            HookFSR2Dx11ExeInputs();
+        else
+        {
+            handle = GetDllNameWModule(&fsr2NamesW);
+            if (handle != nullptr)
+                HookFSR2Inputs(handle);
+
+            handle = GetDllNameWModule(&fsr2BENamesW);
+            if (handle != nullptr)
+                HookFSR2Dx12Inputs(handle);
+
+            HookFSR2ExeInputs();
+        }
+    }
+
+    if (Config::Instance()->EnableFsr3Inputs.value_or_default())
+    {
+        handle = GetDllNameWModule(&fsr3NamesW);
+        if (handle != nullptr)
+            HookFSR3Inputs(handle);
+
+        handle = GetDllNameWModule(&fsr3BENamesW);
+        if (handle != nullptr)
+            HookFSR3Dx12Inputs(handle);
+
+        HookFSR3ExeInputs();
+    }
+    // HookFfxExeInputs();
+
+    if (State::Instance().activeFgInput == FGInput::FSRFG30)
+    {
+        FSR3FG::HookFSR3FGInputs();
+        FSR3FG::HookFSR3FGExeInputs();
+    }
+}
+
+// LoaderLock steps keep the old DllMain order. Only the ones nothing in DllMain
+// or the game's first calls into us depends on are moved to the worker.
+static void RegisterStartupSteps(StartupScheduler& startup)
+{
+    constexpr auto LoaderLock = StartupPhase::LoaderLock;
+    constexpr auto Worker = StartupPhase::Worker;
+
+    startup.Add("KernelProxies", LoaderLock, {},
+                []()
+                {
+                    NtdllProxy::Init();
+                    KernelBaseProxy::Init();
+                    Kernel32Proxy::Init();
+                });
+
+    // Caller checks in the hooks attached below use it
+    startup.Add("ModuleMap", LoaderLock, { "KernelProxies" }, ModuleMap::Init);
+
+    startup.Add("Quirks", LoaderLock, { "ModuleMap" },
+                []()
+                {
+                    spdlog::info("");
+                    CheckQuirks();
+                });
+
+    // Check for working mode and attach hooks
+    startup.Add("WorkingMode", LoaderLock, { "Quirks" },
+                []()
+                {
+                    spdlog::info("");
+                    CheckWorkingMode();
+                });
+
+    // Only D3DKMT, no DXGI factory under the loader lock
+    startup.Add("GpuInventory", LoaderLock, { "KernelProxies" }, GpuInventory::Init);
+
+    startup.Add("NvidiaCheck", LoaderLock, { "WorkingMode", "GpuInventory" }, CheckNvidia);
+    startup.Add(StartupSteps::DlssFiles, Worker, { "NvidiaCheck" }, FindDlssFiles);
+    startup.Add("Environment", LoaderLock, { "Quirks" }, SetEnvironment);
+
+    // Hook FSR4 stuff as early as possible
+    startup.Add("FSR4Update", LoaderLock, { "WorkingMode" },
+                []()
+                {
+                    spdlog::info("");
+                    InitFSR4Update();
+                });
+
+    startup.Add("WineAndNvapi", LoaderLock, { "NvidiaCheck" }, CheckWineAndNvapi);
+
+    // Plugins expect to be loaded before any game code runs
+    startup.Add("AsiPlugins", LoaderLock, { "WorkingMode" },
+                []()
+                {
+                    if (!State::Instance().isWorkingAsNvngx && Config::Instance()->LoadAsiPlugins.value_or_default())
+                    {
+                        spdlog::info("");
+                        LoadAsiPlugins();
+                    }
+                });
+
+    startup.Add("NvngxReplacement", LoaderLock, { "WorkingMode" }, CheckNvngxReplacement);
+    startup.Add("ExeInputs", LoaderLock, { "Quirks" }, HookExeInputs);
+
+    // Only does something when Gdi32 wasn't loaded yet for the GpuInventory step
+    startup.Add("GpuInventoryDeferred", Worker, { "GpuInventory" }, GpuInventory::InitDeferred);
+
+    // Last worker step, versions read during startup are written once and off the loader lock
+    startup.Add("ModuleCache", Worker, { StartupSteps::DlssFiles }, ModuleVersionCache::EndStartup);
+}
+
+BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserved)
+{
     OSVERSIONINFOW winVer { 0 };
 
     switch (ul_reason_for_call)
@@ -1627,191 +1910,11 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         State::Instance().activeFgInput = Config::Instance()->FGInput.value_or_default();
         State::Instance().activeFgOutput = Config::Instance()->FGOutput.value_or_default();
 
-        // Init Kernel proxies
-        NtdllProxy::Init();
-        KernelBaseProxy::Init();
-        Kernel32Proxy::Init();
-
-        spdlog::info("");
-        CheckQuirks();
-
-        // Check for working mode and attach hooks
-        spdlog::info("");
-        CheckWorkingMode();
-
-        // Check if real DLSS available
-        if (Config::Instance()->DLSSEnabled.value_or_default())
-        {
-            spdlog::info("");
-            State::Instance().isRunningOnNvidia = isNvidia();
-
-            if (State::Instance().isRunningOnNvidia)
-            {
-                spdlog::info("Running on Nvidia");
-
-                auto exePath = Util::ExePath().remove_filename();
-                State::Instance().NVNGX_DLSS_Path = Util::FindFilePath(exePath, "nvngx_dlss.dll");
-                State::Instance().NVNGX_DLSSD_Path = Util::FindFilePath(exePath, "nvngx_dlssd.dll");
-                State::Instance().NVNGX_DLSSG_Path = Util::FindFilePath(exePath, "nvngx_dlssg.dll");
-
-                if (State::Instance().NVNGX_DLSS_Path.has_value())
-                {
-                    spdlog::info("Enabling DLSS");
-                    Config::Instance()->DLSSEnabled.set_volatile_value(true);
-                }
-                else
-                {
-                    spdlog::warn("nvngx_dlss.dll not found, disabling DLSS");
-                    Config::Instance()->DLSSEnabled.set_volatile_value(false);
-                }
-
-                if (!Config::Instance()->DxgiSpoofing.has_value())
-                {
-                    spdlog::info("Disabling DxgiSpoofing");
-                    Config::Instance()->DxgiSpoofing.set_volatile_value(false);
-                }
-
-                // StreamlineSpoofing is more selective on Nvidia now
-                // if (!Config::Instance()->StreamlineSpoofing.has_value())
-                //    Config::Instance()->StreamlineSpoofing.set_volatile_value(false);
-            }
-            else
-            {
-                spdlog::info("Not running on Nvidia, disabling DLSS");
-                Config::Instance()->DLSSEnabled.set_volatile_value(false);
-            }
-        }
-        else
-        {
-            spdlog::info("Not running on Nvidia, disabling DLSS");
-            Config::Instance()->DLSSEnabled.set_volatile_value(false);
-        }
-
-        // OptiFG & Overlay Checks
-        // TODO: Either FGInput == FGInput::Upscaler or FGOutput == FGOutput::FSRFG
-        if ((Config::Instance()->FGInput.value_or_default() == FGInput::Upscaler) &&
-            !Config::Instance()->DisableOverlays.has_value())
-            Config::Instance()->DisableOverlays.set_volatile_value(true);
-
-        if (Config::Instance()->DisableOverlays.value_or_default())
-        {
-            _wputenv_s(L"SteamNoOverlayUIDrawing", L"1");
-            SetEnvironmentVariableW(L"SteamNoOverlayUIDrawing", L"1");
-        }
-
-        // FSR4 Watermark, overrides environment variable only if set in config
-        if (Config::Instance()->Fsr4EnableWatermark.has_value())
         {
-            if (Config::Instance()->Fsr4EnableWatermark.value())
-            {
-                _wputenv_s(L"MLSR-WATERMARK", L"1");
-                SetEnvironmentVariableW(L"MLSR-WATERMARK", L"1");
-
-                if (!Config::Instance()->FpsOverlayPos.has_value())
-                    Config::Instance()->FpsOverlayPos.set_volatile_value(1); // Top right
-            }
-            else
-            {
-                _wputenv_s(L"MLSR-WATERMARK", L"0");
-                SetEnvironmentVariableW(L"MLSR-WATERMARK", L"0");
-            }
-        }
-
-        if (Config::Instance()->FSRFGEnableWatermark.has_value())
-        {
-            if (Config::Instance()->FSRFGEnableWatermark.value())
-            {
-                _wputenv_s(L"MLFI-WATERMARK", L"1");
-                SetEnvironmentVariableW(L"MLFI-WATERMARK", L"1");
-
-                if (!Config::Instance()->FpsOverlayPos.has_value())
-                    Config::Instance()->FpsOverlayPos.set_volatile_value(1); // Top right
-            }
-            else
-            {
-                _wputenv_s(L"MLFI-WATERMARK", L"0");
-                SetEnvironmentVariableW(L"MLFI-WATERMARK", L"0");
-            }
-        }
-
-        // Hook FSR4 stuff as early as possible
-        spdlog::info("");
-        InitFSR4Update();
-
-        // Check for Wine
-        spdlog::info("");
-        State::Instance().isRunningOnLinux = IsRunningOnWine();
-        State::Instance().isRunningOnDXVK = State::Instance().isRunningOnLinux;
-
-        if (!Config::Instance()->OverrideNvapiDll.has_value())
-        {
-            spdlog::info("OverrideNvapiDll not set, setting it to: {}",
-                         !State::Instance().isRunningOnNvidia ? "true" : "false");
-            Config::Instance()->OverrideNvapiDll.set_volatile_value(!State::Instance().isRunningOnNvidia);
-
-            // Try to load fakenvapi.dll as the main nvapi if not on Nvidia
-            if (!State::Instance().isRunningOnNvidia && !Config::Instance()->NvapiDllPath.has_value())
-                Config::Instance()->NvapiDllPath.set_volatile_value(L"fakenvapi.dll");
-        }
-
-        // Asi plugins
-        if (!State::Instance().isWorkingAsNvngx && Config::Instance()->LoadAsiPlugins.value_or_default())
-        {
-            spdlog::info("");
-            LoadAsiPlugins();
-        }
-
-        if (!Config::Instance()->DxgiSpoofing.has_value() && !State::Instance().nvngxReplacement.has_value())
-        {
-            LOG_WARN("Nvngx replacement not found!");
-
-            if (!State::Instance().nvngxExists)
-            {
-                LOG_WARN("nvngx.dll not found! - disabling spoofing");
-                Config::Instance()->DxgiSpoofing.set_volatile_value(false);
-            }
-        }
-
-        if (Config::Instance()->EnableFsr2Inputs.value_or_default())
-        {
-            spdlog::info("");
-
-            if (Config::Instance()->UseFsr2VulkanInputs.value_or_default())
-                HookFSR2VkExeInputs();
-            else if (Config::Instance()->UseFsr2Dx11Inputs.value_or_default())
-                HookFSR2Dx11ExeInputs();
-            else
-            {
-                handle = GetDllNameWModule(&fsr2NamesW);
-                if (handle != nullptr)
-                    HookFSR2Inputs(handle);
-
-                handle = GetDllNameWModule(&fsr2BENamesW);
-                if (handle != nullptr)
-                    HookFSR2Dx12Inputs(handle);
-
-                HookFSR2ExeInputs();
-            }
-        }
-
-        if (Config::Instance()->EnableFsr3Inputs.value_or_default())
-        {
-            handle = GetDllNameWModule(&fsr3NamesW);
-            if (handle != nullptr)
-                HookFSR3Inputs(handle);
-
-            handle = GetDllNameWModule(&fsr3BENamesW);
-            if (handle != nullptr)
-                HookFSR3Dx12Inputs(handle);
-
-            HookFSR3ExeInputs();
-        }
-        // HookFfxExeInputs();
-
-        if (State::Instance().activeFgInput == FGInput::FSRFG30)
-        {
-            FSR3FG::HookFSR3FGInputs();
-            FSR3FG::HookFSR3FGExeInputs();
+            // Most of the init has to run here, before the game's next loader call
+            auto& startup = StartupScheduler::Instance();
+            RegisterStartupSteps(startup);
+            startup.RunLoaderLockSteps();
         }
 
         for (size_t i = 0; i < 300; i++)
@@ -1825,10 +1928,15 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         spdlog::info("---------------------------------------------");
         spdlog::info("");
 
+        // Rest runs after the loader lock is released, timeline is logged when it's done
+        StartupScheduler::Instance().StartWorker();
+
         break;
 
     case DLL_PROCESS_DETACH:
         State::Instance().isShuttingDown = true;
+        ConfigReload::Stop(lpReserved != nullptr);
+        ModuleMap::Shutdown();
 
         // Unhooking and cleaning stuff causing issues during shutdown.
         // Disabled for now to check if it cause any issues
@@ -0,0 +1,91 @@
+#include "FG_CopyScheduler.h"
+
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::FG
+
+FG_CopyPath FGCopyScheduler::Classify(FG_ResourceValidity validity, bool hasCmdList)
+{
+    if (!hasCmdList)
+        return FG_CopyPath::Deferred;
+
+    switch (validity)
+    {
+    case FG_ResourceValidity::ValidNow:
+    case FG_ResourceValidity::ValidButMakeCopy:
+        return FG_CopyPath::Inline;
+
+    default:
+        return FG_CopyPath::Deferred;
+    }
+}
+
+FG_CopyPath FGCopyScheduler::Plan(int index, FG_ResourceType type, FG_ResourceValidity validity, bool hasCmdList,
+                                  const void* source) const
+{
+    auto path = Classify(validity, hasCmdList);
+
+    // Content stays valid, the copy was only asked for in case the game touches it before present
+    if (path == FG_CopyPath::Inline && validity == FG_ResourceValidity::ValidButMakeCopy && OverBudget())
+        path = FG_CopyPath::Deferred;
+
+    // Inline copies are never merged, the game can write to the source between them
+    if (path == FG_CopyPath::Deferred && source != nullptr && _slots[index].deferredSource[type] == source)
+        return FG_CopyPath::Merged;
+
+    return path;
+}
+
+void FGCopyScheduler::Record(int index, FG_ResourceType type, FG_CopyPath path, const void* source, uint64_t bytes)
+{
+    auto& slot = _slots[index];
+
+    switch (path)
+    {
+    case FG_CopyPath::Inline:
+        slot.stats.inlineCopies++;
+        slot.stats.inlineBytes += bytes;
+        break;
+
+    case FG_CopyPath::Deferred:
+        slot.stats.deferredCopies++;
+        slot.stats.deferredBytes += bytes;
+        slot.deferredSource[type] = source;
+        break;
+
+    case FG_CopyPath::Merged:
+        slot.stats.mergedCopies++;
+        slot.stats.mergedBytes += bytes;
+        break;
+    }
+}
+
+void FGCopyScheduler::FinishFrame(int index)
+{
+    auto& stats = _slots[index].stats;
+    auto overBudget = stats.inlineBytes > _budgetBytes;
+
+    if (stats.inlineCopies != 0 || stats.deferredCopies != 0 || stats.mergedCopies != 0)
+    {
+        LOG_DEBUG("[{}] inline: {} ({} KB), deferred: {} ({} KB), merged: {} ({} KB)", index, stats.inlineCopies,
+                  stats.inlineBytes / 1024, stats.deferredCopies, stats.deferredBytes / 1024, stats.mergedCopies,
+                  stats.mergedBytes / 1024);
+    }
+
+    // Only the start of a streak is a warning, it usually lasts as long as the game's settings
+    if (overBudget)
+    {
+        if (_holdFrames == 0)
+        {
+            LOG_WARN("Inline FG copies are over budget: {} MB > {} MB, deferring the optional ones",
+                     stats.inlineBytes / (1024 * 1024), _budgetBytes / (1024 * 1024));
+        }
+
+        _holdFrames = HoldFrames;
+    }
+    else if (_holdFrames != 0 && --_holdFrames == 0)
+    {
+        LOG_INFO("Inline FG copies are back within budget");
+    }
+
+    _slots[index] = {};
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <pch.h>
+
+#include "FG_ResourceTypes.h"
+
+enum class FG_CopyPath : uint32_t
+{
+    // On the game's command list where the input was tagged, the only point its content is known to be valid
+    Inline = 0,
+    // On our UI command list, executed on the game queue right before the FG dispatch at present
+    Deferred,
+    // Same source already went through the deferred work of this type in the frame, reuse its output
+    Merged,
+};
+
+struct FG_CopyStats
+{
+    uint32_t inlineCopies = 0;
+    uint32_t deferredCopies = 0;
+    uint32_t mergedCopies = 0;
+
+    uint64_t inlineBytes = 0;
+    uint64_t deferredBytes = 0;
+    uint64_t mergedBytes = 0;
+};
+
+// Decides where copies and format transfers of FG inputs are recorded. Only inputs that must be
+// read right away go on the game's command list, everything that stays valid until present is
+// left to our own list and repeats of it in a frame are merged. Bytes are accounted per frame slot
+// against a budget for the game's timeline, while over it the copies the game only asked for as a
+// precaution are left to our list too. Has no D3D dependencies so decisions can be replayed headless.
+class FGCopyScheduler
+{
+    struct Slot
+    {
+        const void* deferredSource[FG_ResourceType::ResourceTypeCOUNT] {};
+        FG_CopyStats stats;
+    };
+
+    Slot _slots[BUFFER_COUNT] {};
+    uint64_t _budgetBytes;
+
+    // Frames left before optional copies are made inline again
+    uint32_t _holdFrames = 0;
+
+  public:
+    // A 4K RGBA16F target and full size depth and motion vectors fit in
+    static constexpr uint64_t DefaultBudgetBytes = 128ull * 1024 * 1024;
+
+    // Frames without going over before optional copies are tried inline again, keeps it from flipping every frame
+    static constexpr uint32_t HoldFrames = 120;
+
+    explicit FGCopyScheduler(uint64_t budgetBytes = DefaultBudgetBytes) : _budgetBytes(budgetBytes) {}
+
+    // Inputs with a command list and content that may change after tagging have to be copied inline,
+    // the rest are either our own buffers or game resources that are kept until present
+    static FG_CopyPath Classify(FG_ResourceValidity validity, bool hasCmdList);
+
+    // ValidButMakeCopy inputs are deferred while over budget, ValidNow ones are always copied inline
+    FG_CopyPath Plan(int index, FG_ResourceType type, FG_ResourceValidity validity, bool hasCmdList,
+                     const void* source) const;
+
+    // Called once the planned work is recorded, failed work is not recorded so it is never merged with
+    void Record(int index, FG_ResourceType type, FG_CopyPath path, const void* source, uint64_t bytes);
+
+    // Reports the slot before it is reused for a new frame, checks it against the budget and clears it
+    void FinishFrame(int index);
+
+    const FG_CopyStats& Stats(int index) const { return _slots[index].stats; }
+    uint64_t BudgetBytes() const { return _budgetBytes; }
+    bool OverBudget() const { return _holdFrames != 0; }
+};
@@ -0,0 +1,50 @@
+#include "FG_FrameCounter.h"
+
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::FG
+
+bool FGFrameCounter::StartNewFrame()
+{
+    _frameCount++;
+
+    // Dispatch ahead of the frames is left from before a restart
+    if (_lastDispatchedFrame != 0 && _lastDispatchedFrame < _frameCount &&
+        _frameCount - _lastDispatchedFrame <= MaxFramesBehind)
+        return false;
+
+    LOG_WARN("Frame count jumped too much! _frameCount: {}, _lastDispatchedFrame: {}", _frameCount,
+             _lastDispatchedFrame);
+
+    _lastDispatchedFrame = _frameCount - 1;
+    return true;
+}
+
+bool FGFrameCounter::IsBehind(uint32_t allowedAhead) const
+{
+    if (_lastDispatchedFrame == 0 || _lastDispatchedFrame > _frameCount)
+        return true;
+
+    return _frameCount - _lastDispatchedFrame > allowedAhead;
+}
+
+bool FGFrameCounter::Dispatched(uint64_t frame)
+{
+    // Nothing to compare against after a reset, taken as is like before.
+    // A frame left behind is caught up by the next StartNewFrame
+    if (_lastDispatchedFrame == 0)
+    {
+        _lastDispatchedFrame = frame;
+        return true;
+    }
+
+    // Either would hand the FG backend data of another frame
+    if (frame <= _lastDispatchedFrame || frame > _frameCount || _frameCount - frame >= BUFFER_COUNT)
+    {
+        LOG_ERROR("Invalid dispatch frame: {}, _frameCount: {}, _lastDispatchedFrame: {}", frame, _frameCount,
+                  _lastDispatchedFrame);
+        return false;
+    }
+
+    _lastDispatchedFrame = frame;
+    return true;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <pch.h>
+
+// Frame indexing and dispatch pacing of IFGFeature. Frames are numbered from 1, their data
+// is kept in BUFFER_COUNT slots and dispatch follows the frames with at most a couple frames
+// of delay. Has no D3D or config dependencies so interleavings can be replayed headless.
+class FGFrameCounter
+{
+    uint64_t _frameCount = 1;
+    uint64_t _lastDispatchedFrame = 0;
+    uint64_t _targetFrame = 0;
+
+  public:
+    // Dispatch falling further behind than this skips to the previous frame
+    static constexpr uint64_t MaxFramesBehind = 2;
+
+    // Frames FG stays paused for after a change
+    static constexpr uint64_t PauseFrames = 10;
+
+    static int IndexOf(uint64_t frame) { return (int) (frame % BUFFER_COUNT); }
+
+    // Returns true when dispatch fell too far behind and skipped frames
+    bool StartNewFrame();
+
+    // True when dispatch is more than allowedAhead frames behind or didn't start yet,
+    // the current frame can be dispatched instead if it has its data
+    bool IsBehind(uint32_t allowedAhead) const;
+    uint64_t NextDispatchFrame(bool skipToCurrent) const
+    {
+        return skipToCurrent ? _frameCount : _lastDispatchedFrame + 1;
+    }
+
+    // Returns false and keeps the counters if the frame can't be dispatched, its slot
+    // was already reused or it isn't after the last dispatched one. Any frame is taken
+    // after ResetDispatched
+    bool Dispatched(uint64_t frame);
+
+    // Next dispatch starts from the current frame
+    void ResetDispatched() { _lastDispatchedFrame = 0; }
+    void Restart() { _frameCount = 1; }
+
+    // FG output is held until PauseFrames frames are presented
+    void Pause() { _targetFrame = _frameCount + PauseFrames; }
+    void ResetTarget() { _targetFrame = _frameCount; }
+
+    int Index() const { return IndexOf(_frameCount); }
+    bool IsPaused() const { return _targetFrame != 0 && _targetFrame >= _frameCount; }
+    bool IsDispatched() const { return _lastDispatchedFrame == _frameCount; }
+
+    uint64_t FrameCount() const { return _frameCount; }
+    uint64_t LastDispatchedFrame() const { return _lastDispatchedFrame; }
+    uint64_t TargetFrame() const { return _targetFrame; }
+};
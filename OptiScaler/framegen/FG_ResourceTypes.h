@@ -0,0 +1,24 @@
+#pragma once
+#include <pch.h>
+
+enum FG_ResourceType : uint32_t
+{
+    Depth = 0,
+    Velocity,
+    HudlessColor,
+    UIColor,
+    Distortion,
+
+    ResourceTypeCOUNT
+};
+
+enum class FG_ResourceValidity : uint32_t
+{
+    ValidNow = 0,
+    UntilPresent,
+    ValidButMakeCopy,
+    JustTrackCmdlist,
+    UntilPresentFromDispatch,
+
+    ValidityCOUNT
+};
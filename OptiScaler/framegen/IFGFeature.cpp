@@ -2,50 +2,34 @@
 
 #include <Config.h>
 
-int IFGFeature::GetIndex() { return (_frameCount % BUFFER_COUNT); }
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::FG
 
-int IFGFeature::GetIndexWillBeDispatched()
+int IFGFeature::GetIndex() { return _frames.Index(); }
+
+UINT64 IFGFeature::NextDispatchFrame()
 {
-    UINT64 df;
+    // If current index has resources, skip to it
+    auto skipToCurrent = _frames.IsBehind(Config::Instance()->FGAllowedFrameAhead.value_or_default()) &&
+                         HasResource(FG_ResourceType::Depth);
 
-    auto diff = _frameCount - _lastDispatchedFrame;
-    if (diff > Config::Instance()->FGAllowedFrameAhead.value_or_default() || diff < 0 || _lastDispatchedFrame == 0)
-    {
-        // If current index has resources, skip to it
-        if (HasResource(FG_ResourceType::Depth))
-        {
-            LOG_DEBUG("Skipping not presented frames! _frameCount: {}, _lastDispatchedFrame: {}", _frameCount,
-                      _lastDispatchedFrame);
-
-            df = _frameCount; // Set dispatch frame as new one
-        }
-        else
-        {
-            df = _lastDispatchedFrame + 1; // Render next one
-        }
-    }
-    else
+    if (skipToCurrent)
     {
-        df = _lastDispatchedFrame + 1; // Render next one
+        LOG_DEBUG("Skipping not presented frames! _frameCount: {}, _lastDispatchedFrame: {}", _frames.FrameCount(),
+                  _frames.LastDispatchedFrame());
     }
 
-    return (df % BUFFER_COUNT);
+    return _frames.NextDispatchFrame(skipToCurrent);
 }
 
+int IFGFeature::GetIndexWillBeDispatched() { return FGFrameCounter::IndexOf(NextDispatchFrame()); }
+
 UINT64 IFGFeature::StartNewFrame()
 {
-    _frameCount++;
-
-    if (_lastDispatchedFrame == 0 || (_frameCount - _lastDispatchedFrame) > 2)
-    {
-        LOG_WARN("Frame count jumped too much! _frameCount: {}, _lastDispatchedFrame: {}", _frameCount,
-                 _lastDispatchedFrame);
-
-        _lastDispatchedFrame = _frameCount - 1;
-    }
+    _frames.StartNewFrame();
 
     auto fIndex = GetIndex();
-    LOG_DEBUG("_frameCount: {}, fIndex: {}", _frameCount, fIndex);
+    LOG_DEBUG("_frameCount: {}, fIndex: {}", _frames.FrameCount(), fIndex);
 
     _resourceReady[fIndex].clear();
     _waitingExecute[fIndex] = false;
@@ -56,7 +40,19 @@ UINT64 IFGFeature::StartNewFrame()
 
     NewFrame();
 
-    return _frameCount;
+    return _frames.FrameCount();
+}
+
+// Frame numbers start over, readiness of the old frames would be taken for the new ones
+void IFGFeature::RestartFrames()
+{
+    _frames.Restart();
+
+    for (size_t i = 0; i < BUFFER_COUNT; i++)
+    {
+        _resourceReady[i].clear();
+        _waitingExecute[i] = false;
+    }
 }
 
 bool IFGFeature::IsResourceReady(FG_ResourceType type, int index)
@@ -133,36 +129,27 @@ bool IFGFeature::CheckForRealObject(std::string functionName, IUnknown* pObject,
 
 int IFGFeature::GetDispatchIndex(UINT64& willDispatchFrame)
 {
-    LOG_DEBUG("_lastDispatchedFrame: {},  _frameCount: {}", _lastDispatchedFrame, _frameCount);
+    LOG_DEBUG("_lastDispatchedFrame: {},  _frameCount: {}", _frames.LastDispatchedFrame(), _frames.FrameCount());
 
     // We are in same frame
-    if (_frameCount == _lastDispatchedFrame)
+    if (_frames.IsDispatched())
         return -1;
 
-    auto diff = _frameCount - _lastDispatchedFrame;
-    if (diff > Config::Instance()->FGAllowedFrameAhead.value_or_default() || diff < 0 || _lastDispatchedFrame == 0)
-    {
-        if (HasResource(FG_ResourceType::Depth))
-            willDispatchFrame = _frameCount; // Set dispatch frame as new one
-        else
-            willDispatchFrame = _lastDispatchedFrame + 1; // Render next one
-    }
-    else
-    {
-        willDispatchFrame = _lastDispatchedFrame + 1; // Render next one
-    }
+    willDispatchFrame = NextDispatchFrame();
+
+    if (!_frames.Dispatched(willDispatchFrame))
+        return -1;
 
-    _lastDispatchedFrame = willDispatchFrame;
     _lastFGFrame = State::Instance().FGLastFrame;
 
-    return (willDispatchFrame % BUFFER_COUNT);
+    return FGFrameCounter::IndexOf(willDispatchFrame);
 }
 
 bool IFGFeature::IsActive() { return _isActive || _waitingNewFrameData; }
 
-bool IFGFeature::IsPaused() { return _targetFrame != 0 && _targetFrame >= _frameCount; }
+bool IFGFeature::IsPaused() { return _frames.IsPaused(); }
 
-bool IFGFeature::IsDispatched() { return _lastDispatchedFrame == _frameCount; }
+bool IFGFeature::IsDispatched() { return _frames.IsDispatched(); }
 
 bool IFGFeature::IsLowResMV() { return !_constants.flags[FG_Flags::DisplayResolutionMVs]; }
 
@@ -181,10 +168,33 @@ void IFGFeature::SetJitter(float x, float y, int index)
     if (index < 0)
         index = GetIndex();
 
+    auto previous = _jitterTracker.Report();
+
+    if (_jitterTracker.Add(x, y, _jitterRenderWidth, _jitterRenderHeight, _constants.displayWidth))
+        _jitterTracker.LogReport(Name(), previous);
+
+    if (Config::Instance()->JitterAutoCorrect.value_or_default())
+    {
+        auto corrected = _jitterTracker.Correct(x, y);
+        x = corrected.x;
+        y = corrected.y;
+    }
+
     _jitterX[index] = x;
     _jitterY[index] = y;
 }
 
+void IFGFeature::SetJitterRenderSize(uint32_t width, uint32_t height)
+{
+    if (width == _jitterRenderWidth && height == _jitterRenderHeight)
+        return;
+
+    // Offsets measured against the old size don't tell the unit of the new ones
+    _jitterRenderWidth = width;
+    _jitterRenderHeight = height;
+    _jitterTracker.Reset();
+}
+
 void IFGFeature::SetMVScale(float x, float y, int index)
 {
     if (index < 0)
@@ -278,20 +288,19 @@ void IFGFeature::GetInterpolationPos(UINT& left, UINT& top, int index)
         top = 0;
 }
 
-void IFGFeature::ResetCounters() { _targetFrame = _frameCount; }
+void IFGFeature::ResetCounters() { _frames.ResetTarget(); }
 
 void IFGFeature::UpdateTarget()
 {
-    _targetFrame = _frameCount + 10;
-    //_lastDispatchedFrame = 0;
-    LOG_DEBUG("Current frame: {} target frame: {}", _frameCount, _targetFrame);
+    _frames.Pause();
+    LOG_DEBUG("Current frame: {} target frame: {}", _frames.FrameCount(), _frames.TargetFrame());
 }
 
-UINT64 IFGFeature::FrameCount() { return _frameCount; }
+UINT64 IFGFeature::FrameCount() { return _frames.FrameCount(); }
 
-UINT64 IFGFeature::LastDispatchedFrame() { return _lastDispatchedFrame; }
+UINT64 IFGFeature::LastDispatchedFrame() { return _frames.LastDispatchedFrame(); }
 
-UINT64 IFGFeature::TargetFrame() { return _targetFrame; }
+UINT64 IFGFeature::TargetFrame() { return _frames.TargetFrame(); }
 
 void IFGFeature::SetResourceReady(FG_ResourceType type, int index)
 {
@@ -299,5 +308,5 @@ void IFGFeature::SetResourceReady(FG_ResourceType type, int index)
         index = GetIndex();
 
     _resourceReady[index][type] = true;
-    _resourceFrame[type] = _frameCount;
+    _resourceFrame[type] = _frames.FrameCount();
 }
@@ -1,6 +1,11 @@
 #pragma once
 #include <pch.h>
 
+#include "FG_FrameCounter.h"
+#include "FG_ResourceTypes.h"
+
+#include <misc/JitterAnalyzer.h>
+
 #include <OwnedMutex.h>
 
 #include <dxgi1_6.h>
@@ -26,28 +31,6 @@ struct FG_Constants
     // uint32_t maxRenderHeight;
 };
 
-enum FG_ResourceType : uint32_t
-{
-    Depth = 0,
-    Velocity,
-    HudlessColor,
-    UIColor,
-    Distortion,
-
-    ResourceTypeCOUNT
-};
-
-enum class FG_ResourceValidity : uint32_t
-{
-    ValidNow = 0,
-    UntilPresent,
-    ValidButMakeCopy,
-    JustTrackCmdlist,
-    UntilPresentFromDispatch,
-
-    ValidityCOUNT
-};
-
 class IFGFeature
 {
   protected:
@@ -71,13 +54,15 @@ class IFGFeature
     std::optional<UINT> _interpolationTop[BUFFER_COUNT];
     UINT _reset[BUFFER_COUNT] = {};
 
-    UINT64 _frameCount = 1;
-    UINT64 _lastDispatchedFrame = 0;
+    JitterTracker _jitterTracker;
+    uint32_t _jitterRenderWidth = 0;
+    uint32_t _jitterRenderHeight = 0;
+
+    FGFrameCounter _frames;
     UINT64 _lastFGFrame = 0;
     bool _waitingNewFrameData = false;
 
     bool _isActive = false;
-    UINT64 _targetFrame = 0;
     FG_Constants _constants {};
 
     std::unordered_map<FG_ResourceType, bool> _resourceReady[BUFFER_COUNT] {};
@@ -91,9 +76,14 @@ class IFGFeature
     IID streamlineRiid {};
 
     bool CheckForRealObject(std::string functionName, IUnknown* pObject, IUnknown** ppRealObject);
+    UINT64 NextDispatchFrame();
+    void RestartFrames();
     int GetDispatchIndex(UINT64& willDispatchFrame);
     virtual void NewFrame() = 0;
 
+    // Render size the jitter offsets are analyzed against, taken from the depth input
+    void SetJitterRenderSize(uint32_t width, uint32_t height);
+
   public:
     OwnedMutex Mutex;
 
@@ -133,7 +123,10 @@ class IFGFeature
     bool IsInvertedDepth();
     bool IsInfiniteDepth();
 
+    // Records the offsets in the jitter tracker, they are rescaled to render pixels when JitterAutoCorrect
+    // is enabled and the unit is known
     void SetJitter(float x, float y, int index = -1);
+    const JitterReport& JitterState() const { return _jitterTracker.Report(); }
     void SetMVScale(float x, float y, int index = -1);
     void SetCameraValues(float nearValue, float farValue, float vFov, float aspectRatio, float meterFactor = 0.0f,
                          int index = -1);
@@ -3,8 +3,14 @@
 #include <State.h>
 #include <Config.h>
 
+#include <misc/BarrierBatch_Dx12.h>
+#include <misc/StateShadow_Dx12.h>
+
 #include <magic_enum.hpp>
 
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::FG
+
 bool IFGFeature_Dx12::GetResourceCopy(FG_ResourceType type, D3D12_RESOURCE_STATES bufferState, ID3D12Resource* output)
 {
     if (!InitCopyCmdList())
@@ -107,7 +113,7 @@ Dx12Resource* IFGFeature_Dx12::GetResource(FG_ResourceType type, int index)
 {
     std::lock_guard<std::mutex> lock(_frMutex);
 
-    // if (_resourceFrame[type] != _frameCount)
+    // if (_resourceFrame[type] != _frames.FrameCount())
     //     return nullptr;
 
     if (index < 0)
@@ -137,9 +143,10 @@ void IFGFeature_Dx12::NewFrame()
 
     std::lock_guard<std::mutex> lock(_frMutex);
 
-    LOG_DEBUG("_frameCount: {}, fIndex: {}", _frameCount, fIndex);
+    LOG_DEBUG("_frameCount: {}, fIndex: {}", _frames.FrameCount(), fIndex);
 
     _frameResources[fIndex].clear();
+    _copies.FinishFrame(fIndex);
     _uiCommandListResetted[fIndex] = false;
     _lastFGFramePresentId = _fgFramePresentId;
 }
@@ -190,6 +197,10 @@ void IFGFeature_Dx12::FlipResource(Dx12Resource* resource)
     if (flip->get()->IsInit())
     {
         auto cmdList = (resource->cmdList != nullptr) ? resource->cmdList : GetUICommandList(fIndex);
+
+        // Flip runs on the game's list when the input was tagged on one
+        StateShadowScope_Dx12 stateScope(resource->cmdList, StateShadow_Dx12::RestoreMask());
+
         auto result = flip->get()->Dispatch(_device, (ID3D12GraphicsCommandList*) cmdList, resource->resource,
                                             flipOutput, resource->width, resource->height, true);
 
@@ -398,16 +409,33 @@ void IFGFeature_Dx12::ResourceBarrier(ID3D12GraphicsCommandList* cmdList, ID3D12
 bool IFGFeature_Dx12::CopyResource(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* source, ID3D12Resource** target,
                                    D3D12_RESOURCE_STATES sourceState)
 {
-    auto result = true;
+    if (!CreateBufferResource(_device, source, D3D12_RESOURCE_STATE_COPY_DEST, target))
+        return false;
 
-    ResourceBarrier(cmdList, source, sourceState, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    // Sources already in a read state that allows copying need no round trip at all
+    auto copyState = BarrierBatch_Dx12::ReadState(sourceState, D3D12_RESOURCE_STATE_COPY_SOURCE);
 
-    if (CreateBufferResource(_device, source, D3D12_RESOURCE_STATE_COPY_DEST, target))
-        cmdList->CopyResource(*target, source);
-    else
-        result = false;
+    BarrierBatch_Dx12 barriers(cmdList);
+
+    barriers.Transition(source, sourceState, copyState);
+    barriers.Flush();
+
+    cmdList->CopyResource(*target, source);
 
-    ResourceBarrier(cmdList, source, D3D12_RESOURCE_STATE_COPY_SOURCE, sourceState);
+    barriers.Transition(source, copyState, sourceState);
+
+    return true;
+}
+
+void IFGFeature_Dx12::RecordCopy(int index, FG_ResourceType type, FG_CopyPath path, ID3D12Resource* source)
+{
+    UINT64 bytes = 0;
+
+    if (_device != nullptr && source != nullptr)
+    {
+        auto desc = source->GetDesc();
+        _device->GetCopyableFootprints(&desc, 0, 1, 0, nullptr, nullptr, nullptr, &bytes);
+    }
 
-    return result;
+    _copies.Record(index, type, path, source, bytes);
 }
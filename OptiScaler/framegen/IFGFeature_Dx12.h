@@ -1,6 +1,7 @@
 #pragma once
 #include <pch.h>
 #include "IFGFeature.h"
+#include "FG_CopyScheduler.h"
 
 #include <upscalers/IFeature.h>
 
@@ -57,6 +58,9 @@ class IFGFeature_Dx12 : public virtual IFGFeature
     std::unordered_map<FG_ResourceType, ID3D12Resource*> _resourceCopy[BUFFER_COUNT] {};
     std::mutex _frMutex;
 
+    // Guarded by _frMutex like the frame resources
+    FGCopyScheduler _copies;
+
     std::unique_ptr<RF_Dx12> _mvFlip;
     std::unique_ptr<RF_Dx12> _depthFlip;
     std::unique_ptr<HC_Dx12> _hudlessCompare;
@@ -69,6 +73,7 @@ class IFGFeature_Dx12 : public virtual IFGFeature
                          D3D12_RESOURCE_STATES InBeforeState, D3D12_RESOURCE_STATES InAfterState);
     bool CopyResource(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* source, ID3D12Resource** target,
                       D3D12_RESOURCE_STATES sourceState);
+    void RecordCopy(int index, FG_ResourceType type, FG_CopyPath path, ID3D12Resource* source);
 
     void NewFrame() override final;
     void FlipResource(Dx12Resource* resource);
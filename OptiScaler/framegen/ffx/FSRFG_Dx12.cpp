@@ -3,10 +3,14 @@
 #include <State.h>
 
 #include <hudfix/Hudfix_Dx12.h>
+#include <misc/BarrierBatch_Dx12.h>
 #include <menu/menu_overlay_dx.h>
 
 #include <magic_enum.hpp>
 
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::FG
+
 static inline int GetFormatIndex(DXGI_FORMAT format)
 {
     switch (format)
@@ -69,21 +73,6 @@ static inline bool FormatsCompatible(DXGI_FORMAT format1, DXGI_FORMAT format2)
     return false;
 }
 
-static inline void ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
-                                   D3D12_RESOURCE_STATES InBeforeState, D3D12_RESOURCE_STATES InAfterState)
-{
-    if (InBeforeState == InAfterState)
-        return;
-
-    D3D12_RESOURCE_BARRIER barrier = {};
-    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Transition.pResource = InResource;
-    barrier.Transition.StateBefore = InBeforeState;
-    barrier.Transition.StateAfter = InAfterState;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    InCommandList->ResourceBarrier(1, &barrier);
-}
-
 bool FSRFG_Dx12::HudlessFormatTransfer(int index, ID3D12Device* device, DXGI_FORMAT targetFormat,
                                        Dx12Resource* resource)
 {
@@ -99,46 +88,75 @@ bool FSRFG_Dx12::HudlessFormatTransfer(int index, ID3D12Device* device, DXGI_FOR
         return false;
     }
 
+    auto path = _copies.Plan(index, FG_ResourceType::HudlessColor, resource->validity, resource->cmdList != nullptr,
+                             resource->resource);
+
+    if (path == FG_CopyPath::Merged && _hudlessTransfer[index].get()->Buffer() != nullptr)
+    {
+        LOG_DEBUG("Same hudless again, reusing its transfer");
+        RecordCopy(index, FG_ResourceType::HudlessColor, path, resource->resource);
+
+        resource->copy = _hudlessTransfer[index].get()->Buffer();
+        resource->state = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+
+        return true;
+    }
+
+    // Only a hudless that can change after tagging is copied on the game's command list,
+    // the rest is read as is by the transfer on our list
+    auto copyInline = path == FG_CopyPath::Inline;
+
     if (_hudlessTransfer[index].get() != nullptr &&
         _hudlessTransfer[index].get()->CreateBufferResource(device, resource->GetResource(),
                                                             D3D12_RESOURCE_STATE_UNORDERED_ACCESS) &&
-        (resource->cmdList == nullptr ||
-         CreateBufferResource(device, resource->GetResource(), D3D12_RESOURCE_STATE_COPY_DEST,
-                              &_hudlessCopyResource[index])))
+        (!copyInline || CreateBufferResource(device, resource->GetResource(), D3D12_RESOURCE_STATE_COPY_DEST,
+                                             &_hudlessCopyResource[index])))
     {
         auto cmdList = GetUICommandList(index);
 
-        if (resource->cmdList != nullptr && _hudlessCopyResource[index] != nullptr)
+        BarrierBatch_Dx12 uiBarriers(cmdList);
+
+        if (copyInline && _hudlessCopyResource[index] != nullptr)
         {
-            ResourceBarrier(resource->cmdList, resource->GetResource(), resource->state,
-                            D3D12_RESOURCE_STATE_COPY_SOURCE);
+            auto copyState = BarrierBatch_Dx12::ReadState(resource->state, D3D12_RESOURCE_STATE_COPY_SOURCE);
+            BarrierBatch_Dx12 barriers(resource->cmdList);
 
-            resource->cmdList->CopyResource(_hudlessCopyResource[index], resource->GetResource());
+            barriers.Transition(resource->GetResource(), resource->state, copyState);
+            barriers.Flush();
 
-            ResourceBarrier(resource->cmdList, resource->GetResource(), D3D12_RESOURCE_STATE_COPY_SOURCE,
-                            resource->state);
+            resource->cmdList->CopyResource(_hudlessCopyResource[index], resource->GetResource());
 
-            ResourceBarrier(resource->cmdList, _hudlessCopyResource[index], D3D12_RESOURCE_STATE_COPY_DEST,
-                            D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+            // Source restore and copy transition go out in a single call
+            barriers.Transition(resource->GetResource(), copyState, resource->state);
+            barriers.Transition(_hudlessCopyResource[index], D3D12_RESOURCE_STATE_COPY_DEST,
+                                D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+            barriers.Flush();
 
             _hudlessTransfer[index].get()->Dispatch(device, cmdList, _hudlessCopyResource[index],
                                                     _hudlessTransfer[index].get()->Buffer());
 
-            ResourceBarrier(cmdList, _hudlessCopyResource[index], D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
-                            D3D12_RESOURCE_STATE_COPY_DEST);
+            uiBarriers.Transition(_hudlessCopyResource[index], D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
+                                  D3D12_RESOURCE_STATE_COPY_DEST);
         }
         else
         {
-            ResourceBarrier(cmdList, resource->GetResource(), resource->state,
-                            D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+            auto readState =
+                BarrierBatch_Dx12::ReadState(resource->state, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+
+            uiBarriers.Transition(resource->GetResource(), resource->state, readState);
+            uiBarriers.Flush();
 
             _hudlessTransfer[index].get()->Dispatch(device, cmdList, resource->GetResource(),
                                                     _hudlessTransfer[index].get()->Buffer());
 
-            ResourceBarrier(cmdList, resource->GetResource(), D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
-                            resource->state);
+            uiBarriers.Transition(resource->GetResource(), readState, resource->state);
         }
 
+        uiBarriers.Flush();
+
+        RecordCopy(index, FG_ResourceType::HudlessColor, copyInline ? path : FG_CopyPath::Deferred,
+                   resource->resource);
+
         resource->copy = _hudlessTransfer[index].get()->Buffer();
         resource->state = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
 
@@ -163,18 +181,35 @@ bool FSRFG_Dx12::UIFormatTransfer(int index, ID3D12Device* device, ID3D12Graphic
         return false;
     }
 
+    // UI is always transferred on our list, only repeats of it can be saved
+    auto path = _copies.Plan(index, FG_ResourceType::UIColor, resource->validity, false, resource->resource);
+
+    if (path == FG_CopyPath::Merged && _uiTransfer[index].get()->Buffer() != nullptr)
+    {
+        LOG_DEBUG("Same UI again, reusing its transfer");
+        RecordCopy(index, FG_ResourceType::UIColor, path, resource->resource);
+
+        resource->copy = _uiTransfer[index].get()->Buffer();
+        return true;
+    }
+
     if (_uiTransfer[index].get() != nullptr &&
         _uiTransfer[index].get()->CreateBufferResource(device, resource->GetResource(),
                                                        D3D12_RESOURCE_STATE_UNORDERED_ACCESS))
     {
-        ResourceBarrier(cmdList, resource->GetResource(), resource->state,
-                        D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+        auto readState = BarrierBatch_Dx12::ReadState(resource->state, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+        BarrierBatch_Dx12 barriers(cmdList);
+
+        barriers.Transition(resource->GetResource(), resource->state, readState);
+        barriers.Flush();
 
         _uiTransfer[index].get()->Dispatch(device, cmdList, resource->GetResource(),
                                            _uiTransfer[index].get()->Buffer());
 
-        ResourceBarrier(cmdList, resource->GetResource(), D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
-                        resource->state);
+        barriers.Transition(resource->GetResource(), readState, resource->state);
+        barriers.Flush();
+
+        RecordCopy(index, FG_ResourceType::UIColor, FG_CopyPath::Deferred, resource->resource);
 
         resource->copy = _uiTransfer[index].get()->Buffer();
         return true;
@@ -274,7 +309,7 @@ bool FSRFG_Dx12::Dispatch()
     if (state.FSRFGFTPchanged)
         ConfigureFramePaceTuning();
 
-    LOG_DEBUG("_frameCount: {}, willDispatchFrame: {}, fIndex: {}", _frameCount, willDispatchFrame, fIndex);
+    LOG_DEBUG("_frameCount: {}, willDispatchFrame: {}, fIndex: {}", _frames.FrameCount(), willDispatchFrame, fIndex);
 
     if (!_resourceReady[fIndex].contains(FG_ResourceType::Depth) ||
         !_resourceReady[fIndex].at(FG_ResourceType::Depth) ||
@@ -604,8 +639,7 @@ void* FSRFG_Dx12::SwapchainContext()
 
 void FSRFG_Dx12::DestroyFGContext()
 {
-    _frameCount = 1;
-    // _lastDispatchedFrame = 0;
+    RestartFrames();
     _version = {};
 
     LOG_DEBUG("");
@@ -913,7 +947,7 @@ void FSRFG_Dx12::CreateContext(ID3D12Device* device, FG_Constants& fgConstants)
 
         LOG_INFO("D3D12_CreateContext result: {:X}", retCode);
         _isActive = (retCode == FFX_API_RETURN_OK);
-        _lastDispatchedFrame = 0;
+        _frames.ResetDispatched();
     }
 
     LOG_DEBUG("Create");
@@ -935,7 +969,7 @@ void FSRFG_Dx12::Activate()
         if (result == FFX_API_RETURN_OK)
         {
             _isActive = true;
-            _lastDispatchedFrame = 0;
+            _frames.ResetDispatched();
         }
 
         LOG_INFO("D3D12_Configure Enabled: true, result: {} ({})", magic_enum::enum_name((FfxApiReturnCodes) result),
@@ -982,8 +1016,6 @@ void FSRFG_Dx12::Deactivate()
             _isActive = false;
         }
 
-        // _lastDispatchedFrame = 0;
-
         LOG_INFO("D3D12_Configure Enabled: false, result: {} ({})", magic_enum::enum_name((FfxApiReturnCodes) result),
                  (UINT) result);
     }
@@ -1159,6 +1191,10 @@ bool FSRFG_Dx12::SetResource(Dx12Resource* inputResource)
         return false;
     }
 
+    // Depth is at render resolution, jitter offsets are measured in its pixels
+    if (type == FG_ResourceType::Depth)
+        SetJitterRenderSize(static_cast<uint32_t>(inputResource->width), inputResource->height);
+
     _frameResources[fIndex][type] = {};
     auto fResource = &_frameResources[fIndex][type];
     fResource->type = type;
@@ -1261,6 +1297,8 @@ bool FSRFG_Dx12::SetResource(Dx12Resource* inputResource)
 
         copyOutput->SetName(std::format(L"_resourceCopy[{}][{}]", fIndex, (UINT) type).c_str());
 
+        RecordCopy(fIndex, type, FG_CopyPath::Inline, inputResource->resource);
+
         _resourceCopy[fIndex][type] = copyOutput;
         fResource->copy = copyOutput;
         fResource->state = D3D12_RESOURCE_STATE_COPY_DEST;
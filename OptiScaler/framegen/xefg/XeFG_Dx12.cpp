@@ -2,6 +2,7 @@
 
 #include <hudfix/Hudfix_Dx12.h>
 #include <menu/menu_overlay_dx.h>
+#include <misc/StateShadow_Dx12.h>
 #include <resource_tracking/ResTrack_dx12.h>
 
 #include <nvapi/fakenvapi.h>
@@ -10,6 +11,9 @@
 
 #include <DirectXMath.h>
 
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::FG
+
 using namespace DirectX;
 
 void XeFG_Dx12::xefgLogCallback(const char* message, xefg_swapchain_logging_level_t level, void* userData)
@@ -516,7 +520,7 @@ void XeFG_Dx12::CreateContext(ID3D12Device* device, FG_Constants& fgConstants)
     if (_fgContext == nullptr && _swapChainContext != nullptr)
     {
         _fgContext = _swapChainContext;
-        _lastDispatchedFrame = 0;
+        _frames.ResetDispatched();
     }
 
     if (_isActive)
@@ -545,7 +549,7 @@ void XeFG_Dx12::Activate()
         if (result == XEFG_SWAPCHAIN_RESULT_SUCCESS)
         {
             _isActive = true;
-            _lastDispatchedFrame = 0;
+            _frames.ResetDispatched();
         }
 
         LOG_INFO("SetEnabled: true, result: {} ({})", magic_enum::enum_name(result), (UINT) result);
@@ -585,7 +589,6 @@ void XeFG_Dx12::Deactivate()
             _isActive = false;
         }
 
-        //_lastDispatchedFrame = 0;
         _waitingNewFrameData = false;
 
         LOG_INFO("SetEnabled: false, result: {} ({})", magic_enum::enum_name(result), (UINT) result);
@@ -629,7 +632,7 @@ bool XeFG_Dx12::Dispatch()
     if (!IsActive() || IsPaused())
         return false;
 
-    LOG_DEBUG("_frameCount: {}, willDispatchFrame: {}, fIndex: {}", _frameCount, willDispatchFrame, fIndex);
+    LOG_DEBUG("_frameCount: {}, willDispatchFrame: {}, fIndex: {}", _frames.FrameCount(), willDispatchFrame, fIndex);
 
     if (!_resourceReady[fIndex].contains(FG_ResourceType::Depth) ||
         !_resourceReady[fIndex].at(FG_ResourceType::Depth) ||
@@ -1116,6 +1119,10 @@ bool XeFG_Dx12::SetResource(Dx12Resource* inputResource)
         return false;
     }
 
+    // Depth is at render resolution, jitter offsets are measured in its pixels
+    if (type == FG_ResourceType::Depth)
+        SetJitterRenderSize(static_cast<uint32_t>(inputResource->width), inputResource->height);
+
     if (type == FG_ResourceType::Distortion)
     {
         LOG_TRACE("Distortion field is not supported by XeFG");
@@ -1160,21 +1167,34 @@ bool XeFG_Dx12::SetResource(Dx12Resource* inputResource)
                 _depthInvert->Buffer() != nullptr)
             {
                 auto cmdList = (fResource->cmdList != nullptr) ? fResource->cmdList : GetUICommandList(fIndex);
+                BarrierBatch_Dx12 barriers(cmdList);
+
+                // Invert runs on the game's list when the depth was tagged on one
+                StateShadowScope_Dx12 stateScope(fResource->cmdList, StateShadow_Dx12::RestoreMask());
 
-                _depthInvert->SetBufferState(cmdList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+                _depthInvert->SetBufferState(barriers, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+                barriers.Flush();
 
                 if (_depthInvert->Dispatch(_device, cmdList, fResource->GetResource(), _depthInvert->Buffer()))
                 {
                     fResource->copy = _depthInvert->Buffer();
                 }
 
-                _depthInvert->SetBufferState(cmdList, fResource->state);
+                _depthInvert->SetBufferState(barriers, fResource->state);
             }
         }
     }
 
     // We usually don't copy any resources for XeFG, the ones with this tag are the exception
-    if (inputResource->cmdList != nullptr && fResource->validity == FG_ResourceValidity::ValidButMakeCopy)
+    auto path = FG_CopyPath::Deferred;
+
+    if (fResource->validity == FG_ResourceValidity::ValidButMakeCopy)
+    {
+        path = _copies.Plan(fIndex, type, fResource->validity, inputResource->cmdList != nullptr,
+                            inputResource->resource);
+    }
+
+    if (path == FG_CopyPath::Inline)
     {
         LOG_DEBUG("Making a resource copy of: {}", magic_enum::enum_name(type));
 
@@ -1189,6 +1209,8 @@ bool XeFG_Dx12::SetResource(Dx12Resource* inputResource)
             return false;
         }
 
+        RecordCopy(fIndex, type, path, inputResource->resource);
+
         _resourceCopy[fIndex][type] = copyOutput;
         _resourceCopy[fIndex][type]->SetName(std::format(L"_resourceCopy[{}][{}]", fIndex, (UINT) type).c_str());
         fResource->copy = copyOutput;
@@ -1196,6 +1218,10 @@ bool XeFG_Dx12::SetResource(Dx12Resource* inputResource)
 
         fResource->validity = FG_ResourceValidity::UntilPresent;
     }
+    else if (inputResource->cmdList != nullptr && fResource->validity == FG_ResourceValidity::ValidButMakeCopy)
+    {
+        LOG_DEBUG("Inline copies are over budget, {} is read at present", magic_enum::enum_name(type));
+    }
 
     if (type == FG_ResourceType::UIColor)
         _noUi[fIndex] = false;
@@ -1253,7 +1279,7 @@ bool XeFG_Dx12::SetResource(Dx12Resource* inputResource)
         if (indexDiff < 0)
             indexDiff += BUFFER_COUNT;
 
-        auto frameId = static_cast<uint32_t>(_frameCount - indexDiff);
+        auto frameId = static_cast<uint32_t>(_frames.FrameCount() - indexDiff);
         auto result =
             XeFGProxy::D3D12TagFrameResource()(_swapChainContext, fResource->cmdList, frameId, &resourceParam);
         LOG_DEBUG("D3D12TagFrameResource, frameId: {}, type: {} result: {} ({})", frameId, magic_enum::enum_name(type),
@@ -7,6 +7,7 @@
 #include <ffx_framegeneration.h>
 #include <ffx_upscale.h>
 #include "FSR4ModelSelection.h"
+#include <misc/GpuInventory.h>
 #include "proxies/FfxApi_Proxy.h"
 #include <magic_enum.hpp>
 
@@ -38,103 +39,14 @@ static AmdExtFfxApi* amdExtFfxApi = nullptr;
 
 static PFN_AmdExtD3DCreateInterface o_AmdExtD3DCreateInterface = nullptr;
 
-typedef decltype(&D3DKMTQueryAdapterInfo) PFN_D3DKMTQueryAdapterInfo;
-typedef decltype(&D3DKMTEnumAdapters) PFN_D3DKMTEnumAdapters;
-typedef decltype(&D3DKMTCloseAdapter) PFN_D3DKMTCloseAdapter;
-
-std::vector<std::filesystem::path> GetDriverStore()
-{
-    std::vector<std::filesystem::path> result;
-
-    // Load D3DKMT functions dynamically
-    bool libraryLoaded = false;
-    HMODULE hGdi32 = KernelBaseProxy::GetModuleHandleW_()(L"Gdi32.dll");
-
-    if (hGdi32 == nullptr)
-    {
-        hGdi32 = NtdllProxy::LoadLibraryExW_Ldr(L"Gdi32.dll", NULL, 0);
-        libraryLoaded = hGdi32 != nullptr;
-    }
-
-    if (hGdi32 == nullptr)
-    {
-        LOG_ERROR("Failed to load Gdi32.dll");
-        return result;
-    }
-
-    do
-    {
-        auto o_D3DKMTEnumAdapters =
-            (PFN_D3DKMTEnumAdapters) KernelBaseProxy::GetProcAddress_()(hGdi32, "D3DKMTEnumAdapters");
-        auto o_D3DKMTQueryAdapterInfo =
-            (PFN_D3DKMTQueryAdapterInfo) KernelBaseProxy::GetProcAddress_()(hGdi32, "D3DKMTQueryAdapterInfo");
-        auto o_D3DKMTCloseAdapter =
-            (PFN_D3DKMTCloseAdapter) KernelBaseProxy::GetProcAddress_()(hGdi32, "D3DKMTCloseAdapter");
-
-        if (o_D3DKMTEnumAdapters == nullptr || o_D3DKMTQueryAdapterInfo == nullptr || o_D3DKMTCloseAdapter == nullptr)
-        {
-            LOG_ERROR("Failed to resolve D3DKMT functions");
-            break;
-        }
-
-        D3DKMT_UMDFILENAMEINFO umdFileInfo = {};
-        D3DKMT_QUERYADAPTERINFO queryAdapterInfo = {};
-
-        queryAdapterInfo.Type = KMTQAITYPE_UMDRIVERNAME;
-        queryAdapterInfo.pPrivateDriverData = &umdFileInfo;
-        queryAdapterInfo.PrivateDriverDataSize = sizeof(umdFileInfo);
-
-        D3DKMT_ENUMADAPTERS enumAdapters = {};
-
-        // Query the number of adapters first
-        if (o_D3DKMTEnumAdapters(&enumAdapters) != 0)
-        {
-            LOG_ERROR("Failed to enumerate adapters.");
-            break;
-        }
-
-        // If there are any adapters, the first one should be in the list
-        if (enumAdapters.NumAdapters > 0)
-        {
-            for (size_t i = 0; i < enumAdapters.NumAdapters; i++)
-            {
-                D3DKMT_ADAPTERINFO adapter = enumAdapters.Adapters[i];
-                queryAdapterInfo.hAdapter = adapter.hAdapter;
-
-                auto hr = o_D3DKMTQueryAdapterInfo(&queryAdapterInfo);
-
-                if (hr != 0)
-                    LOG_ERROR("Failed to query adapter info {:X}", hr);
-                else
-                    result.push_back(std::filesystem::path(umdFileInfo.UmdFileName).parent_path());
-
-                D3DKMT_CLOSEADAPTER closeAdapter = {};
-                closeAdapter.hAdapter = adapter.hAdapter;
-                auto closeResult = o_D3DKMTCloseAdapter(&closeAdapter);
-                if (closeResult != 0)
-                    LOG_ERROR("D3DKMTCloseAdapter error: {:X}", closeResult);
-            }
-        }
-        else
-        {
-            LOG_ERROR("No adapters found.");
-            break;
-        }
-
-    } while (false);
-
-    if (libraryLoaded)
-        NtdllProxy::FreeLibrary_Ldr(hGdi32);
-
-    return result;
-}
+std::vector<std::filesystem::path> GetDriverStore() { return GpuInventory::DriverStores(); }
 
 #pragma endregion
 
-void CheckForGPU()
+// Only when D3DKMT couldn't tell the vendors, needs a DXGI factory so can't run under the loader lock
+static std::vector<GpuRecord> GetDxgiAdapters()
 {
-    if (Config::Instance()->Fsr4Update.has_value())
-        return;
+    std::vector<GpuRecord> gpus;
 
     // Call init for any case
     DxgiProxy::Init();
@@ -143,7 +55,7 @@ void CheckForGPU()
     HRESULT result = DxgiProxy::CreateDxgiFactory_()(__uuidof(factory), &factory);
 
     if (result != S_OK || factory == nullptr)
-        return;
+        return gpus;
 
     UINT adapterIndex = 0;
     DXGI_ADAPTER_DESC adapterDesc {};
@@ -164,21 +76,16 @@ void CheckForGPU()
 
         if (result == S_OK && adapterDesc.VendorId != VendorId::Microsoft)
         {
-            if (!Config::Instance()->Fsr4Update.has_value() || !Config::Instance()->Fsr4Update.value())
-                Config::Instance()->Fsr4Update.set_volatile_value(false);
+            GpuRecord gpu;
+            gpu.vendorId = adapterDesc.VendorId;
+            gpu.deviceId = adapterDesc.DeviceId;
+            gpu.dedicatedVideoMemory = adapterDesc.DedicatedVideoMemory;
+            gpu.description = adapterDesc.Description;
 
-            std::wstring szName(adapterDesc.Description);
-            std::string descStr = std::format("Adapter: {}, VRAM: {} MB", wstring_to_string(szName),
-                                              adapterDesc.DedicatedVideoMemory / (1024 * 1024));
-            LOG_INFO("{}", descStr);
+            LOG_INFO("Adapter: {}, VRAM: {} MB", wstring_to_string(gpu.description),
+                     gpu.dedicatedVideoMemory / (1024 * 1024));
 
-            // If GPU is AMD
-            if (adapterDesc.VendorId == VendorId::AMD)
-            {
-                // If GPU Name contains 90XX or GFX12 (Linux) always set it to true
-                if (szName.find(L" 90") != std::wstring::npos || szName.find(L" GFX12") != std::wstring::npos)
-                    Config::Instance()->Fsr4Update.set_volatile_value(true);
-            }
+            gpus.push_back(std::move(gpu));
         }
         else
         {
@@ -193,6 +100,25 @@ void CheckForGPU()
     factory->Release();
     factory = nullptr;
 
+    return gpus;
+}
+
+void CheckForGPU()
+{
+    if (Config::Instance()->Fsr4Update.has_value())
+        return;
+
+    auto capabilities = GpuInventory::Capabilities();
+
+    if (!capabilities.known)
+        capabilities = GpuRules::Evaluate(GetDxgiAdapters());
+
+    // Checked again on the next call until an adapter is found
+    if (!capabilities.known)
+        return;
+
+    Config::Instance()->Fsr4Update.set_volatile_value(capabilities.fsr4Eligible);
+
     LOG_INFO("Fsr4Update: {}", Config::Instance()->Fsr4Update.value_or_default());
 }
 
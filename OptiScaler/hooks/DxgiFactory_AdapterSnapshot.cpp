@@ -0,0 +1,52 @@
+#include "DxgiFactory_AdapterSnapshot.h"
+
+std::vector<size_t> DxgiAdapterSnapshot::VisibleAdapters(const std::vector<AdapterTopologyEntry>& adapters,
+                                                         bool firstOnly)
+{
+    std::vector<size_t> result;
+
+    if (adapters.empty())
+        return result;
+
+    if (firstOnly)
+    {
+        result.push_back(0);
+        return result;
+    }
+
+    result.reserve(adapters.size());
+
+    for (size_t i = 0; i < adapters.size(); i++)
+        result.push_back(i);
+
+    return result;
+}
+
+const AdapterTopologyEntry& DxgiAdapterSnapshot::Add(AdapterTopologyEntry entry, const AdapterSpoofingPolicy& policy)
+{
+    entry.index = (UINT) _adapters.size();
+    entry.spoofed = DxgiSpoofingTables::Build(entry.vendorId, entry.deviceId, entry.dedicatedVideoMemory, policy);
+
+    _adapters.push_back(std::move(entry));
+    return _adapters.back();
+}
+
+void DxgiAdapterSnapshot::Finish(bool firstOnly)
+{
+    _firstOnly = firstOnly;
+    _visible = VisibleAdapters(_adapters, firstOnly);
+}
+
+const AdapterTopologyEntry* DxgiAdapterSnapshot::Find(UINT adapter, bool visibleOnly) const
+{
+    if (!visibleOnly)
+        return adapter < _adapters.size() ? &_adapters[adapter] : nullptr;
+
+    return adapter < _visible.size() ? &_adapters[_visible[adapter]] : nullptr;
+}
+
+void DxgiAdapterSnapshot::Clear()
+{
+    _adapters.clear();
+    _visible.clear();
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <pch.h>
+
+#include <spoofing/Dxgi_SpoofingTables.h>
+
+#include <vector>
+
+// Adapters of one factory in high performance order with the descs GetDesc will report for them.
+// Nothing here calls DXGI or reads the config, the topology fills it from the real adapters.
+class DxgiAdapterSnapshot
+{
+    std::vector<AdapterTopologyEntry> _adapters;
+    std::vector<size_t> _visible;
+    bool _firstOnly = false;
+
+  public:
+    // Indexes of the adapters games are allowed to see, in the order they are returned.
+    // firstOnly keeps the driver's first high performance choice
+    static std::vector<size_t> VisibleAdapters(const std::vector<AdapterTopologyEntry>& adapters, bool firstOnly);
+
+    // Next adapter in high performance order, its spoofed desc is built here
+    const AdapterTopologyEntry& Add(AdapterTopologyEntry entry, const AdapterSpoofingPolicy& policy);
+
+    // Applies the PreferFirstDedicatedGpu filter once every adapter is added
+    void Finish(bool firstOnly);
+
+    // visibleOnly applies the filter, otherwise all adapters are indexed. nullptr past the last one
+    const AdapterTopologyEntry* Find(UINT adapter, bool visibleOnly) const;
+
+    void Clear();
+
+    bool Empty() const { return _adapters.empty(); }
+    bool FirstOnly() const { return _firstOnly; }
+    const std::vector<AdapterTopologyEntry>& Adapters() const { return _adapters; }
+};
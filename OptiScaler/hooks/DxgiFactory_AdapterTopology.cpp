@@ -0,0 +1,376 @@
+#include "DxgiFactory_AdapterTopology.h"
+
+#include <Config.h>
+
+#include <spoofing/Dxgi_SpoofedDescs.h>
+
+// {5A3B7C1E-2F4D-4B8A-9E61-0C7D3F2A8B54}
+static const GUID OwnerGuid = { 0x5a3b7c1e, 0x2f4d, 0x4b8a, { 0x9e, 0x61, 0x0c, 0x7d, 0x3f, 0x2a, 0x8b, 0x54 } };
+
+// Private data of a factory with a snapshot, last reference is dropped when the factory is destroyed.
+// Only clears a flag, a new factory at the address of a released one is detected by it
+class SnapshotOwner final : public IUnknown
+{
+    std::atomic<ULONG> _refCount = 1;
+
+  public:
+    std::shared_ptr<std::atomic<bool>> alive = std::make_shared<std::atomic<bool>>(true);
+
+    ~SnapshotOwner() { alive->store(false, std::memory_order_release); }
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override
+    {
+        if (ppvObject == nullptr)
+            return E_POINTER;
+
+        if (riid == __uuidof(IUnknown))
+        {
+            AddRef();
+            *ppvObject = this;
+            return S_OK;
+        }
+
+        *ppvObject = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() override { return ++_refCount; }
+
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        auto count = --_refCount;
+
+        if (count == 0)
+            delete this;
+
+        return count;
+    }
+};
+
+AdapterSpoofingPolicy DxgiAdapterTopology::CurrentSpoofingPolicy()
+{
+    auto config = Config::Instance();
+
+    AdapterSpoofingPolicy policy {};
+    policy.enabled = config->DxgiSpoofing.value_or_default();
+    policy.vendorId = config->SpoofedVendorId.value_or_default();
+    policy.deviceId = config->SpoofedDeviceId.value_or_default();
+    policy.name = config->SpoofedGPUName.value_or_default();
+
+    if (config->TargetVendorId.has_value())
+        policy.targetVendorId = config->TargetVendorId.value();
+
+    if (config->TargetDeviceId.has_value())
+        policy.targetDeviceId = config->TargetDeviceId.value();
+
+    if (config->DxgiVRAM.has_value())
+        policy.vramGB = config->DxgiVRAM.value();
+
+    return policy;
+}
+
+void DxgiAdapterTopology::ReleaseSnapshot(IDXGIFactory* realFactory, Snapshot& snapshot)
+{
+    // A destroyed factory took its registration with it
+    if (snapshot.eventRegistered && snapshot.factoryAlive != nullptr &&
+        snapshot.factoryAlive->load(std::memory_order_acquire))
+    {
+        IDXGIFactory7* factory7 = nullptr;
+        if (realFactory->QueryInterface(IID_PPV_ARGS(&factory7)) == S_OK && factory7 != nullptr)
+        {
+            factory7->UnregisterAdaptersChangedEvent(snapshot.eventCookie);
+            factory7->Release();
+        }
+    }
+
+    snapshot.eventRegistered = false;
+    snapshot.adapters.Clear();
+}
+
+void DxgiAdapterTopology::ReleaseSnapshots()
+{
+    for (auto& [factory, snapshot] : _snapshots)
+        ReleaseSnapshot(factory, snapshot);
+
+    _snapshots.clear();
+}
+
+void DxgiAdapterTopology::Invalidate()
+{
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    ReleaseSnapshots();
+}
+
+bool DxgiAdapterTopology::AdaptersChanged()
+{
+    // Event resets when it's seen, the flag keeps it until the snapshots are dropped
+    if (_adaptersChangedEvent != nullptr && WaitForSingleObject(_adaptersChangedEvent, 0) == WAIT_OBJECT_0)
+        _adaptersChanged.store(true, std::memory_order_release);
+
+    return _adaptersChanged.load(std::memory_order_acquire);
+}
+
+bool DxgiAdapterTopology::IsCurrent(const Snapshot& snapshot)
+{
+    return snapshot.factoryAlive->load(std::memory_order_acquire) &&
+           snapshot.adapters.FirstOnly() == Config::Instance()->PreferFirstDedicatedGpu.value_or_default();
+}
+
+bool DxgiAdapterTopology::AttachOwner(IDXGIFactory* realFactory, Snapshot& snapshot)
+{
+    IUnknown* data = nullptr;
+    UINT size = sizeof(data);
+
+    // Factory keeps its owner when its snapshot is rebuilt or evicted
+    if (realFactory->GetPrivateData(OwnerGuid, &size, &data) == S_OK && data != nullptr)
+    {
+        snapshot.factoryAlive = static_cast<SnapshotOwner*>(data)->alive;
+        data->Release();
+        return true;
+    }
+
+    auto owner = new SnapshotOwner();
+    auto result = realFactory->SetPrivateDataInterface(OwnerGuid, owner);
+
+    if (result == S_OK)
+        snapshot.factoryAlive = owner->alive;
+    else
+        LOG_WARN("SetPrivateDataInterface error: {:X}", (UINT) result);
+
+    // Factory holds the only reference now
+    owner->Release();
+
+    return result == S_OK;
+}
+
+bool DxgiAdapterTopology::BuildSnapshot(IDXGIFactory* realFactory, PFN_EnumHighPerformance enumerate,
+                                        PFN_CheckAdapter check, Snapshot& snapshot)
+{
+    IDXGIFactory6* factory6 = nullptr;
+    if (realFactory->QueryInterface(IID_PPV_ARGS(&factory6)) != S_OK || factory6 == nullptr)
+        return false;
+
+    factory6->Release();
+    snapshot.factory6 = factory6;
+
+    auto policy = CurrentSpoofingPolicy();
+
+    for (UINT i = 0;; i++)
+    {
+        IDXGIAdapter1* adapter = nullptr;
+        auto result = enumerate(factory6, i, IID_PPV_ARGS(&adapter));
+
+        if (result == DXGI_ERROR_NOT_FOUND)
+            break;
+
+        if (result != S_OK || adapter == nullptr)
+        {
+            LOG_WARN("Enumeration of adapter {} failed: {:X}", i, (UINT) result);
+            snapshot.adapters.Clear();
+            return false;
+        }
+
+        AdapterTopologyEntry entry {};
+
+        DXGI_ADAPTER_DESC1 desc {};
+        HRESULT descResult;
+
+        {
+            ScopedSkipSpoofing skipSpoofing {};
+            descResult = adapter->GetDesc1(&desc);
+        }
+
+        if (descResult == S_OK)
+        {
+            entry.luid = desc.AdapterLuid;
+            entry.vendorId = desc.VendorId;
+            entry.deviceId = desc.DeviceId;
+            entry.dedicatedVideoMemory = desc.DedicatedVideoMemory;
+            entry.software = (desc.Flags & DXGI_ADAPTER_FLAG_SOFTWARE) != 0;
+            entry.description = desc.Description;
+        }
+        else
+        {
+            LOG_ERROR("Can't get description of adapter {}", i);
+        }
+
+        auto luidKey = ((uint64_t) (uint32_t) desc.AdapterLuid.HighPart << 32) | desc.AdapterLuid.LowPart;
+
+        // Served adapters skip the check, it only has to run for an adapter once
+        if (descResult != S_OK || _checkedAdapters.insert(luidKey).second)
+            check(adapter);
+
+        adapter->Release();
+
+        auto& added = snapshot.adapters.Add(std::move(entry), policy);
+
+        if (descResult == S_OK)
+            DxgiSpoofedDescs::Prepare(added);
+
+        LOG_DEBUG("{}: {}, VendorId: {:#x}, DeviceId: {:#x}, spoofed: {}", i, wstring_to_string(added.description),
+                  added.vendorId, added.deviceId, added.spoofed.identity);
+    }
+
+    if (snapshot.adapters.Empty())
+        return false;
+
+    snapshot.adapters.Finish(Config::Instance()->PreferFirstDedicatedGpu.value_or_default());
+
+    // Without an owner there is no way to tell when the factory is gone
+    if (!AttachOwner(realFactory, snapshot))
+    {
+        snapshot.adapters.Clear();
+        return false;
+    }
+
+    IDXGIFactory7* factory7 = nullptr;
+    if (realFactory->QueryInterface(IID_PPV_ARGS(&factory7)) == S_OK && factory7 != nullptr)
+    {
+        if (_adaptersChangedEvent == nullptr)
+            _adaptersChangedEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+
+        if (_adaptersChangedEvent != nullptr)
+        {
+            snapshot.eventRegistered =
+                factory7->RegisterAdaptersChangedEvent(_adaptersChangedEvent, &snapshot.eventCookie) == S_OK;
+
+            if (!snapshot.eventRegistered)
+                LOG_WARN("Can't register adapters changed event");
+        }
+
+        factory7->Release();
+    }
+
+    return true;
+}
+
+DxgiAdapterTopology::Snapshot* DxgiAdapterTopology::GetSnapshot(IDXGIFactory* realFactory,
+                                                                PFN_EnumHighPerformance enumerate,
+                                                                PFN_CheckAdapter check)
+{
+    if (AdaptersChanged())
+    {
+        LOG_INFO("Adapters changed, dropping {} snapshots", _snapshots.size());
+        ReleaseSnapshots();
+        _adaptersChanged.store(false, std::memory_order_release);
+    }
+
+    auto it = _snapshots.find(realFactory);
+
+    if (it != _snapshots.end())
+    {
+        if (IsCurrent(it->second))
+            return &it->second;
+
+        ReleaseSnapshot(it->first, it->second);
+        _snapshots.erase(it);
+    }
+
+    // Drop the snapshots of destroyed factories before evicting live ones
+    for (auto i = _snapshots.begin(); i != _snapshots.end();)
+    {
+        if (i->second.factoryAlive->load(std::memory_order_acquire))
+        {
+            i++;
+            continue;
+        }
+
+        ReleaseSnapshot(i->first, i->second);
+        i = _snapshots.erase(i);
+    }
+
+    if (_snapshots.size() >= MaxSnapshots)
+    {
+        auto oldest = _snapshots.begin();
+
+        for (auto i = _snapshots.begin(); i != _snapshots.end(); i++)
+        {
+            if (i->second.id < oldest->second.id)
+                oldest = i;
+        }
+
+        ReleaseSnapshot(oldest->first, oldest->second);
+        _snapshots.erase(oldest);
+    }
+
+    Snapshot snapshot {};
+
+    _building = true;
+    auto built = BuildSnapshot(realFactory, enumerate, check, snapshot);
+    _building = false;
+
+    if (!built)
+        return nullptr;
+
+    snapshot.id = ++_lastSnapshotId;
+
+    LOG_INFO("Built adapter snapshot {} with {} adapters", snapshot.id, snapshot.adapters.Adapters().size());
+
+    auto result = _snapshots.insert_or_assign(realFactory, std::move(snapshot));
+    return &result.first->second;
+}
+
+bool DxgiAdapterTopology::GetAdapter(const Snapshot& snapshot, UINT Adapter, bool visibleOnly, REFIID riid,
+                                     void** ppvAdapter, HRESULT* result, PFN_EnumHighPerformance enumerate)
+{
+    auto entry = snapshot.adapters.Find(Adapter, visibleOnly);
+
+    if (entry == nullptr)
+    {
+        LOG_DEBUG("{}, returning not found", Adapter);
+        *ppvAdapter = nullptr;
+        *result = DXGI_ERROR_NOT_FOUND;
+        return true;
+    }
+
+    _building = true;
+    auto enumResult = enumerate(snapshot.factory6, entry->index, riid, ppvAdapter);
+    _building = false;
+
+    // Adapter doesn't have the asked interface, same answer as enumerating it directly
+    if (enumResult == E_NOINTERFACE)
+    {
+        *result = enumResult;
+        return true;
+    }
+
+    // Order changed without a signal, snapshots are dropped on the next call and the caller enumerates itself
+    if (enumResult != S_OK || *ppvAdapter == nullptr)
+    {
+        LOG_WARN("Enumeration of adapter {} failed: {:X}, dropping snapshots", entry->index, (UINT) enumResult);
+        _adaptersChanged.store(true, std::memory_order_release);
+        return false;
+    }
+
+    *result = S_OK;
+    return true;
+}
+
+bool DxgiAdapterTopology::TryGetAdapter(IDXGIFactory* realFactory, UINT Adapter, bool visibleOnly, REFIID riid,
+                                        void** ppvAdapter, HRESULT* result, PFN_EnumHighPerformance enumerate,
+                                        PFN_CheckAdapter check)
+{
+    if (_building || realFactory == nullptr || ppvAdapter == nullptr || result == nullptr)
+        return false;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+
+        if (!AdaptersChanged())
+        {
+            auto it = _snapshots.find(realFactory);
+
+            if (it != _snapshots.end() && IsCurrent(it->second))
+                return GetAdapter(it->second, Adapter, visibleOnly, riid, ppvAdapter, result, enumerate);
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+
+    auto snapshot = GetSnapshot(realFactory, enumerate, check);
+
+    if (snapshot == nullptr)
+        return false;
+
+    return GetAdapter(*snapshot, Adapter, visibleOnly, riid, ppvAdapter, result, enumerate);
+}
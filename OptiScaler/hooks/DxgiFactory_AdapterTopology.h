@@ -0,0 +1,81 @@
+#pragma once
+
+#include <pch.h>
+
+#include "DxgiFactory_AdapterSnapshot.h"
+
+#include <dxgi1_6.h>
+
+#include <ankerl/unordered_dense.h>
+
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+// Adapters of a factory in high performance order, built once with the first
+// PreferDedicatedGpu enumeration so following EnumAdapters calls only enumerate
+// the adapter they return instead of walking, describing and checking all of them.
+// Snapshots are dropped with their factory or when DXGI signals an adapter change.
+class DxgiAdapterTopology
+{
+  public:
+    // Enumerates one adapter of the factory in high performance order, DXGI_ERROR_NOT_FOUND past the last one
+    typedef HRESULT (*PFN_EnumHighPerformance)(IDXGIFactory6* factory, UINT Adapter, REFIID riid, void** ppvAdapter);
+
+    // DXVK check and desc hooks, run once per adapter LUID
+    typedef void (*PFN_CheckAdapter)(IUnknown* adapter);
+
+    static AdapterSpoofingPolicy CurrentSpoofingPolicy();
+
+    // Returns false when there is no snapshot and one couldn't be built, caller should enumerate itself
+    // visibleOnly applies the PreferFirstDedicatedGpu filter, otherwise all adapters are indexed
+    static bool TryGetAdapter(IDXGIFactory* realFactory, UINT Adapter, bool visibleOnly, REFIID riid,
+                              void** ppvAdapter, HRESULT* result, PFN_EnumHighPerformance enumerate,
+                              PFN_CheckAdapter check);
+
+    static void Invalidate();
+
+  private:
+    struct Snapshot
+    {
+        uint64_t id = 0;
+        DxgiAdapterSnapshot adapters;
+
+        // Same object as the factory, not held so the snapshot doesn't keep it alive
+        IDXGIFactory6* factory6 = nullptr;
+
+        // Cleared by the factory's private data when it is destroyed
+        std::shared_ptr<std::atomic<bool>> factoryAlive;
+
+        bool eventRegistered = false;
+        DWORD eventCookie = 0;
+    };
+
+    static constexpr size_t MaxSnapshots = 16;
+
+    // Served under the shared lock, building and dropping snapshots takes it exclusively
+    inline static std::shared_mutex _mutex;
+    inline static ankerl::unordered_dense::map<IDXGIFactory*, Snapshot> _snapshots;
+    inline static uint64_t _lastSnapshotId = 0;
+    inline static HANDLE _adaptersChangedEvent = nullptr;
+    inline static std::atomic<bool> _adaptersChanged = false;
+
+    // LUIDs which went through the check callback
+    inline static ankerl::unordered_dense::set<uint64_t> _checkedAdapters;
+
+    // Enumeration while building can come back through the hooks
+    inline static thread_local bool _building = false;
+
+    static Snapshot* GetSnapshot(IDXGIFactory* realFactory, PFN_EnumHighPerformance enumerate,
+                                 PFN_CheckAdapter check);
+    static bool BuildSnapshot(IDXGIFactory* realFactory, PFN_EnumHighPerformance enumerate, PFN_CheckAdapter check,
+                              Snapshot& snapshot);
+    static bool IsCurrent(const Snapshot& snapshot);
+    static bool GetAdapter(const Snapshot& snapshot, UINT Adapter, bool visibleOnly, REFIID riid, void** ppvAdapter,
+                           HRESULT* result, PFN_EnumHighPerformance enumerate);
+    static void ReleaseSnapshot(IDXGIFactory* realFactory, Snapshot& snapshot);
+    static void ReleaseSnapshots();
+    static bool AttachOwner(IDXGIFactory* realFactory, Snapshot& snapshot);
+    static bool AdaptersChanged();
+};
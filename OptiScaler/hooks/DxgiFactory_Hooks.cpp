@@ -3,6 +3,7 @@
 #include <Config.h>
 
 #include "D3D12_Hooks.h"
+#include "DxgiFactory_AdapterTopology.h"
 
 #include <spoofing/Dxgi_Spoofing.h>
 #include <wrapped/wrapped_swapchain.h>
@@ -731,12 +732,37 @@ HRESULT DxgiFactoryHooks::CreateSwapChainForCoreWindow(IDXGIFactory2* realFactor
     return result;
 }
 
+HRESULT DxgiFactoryHooks::EnumHighPerformanceAdapter(IDXGIFactory6* factory6, UINT Adapter, REFIID riid,
+                                                     void** ppvAdapter)
+{
+    if (o_EnumAdapterByGpuPreference == nullptr)
+        return E_NOTIMPL;
+
+    ScopedSkipDxgiLoadChecks skipDxgiLoadChecks {};
+    ScopedSkipHighPerfCheck skipHighPerfCheck {};
+
+    return o_EnumAdapterByGpuPreference(factory6, Adapter, DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE, riid,
+                                        (IUnknown**) ppvAdapter);
+}
+
+void DxgiFactoryHooks::CheckNewAdapter(IUnknown* unkAdapter)
+{
+    CheckAdapter(unkAdapter);
+    DxgiSpoofing::AttachToAdapter(unkAdapter);
+}
+
 HRESULT DxgiFactoryHooks::EnumAdapters(IDXGIFactory* realFactory, UINT Adapter, IDXGIAdapter** ppAdapter)
 {
     HRESULT result = S_OK;
 
     if (!_skipHighPerfCheck && Config::Instance()->PreferDedicatedGpu.value_or_default())
     {
+        if (DxgiAdapterTopology::TryGetAdapter(realFactory, Adapter, true, __uuidof(IDXGIAdapter), (void**) ppAdapter,
+                                               &result, EnumHighPerformanceAdapter, CheckNewAdapter))
+        {
+            return result;
+        }
+
         if (Config::Instance()->PreferFirstDedicatedGpu.value_or_default() && Adapter > 0)
         {
             LOG_DEBUG("{}, returning not found", Adapter);
@@ -812,6 +838,12 @@ HRESULT DxgiFactoryHooks::EnumAdapters1(IDXGIFactory1* realFactory, UINT Adapter
 
     if (!_skipHighPerfCheck && Config::Instance()->PreferDedicatedGpu.value_or_default())
     {
+        if (DxgiAdapterTopology::TryGetAdapter(realFactory, Adapter, true, __uuidof(IDXGIAdapter1), (void**) ppAdapter,
+                                               &result, EnumHighPerformanceAdapter, CheckNewAdapter))
+        {
+            return result;
+        }
+
         LOG_WARN("High perf GPU selection");
 
         if (Config::Instance()->PreferFirstDedicatedGpu.value_or_default() && Adapter > 0)
@@ -910,6 +942,14 @@ HRESULT DxgiFactoryHooks::EnumAdapterByGpuPreference(IDXGIFactory6* realFactory,
 {
     HRESULT result;
 
+    if (GpuPreference == DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE && !_skipHighPerfCheck &&
+        Config::Instance()->PreferDedicatedGpu.value_or_default() &&
+        DxgiAdapterTopology::TryGetAdapter(realFactory, Adapter, false, riid, ppvAdapter, &result,
+                                           EnumHighPerformanceAdapter, CheckNewAdapter))
+    {
+        return result;
+    }
+
     {
         ScopedSkipDxgiLoadChecks skipDxgiLoadChecks {};
         result = o_EnumAdapterByGpuPreference(realFactory, Adapter, GpuPreference, riid, (IUnknown**) ppvAdapter);
@@ -58,6 +58,10 @@ class DxgiFactoryHooks
 
     static void CheckAdapter(IUnknown* unkAdapter);
 
+    // Feed DxgiAdapterTopology snapshots
+    static HRESULT EnumHighPerformanceAdapter(IDXGIFactory6* factory6, UINT Adapter, REFIID riid, void** ppvAdapter);
+    static void CheckNewAdapter(IUnknown* unkAdapter);
+
     class ScopedSkipFGSCCreation
     {
       private:
@@ -1,6 +1,7 @@
 #include "DxgiFactory_WrappedCalls.h"
 
 #include "FG_Hooks.h"
+#include "DxgiFactory_AdapterTopology.h"
 
 #include <Config.h>
 
@@ -515,12 +516,33 @@ HRESULT DxgiFactoryWrappedCalls::CreateSwapChainForCoreWindow(IDXGIFactory2* rea
     return result;
 }
 
+HRESULT DxgiFactoryWrappedCalls::EnumHighPerformanceAdapter(IDXGIFactory6* factory6, UINT Adapter, REFIID riid,
+                                                            void** ppvAdapter)
+{
+    ScopedSkipDxgiLoadChecks skipDxgiLoadChecks {};
+    ScopedSkipHighPerfCheck skipHighPerfCheck {};
+
+    return factory6->EnumAdapterByGpuPreference(Adapter, DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE, riid, ppvAdapter);
+}
+
+void DxgiFactoryWrappedCalls::CheckNewAdapter(IUnknown* unkAdapter)
+{
+    CheckAdapter(unkAdapter);
+    DxgiSpoofing::AttachToAdapter(unkAdapter);
+}
+
 HRESULT DxgiFactoryWrappedCalls::EnumAdapters(IDXGIFactory* realFactory, UINT Adapter, IDXGIAdapter** ppAdapter)
 {
     HRESULT result = S_OK;
 
     if (!_skipHighPerfCheck && Config::Instance()->PreferDedicatedGpu.value_or_default())
     {
+        if (DxgiAdapterTopology::TryGetAdapter(realFactory, Adapter, true, __uuidof(IDXGIAdapter), (void**) ppAdapter,
+                                               &result, EnumHighPerformanceAdapter, CheckNewAdapter))
+        {
+            return result;
+        }
+
         if (Config::Instance()->PreferFirstDedicatedGpu.value_or_default() && Adapter > 0)
         {
             LOG_DEBUG("{}, returning not found", Adapter);
@@ -595,6 +617,12 @@ HRESULT DxgiFactoryWrappedCalls::EnumAdapters1(IDXGIFactory1* realFactory, UINT
 
     if (!_skipHighPerfCheck && Config::Instance()->PreferDedicatedGpu.value_or_default())
     {
+        if (DxgiAdapterTopology::TryGetAdapter(realFactory, Adapter, true, __uuidof(IDXGIAdapter1), (void**) ppAdapter,
+                                               &result, EnumHighPerformanceAdapter, CheckNewAdapter))
+        {
+            return result;
+        }
+
         LOG_WARN("High perf GPU selection");
 
         if (Config::Instance()->PreferFirstDedicatedGpu.value_or_default() && Adapter > 0)
@@ -694,6 +722,14 @@ HRESULT DxgiFactoryWrappedCalls::EnumAdapterByGpuPreference(IDXGIFactory6* realF
 {
     HRESULT result;
 
+    if (GpuPreference == DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE && !_skipHighPerfCheck &&
+        Config::Instance()->PreferDedicatedGpu.value_or_default() &&
+        DxgiAdapterTopology::TryGetAdapter(realFactory, Adapter, false, riid, ppvAdapter, &result,
+                                           EnumHighPerformanceAdapter, CheckNewAdapter))
+    {
+        return result;
+    }
+
     {
         ScopedSkipDxgiLoadChecks skipDxgiLoadChecks {};
         result = realFactory->EnumAdapterByGpuPreference(Adapter, GpuPreference, riid, ppvAdapter);
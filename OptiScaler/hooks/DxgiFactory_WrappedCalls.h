@@ -34,6 +34,10 @@ class DxgiFactoryWrappedCalls
 
     static void CheckAdapter(IUnknown* unkAdapter);
 
+    // Feed DxgiAdapterTopology snapshots
+    static HRESULT EnumHighPerformanceAdapter(IDXGIFactory6* factory6, UINT Adapter, REFIID riid, void** ppvAdapter);
+    static void CheckNewAdapter(IUnknown* unkAdapter);
+
     class ScopedSkipFGSCCreation
     {
       private:
@@ -8,6 +8,9 @@
 
 #include <DllNames.h>
 
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::Loader
+
 static DxgiProxy::PFN_CreateDxgiFactory o_CreateDXGIFactory = nullptr;
 static DxgiProxy::PFN_CreateDxgiFactory1 o_CreateDXGIFactory1 = nullptr;
 static DxgiProxy::PFN_CreateDxgiFactory2 o_CreateDXGIFactory2 = nullptr;
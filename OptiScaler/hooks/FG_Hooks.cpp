@@ -18,6 +18,9 @@
 
 #include <d3d12.h>
 
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::FG
+
 static bool CheckForFGStatus()
 {
     // Need to check overlay menu parameter, goes to places it shouldn't go
@@ -838,137 +841,250 @@ HRESULT FGHooks::hkFGPresent1(void* This, UINT SyncInterval, UINT Flags,
     return result;
 }
 
-HRESULT FGHooks::FGPresent(void* This, UINT SyncInterval, UINT Flags, const DXGI_PRESENT_PARAMETERS* pPresentParameters)
+uint64_t FGHooks::PresentPipelineStateKey()
 {
-    _lastPresentFlags = Flags;
-
-    if (State::Instance().isShuttingDown)
+    // Config part is only rebuilt after a change was dispatched
+    if (_presentConfigChanged.exchange(false, std::memory_order_acquire))
     {
-        if (pPresentParameters == nullptr)
-            return o_FGSCPresent(This, SyncInterval, Flags);
-        else
-            return o_FGSCPresent1(This, SyncInterval, Flags, pPresentParameters);
+        auto config = Config::Instance();
+
+        uint64_t configKey = config->FGUseMutexForSwapchain.value_or_default() ? 1 : 0;
+        configKey = (configKey << 1) | (config->FGDrawUIOverFG.value_or_default() ? 1 : 0);
+        configKey = (configKey << 1) | (config->ForceVsync.has_value() ? 1 : 0);
+
+        _presentConfigKey = configKey;
     }
 
-    auto willPresent = (Flags & DXGI_PRESENT_TEST) == 0;
+    auto& state = State::Instance();
 
-    if (willPresent)
-    {
-        State::Instance().FGLastFrame++;
+    uint64_t key = (uint64_t) state.activeFgInput;
+    key = (key << 8) | (uint64_t) state.activeFgOutput;
+    key = (key << 1) | (state.reflexLimitsFps ? 1 : 0);
 
-        double ftDelta = 0.0f;
-        auto now = Util::MillisecondsNow();
+    return (key << 3) | _presentConfigKey;
+}
 
-        if (_lastFGFrameTime != 0)
-            ftDelta = now - _lastFGFrameTime;
+void FGHooks::InvalidatePresentPipeline() { _presentConfigChanged.store(true, std::memory_order_release); }
 
-        _lastFGFrameTime = now;
-        State::Instance().lastFGFrameTime = ftDelta;
+// Presents can come from more than one thread, only the first one builds the list
+void FGHooks::InitPresentPipeline() { std::call_once(_presentPipelineBuilt, BuildPresentPipeline); }
 
-        LOG_DEBUG("flags: {:X}, Frametime: {}", Flags, ftDelta);
-    }
+void FGHooks::BuildPresentPipeline()
+{
+    _presentPipeline.SetStateKey(PresentPipelineStateKey);
 
-    if (willPresent && State::Instance().currentCommandQueue != nullptr)
-    {
-        UpscalerTimeDx12::ReadUpscalingTime(State::Instance().currentCommandQueue);
-    }
+    _presentPipeline.AddStage("Frame Time", nullptr,
+                              [](FGPresentContext& ctx)
+                              {
+                                  if (!ctx.willPresent)
+                                      return;
 
-    auto fg = State::Instance().currentFG;
-    bool mutexUsed = false;
-    if (willPresent && fg != nullptr && fg->IsActive() &&
-        Config::Instance()->FGUseMutexForSwapchain.value_or_default() && fg->Mutex.getOwner() != 2)
-    {
-        LOG_TRACE("Waiting FG->Mutex 2, current: {}", fg->Mutex.getOwner());
-        fg->Mutex.lock(2);
-        mutexUsed = true;
-        LOG_TRACE("Accuired FG->Mutex: {}", fg->Mutex.getOwner());
-    }
+                                  State::Instance().FGLastFrame++;
 
-    if (willPresent && fg != nullptr)
-    {
-        // Some games use this callback to render UI even when
-        // FG is disabled. So call it when there is FGFeature
-        if (State::Instance().activeFgInput == FGInput::FSRFG)
-            ffxPresentCallback();
-        else if (State::Instance().activeFgInput == FGInput::FSRFG30)
-            FSR3FG::ffxPresentCallback();
+                                  double ftDelta = 0.0f;
+                                  auto now = Util::MillisecondsNow();
 
-        // And if Optiscalers FG is active call
-        // FG Features present
-        fg->Present();
-    }
+                                  if (_lastFGFrameTime != 0)
+                                      ftDelta = now - _lastFGFrameTime;
 
-    if (willPresent)
-    {
-        ResTrack_Dx12::ClearPossibleHudless();
-        Hudfix_Dx12::PresentStart();
-    }
+                                  _lastFGFrameTime = now;
+                                  State::Instance().lastFGFrameTime = ftDelta;
 
-    if (willPresent && fg != nullptr && fg->IsUsingUI() && Config::Instance()->FGDrawUIOverFG.value_or_default())
-    {
-        ID3D12Resource* backBuffer = nullptr;
-        auto swapchain = ((IDXGISwapChain3*) This);
-        auto swapchainIndex = swapchain->GetCurrentBackBufferIndex();
+                                  LOG_DEBUG("flags: {:X}, Frametime: {}", ctx.flags, ftDelta);
+                              });
 
-        if (swapchain->GetBuffer(swapchainIndex, IID_PPV_ARGS(&backBuffer)) == S_OK)
+    _presentPipeline.AddStage("Upscaler Time", nullptr,
+                              [](FGPresentContext& ctx)
+                              {
+                                  if (ctx.willPresent && State::Instance().currentCommandQueue != nullptr)
+                                      UpscalerTimeDx12::ReadUpscalingTime(State::Instance().currentCommandQueue);
+                              });
+
+    _presentPipeline.AddStage(
+        "FG Mutex", []() { return Config::Instance()->FGUseMutexForSwapchain.value_or_default(); },
+        [](FGPresentContext& ctx)
+        {
+            auto fg = ctx.fg;
+
+            if (!ctx.willPresent || fg == nullptr || !fg->IsActive() || fg->Mutex.getOwner() == 2)
+                return;
+
+            LOG_TRACE("Waiting FG->Mutex 2, current: {}", fg->Mutex.getOwner());
+            fg->Mutex.lock(2);
+            ctx.mutexUsed = true;
+            LOG_TRACE("Accuired FG->Mutex: {}", fg->Mutex.getOwner());
+        });
+
+    // Some games use this callback to render UI even when
+    // FG is disabled. So call it when there is FGFeature
+    _presentPipeline.AddStage(
+        "Present Callback",
+        []()
+        {
+            return State::Instance().activeFgInput == FGInput::FSRFG ||
+                   State::Instance().activeFgInput == FGInput::FSRFG30;
+        },
+        [](FGPresentContext& ctx)
+        {
+            if (!ctx.willPresent || ctx.fg == nullptr)
+                return;
+
+            if (State::Instance().activeFgInput == FGInput::FSRFG)
+                ffxPresentCallback();
+            else if (State::Instance().activeFgInput == FGInput::FSRFG30)
+                FSR3FG::ffxPresentCallback();
+        });
+
+    // And if Optiscalers FG is active call
+    // FG Features present
+    _presentPipeline.AddStage("FG Present", nullptr,
+                              [](FGPresentContext& ctx)
+                              {
+                                  if (ctx.willPresent && ctx.fg != nullptr)
+                                      ctx.fg->Present();
+                              });
+
+    _presentPipeline.AddStage("Hudless Clear", nullptr,
+                              [](FGPresentContext& ctx)
+                              {
+                                  if (ctx.willPresent)
+                                      ResTrack_Dx12::ClearPossibleHudless();
+                              });
+
+    _presentPipeline.AddStage("Tracking Hooks", nullptr,
+                              [](FGPresentContext& ctx)
+                              {
+                                  if (ctx.willPresent)
+                                      ResTrack_Dx12::UpdateArming();
+                              });
+
+    _presentPipeline.AddStage("Hudfix Start", nullptr,
+                              [](FGPresentContext& ctx)
+                              {
+                                  if (ctx.willPresent)
+                                      Hudfix_Dx12::PresentStart();
+                              });
+
+    _presentPipeline.AddStage(
+        "Draw UI Over FG", []() { return Config::Instance()->FGDrawUIOverFG.value_or_default(); },
+        [](FGPresentContext& ctx)
         {
-            auto result = fg->GetResourceCopy(FG_ResourceType::HudlessColor, D3D12_RESOURCE_STATE_PRESENT, backBuffer);
-            backBuffer->Release();
+            if (!ctx.willPresent || ctx.fg == nullptr || !ctx.fg->IsUsingUI())
+                return;
 
-            if (!result)
-                LOG_WARN("Couldn't copy hudless into the backbuffer");
-        }
-    }
+            ID3D12Resource* backBuffer = nullptr;
+            auto swapchain = ((IDXGISwapChain3*) ctx.swapchain);
+            auto swapchainIndex = swapchain->GetCurrentBackBufferIndex();
 
-    if (willPresent && Config::Instance()->ForceVsync.has_value())
-    {
-        LOG_DEBUG("ForceVsync: {}, VsyncInterval: {}, SCAllowTearing: {}, realExclusiveFullscreen: {}",
-                  Config::Instance()->ForceVsync.value(), Config::Instance()->VsyncInterval.value_or_default(),
-                  State::Instance().SCAllowTearing, State::Instance().realExclusiveFullscreen);
+            if (swapchain->GetBuffer(swapchainIndex, IID_PPV_ARGS(&backBuffer)) == S_OK)
+            {
+                auto result =
+                    ctx.fg->GetResourceCopy(FG_ResourceType::HudlessColor, D3D12_RESOURCE_STATE_PRESENT, backBuffer);
+                backBuffer->Release();
 
-        if (!Config::Instance()->ForceVsync.value())
+                if (!result)
+                    LOG_WARN("Couldn't copy hudless into the backbuffer");
+            }
+        });
+
+    _presentPipeline.AddStage(
+        "Vsync Override", []() { return Config::Instance()->ForceVsync.has_value(); },
+        [](FGPresentContext& ctx)
         {
-            SyncInterval = 0;
+            if (!ctx.willPresent)
+                return;
 
-            if (State::Instance().SCAllowTearing && !State::Instance().realExclusiveFullscreen)
+            LOG_DEBUG("ForceVsync: {}, VsyncInterval: {}, SCAllowTearing: {}, realExclusiveFullscreen: {}",
+                      Config::Instance()->ForceVsync.value(), Config::Instance()->VsyncInterval.value_or_default(),
+                      State::Instance().SCAllowTearing, State::Instance().realExclusiveFullscreen);
+
+            if (!Config::Instance()->ForceVsync.value())
             {
-                LOG_DEBUG("Adding DXGI_PRESENT_ALLOW_TEARING");
-                Flags |= DXGI_PRESENT_ALLOW_TEARING;
+                ctx.syncInterval = 0;
+
+                if (State::Instance().SCAllowTearing && !State::Instance().realExclusiveFullscreen)
+                {
+                    LOG_DEBUG("Adding DXGI_PRESENT_ALLOW_TEARING");
+                    ctx.flags |= DXGI_PRESENT_ALLOW_TEARING;
+                }
             }
-        }
-        else
-        {
-            SyncInterval = Config::Instance()->VsyncInterval.value_or_default();
+            else
+            {
+                ctx.syncInterval = Config::Instance()->VsyncInterval.value_or_default();
 
-            if (SyncInterval < 1)
-                SyncInterval = 1;
+                if (ctx.syncInterval < 1)
+                    ctx.syncInterval = 1;
 
-            LOG_DEBUG("Removing DXGI_PRESENT_ALLOW_TEARING");
-            Flags &= ~DXGI_PRESENT_ALLOW_TEARING;
-        }
+                LOG_DEBUG("Removing DXGI_PRESENT_ALLOW_TEARING");
+                ctx.flags &= ~DXGI_PRESENT_ALLOW_TEARING;
+            }
 
-        LOG_DEBUG("Final SyncInterval: {}", SyncInterval);
-    }
+            LOG_DEBUG("Final SyncInterval: {}", ctx.syncInterval);
+        });
 
-    HRESULT result;
-    if (pPresentParameters == nullptr)
-        result = o_FGSCPresent(This, SyncInterval, Flags);
-    else
-        result = o_FGSCPresent1(This, SyncInterval, Flags, pPresentParameters);
-    LOG_DEBUG("Result: {:X}", result);
+    _presentPipeline.AddStage("Present", nullptr,
+                              [](FGPresentContext& ctx)
+                              {
+                                  if (ctx.presentParameters == nullptr)
+                                      ctx.result = o_FGSCPresent(ctx.swapchain, ctx.syncInterval, ctx.flags);
+                                  else
+                                      ctx.result = o_FGSCPresent1(ctx.swapchain, ctx.syncInterval, ctx.flags,
+                                                                  ctx.presentParameters);
+
+                                  LOG_DEBUG("Result: {:X}", ctx.result);
+                              });
 
-    Hudfix_Dx12::PresentEnd();
+    _presentPipeline.AddStage("Hudfix End", nullptr, [](FGPresentContext& ctx) { Hudfix_Dx12::PresentEnd(); });
 
-    if (willPresent && !State::Instance().reflexLimitsFps && State::Instance().activeFgOutput != FGOutput::NoFG)
-        FrameLimit::sleep(fg != nullptr ? fg->IsActive() : false);
+    _presentPipeline.AddStage(
+        "Frame Limit",
+        []()
+        { return !State::Instance().reflexLimitsFps && State::Instance().activeFgOutput != FGOutput::NoFG; },
+        [](FGPresentContext& ctx)
+        {
+            if (ctx.willPresent)
+                FrameLimit::sleep(ctx.fg != nullptr ? ctx.fg->IsActive() : false);
+        });
+
+    // Not gated by config, mutex might be taken before a config change
+    _presentPipeline.AddStage("FG Mutex Release", nullptr,
+                              [](FGPresentContext& ctx)
+                              {
+                                  if (!ctx.mutexUsed || ctx.fg == nullptr)
+                                      return;
+
+                                  LOG_TRACE("Releasing FG->Mutex: {}", ctx.fg->Mutex.getOwner());
+                                  ctx.fg->Mutex.unlockThis(2);
+                              });
+}
+
+std::vector<StageTiming> FGHooks::PresentStageTimings() { return _presentPipeline.Timings(); }
+
+HRESULT FGHooks::FGPresent(void* This, UINT SyncInterval, UINT Flags, const DXGI_PRESENT_PARAMETERS* pPresentParameters)
+{
+    _lastPresentFlags = Flags;
 
-    if (mutexUsed && fg != nullptr)
+    if (State::Instance().isShuttingDown)
     {
-        LOG_TRACE("Releasing FG->Mutex: {}", fg->Mutex.getOwner());
-        fg->Mutex.unlockThis(2);
+        if (pPresentParameters == nullptr)
+            return o_FGSCPresent(This, SyncInterval, Flags);
+        else
+            return o_FGSCPresent1(This, SyncInterval, Flags, pPresentParameters);
     }
 
-    return result;
+    InitPresentPipeline();
+
+    FGPresentContext ctx {};
+    ctx.swapchain = This;
+    ctx.syncInterval = SyncInterval;
+    ctx.flags = Flags;
+    ctx.presentParameters = pPresentParameters;
+    ctx.willPresent = (Flags & DXGI_PRESENT_TEST) == 0;
+    ctx.fg = State::Instance().currentFG;
+
+    _presentPipeline.Run(ctx);
+
+    return ctx.result;
 }
 
 HRESULT FGHooks::hkFGRelease(IDXGISwapChain* This)
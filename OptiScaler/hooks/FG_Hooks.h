@@ -2,8 +2,26 @@
 
 #include <pch.h>
 
+#include <misc/StagePipeline.h>
+
 #include <dxgi1_6.h>
 
+class IFGFeature_Dx12;
+
+// Shared state of the FGPresent stages
+struct FGPresentContext
+{
+    void* swapchain = nullptr;
+    UINT syncInterval = 0;
+    UINT flags = 0;
+    const DXGI_PRESENT_PARAMETERS* presentParameters = nullptr;
+
+    bool willPresent = false;
+    IFGFeature_Dx12* fg = nullptr;
+    bool mutexUsed = false;
+    HRESULT result = S_OK;
+};
+
 class FGHooks
 {
   public:
@@ -15,6 +33,12 @@ class FGHooks
                                           DXGI_SWAP_CHAIN_FULLSCREEN_DESC* pFullscreenDesc,
                                           IDXGIOutput* pRestrictToOutput, IDXGISwapChain1** ppSwapChain);
 
+    // CPU time spent in each FGPresent stage, for the overlay
+    static std::vector<StageTiming> PresentStageTimings();
+
+    // Config options the FGPresent stages depend on were changed, by the menu or an ini reload
+    static void InvalidatePresentPipeline();
+
   private:
     typedef HRESULT (*PFN_Present)(void* This, UINT SyncInterval, UINT Flags);
     typedef HRESULT (*PFN_Present1)(void* This, UINT SyncInterval, UINT Flags,
@@ -46,6 +70,14 @@ class FGHooks
     inline static bool _skipPresent1 = false;
     inline static UINT _lastPresentFlags = 0;
     inline static double _lastFGFrameTime = 0.0;
+    inline static StagePipeline<FGPresentContext> _presentPipeline;
+    inline static std::once_flag _presentPipelineBuilt;
+    inline static std::atomic<bool> _presentConfigChanged = true;
+    inline static uint64_t _presentConfigKey = 0;
+
+    static void InitPresentPipeline();
+    static void BuildPresentPipeline();
+    static uint64_t PresentPipelineStateKey();
 
     static void HookFGSwapchain(IDXGISwapChain* pSwapChain);
 
@@ -0,0 +1,372 @@
+#include "HookRegistry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool InGroups(const HookInfo& hook, std::span<const std::string_view> groups)
+{
+    return std::find(groups.begin(), groups.end(), hook.group) != groups.end();
+}
+
+HookRegistry& HookRegistry::Instance()
+{
+    static HookRegistry instance(DetoursHookBackend());
+    return instance;
+}
+
+const void* HookRegistry::DecodeJump(const uint8_t* code, size_t count, const void* address, bool& indirect)
+{
+    auto base = reinterpret_cast<uintptr_t>(address);
+    indirect = false;
+
+    // jmp rel8
+    if (count >= 2 && code[0] == 0xEB)
+        return reinterpret_cast<const void*>(base + 2 + static_cast<int8_t>(code[1]));
+
+    // jmp rel32
+    if (count >= 5 && code[0] == 0xE9)
+    {
+        int32_t offset;
+        std::memcpy(&offset, code + 1, sizeof(offset));
+        return reinterpret_cast<const void*>(base + 5 + offset);
+    }
+
+    // jmp [rip+disp32]
+    if (count >= 6 && code[0] == 0xFF && code[1] == 0x25)
+    {
+        int32_t offset;
+        std::memcpy(&offset, code + 2, sizeof(offset));
+        indirect = true;
+        return reinterpret_cast<const void*>(base + 6 + offset);
+    }
+
+    // mov rax, imm64; jmp rax
+    if (count >= 12 && code[0] == 0x48 && code[1] == 0xB8 && code[10] == 0xFF && code[11] == 0xE0)
+    {
+        uint64_t destination;
+        std::memcpy(&destination, code + 2, sizeof(destination));
+        return reinterpret_cast<const void*>(destination);
+    }
+
+    return nullptr;
+}
+
+bool HookRegistry::CheckPrologue(HookInfo& hook)
+{
+    uint8_t code[16] {};
+
+    if (!_backend->ReadCode(hook.target, code, sizeof(code)))
+    {
+        LOG_WARN("{}::{} can't read target {:X}", hook.group, hook.name, (size_t) hook.target);
+        return false;
+    }
+
+    bool indirect = false;
+    auto destination = DecodeJump(code, sizeof(code), hook.target, indirect);
+
+    if (destination != nullptr && indirect)
+    {
+        const void* pointer = nullptr;
+
+        if (_backend->ReadCode(destination, reinterpret_cast<uint8_t*>(&pointer), sizeof(pointer)))
+            destination = pointer;
+    }
+
+    hook.chained = destination != nullptr;
+
+    if (hook.chained)
+    {
+        hook.chainedModule = _backend->ModuleName(destination);
+        LOG_INFO("{}::{} is already hooked, jumps to {:X} ({})", hook.group, hook.name, (size_t) destination,
+                 hook.chainedModule.empty() ? "unknown module" : hook.chainedModule);
+
+        // Detours follows the jump, the expected prologue is behind it
+        return true;
+    }
+
+    if (hook.expectedPrologue.empty())
+        return true;
+
+    auto count = std::min(hook.expectedPrologue.size(), sizeof(code));
+
+    if (std::memcmp(code, hook.expectedPrologue.data(), count) != 0)
+    {
+        LOG_WARN("{}::{} prologue doesn't match, skipping", hook.group, hook.name);
+        return false;
+    }
+
+    return true;
+}
+
+void HookRegistry::Declare(std::string_view group, std::string_view name, void** original, void* detour,
+                           std::span<const uint8_t> expectedPrologue)
+{
+    if (original == nullptr || detour == nullptr)
+        return;
+
+    std::scoped_lock lock(_mutex);
+
+    auto it = std::find_if(_hooks.begin(), _hooks.end(), [original](const HookInfo& hook)
+                           { return hook.original == original; });
+
+    if (it != _hooks.end())
+    {
+        if (it->state == HookState::Installed)
+            return;
+
+        it->group = group;
+        it->name = name;
+        it->detour = detour;
+        it->target = *original;
+        it->expectedPrologue.assign(expectedPrologue.begin(), expectedPrologue.end());
+        it->state = HookState::Declared;
+        return;
+    }
+
+    auto& hook = _hooks.emplace_back();
+    hook.group = group;
+    hook.name = name;
+    hook.original = original;
+    hook.detour = detour;
+    hook.target = *original;
+    hook.expectedPrologue.assign(expectedPrologue.begin(), expectedPrologue.end());
+}
+
+bool HookRegistry::Install(std::span<const std::string_view> groups)
+{
+    std::scoped_lock lock(_mutex);
+
+    std::vector<HookInfo*> pending;
+
+    for (auto& hook : _hooks)
+    {
+        if (!InGroups(hook, groups) || hook.state == HookState::Installed)
+            continue;
+
+        // Target might have been filled after the declaration
+        if (hook.target == nullptr)
+            hook.target = *hook.original;
+
+        if (hook.target == nullptr)
+        {
+            hook.state = HookState::Skipped;
+            continue;
+        }
+
+        if (!CheckPrologue(hook))
+        {
+            hook.state = HookState::Skipped;
+            continue;
+        }
+
+        pending.push_back(&hook);
+    }
+
+    auto markInstalled = [&]()
+    {
+        for (auto group : groups)
+        {
+            std::erase(_installOrder, group);
+            _installOrder.emplace_back(group);
+        }
+    };
+
+    if (pending.empty())
+    {
+        markInstalled();
+        return true;
+    }
+
+    // A failed attach fails the whole commit with Detours, the transaction is redone without it
+    std::vector<HookInfo*> attached;
+    attached.reserve(pending.size());
+
+    while (!pending.empty())
+    {
+        if (!_backend->Begin())
+        {
+            LOG_ERROR("Can't begin transaction");
+            return false;
+        }
+
+        attached.clear();
+
+        for (auto hook : pending)
+        {
+            *hook->original = hook->target;
+
+            auto start = std::chrono::steady_clock::now();
+            auto result = _backend->Attach(hook->original, hook->detour);
+            hook->attachMs = ElapsedMs(start);
+
+            if (!result)
+            {
+                LOG_ERROR("{}::{} attach failed", hook->group, hook->name);
+                hook->state = HookState::Failed;
+                continue;
+            }
+
+            attached.push_back(hook);
+        }
+
+        if (attached.size() == pending.size())
+            break;
+
+        _backend->Abort();
+
+        for (auto hook : pending)
+            *hook->original = hook->target;
+
+        pending = attached;
+    }
+
+    if (attached.empty())
+        return false;
+
+    auto start = std::chrono::steady_clock::now();
+
+    if (!_backend->Commit())
+    {
+        LOG_ERROR("Commit failed, {} hooks not installed", attached.size());
+
+        for (auto hook : attached)
+        {
+            hook->state = HookState::Failed;
+            *hook->original = hook->target;
+        }
+
+        return false;
+    }
+
+    auto commitMs = ElapsedMs(start);
+
+    for (auto hook : attached)
+    {
+        hook->state = HookState::Installed;
+        hook->commitMs = commitMs;
+    }
+
+    markInstalled();
+
+    LOG_DEBUG("{} hooks in {} groups, commit: {:.3f} ms", attached.size(), groups.size(), commitMs);
+
+    return std::none_of(_hooks.begin(), _hooks.end(), [groups](const HookInfo& hook)
+                        { return InGroups(hook, groups) && hook.state == HookState::Failed; });
+}
+
+bool HookRegistry::RemoveLocked(std::span<const std::string_view> groups, bool forget)
+{
+    std::vector<HookInfo*> installed;
+
+    // Groups in the given order, hooks of a group in reverse declaration order
+    for (auto group : groups)
+    {
+        for (auto it = _hooks.rbegin(); it != _hooks.rend(); ++it)
+        {
+            if (it->group == group && it->state == HookState::Installed)
+                installed.push_back(&*it);
+        }
+    }
+
+    auto result = true;
+
+    if (!installed.empty())
+    {
+        if (!_backend->Begin())
+        {
+            LOG_ERROR("Can't begin transaction");
+            return false;
+        }
+
+        for (auto hook : installed)
+        {
+            if (!_backend->Detach(hook->original, hook->detour))
+                LOG_ERROR("{}::{} detach failed", hook->group, hook->name);
+        }
+
+        result = _backend->Commit();
+
+        if (!result)
+        {
+            LOG_ERROR("Commit failed, {} hooks still installed", installed.size());
+            return false;
+        }
+
+        for (auto hook : installed)
+        {
+            hook->state = HookState::Declared;
+            *hook->original = hook->target;
+        }
+
+        LOG_DEBUG("{} hooks removed from {} groups", installed.size(), groups.size());
+    }
+
+    for (auto group : groups)
+        std::erase(_installOrder, group);
+
+    if (forget)
+        std::erase_if(_hooks, [groups](const HookInfo& hook) { return InGroups(hook, groups); });
+
+    return result;
+}
+
+bool HookRegistry::Remove(std::span<const std::string_view> groups, bool forget)
+{
+    std::scoped_lock lock(_mutex);
+    return RemoveLocked(groups, forget);
+}
+
+void HookRegistry::RemoveAll()
+{
+    std::scoped_lock lock(_mutex);
+
+    // Copied, removing edits the install order
+    std::vector<std::string> order(_installOrder.rbegin(), _installOrder.rend());
+    std::vector<std::string_view> groups(order.begin(), order.end());
+
+    RemoveLocked(groups, false);
+}
+
+bool HookRegistry::IsInstalled(std::string_view group) const
+{
+    std::scoped_lock lock(_mutex);
+
+    auto found = false;
+
+    for (auto& hook : _hooks)
+    {
+        if (hook.group != group)
+            continue;
+
+        if (hook.state == HookState::Installed)
+            found = true;
+        else if (hook.state == HookState::Declared || hook.state == HookState::Failed)
+            return false;
+    }
+
+    return found;
+}
+
+std::vector<HookInfo> HookRegistry::Hooks() const
+{
+    std::scoped_lock lock(_mutex);
+    return _hooks;
+}
+
+void HookRegistry::LogSummary() const
+{
+    std::scoped_lock lock(_mutex);
+
+    for (auto& hook : _hooks)
+    {
+        LOG_INFO("{}::{} state: {}, attach: {:.3f} ms, commit: {:.3f} ms{}", hook.group, hook.name,
+                 (uint32_t) hook.state, hook.attachMs, hook.commitMs,
+                 hook.chained ? std::format(", chained to {}", hook.chainedModule) : "");
+    }
+}
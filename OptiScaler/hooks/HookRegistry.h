@@ -0,0 +1,102 @@
+#pragma once
+#include <pch.h>
+
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Patching operations used by the registry, Detours in the game. Can be replaced to run the
+// bookkeeping without patching anything.
+class IHookBackend
+{
+  public:
+    virtual ~IHookBackend() = default;
+
+    virtual bool Begin() = 0;
+    virtual bool Attach(void** original, void* detour) = 0;
+    virtual bool Detach(void** original, void* detour) = 0;
+    virtual bool Commit() = 0;
+    virtual void Abort() = 0;
+
+    // Copies the first bytes of the function, false when they can't be read
+    virtual bool ReadCode(const void* address, uint8_t* bytes, size_t count) = 0;
+
+    // Name of the module the address is in, empty when unknown
+    virtual std::string ModuleName(const void* address) = 0;
+};
+
+IHookBackend* DetoursHookBackend();
+
+enum class HookState : uint8_t
+{
+    Declared,
+    Installed,
+    Skipped, // Target missing or prologue didn't match
+    Failed,
+};
+
+struct HookInfo
+{
+    std::string group;
+    std::string name;
+    void** original = nullptr; // Points to the o_ pointer, holds the trampoline while installed
+    void* detour = nullptr;
+    void* target = nullptr; // Function address when declared
+    std::vector<uint8_t> expectedPrologue;
+
+    HookState state = HookState::Declared;
+
+    // Target already started with a jump, another overlay or tool hooked it before us
+    bool chained = false;
+    std::string chainedModule;
+
+    double attachMs = 0.0;
+    double commitMs = 0.0; // Whole transaction the hook was installed in
+};
+
+// Keeps the hooks of all subsystems in named groups. Groups are installed and removed in
+// batched transactions and removed in reverse install order.
+class HookRegistry
+{
+    mutable std::mutex _mutex;
+    IHookBackend* _backend = nullptr;
+    std::vector<HookInfo> _hooks;
+    std::vector<std::string> _installOrder;
+
+    bool CheckPrologue(HookInfo& hook);
+    bool RemoveLocked(std::span<const std::string_view> groups, bool forget);
+
+  public:
+    explicit HookRegistry(IHookBackend* backend) : _backend(backend) {}
+
+    static HookRegistry& Instance();
+
+    // Registers a hook of the group. Declaring the same original again updates the target,
+    // null targets are skipped when installing. Expected prologue is optional.
+    void Declare(std::string_view group, std::string_view name, void** original, void* detour,
+                 std::span<const uint8_t> expectedPrologue = {});
+
+    // Installs the declared hooks of the groups which aren't installed yet in one transaction
+    bool Install(std::span<const std::string_view> groups);
+    bool Install(std::string_view group) { return Install(std::span(&group, 1)); }
+
+    // Removes the installed hooks of the groups in one transaction, original pointers get the
+    // declared targets back. Forget drops the declarations too.
+    bool Remove(std::span<const std::string_view> groups, bool forget = false);
+    bool Remove(std::string_view group, bool forget = false) { return Remove(std::span(&group, 1), forget); }
+
+    // All groups, last installed first
+    void RemoveAll();
+
+    bool IsInstalled(std::string_view group) const;
+    std::vector<HookInfo> Hooks() const;
+
+    void LogSummary() const;
+
+    // Recognizes jmp rel8/rel32, jmp [rip+x] and mov rax, imm64; jmp rax at address. Returns the
+    // jump destination, or the address of the pointer holding it when indirect is set. Null when
+    // the code doesn't start with a jump.
+    static const void* DecodeJump(const uint8_t* code, size_t count, const void* address, bool& indirect);
+};
@@ -0,0 +1,56 @@
+#include "HookRegistry.h"
+
+#include <detours/detours.h>
+
+class DetoursBackend final : public IHookBackend
+{
+  public:
+    bool Begin() override
+    {
+        if (DetourTransactionBegin() != NO_ERROR)
+            return false;
+
+        // Only the calling thread is updated, other threads running the patched code aren't suspended.
+        // Hooks on hot paths are attached once before the game uses them and pass through instead.
+        DetourUpdateThread(GetCurrentThread());
+        return true;
+    }
+
+    bool Attach(void** original, void* detour) override { return DetourAttach(original, detour) == NO_ERROR; }
+
+    bool Detach(void** original, void* detour) override { return DetourDetach(original, detour) == NO_ERROR; }
+
+    bool Commit() override { return DetourTransactionCommit() == NO_ERROR; }
+
+    void Abort() override { DetourTransactionAbort(); }
+
+    bool ReadCode(const void* address, uint8_t* bytes, size_t count) override
+    {
+        SIZE_T read = 0;
+        return ReadProcessMemory(GetCurrentProcess(), address, bytes, count, &read) && read == count;
+    }
+
+    std::string ModuleName(const void* address) override
+    {
+        HMODULE module = nullptr;
+
+        if (!GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                                (LPCWSTR) address, &module))
+        {
+            return {};
+        }
+
+        wchar_t path[MAX_PATH] {};
+
+        if (GetModuleFileNameW(module, path, MAX_PATH) == 0)
+            return {};
+
+        return wstring_to_string(std::filesystem::path(path).filename().wstring());
+    }
+};
+
+IHookBackend* DetoursHookBackend()
+{
+    static DetoursBackend backend;
+    return &backend;
+}
@@ -13,6 +13,9 @@
 
 #include <cwctype>
 
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::Loader
+
 #pragma intrinsic(_ReturnAddress)
 
 static inline void NormalizePath(std::string& path)
@@ -3,6 +3,8 @@
 #include <Config.h>
 #include <DllNames.h>
 
+#include <misc/StartupScheduler.h>
+
 #include <proxies/Ntdll_Proxy.h>
 #include <proxies/Kernel32_Proxy.h>
 #include <proxies/NVNGX_Proxy.h>
@@ -27,6 +29,9 @@
 
 #include <fsr4/FSR4ModelSelection.h>
 
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::Loader
+
 HMODULE LibraryLoadHooks::LoadLibraryCheckA(std::string libName, LPCSTR lpLibFullPath)
 {
     auto fullPath = std::string(lpLibFullPath);
@@ -83,9 +88,10 @@ HMODULE LibraryLoadHooks::LoadLibraryCheckW(std::wstring libName, LPCWSTR lpLibF
         }
     }
 
-    // nvngx_dlss
-    if (Config::Instance()->DLSSEnabled.value_or_default() && Config::Instance()->NVNGX_DLSS_Library.has_value() &&
-        CheckDllNameW(&libName, &nvngxDlssNamesW))
+    // nvngx_dlss, DLSSEnabled is final after the DLSS files are found
+    if (Config::Instance()->NVNGX_DLSS_Library.has_value() && CheckDllNameW(&libName, &nvngxDlssNamesW) &&
+        StartupScheduler::Instance().Wait(StartupSteps::DlssFiles) &&
+        Config::Instance()->DLSSEnabled.value_or_default())
     {
         auto nvngxDlss = LoadNvngxDlss(libName);
 
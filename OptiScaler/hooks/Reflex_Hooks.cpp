@@ -1,4 +1,5 @@
 #include "Reflex_Hooks.h"
+#include "Reflex_Timeline.h"
 #include <Config.h>
 
 #include <nvapi/fakenvapi.h>
@@ -97,6 +98,10 @@ NvAPI_Status ReflexHooks::hkNvAPI_D3D_SetLatencyMarker(IUnknown* pDev,
         }
     }
 
+    ReflexTimeline::Instance().RecordMarker(pSetLatencyMarkerParams->frameID,
+                                            (ReflexMarker) pSetLatencyMarkerParams->markerType,
+                                            ReflexTimeline::NowNs());
+
     // For now this means that dlssg inputs require fakenvapi, as otherwise hooks won't be called
     if (pSetLatencyMarkerParams->markerType == RENDERSUBMIT_START && State::Instance().activeFgInput == FGInput::DLSSG)
     {
@@ -139,6 +144,10 @@ NvAPI_Status ReflexHooks::hkNvAPI_D3D12_SetAsyncFrameMarker(ID3D12CommandQueue*
 
     _lastAsyncMarkerFrameId = pSetAsyncFrameMarkerParams->frameID;
 
+    ReflexTimeline::Instance().RecordMarker(pSetAsyncFrameMarkerParams->frameID,
+                                            (ReflexMarker) pSetAsyncFrameMarkerParams->markerType,
+                                            ReflexTimeline::NowNs());
+
     if (pSetAsyncFrameMarkerParams->markerType == OUT_OF_BAND_PRESENT_START)
     {
         constexpr size_t history_size = 12;
@@ -186,6 +195,10 @@ NvAPI_Status ReflexHooks::hkNvAPI_Vulkan_SetLatencyMarker(HANDLE vkDevice,
 
     _updatesWithoutMarker = 0;
 
+    ReflexTimeline::Instance().RecordMarker(pSetLatencyMarkerParams->frameID,
+                                            (ReflexMarker) pSetLatencyMarkerParams->markerType,
+                                            ReflexTimeline::NowNs());
+
     return o_NvAPI_Vulkan_SetLatencyMarker(vkDevice, pSetLatencyMarkerParams);
 }
 
@@ -295,6 +308,26 @@ bool ReflexHooks::updateTimingData()
     if (auto result = hkNvAPI_D3D_GetLatency(_lastSleepDev, &results); result != NVAPI_OK)
         return false;
 
+    for (const auto& report : results.frameReport)
+    {
+        ReflexTimeline::Instance().RecordReport(ReflexLatencyReport {
+            .frameId = report.frameID,
+            .inputSampleTime = report.inputSampleTime,
+            .simStartTime = report.simStartTime,
+            .simEndTime = report.simEndTime,
+            .renderSubmitStartTime = report.renderSubmitStartTime,
+            .renderSubmitEndTime = report.renderSubmitEndTime,
+            .presentStartTime = report.presentStartTime,
+            .presentEndTime = report.presentEndTime,
+            .driverStartTime = report.driverStartTime,
+            .driverEndTime = report.driverEndTime,
+            .osRenderQueueStartTime = report.osRenderQueueStartTime,
+            .osRenderQueueEndTime = report.osRenderQueueEndTime,
+            .gpuRenderStartTime = report.gpuRenderStartTime,
+            .gpuRenderEndTime = report.gpuRenderEndTime,
+        });
+    }
+
     // 64th element have the latest data
     auto& frameReport = results.frameReport[63];
 
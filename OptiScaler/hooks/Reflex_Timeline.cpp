@@ -0,0 +1,388 @@
+#include "Reflex_Timeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+// Markers that make a frame complete, in the order they are expected to arrive
+static constexpr ReflexMarker OrderedMarkers[] = { ReflexMarker::SimulationStart,   ReflexMarker::SimulationEnd,
+                                                   ReflexMarker::RenderSubmitStart, ReflexMarker::RenderSubmitEnd,
+                                                   ReflexMarker::PresentStart,      ReflexMarker::PresentEnd };
+
+static int OrderIndex(ReflexMarker marker)
+{
+    for (int i = 0; i < (int) std::size(OrderedMarkers); i++)
+    {
+        if (OrderedMarkers[i] == marker)
+            return i;
+    }
+
+    return -1;
+}
+
+ReflexTimeline& ReflexTimeline::Instance()
+{
+    static ReflexTimeline instance;
+    return instance;
+}
+
+uint64_t ReflexTimeline::NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+const char* ReflexTimeline::StageName(ReflexStage stage)
+{
+    switch (stage)
+    {
+    case ReflexStage::Simulation:
+        return "Simulation";
+    case ReflexStage::RenderSubmit:
+        return "RenderSubmit";
+    case ReflexStage::Present:
+        return "Present";
+    case ReflexStage::Driver:
+        return "Driver";
+    case ReflexStage::OsRenderQueue:
+        return "RenderQueue";
+    case ReflexStage::GpuRender:
+        return "GpuRender";
+    case ReflexStage::PcLatency:
+        return "PC Latency";
+    case ReflexStage::FGHoldback:
+        return "FG Holdback";
+    default:
+        return "Unknown";
+    }
+}
+
+void ReflexTimeline::Retire(ReflexFrameRecord& record)
+{
+    if (!record.used)
+        return;
+
+    uint32_t received = 0;
+
+    for (auto marker : OrderedMarkers)
+    {
+        if (record.markers[(size_t) marker] != 0)
+            received++;
+    }
+
+    // Frames that only came from GetLatency reports never had markers to drop
+    if (received > 0 && received < std::size(OrderedMarkers))
+    {
+        record.flags |= ReflexFrame_MissingMarker;
+        _droppedMarkers += std::size(OrderedMarkers) - received;
+    }
+}
+
+ReflexFrameRecord* ReflexTimeline::GetRecord(uint64_t frameId)
+{
+    auto& record = _frames[frameId % RingSize];
+
+    if (record.used && record.frameId == frameId)
+        return &record;
+
+    // Slot is owned by a newer frame or the id is too old to still have a slot
+    if ((record.used && record.frameId > frameId) || frameId + RingSize <= _highestFrameId)
+    {
+        _lateFrameIds++;
+        return nullptr;
+    }
+
+    Retire(record);
+
+    record = {};
+    record.frameId = frameId;
+    record.used = true;
+
+    if (frameId < _highestFrameId)
+    {
+        record.flags |= ReflexFrame_LateFrameId;
+        _lateFrameIds++;
+    }
+    else
+    {
+        _highestFrameId = frameId;
+    }
+
+    return &record;
+}
+
+void ReflexTimeline::RecordMarker(uint64_t frameId, ReflexMarker marker, uint64_t timestampNs)
+{
+    if (marker >= ReflexMarker::COUNT)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto record = GetRecord(frameId);
+
+    if (record == nullptr)
+        return;
+
+    if (marker == ReflexMarker::OutOfBandPresentStart)
+    {
+        if (record->outOfBandPresents == 0)
+            record->firstOutOfBandPresent = timestampNs;
+
+        record->lastOutOfBandPresent = timestampNs;
+        record->outOfBandPresents++;
+    }
+
+    auto& slot = record->markers[(size_t) marker];
+
+    // Out of band markers repeat for every generated frame, only the first one is kept
+    if (slot != 0)
+    {
+        if (marker < ReflexMarker::OutOfBandRenderSubmitStart)
+        {
+            record->flags |= ReflexFrame_DuplicateMarker;
+            _duplicateMarkers++;
+        }
+
+        return;
+    }
+
+    slot = timestampNs;
+
+    auto order = OrderIndex(marker);
+
+    if (order < 0)
+        return;
+
+    for (int i = 0; i < (int) std::size(OrderedMarkers); i++)
+    {
+        auto other = record->markers[(size_t) OrderedMarkers[i]];
+
+        if (other == 0 || i == order)
+            continue;
+
+        if ((i > order) || (other > timestampNs))
+        {
+            record->flags |= ReflexFrame_OutOfOrder;
+            _outOfOrderMarkers++;
+            break;
+        }
+    }
+}
+
+void ReflexTimeline::RecordReport(const ReflexLatencyReport& report)
+{
+    if (report.frameId == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto& record = _frames[report.frameId % RingSize];
+
+    // Reports are for frames which are already done, don't let them evict newer frames
+    if (record.used && record.frameId != report.frameId)
+    {
+        if (record.frameId > report.frameId)
+            return;
+
+        Retire(record);
+        record = {};
+    }
+
+    record.frameId = report.frameId;
+    record.used = true;
+    record.hasReport = true;
+    record.report = report;
+
+    if (report.frameId > _highestFrameId)
+        _highestFrameId = report.frameId;
+}
+
+void ReflexTimeline::Reset()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _frames = {};
+    _highestFrameId = 0;
+    _droppedMarkers = 0;
+    _outOfOrderMarkers = 0;
+    _duplicateMarkers = 0;
+    _lateFrameIds = 0;
+}
+
+std::vector<ReflexFrameRecord> ReflexTimeline::Snapshot() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::vector<ReflexFrameRecord> result;
+    result.reserve(RingSize);
+
+    for (const auto& record : _frames)
+    {
+        if (record.used)
+            result.push_back(record);
+    }
+
+    std::sort(result.begin(), result.end(),
+              [](const ReflexFrameRecord& a, const ReflexFrameRecord& b) { return a.frameId < b.frameId; });
+
+    return result;
+}
+
+static void FillStats(std::vector<double>& values, ReflexStageStats& stats)
+{
+    if (values.empty())
+        return;
+
+    std::sort(values.begin(), values.end());
+
+    const auto percentile = [&values](double p)
+    {
+        auto index = static_cast<size_t>(p * (values.size() - 1) + 0.5);
+        return values[std::min(index, values.size() - 1)];
+    };
+
+    double sum = 0.0;
+    for (auto value : values)
+        sum += value;
+
+    stats.count = static_cast<uint32_t>(values.size());
+    stats.min = values.front();
+    stats.max = values.back();
+    stats.avg = sum / values.size();
+    stats.p50 = percentile(0.50);
+    stats.p95 = percentile(0.95);
+    stats.p99 = percentile(0.99);
+}
+
+ReflexTimelineStats ReflexTimeline::Analyze() const
+{
+    auto frames = Snapshot();
+
+    ReflexTimelineStats stats {};
+    std::array<std::vector<double>, (size_t) ReflexStage::COUNT> values {};
+
+    const auto markerSpan = [](const ReflexFrameRecord& record, ReflexMarker start, ReflexMarker end,
+                               double* result)
+    {
+        auto startTime = record.markers[(size_t) start];
+        auto endTime = record.markers[(size_t) end];
+
+        if (startTime == 0 || endTime < startTime)
+            return false;
+
+        *result = (endTime - startTime) / 1000000.0;
+        return true;
+    };
+
+    const auto reportSpan = [this](uint64_t start, uint64_t end, double* result)
+    {
+        if (start == 0 || end < start)
+            return false;
+
+        *result = (end - start) / _reportUnitsPerMs;
+        return true;
+    };
+
+    for (const auto& record : frames)
+    {
+        double duration = 0.0;
+        auto& report = record.report;
+        bool hasReport = record.hasReport;
+
+        stats.frames++;
+
+        // Markers are measured on our side, reports fill the gaps when a game doesn't send them
+        if (markerSpan(record, ReflexMarker::SimulationStart, ReflexMarker::SimulationEnd, &duration) ||
+            (hasReport && reportSpan(report.simStartTime, report.simEndTime, &duration)))
+            values[(size_t) ReflexStage::Simulation].push_back(duration);
+
+        if (markerSpan(record, ReflexMarker::RenderSubmitStart, ReflexMarker::RenderSubmitEnd, &duration) ||
+            (hasReport && reportSpan(report.renderSubmitStartTime, report.renderSubmitEndTime, &duration)))
+            values[(size_t) ReflexStage::RenderSubmit].push_back(duration);
+
+        if (markerSpan(record, ReflexMarker::PresentStart, ReflexMarker::PresentEnd, &duration) ||
+            (hasReport && reportSpan(report.presentStartTime, report.presentEndTime, &duration)))
+            values[(size_t) ReflexStage::Present].push_back(duration);
+
+        if (hasReport)
+        {
+            if (reportSpan(report.driverStartTime, report.driverEndTime, &duration))
+                values[(size_t) ReflexStage::Driver].push_back(duration);
+
+            if (reportSpan(report.osRenderQueueStartTime, report.osRenderQueueEndTime, &duration))
+                values[(size_t) ReflexStage::OsRenderQueue].push_back(duration);
+
+            if (reportSpan(report.gpuRenderStartTime, report.gpuRenderEndTime, &duration))
+                values[(size_t) ReflexStage::GpuRender].push_back(duration);
+
+            auto latencyStart = report.inputSampleTime != 0 ? report.inputSampleTime : report.simStartTime;
+            if (reportSpan(latencyStart, report.gpuRenderEndTime, &duration))
+                values[(size_t) ReflexStage::PcLatency].push_back(duration);
+        }
+
+        if (record.outOfBandPresents > 1)
+        {
+            stats.fgFrames++;
+            values[(size_t) ReflexStage::FGHoldback].push_back(
+                (record.lastOutOfBandPresent - record.firstOutOfBandPresent) / 1000000.0);
+        }
+    }
+
+    for (size_t i = 0; i < values.size(); i++)
+        FillStats(values[i], stats.stages[i]);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    stats.droppedMarkers = _droppedMarkers;
+    stats.outOfOrderMarkers = _outOfOrderMarkers;
+    stats.duplicateMarkers = _duplicateMarkers;
+    stats.lateFrameIds = _lateFrameIds;
+
+    return stats;
+}
+
+bool ReflexTimeline::ExportCsv(const std::filesystem::path& path) const
+{
+    auto frames = Snapshot();
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        LOG_ERROR("Can't open {} for writing", path.string());
+        return false;
+    }
+
+    file << "frameId,flags,simStart,simEnd,renderSubmitStart,renderSubmitEnd,presentStart,presentEnd,"
+            "outOfBandPresents,firstOutOfBandPresent,lastOutOfBandPresent,"
+            "reportInputSample,reportSimStart,reportSimEnd,reportRenderSubmitStart,reportRenderSubmitEnd,"
+            "reportPresentStart,reportPresentEnd,reportDriverStart,reportDriverEnd,reportOsRenderQueueStart,"
+            "reportOsRenderQueueEnd,reportGpuRenderStart,reportGpuRenderEnd\n";
+
+    for (const auto& record : frames)
+    {
+        const auto& m = record.markers;
+        const auto& r = record.report;
+
+        file << record.frameId << ',' << record.flags;
+
+        for (auto marker : OrderedMarkers)
+            file << ',' << m[(size_t) marker];
+
+        file << ',' << record.outOfBandPresents << ',' << record.firstOutOfBandPresent << ','
+             << record.lastOutOfBandPresent;
+
+        for (auto value : { r.inputSampleTime, r.simStartTime, r.simEndTime, r.renderSubmitStartTime,
+                            r.renderSubmitEndTime, r.presentStartTime, r.presentEndTime, r.driverStartTime,
+                            r.driverEndTime, r.osRenderQueueStartTime, r.osRenderQueueEndTime,
+                            r.gpuRenderStartTime, r.gpuRenderEndTime })
+            file << ',' << value;
+
+        file << '\n';
+    }
+
+    LOG_INFO("Exported {} frames to {}", frames.size(), path.string());
+
+    return true;
+}
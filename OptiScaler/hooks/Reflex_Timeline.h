@@ -0,0 +1,155 @@
+#pragma once
+#include <pch.h>
+
+#include <array>
+#include <mutex>
+#include <vector>
+#include <filesystem>
+
+// Same values as NV_LATENCY_MARKER_TYPE, kept separate so the timeline can be fed without nvapi
+enum class ReflexMarker : uint32_t
+{
+    SimulationStart = 0,
+    SimulationEnd = 1,
+    RenderSubmitStart = 2,
+    RenderSubmitEnd = 3,
+    PresentStart = 4,
+    PresentEnd = 5,
+    InputSample = 6,
+    TriggerFlash = 7,
+    PcLatencyPing = 8,
+    OutOfBandRenderSubmitStart = 9,
+    OutOfBandRenderSubmitEnd = 10,
+    OutOfBandPresentStart = 11,
+    OutOfBandPresentEnd = 12,
+
+    COUNT
+};
+
+enum class ReflexStage : uint32_t
+{
+    Simulation,
+    RenderSubmit,
+    Present,
+    Driver,
+    OsRenderQueue,
+    GpuRender,
+    PcLatency,  // simulation start (or input sample) -> gpu render end
+    FGHoldback, // first -> last out of band present of a frame, time the real frame waits behind generated ones
+
+    COUNT
+};
+
+// Subset of NV_LATENCY_RESULT_PARAMS::FrameReport, all values in driver time units
+struct ReflexLatencyReport
+{
+    uint64_t frameId = 0;
+    uint64_t inputSampleTime = 0;
+    uint64_t simStartTime = 0;
+    uint64_t simEndTime = 0;
+    uint64_t renderSubmitStartTime = 0;
+    uint64_t renderSubmitEndTime = 0;
+    uint64_t presentStartTime = 0;
+    uint64_t presentEndTime = 0;
+    uint64_t driverStartTime = 0;
+    uint64_t driverEndTime = 0;
+    uint64_t osRenderQueueStartTime = 0;
+    uint64_t osRenderQueueEndTime = 0;
+    uint64_t gpuRenderStartTime = 0;
+    uint64_t gpuRenderEndTime = 0;
+};
+
+enum ReflexFrameFlags : uint32_t
+{
+    ReflexFrame_None = 0,
+    // Marker arrived after a later stage of the same frame was already recorded
+    ReflexFrame_OutOfOrder = 1 << 0,
+    // Same marker sent twice for the frame
+    ReflexFrame_DuplicateMarker = 1 << 1,
+    // Frame left the ring without a complete sim/submit/present set
+    ReflexFrame_MissingMarker = 1 << 2,
+    // Frame id arrived after a newer one was already seen
+    ReflexFrame_LateFrameId = 1 << 3,
+};
+
+struct ReflexFrameRecord
+{
+    uint64_t frameId = 0;
+    bool used = false;
+
+    // Timestamps from SetLatencyMarker / SetAsyncFrameMarker in ns, 0 means not received
+    std::array<uint64_t, (size_t) ReflexMarker::COUNT> markers {};
+
+    uint32_t outOfBandPresents = 0;
+    uint64_t firstOutOfBandPresent = 0;
+    uint64_t lastOutOfBandPresent = 0;
+
+    bool hasReport = false;
+    ReflexLatencyReport report {};
+
+    uint32_t flags = ReflexFrame_None;
+};
+
+struct ReflexStageStats
+{
+    uint32_t count = 0;
+    double min = 0.0;
+    double avg = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+struct ReflexTimelineStats
+{
+    // In milliseconds
+    std::array<ReflexStageStats, (size_t) ReflexStage::COUNT> stages {};
+
+    uint32_t frames = 0;
+    uint32_t fgFrames = 0; // Frames with more than one out of band present
+    uint64_t droppedMarkers = 0;
+    uint64_t outOfOrderMarkers = 0;
+    uint64_t duplicateMarkers = 0;
+    uint64_t lateFrameIds = 0;
+};
+
+// Per frame store of Reflex markers and GetLatency reports
+// All inputs carry their own timestamps so streams can be replayed deterministically
+class ReflexTimeline
+{
+  public:
+    static constexpr size_t RingSize = 256;
+
+  private:
+    std::array<ReflexFrameRecord, RingSize> _frames {};
+    uint64_t _highestFrameId = 0;
+
+    uint64_t _droppedMarkers = 0;
+    uint64_t _outOfOrderMarkers = 0;
+    uint64_t _duplicateMarkers = 0;
+    uint64_t _lateFrameIds = 0;
+
+    // Driver report units per millisecond, GetLatency reports microseconds
+    double _reportUnitsPerMs = 1000.0;
+
+    mutable std::mutex _mutex;
+
+    ReflexFrameRecord* GetRecord(uint64_t frameId);
+    void Retire(ReflexFrameRecord& record);
+
+  public:
+    static ReflexTimeline& Instance();
+
+    void RecordMarker(uint64_t frameId, ReflexMarker marker, uint64_t timestampNs);
+    void RecordReport(const ReflexLatencyReport& report);
+    void SetReportUnitsPerMs(double unitsPerMs) { _reportUnitsPerMs = unitsPerMs; }
+    void Reset();
+
+    ReflexTimelineStats Analyze() const;
+    std::vector<ReflexFrameRecord> Snapshot() const;
+    bool ExportCsv(const std::filesystem::path& path) const;
+
+    static const char* StageName(ReflexStage stage);
+    static uint64_t NowNs();
+};
@@ -8,10 +8,14 @@
 #include <proxies/KernelBase_Proxy.h>
 #include <menu/menu_overlay_base.h>
 #include <hooks/Reflex_Hooks.h>
+#include <hooks/Vulkan_Hooks.h>
 #include <magic_enum.hpp>
 #include <sl1_reflex.h>
 #include <nvapi/fakenvapi.h>
 
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::Loader
+
 sl::RenderAPI StreamlineHooks::renderApi = sl::RenderAPI::eCount;
 std::mutex StreamlineHooks::setConstantsMutex {};
 SystemCaps* StreamlineHooks::systemCaps = nullptr;
@@ -126,7 +130,10 @@ sl::Result StreamlineHooks::hkslInit(sl::Preferences* pref, uint64_t sdkVersion)
 
     // Treat engine type set in Streamline as ground truth
     if (pref->engine == sl::EngineType::eUnreal)
+    {
         State::Instance().gameQuirks |= GameQuirk::ForceUnrealEngine;
+        VulkanHooks::UpdateBarrierRules();
+    }
 
     // bool hookSetTag =
     //     (State::Instance().activeFgInput == FGInput::Nukems || State::Instance().activeFgInput == FGInput::DLSSG);
@@ -0,0 +1,178 @@
+#include "Vulkan_BarrierRules.h"
+
+// AMD drivers on the cards around RDNA2 didn't treat VK_IMAGE_LAYOUT_UNDEFINED in the same way Nvidia does.
+// Doesn't seem like a bug, just a different way of handling an UB but we need to adjust.
+static const VkBarrierRule DefaultVkBarrierRules[] = {
+    {
+        .name = "DLSSG Present",
+        .quirk = GameQuirk::VulkanDLSSBarrierFixup,
+        .gpu = VkBarrierRuleGpu::NonNvidiaOrPascal,
+        .imageBarrierCount = 2,
+        .match = { { { .oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                       .newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL },
+                     { .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED, .newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL } } },
+        .action = VkBarrierRuleAction::Rewrite,
+        .rewrite = { { {}, { .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL } } },
+    },
+    {
+        // Those are already in the correct layouts
+        // In the Voyagers update, the 2nd oldLayout has changed so it's not matched
+        .name = "DLSS",
+        .quirk = GameQuirk::VulkanDLSSBarrierFixup,
+        .gpu = VkBarrierRuleGpu::NonNvidiaOrPascal,
+        .imageBarrierCount = 4,
+        .match = { { { .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED },
+                     {},
+                     { .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED },
+                     { .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED } } },
+        .action = VkBarrierRuleAction::Drop,
+    },
+};
+
+bool VkImageBarrierPattern::Matches(const VkImageMemoryBarrier& barrier) const
+{
+    return (oldLayout == AnyLayout || oldLayout == barrier.oldLayout) &&
+           (newLayout == AnyLayout || newLayout == barrier.newLayout) &&
+           (srcAccessMask == AnyAccess || srcAccessMask == barrier.srcAccessMask) &&
+           (dstAccessMask == AnyAccess || dstAccessMask == barrier.dstAccessMask);
+}
+
+void VkImageBarrierPattern::Apply(VkImageMemoryBarrier& barrier) const
+{
+    if (oldLayout != AnyLayout)
+        barrier.oldLayout = oldLayout;
+
+    if (newLayout != AnyLayout)
+        barrier.newLayout = newLayout;
+
+    if (srcAccessMask != AnyAccess)
+        barrier.srcAccessMask = srcAccessMask;
+
+    if (dstAccessMask != AnyAccess)
+        barrier.dstAccessMask = dstAccessMask;
+}
+
+std::span<const VkBarrierRule> VkBarrierMatcher::DefaultRules() { return DefaultVkBarrierRules; }
+
+void VkBarrierMatcher::ApplyRewrite(const VkBarrierRule& rule, const VkImageMemoryBarrier* barriers,
+                                    VkImageMemoryBarrier* result)
+{
+    for (uint32_t i = 0; i < rule.imageBarrierCount; i++)
+    {
+        result[i] = barriers[i];
+        rule.rewrite[i].Apply(result[i]);
+    }
+}
+
+VkBarrierMatcher::VkBarrierMatcher(std::span<const VkBarrierRule> rules) : _rules(rules)
+{
+    _hits = std::make_unique<std::atomic<uint64_t>[]>(_rules.size());
+}
+
+void VkBarrierMatcher::CompileLocked(const flag_set<GameQuirk>& quirks, bool isRunningOnNvidia,
+                                     bool isPascalOrOlder)
+{
+    _compiled = true;
+    _compiledQuirks = quirks;
+    _compiledNvidia = isRunningOnNvidia;
+    _compiledPascal = isPascalOrOlder;
+
+    auto active = std::make_unique<ActiveRules>();
+
+    for (uint32_t i = 0; i < _rules.size(); i++)
+    {
+        const auto& rule = _rules[i];
+
+        if (rule.imageBarrierCount == 0 || rule.imageBarrierCount > VkBarrierRule::MaxBarriers)
+        {
+            LOG_ERROR("Rule {} has invalid barrier count: {}", rule.name, rule.imageBarrierCount);
+            continue;
+        }
+
+        if (rule.quirk != GameQuirk::_ && !(quirks & rule.quirk))
+            continue;
+
+        if (rule.gpu == VkBarrierRuleGpu::NonNvidiaOrPascal && isRunningOnNvidia && !isPascalOrOlder)
+            continue;
+
+        if (active->count == MaxActiveRules)
+        {
+            LOG_ERROR("Too many active barrier rules, skipping {}", rule.name);
+            break;
+        }
+
+        active->indexes[active->count++] = i;
+        active->countMask |= 1ull << rule.imageBarrierCount;
+    }
+
+    LOG_DEBUG("{} of {} barrier rules active", active->count, _rules.size());
+
+    _active.store(active.get(), std::memory_order_release);
+    _compiledSets.push_back(std::move(active));
+}
+
+void VkBarrierMatcher::Compile(const flag_set<GameQuirk>& quirks, bool isRunningOnNvidia, bool isPascalOrOlder)
+{
+    std::scoped_lock lock(_compileMutex);
+    CompileLocked(quirks, isRunningOnNvidia, isPascalOrOlder);
+}
+
+void VkBarrierMatcher::Update(const flag_set<GameQuirk>& quirks, bool isRunningOnNvidia, bool isPascalOrOlder)
+{
+    std::scoped_lock lock(_compileMutex);
+
+    if (_compiled && _compiledNvidia == isRunningOnNvidia && _compiledPascal == isPascalOrOlder &&
+        _compiledQuirks == quirks)
+    {
+        return;
+    }
+
+    CompileLocked(quirks, isRunningOnNvidia, isPascalOrOlder);
+}
+
+int VkBarrierMatcher::Match(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask,
+                            uint32_t imageBarrierCount, const VkImageMemoryBarrier* pImageMemoryBarriers)
+{
+    if (imageBarrierCount >= 64 || pImageMemoryBarriers == nullptr)
+        return -1;
+
+    // Same set for the mask check and the rules
+    auto active = _active.load(std::memory_order_acquire);
+
+    if ((active->countMask & (1ull << imageBarrierCount)) == 0)
+        return -1;
+
+    for (uint32_t a = 0; a < active->count; a++)
+    {
+        auto index = active->indexes[a];
+        const auto& rule = _rules[index];
+
+        if (rule.imageBarrierCount != imageBarrierCount)
+            continue;
+
+        if ((rule.srcStageMask != VkBarrierRule::AnyStage && rule.srcStageMask != srcStageMask) ||
+            (rule.dstStageMask != VkBarrierRule::AnyStage && rule.dstStageMask != dstStageMask))
+        {
+            continue;
+        }
+
+        bool matched = true;
+
+        for (uint32_t i = 0; i < imageBarrierCount; i++)
+        {
+            if (!rule.match[i].Matches(pImageMemoryBarriers[i]))
+            {
+                matched = false;
+                break;
+            }
+        }
+
+        if (!matched)
+            continue;
+
+        _hits[index].fetch_add(1, std::memory_order_relaxed);
+        return (int) index;
+    }
+
+    return -1;
+}
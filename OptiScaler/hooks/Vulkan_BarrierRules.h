@@ -0,0 +1,127 @@
+#pragma once
+
+#include <pch.h>
+
+#include <misc/Quirks.h>
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+enum class VkBarrierRuleAction
+{
+    PassThrough,
+    Drop,
+    Rewrite,
+};
+
+enum class VkBarrierRuleGpu
+{
+    Any,
+    NonNvidiaOrPascal,
+};
+
+// Fields left at Any match everything, when used for a rewrite they keep the original value
+struct VkImageBarrierPattern
+{
+    static constexpr VkImageLayout AnyLayout = VK_IMAGE_LAYOUT_MAX_ENUM;
+    static constexpr VkAccessFlags AnyAccess = VK_ACCESS_FLAG_BITS_MAX_ENUM;
+
+    VkImageLayout oldLayout = AnyLayout;
+    VkImageLayout newLayout = AnyLayout;
+    VkAccessFlags srcAccessMask = AnyAccess;
+    VkAccessFlags dstAccessMask = AnyAccess;
+
+    bool Matches(const VkImageMemoryBarrier& barrier) const;
+    void Apply(VkImageMemoryBarrier& barrier) const;
+};
+
+struct VkBarrierRule
+{
+    static constexpr uint32_t MaxBarriers = 8;
+    static constexpr VkPipelineStageFlags AnyStage = VK_PIPELINE_STAGE_FLAG_BITS_MAX_ENUM;
+
+    const char* name = nullptr;
+
+    // Rule is only active when the game has this quirk, _ means always
+    GameQuirk quirk = GameQuirk::_;
+    VkBarrierRuleGpu gpu = VkBarrierRuleGpu::Any;
+
+    uint32_t imageBarrierCount = 0;
+    VkPipelineStageFlags srcStageMask = AnyStage;
+    VkPipelineStageFlags dstStageMask = AnyStage;
+    std::array<VkImageBarrierPattern, MaxBarriers> match {};
+
+    VkBarrierRuleAction action = VkBarrierRuleAction::PassThrough;
+    std::array<VkImageBarrierPattern, MaxBarriers> rewrite {};
+};
+
+// Matches vkCmdPipelineBarrier image barriers against a rule table.
+// Compile() keeps the rules active for the current quirks/GPU and builds a mask
+// of their barrier counts, so most calls are rejected with a single bit test.
+// Compiled sets are published with one pointer swap, recording threads never see a half built set.
+class VkBarrierMatcher
+{
+  public:
+    static constexpr uint32_t MaxActiveRules = 32;
+
+  private:
+    struct ActiveRules
+    {
+        std::array<uint32_t, MaxActiveRules> indexes {};
+        uint32_t count = 0;
+        uint64_t countMask = 0;
+    };
+
+    std::span<const VkBarrierRule> _rules;
+    std::unique_ptr<std::atomic<uint64_t>[]> _hits;
+
+    ActiveRules _empty {};
+    std::atomic<const ActiveRules*> _active = &_empty;
+
+    // Replaced sets are kept, a recording thread can still be matching against them.
+    // Only changes with the quirks or GPU so there are a few at most
+    std::vector<std::unique_ptr<ActiveRules>> _compiledSets;
+
+    std::mutex _compileMutex;
+    bool _compiled = false;
+    flag_set<GameQuirk> _compiledQuirks {};
+    bool _compiledNvidia = false;
+    bool _compiledPascal = false;
+
+    void CompileLocked(const flag_set<GameQuirk>& quirks, bool isRunningOnNvidia, bool isPascalOrOlder);
+
+  public:
+    static std::span<const VkBarrierRule> DefaultRules();
+
+    static void ApplyRewrite(const VkBarrierRule& rule, const VkImageMemoryBarrier* barriers,
+                             VkImageMemoryBarrier* result);
+
+    explicit VkBarrierMatcher(std::span<const VkBarrierRule> rules);
+
+    void Compile(const flag_set<GameQuirk>& quirks, bool isRunningOnNvidia, bool isPascalOrOlder);
+
+    // Recompiles only when the inputs differ from the last compile.
+    // Called where the quirks or GPU info change, not on the barrier path
+    void Update(const flag_set<GameQuirk>& quirks, bool isRunningOnNvidia, bool isPascalOrOlder);
+
+    bool MightMatch(uint32_t imageBarrierCount) const
+    {
+        return imageBarrierCount < 64 &&
+               (_active.load(std::memory_order_acquire)->countMask & (1ull << imageBarrierCount)) != 0;
+    }
+
+    // Index of the first matching rule, -1 if none
+    int Match(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, uint32_t imageBarrierCount,
+              const VkImageMemoryBarrier* pImageMemoryBarriers);
+
+    const VkBarrierRule& Rule(size_t index) const { return _rules[index]; }
+    size_t RuleCount() const { return _rules.size(); }
+    uint64_t HitCount(size_t index) const { return _hits[index].load(std::memory_order_relaxed); }
+    uint32_t ActiveRuleCount() const { return _active.load(std::memory_order_acquire)->count; }
+};
@@ -2,13 +2,17 @@
 
 #include <Util.h>
 #include <Config.h>
+#include <ConfigReload.h>
 
 #include <menu/menu_overlay_vk.h>
 #include <proxies/KernelBase_Proxy.h>
 #include <upscaler_time/UpscalerTime_Vk.h>
+#include <upscalers/FeatureProvider_Vk.h>
 
 #include <misc/FrameLimit.h>
+#include <misc/DynamicResolution.h>
 #include "Reflex_Hooks.h"
+#include "Vulkan_BarrierRules.h"
 
 #include <vulkan/vulkan.hpp>
 
@@ -22,6 +26,9 @@ static HWND _hwnd = nullptr;
 
 static std::mutex _vkPresentMutex;
 
+// Game specific vkCmdPipelineBarrier fixups
+static VkBarrierMatcher _barrierMatcher(VkBarrierMatcher::DefaultRules());
+
 // hooking
 typedef VkResult (*PFN_QueuePresentKHR)(VkQueue, const VkPresentInfoKHR*);
 typedef VkResult (*PFN_CreateSwapchainKHR)(VkDevice, const VkSwapchainCreateInfoKHR*, const VkAllocationCallbacks*,
@@ -74,47 +81,33 @@ static void hkvkCmdPipelineBarrier(VkCommandBuffer commandBuffer, VkPipelineStag
                                    const VkBufferMemoryBarrier* pBufferMemoryBarriers, uint32_t imageMemoryBarrierCount,
                                    const VkImageMemoryBarrier* pImageMemoryBarriers)
 {
-    if (State::Instance().gameQuirks & GameQuirk::VulkanDLSSBarrierFixup &&
-        (!State::Instance().isRunningOnNvidia || State::Instance().isPascalOrOlder))
+    if (_barrierMatcher.MightMatch(imageMemoryBarrierCount))
     {
-        // AMD drivers on the cards around RDNA2 didn't treat VK_IMAGE_LAYOUT_UNDEFINED in the same way Nvidia does.
-        // Doesn't seem like a bug, just a different way of handling an UB but we need to adjust.
+        auto ruleIndex =
+            _barrierMatcher.Match(srcStageMask, dstStageMask, imageMemoryBarrierCount, pImageMemoryBarriers);
 
-        // DLSSG Present
-        if (imageMemoryBarrierCount == 2)
+        if (ruleIndex >= 0)
         {
-            if (pImageMemoryBarriers[0].oldLayout == VK_IMAGE_LAYOUT_PRESENT_SRC_KHR &&
-                pImageMemoryBarriers[0].newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL &&
-                pImageMemoryBarriers[1].oldLayout == VK_IMAGE_LAYOUT_UNDEFINED &&
-                pImageMemoryBarriers[1].newLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL)
+            const auto& rule = _barrierMatcher.Rule(ruleIndex);
+
+            if (rule.action == VkBarrierRuleAction::Drop)
             {
-                LOG_TRACE("Changing an UNDEFINED barrier in DLSSG Present");
+                LOG_TRACE("Removing barriers, rule: {}", rule.name);
+                return;
+            }
 
-                VkImageMemoryBarrier newImageBarriers[2];
-                std::memcpy(newImageBarriers, pImageMemoryBarriers, sizeof(newImageBarriers));
+            if (rule.action == VkBarrierRuleAction::Rewrite)
+            {
+                LOG_TRACE("Changing barriers, rule: {}", rule.name);
 
-                newImageBarriers[1].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                VkImageMemoryBarrier newImageBarriers[VkBarrierRule::MaxBarriers];
+                VkBarrierMatcher::ApplyRewrite(rule, pImageMemoryBarriers, newImageBarriers);
 
                 return o_vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, dependencyFlags,
                                               memoryBarrierCount, pMemoryBarriers, bufferMemoryBarrierCount,
                                               pBufferMemoryBarriers, imageMemoryBarrierCount, newImageBarriers);
             }
         }
-
-        // DLSS
-        // Those are already in the correct layouts
-        if (imageMemoryBarrierCount == 4)
-        {
-            // In the Voyagers update, the 2nd oldLayout has changed
-            if (pImageMemoryBarriers[0].oldLayout == VK_IMAGE_LAYOUT_UNDEFINED &&
-                // pImageMemoryBarriers[1].oldLayout == VK_IMAGE_LAYOUT_UNDEFINED &&
-                pImageMemoryBarriers[2].oldLayout == VK_IMAGE_LAYOUT_UNDEFINED &&
-                pImageMemoryBarriers[3].oldLayout == VK_IMAGE_LAYOUT_UNDEFINED)
-            {
-                LOG_TRACE("Removing an UNDEFINED barrier in DLSS");
-                return;
-            }
-        }
     }
 
     return o_vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, dependencyFlags, memoryBarrierCount,
@@ -182,6 +175,8 @@ static VkResult hkvkCreateDevice(VkPhysicalDevice physicalDevice, const VkDevice
 
     if (o_vkCmdPipelineBarrier == nullptr)
     {
+        VulkanHooks::UpdateBarrierRules();
+
         o_vkCmdPipelineBarrier = (PFN_vkCmdPipelineBarrier) vkGetDeviceProcAddr(*pDevice, "vkCmdPipelineBarrier");
 
         DetourTransactionBegin();
@@ -226,6 +221,15 @@ static VkResult hkvkQueuePresentKHR(VkQueue queue, VkPresentInfoKHR* pPresentInf
     // get upscaler time
     UpscalerTimeVk::ReadUpscalingTime(_device);
 
+    // Apply the ini changes made while running
+    ConfigReload::OnPresent();
+
+    // Frame time of the finished frame drives the dynamic resolution ratio
+    DynamicResolution::OnPresent();
+
+    // Release upscalers retired by a backend change
+    FeatureProvider_Vk::OnPresent();
+
     if (!State::Instance().isRunningOnDXVK)
         State::Instance().swapchainApi = Vulkan;
 
@@ -315,6 +319,12 @@ void VulkanHooks::Hook(HMODULE vulkan1)
     }
 }
 
+void VulkanHooks::UpdateBarrierRules()
+{
+    auto& state = State::Instance();
+    _barrierMatcher.Update(state.gameQuirks, state.isRunningOnNvidia, state.isPascalOrOlder);
+}
+
 void VulkanHooks::Unhook()
 {
     DetourTransactionBegin();
@@ -7,4 +7,7 @@ class VulkanHooks
   public:
     static void Hook(HMODULE vulkan1);
     static void Unhook();
+
+    // Recompiles the vkCmdPipelineBarrier fixups, call after changing the quirks or GPU info
+    static void UpdateBarrierRules();
 };
@@ -5,6 +5,11 @@
 #include <Config.h>
 
 #include <framegen/IFGFeature_Dx12.h>
+#include <resource_tracking/ResourceLifetime_Dx12.h>
+#include <misc/StateShadow_Dx12.h>
+
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::Hudfix
 
 bool Hudfix_Dx12::CreateObjects()
 {
@@ -416,6 +421,17 @@ void Hudfix_Dx12::UpscaleStart()
         State::Instance().ClearCapturedHudlesses = false;
         State::Instance().CapturedHudlesses.clear();
     }
+
+    // Captured hudless list is only touched from here, drop the destroyed ones once per frame.
+    // An entry of another id was made for a new resource at the same address after a clear.
+    ResourceLifetime_Dx12::DrainDestroyed(
+        [](ID3D12Resource* resource, uint64_t watchId)
+        {
+            auto& captured = State::Instance().CapturedHudlesses;
+
+            if (auto it = captured.find(resource); it != captured.end() && it->second.watchId == watchId)
+                captured.erase(it);
+        });
 }
 
 void Hudfix_Dx12::UpscaleEnd(UINT64 frameId, double lastFGFrameTime)
@@ -509,7 +525,14 @@ bool Hudfix_Dx12::CheckForHudless(ID3D12GraphicsCommandList* cmdList, ResourceIn
         if (!CheckResource(resource))
             break;
 
-        CapturedHudlessInfo* capturedHudlessInfo = &s.CapturedHudlesses[resource->buffer];
+        auto [capturedIt, inserted] = s.CapturedHudlesses.try_emplace(resource->buffer);
+
+        // Entry is dropped at UpscaleStart after the resource is destroyed. A new resource at the
+        // address of a destroyed one uses the old entry until then and gets its own on the next check.
+        if (inserted || capturedIt->second.watchId == 0)
+            capturedIt->second.watchId = ResourceLifetime_Dx12::Watch(resource->buffer, true);
+
+        CapturedHudlessInfo* capturedHudlessInfo = &capturedIt->second;
         if (capturedHudlessInfo != nullptr && !capturedHudlessInfo->enabled)
         {
             LOG_DEBUG("Skipping {:X}, disabled from captured hudless list!", (size_t) resource->buffer);
@@ -630,6 +653,9 @@ bool Hudfix_Dx12::CheckForHudless(ID3D12GraphicsCommandList* cmdList, ResourceIn
         auto scWidth = s.currentSwapchainDesc.BufferDesc.Width;
         auto scHeight = s.currentSwapchainDesc.BufferDesc.Height;
 
+        // Capture and the FG inputs set from it are recorded on the game's list
+        StateShadowScope_Dx12 stateScope(cmdList, StateShadow_Dx12::RestoreMask());
+
         // Make a copy of resource to capture current state
         if (!resource->extended)
         {
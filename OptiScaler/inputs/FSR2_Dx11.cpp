@@ -12,6 +12,7 @@
 
 #include "fsr2/ffx_fsr2.h"
 #include "fsr2/dx11/ffx_fsr2_dx11.h"
+#include <misc/DynamicResolution.h>
 
 typedef FfxErrorCode (*PFN_ffxFsr2ContextCreate)(FfxFsr2Context* context,
                                                  const FfxFsr2ContextDescription* contextDescription);
@@ -113,6 +114,10 @@ static std::optional<float> GetQualityOverrideRatioFfx(const FfxFsr2QualityMode
 
     std::optional<float> output;
 
+    // Dynamic resolution controller picks the ratio itself
+    if (auto dynamicRatio = DynamicResolution::Ratio(); dynamicRatio.has_value())
+        return dynamicRatio;
+
     auto sliderLimit = Config::Instance()->ExtendedLimits.value_or_default() ? 0.1f : 1.0f;
 
     if (Config::Instance()->UpscaleRatioOverrideEnabled.value_or_default() &&
@@ -12,6 +12,8 @@
 
 #include "fsr2_212/ffx_fsr2.h"
 #include "fsr2_212/dx12/ffx_fsr2_dx12.h"
+#include <misc/DynamicResolution.h>
+#include <misc/StateShadow_Dx12.h>
 
 // Tiny Tina's Wonderland
 typedef struct FfxResourceTiny
@@ -306,6 +308,10 @@ static std::optional<float> GetQualityOverrideRatioFfx(const Fsr212::FfxFsr2Qual
 
     std::optional<float> output;
 
+    // Dynamic resolution controller picks the ratio itself
+    if (auto dynamicRatio = DynamicResolution::Ratio(); dynamicRatio.has_value())
+        return dynamicRatio;
+
     auto sliderLimit = Config::Instance()->ExtendedLimits.value_or_default() ? 0.1f : 1.0f;
 
     if (Config::Instance()->UpscaleRatioOverrideEnabled.value_or_default() &&
@@ -613,6 +619,10 @@ static Fsr212::FfxErrorCode ffxFsr2ContextDispatch_Dx12(Fsr212::FfxFsr2Context*
     if (dispatchDescription == nullptr || context == nullptr || dispatchDescription->commandList == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
+    // Game state restore when the dispatch returns, covers the context creation too
+    StateShadowScope_Dx12 stateScope((ID3D12GraphicsCommandList*) dispatchDescription->commandList,
+                                     StateShadow_Dx12::RestoreMask());
+
     // If not in contexts list create and add context
     if (!_contexts.contains(context) && _initParams.contains(context) &&
         !CreateDLSSContext(context, dispatchDescription))
@@ -677,6 +687,10 @@ ffxFsr2ContextDispatch_Pattern_Dx12(Fsr212::FfxFsr2Context* context,
     if (dispatchDescription == nullptr || context == nullptr || dispatchDescription->commandList == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
+    // Game state restore when the dispatch returns, covers the context creation too
+    StateShadowScope_Dx12 stateScope((ID3D12GraphicsCommandList*) dispatchDescription->commandList,
+                                     StateShadow_Dx12::RestoreMask());
+
     // If not in contexts list create and add context
     if (!_contexts.contains(context) && _initParams.contains(context) &&
         !CreateDLSSContext(context, dispatchDescription))
@@ -744,6 +758,10 @@ static Fsr212::FfxErrorCode ffxFsr20ContextDispatch_Dx12(Fsr212::FfxFsr2Context*
     if (dispatchDescription == nullptr || context == nullptr || dispatchDescription->commandList == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
+    // Game state restore when the dispatch returns, covers the context creation too
+    StateShadowScope_Dx12 stateScope((ID3D12GraphicsCommandList*) dispatchDescription->commandList,
+                                     StateShadow_Dx12::RestoreMask());
+
     // If not in contexts list create and add context
     if (!_contexts.contains(context) && _initParams.contains(context) &&
         !CreateDLSSContext20(context, dispatchDescription))
@@ -812,6 +830,10 @@ static Fsr212::FfxErrorCode ffxFsr20ContextDispatch_Pattern_Dx12(Fsr212::FfxFsr2
     if (dispatchDescription == nullptr || context == nullptr || dispatchDescription->commandList == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
+    // Game state restore when the dispatch returns, covers the context creation too
+    StateShadowScope_Dx12 stateScope((ID3D12GraphicsCommandList*) dispatchDescription->commandList,
+                                     StateShadow_Dx12::RestoreMask());
+
     // If not in contexts list create and add context
     if (!_contexts.contains(context) && _initParams.contains(context) &&
         !CreateDLSSContext20(context, dispatchDescription))
@@ -876,6 +898,10 @@ static Fsr212::FfxErrorCode ffxFsr2TinyContextDispatch_Dx12(Fsr212::FfxFsr2Conte
     if (dispatchDescription == nullptr || context == nullptr || dispatchDescription->commandList == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
+    // Game state restore when the dispatch returns, covers the context creation too
+    StateShadowScope_Dx12 stateScope((ID3D12GraphicsCommandList*) dispatchDescription->commandList,
+                                     StateShadow_Dx12::RestoreMask());
+
     // If not in contexts list create and add context
     if (!_contexts.contains(context) && _initParams.contains(context) &&
         !CreateDLSSContextTiny(context, dispatchDescription))
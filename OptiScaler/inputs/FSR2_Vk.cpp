@@ -15,6 +15,7 @@
 
 #include <nvsdk_ngx_vk.h>
 #include <nvsdk_ngx_helpers_vk.h>
+#include <misc/DynamicResolution.h>
 
 typedef FfxErrorCode (*PFN_ffxFsr2ContextCreate)(FfxFsr2Context* context,
                                                  const FfxFsr2ContextDescription* contextDescription);
@@ -236,6 +237,10 @@ static std::optional<float> GetQualityOverrideRatioFfx(const FfxFsr2QualityMode
 
     std::optional<float> output;
 
+    // Dynamic resolution controller picks the ratio itself
+    if (auto dynamicRatio = DynamicResolution::Ratio(); dynamicRatio.has_value())
+        return dynamicRatio;
+
     auto sliderLimit = Config::Instance()->ExtendedLimits.value_or_default() ? 0.1f : 1.0f;
 
     if (Config::Instance()->UpscaleRatioOverrideEnabled.value_or_default() &&
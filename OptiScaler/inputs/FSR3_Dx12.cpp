@@ -13,6 +13,8 @@
 #include "detours/detours.h"
 #include "fsr3/ffx_fsr3upscaler.h"
 #include "fsr3/dx12/ffx_dx12.h"
+#include <misc/DynamicResolution.h>
+#include <misc/StateShadow_Dx12.h>
 
 // FSR3
 typedef Fsr3::FfxErrorCode (*PFN_ffxFsr3UpscalerContextCreate)(
@@ -147,6 +149,10 @@ static std::optional<float> GetQualityOverrideRatioFfx(const Fsr3::FfxFsr3Upscal
 {
     std::optional<float> output;
 
+    // Dynamic resolution controller picks the ratio itself
+    if (auto dynamicRatio = DynamicResolution::Ratio(); dynamicRatio.has_value())
+        return dynamicRatio;
+
     auto sliderLimit = Config::Instance()->ExtendedLimits.value_or_default() ? 0.1f : 1.0f;
 
     if (Config::Instance()->UpscaleRatioOverrideEnabled.value_or_default() &&
@@ -343,6 +349,10 @@ static Fsr3::FfxErrorCode ffxFsr3ContextDispatch_Dx12(Fsr3::FfxFsr3UpscalerConte
     if (pDispatchDescription == nullptr || pContext == nullptr || pDispatchDescription->commandList == nullptr)
         return Fsr3::FFX_ERROR_BACKEND_API_ERROR;
 
+    // Game state restore when the dispatch returns, covers the context creation too
+    StateShadowScope_Dx12 stateScope((ID3D12GraphicsCommandList*) pDispatchDescription->commandList,
+                                     StateShadow_Dx12::RestoreMask());
+
     // If not in contexts list create and add context
     if (!_contexts.contains(pContext) && _initParams.contains(pContext) &&
         !CreateDLSSContext(pContext, pDispatchDescription))
@@ -565,6 +575,10 @@ ffxFsr3ContextDispatch_Pattern_Dx12(Fsr3::FfxFsr3UpscalerContext* pContext,
     if (pDispatchDescription == nullptr || pContext == nullptr || pDispatchDescription->commandList == nullptr)
         return Fsr3::FFX_ERROR_BACKEND_API_ERROR;
 
+    // Game state restore when the dispatch returns, covers the context creation too
+    StateShadowScope_Dx12 stateScope((ID3D12GraphicsCommandList*) pDispatchDescription->commandList,
+                                     StateShadow_Dx12::RestoreMask());
+
     // If not in contexts list create and add context
     if (!_contexts.contains(pContext) && _initParams.contains(pContext) &&
         !CreateDLSSContext(pContext, pDispatchDescription))
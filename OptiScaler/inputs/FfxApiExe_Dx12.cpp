@@ -13,6 +13,8 @@
 #include "ffx_upscale.h"
 #include "dx12/ffx_api_dx12.h"
 #include "FfxApiExe_Dx12.h"
+#include <misc/DynamicResolution.h>
+#include <misc/StateShadow_Dx12.h>
 
 inline static PfnFfxCreateContext _D3D12_CreateContext = nullptr;
 inline static PfnFfxDestroyContext _D3D12_DestroyContext = nullptr;
@@ -101,6 +103,10 @@ static std::optional<float> GetQualityOverrideRatioFfx(const uint32_t input)
 {
     std::optional<float> output;
 
+    // Dynamic resolution controller picks the ratio itself
+    if (auto dynamicRatio = DynamicResolution::Ratio(); dynamicRatio.has_value())
+        return dynamicRatio;
+
     auto sliderLimit = Config::Instance()->ExtendedLimits.value_or_default() ? 0.1f : 1.0f;
 
     if (Config::Instance()->UpscaleRatioOverrideEnabled.value_or_default() &&
@@ -374,6 +380,10 @@ static ffxReturnCode_t ffxDispatch_Dx12(ffxContext* context, ffxDispatchDescHead
     if (dispatchDesc->commandList == nullptr)
         return FFX_API_RETURN_ERROR_PARAMETER;
 
+    // Game state restore when the dispatch returns, covers the context creation too
+    StateShadowScope_Dx12 stateScope((ID3D12GraphicsCommandList*) dispatchDesc->commandList,
+                                     StateShadow_Dx12::RestoreMask());
+
     // If not in contexts list create and add context
     auto contextId = (size_t) *context;
     if (!_contexts.contains(*context) && _initParams.contains(*context) && !CreateDLSSContext(*context, dispatchDesc))
@@ -13,6 +13,8 @@
 #include "dx12/ffx_api_dx12.h"
 
 #include <magic_enum.hpp>
+#include <misc/DynamicResolution.h>
+#include <misc/StateShadow_Dx12.h>
 
 static std::unordered_map<ffxContext, ffxCreateContextDescUpscale> _initParams;
 static std::unordered_map<ffxContext, NVSDK_NGX_Parameter*> _nvParams;
@@ -250,6 +252,10 @@ static std::optional<float> GetQualityOverrideRatioFfx(const uint32_t input)
 {
     std::optional<float> output;
 
+    // Dynamic resolution controller picks the ratio itself
+    if (auto dynamicRatio = DynamicResolution::Ratio(); dynamicRatio.has_value())
+        return dynamicRatio;
+
     auto sliderLimit = Config::Instance()->ExtendedLimits.value_or_default() ? 0.1f : 1.0f;
 
     if (Config::Instance()->UpscaleRatioOverrideEnabled.value_or_default() &&
@@ -739,6 +745,10 @@ ffxReturnCode_t ffxDispatch_Dx12(ffxContext* context, ffxDispatchDescHeader* des
     if (dispatchDesc->commandList == nullptr)
         return FfxApiProxy::D3D12_Dispatch(context, desc);
 
+    // Game state restore when the dispatch returns, covers the context creation too
+    StateShadowScope_Dx12 stateScope((ID3D12GraphicsCommandList*) dispatchDesc->commandList,
+                                     StateShadow_Dx12::RestoreMask());
+
     // If not in contexts list create and add context
     auto contextId = (size_t) *context;
     if (!_contexts.contains(*context) && _initParams.contains(*context) && !CreateDLSSContext(*context, dispatchDesc))
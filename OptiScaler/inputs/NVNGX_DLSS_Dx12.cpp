@@ -16,15 +16,14 @@
 
 #include <hooks/D3D12_Hooks.h>
 
+#include <misc/StateShadow_Dx12.h>
+#include <misc/StartupScheduler.h>
+
 #include <dxgi1_4.h>
-#include <shared_mutex>
-#include "detours/detours.h"
 #include <ankerl/unordered_dense.h>
 
 static ankerl::unordered_dense::map<unsigned int, ContextData<IFeature_Dx12>> Dx12Contexts;
 
-static ankerl::unordered_dense::map<ID3D12GraphicsCommandList*, ID3D12RootSignature*> computeSignatures;
-static ankerl::unordered_dense::map<ID3D12GraphicsCommandList*, ID3D12RootSignature*> graphicSignatures;
 static ID3D12Device* D3D12Device = nullptr;
 static int evalCounter = 0;
 static std::wstring appDataPath = L".";
@@ -45,91 +44,6 @@ class ScopedInit
     ~ScopedInit() { _skipInit = previousState; }
 };
 
-#pragma region Hooks
-
-typedef void (*PFN_SetComputeRootSignature)(ID3D12GraphicsCommandList* commandList,
-                                            ID3D12RootSignature* pRootSignature);
-
-static PFN_SetComputeRootSignature orgSetComputeRootSignature = nullptr;
-static PFN_SetComputeRootSignature orgSetGraphicRootSignature = nullptr;
-
-static bool contextRendering = false;
-static std::shared_mutex computeSigatureMutex;
-static std::shared_mutex graphSigatureMutex;
-
-static void hkSetComputeRootSignature(ID3D12GraphicsCommandList* commandList, ID3D12RootSignature* pRootSignature)
-{
-    if (Config::Instance()->RestoreComputeSignature.value_or_default() && !contextRendering && commandList != nullptr &&
-        pRootSignature != nullptr)
-    {
-        std::unique_lock<std::shared_mutex> lock(computeSigatureMutex);
-        computeSignatures.insert_or_assign(commandList, pRootSignature);
-    }
-
-    orgSetComputeRootSignature(commandList, pRootSignature);
-}
-
-static void hkSetGraphicRootSignature(ID3D12GraphicsCommandList* commandList, ID3D12RootSignature* pRootSignature)
-{
-    if (Config::Instance()->RestoreGraphicSignature.value_or_default() && !contextRendering && commandList != nullptr &&
-        pRootSignature != nullptr)
-    {
-        std::unique_lock<std::shared_mutex> lock(graphSigatureMutex);
-        graphicSignatures.insert_or_assign(commandList, pRootSignature);
-    }
-
-    orgSetGraphicRootSignature(commandList, pRootSignature);
-}
-
-static void HookToCommandList(ID3D12GraphicsCommandList* InCmdList)
-{
-    if (orgSetComputeRootSignature != nullptr || orgSetGraphicRootSignature != nullptr)
-        return;
-
-    PVOID* pVTable = *(PVOID**) InCmdList;
-
-    orgSetComputeRootSignature = (PFN_SetComputeRootSignature) pVTable[29];
-    orgSetGraphicRootSignature = (PFN_SetComputeRootSignature) pVTable[30];
-
-    if (orgSetComputeRootSignature != nullptr || orgSetGraphicRootSignature != nullptr)
-    {
-        DetourTransactionBegin();
-        DetourUpdateThread(GetCurrentThread());
-
-        if (orgSetComputeRootSignature != nullptr)
-            DetourAttach(&(PVOID&) orgSetComputeRootSignature, hkSetComputeRootSignature);
-
-        if (orgSetGraphicRootSignature != nullptr)
-            DetourAttach(&(PVOID&) orgSetGraphicRootSignature, hkSetGraphicRootSignature);
-
-        LOG_DEBUG("Hooked SetRootSignature functions");
-
-        DetourTransactionCommit();
-    }
-}
-
-static void UnhookAll()
-{
-    DetourTransactionBegin();
-    DetourUpdateThread(GetCurrentThread());
-
-    if (orgSetComputeRootSignature != nullptr)
-    {
-        DetourDetach(&(PVOID&) orgSetComputeRootSignature, hkSetComputeRootSignature);
-        orgSetComputeRootSignature = nullptr;
-    }
-
-    if (orgSetGraphicRootSignature != nullptr)
-    {
-        DetourDetach(&(PVOID&) orgSetGraphicRootSignature, hkSetGraphicRootSignature);
-        orgSetGraphicRootSignature = nullptr;
-    }
-
-    DetourTransactionCommit();
-}
-
-#pragma endregion
-
 #pragma region DLSS Init Calls
 
 NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_Init_Ext(unsigned long long InApplicationId,
@@ -150,6 +64,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_Init_Ext(unsigned long long InApp
     if (InFeatureInfo != nullptr && InSDKVersion > 0x0000013)
         State::Instance().NVNGX_Logger = InFeatureInfo->LoggingInfo;
 
+    StartupScheduler::Instance().Wait(StartupSteps::DlssFiles);
+
     if (Config::Instance()->DLSSEnabled.value_or_default() && !_skipInit)
     {
         if (NVNGXProxy::NVNGXModule() == nullptr)
@@ -223,6 +139,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_Init(unsigned long long InApplica
 {
     LOG_FUNC();
 
+    StartupScheduler::Instance().Wait(StartupSteps::DlssFiles);
+
     if (Config::Instance()->DLSSEnabled.value_or_default() && !_skipInit)
     {
         if (Config::Instance()->UseGenericAppIdWithDlss.value_or_default())
@@ -273,6 +191,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_Init_ProjectID(const char* InProj
 {
     LOG_FUNC();
 
+    StartupScheduler::Instance().Wait(StartupSteps::DlssFiles);
+
     if (Config::Instance()->DLSSEnabled.value_or_default() && !_skipInit)
     {
         if (Config::Instance()->UseGenericAppIdWithDlss.value_or_default())
@@ -354,10 +274,11 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_Shutdown(void)
     D3D12Device = nullptr;
 
     State::Instance().currentFeature = nullptr;
+    FeatureProvider_Dx12::ReleaseAllStandby();
 
     // Unhooking and cleaning stuff causing issues during shutdown.
     // Disabled for now to check if it cause any issues
-    // UnhookAll();
+    // StateShadow_Dx12::Unhook();
     DLSSFeatureDx12::Shutdown(D3D12Device);
 
     // Added `&& !State::Instance().isShuttingDown` hack for crash on exit
@@ -542,7 +463,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_CreateFeature(ID3D12GraphicsComma
     LOG_FUNC();
 
     if (InCmdList != nullptr)
-        HookToCommandList(InCmdList);
+        StateShadow_Dx12::Hook(InCmdList);
 
     if (State::Instance().activeFgInput == FGInput::Nukems && DLSSGMod::isDx12Available() &&
         InFeatureID == NVSDK_NGX_Feature_FrameGeneration)
@@ -582,10 +503,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_CreateFeature(ID3D12GraphicsComma
     auto handleId = IFeature::GetNextHandleId();
     LOG_INFO("HandleId: {0}", handleId);
 
-    // Root signature restore
-    if (Config::Instance()->RestoreComputeSignature.value_or_default() ||
-        Config::Instance()->RestoreGraphicSignature.value_or_default())
-        contextRendering = true;
+    // Game state restore
+    StateShadowScope_Dx12 stateScope(InCmdList, StateShadow_Dx12::RestoreMask());
 
     if (InFeatureID == NVSDK_NGX_Feature_SuperSampling)
     {
@@ -660,34 +579,6 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_CreateFeature(ID3D12GraphicsComma
         State::Instance().changeBackend[handleId] = true;
     }
 
-    if (Config::Instance()->RestoreComputeSignature.value_or_default() ||
-        Config::Instance()->RestoreGraphicSignature.value_or_default())
-    {
-        if (Config::Instance()->RestoreComputeSignature.value_or_default() && computeSignatures.contains(InCmdList))
-        {
-            auto signature = computeSignatures[InCmdList];
-            LOG_TRACE("restore ComputeRootSig: {0:X}", (UINT64) signature);
-            orgSetComputeRootSignature(InCmdList, signature);
-        }
-        else if (Config::Instance()->RestoreComputeSignature.value_or_default())
-        {
-            LOG_TRACE("can't restore ComputeRootSig");
-        }
-
-        if (Config::Instance()->RestoreGraphicSignature.value_or_default() && graphicSignatures.contains(InCmdList))
-        {
-            auto signature = graphicSignatures[InCmdList];
-            LOG_TRACE("restore GraphicRootSig: {0:X}", (UINT64) signature);
-            orgSetGraphicRootSignature(InCmdList, signature);
-        }
-        else if (Config::Instance()->RestoreGraphicSignature.value_or_default())
-        {
-            LOG_TRACE("can't restore GraphicRootSig");
-        }
-
-        contextRendering = false;
-    }
-
     State::Instance().FGchanged = true;
 
     return NVSDK_NGX_Result_Success;
@@ -741,6 +632,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_ReleaseFeature(NVSDK_NGX_Handle*
         return DLSSGMod::D3D12_ReleaseFeature(InHandle);
     }
 
+    FeatureProvider_Dx12::ReleaseStandby(handleId);
+
     if (auto deviceContext = Dx12Contexts[handleId].feature.get(); deviceContext != nullptr)
     {
         if (deviceContext == State::Instance().currentFeature)
@@ -784,6 +677,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_GetFeatureRequirements(
         return NVSDK_NGX_Result_Success;
     }
 
+    StartupScheduler::Instance().Wait(StartupSteps::DlssFiles);
+
     if (Config::Instance()->DLSSEnabled.value_or_default() && NVNGXProxy::NVNGXModule() == nullptr)
         NVNGXProxy::InitNVNGX();
 
@@ -882,11 +777,16 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
             State::Instance().changeBackend[handleId] = true;
     }
 
+    // Game state restore when the scope ends, feature changes record their init work on the game's list too
+    auto restoreMask = deviceContext->feature != nullptr && deviceContext->feature->Name() == "DLSSD"
+                           ? StateShadowRestore_None
+                           : StateShadow_Dx12::RestoreMask();
+    StateShadowScope_Dx12 stateScope(InCmdList, restoreMask);
+
     // Change backend
     if (State::Instance().changeBackend[handleId])
     {
         UpscalerInputsDx12::Reset();
-        contextRendering = false;
 
         FeatureProvider_Dx12::ChangeFeature(State::Instance().newBackend, D3D12Device, InCmdList, handleId,
                                             InParameters, deviceContext);
@@ -906,12 +806,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
 
     State::Instance().currentFeature = deviceContext->feature.get();
 
-    // Root signature restore
-    if (deviceContext->feature->Name() != "DLSSD" && (Config::Instance()->RestoreComputeSignature.value_or_default() ||
-                                                      Config::Instance()->RestoreGraphicSignature.value_or_default()))
-    {
-        contextRendering = true;
-    }
+    deviceContext->feature->TrackJitter(InParameters);
 
     UpscalerInputsDx12::UpscaleStart(InCmdList, InParameters, deviceContext->feature.get());
     FSR3FG::SetUpscalerInputs(InCmdList, InParameters, deviceContext->feature.get());
@@ -928,6 +823,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
         evalResult = deviceContext->feature->Evaluate(InCmdList, InParameters);
     }
 
+    FeatureProvider_Dx12::OnEvaluate(InCmdList);
+
     NVSDK_NGX_Result methodResult = evalResult ? NVSDK_NGX_Result_Success : NVSDK_NGX_Result_Fail;
 
     if (evalResult)
@@ -941,35 +838,6 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
         UpscalerInputsDx12::UpscaleEnd(InCmdList, InParameters, deviceContext->feature.get());
     }
 
-    // Root signature restore
-    if (deviceContext->feature->Name() != "DLSSD" && (Config::Instance()->RestoreComputeSignature.value_or_default() ||
-                                                      Config::Instance()->RestoreGraphicSignature.value_or_default()))
-    {
-        if (Config::Instance()->RestoreComputeSignature.value_or_default() && computeSignatures.contains(InCmdList))
-        {
-            auto signature = computeSignatures[InCmdList];
-            LOG_TRACE("restore orgComputeRootSig: {0:X}", (UINT64) signature);
-            orgSetComputeRootSignature(InCmdList, signature);
-        }
-        else if (Config::Instance()->RestoreComputeSignature.value_or_default())
-        {
-            LOG_WARN("Can't restore ComputeRootSig!");
-        }
-
-        if (Config::Instance()->RestoreGraphicSignature.value_or_default() && graphicSignatures.contains(InCmdList))
-        {
-            auto signature = graphicSignatures[InCmdList];
-            LOG_TRACE("restore orgGraphicRootSig: {0:X}", (UINT64) signature);
-            orgSetGraphicRootSignature(InCmdList, signature);
-        }
-        else if (Config::Instance()->RestoreGraphicSignature.value_or_default())
-        {
-            LOG_WARN("Can't restore GraphicRootSig!");
-        }
-
-        contextRendering = false;
-    }
-
     LOG_DEBUG("Upscaling done: {}", evalResult);
 
     return methodResult;
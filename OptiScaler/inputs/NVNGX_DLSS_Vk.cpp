@@ -11,6 +11,7 @@
 #include "upscalers/FeatureProvider_Vk.h"
 
 #include <upscaler_time/UpscalerTime_Vk.h>
+#include <misc/StartupScheduler.h>
 
 #include <vulkan/vulkan.hpp>
 #include <ankerl/unordered_dense.h>
@@ -47,6 +48,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_Init_Ext2(
 {
     LOG_FUNC();
 
+    StartupScheduler::Instance().Wait(StartupSteps::DlssFiles);
+
     if (Config::Instance()->DLSSEnabled.value_or_default() && !_skipInit)
     {
         if (Config::Instance()->UseGenericAppIdWithDlss.value_or_default())
@@ -166,6 +169,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_Init_Ext(unsigned long long InAp
 {
     LOG_FUNC();
 
+    StartupScheduler::Instance().Wait(StartupSteps::DlssFiles);
+
     if (Config::Instance()->DLSSEnabled.value_or_default() && !_skipInit)
     {
         if (Config::Instance()->UseGenericAppIdWithDlss.value_or_default())
@@ -203,6 +208,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_Init_ProjectID_Ext(
 {
     LOG_FUNC();
 
+    StartupScheduler::Instance().Wait(StartupSteps::DlssFiles);
+
     if (Config::Instance()->DLSSEnabled.value_or_default() && !_skipInit)
     {
         if (NVNGXProxy::NVNGXModule() == nullptr)
@@ -245,6 +252,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_Init(unsigned long long InApplic
 {
     LOG_FUNC();
 
+    StartupScheduler::Instance().Wait(StartupSteps::DlssFiles);
+
     if (Config::Instance()->DLSSEnabled.value_or_default() && !_skipInit)
     {
         if (Config::Instance()->UseGenericAppIdWithDlss.value_or_default())
@@ -282,6 +291,8 @@ NVSDK_NGX_VULKAN_Init_ProjectID(const char* InProjectId, NVSDK_NGX_EngineType In
 {
     LOG_FUNC();
 
+    StartupScheduler::Instance().Wait(StartupSteps::DlssFiles);
+
     if (Config::Instance()->DLSSEnabled.value_or_default() && !_skipInit)
     {
         if (Config::Instance()->UseGenericAppIdWithDlss.value_or_default())
@@ -554,6 +565,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_GetFeatureRequirements(
         return NVSDK_NGX_Result_Success;
     }
 
+    StartupScheduler::Instance().Wait(StartupSteps::DlssFiles);
+
     if (Config::Instance()->DLSSEnabled.value_or_default() && NVNGXProxy::NVNGXModule() == nullptr)
         NVNGXProxy::InitNVNGX();
 
@@ -916,6 +929,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_EvaluateFeature(VkCommandBuffer
         return NVSDK_NGX_Result_Success;
     }
 
+    deviceContext->TrackJitter(InParameters);
+
     UpscalerTimeVk::UpscaleStart(InCmdList);
 
     auto upscaleResult = deviceContext->Evaluate(InCmdList, InParameters);
@@ -4,11 +4,16 @@
 
 #include <proxies/XeSS_Proxy.h>
 #include <nvsdk_ngx_vk.h>
+#include <misc/DynamicResolution.h>
 
 static std::optional<float> GetQualityOverrideRatio(const xess_quality_settings_t input)
 {
     std::optional<float> output;
 
+    // Dynamic resolution controller picks the ratio itself
+    if (auto dynamicRatio = DynamicResolution::Ratio(); dynamicRatio.has_value())
+        return dynamicRatio;
+
     auto sliderLimit = Config::Instance()->ExtendedLimits.value_or_default() ? 0.1f : 1.0f;
 
     if (Config::Instance()->UpscaleRatioOverrideEnabled.value_or_default() &&
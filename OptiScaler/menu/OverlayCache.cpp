@@ -0,0 +1,53 @@
+#include "OverlayCache.h"
+
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::Menu
+
+void OverlayCache::FreeLists()
+{
+    for (auto list : _lists)
+        IM_DELETE(list);
+
+    _lists.clear();
+    _drawData.CmdLists.clear();
+}
+
+OverlayFrame OverlayCache::Schedule(bool visible, bool interactive, bool animating, uint64_t contentHash,
+                                    double nowMs, float refreshRate)
+{
+    auto frame = _schedule.Next(visible, interactive, animating, contentHash, nowMs, refreshRate);
+
+    if (frame == OverlayFrame::Hidden || frame == OverlayFrame::Draw)
+        FreeLists();
+
+    return frame;
+}
+
+void OverlayCache::Store(const ImDrawData* drawData, uint64_t contentHash, double nowMs)
+{
+    FreeLists();
+
+    if (drawData == nullptr || !drawData->Valid)
+    {
+        _schedule.Cleared();
+        return;
+    }
+
+    _drawData = *drawData;
+    _drawData.CmdLists.clear();
+
+    for (auto list : drawData->CmdLists)
+    {
+        auto clone = list->CloneOutput();
+        _lists.push_back(clone);
+        _drawData.CmdLists.push_back(clone);
+    }
+
+    _schedule.Stored(contentHash, nowMs);
+}
+
+void OverlayCache::Clear()
+{
+    FreeLists();
+    _schedule.Cleared();
+}
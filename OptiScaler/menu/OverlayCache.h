@@ -0,0 +1,41 @@
+#pragma once
+#include <pch.h>
+
+#include "OverlaySchedule.h"
+
+#include <imgui/imgui.h>
+
+#include <vector>
+
+// Keeps the last draw data of the passive overlays (fps overlay, splash, update notice)
+// and replays it until its content changes or the refresh interval passes. Building the
+// ImGui frame is the costly part of the overlays, replaying only uploads the cached
+// vertices again. The interactive menu is always drawn fresh.
+class OverlayCache
+{
+    ImDrawData _drawData {};
+    std::vector<ImDrawList*> _lists;
+    OverlaySchedule _schedule;
+
+    void FreeLists();
+
+  public:
+    // Hidden and Draw frames free the cached one, see OverlaySchedule::Next
+    OverlayFrame Schedule(bool visible, bool interactive, bool animating, uint64_t contentHash, double nowMs,
+                          float refreshRate);
+
+    // Copies the draw data which was built for a Rebuild frame
+    void Store(const ImDrawData* drawData, uint64_t contentHash, double nowMs);
+
+    ImDrawData* DrawData() { return _schedule.HasFrame() ? &_drawData : nullptr; }
+    bool HasFrame() const { return _schedule.HasFrame(); }
+
+    // Must be called before the ImGui context is destroyed
+    void Clear();
+
+    OverlayCache() = default;
+    ~OverlayCache() { FreeLists(); }
+
+    OverlayCache(const OverlayCache&) = delete;
+    OverlayCache& operator=(const OverlayCache&) = delete;
+};
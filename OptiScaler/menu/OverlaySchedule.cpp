@@ -0,0 +1,29 @@
+#include "OverlaySchedule.h"
+
+OverlayFrame OverlaySchedule::Next(bool visible, bool interactive, bool animating, uint64_t contentHash, double nowMs,
+                                   float refreshRate)
+{
+    if (!visible)
+    {
+        _hasFrame = false;
+        return OverlayFrame::Hidden;
+    }
+
+    if (interactive || animating || refreshRate <= 0.0f)
+    {
+        _hasFrame = false;
+        return OverlayFrame::Draw;
+    }
+
+    if (!_hasFrame || contentHash != _contentHash || nowMs - _buildTime >= 1000.0 / refreshRate)
+        return OverlayFrame::Rebuild;
+
+    return OverlayFrame::Reuse;
+}
+
+void OverlaySchedule::Stored(uint64_t contentHash, double nowMs)
+{
+    _hasFrame = true;
+    _contentHash = contentHash;
+    _buildTime = nowMs;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <pch.h>
+
+#include <cstring>
+#include <type_traits>
+
+enum class OverlayFrame : uint8_t
+{
+    Hidden,  // Nothing to draw
+    Draw,    // Build a new ImGui frame and draw it, not cached
+    Rebuild, // Build a new ImGui frame, draw it and cache it
+    Reuse,   // Draw the cached frame again without building one
+};
+
+// Decides when OverlayCache has to build the passive overlays again, kept apart from the
+// ImGui draw data so it can be tested without ImGui
+class OverlaySchedule
+{
+    bool _hasFrame = false;
+    uint64_t _contentHash = 0;
+    double _buildTime = 0.0;
+
+  public:
+    static constexpr uint64_t HashSeed = 14695981039346656037ull;
+
+    // FNV-1a over the bytes of a value, for building the content hash
+    template <typename T> static uint64_t Hash(uint64_t seed, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+
+        for (auto byte : bytes)
+        {
+            seed ^= byte;
+            seed *= 1099511628211ull;
+        }
+
+        return seed;
+    }
+
+    // visible: any overlay is shown, interactive: menu is open, animating: a fade is in progress.
+    // A refresh rate of 0 or less rebuilds every frame. Hidden and Draw drop the cached frame.
+    OverlayFrame Next(bool visible, bool interactive, bool animating, uint64_t contentHash, double nowMs,
+                      float refreshRate);
+
+    // A frame was cached for a Rebuild
+    void Stored(uint64_t contentHash, double nowMs);
+    void Cleared() { _hasFrame = false; }
+
+    bool HasFrame() const { return _hasFrame; }
+};
@@ -12,8 +12,14 @@
 
 #include <nvapi/fakenvapi.h>
 #include <hooks/Reflex_Hooks.h>
+#include <hooks/Reflex_Timeline.h>
+#include <hooks/FG_Hooks.h>
+
+#include <misc/DynamicResolution.h>
+#include <misc/StartupScheduler.h>
 
 #include <version_check.h>
+#include <ConfigSchema.h>
 
 #include <imgui/imgui_internal.h>
 
@@ -23,6 +29,9 @@
 #include <array>
 #include <chrono>
 
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::Menu
+
 #define MARK_ALL_BACKENDS_CHANGED()                                                                                    \
     for (auto& singleChangeBackend : State::Instance().changeBackend)                                                  \
         singleChangeBackend.second = true;
@@ -1479,11 +1488,25 @@ inline static std::string GetDispatchString(UINT source)
 static double lastTime = 0.0;
 static UINT64 uwpTargetFrame = 0;
 
+static void PushFrameTimes(const State& state)
+{
+    float lastFT = static_cast<float>(state.frameTimes.empty() ? 0.0f : state.frameTimes.back());
+    float lastUT = static_cast<float>(state.upscaleTimes.empty() ? 0.0f : state.upscaleTimes.back());
+    gFrameTimes.Push(lastFT);
+    gUpscalerTimes.Push(lastUT);
+}
+
 bool MenuCommon::RenderMenu()
 {
     if (!_isInited)
         return false;
 
+    // DLSSEnabled and the nvngx paths shown in the menu are set on the startup worker
+    static bool dlssFilesReady = false;
+
+    if (!dlssFilesReady)
+        dlssFilesReady = StartupScheduler::Instance().Wait(StartupSteps::DlssFiles);
+
     auto& state = State::Instance();
     auto config = Config::Instance();
 
@@ -1642,9 +1665,45 @@ bool MenuCommon::RenderMenu()
         splashMessage = splashText[std::rand() % splashText.size()];
     }
 
+    bool splashVisible = !config->DisableSplash.value_or_default() && now > splashStart && now < splashLimit;
+    bool noticeVisible = updateNoticeVisible && now < updateNoticeLimit;
+
+    // FPS Overlay font
+    auto fpsScale = config->FpsScale.value_or(config->MenuScale.value_or_default());
+
+    // Passive overlays are only rebuilt when what they show changes or on refresh interval
+    bool fading = (splashVisible && (now - splashStart < fadeTime || splashLimit - now < fadeTime)) ||
+                  (noticeVisible &&
+                   (now - updateNoticeStart < updateNoticeFade || updateNoticeLimit - now < updateNoticeFade));
+
+    auto contentHash = OverlaySchedule::HashSeed;
+    contentHash = OverlaySchedule::Hash(contentHash, splashVisible);
+    contentHash = OverlaySchedule::Hash(contentHash, noticeVisible);
+    contentHash = OverlaySchedule::Hash(contentHash, config->ShowFps.value_or_default());
+    contentHash = OverlaySchedule::Hash(contentHash, config->FpsOverlayType.value_or_default());
+    contentHash = OverlaySchedule::Hash(contentHash, config->FpsOverlayPos.value_or_default());
+    contentHash = OverlaySchedule::Hash(contentHash, config->FpsOverlayHorizontal.value_or_default());
+    contentHash = OverlaySchedule::Hash(contentHash, config->FpsOverlayAlpha.value_or_default());
+    contentHash = OverlaySchedule::Hash(contentHash, fpsScale);
+    contentHash = OverlaySchedule::Hash(contentHash, io.DisplaySize);
+    contentHash = OverlaySchedule::Hash(contentHash, currentFeature);
+    contentHash = OverlaySchedule::Hash(contentHash, state.activeFgOutput);
+
+    bool overlayVisible = splashVisible || noticeVisible || config->ShowFps.value_or_default() || _isVisible;
+    auto overlayFrame = _overlayCache.Schedule(overlayVisible, _isVisible, fading, contentHash, now,
+                                               config->FpsOverlayRefreshRate.value_or_default());
+
+    _drawCached = overlayFrame == OverlayFrame::Reuse;
+
+    if (_drawCached)
+    {
+        // Graphs still get a sample every frame
+        PushFrameTimes(state);
+        return true;
+    }
+
     // New frame check
-    if ((!config->DisableSplash.value_or_default() && now > splashStart && now < splashLimit) ||
-        (updateNoticeVisible && now < updateNoticeLimit) || config->ShowFps.value_or_default() || _isVisible)
+    if (overlayFrame != OverlayFrame::Hidden)
     {
         if (!_isUWP)
         {
@@ -1793,9 +1852,6 @@ bool MenuCommon::RenderMenu()
         }
     }
 
-    // FPS Overlay font
-    auto fpsScale = config->FpsScale.value_or(config->MenuScale.value_or_default());
-
     // Update frame time & upscaler time averages
     float averageFrameTime = 0.0f;
     float averageUpscalerFT = 0.0f;
@@ -1817,10 +1873,7 @@ bool MenuCommon::RenderMenu()
         frameRate = 1000.0 / frameTime;
         frameTimesCalculated = true;
 
-        float lastFT = static_cast<float>(state.frameTimes.empty() ? 0.0f : state.frameTimes.back());
-        float lastUT = static_cast<float>(state.upscaleTimes.empty() ? 0.0f : state.upscaleTimes.back());
-        gFrameTimes.Push(lastFT);
-        gUpscalerTimes.Push(lastUT);
+        PushFrameTimes(state);
 
         averageFrameTime = gFrameTimes.Average();
         averageUpscalerFT = gUpscalerTimes.Average();
@@ -2057,9 +2110,11 @@ bool MenuCommon::RenderMenu()
                 constexpr auto delayBetweenPollsMs = 500;
                 static auto previousPoll = 0.0;
                 static bool gotData = false;
+                static ReflexTimelineStats timelineStats {};
                 if (previousPoll <= 0.001 || previousPoll + delayBetweenPollsMs < now)
                 {
                     gotData = ReflexHooks::updateTimingData();
+                    timelineStats = ReflexTimeline::Instance().Analyze();
                     previousPoll = now;
                 }
 
@@ -2104,6 +2159,41 @@ bool MenuCommon::RenderMenu()
                     drawTiming(TimingType::OsRenderQueue, "RenderQueue", ImVec4(0.76f, 0.51f, 0.188f, 1.0f));
                     drawTiming(TimingType::GpuRender, "GpuRender", ImVec4(0.569f, 0.117f, 0.705f, 1.0f));
                 }
+
+                const auto& pcLatency = timelineStats.stages[(size_t) ReflexStage::PcLatency];
+                if (pcLatency.count > 0)
+                {
+                    ImGui::Text("PC Latency avg: %.1fms, p95: %.1fms, p99: %.1fms", pcLatency.avg, pcLatency.p95,
+                                pcLatency.p99);
+                }
+
+                const auto& fgHoldback = timelineStats.stages[(size_t) ReflexStage::FGHoldback];
+                if (fgHoldback.count > 0)
+                    ImGui::Text("FG holdback avg: %.1fms, p95: %.1fms", fgHoldback.avg, fgHoldback.p95);
+
+                if (timelineStats.droppedMarkers > 0 || timelineStats.outOfOrderMarkers > 0)
+                {
+                    ImGui::TextColored(ImVec4(1.f, 0.8f, 0.f, 1.f), "Markers dropped: %llu, out of order: %llu",
+                                       timelineStats.droppedMarkers, timelineStats.outOfOrderMarkers);
+                }
+
+                if (State::Instance().activeFgOutput != FGOutput::NoFG)
+                {
+                    static std::vector<StageTiming> presentStages;
+                    if (previousPoll == now)
+                        presentStages = FGHooks::PresentStageTimings();
+
+                    if (!presentStages.empty())
+                        ImGui::Text("FG present stages, CPU time avg:");
+
+                    for (const auto& stage : presentStages)
+                    {
+                        if (!stage.enabled || stage.calls == 0)
+                            continue;
+
+                        ImGui::Text("%-16s %5.2fms, max: %5.2fms", stage.name, stage.avgMs, stage.maxMs);
+                    }
+                }
             }
 
             ImGui::PopStyleColor(3); // Restore the style
@@ -3272,6 +3362,7 @@ bool MenuCommon::RenderMenu()
                                     ImGui::Checkbox("Draw UI over FG", &drawUIOverFG))
                                 {
                                     config->FGDrawUIOverFG = drawUIOverFG;
+                                    FGHooks::InvalidatePresentPipeline();
                                 }
 
                                 ImGui::EndDisabled();
@@ -4061,7 +4152,10 @@ bool MenuCommon::RenderMenu()
                             {
                                 bool useMutexForPresent = config->FGUseMutexForSwapchain.value_or_default();
                                 if (ImGui::Checkbox("FG Use Mutex for Present", &useMutexForPresent))
+                                {
                                     config->FGUseMutexForSwapchain = useMutexForPresent;
+                                    FGHooks::InvalidatePresentPipeline();
+                                }
                                 ShowHelpMarker("Use mutex to prevent desync of FG and crashes\n"
                                                "Disabling might improve the perf but decrease stability");
 
@@ -4747,6 +4841,16 @@ bool MenuCommon::RenderMenu()
                                             ((float) currentFeature->DisplayWidth() * _ssRatio) /
                                                 (float) currentFeature->RenderWidth(),
                                             currentFeature->JitterCount());
+
+                                const auto& jitter = currentFeature->JitterState();
+
+                                if (jitter.samples > 0)
+                                {
+                                    ImGui::Text("Jitter: %s, %s, %u phases (expected %u), restarts: %u",
+                                                JitterAnalyzer::SequenceName(jitter.sequence),
+                                                JitterAnalyzer::UnitName(jitter.unit), jitter.period,
+                                                jitter.expectedPhases, jitter.restarts);
+                                }
                             }
 
                             ImGui::EndDisabled();
@@ -4963,6 +5067,28 @@ bool MenuCommon::RenderMenu()
                         ImGui::EndTable();
                     }
 
+                    if (bool drsController = config->DrsControllerEnabled.value_or_default();
+                        ImGui::Checkbox("Frame Time Controller", &drsController))
+                        config->DrsControllerEnabled = drsController;
+                    ShowHelpMarker("Picks the upscale ratio to keep the frame time at the target\n"
+                                   "Needs a game which queries the render resolution every frame or uses DRS");
+
+                    ImGui::BeginDisabled(!config->DrsControllerEnabled.value_or_default());
+
+                    float drsTarget = config->DrsTargetFrameTime.value_or_default();
+                    if (ImGui::SliderFloat("Target Frame Time", &drsTarget, 4.0f, 50.0f, "%.2f ms"))
+                        config->DrsTargetFrameTime = drsTarget;
+
+                    if (DynamicResolution::IsActive())
+                    {
+                        auto& controller = DynamicResolution::Controller();
+                        ImGui::Text("Ratio: %.2f, Frame: %.2f ms, Fixed: %.2f ms, Scalable: %.2f ms",
+                                    controller.Ratio(), controller.AverageFrameTime(), controller.FixedCost(),
+                                    controller.ScalableCost());
+                    }
+
+                    ImGui::EndDisabled();
+
                     // Non-DLSS hotfixes -----------------------------
                     if (currentFeature != nullptr && !currentFeature->IsFrozen() && currentBackend != "dlss")
                     {
@@ -4993,10 +5119,14 @@ bool MenuCommon::RenderMenu()
                                 if (bool crs = config->RestoreComputeSignature.value_or_default();
                                     ImGui::Checkbox("Restore Compute Root Signature", &crs))
                                     config->RestoreComputeSignature = crs;
+                                ShowHelpMarker("Restores compute root signature and arguments after upscaling\n"
+                                               "Descriptor heaps and pipeline state are restored with either one");
 
                                 if (bool grs = config->RestoreGraphicSignature.value_or_default();
                                     ImGui::Checkbox("Restore Graphic Root Signature", &grs))
                                     config->RestoreGraphicSignature = grs;
+                                ShowHelpMarker(
+                                    "Restores graphics root signature, arguments and topology after upscaling");
                             }
                         }
                     }
@@ -5011,10 +5141,9 @@ bool MenuCommon::RenderMenu()
 
                     if (config->LogToConsole.value_or_default() || config->LogToFile.value_or_default() ||
                         config->LogToNGX.value_or_default())
-                        spdlog::default_logger()->set_level(
-                            (spdlog::level::level_enum) config->LogLevel.value_or_default());
+                        LogGate::SetGlobal(config->LogLevel.value_or_default());
                     else
-                        spdlog::default_logger()->set_level(spdlog::level::off);
+                        LogGate::SetGlobal(SPDLOG_LEVEL_OFF);
 
                     if (bool toFile = config->LogToFile.value_or_default(); ImGui::Checkbox("To File", &toFile))
                     {
@@ -5040,13 +5169,41 @@ bool MenuCommon::RenderMenu()
                             if (ImGui::Selectable(logLevels[n], (config->LogLevel.value_or_default() == n)))
                             {
                                 config->LogLevel = n;
-                                spdlog::default_logger()->set_level(
-                                    (spdlog::level::level_enum) config->LogLevel.value_or_default());
+                                LogGate::SetGlobal(config->LogLevel.value_or_default());
                             }
                         }
 
                         ImGui::EndCombo();
                     }
+
+                    if (auto ch = ScopedCollapsingHeader("Log Categories"); ch.IsHeaderOpen())
+                    {
+                        ScopedIndent indent {};
+                        ImGui::Spacing();
+
+                        // Index 0 is LogGate's inherit (-1)
+                        const char* categoryLevels[] = { "Log Level",   "Trace",   "Debug",
+                                                         "Information", "Warning", "Error" };
+
+                        for (uint32_t i = 0; i < (uint32_t) LogCategory::Count; i++)
+                        {
+                            auto category = (LogCategory) i;
+                            auto level = LogGate::CategoryLevel(category);
+
+                            if (ImGui::BeginCombo(LogGate::Name(category), categoryLevels[level + 1]))
+                            {
+                                for (int n = -1; n < 5; n++)
+                                {
+                                    if (ImGui::Selectable(categoryLevels[n + 1], level == n))
+                                        LogGate::SetCategory(category, n);
+                                }
+
+                                ImGui::EndCombo();
+                            }
+                        }
+
+                        ShowHelpMarker("Overrides Log Level for parts of OptiScaler, not saved to ini");
+                    }
                 }
 
                 // FPS OVERLAY -----------------------------
@@ -5095,10 +5252,28 @@ bool MenuCommon::RenderMenu()
                         ImGui::EndCombo();
                     }
 
+                    if (config->FpsOverlayType.value_or_default() >= FpsOverlay_ReflexTimings)
+                    {
+                        if (ImGui::Button("Export Reflex Timeline"))
+                            ReflexTimeline::Instance().ExportCsv(Util::DllPath().parent_path() /
+                                                                 "OptiScaler_ReflexTimeline.csv");
+
+                        ShowHelpMarker("Saves the last 256 frames of Reflex markers and latency reports\n"
+                                       "to OptiScaler_ReflexTimeline.csv next to OptiScaler");
+                    }
+
                     float fpsAlpha = config->FpsOverlayAlpha.value_or_default();
                     if (ImGui::SliderFloat("Background Alpha", &fpsAlpha, 0.0f, 1.0f, "%.2f"))
                         config->FpsOverlayAlpha = fpsAlpha;
 
+                    float fpsRefreshRate = config->FpsOverlayRefreshRate.value_or_default();
+                    if (ImGui::SliderFloat("Refresh Rate", &fpsRefreshRate, 0.0f, 60.0f, "%.0f Hz"))
+                        config->FpsOverlayRefreshRate = fpsRefreshRate;
+
+                    ShowHelpMarker("How many times per second the overlay is rebuilt while the menu is closed\n"
+                                   "Frames in between draw the last built overlay again\n\n"
+                                   "0 rebuilds it every frame");
+
                     const char* options[] = { "Same as menu", "0.5", "0.6", "0.7", "0.8", "0.9", "1.0", "1.1", "1.2",
                                               "1.3",          "1.4", "1.5", "1.6", "1.7", "1.8", "1.9", "2.0" };
                     int currentIndex = std::max(((int) (config->FpsScale.value_or(0.0f) * 10.0f)) - 4, 0);
@@ -5183,6 +5358,8 @@ bool MenuCommon::RenderMenu()
                                 config->ForceVsync = true;
                             else
                                 config->ForceVsync.reset();
+
+                            FGHooks::InvalidatePresentPipeline();
                         }
                         ImGui::SameLine(0.0f, 16.0f);
 
@@ -5192,6 +5369,8 @@ bool MenuCommon::RenderMenu()
                                 config->ForceVsync = false;
                             else
                                 config->ForceVsync.reset();
+
+                            FGHooks::InvalidatePresentPipeline();
                         }
                         ImGui::SameLine(0.0f, 16.0f);
 
@@ -5222,7 +5401,10 @@ bool MenuCommon::RenderMenu()
                         ImGui::SameLine(0.0f, 16.0f);
 
                         if (ImGui::Button("Reset##10"))
+                        {
                             config->ForceVsync.reset();
+                            FGHooks::InvalidatePresentPipeline();
+                        }
 
                         ShowHelpMarker("Force V-Sync On/Off & Sync Interval options");
                     }
@@ -5517,8 +5699,14 @@ bool MenuCommon::RenderMenu()
                 ImGui::SameLine(0.0f, 15.0f);
 
                 if (ImGui::Button("Save INI"))
+                {
                     config->SaveIni();
 
+                    _restartOptions.clear();
+                    for (auto option : ConfigSchema::ChangedSinceLoad(config, ConfigScope::Restart))
+                        _restartOptions += std::format("{}.{}\n", option->section, option->key);
+                }
+
                 ImGui::SameLine(0.0f, 6.0f);
 
                 if (ImGui::Button("Close"))
@@ -5542,6 +5730,13 @@ bool MenuCommon::RenderMenu()
                 ImGui::Spacing();
                 ImGui::Separator();
 
+                if (!_restartOptions.empty())
+                {
+                    ImGui::Spacing();
+                    ImGui::TextColored(ImVec4(1.f, 0.8f, 0.f, 1.f), "Some saved changes need a game restart");
+                    ShowHelpMarker(_restartOptions.c_str());
+                }
+
                 if (state.nvngxIniDetected)
                 {
                     ImGui::Spacing();
@@ -5798,11 +5993,24 @@ bool MenuCommon::RenderMenu()
     }
 
     if (newFrame)
-        ImGui::EndFrame();
+    {
+        ImGui::Render();
+
+        if (overlayFrame == OverlayFrame::Rebuild)
+            _overlayCache.Store(ImGui::GetDrawData(), contentHash, now);
+    }
 
     return newFrame;
 }
 
+ImDrawData* MenuCommon::DrawData()
+{
+    if (_drawCached)
+        return _overlayCache.DrawData();
+
+    return ImGui::GetDrawData();
+}
+
 void MenuCommon::Init(HWND InHwnd, bool isUWP)
 {
     _handle = InHwnd;
@@ -5904,6 +6112,9 @@ void MenuCommon::Shutdown()
     else
         ImGui_ImplUwp_Shutdown();
 
+    _overlayCache.Clear();
+    _drawCached = false;
+
     ImGui::DestroyContext();
 
     _handle = nullptr;
@@ -10,6 +10,8 @@
 #include <imgui/imgui_impl_win32.h>
 #include <imgui/imgui_impl_uwp.h>
 
+#include "OverlayCache.h"
+
 #include <detours/detours.h>
 
 extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
@@ -66,6 +68,9 @@ class MenuCommon
     inline static bool _isUWP = false;
     // inline static bool _isResetRequested = false;
 
+    // Section.Key of the saved options which are only read during startup
+    inline static std::string _restartOptions;
+
     // mipmap calculations
     inline static bool _showMipmapCalcWindow = false;
     inline static bool _showHudlessWindow = false;
@@ -98,6 +103,10 @@ class MenuCommon
     inline static int _selectedScale = 5;
     inline static bool _imguiSizeUpdate = true;
 
+    // passive overlay draw data reuse
+    inline static OverlayCache _overlayCache;
+    inline static bool _drawCached = false;
+
     // overlay states
     inline static bool _dx11Ready = false;
     inline static bool _dx12Ready = false;
@@ -180,7 +189,10 @@ class MenuCommon
     static bool IsVisible() { return _isVisible; }
     static HWND Handle() { return _handle; }
 
+    // Builds or reuses the overlay frame, returns true if there is something to draw.
+    // ImGui::Render is already done, draw DrawData() instead of ImGui::GetDrawData().
     static bool RenderMenu();
+    static ImDrawData* DrawData();
     static void Init(HWND InHwnd, bool isUWP);
     static void Shutdown();
     static void HideMenu();
@@ -5,6 +5,9 @@
 #include <imgui/imgui_impl_dx11.h>
 #include <imgui/imgui_impl_win32.h>
 
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::Menu
+
 void Menu_Dx11::CreateRenderTarget(ID3D11Resource* out)
 {
     ID3D11Texture2D* outTexture2D = nullptr;
@@ -107,7 +110,7 @@ bool Menu_Dx11::Render(ID3D11DeviceContext* pCmdList, ID3D11Resource* outTexture
         if (_renderTargetTexture == nullptr)
         {
             // Render
-            ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+            ImGui_ImplDX11_RenderDrawData(MenuCommon::DrawData());
             return true;
         }
 
@@ -115,7 +118,7 @@ bool Menu_Dx11::Render(ID3D11DeviceContext* pCmdList, ID3D11Resource* outTexture
         pCmdList->CopyResource(_renderTargetTexture, outTexture);
 
         // Render
-        ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+        ImGui_ImplDX11_RenderDrawData(MenuCommon::DrawData());
 
         // Copy result
         pCmdList->CopyResource(outTexture, _renderTargetTexture);
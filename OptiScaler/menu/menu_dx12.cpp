@@ -7,6 +7,9 @@
 #include <imgui/imgui_impl_dx12.h>
 #include <imgui/imgui_impl_win32.h>
 
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::Menu
+
 long frameCounter = 0;
 static int const SRV_HEAP_SIZE = 64;
 
@@ -124,7 +127,7 @@ bool Menu_Dx12::Render(ID3D12GraphicsCommandList* pCmdList, ID3D12Resource* outT
 
         // Render
         if (MenuDxBase::RenderMenu())
-            ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), pCmdList);
+            ImGui_ImplDX12_RenderDrawData(MenuCommon::DrawData(), pCmdList);
 
         outBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
         outBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
@@ -172,7 +175,7 @@ bool Menu_Dx12::Render(ID3D12GraphicsCommandList* pCmdList, ID3D12Resource* outT
     // Render to buffer
     if (MenuDxBase::RenderMenu())
     {
-        ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), pCmdList);
+        ImGui_ImplDX12_RenderDrawData(MenuCommon::DrawData(), pCmdList);
 
         outBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_SOURCE;
         outBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_DEST;
@@ -8,18 +8,15 @@
 
 #include <imgui/imgui_impl_win32.h>
 
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::Menu
+
 bool MenuDxBase::RenderMenu()
 {
     if (Config::Instance()->OverlayMenu.value_or_default())
         return false;
 
-    if (MenuCommon::RenderMenu())
-    {
-        ImGui::Render();
-        return true;
-    }
-
-    return false;
+    return MenuCommon::RenderMenu();
 }
 
 bool MenuDxBase::IsHandleDifferent()
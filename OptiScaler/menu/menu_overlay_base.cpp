@@ -5,6 +5,9 @@
 #include <Logger.h>
 #include <resource.h>
 
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::Menu
+
 // #include "imgui/imgui.h"
 // #include "imgui/imgui_impl_win32.h"
 
@@ -37,6 +40,8 @@ bool MenuOverlayBase::RenderMenu()
     return MenuCommon::RenderMenu();
 }
 
+ImDrawData* MenuOverlayBase::DrawData() { return MenuCommon::DrawData(); }
+
 void MenuOverlayBase::Shutdown() { MenuCommon::Shutdown(); }
 
 void MenuOverlayBase::HideMenu() { MenuCommon::HideMenu(); }
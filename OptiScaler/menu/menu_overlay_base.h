@@ -5,6 +5,8 @@
 #include <d3d12.h>
 #include <dxgi1_6.h>
 
+struct ImDrawData;
+
 class MenuOverlayBase
 {
   public:
@@ -19,6 +21,7 @@ class MenuOverlayBase
 
     static void Init(HWND InHandle, bool isUWP);
     static bool RenderMenu();
+    static ImDrawData* DrawData();
     static void Shutdown();
     static void HideMenu();
 };
@@ -9,6 +9,9 @@
 #include <imgui/imgui_impl_dx12.h>
 #include <imgui/imgui_impl_win32.h>
 
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::Menu
+
 // menu
 static int const NUM_BACK_BUFFERS = 8;
 static int const SRV_HEAP_SIZE = 64;
@@ -275,10 +278,8 @@ static void RenderImGui_DX11(IDXGISwapChain* pSwapChain)
 
             if (MenuOverlayBase::RenderMenu())
             {
-                ImGui::Render();
-
                 g_pd3dDeviceContext->OMSetRenderTargets(1, &g_pd3dRenderTarget, NULL);
-                ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+                ImGui_ImplDX11_RenderDrawData(MenuOverlayBase::DrawData());
             }
         }
     }
@@ -463,8 +464,6 @@ static void RenderImGui_DX12(IDXGISwapChain* pSwapChainPlain)
 
             if (MenuOverlayBase::RenderMenu())
             {
-                ImGui::Render();
-
                 UINT backBufferIdx = pSwapChain->GetCurrentBackBufferIndex();
                 ID3D12CommandAllocator* commandAllocator = g_commandAllocators[backBufferIdx];
 
@@ -497,7 +496,7 @@ static void RenderImGui_DX12(IDXGISwapChain* pSwapChainPlain)
                 g_pd3dCommandList->OMSetRenderTargets(1, &g_mainRenderTargetDescriptor[backBufferIdx], FALSE, NULL);
                 g_pd3dCommandList->SetDescriptorHeaps(1, &g_pd3dSrvDescHeap);
 
-                ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), g_pd3dCommandList);
+                ImGui_ImplDX12_RenderDrawData(MenuOverlayBase::DrawData(), g_pd3dCommandList);
 
                 barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
                 barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
@@ -7,6 +7,9 @@
 #include <imgui/imgui_impl_vulkan.h>
 #include <imgui/imgui_impl_win32.h>
 
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::Menu
+
 // Vulkan overlay code adopted from here:
 // https://gist.github.com/mem99/0ec31ca302927457f86b1d6756aaa8c4
 // Need to check resize & recreate fixes
@@ -506,8 +509,7 @@ bool MenuOverlayVk::QueuePresent(VkQueue queue, VkPresentInfoKHR* pPresentInfo)
                     vkCmdBeginRenderPass(fd->CommandBuffer, &info, VK_SUBPASS_CONTENTS_INLINE);
                 }
 
-                ImGui::Render();
-                ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), fd->CommandBuffer);
+                ImGui_ImplVulkan_RenderDrawData(MenuOverlayBase::DrawData(), fd->CommandBuffer);
 
                 // Submit command buffer
                 vkCmdEndRenderPass(fd->CommandBuffer);
@@ -542,11 +544,6 @@ bool MenuOverlayVk::QueuePresent(VkQueue queue, VkPresentInfoKHR* pPresentInfo)
                 pPresentInfo->waitSemaphoreCount = pPresentInfo->swapchainCount;
                 pPresentInfo->pWaitSemaphores = &_ImVulkan_Semaphores[semaphoreIndex];
             }
-            else
-            {
-                // To make RenderMenu happy as it expects this
-                ImGui::Render();
-            }
         }
     }
 
@@ -0,0 +1,120 @@
+#include "BarrierBatch_Dx12.h"
+
+#include <Config.h>
+
+BarrierBatch_Dx12::BarrierBatch_Dx12(ID3D12GraphicsCommandList* cmdList) : _cmdList(cmdList) { _pending.reserve(8); }
+
+BarrierBatch_Dx12::~BarrierBatch_Dx12() { Flush(); }
+
+void BarrierBatch_Dx12::Transition(ID3D12Resource* resource, D3D12_RESOURCE_STATES before,
+                                   D3D12_RESOURCE_STATES after)
+{
+    Record(_pending, { resource, before, after });
+}
+
+void BarrierBatch_Dx12::Flush()
+{
+    if (_pending.empty())
+        return;
+
+    if (_cmdList == nullptr)
+    {
+        LOG_WARN("{} pending barriers without a command list, dropping them", _pending.size());
+        _pending.clear();
+        return;
+    }
+
+    if (Config::Instance()->UseEnhancedBarriers.value_or_default() && FlushEnhanced())
+    {
+        _pending.clear();
+        return;
+    }
+
+    D3D12_RESOURCE_BARRIER barriers[16];
+    UINT count = 0;
+
+    for (const auto& transition : _pending)
+    {
+        auto& barrier = barriers[count++];
+        barrier = {};
+        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barrier.Transition.pResource = transition.resource;
+        barrier.Transition.StateBefore = transition.before;
+        barrier.Transition.StateAfter = transition.after;
+        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+
+        if (count == std::size(barriers))
+        {
+            _cmdList->ResourceBarrier(count, barriers);
+            count = 0;
+        }
+    }
+
+    if (count > 0)
+        _cmdList->ResourceBarrier(count, barriers);
+
+    _pending.clear();
+}
+
+void BarrierBatch_Dx12::CheckEnhancedBarrierSupport(ID3D12GraphicsCommandList* cmdList)
+{
+    ID3D12Device* device = nullptr;
+    if (cmdList->GetDevice(IID_PPV_ARGS(&device)) != S_OK || device == nullptr)
+        return;
+
+    D3D12_FEATURE_DATA_D3D12_OPTIONS12 options12 {};
+    if (device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS12, &options12, sizeof(options12)) == S_OK)
+        _enhancedSupported = options12.EnhancedBarriersSupported;
+
+    device->Release();
+
+    LOG_INFO("Enhanced barriers supported: {}", _enhancedSupported.load());
+}
+
+bool BarrierBatch_Dx12::FlushEnhanced()
+{
+    std::call_once(_enhancedChecked, CheckEnhancedBarrierSupport, _cmdList);
+
+    if (!_enhancedSupported)
+        return false;
+
+    D3D12_TEXTURE_BARRIER barriers[16] {};
+    UINT count = 0;
+
+    // Only plain texture transitions with an exact layout equivalent are translated,
+    // anything else makes the whole batch fall back to legacy barriers
+    if (_pending.size() > std::size(barriers))
+        return false;
+
+    for (const auto& transition : _pending)
+    {
+        if (transition.resource->GetDesc().Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+            return false;
+
+        auto& barrier = barriers[count++];
+
+        if (!MapLegacyState(transition.before, &barrier.SyncBefore, &barrier.AccessBefore, &barrier.LayoutBefore) ||
+            !MapLegacyState(transition.after, &barrier.SyncAfter, &barrier.AccessAfter, &barrier.LayoutAfter))
+        {
+            return false;
+        }
+
+        barrier.pResource = transition.resource;
+        barrier.Subresources.IndexOrFirstMipLevel = 0xffffffff;
+        barrier.Flags = D3D12_TEXTURE_BARRIER_FLAG_NONE;
+    }
+
+    ID3D12GraphicsCommandList7* cmdList7 = nullptr;
+    if (_cmdList->QueryInterface(IID_PPV_ARGS(&cmdList7)) != S_OK || cmdList7 == nullptr)
+        return false;
+
+    D3D12_BARRIER_GROUP group {};
+    group.Type = D3D12_BARRIER_TYPE_TEXTURE;
+    group.NumBarriers = count;
+    group.pTextureBarriers = barriers;
+
+    cmdList7->Barrier(1, &group);
+    cmdList7->Release();
+
+    return true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <pch.h>
+
+#include <d3d12.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+// Collects resource transitions recorded on a single command list and submits
+// them with one ResourceBarrier call at the next dispatch/copy boundary.
+// Chained transitions (A -> B, B -> C) are merged into A -> C and round trips
+// (A -> B, B -> A) recorded between two flushes are dropped completely.
+// Anything still pending is flushed when the batch goes out of scope.
+class BarrierBatch_Dx12
+{
+  public:
+    struct PendingTransition
+    {
+        ID3D12Resource* resource = nullptr;
+        D3D12_RESOURCE_STATES before = D3D12_RESOURCE_STATE_COMMON;
+        D3D12_RESOURCE_STATES after = D3D12_RESOURCE_STATE_COMMON;
+    };
+
+    enum class RecordResult
+    {
+        Dropped,   // before == after, nothing to do
+        Added,     // new pending transition
+        Merged,    // chained onto a pending transition of the same resource
+        Cancelled, // undid a pending transition, both are gone
+    };
+
+  private:
+    ID3D12GraphicsCommandList* _cmdList = nullptr;
+    std::vector<PendingTransition> _pending;
+
+    // Batches are recorded from any thread the game records lists on
+    inline static std::once_flag _enhancedChecked;
+    inline static std::atomic<bool> _enhancedSupported = false;
+
+    bool FlushEnhanced();
+    static void CheckEnhancedBarrierSupport(ID3D12GraphicsCommandList* cmdList);
+
+  public:
+    // Pure state machine for the pending list, kept static so it can be driven with fake resource handles
+    static RecordResult Record(std::vector<PendingTransition>& pending, const PendingTransition& transition);
+
+    // Translates a legacy state to enhanced barrier sync/access/layout, false if there is no exact equivalent
+    static bool MapLegacyState(D3D12_RESOURCE_STATES state, D3D12_BARRIER_SYNC* sync, D3D12_BARRIER_ACCESS* access,
+                               D3D12_BARRIER_LAYOUT* layout);
+
+    // State to read a resource as readState in. A resource already in a combined read state that covers it,
+    // like a copy source in GENERIC_READ, stays as is and its transition and restore are both dropped.
+    static D3D12_RESOURCE_STATES ReadState(D3D12_RESOURCE_STATES state, D3D12_RESOURCE_STATES readState);
+
+    void Transition(ID3D12Resource* resource, D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after);
+    void Flush();
+
+    size_t PendingCount() const { return _pending.size(); }
+    ID3D12GraphicsCommandList* CommandList() const { return _cmdList; }
+
+    BarrierBatch_Dx12(ID3D12GraphicsCommandList* cmdList = nullptr);
+    ~BarrierBatch_Dx12();
+
+    BarrierBatch_Dx12(const BarrierBatch_Dx12&) = delete;
+    BarrierBatch_Dx12& operator=(const BarrierBatch_Dx12&) = delete;
+};
@@ -0,0 +1,113 @@
+#include "BarrierBatch_Dx12.h"
+
+BarrierBatch_Dx12::RecordResult BarrierBatch_Dx12::Record(std::vector<PendingTransition>& pending,
+                                                          const PendingTransition& transition)
+{
+    if (transition.before == transition.after || transition.resource == nullptr)
+        return RecordResult::Dropped;
+
+    // Search backwards, the newest pending transition of a resource is the one we can chain onto
+    for (size_t i = pending.size(); i > 0; i--)
+    {
+        auto& existing = pending[i - 1];
+
+        if (existing.resource != transition.resource)
+            continue;
+
+        // Caller disagrees about the current state, keep both so behaviour matches unbatched recording
+        if (existing.after != transition.before)
+            break;
+
+        existing.after = transition.after;
+
+        if (existing.before == existing.after)
+        {
+            pending.erase(pending.begin() + (i - 1));
+            return RecordResult::Cancelled;
+        }
+
+        return RecordResult::Merged;
+    }
+
+    pending.push_back(transition);
+    return RecordResult::Added;
+}
+
+D3D12_RESOURCE_STATES BarrierBatch_Dx12::ReadState(D3D12_RESOURCE_STATES state, D3D12_RESOURCE_STATES readState)
+{
+    // Write states never combine with others, any read bit means a read only state
+    if (readState != D3D12_RESOURCE_STATE_COMMON && (state & readState) == readState)
+        return state;
+
+    return readState;
+}
+
+bool BarrierBatch_Dx12::MapLegacyState(D3D12_RESOURCE_STATES state, D3D12_BARRIER_SYNC* sync,
+                                       D3D12_BARRIER_ACCESS* access, D3D12_BARRIER_LAYOUT* layout)
+{
+    switch (state)
+    {
+    case D3D12_RESOURCE_STATE_COMMON:
+        *sync = D3D12_BARRIER_SYNC_ALL;
+        *access = D3D12_BARRIER_ACCESS_COMMON;
+        *layout = D3D12_BARRIER_LAYOUT_COMMON;
+        return true;
+
+    case D3D12_RESOURCE_STATE_RENDER_TARGET:
+        *sync = D3D12_BARRIER_SYNC_RENDER_TARGET;
+        *access = D3D12_BARRIER_ACCESS_RENDER_TARGET;
+        *layout = D3D12_BARRIER_LAYOUT_RENDER_TARGET;
+        return true;
+
+    case D3D12_RESOURCE_STATE_UNORDERED_ACCESS:
+        *sync = D3D12_BARRIER_SYNC_ALL_SHADING;
+        *access = D3D12_BARRIER_ACCESS_UNORDERED_ACCESS;
+        *layout = D3D12_BARRIER_LAYOUT_UNORDERED_ACCESS;
+        return true;
+
+    case D3D12_RESOURCE_STATE_DEPTH_WRITE:
+        *sync = D3D12_BARRIER_SYNC_DEPTH_STENCIL;
+        *access = D3D12_BARRIER_ACCESS_DEPTH_STENCIL_WRITE;
+        *layout = D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_WRITE;
+        return true;
+
+    case D3D12_RESOURCE_STATE_DEPTH_READ:
+        *sync = D3D12_BARRIER_SYNC_DEPTH_STENCIL;
+        *access = D3D12_BARRIER_ACCESS_DEPTH_STENCIL_READ;
+        *layout = D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_READ;
+        return true;
+
+    case D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE:
+        *sync = D3D12_BARRIER_SYNC_NON_PIXEL_SHADING;
+        *access = D3D12_BARRIER_ACCESS_SHADER_RESOURCE;
+        *layout = D3D12_BARRIER_LAYOUT_SHADER_RESOURCE;
+        return true;
+
+    case D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE:
+        *sync = D3D12_BARRIER_SYNC_PIXEL_SHADING;
+        *access = D3D12_BARRIER_ACCESS_SHADER_RESOURCE;
+        *layout = D3D12_BARRIER_LAYOUT_SHADER_RESOURCE;
+        return true;
+
+    case D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE:
+        *sync = D3D12_BARRIER_SYNC_ALL_SHADING;
+        *access = D3D12_BARRIER_ACCESS_SHADER_RESOURCE;
+        *layout = D3D12_BARRIER_LAYOUT_SHADER_RESOURCE;
+        return true;
+
+    case D3D12_RESOURCE_STATE_COPY_SOURCE:
+        *sync = D3D12_BARRIER_SYNC_COPY;
+        *access = D3D12_BARRIER_ACCESS_COPY_SOURCE;
+        *layout = D3D12_BARRIER_LAYOUT_COPY_SOURCE;
+        return true;
+
+    case D3D12_RESOURCE_STATE_COPY_DEST:
+        *sync = D3D12_BARRIER_SYNC_COPY;
+        *access = D3D12_BARRIER_ACCESS_COPY_DEST;
+        *layout = D3D12_BARRIER_LAYOUT_COPY_DEST;
+        return true;
+
+    default:
+        return false;
+    }
+}
@@ -0,0 +1,141 @@
+#include "CommandListSlots_Dx12.h"
+
+// {5B0F1D2A-8C3E-4E61-9A57-3D2B6C1E7F40}
+static const GUID SlotsGuid = { 0x5b0f1d2a, 0x8c3e, 0x4e61, { 0x9a, 0x57, 0x3d, 0x2b, 0x6c, 0x1e, 0x7f, 0x40 } };
+
+// Private data of a command list, the runtime releases it with the list
+class CommandListEntry_Dx12 final : public IUnknown
+{
+    std::atomic<ULONG> _refCount = 1;
+
+  public:
+    uint32_t index = CommandListSlots_Dx12::AcquireIndex();
+    CommandListSlots_Dx12::Slots slots {};
+
+    ~CommandListEntry_Dx12() { CommandListSlots_Dx12::ReleaseIndex(index); }
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override
+    {
+        if (ppvObject == nullptr)
+            return E_POINTER;
+
+        if (riid == __uuidof(IUnknown))
+        {
+            AddRef();
+            *ppvObject = this;
+            return S_OK;
+        }
+
+        *ppvObject = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() override { return ++_refCount; }
+
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        auto count = --_refCount;
+
+        if (count == 0)
+        {
+            CommandListSlots_Dx12::_generation.fetch_add(1, std::memory_order_release);
+            delete this;
+        }
+
+        return count;
+    }
+};
+
+uint32_t CommandListSlots_Dx12::AcquireIndex()
+{
+    std::scoped_lock lock(_indexMutex);
+
+    _liveCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (!_freeIndexes.empty())
+    {
+        auto index = _freeIndexes.back();
+        _freeIndexes.pop_back();
+        return index;
+    }
+
+    return _nextIndex++;
+}
+
+void CommandListSlots_Dx12::ReleaseIndex(uint32_t index)
+{
+    std::scoped_lock lock(_indexMutex);
+
+    _liveCount.fetch_sub(1, std::memory_order_relaxed);
+    _freeIndexes.push_back(index);
+}
+
+static CommandListEntry_Dx12* GetEntry(ID3D12GraphicsCommandList* list, bool create)
+{
+    IUnknown* data = nullptr;
+    UINT size = sizeof(data);
+
+    if (list->GetPrivateData(SlotsGuid, &size, &data) == S_OK && data != nullptr)
+    {
+        // Only set here, the list keeps its own reference
+        auto entry = static_cast<CommandListEntry_Dx12*>(data);
+        data->Release();
+        return entry;
+    }
+
+    if (!create)
+        return nullptr;
+
+    auto entry = new CommandListEntry_Dx12();
+    auto result = list->SetPrivateDataInterface(SlotsGuid, entry);
+    entry->Release();
+
+    if (result != S_OK)
+    {
+        LOG_WARN("SetPrivateDataInterface error: {:X}", (UINT) result);
+        return nullptr;
+    }
+
+    LOG_DEBUG("CommandList: {:X}, index: {}", (size_t) list, entry->index);
+
+    return entry;
+}
+
+CommandListSlots_Dx12::Slots* CommandListSlots_Dx12::GetSlots(ID3D12GraphicsCommandList* list, bool create)
+{
+    // A list is recorded on one thread at a time and the calls come in long runs for the same list
+    thread_local ID3D12GraphicsCommandList* cachedList = nullptr;
+    thread_local CommandListEntry_Dx12* cachedEntry = nullptr;
+    thread_local uint64_t cachedGeneration = 0;
+
+    if (list == nullptr)
+        return nullptr;
+
+    auto generation = _generation.load(std::memory_order_acquire);
+
+    if (list == cachedList && generation == cachedGeneration)
+        return &cachedEntry->slots;
+
+    auto entry = GetEntry(list, create);
+
+    // Not cached when missing, a later Get can still create it
+    if (entry == nullptr)
+        return nullptr;
+
+    cachedList = list;
+    cachedEntry = entry;
+    cachedGeneration = _generation.load(std::memory_order_acquire);
+
+    return &entry->slots;
+}
+
+uint32_t CommandListSlots_Dx12::Index(ID3D12GraphicsCommandList* list)
+{
+    if (list == nullptr)
+        return UINT32_MAX;
+
+    auto entry = GetEntry(list, false);
+    return entry != nullptr ? entry->index : UINT32_MAX;
+}
+
+uint32_t CommandListSlots_Dx12::LiveCount() { return _liveCount.load(std::memory_order_relaxed); }
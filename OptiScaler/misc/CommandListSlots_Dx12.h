@@ -0,0 +1,85 @@
+#pragma once
+#include <pch.h>
+
+#include <d3d12.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Subsystems with state attached to game command lists, one slot each
+enum class CommandListSlot : uint8_t
+{
+    StateShadow,
+    PossibleHudless,
+
+    Count
+};
+
+// Base of the per list state, deleted together with the command list
+struct CommandListSlotData
+{
+    virtual ~CommandListSlotData() = default;
+};
+
+// Per list storage for the command list hooks. The storage is attached to the list as
+// private data on first use, so it is released with the list and released lists don't
+// leave entries behind. Lookups go through a per thread cache and take no locks, slots
+// are only touched by the thread recording the list like the list itself.
+class CommandListSlots_Dx12
+{
+  public:
+    // Slot of the list, created with T's default constructor on first use. Null when the
+    // storage couldn't be attached.
+    template <typename T> static T* Get(ID3D12GraphicsCommandList* list, CommandListSlot slot)
+    {
+        auto slots = GetSlots(list, true);
+
+        if (slots == nullptr)
+            return nullptr;
+
+        auto& data = (*slots)[static_cast<size_t>(slot)];
+
+        if (data == nullptr)
+            data = std::make_unique<T>();
+
+        return static_cast<T*>(data.get());
+    }
+
+    // Slot of the list if it was created before, doesn't attach anything
+    template <typename T> static T* Find(ID3D12GraphicsCommandList* list, CommandListSlot slot)
+    {
+        auto slots = GetSlots(list, false);
+
+        if (slots == nullptr)
+            return nullptr;
+
+        return static_cast<T*>((*slots)[static_cast<size_t>(slot)].get());
+    }
+
+    // Small index of the list, reused after the list is released. UINT32_MAX when not attached.
+    static uint32_t Index(ID3D12GraphicsCommandList* list);
+
+    // Lists with attached storage
+    static uint32_t LiveCount();
+
+  private:
+    using Slots = std::array<std::unique_ptr<CommandListSlotData>, static_cast<size_t>(CommandListSlot::Count)>;
+
+    // Bumped when any storage is released, invalidates the per thread lookup caches
+    inline static std::atomic<uint64_t> _generation = 1;
+
+    inline static std::mutex _indexMutex;
+    inline static std::vector<uint32_t> _freeIndexes;
+    inline static uint32_t _nextIndex = 0;
+    inline static std::atomic<uint32_t> _liveCount = 0;
+
+    static Slots* GetSlots(ID3D12GraphicsCommandList* list, bool create);
+
+    static uint32_t AcquireIndex();
+    static void ReleaseIndex(uint32_t index);
+
+    friend class CommandListEntry_Dx12;
+};
@@ -0,0 +1,169 @@
+#include "DrsController.h"
+
+#include <cmath>
+
+// Ratio spread the fit needs, less than this is mostly noise
+static constexpr double MinVariance = 1e-5;
+
+// Share of the frame time which must scale with resolution before the ratio is changed for it
+static constexpr double MinScalableShare = 0.1;
+
+// Difference between the fit and the measured frame time which drops the fit
+static constexpr double WorkloadChange = 0.15;
+
+DrsController::DrsController(const DrsControllerSettings& settings, float initialRatio)
+{
+    Configure(settings);
+    Reset(initialRatio);
+}
+
+void DrsController::Configure(const DrsControllerSettings& settings)
+{
+    _settings = settings;
+
+    if (_settings.maxRatio < _settings.minRatio)
+        _settings.maxRatio = _settings.minRatio;
+
+    _ratio = std::clamp(_ratio, _settings.minRatio, _settings.maxRatio);
+}
+
+void DrsController::Reset(float ratio)
+{
+    _ratio = std::clamp(ratio, _settings.minRatio, _settings.maxRatio);
+    _frameMs = 0.0;
+    _upscalerMs = 0.0;
+    _sinceChangeMs = 0.0;
+    _hasSample = false;
+    _fixedMs = 0.0;
+    _scalableMs = 0.0;
+
+    ResetFit();
+}
+
+void DrsController::ResetFit()
+{
+    _sumWeight = 0.0;
+    _sumX = 0.0;
+    _sumY = 0.0;
+    _sumXX = 0.0;
+    _sumXY = 0.0;
+}
+
+float DrsController::Update(double frameMs, double upscalerMs, double elapsedMs, float renderRatio)
+{
+    if (frameMs <= 0.0 || _settings.targetMs <= 0.0)
+        return _ratio;
+
+    if (!_hasSample)
+    {
+        _frameMs = frameMs;
+        _upscalerMs = std::max(upscalerMs, 0.0);
+        _hasSample = true;
+    }
+    else
+    {
+        _frameMs += (frameMs - _frameMs) * _settings.smoothing;
+        _upscalerMs += (std::max(upscalerMs, 0.0) - _upscalerMs) * _settings.smoothing;
+    }
+
+    // Credit must still reach a minimum step when the rate limit is set low
+    auto maxCreditMs = MaxRateCreditMs;
+
+    if (_settings.maxRatePerSecond > 0.0f)
+        maxCreditMs = std::max(maxCreditMs, 1000.0 * _settings.minStep / _settings.maxRatePerSecond);
+
+    _sinceChangeMs = std::min(_sinceChangeMs + elapsedMs, maxCreditMs);
+
+    auto ratio = renderRatio > 0.0f ? renderRatio : _ratio;
+    double pixels = 1.0 / (static_cast<double>(ratio) * ratio);
+
+    _sumWeight = _sumWeight * Forgetting + 1.0;
+    _sumX = _sumX * Forgetting + pixels;
+    _sumY = _sumY * Forgetting + frameMs;
+    _sumXX = _sumXX * Forgetting + pixels * pixels;
+    _sumXY = _sumXY * Forgetting + pixels * frameMs;
+
+    auto variance = _sumWeight * _sumXX - _sumX * _sumX;
+    bool fitted = false;
+
+    if (variance > MinVariance * _sumWeight * _sumWeight)
+    {
+        // More pixels can't be faster, a negative slope is noise around zero
+        _scalableMs = std::max((_sumWeight * _sumXY - _sumX * _sumY) / variance, 0.0);
+        _fixedMs = (_sumY - _scalableMs * _sumX) / _sumWeight;
+        fitted = true;
+
+        // Fit doesn't explain the current frames anymore, the scene changed under it
+        if (std::abs(_frameMs - (_fixedMs + _scalableMs * pixels)) > WorkloadChange * _frameMs)
+        {
+            ResetFit();
+            fitted = false;
+        }
+    }
+
+    if (!fitted)
+    {
+        _fixedMs = std::min(_upscalerMs, _frameMs);
+        _scalableMs = (_frameMs - _fixedMs) / pixels;
+    }
+
+    auto error = (_frameMs - _settings.targetMs) / _settings.targetMs;
+
+    if (std::abs(error) <= _settings.hysteresis)
+        return _ratio;
+
+    float difference = 0.0f;
+
+    // Frame is bound by something else (CPU, sync) when resolution is a small part of it
+    bool insensitive = _scalableMs <= 1e-3 || (fitted && _scalableMs * pixels < MinScalableShare * _frameMs);
+
+    if (insensitive)
+    {
+        // Resolution doesn't change the frame time, only spend headroom. The model can't tell how far
+        // that is safe so it goes one step at a time and the fit sees each of them
+        if (error > 0.0)
+            return _ratio;
+
+        difference = std::max(_settings.minRatio - _ratio, -_settings.minStep);
+
+        if (difference == 0.0f)
+            return _ratio;
+    }
+    else
+    {
+        float desired = _ratio;
+        auto targetPixels = (_settings.targetMs - _fixedMs) / _scalableMs;
+
+        if (targetPixels <= 0.0)
+            desired = _settings.maxRatio;
+        else
+            desired = static_cast<float>(1.0 / std::sqrt(targetPixels));
+
+        // Fixed cost can eat the budget, then the model asks for more than the limits allow
+        desired = std::clamp(desired, _settings.minRatio, _settings.maxRatio);
+
+        // Going further in the wrong direction would only be model error
+        if ((error > 0.0 && desired < _ratio) || (error < 0.0 && desired > _ratio))
+            return _ratio;
+
+        difference = desired - _ratio;
+
+        // Last bit to a limit is allowed to be smaller, the ratio would stop short of it otherwise
+        bool toLimit = desired == _settings.minRatio || desired == _settings.maxRatio;
+
+        if (std::abs(difference) < _settings.minStep && !toLimit)
+            return _ratio;
+    }
+
+    // Steps are at least minStep and together not faster than the rate limit
+    auto allowed = static_cast<float>(_settings.maxRatePerSecond * _sinceChangeMs / 1000.0);
+
+    if (allowed < std::min(_settings.minStep, std::abs(difference)))
+        return _ratio;
+
+    _ratio += std::clamp(difference, -allowed, allowed);
+    _ratio = std::clamp(_ratio, _settings.minRatio, _settings.maxRatio);
+    _sinceChangeMs = 0.0;
+
+    return _ratio;
+}
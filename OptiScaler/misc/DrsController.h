@@ -0,0 +1,63 @@
+#pragma once
+#include <pch.h>
+
+struct DrsControllerSettings
+{
+    double targetMs = 16.667;
+    float minRatio = 1.0f; // Upscale ratio, display / render
+    float maxRatio = 2.0f;
+    double hysteresis = 0.05;       // Frame time error ignored, relative to the target
+    float minStep = 0.02f;          // Smaller ratio changes are skipped
+    float maxRatePerSecond = 0.25f; // Ratio change allowed per second
+    double smoothing = 0.1;         // Weight of the new frame time in the average
+};
+
+// Picks the upscale ratio which meets a frame time budget. Frame time is modeled as
+// fixed + scalable * renderPixels, the two costs are fitted from the measured frames
+// over the ratios which were used. Until the ratio moved enough for a fit, the upscaler
+// time is taken as the fixed cost. Has no clock of its own, can be driven by a simulation.
+class DrsController
+{
+    DrsControllerSettings _settings {};
+    float _ratio = 1.5f;
+
+    double _frameMs = 0.0;
+    double _upscalerMs = 0.0;
+    double _sinceChangeMs = 0.0;
+    bool _hasSample = false;
+
+    // Weighted sums for the fit, x is render pixels relative to display pixels
+    double _sumWeight = 0.0;
+    double _sumX = 0.0;
+    double _sumY = 0.0;
+    double _sumXX = 0.0;
+    double _sumXY = 0.0;
+
+    double _fixedMs = 0.0;
+    double _scalableMs = 0.0;
+
+    void ResetFit();
+
+  public:
+    static constexpr double Forgetting = 0.995;
+
+    // Rate limit credit kept while the ratio holds, a long steady stretch doesn't allow a jump
+    static constexpr double MaxRateCreditMs = 250.0;
+
+    DrsController() = default;
+    DrsController(const DrsControllerSettings& settings, float initialRatio);
+
+    // Settings can change while running, ratio is clamped to the new limits
+    void Configure(const DrsControllerSettings& settings);
+    void Reset(float ratio);
+
+    // Feeds one frame and returns the ratio for the next one. renderRatio is the ratio the frame
+    // was actually rendered at when known, the game may not follow the requested one right away
+    float Update(double frameMs, double upscalerMs, double elapsedMs, float renderRatio = 0.0f);
+
+    float Ratio() const { return _ratio; }
+    const DrsControllerSettings& Settings() const { return _settings; }
+    double AverageFrameTime() const { return _frameMs; }
+    double FixedCost() const { return _fixedMs; }
+    double ScalableCost() const { return _scalableMs; } // At display resolution
+};
@@ -0,0 +1,152 @@
+#include "DynamicResolution.h"
+
+#include <Config.h>
+#include <State.h>
+#include <Util.h>
+
+#include <upscalers/IFeature.h>
+
+// Upscaler timestamps stopped coming, the present interval is used until they are back
+static constexpr double GpuSampleTimeoutMs = 500.0;
+
+DrsControllerSettings DynamicResolution::CurrentSettings()
+{
+    auto config = Config::Instance();
+    DrsControllerSettings settings {};
+
+    settings.targetMs = config->DrsTargetFrameTime.value_or_default();
+
+    // Upscalers go down to 1/3 of display, supersampling only with extended limits
+    float lowest = config->ExtendedLimits.value_or_default() ? 0.5f : 1.0f;
+    float highest = 3.0f;
+
+    // DLSS DRS range is half to full display resolution
+    if (auto feature = State::Instance().currentFeature; feature != nullptr && feature->Name().starts_with("DLSS") &&
+                                                         !config->ExtendedLimits.value_or_default())
+    {
+        highest = 2.0f;
+    }
+
+    settings.minRatio = std::clamp(config->DrsControllerMinRatio.value_or_default(), lowest, highest);
+    settings.maxRatio = std::clamp(config->DrsControllerMaxRatio.value_or_default(), settings.minRatio, highest);
+
+    return settings;
+}
+
+void DynamicResolution::OnGpuFrame(double frameMs, double upscalerMs)
+{
+    _gpuFrameMs = frameMs;
+    _gpuUpscalerMs = upscalerMs;
+    _gpuFrames++;
+}
+
+void DynamicResolution::Feed(double frameMs, double upscalerMs, double now)
+{
+    auto elapsedMs = _lastUpdateMs > 0.0 ? now - _lastUpdateMs : frameMs;
+    _lastUpdateMs = now;
+
+    // The fit needs the size the game rendered at, it may still be on an older ratio
+    float renderRatio = 0.0f;
+
+    if (auto feature = State::Instance().currentFeature;
+        feature != nullptr && feature->RenderWidth() > 0 && feature->DisplayWidth() > 0)
+    {
+        renderRatio = static_cast<float>(feature->DisplayWidth()) / feature->RenderWidth();
+    }
+
+    auto before = _controller.Ratio();
+    auto ratio = _controller.Update(frameMs, upscalerMs, elapsedMs, renderRatio);
+
+    if (ratio != before)
+    {
+        LOG_DEBUG("Ratio {:.3f} -> {:.3f}, frame: {:.2f} ms, fixed: {:.2f} ms, scalable: {:.2f} ms", before, ratio,
+                  _controller.AverageFrameTime(), _controller.FixedCost(), _controller.ScalableCost());
+    }
+}
+
+void DynamicResolution::OnPresent()
+{
+    auto now = Util::MillisecondsNow();
+
+    if (!Config::Instance()->DrsControllerEnabled.value_or_default())
+    {
+        if (_running)
+        {
+            LOG_INFO("Dynamic resolution controller stopped");
+            _running = false;
+            _ratio.store(0.0f, std::memory_order_relaxed);
+            _minRatio.store(0.0f, std::memory_order_relaxed);
+            _maxRatio.store(0.0f, std::memory_order_relaxed);
+        }
+
+        _lastPresentMs = 0.0;
+        _usedGpuFrames = _gpuFrames;
+        return;
+    }
+
+    auto settings = CurrentSettings();
+
+    if (!_running)
+    {
+        // Start from the quality the user picked when there is one
+        auto initial = Config::Instance()->UpscaleRatioOverrideEnabled.value_or_default()
+                           ? Config::Instance()->UpscaleRatioOverrideValue.value_or_default()
+                           : 1.5f;
+
+        _controller.Configure(settings);
+        _controller.Reset(initial);
+        _running = true;
+        _lastUpdateMs = 0.0;
+        _lastGpuFrameMs = now;
+        _usedGpuFrames = _gpuFrames;
+
+        LOG_INFO("Dynamic resolution controller started, target: {:.2f} ms, ratio: {:.2f} - {:.2f}",
+                 settings.targetMs, settings.minRatio, settings.maxRatio);
+    }
+    else
+    {
+        _controller.Configure(settings);
+    }
+
+    if (_gpuFrames != _usedGpuFrames)
+    {
+        // One sample per upscaled frame, generated frames don't add any
+        _usedGpuFrames = _gpuFrames;
+        _lastGpuFrameMs = now;
+        Feed(_gpuFrameMs, _gpuUpscalerMs, now);
+    }
+    else if (_lastPresentMs > 0.0 && now - _lastGpuFrameMs > GpuSampleTimeoutMs)
+    {
+        auto frameMs = now - _lastPresentMs;
+        auto& upscaleTimes = State::Instance().upscaleTimes;
+        auto upscalerMs = upscaleTimes.empty() ? 0.0 : upscaleTimes.back();
+
+        Feed(frameMs, upscalerMs, now);
+    }
+
+    _lastPresentMs = now;
+    _ratio.store(_controller.Ratio(), std::memory_order_relaxed);
+    _minRatio.store(_controller.Settings().minRatio, std::memory_order_relaxed);
+    _maxRatio.store(_controller.Settings().maxRatio, std::memory_order_relaxed);
+}
+
+std::optional<float> DynamicResolution::Ratio()
+{
+    auto ratio = _ratio.load(std::memory_order_relaxed);
+
+    if (ratio <= 0.0f)
+        return std::nullopt;
+
+    return ratio;
+}
+
+std::optional<std::pair<float, float>> DynamicResolution::RatioRange()
+{
+    auto minRatio = _minRatio.load(std::memory_order_relaxed);
+    auto maxRatio = _maxRatio.load(std::memory_order_relaxed);
+
+    if (minRatio <= 0.0f || maxRatio <= 0.0f)
+        return std::nullopt;
+
+    return std::make_pair(minRatio, maxRatio);
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <pch.h>
+
+#include "DrsController.h"
+
+#include <atomic>
+#include <optional>
+
+// Runs the controller from the present hooks and hands its ratio to the ratio override paths.
+// Frames are measured with the upscaler GPU timestamps, present intervals also count generated
+// frames and CPU pacing. They are only used when the path has no upscaler timing.
+class DynamicResolution
+{
+    inline static DrsController _controller {};
+    inline static double _lastPresentMs = 0.0;
+    inline static double _lastUpdateMs = 0.0;
+    inline static double _lastGpuFrameMs = 0.0;
+    inline static bool _running = false;
+    inline static std::atomic<float> _ratio = 0.0f;
+    inline static std::atomic<float> _minRatio = 0.0f;
+    inline static std::atomic<float> _maxRatio = 0.0f;
+
+    // Written by the upscaler timers on the present thread before OnPresent
+    inline static double _gpuFrameMs = 0.0;
+    inline static double _gpuUpscalerMs = 0.0;
+    inline static uint64_t _gpuFrames = 0;
+    inline static uint64_t _usedGpuFrames = 0;
+
+    static DrsControllerSettings CurrentSettings();
+    static void Feed(double frameMs, double upscalerMs, double now);
+
+  public:
+    // Time between the ends of two consecutive upscales on the GPU clock and the upscale itself
+    static void OnGpuFrame(double frameMs, double upscalerMs);
+
+    static void OnPresent();
+
+    // Ratio to use instead of the quality mode ratio, empty when the controller is off
+    static std::optional<float> Ratio();
+    static bool IsActive() { return _ratio.load(std::memory_order_relaxed) > 0.0f; }
+
+    // Limits of the controller as min, max ratio. DLSS games which pick their own size inside the
+    // DRS range get these, the optimal size is only read by the ones querying every frame
+    static std::optional<std::pair<float, float>> RatioRange();
+
+    static const DrsController& Controller() { return _controller; }
+};
@@ -0,0 +1,310 @@
+#include "GpuInventory.h"
+
+#include <Util.h>
+#include <proxies/KernelBase_Proxy.h>
+#include <proxies/Ntdll_Proxy.h>
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+
+typedef decltype(&D3DKMTQueryAdapterInfo) PFN_D3DKMTQueryAdapterInfo;
+typedef decltype(&D3DKMTEnumAdapters) PFN_D3DKMTEnumAdapters;
+typedef decltype(&D3DKMTCloseAdapter) PFN_D3DKMTCloseAdapter;
+
+static constexpr std::string_view CacheHeader = "OptiScaler gpu cache 1";
+
+template <typename T> static bool ParseNumber(std::string_view text, T& value)
+{
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+static std::string DriverVersionString(uint64_t version)
+{
+    return std::format("{}.{}.{}.{}", (version >> 48) & 0xFFFF, (version >> 32) & 0xFFFF, (version >> 16) & 0xFFFF,
+                       version & 0xFFFF);
+}
+
+std::filesystem::path GpuInventory::CachePath() { return Util::DllPath().parent_path() / L"OptiScaler.gpu.cache"; }
+
+// vendorId|deviceId|driverVersion|dedicatedVideoMemory|driverStore|description
+// in enumeration order, used only when the same adapters run the same drivers
+bool GpuInventory::LoadCache(std::span<const GpuRecord> current, std::vector<GpuRecord>& gpus)
+{
+    std::ifstream file(CachePath());
+
+    if (!file.is_open())
+        return false;
+
+    std::string line;
+
+    if (!std::getline(file, line) || line != CacheHeader)
+        return false;
+
+    std::vector<GpuRecord> cached;
+
+    while (std::getline(file, line))
+    {
+        std::string_view fields[6];
+        std::string_view rest = line;
+
+        // Description is last and taken as is
+        for (size_t i = 0; i < 5; i++)
+        {
+            auto separator = rest.find('|');
+
+            if (separator == std::string_view::npos)
+                return false;
+
+            fields[i] = rest.substr(0, separator);
+            rest.remove_prefix(separator + 1);
+        }
+
+        fields[5] = rest;
+
+        GpuRecord gpu;
+
+        if (!ParseNumber(fields[0], gpu.vendorId) || !ParseNumber(fields[1], gpu.deviceId) ||
+            !ParseNumber(fields[2], gpu.driverVersion) || !ParseNumber(fields[3], gpu.dedicatedVideoMemory))
+        {
+            return false;
+        }
+
+        gpu.driverStore = string_to_wstring(std::string(fields[4]));
+        gpu.description = string_to_wstring(std::string(fields[5]));
+        cached.push_back(std::move(gpu));
+    }
+
+    if (!GpuRules::MatchesCache(cached, current))
+        return false;
+
+    gpus = std::move(cached);
+    return true;
+}
+
+void GpuInventory::SaveCache(std::span<const GpuRecord> gpus)
+{
+    auto path = CachePath();
+    auto tempPath = path;
+    tempPath += L".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::out | std::ios::trunc);
+
+        if (!file.is_open())
+        {
+            LOG_WARN("Can't open {} for writing", wstring_to_string(tempPath.wstring()));
+            return;
+        }
+
+        file << CacheHeader << "\n";
+
+        for (const auto& gpu : gpus)
+        {
+            file << std::format("{}|{}|{}|{}|{}|{}\n", gpu.vendorId, gpu.deviceId, gpu.driverVersion,
+                                gpu.dedicatedVideoMemory, wstring_to_string(gpu.driverStore.wstring()),
+                                wstring_to_string(gpu.description));
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+
+    if (ec)
+        LOG_WARN("Can't replace {}: {}", wstring_to_string(path.wstring()), ec.message());
+}
+
+std::vector<GpuRecord> GpuInventory::Enumerate(HMODULE hGdi32)
+{
+    std::vector<GpuRecord> gpus;
+
+    do
+    {
+        auto o_D3DKMTEnumAdapters =
+            (PFN_D3DKMTEnumAdapters) KernelBaseProxy::GetProcAddress_()(hGdi32, "D3DKMTEnumAdapters");
+        auto o_D3DKMTQueryAdapterInfo =
+            (PFN_D3DKMTQueryAdapterInfo) KernelBaseProxy::GetProcAddress_()(hGdi32, "D3DKMTQueryAdapterInfo");
+        auto o_D3DKMTCloseAdapter =
+            (PFN_D3DKMTCloseAdapter) KernelBaseProxy::GetProcAddress_()(hGdi32, "D3DKMTCloseAdapter");
+
+        if (o_D3DKMTEnumAdapters == nullptr || o_D3DKMTQueryAdapterInfo == nullptr || o_D3DKMTCloseAdapter == nullptr)
+        {
+            LOG_ERROR("Failed to resolve D3DKMT functions");
+            break;
+        }
+
+        D3DKMT_ENUMADAPTERS enumAdapters = {};
+
+        if (o_D3DKMTEnumAdapters(&enumAdapters) != 0)
+        {
+            LOG_ERROR("Failed to enumerate adapters.");
+            break;
+        }
+
+        auto query = [&](D3DKMT_HANDLE adapter, KMTQUERYADAPTERINFOTYPE type, auto& data)
+        {
+            D3DKMT_QUERYADAPTERINFO queryAdapterInfo = {};
+            queryAdapterInfo.hAdapter = adapter;
+            queryAdapterInfo.Type = type;
+            queryAdapterInfo.pPrivateDriverData = &data;
+            queryAdapterInfo.PrivateDriverDataSize = sizeof(data);
+
+            auto result = o_D3DKMTQueryAdapterInfo(&queryAdapterInfo);
+
+            if (result != 0)
+                LOG_DEBUG("D3DKMTQueryAdapterInfo type {} error: {:X}", (UINT) type, (UINT) result);
+
+            return result == 0;
+        };
+
+        // Ids and driver versions decide if the cached records are still valid, LUIDs change every boot
+        std::vector<GpuRecord> current(enumAdapters.NumAdapters);
+
+        for (size_t i = 0; i < enumAdapters.NumAdapters; i++)
+        {
+            auto adapter = enumAdapters.Adapters[i].hAdapter;
+
+            D3DKMT_QUERY_DEVICE_IDS deviceIds = {};
+
+            if (query(adapter, KMTQAITYPE_PHYSICALADAPTERDEVICEIDS, deviceIds))
+            {
+                current[i].vendorId = deviceIds.DeviceIds.VendorID;
+                current[i].deviceId = deviceIds.DeviceIds.DeviceID;
+            }
+
+            D3DKMT_UMD_DRIVER_VERSION driverVersion = {};
+
+            if (query(adapter, KMTQAITYPE_UMD_DRIVER_VERSION, driverVersion))
+                current[i].driverVersion = driverVersion.DriverVersion.QuadPart;
+        }
+
+        if (LoadCache(current, gpus))
+        {
+            LOG_DEBUG("Using cached adapter records");
+        }
+        else
+        {
+            gpus = std::move(current);
+
+            for (size_t i = 0; i < enumAdapters.NumAdapters; i++)
+            {
+                auto adapter = enumAdapters.Adapters[i].hAdapter;
+                auto& gpu = gpus[i];
+
+                D3DKMT_ADAPTERREGISTRYINFO registryInfo = {};
+
+                if (query(adapter, KMTQAITYPE_ADAPTERREGISTRYINFO, registryInfo))
+                    gpu.description = registryInfo.AdapterString;
+
+                D3DKMT_SEGMENTSIZEINFO segmentSize = {};
+
+                if (query(adapter, KMTQAITYPE_GETSEGMENTSIZE, segmentSize))
+                    gpu.dedicatedVideoMemory = segmentSize.DedicatedVideoMemorySize;
+
+                D3DKMT_UMDFILENAMEINFO umdFileInfo = {};
+
+                if (query(adapter, KMTQAITYPE_UMDRIVERNAME, umdFileInfo))
+                    gpu.driverStore = std::filesystem::path(umdFileInfo.UmdFileName).parent_path();
+            }
+
+            // Only records a later launch can match
+            auto keysKnown = std::all_of(gpus.begin(), gpus.end(), GpuRules::HasCacheKey);
+
+            if (keysKnown && GpuRules::Evaluate(gpus).known)
+                SaveCache(gpus);
+        }
+
+        for (size_t i = 0; i < enumAdapters.NumAdapters; i++)
+        {
+            D3DKMT_CLOSEADAPTER closeAdapter = {};
+            closeAdapter.hAdapter = enumAdapters.Adapters[i].hAdapter;
+            auto closeResult = o_D3DKMTCloseAdapter(&closeAdapter);
+            if (closeResult != 0)
+                LOG_ERROR("D3DKMTCloseAdapter error: {:X}", closeResult);
+        }
+
+    } while (false);
+
+    return gpus;
+}
+
+void GpuInventory::Load(bool mayLoadGdi32)
+{
+    std::scoped_lock lock(_mutex);
+
+    if (_ready)
+        return;
+
+    // Loading a library from DllMain can deadlock, D3DKMT waits for the worker if Gdi32 isn't there yet
+    bool libraryLoaded = false;
+    HMODULE hGdi32 = KernelBaseProxy::GetModuleHandleW_()(L"Gdi32.dll");
+
+    if (hGdi32 == nullptr)
+    {
+        if (!mayLoadGdi32)
+        {
+            if (!_deferred)
+                LOG_INFO("Gdi32.dll is not loaded yet, adapters are enumerated after startup");
+
+            _deferred = true;
+            return;
+        }
+
+        hGdi32 = NtdllProxy::LoadLibraryExW_Ldr(L"Gdi32.dll", NULL, 0);
+        libraryLoaded = hGdi32 != nullptr;
+    }
+
+    if (hGdi32 == nullptr)
+        LOG_ERROR("Failed to load Gdi32.dll");
+    else
+        _gpus = Enumerate(hGdi32);
+
+    if (libraryLoaded)
+        NtdllProxy::FreeLibrary_Ldr(hGdi32);
+
+    _capabilities = GpuRules::Evaluate(_gpus);
+    _ready = true;
+
+    for (const auto& gpu : _gpus)
+    {
+        if (gpu.vendorId == VendorId::Microsoft)
+            continue;
+
+        LOG_INFO("Adapter: {}, VRAM: {} MB, VendorId: {:#x}, DeviceId: {:#x}, Driver: {}",
+                 wstring_to_string(gpu.description), gpu.dedicatedVideoMemory / (1024 * 1024), gpu.vendorId,
+                 gpu.deviceId, DriverVersionString(gpu.driverVersion));
+    }
+
+    LOG_INFO("Known: {}, Nvidia: {}, Pascal or older: {}, FSR4 eligible: {}", _capabilities.known,
+             _capabilities.nvidiaPresent, _capabilities.pascalOrOlder, _capabilities.fsr4Eligible);
+}
+
+void GpuInventory::Init() { Load(false); }
+
+void GpuInventory::InitDeferred() { Load(true); }
+
+std::span<const GpuRecord> GpuInventory::Adapters()
+{
+    Init();
+    return _gpus;
+}
+
+GpuCapabilities GpuInventory::Capabilities()
+{
+    Init();
+    return _capabilities;
+}
+
+std::vector<std::filesystem::path> GpuInventory::DriverStores()
+{
+    std::vector<std::filesystem::path> result;
+
+    for (const auto& gpu : Adapters())
+    {
+        if (!gpu.driverStore.empty())
+            result.push_back(gpu.driverStore);
+    }
+
+    return result;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <pch.h>
+
+#include "GpuRules.h"
+
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <vector>
+
+// Adapters of the system, enumerated once through D3DKMT without creating a DXGI factory
+// so it is safe under the loader lock. Records are kept next to OptiScaler keyed by the
+// device ids and driver versions, a launch with the same adapters only asks for those.
+class GpuInventory
+{
+    inline static std::mutex _mutex;
+    inline static bool _ready = false;
+    inline static bool _deferred = false;
+    inline static std::vector<GpuRecord> _gpus;
+    inline static GpuCapabilities _capabilities;
+
+    static std::filesystem::path CachePath();
+    static bool LoadCache(std::span<const GpuRecord> current, std::vector<GpuRecord>& gpus);
+    static void SaveCache(std::span<const GpuRecord> gpus);
+    static std::vector<GpuRecord> Enumerate(HMODULE hGdi32);
+    static void Load(bool mayLoadGdi32);
+
+  public:
+    // Safe under the loader lock, waits for InitDeferred when Gdi32 isn't loaded yet
+    static void Init();
+
+    // Startup worker step, loads Gdi32 if Init had to skip it
+    static void InitDeferred();
+
+    // Empty when D3DKMT isn't usable, like on some Wine versions, or before it could be enumerated
+    static std::span<const GpuRecord> Adapters();
+    static GpuCapabilities Capabilities();
+
+    static std::vector<std::filesystem::path> DriverStores();
+};
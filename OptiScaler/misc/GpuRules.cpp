@@ -0,0 +1,74 @@
+#include "GpuRules.h"
+
+#include <algorithm>
+
+// Navi 48 and Navi 44, for adapters whose name doesn't give them away
+static constexpr uint32_t Rdna4DeviceIds[] = { 0x7550, 0x7551, 0x7590 };
+
+// GV100 starts here, every Nvidia device id below it is Pascal or older
+static constexpr uint32_t FirstVoltaDeviceId = 0x1D80;
+
+bool GpuRules::IsFsr4Eligible(const GpuRecord& gpu)
+{
+    if (gpu.vendorId != VendorId::AMD)
+        return false;
+
+    if (std::find(std::begin(Rdna4DeviceIds), std::end(Rdna4DeviceIds), gpu.deviceId) != std::end(Rdna4DeviceIds))
+        return true;
+
+    // RX 90XX on Windows, GFX12 on Linux
+    return gpu.description.find(L" 90") != std::wstring::npos ||
+           gpu.description.find(L" GFX12") != std::wstring::npos;
+}
+
+bool GpuRules::IsPascalOrOlder(const GpuRecord& gpu)
+{
+    return gpu.vendorId == VendorId::Nvidia && gpu.deviceId != 0 && gpu.deviceId < FirstVoltaDeviceId;
+}
+
+GpuCapabilities GpuRules::Evaluate(std::span<const GpuRecord> gpus)
+{
+    GpuCapabilities caps;
+    bool newerNvidia = false;
+
+    for (const auto& gpu : gpus)
+    {
+        if (gpu.vendorId == VendorId::Invalid || gpu.vendorId == VendorId::Microsoft)
+            continue;
+
+        caps.known = true;
+        caps.fsr4Eligible |= IsFsr4Eligible(gpu);
+
+        if (gpu.vendorId == VendorId::Nvidia)
+        {
+            caps.nvidiaPresent = true;
+            newerNvidia |= !IsPascalOrOlder(gpu);
+        }
+    }
+
+    caps.pascalOrOlder = caps.nvidiaPresent && !newerNvidia;
+
+    return caps;
+}
+
+bool GpuRules::HasCacheKey(const GpuRecord& gpu)
+{
+    return gpu.vendorId != VendorId::Invalid && gpu.deviceId != 0 && gpu.driverVersion != 0;
+}
+
+bool GpuRules::MatchesCache(std::span<const GpuRecord> cached, std::span<const GpuRecord> current)
+{
+    if (cached.size() != current.size())
+        return false;
+
+    for (size_t i = 0; i < current.size(); i++)
+    {
+        if (!HasCacheKey(current[i]) || cached[i].vendorId != current[i].vendorId ||
+            cached[i].deviceId != current[i].deviceId || cached[i].driverVersion != current[i].driverVersion)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
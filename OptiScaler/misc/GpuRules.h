@@ -0,0 +1,55 @@
+#pragma once
+#include <pch.h>
+
+#include <filesystem>
+#include <span>
+#include <string>
+
+// One adapter as enumerated by GpuInventory
+struct GpuRecord
+{
+    uint32_t vendorId = VendorId::Invalid;
+    uint32_t deviceId = 0;
+
+    // Same as IDXGIAdapter::CheckInterfaceSupport, 0 if unknown
+    uint64_t driverVersion = 0;
+    uint64_t dedicatedVideoMemory = 0;
+
+    std::wstring description;
+
+    // Folder of the user mode driver, empty if unknown
+    std::filesystem::path driverStore;
+};
+
+struct GpuCapabilities
+{
+    // At least one adapter with a known vendor, otherwise the rest is meaningless
+    bool known = false;
+
+    bool nvidiaPresent = false;
+
+    // Every Nvidia adapter is Pascal or older
+    bool pascalOrOlder = false;
+
+    // An RDNA4 adapter that can run FSR4 through amdxcffx64
+    bool fsr4Eligible = false;
+};
+
+// Capability rules over adapter records. Pure functions, nothing here queries the system.
+class GpuRules
+{
+  public:
+    static bool IsFsr4Eligible(const GpuRecord& gpu);
+
+    // Device ids below Volta, nvapi's arch info stays authoritative when the game asks for it
+    static bool IsPascalOrOlder(const GpuRecord& gpu);
+
+    // Software adapters are ignored
+    static GpuCapabilities Evaluate(std::span<const GpuRecord> gpus);
+
+    // Vendor, device id and driver version are all known
+    static bool HasCacheKey(const GpuRecord& gpu);
+
+    // Cached records are used only for the same adapters in the same order with the same drivers
+    static bool MatchesCache(std::span<const GpuRecord> cached, std::span<const GpuRecord> current);
+};
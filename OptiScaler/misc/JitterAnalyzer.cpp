@@ -0,0 +1,538 @@
+#include "JitterAnalyzer.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Offsets are compared in render pixels, float math of the games stays well below this
+static constexpr float PixelTolerance = 1e-4f;
+static constexpr float ZeroTolerance = 1e-7f;
+static constexpr float MatchThreshold = 0.9f;
+static constexpr uint32_t StallRun = 3;
+
+// Halton indices up to base^digits can be found from the value
+static constexpr uint32_t Base2Digits = 11; // 2048
+static constexpr uint32_t Base3Digits = 7;  // 2187
+
+// Roberts R2, 1 / g and 1 / g^2 of the plastic number
+static constexpr double R2AlphaX = 0.75487766624669276005;
+static constexpr double R2AlphaY = 0.56984029099805326591;
+
+static bool SameSample(const JitterSample& a, const JitterSample& b, float tolerance)
+{
+    return std::abs(a.x - b.x) <= tolerance && std::abs(a.y - b.y) <= tolerance;
+}
+
+// Distance on the unit circle, values are fractional parts
+static double WrappedDistance(double a, double b)
+{
+    auto diff = std::abs(a - b);
+    return std::min(diff, 1.0 - diff);
+}
+
+static double Fraction(double value) { return value - std::floor(value); }
+
+// Inverse of the radical inverse, -1 if the value isn't a Halton point
+static int32_t HaltonIndex(double value, uint32_t base, uint32_t digits)
+{
+    uint32_t scale = 1;
+    for (uint32_t i = 0; i < digits; i++)
+        scale *= base;
+
+    auto scaled = value * scale;
+    auto rounded = std::round(scaled);
+
+    if (rounded < 0.0 || rounded >= scale || std::abs(scaled - rounded) > PixelTolerance * scale)
+        return -1;
+
+    auto remaining = static_cast<uint32_t>(rounded);
+    uint32_t index = 0;
+
+    // Digits of the value are the reversed digits of the index
+    for (uint32_t i = 0; i < digits; i++)
+    {
+        index = index * base + remaining % base;
+        remaining /= base;
+    }
+
+    return static_cast<int32_t>(index);
+}
+
+static uint32_t FindPeriod(const std::vector<JitterSample>& points, float tolerance, float* matchRatio)
+{
+    auto count = static_cast<uint32_t>(points.size());
+
+    for (uint32_t period = 2; period <= count / 2; period++)
+    {
+        uint32_t matches = 0;
+
+        for (uint32_t i = 0; i + period < count; i++)
+        {
+            if (SameSample(points[i], points[i + period], tolerance))
+                matches++;
+        }
+
+        auto ratio = static_cast<float>(matches) / (count - period);
+
+        if (ratio >= MatchThreshold)
+        {
+            *matchRatio = ratio;
+            return period;
+        }
+    }
+
+    *matchRatio = 0.0f;
+    return 0;
+}
+
+static JitterUnit DetectUnit(float maxX, float maxY, uint32_t renderWidth, uint32_t renderHeight,
+                             uint32_t displayWidth, float* scaleX, float* scaleY)
+{
+    constexpr float halfPixel = 0.5f + PixelTolerance;
+
+    // Halton and R2 reach at least a quarter pixel with the minimum sample count
+    if (maxX <= halfPixel && maxY <= halfPixel && std::max(maxX, maxY) >= 0.05f)
+    {
+        *scaleX = 1.0f;
+        *scaleY = 1.0f;
+        return JitterUnit::Pixels;
+    }
+
+    auto pixelsX = maxX * renderWidth;
+    auto pixelsY = maxY * renderHeight;
+
+    if (pixelsX <= halfPixel && pixelsY <= halfPixel)
+    {
+        *scaleX = static_cast<float>(renderWidth);
+        *scaleY = static_cast<float>(renderHeight);
+        return JitterUnit::Uv;
+    }
+
+    if (pixelsX <= halfPixel * 2.0f && pixelsY <= halfPixel * 2.0f)
+    {
+        *scaleX = renderWidth * 0.5f;
+        *scaleY = renderHeight * 0.5f;
+        return JitterUnit::Ndc;
+    }
+
+    // Likely output pixels, checked against the sequences before it's trusted
+    if (displayWidth > renderWidth)
+    {
+        *scaleX = static_cast<float>(renderWidth) / displayWidth;
+        *scaleY = *scaleX;
+    }
+
+    return JitterUnit::OutOfRange;
+}
+
+struct SequenceMatch
+{
+    float ratio = 0.0f;
+    int8_t signX = 1;
+    int8_t signY = 1;
+    bool swapped = false;
+};
+
+static SequenceMatch MatchHalton(const std::vector<JitterSample>& points, std::vector<int32_t>& indices)
+{
+    SequenceMatch best {};
+    std::vector<int32_t> current(points.size());
+
+    for (int swapped = 0; swapped < 2; swapped++)
+    {
+        uint32_t baseX = swapped ? 3 : 2;
+        uint32_t baseY = swapped ? 2 : 3;
+        uint32_t digitsX = swapped ? Base3Digits : Base2Digits;
+        uint32_t digitsY = swapped ? Base2Digits : Base3Digits;
+
+        for (int8_t signX : { 1, -1 })
+        {
+            for (int8_t signY : { 1, -1 })
+            {
+                uint32_t matches = 0;
+
+                for (size_t i = 0; i < points.size(); i++)
+                {
+                    auto indexX = HaltonIndex(signX * points[i].x + 0.5, baseX, digitsX);
+                    auto indexY = HaltonIndex(signY * points[i].y + 0.5, baseY, digitsY);
+
+                    // Both axes use the same index
+                    current[i] = (indexX >= 0 && indexX == indexY) ? indexX : -1;
+
+                    if (current[i] >= 0)
+                        matches++;
+                }
+
+                auto ratio = static_cast<float>(matches) / points.size();
+
+                if (ratio > best.ratio)
+                {
+                    best = { ratio, signX, signY, swapped != 0 };
+                    indices = current;
+                }
+            }
+        }
+    }
+
+    return best;
+}
+
+static SequenceMatch MatchR2(const std::vector<JitterSample>& points, std::vector<bool>& continuous)
+{
+    SequenceMatch best {};
+
+    if (points.size() < 2)
+        return best;
+
+    auto pairs = points.size() - 1;
+    std::vector<bool> current(pairs);
+
+    for (int swapped = 0; swapped < 2; swapped++)
+    {
+        auto alphaX = swapped ? R2AlphaY : R2AlphaX;
+        auto alphaY = swapped ? R2AlphaX : R2AlphaY;
+
+        for (int8_t signX : { 1, -1 })
+        {
+            for (int8_t signY : { 1, -1 })
+            {
+                // Negated axis steps by 1 - alpha
+                auto stepX = signX > 0 ? alphaX : 1.0 - alphaX;
+                auto stepY = signY > 0 ? alphaY : 1.0 - alphaY;
+                uint32_t matches = 0;
+
+                for (size_t i = 0; i < pairs; i++)
+                {
+                    auto deltaX = Fraction(static_cast<double>(points[i + 1].x) - points[i].x);
+                    auto deltaY = Fraction(static_cast<double>(points[i + 1].y) - points[i].y);
+
+                    current[i] = WrappedDistance(deltaX, stepX) <= PixelTolerance * 2.0 &&
+                                 WrappedDistance(deltaY, stepY) <= PixelTolerance * 2.0;
+
+                    if (current[i])
+                        matches++;
+                }
+
+                auto ratio = static_cast<float>(matches) / pairs;
+
+                if (ratio > best.ratio)
+                {
+                    best = { ratio, signX, signY, swapped != 0 };
+                    continuous = current;
+                }
+            }
+        }
+    }
+
+    return best;
+}
+
+float JitterAnalyzer::Halton(uint32_t index, uint32_t base)
+{
+    float fraction = 1.0f;
+    float result = 0.0f;
+
+    while (index > 0)
+    {
+        fraction /= base;
+        result += fraction * (index % base);
+        index /= base;
+    }
+
+    return result;
+}
+
+JitterReport JitterAnalyzer::Analyze(std::span<const JitterSample> samples, uint32_t renderWidth,
+                                     uint32_t renderHeight, uint32_t displayWidth)
+{
+    JitterReport report {};
+    report.samples = static_cast<uint32_t>(samples.size());
+
+    if (displayWidth > 0 && renderWidth > 0)
+    {
+        auto ratio = static_cast<double>(displayWidth) / renderWidth;
+        report.expectedPhases = static_cast<uint32_t>(std::ceil(8.0 * ratio * ratio));
+    }
+
+    if (samples.size() < MinSamples || renderWidth == 0 || renderHeight == 0)
+        return report;
+
+    float maxX = 0.0f;
+    float maxY = 0.0f;
+
+    for (const auto& sample : samples)
+    {
+        maxX = std::max(maxX, std::abs(sample.x));
+        maxY = std::max(maxY, std::abs(sample.y));
+    }
+
+    if (maxX <= ZeroTolerance && maxY <= ZeroTolerance)
+    {
+        report.sequence = JitterSequence::None;
+        return report;
+    }
+
+    float scaleX = 0.0f;
+    float scaleY = 0.0f;
+    report.unit = DetectUnit(maxX, maxY, renderWidth, renderHeight, displayWidth, &scaleX, &scaleY);
+
+    // Unknown scale is compared in its own units
+    float tolerance = scaleX > 0.0f ? PixelTolerance : std::max(maxX, maxY) * 2.0f * PixelTolerance;
+
+    // Stalls, same offset as the frame before
+    std::vector<JitterSample> points;
+    std::vector<uint32_t> positions;
+    uint32_t run = 0;
+
+    for (uint32_t i = 0; i < samples.size(); i++)
+    {
+        JitterSample point = samples[i];
+
+        if (scaleX > 0.0f)
+        {
+            point.x *= scaleX;
+            point.y *= scaleY;
+        }
+
+        if (!points.empty() && SameSample(points.back(), point, tolerance))
+        {
+            report.stalledFrames++;
+            run++;
+            continue;
+        }
+
+        run = 0;
+        points.push_back(point);
+        positions.push_back(i);
+    }
+
+    report.stalled = run >= StallRun;
+
+    if (points.size() < MinSamples)
+        return report;
+
+    float periodRatio = 0.0f;
+    report.period = FindPeriod(points, tolerance, &periodRatio);
+
+    if (scaleX > 0.0f)
+    {
+        std::vector<int32_t> indices;
+        auto halton = MatchHalton(points, indices);
+
+        if (halton.ratio >= MatchThreshold)
+        {
+            report.sequence = JitterSequence::Halton;
+            report.matchRatio = halton.ratio;
+            report.signX = halton.signX;
+            report.signY = halton.signY;
+            report.swappedAxes = halton.swapped;
+
+            // Cycle wraps from its last index back to the start, other backward steps are restarts
+            int32_t start = INT32_MAX;
+            for (auto index : indices)
+            {
+                if (index >= 0)
+                    start = std::min(start, index);
+            }
+
+            report.haltonStart = static_cast<uint32_t>(start);
+
+            // Restarts break the repeat check, the index the cycle most often ends at is the period then
+            int32_t cycleEnd = -1;
+
+            if (report.period > 0)
+            {
+                cycleEnd = start + static_cast<int32_t>(report.period) - 1;
+            }
+            else
+            {
+                std::vector<int32_t> ends;
+
+                for (size_t i = 1; i < indices.size(); i++)
+                {
+                    if (indices[i - 1] >= 0 && indices[i] == start)
+                        ends.push_back(indices[i - 1]);
+                }
+
+                uint32_t bestCount = 1;
+
+                for (auto end : ends)
+                {
+                    auto count = static_cast<uint32_t>(std::ranges::count(ends, end));
+
+                    if (count > bestCount || (count == bestCount && end > cycleEnd && count > 1))
+                    {
+                        bestCount = count;
+                        cycleEnd = end;
+                    }
+                }
+
+                if (cycleEnd >= start)
+                    report.period = static_cast<uint32_t>(cycleEnd - start + 1);
+            }
+
+            for (size_t i = 1; i < indices.size(); i++)
+            {
+                if (indices[i - 1] < 0 || indices[i] < 0 || indices[i] > indices[i - 1])
+                    continue;
+
+                if (indices[i - 1] == cycleEnd && indices[i] == start)
+                    continue;
+
+                report.restarts++;
+                report.lastRestart = static_cast<int32_t>(positions[i]);
+            }
+        }
+        else
+        {
+            std::vector<bool> continuous;
+            auto r2 = MatchR2(points, continuous);
+
+            if (r2.ratio >= MatchThreshold)
+            {
+                report.sequence = JitterSequence::R2;
+                report.matchRatio = r2.ratio;
+                report.signX = r2.signX;
+                report.signY = r2.signY;
+                report.swappedAxes = r2.swapped;
+
+                // Breaks a period apart are the sequence wrapping
+                int32_t lastBreak = -1;
+
+                for (size_t i = 0; i < continuous.size(); i++)
+                {
+                    if (continuous[i])
+                        continue;
+
+                    auto position = static_cast<int32_t>(i + 1);
+                    bool wrap = report.period > 0 && lastBreak >= 0 &&
+                                static_cast<uint32_t>(position - lastBreak) == report.period;
+                    bool firstWrap = report.period > 0 && lastBreak < 0;
+
+                    if (!wrap && !firstWrap)
+                    {
+                        report.restarts++;
+                        report.lastRestart = static_cast<int32_t>(positions[position]);
+                    }
+
+                    lastBreak = position;
+                }
+            }
+        }
+    }
+
+    if (report.sequence == JitterSequence::Unknown && report.period > 0)
+    {
+        report.sequence = JitterSequence::Periodic;
+        report.matchRatio = periodRatio;
+    }
+
+    // Output pixel guess is only trusted when a known sequence confirms it
+    bool recognized = report.sequence == JitterSequence::Halton || report.sequence == JitterSequence::R2;
+
+    if (report.unit != JitterUnit::OutOfRange || recognized)
+    {
+        report.scaleX = scaleX;
+        report.scaleY = scaleY;
+    }
+
+    return report;
+}
+
+const char* JitterAnalyzer::SequenceName(JitterSequence sequence)
+{
+    switch (sequence)
+    {
+    case JitterSequence::None:
+        return "None";
+    case JitterSequence::Halton:
+        return "Halton";
+    case JitterSequence::R2:
+        return "R2";
+    case JitterSequence::Periodic:
+        return "Periodic";
+    default:
+        return "Unknown";
+    }
+}
+
+const char* JitterAnalyzer::UnitName(JitterUnit unit)
+{
+    switch (unit)
+    {
+    case JitterUnit::Pixels:
+        return "Pixels";
+    case JitterUnit::Uv:
+        return "UV";
+    case JitterUnit::Ndc:
+        return "NDC";
+    case JitterUnit::OutOfRange:
+        return "Out of range";
+    default:
+        return "Unknown";
+    }
+}
+
+bool JitterTracker::Add(float x, float y, uint32_t renderWidth, uint32_t renderHeight, uint32_t displayWidth)
+{
+    _samples[_next] = { x, y };
+    _next = (_next + 1) % HistorySize;
+    _count = std::min(_count + 1, HistorySize);
+    _sinceAnalyze++;
+
+    // First report early, then on every interval
+    if (_count < JitterAnalyzer::MinSamples * 4 || (_report.samples > 0 && _sinceAnalyze < AnalyzeInterval))
+        return false;
+
+    auto samples = Samples();
+    _report = JitterAnalyzer::Analyze(samples, renderWidth, renderHeight, displayWidth);
+    _sinceAnalyze = 0;
+
+    return true;
+}
+
+std::vector<JitterSample> JitterTracker::Samples() const
+{
+    std::vector<JitterSample> result;
+    result.reserve(_count);
+
+    auto first = (_next + HistorySize - _count) % HistorySize;
+
+    for (uint32_t i = 0; i < _count; i++)
+        result.push_back(_samples[(first + i) % HistorySize]);
+
+    return result;
+}
+
+JitterSample JitterTracker::Correct(float x, float y) const
+{
+    if (!_report.IsConfident() || _report.unit == JitterUnit::Pixels)
+        return { x, y };
+
+    return { x * _report.scaleX, y * _report.scaleY };
+}
+
+void JitterTracker::LogReport(std::string_view owner, const JitterReport& previous) const
+{
+    if (!_report.SameConvention(previous))
+    {
+        LOG_INFO("{}: {} jitter, unit: {}, phases: {} (expected {}), sign: {}/{}, swapped: {}, match: {:.2f}", owner,
+                 JitterAnalyzer::SequenceName(_report.sequence), JitterAnalyzer::UnitName(_report.unit),
+                 _report.period, _report.expectedPhases, _report.signX, _report.signY, _report.swappedAxes,
+                 _report.matchRatio);
+    }
+
+    if (_report.restarts > 0)
+        LOG_DEBUG("{}: jitter sequence restarted {} times, last at sample {}", owner, _report.restarts,
+                  _report.lastRestart);
+
+    if (_report.stalled)
+        LOG_DEBUG("{}: jitter is stalled", owner);
+}
+
+void JitterTracker::Reset()
+{
+    _next = 0;
+    _count = 0;
+    _sinceAnalyze = 0;
+    _report = {};
+}
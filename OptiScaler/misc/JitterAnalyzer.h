@@ -0,0 +1,118 @@
+#pragma once
+#include <pch.h>
+
+#include <array>
+#include <span>
+#include <string_view>
+#include <vector>
+
+enum class JitterSequence : uint8_t
+{
+    Unknown,  // Not enough samples or no pattern found
+    None,     // All offsets are zero
+    Halton,   // Halton with a shared index on both axes
+    R2,       // Roberts R2 additive recurrence
+    Periodic, // Repeats but isn't a known sequence
+};
+
+enum class JitterUnit : uint8_t
+{
+    Unknown,
+    Pixels,     // Render resolution pixels, [-0.5, 0.5]
+    Uv,         // Pixels divided by render size
+    Ndc,        // Pixels * 2 divided by render size
+    OutOfRange, // Bigger than half a render pixel, probably output resolution pixels
+};
+
+struct JitterSample
+{
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+struct JitterReport
+{
+    uint32_t samples = 0;
+    JitterSequence sequence = JitterSequence::Unknown;
+    JitterUnit unit = JitterUnit::Unknown;
+
+    // Multipliers which turn the offsets into render pixels, 0 when unit isn't known
+    float scaleX = 0.0f;
+    float scaleY = 0.0f;
+
+    // Relative to the reference sequence, -1 means the axis is negated
+    int8_t signX = 1;
+    int8_t signY = 1;
+    bool swappedAxes = false; // Halton 3,2 or R2 with swapped alphas
+
+    uint32_t period = 0;        // Phase count, 0 when the sequence doesn't repeat in the samples
+    uint32_t haltonStart = 0;   // First Halton index of the cycle, games use 0 or 1
+    float matchRatio = 0.0f;    // Share of samples which fit the detected sequence
+    uint32_t stalledFrames = 0; // Frames which repeated the previous offset
+    bool stalled = false;       // Last frames all have the same offset
+    uint32_t restarts = 0;      // Cycles which started over before reaching the period
+    int32_t lastRestart = -1;   // Sample index of the last restart
+
+    // Phases the upscaler wants for the current ratio, 8 * ratio^2 per DLSS guidance
+    uint32_t expectedPhases = 0;
+
+    // Recognized sequence with known unit, safe to rescale to pixels
+    bool IsConfident() const
+    {
+        return (sequence == JitterSequence::Halton || sequence == JitterSequence::R2) && scaleX > 0.0f &&
+               scaleY > 0.0f && matchRatio >= 0.9f;
+    }
+
+    // Same sequence, unit and orientation, only the counters differ
+    bool SameConvention(const JitterReport& other) const
+    {
+        return sequence == other.sequence && unit == other.unit && period == other.period && signX == other.signX &&
+               signY == other.signY && swappedAxes == other.swappedAxes;
+    }
+};
+
+// Finds the convention of a jitter offset stream. Analyze is a pure function over the
+// samples (oldest first), JitterTracker keeps the recent samples of a feature.
+class JitterAnalyzer
+{
+  public:
+    static constexpr uint32_t MinSamples = 8;
+
+    static JitterReport Analyze(std::span<const JitterSample> samples, uint32_t renderWidth, uint32_t renderHeight,
+                                uint32_t displayWidth = 0);
+
+    static float Halton(uint32_t index, uint32_t base);
+
+    static const char* SequenceName(JitterSequence sequence);
+    static const char* UnitName(JitterUnit unit);
+};
+
+class JitterTracker
+{
+  public:
+    static constexpr uint32_t HistorySize = 256;
+    static constexpr uint32_t AnalyzeInterval = 64;
+
+  private:
+    std::array<JitterSample, HistorySize> _samples {};
+    uint32_t _next = 0;
+    uint32_t _count = 0;
+    uint32_t _sinceAnalyze = 0;
+    JitterReport _report {};
+
+  public:
+    // Adds the sample, returns true when a new analysis was done
+    bool Add(float x, float y, uint32_t renderWidth, uint32_t renderHeight, uint32_t displayWidth);
+
+    // Samples oldest first
+    std::vector<JitterSample> Samples() const;
+
+    // Offset in render pixels when the report is confident about another unit, as is otherwise
+    JitterSample Correct(float x, float y) const;
+
+    // Logs the report of the last analysis when it differs from the previous one
+    void LogReport(std::string_view owner, const JitterReport& previous) const;
+
+    const JitterReport& Report() const { return _report; }
+    void Reset();
+};
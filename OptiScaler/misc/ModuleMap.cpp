@@ -0,0 +1,245 @@
+#include "ModuleMap.h"
+
+#include <proxies/Ntdll_Proxy.h>
+
+#include <psapi.h>
+#include <winternl.h>
+
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::Loader
+
+// Not in the SDK headers
+#define LDR_DLL_NOTIFICATION_REASON_LOADED 1
+#define LDR_DLL_NOTIFICATION_REASON_UNLOADED 2
+
+typedef struct _LDR_DLL_NOTIFICATION_DATA
+{
+    ULONG Flags;
+    PCUNICODE_STRING FullDllName;
+    PCUNICODE_STRING BaseDllName;
+    PVOID DllBase;
+    ULONG SizeOfImage;
+} LDR_DLL_NOTIFICATION_DATA, *PLDR_DLL_NOTIFICATION_DATA;
+
+typedef VOID(CALLBACK* PFN_LdrDllNotification)(ULONG NotificationReason, const void* NotificationData,
+                                               PVOID Context);
+typedef NTSTATUS(NTAPI* PFN_LdrRegisterDllNotification)(ULONG Flags, PFN_LdrDllNotification NotificationFunction,
+                                                        PVOID Context, PVOID* Cookie);
+typedef NTSTATUS(NTAPI* PFN_LdrUnregisterDllNotification)(PVOID Cookie);
+
+// Counts the reader in, snapshots aren't freed while any reader is counted
+class SnapshotReader
+{
+    std::atomic<uint32_t>& _readers;
+
+  public:
+    SnapshotReader(std::atomic<uint32_t>& readers) : _readers(readers) { _readers.fetch_add(1); }
+    ~SnapshotReader() { _readers.fetch_sub(1); }
+};
+
+uint32_t ModuleMap::OwnCategories(uintptr_t base)
+{
+    uint32_t categories = ModuleCategory_None;
+
+    if (base == (uintptr_t) dllModule)
+        categories |= ModuleCategory_Self;
+
+    if (base == (uintptr_t) exeModule)
+        categories |= ModuleCategory_Executable;
+
+    return categories;
+}
+
+void ModuleMap::Publish(Snapshot* snapshot)
+{
+    auto old = _current.exchange(snapshot);
+
+    if (old != nullptr)
+    {
+        old->nextRetired = _retired;
+        _retired = old;
+    }
+
+    FreeRetired();
+}
+
+void ModuleMap::FreeRetired()
+{
+    // A reader counted after this load will see the new snapshot, so with no reader
+    // in flight nothing can still point to a retired one. Otherwise try on next change.
+    if (_readers.load() != 0)
+        return;
+
+    while (_retired != nullptr)
+    {
+        auto next = _retired->nextRetired;
+        delete _retired;
+        _retired = next;
+    }
+}
+
+void CALLBACK ModuleMap::OnDllNotification(ULONG reason, const void* data, PVOID context)
+{
+    auto notification = (const LDR_DLL_NOTIFICATION_DATA*) data;
+
+    if (notification == nullptr || notification->DllBase == nullptr)
+        return;
+
+    auto base = (uintptr_t) notification->DllBase;
+
+    std::scoped_lock lock(_writeMutex);
+
+    auto current = _current.load();
+
+    if (current == nullptr)
+        return;
+
+    auto snapshot = new Snapshot { current->ranges };
+
+    if (reason == LDR_DLL_NOTIFICATION_REASON_LOADED)
+    {
+        std::wstring path;
+
+        if (notification->FullDllName != nullptr && notification->FullDllName->Buffer != nullptr)
+            path.assign(notification->FullDllName->Buffer, notification->FullDllName->Length / sizeof(wchar_t));
+
+        snapshot->ranges.Add(
+            ModuleRanges::Make(base, notification->SizeOfImage, wstring_to_string(path), OwnCategories(base)));
+    }
+    else if (reason != LDR_DLL_NOTIFICATION_REASON_UNLOADED || !snapshot->ranges.Remove(base))
+    {
+        delete snapshot;
+        return;
+    }
+
+    Publish(snapshot);
+}
+
+void ModuleMap::Init()
+{
+    if (_current.load() != nullptr || _cookie != nullptr)
+        return;
+
+    auto ntdll = NtdllProxy::Module();
+
+    if (ntdll == nullptr)
+        ntdll = GetModuleHandleW(L"ntdll.dll");
+
+    auto registerNotification =
+        (PFN_LdrRegisterDllNotification) GetProcAddress(ntdll, "LdrRegisterDllNotification");
+
+    // Runs under the loader lock, so no module can be loaded or unloaded between
+    // registering and publishing the enumerated snapshot
+    if (registerNotification == nullptr ||
+        registerNotification(0, (PFN_LdrDllNotification) OnDllNotification, nullptr, &_cookie) != 0)
+    {
+        LOG_WARN("Can't register for DLL notifications, module map disabled");
+        _cookie = nullptr;
+        return;
+    }
+
+    std::vector<HMODULE> modules(512);
+    DWORD needed = 0;
+
+    while (true)
+    {
+        auto size = (DWORD) (modules.size() * sizeof(HMODULE));
+
+        if (!K32EnumProcessModules(GetCurrentProcess(), modules.data(), size, &needed))
+        {
+            LOG_WARN("EnumProcessModules failed: {:X}", GetLastError());
+            needed = 0;
+            break;
+        }
+
+        if (needed <= size)
+            break;
+
+        modules.resize(needed / sizeof(HMODULE));
+    }
+
+    auto snapshot = new Snapshot {};
+    wchar_t path[MAX_PATH] {};
+
+    for (size_t i = 0; i < needed / sizeof(HMODULE); i++)
+    {
+        MODULEINFO info {};
+
+        if (!K32GetModuleInformation(GetCurrentProcess(), modules[i], &info, sizeof(info)))
+            continue;
+
+        auto length = GetModuleFileNameW(modules[i], path, MAX_PATH);
+
+        auto base = (uintptr_t) info.lpBaseOfDll;
+        snapshot->ranges.Add(ModuleRanges::Make(base, info.SizeOfImage,
+                                                wstring_to_string(std::wstring(path, length)), OwnCategories(base)));
+    }
+
+    LOG_INFO("{} modules mapped", snapshot->ranges.Size());
+
+    std::scoped_lock lock(_writeMutex);
+    Publish(snapshot);
+}
+
+void ModuleMap::Shutdown()
+{
+    std::scoped_lock lock(_writeMutex);
+
+    if (_cookie != nullptr)
+    {
+        auto ntdll = NtdllProxy::Module();
+
+        if (ntdll == nullptr)
+            ntdll = GetModuleHandleW(L"ntdll.dll");
+
+        auto unregisterNotification =
+            (PFN_LdrUnregisterDllNotification) GetProcAddress(ntdll, "LdrUnregisterDllNotification");
+
+        if (unregisterNotification != nullptr)
+            unregisterNotification(_cookie);
+
+        _cookie = nullptr;
+    }
+
+    // Lookups fall back to the slow path from now on
+    Publish(nullptr);
+}
+
+std::optional<ModuleRange> ModuleMap::Find(const void* address)
+{
+    SnapshotReader reader(_readers);
+
+    auto snapshot = _current.load();
+
+    if (snapshot == nullptr)
+        return std::nullopt;
+
+    if (auto range = snapshot->ranges.Find((uintptr_t) address); range != nullptr)
+        return *range;
+
+    return std::nullopt;
+}
+
+std::string_view ModuleMap::NameOf(const void* address)
+{
+    if (auto range = Find(address); range.has_value())
+        return range->name;
+
+    return {};
+}
+
+HMODULE ModuleMap::ModuleOf(const void* address)
+{
+    if (auto range = Find(address); range.has_value())
+        return (HMODULE) range->base;
+
+    return nullptr;
+}
+
+uint32_t ModuleMap::CategoriesOf(const void* address)
+{
+    if (auto range = Find(address); range.has_value())
+        return range->categories;
+
+    return ModuleCategory_None;
+}
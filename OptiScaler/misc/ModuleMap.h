@@ -0,0 +1,47 @@
+#pragma once
+#include <pch.h>
+
+#include "ModuleRanges.h"
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+
+// Address to module lookups without a syscall. Loaded modules are enumerated once and
+// kept current with loader notifications. Readers never lock, each change publishes a
+// new immutable snapshot and old ones are freed once no reader is inside one.
+class ModuleMap
+{
+    struct Snapshot
+    {
+        ModuleRanges ranges;
+        Snapshot* nextRetired = nullptr;
+    };
+
+    inline static std::atomic<Snapshot*> _current = nullptr;
+    inline static std::atomic<uint32_t> _readers = 0;
+
+    inline static std::mutex _writeMutex;
+    inline static Snapshot* _retired = nullptr;
+    inline static PVOID _cookie = nullptr;
+
+    static uint32_t OwnCategories(uintptr_t base);
+    static void Publish(Snapshot* snapshot);
+    static void FreeRetired();
+
+    static void CALLBACK OnDllNotification(ULONG reason, const void* data, PVOID context);
+
+  public:
+    // Safe under the loader lock
+    static void Init();
+    static void Shutdown();
+
+    static bool IsReady() { return _current.load() != nullptr; }
+
+    static std::optional<ModuleRange> Find(const void* address);
+
+    // Interned lowercase file name, empty if the address isn't in a module or the map isn't ready
+    static std::string_view NameOf(const void* address);
+    static HMODULE ModuleOf(const void* address);
+    static uint32_t CategoriesOf(const void* address);
+};
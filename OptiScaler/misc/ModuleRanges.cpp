@@ -0,0 +1,139 @@
+#include "ModuleRanges.h"
+
+#include <algorithm>
+
+static std::string ToLower(std::string_view text)
+{
+    std::string result(text);
+
+    for (auto& c : result)
+    {
+        if (c >= 'A' && c <= 'Z')
+            c = static_cast<char>(c - 'A' + 'a');
+    }
+
+    return result;
+}
+
+static bool StartsWith(std::string_view text, std::string_view prefix)
+{
+    return text.size() >= prefix.size() && text.substr(0, prefix.size()) == prefix;
+}
+
+static bool RangeBefore(const ModuleRange& range, uintptr_t address) { return range.end <= address; }
+
+// Lowercase file names
+static constexpr std::string_view OverlayNames[] = {
+    "gameoverlayrenderer64.dll", "rtsshooks64.dll", "discordhook64.dll", "overlay64.dll",
+    "eosovh-win64-shipping.dll", "nvspcap64.dll",   "reshade64.dll",
+};
+
+static constexpr std::string_view DriverNames[] = {
+    "nvwgf2umx.dll", "nvldumdx.dll", "nvoglv64.dll",    "nvapi64.dll",  "nvngx.dll",      "amdxc64.dll", "amdxx64.dll",
+    "amdvlk64.dll",  "atidxx64.dll", "igxelpicd64.dll", "igdext64.dll", "igd12umd64.dll", "igdml64.dll",
+};
+
+const char* ModuleRanges::Intern(std::string_view name)
+{
+    auto lower = ToLower(name);
+
+    std::scoped_lock lock(_internMutex);
+
+    // Few hundred modules per process, a linear search is enough
+    for (auto& interned : _interned)
+    {
+        if (interned == lower)
+            return interned.c_str();
+    }
+
+    return _interned.emplace_back(std::move(lower)).c_str();
+}
+
+uint32_t ModuleRanges::Categorize(std::string_view lowerPath)
+{
+    uint32_t categories = ModuleCategory_None;
+
+    auto separator = lowerPath.find_last_of("\\/");
+    auto name = separator == std::string_view::npos ? lowerPath : lowerPath.substr(separator + 1);
+
+    if (lowerPath.find("\\windows\\system32\\") != std::string_view::npos ||
+        lowerPath.find("\\windows\\syswow64\\") != std::string_view::npos ||
+        lowerPath.find("\\windows\\winsxs\\") != std::string_view::npos)
+    {
+        categories |= ModuleCategory_System;
+    }
+
+    // Drivers are installed to the driver store
+    if (lowerPath.find("\\driverstore\\") != std::string_view::npos ||
+        std::find(std::begin(DriverNames), std::end(DriverNames), name) != std::end(DriverNames) ||
+        StartsWith(name, "nvngx_") || StartsWith(name, "amdxcffx"))
+    {
+        categories |= ModuleCategory_Driver;
+    }
+
+    if (std::find(std::begin(OverlayNames), std::end(OverlayNames), name) != std::end(OverlayNames))
+        categories |= ModuleCategory_Overlay;
+
+    if (StartsWith(name, "sl."))
+        categories |= ModuleCategory_Streamline;
+
+    return categories;
+}
+
+ModuleRange ModuleRanges::Make(uintptr_t base, size_t size, std::string_view path, uint32_t categories)
+{
+    auto lowerPath = ToLower(path);
+    auto separator = lowerPath.find_last_of("\\/");
+    auto name = separator == std::string::npos ? std::string_view(lowerPath)
+                                               : std::string_view(lowerPath).substr(separator + 1);
+
+    ModuleRange range {};
+    range.base = base;
+    range.end = base + size;
+    range.name = Intern(name);
+    range.categories = categories | Categorize(lowerPath);
+
+    return range;
+}
+
+void ModuleRanges::Add(const ModuleRange& range)
+{
+    if (range.end <= range.base)
+        return;
+
+    auto first = std::lower_bound(_ranges.begin(), _ranges.end(), range.base, RangeBefore);
+    auto last = first;
+
+    while (last != _ranges.end() && last->base < range.end)
+        ++last;
+
+    if (first != last)
+    {
+        LOG_DEBUG("{} replaces {} stale ranges", range.name, std::distance(first, last));
+        first = _ranges.erase(first, last);
+    }
+
+    _ranges.insert(first, range);
+}
+
+bool ModuleRanges::Remove(uintptr_t base)
+{
+    auto it = std::lower_bound(_ranges.begin(), _ranges.end(), base, RangeBefore);
+
+    if (it == _ranges.end() || it->base != base)
+        return false;
+
+    _ranges.erase(it);
+    return true;
+}
+
+const ModuleRange* ModuleRanges::Find(uintptr_t address) const
+{
+    // First range ending after the address
+    auto it = std::lower_bound(_ranges.begin(), _ranges.end(), address, RangeBefore);
+
+    if (it == _ranges.end() || !it->Contains(address))
+        return nullptr;
+
+    return &*it;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <pch.h>
+
+#include <deque>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum ModuleCategory : uint32_t
+{
+    ModuleCategory_None = 0,
+    ModuleCategory_Self = 1 << 0,       // OptiScaler
+    ModuleCategory_Executable = 1 << 1, // Game exe
+    ModuleCategory_System = 1 << 2,     // Windows directory
+    ModuleCategory_Overlay = 1 << 3,    // Steam, RTSS, Discord etc.
+    ModuleCategory_Streamline = 1 << 4,
+    ModuleCategory_Driver = 1 << 5, // GPU vendor user mode drivers and their extensions
+};
+
+struct ModuleRange
+{
+    uintptr_t base = 0;
+    uintptr_t end = 0;     // Exclusive
+    const char* name = ""; // Interned lowercase file name, valid until the process ends
+    uint32_t categories = ModuleCategory_None;
+
+    bool Contains(uintptr_t address) const { return address >= base && address < end; }
+};
+
+// Sorted non overlapping module ranges, an address is found with a binary search.
+// Nothing here calls Windows, the map keeping it current lives in ModuleMap.
+class ModuleRanges
+{
+    std::vector<ModuleRange> _ranges;
+
+    inline static std::mutex _internMutex;
+    inline static std::deque<std::string> _interned;
+
+  public:
+    // Lowercase copy kept until the process ends
+    static const char* Intern(std::string_view name);
+
+    // Categories from the lowercase full path, self and executable are set by the caller
+    static uint32_t Categorize(std::string_view lowerPath);
+
+    // Builds a range from a full path, name and categories are filled from it
+    static ModuleRange Make(uintptr_t base, size_t size, std::string_view path, uint32_t categories = 0);
+
+    // Ranges overlapping the new one belong to modules whose unload was missed and are dropped
+    void Add(const ModuleRange& range);
+    bool Remove(uintptr_t base);
+
+    const ModuleRange* Find(uintptr_t address) const;
+
+    std::span<const ModuleRange> Ranges() const { return _ranges; }
+    size_t Size() const { return _ranges.size(); }
+};
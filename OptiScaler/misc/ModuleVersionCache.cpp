@@ -0,0 +1,363 @@
+#include "ModuleVersionCache.h"
+
+#include <Util.h>
+
+#include <charconv>
+#include <cwctype>
+#include <fstream>
+
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::Loader
+
+static constexpr std::string_view CacheHeader = "OptiScaler module cache 1";
+static constexpr std::string_view ExportPrefix = "export:";
+
+static std::wstring CacheKey(const std::filesystem::path& path)
+{
+    auto key = path.wstring();
+
+    for (auto& c : key)
+        c = static_cast<wchar_t>(std::towlower(c));
+
+    return key;
+}
+
+template <typename T> static bool ParseNumber(std::string_view text, T& value)
+{
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+static std::optional<PeVersion> ParseVersion(std::string_view text)
+{
+    PeVersion version;
+    uint16_t* parts[] = { &version.major, &version.minor, &version.patch, &version.build };
+
+    for (size_t i = 0; i < std::size(parts); i++)
+    {
+        auto dot = i + 1 < std::size(parts) ? text.find('.') : text.size();
+
+        if (dot == std::string_view::npos || !ParseNumber(text.substr(0, dot), *parts[i]))
+            return std::nullopt;
+
+        text.remove_prefix((std::min)(dot + 1, text.size()));
+    }
+
+    return version;
+}
+
+std::filesystem::path ModuleVersionCache::CachePath()
+{
+    return Util::DllPath().parent_path() / L"OptiScaler.modules.cache";
+}
+
+// size|writeTime|version|key=value,key=value|path
+// version is ? when it wasn't read yet and - when the file has none
+void ModuleVersionCache::Load()
+{
+    _loaded = true;
+
+    std::ifstream file(CachePath());
+
+    if (!file.is_open())
+        return;
+
+    std::string line;
+
+    if (!std::getline(file, line) || line != CacheHeader)
+    {
+        LOG_INFO("Module cache is from another version, ignoring it");
+        return;
+    }
+
+    while (std::getline(file, line))
+    {
+        std::string_view fields[5];
+        std::string_view rest = line;
+
+        // Path is last and taken as is
+        for (size_t i = 0; i < 4; i++)
+        {
+            auto separator = rest.find('|');
+
+            if (separator == std::string_view::npos)
+            {
+                rest = {};
+                break;
+            }
+
+            fields[i] = rest.substr(0, separator);
+            rest.remove_prefix(separator + 1);
+        }
+
+        fields[4] = rest;
+
+        Entry entry;
+
+        if (fields[4].empty() || !ParseNumber(fields[0], entry.size) || !ParseNumber(fields[1], entry.writeTime))
+            continue;
+
+        if (fields[2] != "?")
+        {
+            entry.versionRead = true;
+
+            if (fields[2] != "-")
+                entry.fileVersion = ParseVersion(fields[2]);
+        }
+
+        auto values = fields[3];
+
+        while (!values.empty())
+        {
+            auto comma = values.find(',');
+            auto pair = values.substr(0, comma);
+            auto equals = pair.find('=');
+            uint64_t value = 0;
+
+            if (equals != std::string_view::npos && ParseNumber(pair.substr(equals + 1), value))
+                entry.values.emplace(pair.substr(0, equals), value);
+
+            values.remove_prefix(comma == std::string_view::npos ? values.size() : comma + 1);
+        }
+
+        _entries.insert_or_assign(string_to_wstring(std::string(fields[4])), std::move(entry));
+    }
+
+    LOG_DEBUG("Loaded {} module cache entries", _entries.size());
+}
+
+void ModuleVersionCache::Save()
+{
+    auto path = CachePath();
+    auto tempPath = path;
+    tempPath += L".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::out | std::ios::trunc);
+
+        if (!file.is_open())
+        {
+            LOG_WARN("Can't open {} for writing", wstring_to_string(tempPath.wstring()));
+            return;
+        }
+
+        file << CacheHeader << "\n";
+
+        for (const auto& [key, entry] : _entries)
+        {
+            std::string version = "?";
+
+            if (entry.fileVersion.has_value())
+            {
+                const auto& v = entry.fileVersion.value();
+                version = std::format("{}.{}.{}.{}", v.major, v.minor, v.patch, v.build);
+            }
+            else if (entry.versionRead)
+            {
+                version = "-";
+            }
+
+            std::string values;
+
+            for (const auto& [name, value] : entry.values)
+                values += std::format("{}{}={}", values.empty() ? "" : ",", name, value);
+
+            file << std::format("{}|{}|{}|{}|{}\n", entry.size, entry.writeTime, version, values,
+                                wstring_to_string(key));
+        }
+    }
+
+    // Replaced at once so another process never reads half a file
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+
+    if (ec)
+        LOG_WARN("Can't replace {}: {}", wstring_to_string(path.wstring()), ec.message());
+}
+
+void ModuleVersionCache::MarkDirty()
+{
+    if (_startupDone)
+        Save();
+    else
+        _dirty = true;
+}
+
+void ModuleVersionCache::EndStartup()
+{
+    std::scoped_lock lock(_mutex);
+
+    _startupDone = true;
+
+    if (!_dirty)
+        return;
+
+    _dirty = false;
+    Save();
+}
+
+ModuleVersionCache::Entry* ModuleVersionCache::Get(const std::filesystem::path& path)
+{
+    if (!_loaded)
+        Load();
+
+    auto key = CacheKey(path);
+
+    WIN32_FILE_ATTRIBUTE_DATA attributes {};
+
+    if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &attributes))
+    {
+        _entries.erase(key);
+        return nullptr;
+    }
+
+    auto size = (static_cast<uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+    auto writeTime = (static_cast<uint64_t>(attributes.ftLastWriteTime.dwHighDateTime) << 32) |
+                     attributes.ftLastWriteTime.dwLowDateTime;
+
+    auto& entry = _entries[key];
+
+    if (entry.size != size || entry.writeTime != writeTime)
+    {
+        if (entry.size != 0)
+            LOG_DEBUG("{} changed, dropping its cache entry", wstring_to_string(path.wstring()));
+
+        entry = Entry {};
+        entry.size = size;
+        entry.writeTime = writeTime;
+    }
+
+    return &entry;
+}
+
+void ModuleVersionCache::Parse(const std::filesystem::path& path, Entry& entry)
+{
+    entry.parsed = true;
+    entry.versionRead = true;
+
+    auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        LOG_WARN("Can't open {}: {:X}", wstring_to_string(path.wstring()), GetLastError());
+        return;
+    }
+
+    // Size of the file that is mapped, it may have changed since Get
+    LARGE_INTEGER fileSize {};
+
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        LOG_WARN("Can't get the size of {}: {:X}", wstring_to_string(path.wstring()), GetLastError());
+        CloseHandle(file);
+        return;
+    }
+
+    // Fails instead of mapping less if the file shrank since
+    auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, static_cast<DWORD>(fileSize.HighPart),
+                                      fileSize.LowPart, nullptr);
+
+    if (mapping == nullptr)
+    {
+        LOG_WARN("Can't map {}: {:X}", wstring_to_string(path.wstring()), GetLastError());
+        CloseHandle(file);
+        return;
+    }
+
+    // Only the pages the parser touches are read from disk
+    auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+    if (view == nullptr)
+        LOG_WARN("Can't map {}: {:X}", wstring_to_string(path.wstring()), GetLastError());
+
+    CloseHandle(mapping);
+    CloseHandle(file);
+
+    if (view == nullptr)
+        return;
+
+    entry.size = static_cast<uint64_t>(fileSize.QuadPart);
+
+    auto info = PeImage::Parse(std::span(static_cast<const uint8_t*>(view), static_cast<size_t>(entry.size)));
+    UnmapViewOfFile(view);
+
+    if (!info.has_value())
+    {
+        LOG_WARN("{} is not a PE file", wstring_to_string(path.wstring()));
+        return;
+    }
+
+    entry.fileVersion = info->fileVersion;
+    entry.exports = std::move(info->exports);
+}
+
+std::optional<PeVersion> ModuleVersionCache::FileVersion(const std::filesystem::path& path)
+{
+    std::scoped_lock lock(_mutex);
+
+    auto entry = Get(path);
+
+    if (entry == nullptr)
+        return std::nullopt;
+
+    if (!entry->versionRead)
+    {
+        Parse(path, *entry);
+        MarkDirty();
+    }
+
+    return entry->fileVersion;
+}
+
+bool ModuleVersionCache::HasExport(const std::filesystem::path& path, std::string_view name)
+{
+    std::scoped_lock lock(_mutex);
+
+    auto entry = Get(path);
+
+    if (entry == nullptr)
+        return false;
+
+    auto key = std::format("{}{}", ExportPrefix, name);
+
+    if (auto it = entry->values.find(key); it != entry->values.end())
+        return it->second != 0;
+
+    if (!entry->parsed)
+        Parse(path, *entry);
+
+    bool found = std::find(entry->exports.begin(), entry->exports.end(), name) != entry->exports.end();
+    entry->values.insert_or_assign(key, found ? 1 : 0);
+    MarkDirty();
+
+    return found;
+}
+
+std::optional<uint64_t> ModuleVersionCache::Value(const std::filesystem::path& path, std::string_view key)
+{
+    std::scoped_lock lock(_mutex);
+
+    auto entry = Get(path);
+
+    if (entry == nullptr)
+        return std::nullopt;
+
+    if (auto it = entry->values.find(key); it != entry->values.end())
+        return it->second;
+
+    return std::nullopt;
+}
+
+void ModuleVersionCache::SetValue(const std::filesystem::path& path, std::string_view key, uint64_t value)
+{
+    std::scoped_lock lock(_mutex);
+
+    auto entry = Get(path);
+
+    if (entry == nullptr)
+        return;
+
+    entry->values.insert_or_assign(std::string(key), value);
+    MarkDirty();
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <pch.h>
+
+#include "PeImage.h"
+
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Versions and capabilities of module files, kept next to OptiScaler between launches.
+// Entries are keyed by path and dropped when the size or last write time changes, so most
+// launches neither map the files nor load them just to ask for a version.
+class ModuleVersionCache
+{
+    struct Entry
+    {
+        uint64_t size = 0;
+        uint64_t writeTime = 0;
+
+        // False until the version resource is read, files without one stay empty
+        bool versionRead = false;
+        std::optional<PeVersion> fileVersion;
+
+        // Export presence as "export:<name>" and values stored by callers
+        std::map<std::string, uint64_t, std::less<>> values;
+
+        // Only for the current session, filled when the file is parsed
+        bool parsed = false;
+        std::vector<std::string> exports;
+    };
+
+    inline static std::mutex _mutex;
+    inline static bool _loaded = false;
+    inline static std::unordered_map<std::wstring, Entry> _entries;
+
+    // Misses during startup are saved together once it ends
+    inline static bool _startupDone = false;
+    inline static bool _dirty = false;
+
+    static std::filesystem::path CachePath();
+    static void Load();
+    static void Save();
+
+    // _mutex must be held
+    static void MarkDirty();
+
+    // Entry of the file as it is now, nullptr if it doesn't exist. _mutex must be held.
+    static Entry* Get(const std::filesystem::path& path);
+    static void Parse(const std::filesystem::path& path, Entry& entry);
+
+  public:
+    // Same as VS_FIXEDFILEINFO dwFileVersionMS/LS
+    static std::optional<PeVersion> FileVersion(const std::filesystem::path& path);
+
+    static bool HasExport(const std::filesystem::path& path, std::string_view name);
+
+    // Values that need the module loaded to learn, like the NGX snippet version
+    static std::optional<uint64_t> Value(const std::filesystem::path& path, std::string_view key);
+    static void SetValue(const std::filesystem::path& path, std::string_view key, uint64_t value);
+
+    // Saves what startup added, later misses are saved as they happen
+    static void EndStartup();
+};
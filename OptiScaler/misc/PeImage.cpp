@@ -0,0 +1,367 @@
+#include "PeImage.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+constexpr uint16_t DosSignature = 0x5A4D;   // MZ
+constexpr uint32_t NtSignature = 0x00004550; // PE\0\0
+constexpr uint16_t OptionalMagic32 = 0x10B;
+constexpr uint16_t OptionalMagic64 = 0x20B;
+constexpr uint32_t FixedFileInfoSignature = 0xFEEF04BD;
+
+constexpr uint32_t ExportDirectory = 0;
+constexpr uint32_t ResourceDirectory = 2;
+constexpr uint32_t ResourceTypeVersion = 16; // RT_VERSION
+constexpr uint32_t ResourceHighBit = 0x80000000;
+
+// Anything above these is a malformed file, not a real module
+constexpr uint32_t MaxSections = 96;
+constexpr uint32_t MaxExports = 1 << 16;
+constexpr size_t MaxExportNameLength = 4096;
+
+struct Section
+{
+    uint32_t virtualAddress = 0;
+    uint32_t virtualSize = 0;
+    uint32_t rawPointer = 0;
+    uint32_t rawSize = 0;
+};
+
+class Reader
+{
+    std::span<const uint8_t> _bytes;
+
+  public:
+    explicit Reader(std::span<const uint8_t> bytes) : _bytes(bytes) {}
+
+    size_t Size() const { return _bytes.size(); }
+
+    bool Has(size_t offset, size_t size) const { return offset <= _bytes.size() && size <= _bytes.size() - offset; }
+
+    template <typename T> std::optional<T> Read(size_t offset) const
+    {
+        if (!Has(offset, sizeof(T)))
+            return std::nullopt;
+
+        T value;
+        std::memcpy(&value, _bytes.data() + offset, sizeof(T));
+        return value;
+    }
+
+    std::span<const uint8_t> Slice(size_t offset, size_t size) const
+    {
+        if (!Has(offset, size))
+            return {};
+
+        return _bytes.subspan(offset, size);
+    }
+
+    std::optional<std::string> CString(size_t offset, size_t maxLength) const
+    {
+        if (offset >= _bytes.size())
+            return std::nullopt;
+
+        auto available = (std::min)(_bytes.size() - offset, maxLength);
+        auto begin = reinterpret_cast<const char*>(_bytes.data() + offset);
+        auto end = std::find(begin, begin + available, '\0');
+
+        // Unterminated
+        if (end == begin + available)
+            return std::nullopt;
+
+        return std::string(begin, end);
+    }
+};
+
+class Image
+{
+    Reader _reader;
+    std::vector<Section> _sections;
+
+  public:
+    explicit Image(std::span<const uint8_t> bytes) : _reader(bytes) {}
+
+    const Reader& File() const { return _reader; }
+    void AddSection(const Section& section) { _sections.push_back(section); }
+
+    std::optional<size_t> RvaToOffset(uint32_t rva, size_t size) const
+    {
+        for (const auto& section : _sections)
+        {
+            auto mappedSize = (std::max)(section.virtualSize, section.rawSize);
+
+            if (rva < section.virtualAddress || rva - section.virtualAddress >= mappedSize)
+                continue;
+
+            auto delta = rva - section.virtualAddress;
+
+            // Part of the section that is zero filled, not in the file
+            if (delta >= section.rawSize || size > section.rawSize - delta)
+                return std::nullopt;
+
+            size_t offset = static_cast<size_t>(section.rawPointer) + delta;
+
+            if (!_reader.Has(offset, size))
+                return std::nullopt;
+
+            return offset;
+        }
+
+        return std::nullopt;
+    }
+};
+
+PeVersion VersionFrom(uint32_t ms, uint32_t ls)
+{
+    return PeVersion { static_cast<uint16_t>(ms >> 16), static_cast<uint16_t>(ms & 0xFFFF),
+                       static_cast<uint16_t>(ls >> 16), static_cast<uint16_t>(ls & 0xFFFF) };
+}
+
+// Entry of a resource directory, returns the directory relative OffsetToData
+std::optional<uint32_t> FindResourceEntry(const Reader& file, size_t resourceBase, size_t directory,
+                                          std::optional<uint32_t> id, bool wantDirectory)
+{
+    auto namedCount = file.Read<uint16_t>(directory + 12);
+    auto idCount = file.Read<uint16_t>(directory + 14);
+
+    if (!namedCount || !idCount)
+        return std::nullopt;
+
+    uint32_t count = static_cast<uint32_t>(*namedCount) + *idCount;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        auto entry = directory + 16 + i * 8;
+        auto name = file.Read<uint32_t>(entry);
+        auto offsetToData = file.Read<uint32_t>(entry + 4);
+
+        if (!name || !offsetToData)
+            return std::nullopt;
+
+        if (id.has_value() && ((*name & ResourceHighBit) != 0 || *name != *id))
+            continue;
+
+        if (((*offsetToData & ResourceHighBit) != 0) != wantDirectory)
+            continue;
+
+        auto relative = *offsetToData & ~ResourceHighBit;
+
+        if (!file.Has(resourceBase + relative, wantDirectory ? 16 : 8))
+            return std::nullopt;
+
+        return relative;
+    }
+
+    return std::nullopt;
+}
+
+// RT_VERSION -> first name -> first language
+std::span<const uint8_t> FindVersionResource(const Image& image, uint32_t resourceRva)
+{
+    const auto& file = image.File();
+
+    auto base = image.RvaToOffset(resourceRva, 16);
+
+    if (!base)
+        return {};
+
+    auto type = FindResourceEntry(file, *base, *base, ResourceTypeVersion, true);
+
+    if (!type)
+        return {};
+
+    auto name = FindResourceEntry(file, *base, *base + *type, std::nullopt, true);
+
+    if (!name)
+        return {};
+
+    auto language = FindResourceEntry(file, *base, *base + *name, std::nullopt, false);
+
+    if (!language)
+        return {};
+
+    auto dataRva = file.Read<uint32_t>(*base + *language);
+    auto dataSize = file.Read<uint32_t>(*base + *language + 4);
+
+    if (!dataRva || !dataSize)
+        return {};
+
+    auto data = image.RvaToOffset(*dataRva, *dataSize);
+
+    if (!data)
+        return {};
+
+    return file.Slice(*data, *dataSize);
+}
+
+void ReadExports(const Image& image, uint32_t exportRva, PeInfo& info)
+{
+    const auto& file = image.File();
+
+    auto directory = image.RvaToOffset(exportRva, 40);
+
+    if (!directory)
+        return;
+
+    auto nameCount = file.Read<uint32_t>(*directory + 24);
+    auto namesRva = file.Read<uint32_t>(*directory + 32);
+
+    if (!nameCount || !namesRva || *nameCount == 0 || *nameCount > MaxExports)
+        return;
+
+    auto names = image.RvaToOffset(*namesRva, static_cast<size_t>(*nameCount) * 4);
+
+    if (!names)
+        return;
+
+    info.exports.reserve(*nameCount);
+
+    for (uint32_t i = 0; i < *nameCount; i++)
+    {
+        auto nameRva = file.Read<uint32_t>(*names + i * 4);
+
+        if (!nameRva)
+            return;
+
+        auto nameOffset = image.RvaToOffset(*nameRva, 1);
+
+        if (!nameOffset)
+            continue;
+
+        if (auto name = file.CString(*nameOffset, MaxExportNameLength); name.has_value())
+            info.exports.push_back(std::move(*name));
+    }
+}
+} // namespace
+
+bool PeInfo::HasExport(std::string_view name) const
+{
+    return std::find(exports.begin(), exports.end(), name) != exports.end();
+}
+
+bool PeImage::ParseVersionInfo(std::span<const uint8_t> block, PeInfo& info)
+{
+    static constexpr char16_t Key[] = u"VS_VERSION_INFO";
+
+    Reader reader(block);
+
+    auto length = reader.Read<uint16_t>(0);
+    auto valueLength = reader.Read<uint16_t>(2);
+
+    if (!length || !valueLength || *length > block.size())
+        return false;
+
+    // wLength, wValueLength, wType then the key including its terminator
+    size_t keyOffset = 6;
+
+    for (size_t i = 0; i < std::size(Key); i++)
+    {
+        auto c = reader.Read<uint16_t>(keyOffset + i * 2);
+
+        if (!c || *c != static_cast<uint16_t>(Key[i]))
+            return false;
+    }
+
+    // Value is 32 bit aligned from the start of the block
+    size_t valueOffset = (keyOffset + sizeof(Key) + 3) & ~static_cast<size_t>(3);
+
+    if (*valueLength < 52 || valueOffset + 52 > *length)
+        return false;
+
+    auto signature = reader.Read<uint32_t>(valueOffset);
+    auto fileMS = reader.Read<uint32_t>(valueOffset + 8);
+    auto fileLS = reader.Read<uint32_t>(valueOffset + 12);
+    auto productMS = reader.Read<uint32_t>(valueOffset + 16);
+    auto productLS = reader.Read<uint32_t>(valueOffset + 20);
+
+    if (!signature || *signature != FixedFileInfoSignature || !fileMS || !fileLS || !productMS || !productLS)
+        return false;
+
+    info.fileVersion = VersionFrom(*fileMS, *fileLS);
+    info.productVersion = VersionFrom(*productMS, *productLS);
+
+    return true;
+}
+
+std::optional<PeInfo> PeImage::Parse(std::span<const uint8_t> bytes)
+{
+    Image image(bytes);
+    const auto& file = image.File();
+
+    auto dosSignature = file.Read<uint16_t>(0);
+    auto ntOffset = file.Read<uint32_t>(0x3C);
+
+    if (!dosSignature || *dosSignature != DosSignature || !ntOffset)
+        return std::nullopt;
+
+    auto ntSignature = file.Read<uint32_t>(*ntOffset);
+
+    if (!ntSignature || *ntSignature != NtSignature)
+        return std::nullopt;
+
+    // IMAGE_FILE_HEADER
+    size_t fileHeader = static_cast<size_t>(*ntOffset) + 4;
+    auto machine = file.Read<uint16_t>(fileHeader);
+    auto sectionCount = file.Read<uint16_t>(fileHeader + 2);
+    auto optionalSize = file.Read<uint16_t>(fileHeader + 16);
+
+    if (!machine || !sectionCount || !optionalSize || *sectionCount > MaxSections)
+        return std::nullopt;
+
+    // IMAGE_OPTIONAL_HEADER32/64, they differ in where the data directories start
+    size_t optionalHeader = fileHeader + 20;
+    auto magic = file.Read<uint16_t>(optionalHeader);
+
+    if (!magic || (*magic != OptionalMagic32 && *magic != OptionalMagic64))
+        return std::nullopt;
+
+    PeInfo info;
+    info.machine = *machine;
+    info.is64Bit = *magic == OptionalMagic64;
+
+    size_t directoryCountOffset = info.is64Bit ? 108 : 92;
+    auto directoryCount = file.Read<uint32_t>(optionalHeader + directoryCountOffset);
+
+    if (!directoryCount)
+        return std::nullopt;
+
+    auto directory = [&](uint32_t index) -> std::pair<uint32_t, uint32_t>
+    {
+        auto entry = optionalHeader + directoryCountOffset + 4 + index * 8;
+
+        if (index >= *directoryCount || entry + 8 > optionalHeader + *optionalSize)
+            return { 0, 0 };
+
+        return { file.Read<uint32_t>(entry).value_or(0), file.Read<uint32_t>(entry + 4).value_or(0) };
+    };
+
+    size_t sectionTable = optionalHeader + *optionalSize;
+
+    for (uint16_t i = 0; i < *sectionCount; i++)
+    {
+        auto header = sectionTable + i * 40;
+
+        if (!file.Has(header, 40))
+            return std::nullopt;
+
+        Section section;
+        section.virtualSize = *file.Read<uint32_t>(header + 8);
+        section.virtualAddress = *file.Read<uint32_t>(header + 12);
+        section.rawSize = *file.Read<uint32_t>(header + 16);
+        section.rawPointer = *file.Read<uint32_t>(header + 20);
+        image.AddSection(section);
+    }
+
+    if (auto [rva, size] = directory(ResourceDirectory); rva != 0 && size != 0)
+    {
+        if (auto block = FindVersionResource(image, rva); !block.empty())
+            ParseVersionInfo(block, info);
+    }
+
+    if (auto [rva, size] = directory(ExportDirectory); rva != 0 && size != 0)
+        ReadExports(image, rva, info);
+
+    return info;
+}
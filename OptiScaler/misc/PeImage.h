@@ -0,0 +1,45 @@
+#pragma once
+#include <pch.h>
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct PeVersion
+{
+    uint16_t major = 0;
+    uint16_t minor = 0;
+    uint16_t patch = 0;
+    uint16_t build = 0;
+
+    auto operator<=>(const PeVersion&) const = default;
+};
+
+struct PeInfo
+{
+    bool is64Bit = false;
+    uint16_t machine = 0;
+
+    // From VS_FIXEDFILEINFO, empty when the file has no version resource
+    std::optional<PeVersion> fileVersion;
+    std::optional<PeVersion> productVersion;
+
+    // Named exports in export table order
+    std::vector<std::string> exports;
+
+    bool HasExport(std::string_view name) const;
+};
+
+// Reads headers, the version resource and the export names straight from the file bytes
+// without loading the module. Nothing here calls Windows, every offset is bounds checked
+// so truncated or malformed files are never read past their end.
+class PeImage
+{
+  public:
+    static std::optional<PeInfo> Parse(std::span<const uint8_t> bytes);
+
+    // VS_VERSIONINFO block as returned by GetFileVersionInfoW, fills file and product versions
+    static bool ParseVersionInfo(std::span<const uint8_t> block, PeInfo& info);
+};
@@ -0,0 +1,39 @@
+#include "StagePipeline.h"
+
+void StageTimer::Add(double ms)
+{
+    _timing.calls++;
+    _timing.lastMs = ms;
+
+    _windowSum += ms;
+    _windowCount++;
+
+    if (ms > _windowMax)
+        _windowMax = ms;
+
+    // First window publishes early so the overlay has something to show
+    if (_windowCount < WindowSize && _timing.calls > WindowSize)
+        return;
+
+    _timing.avgMs = _windowSum / _windowCount;
+    _timing.maxMs = _windowMax;
+
+    if (_windowCount < WindowSize)
+        return;
+
+    _windowSum = 0.0;
+    _windowMax = 0.0;
+    _windowCount = 0;
+}
+
+void StageTimer::Reset()
+{
+    auto name = _timing.name;
+
+    _timing = {};
+    _timing.name = name;
+
+    _windowSum = 0.0;
+    _windowMax = 0.0;
+    _windowCount = 0;
+}
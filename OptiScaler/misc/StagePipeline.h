@@ -0,0 +1,182 @@
+#pragma once
+#include <pch.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// CPU time statistics of a single pipeline stage
+// Averages and maximums are published once per window so overlay values don't flicker
+struct StageTiming
+{
+    const char* name = nullptr;
+    bool enabled = false;
+    uint64_t calls = 0;
+    double lastMs = 0.0;
+    double avgMs = 0.0;
+    double maxMs = 0.0;
+};
+
+class StageTimer
+{
+  public:
+    static constexpr uint32_t WindowSize = 120;
+
+  private:
+    StageTiming _timing {};
+
+    double _windowSum = 0.0;
+    double _windowMax = 0.0;
+    uint32_t _windowCount = 0;
+
+  public:
+    void Add(double ms);
+    void Reset();
+
+    const StageTiming& Timing() const { return _timing; }
+    StageTiming& Timing() { return _timing; }
+};
+
+// Ordered list of named stages which are run one after another with a shared context.
+// Every stage has an enable predicate which is only re-evaluated when the value returned
+// by the state key function changes, so config and state lookups don't happen per call.
+// Stages can still bail out by themselves for checks which change every call.
+template <typename TContext> class StagePipeline
+{
+  public:
+    using StageFunction = std::function<void(TContext&)>;
+    using Predicate = std::function<bool()>;
+    using StateKeyFunction = std::function<uint64_t()>;
+    using Clock = std::chrono::steady_clock;
+
+  private:
+    struct Stage
+    {
+        const char* name = nullptr;
+        Predicate enabled;
+        StageFunction run;
+        bool active = true;
+        StageTimer timer;
+    };
+
+    std::vector<Stage> _stages;
+    StateKeyFunction _stateKey;
+    uint64_t _lastStateKey = 0;
+    std::atomic<bool> _dirty = true;
+    bool _timingEnabled = true;
+
+    // Stage times of the current run, published together once the run is done
+    std::vector<double> _elapsed;
+
+    // Guards the stage list and the timers against Timings readers on other threads.
+    // Stages are only added and run by the building thread, its own reads don't need it.
+    mutable std::mutex _stagesMutex;
+
+    void EvaluatePredicates()
+    {
+        _dirty.store(false, std::memory_order_relaxed);
+
+        for (auto& stage : _stages)
+            stage.active = !stage.enabled || stage.enabled();
+    }
+
+  public:
+    // Stages run in the order they are added, a null predicate means always enabled
+    void AddStage(const char* name, Predicate enabled, StageFunction run)
+    {
+        Stage stage {};
+        stage.name = name;
+        stage.enabled = std::move(enabled);
+        stage.run = std::move(run);
+        stage.timer.Timing().name = name;
+
+        std::lock_guard<std::mutex> lock(_stagesMutex);
+
+        _stages.push_back(std::move(stage));
+        _elapsed.push_back(0.0);
+        _dirty = true;
+    }
+
+    void SetStateKey(StateKeyFunction stateKey)
+    {
+        _stateKey = std::move(stateKey);
+        _dirty = true;
+    }
+
+    // Forces predicates to be re-evaluated on the next run, can be called from any thread
+    void Invalidate() { _dirty.store(true, std::memory_order_relaxed); }
+
+    void SetTimingEnabled(bool enabled) { _timingEnabled = enabled; }
+
+    bool Empty() const { return _stages.empty(); }
+    size_t StageCount() const { return _stages.size(); }
+
+    void Run(TContext& context)
+    {
+        if (_stateKey)
+        {
+            auto key = _stateKey();
+
+            if (key != _lastStateKey)
+            {
+                _lastStateKey = key;
+                _dirty = true;
+            }
+        }
+
+        if (_dirty.load(std::memory_order_relaxed))
+            EvaluatePredicates();
+
+        for (size_t i = 0; i < _stages.size(); i++)
+        {
+            auto& stage = _stages[i];
+
+            if (!stage.active)
+                continue;
+
+            if (!_timingEnabled)
+            {
+                stage.run(context);
+                continue;
+            }
+
+            auto start = Clock::now();
+            stage.run(context);
+            _elapsed[i] = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        std::lock_guard<std::mutex> lock(_stagesMutex);
+
+        for (size_t i = 0; i < _stages.size(); i++)
+        {
+            auto& stage = _stages[i];
+            stage.timer.Timing().enabled = stage.active;
+
+            if (stage.active && _timingEnabled)
+                stage.timer.Add(_elapsed[i]);
+        }
+    }
+
+    std::vector<StageTiming> Timings() const
+    {
+        std::lock_guard<std::mutex> lock(_stagesMutex);
+
+        std::vector<StageTiming> result;
+        result.reserve(_stages.size());
+
+        for (const auto& stage : _stages)
+            result.push_back(stage.timer.Timing());
+
+        return result;
+    }
+
+    void ResetTimings()
+    {
+        std::lock_guard<std::mutex> lock(_stagesMutex);
+
+        for (auto& stage : _stages)
+            stage.timer.Reset();
+    }
+};
@@ -0,0 +1,256 @@
+#include "StartupScheduler.h"
+
+#include <thread>
+
+StartupScheduler& StartupScheduler::Instance()
+{
+    static StartupScheduler instance;
+    return instance;
+}
+
+StartupScheduler::Step* StartupScheduler::Find(std::string_view name) const
+{
+    for (const auto& step : _steps)
+    {
+        if (name == step->name)
+            return step.get();
+    }
+
+    return nullptr;
+}
+
+bool StartupScheduler::DependenciesDone(const Step& step) const
+{
+    for (auto index : step.dependencies)
+    {
+        if (_steps[index]->state.load(std::memory_order_acquire) != Done)
+            return false;
+    }
+
+    return true;
+}
+
+bool StartupScheduler::Add(const char* name, StartupPhase phase, std::initializer_list<const char*> dependsOn,
+                           StepFunction run)
+{
+    if (Find(name) != nullptr)
+    {
+        LOG_ERROR("Step {} is already added", name);
+        _valid = false;
+        return false;
+    }
+
+    auto step = std::make_unique<Step>();
+    step->name = name;
+    step->phase = phase;
+    step->run = std::move(run);
+
+    for (auto dependency : dependsOn)
+    {
+        size_t index = 0;
+
+        for (; index < _steps.size(); index++)
+        {
+            if (std::string_view(dependency) == _steps[index]->name)
+                break;
+        }
+
+        if (index == _steps.size())
+        {
+            LOG_ERROR("Step {} depends on {} which isn't added before it", name, dependency);
+            _valid = false;
+            return false;
+        }
+
+        if (phase == StartupPhase::LoaderLock && _steps[index]->phase == StartupPhase::Worker)
+        {
+            LOG_ERROR("LoaderLock step {} can't depend on worker step {}", name, dependency);
+            _valid = false;
+            return false;
+        }
+
+        step->dependencies.push_back(index);
+    }
+
+    _steps.push_back(std::move(step));
+    return true;
+}
+
+void StartupScheduler::RunStep(Step& step, bool ranByWaiter)
+{
+    auto start = Clock::now();
+
+    step.run();
+
+    auto end = Clock::now();
+
+    step.timeline.name = step.name;
+    step.timeline.phase = step.phase;
+    step.timeline.ranByWaiter = ranByWaiter;
+    step.timeline.startMs = std::chrono::duration<double, std::milli>(start - _start).count();
+    step.timeline.durationMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        step.state.store(Done, std::memory_order_release);
+    }
+
+    _doneCondition.notify_all();
+}
+
+void StartupScheduler::RunLoaderLockSteps()
+{
+    if (!_started)
+    {
+        _start = Clock::now();
+        _started = true;
+    }
+
+    for (auto& step : _steps)
+    {
+        if (step->phase != StartupPhase::LoaderLock)
+            continue;
+
+        uint8_t expected = Pending;
+        if (!step->state.compare_exchange_strong(expected, Running, std::memory_order_acq_rel))
+            continue;
+
+        RunStep(*step, false);
+    }
+}
+
+void StartupScheduler::RunWorkerSteps()
+{
+    for (auto& step : _steps)
+    {
+        if (step->phase != StartupPhase::Worker)
+            continue;
+
+        // Add order is a valid run order, dependencies can only be running on a waiter thread here
+        for (auto index : step->dependencies)
+            Wait(_steps[index]->name, std::chrono::milliseconds::max());
+
+        uint8_t expected = Pending;
+        if (!step->state.compare_exchange_strong(expected, Running, std::memory_order_acq_rel))
+            continue;
+
+        RunStep(*step, false);
+    }
+
+    // Steps taken by waiters might still be running
+    for (auto& step : _steps)
+    {
+        if (step->phase == StartupPhase::Worker)
+            Wait(step->name, std::chrono::milliseconds::max());
+    }
+}
+
+void StartupScheduler::StartWorker()
+{
+    try
+    {
+        std::thread(
+            [this]()
+            {
+                RunWorkerSteps();
+                LogTimeline();
+            })
+            .detach();
+    }
+    catch (const std::exception& ex)
+    {
+        LOG_ERROR("Can't start startup worker: {}, running the steps inline", ex.what());
+        RunWorkerSteps();
+        LogTimeline();
+    }
+}
+
+bool StartupScheduler::Wait(std::string_view name, std::chrono::milliseconds timeout)
+{
+    auto step = Find(name);
+
+    if (step == nullptr)
+        return false;
+
+    auto state = step->state.load(std::memory_order_acquire);
+
+    if (state == Done)
+        return true;
+
+    // Not reached yet, running it out of order would break DllMain's sequence
+    if (step->phase == StartupPhase::LoaderLock && state == Pending)
+        return false;
+
+    if (state == Pending)
+    {
+        if (!DependenciesDone(*step))
+        {
+            LOG_WARN("{} is not ready, dependencies are not done", step->name);
+            return false;
+        }
+
+        uint8_t expected = Pending;
+        if (step->state.compare_exchange_strong(expected, Running, std::memory_order_acq_rel))
+        {
+            LOG_DEBUG("Running {} on waiting thread", step->name);
+            RunStep(*step, true);
+            return true;
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto isDone = [step]() { return step->state.load(std::memory_order_acquire) == Done; };
+
+    if (timeout == std::chrono::milliseconds::max())
+    {
+        _doneCondition.wait(lock, isDone);
+        return true;
+    }
+
+    if (!_doneCondition.wait_for(lock, timeout, isDone))
+    {
+        LOG_WARN("Timed out waiting for {}", step->name);
+        return false;
+    }
+
+    return true;
+}
+
+bool StartupScheduler::IsDone(std::string_view name) const
+{
+    auto step = Find(name);
+    return step != nullptr && step->state.load(std::memory_order_acquire) == Done;
+}
+
+std::vector<StartupTimelineEntry> StartupScheduler::Timeline() const
+{
+    std::vector<StartupTimelineEntry> result;
+
+    for (const auto& step : _steps)
+    {
+        if (step->state.load(std::memory_order_acquire) == Done)
+            result.push_back(step->timeline);
+    }
+
+    std::ranges::sort(result, {}, &StartupTimelineEntry::startMs);
+    return result;
+}
+
+void StartupScheduler::LogTimeline() const
+{
+    LOG_INFO("Startup timeline:");
+
+    double loaderLockMs = 0.0;
+
+    for (const auto& entry : Timeline())
+    {
+        auto thread = entry.phase == StartupPhase::LoaderLock ? "DllMain" : entry.ranByWaiter ? "Waiter" : "Worker";
+
+        LOG_INFO("  {:>9.3f} ms {:>9.3f} ms  {:<7}  {}", entry.startMs, entry.durationMs, thread, entry.name);
+
+        if (entry.phase == StartupPhase::LoaderLock)
+            loaderLockMs += entry.durationMs;
+    }
+
+    LOG_INFO("Time spent in DllMain steps: {:.3f} ms", loaderLockMs);
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include <pch.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+enum class StartupPhase : uint8_t
+{
+    LoaderLock, // Run inside DllMain, before the game's next loader call
+    Worker,     // Run on the startup worker after DllMain returns
+};
+
+// Steps other modules wait on
+namespace StartupSteps
+{
+// nvngx_dlss/dlssd/dlssg paths and the DLSSEnabled decision which depends on them
+inline constexpr const char* DlssFiles = "DlssFiles";
+} // namespace StartupSteps
+
+struct StartupTimelineEntry
+{
+    const char* name = nullptr;
+    StartupPhase phase = StartupPhase::LoaderLock;
+    bool ranByWaiter = false; // Worker step which was run by a thread waiting for it
+    double startMs = 0.0;     // Since the first step started
+    double durationMs = 0.0;
+};
+
+// Runs DllMain init as named steps and keeps a timeline of them.
+// LoaderLock steps run in the order they were added. Worker steps run in the
+// same order on a thread which is started at the end of DllMain, it can only
+// run after the loader lock is released. Code depending on a worker step calls
+// Wait, if the step hasn't started yet it's run on the waiting thread instead,
+// so waiting from a thread holding the loader lock can't deadlock on the worker.
+class StartupScheduler
+{
+  public:
+    using StepFunction = std::function<void()>;
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::milliseconds DefaultWaitTimeout { 10000 };
+
+  private:
+    enum StepState : uint8_t
+    {
+        Pending,
+        Running,
+        Done,
+    };
+
+    struct Step
+    {
+        const char* name = nullptr;
+        StartupPhase phase = StartupPhase::LoaderLock;
+        std::vector<size_t> dependencies;
+        StepFunction run;
+
+        std::atomic<uint8_t> state = Pending;
+        StartupTimelineEntry timeline {};
+    };
+
+    // Steps are only added before anything runs, pointers stay valid
+    std::vector<std::unique_ptr<Step>> _steps;
+    bool _valid = true;
+
+    Clock::time_point _start {};
+    bool _started = false;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _doneCondition;
+
+    Step* Find(std::string_view name) const;
+    bool DependenciesDone(const Step& step) const;
+    void RunStep(Step& step, bool ranByWaiter);
+
+  public:
+    static StartupScheduler& Instance();
+
+    // Dependencies must be added before the step, so the add order is always a valid run order.
+    // LoaderLock steps can't depend on worker steps. Returns false and marks the scheduler invalid otherwise.
+    bool Add(const char* name, StartupPhase phase, std::initializer_list<const char*> dependsOn, StepFunction run);
+
+    bool IsValid() const { return _valid; }
+
+    void RunLoaderLockSteps();
+
+    // Runs the worker steps on the calling thread, the worker thread uses this too
+    void RunWorkerSteps();
+
+    // Starts the worker thread, worker steps run inline if the thread can't be created
+    void StartWorker();
+
+    // Completion barrier for a step. Returns false if the step is unknown, is a LoaderLock step
+    // which hasn't run yet, has dependencies which aren't done or didn't finish in time
+    bool Wait(std::string_view name, std::chrono::milliseconds timeout = DefaultWaitTimeout);
+
+    bool IsDone(std::string_view name) const;
+
+    std::vector<StartupTimelineEntry> Timeline() const;
+    void LogTimeline() const;
+};
@@ -0,0 +1,590 @@
+#include "StateShadow_Dx12.h"
+
+#include <Config.h>
+
+#include <detours/detours.h>
+
+#include <bit>
+
+// Shadow of a command list, kept in the list's slot storage
+struct StateShadowSlot_Dx12 final : CommandListSlotData
+{
+    StateShadow_Dx12 shadow;
+};
+
+#pragma region State
+
+StateShadow_Dx12::Argument* StateShadow_Dx12::BeginArgument(Pipeline pipeline, UINT index)
+{
+    if (index >= MaxRootParameters)
+        return nullptr;
+
+    auto& state = _pipelines[pipeline];
+    auto bit = 1ull << index;
+
+    if (InWork())
+    {
+        state.dirtyMask |= bit;
+        return nullptr;
+    }
+
+    auto& argument = state.arguments[index];
+
+    // First one since the root signature, values of the previous one are not valid
+    if ((state.boundMask & bit) == 0)
+    {
+        argument.type = ArgumentType::None;
+        argument.constantsMask = 0;
+        state.boundMask |= bit;
+    }
+
+    return &argument;
+}
+
+void StateShadow_Dx12::Reset(ID3D12PipelineState* initialState)
+{
+    _heaps = {};
+    _heapsKnown = false;
+    _pso = initialState;
+    _topology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+
+    _currentHeaps = {};
+    _currentPso = initialState;
+    _currentTopology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+
+    for (auto& state : _pipelines)
+    {
+        state.rootSignature = nullptr;
+        state.boundMask = 0;
+        state.currentSignature = nullptr;
+        state.argumentsLost = false;
+        state.dirtyMask = 0;
+    }
+}
+
+void StateShadow_Dx12::SetDescriptorHeaps(UINT count, ID3D12DescriptorHeap* const* heaps)
+{
+    Heaps value {};
+    value.count = std::min(count, (UINT) value.heaps.size());
+
+    for (UINT i = 0; i < value.count && heaps != nullptr; i++)
+        value.heaps[i] = heaps[i];
+
+    _currentHeaps = value;
+
+    if (InWork())
+        return;
+
+    _heaps = value;
+    _heapsKnown = true;
+}
+
+void StateShadow_Dx12::SetPipelineState(ID3D12PipelineState* pso)
+{
+    _currentPso = pso;
+
+    if (!InWork())
+        _pso = pso;
+}
+
+void StateShadow_Dx12::SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY topology)
+{
+    _currentTopology = topology;
+
+    if (!InWork())
+        _topology = topology;
+}
+
+void StateShadow_Dx12::SetRootSignature(Pipeline pipeline, ID3D12RootSignature* signature)
+{
+    auto& state = _pipelines[pipeline];
+
+    // Setting the same root signature again keeps the arguments
+    bool changed = signature != state.currentSignature;
+    state.currentSignature = signature;
+
+    if (InWork())
+    {
+        state.argumentsLost |= changed;
+        return;
+    }
+
+    if (signature != state.rootSignature)
+        state.boundMask = 0;
+
+    state.rootSignature = signature;
+}
+
+void StateShadow_Dx12::SetRootDescriptorTable(Pipeline pipeline, UINT index, D3D12_GPU_DESCRIPTOR_HANDLE table)
+{
+    if (auto argument = BeginArgument(pipeline, index))
+    {
+        argument->type = ArgumentType::Table;
+        argument->value = table.ptr;
+    }
+}
+
+void StateShadow_Dx12::SetRoot32BitConstants(Pipeline pipeline, UINT index, UINT count, const void* data, UINT offset)
+{
+    auto argument = BeginArgument(pipeline, index);
+
+    if (argument == nullptr)
+        return;
+
+    if (data == nullptr || count == 0 || offset + count > MaxRootConstants)
+    {
+        argument->type = ArgumentType::None;
+        return;
+    }
+
+    if (argument->type != ArgumentType::Constants)
+    {
+        argument->type = ArgumentType::Constants;
+        argument->constantsMask = 0;
+    }
+
+    if (argument->constants.size() < offset + count)
+        argument->constants.resize(offset + count);
+
+    memcpy(argument->constants.data() + offset, data, count * sizeof(UINT));
+
+    auto bits = count == 64 ? ~0ull : (1ull << count) - 1;
+    argument->constantsMask |= bits << offset;
+}
+
+void StateShadow_Dx12::SetRootView(Pipeline pipeline, UINT index, ArgumentType type, D3D12_GPU_VIRTUAL_ADDRESS va)
+{
+    if (auto argument = BeginArgument(pipeline, index))
+    {
+        argument->type = type;
+        argument->value = va;
+    }
+}
+
+uint32_t StateShadow_Dx12::RestoreArgument(ID3D12GraphicsCommandList* list, const StateShadowWriter& writer,
+                                           Pipeline pipeline, UINT index, const Argument& argument) const
+{
+    switch (argument.type)
+    {
+    case ArgumentType::Table:
+        writer.SetRootDescriptorTable[pipeline](list, index, D3D12_GPU_DESCRIPTOR_HANDLE { argument.value });
+        return 1;
+
+    case ArgumentType::CBV:
+        writer.SetRootConstantBufferView[pipeline](list, index, argument.value);
+        return 1;
+
+    case ArgumentType::SRV:
+        writer.SetRootShaderResourceView[pipeline](list, index, argument.value);
+        return 1;
+
+    case ArgumentType::UAV:
+        writer.SetRootUnorderedAccessView[pipeline](list, index, argument.value);
+        return 1;
+
+    case ArgumentType::Constants:
+    {
+        uint32_t calls = 0;
+        auto mask = argument.constantsMask;
+
+        // One call for each continuous range of known values
+        while (mask != 0)
+        {
+            auto start = (UINT) std::countr_zero(mask);
+            auto count = (UINT) std::countr_one(mask >> start);
+
+            writer.SetRoot32BitConstants[pipeline](list, index, count, argument.constants.data() + start, start);
+            calls++;
+
+            auto bits = count == 64 ? ~0ull : (1ull << count) - 1;
+            mask &= ~(bits << start);
+        }
+
+        return calls;
+    }
+
+    default:
+        return 0;
+    }
+}
+
+uint32_t StateShadow_Dx12::EndWork(ID3D12GraphicsCommandList* list, const StateShadowWriter& writer,
+                                   uint32_t restoreMask)
+{
+    if (_workDepth == 0)
+        return 0;
+
+    if (--_workDepth > 0)
+        return 0;
+
+    return Restore(list, writer, restoreMask);
+}
+
+uint32_t StateShadow_Dx12::Restore(ID3D12GraphicsCommandList* list, const StateShadowWriter& writer,
+                                   uint32_t restoreMask)
+{
+    uint32_t calls = 0;
+    bool tablesLost = false;
+
+    if (restoreMask != StateShadowRestore_None)
+    {
+        if (_heapsKnown && _currentHeaps != _heaps)
+        {
+            writer.SetDescriptorHeaps(list, _heaps.count, _heaps.heaps.data());
+            _currentHeaps = _heaps;
+            calls++;
+
+            // Tables point into the heaps which were bound when they were set
+            tablesLost = true;
+        }
+
+        if (_pso != nullptr && _currentPso != _pso)
+        {
+            writer.SetPipelineState(list, _pso);
+            _currentPso = _pso;
+            calls++;
+        }
+    }
+
+    if ((restoreMask & StateShadowRestore_Graphics) && _topology != D3D_PRIMITIVE_TOPOLOGY_UNDEFINED &&
+        _currentTopology != _topology)
+    {
+        writer.IASetPrimitiveTopology(list, _topology);
+        _currentTopology = _topology;
+        calls++;
+    }
+
+    for (auto pipeline : { Compute, Graphics })
+    {
+        auto& state = _pipelines[pipeline];
+        auto flag = pipeline == Compute ? StateShadowRestore_Compute : StateShadowRestore_Graphics;
+
+        if ((restoreMask & flag) && state.rootSignature != nullptr)
+        {
+            auto rebindMask = state.dirtyMask;
+
+            if (state.argumentsLost || state.currentSignature != state.rootSignature)
+            {
+                writer.SetRootSignature[pipeline](list, state.rootSignature);
+                state.currentSignature = state.rootSignature;
+                rebindMask = state.boundMask;
+                calls++;
+            }
+            else if (tablesLost)
+            {
+                for (UINT i = 0; i < MaxRootParameters; i++)
+                {
+                    if (state.arguments[i].type == ArgumentType::Table)
+                        rebindMask |= 1ull << i;
+                }
+            }
+
+            rebindMask &= state.boundMask;
+
+            while (rebindMask != 0)
+            {
+                auto index = (UINT) std::countr_zero(rebindMask);
+                rebindMask &= rebindMask - 1;
+
+                calls += RestoreArgument(list, writer, pipeline, index, state.arguments[index]);
+            }
+        }
+
+        state.argumentsLost = false;
+        state.dirtyMask = 0;
+    }
+
+    return calls;
+}
+
+#pragma endregion
+
+#pragma region Hooks
+
+typedef HRESULT (*PFN_Reset)(ID3D12GraphicsCommandList* list, ID3D12CommandAllocator* allocator,
+                             ID3D12PipelineState* initialState);
+typedef void (*PFN_ClearState)(ID3D12GraphicsCommandList* list, ID3D12PipelineState* pso);
+typedef void (*PFN_SetRoot32BitConstant)(ID3D12GraphicsCommandList* list, UINT index, UINT data, UINT offset);
+
+static PFN_Reset o_Reset = nullptr;
+static PFN_ClearState o_ClearState = nullptr;
+static PFN_SetRoot32BitConstant o_SetComputeRoot32BitConstant = nullptr;
+static PFN_SetRoot32BitConstant o_SetGraphicsRoot32BitConstant = nullptr;
+
+// Filled with the trampolines after hooking
+static StateShadowWriter o_Writer {};
+
+template <typename T> static void AssignOriginal(T& target, PVOID address) { target = (T) address; }
+
+// Lists OptiScaler never worked on have no shadow, they only pay for the lookup
+static StateShadow_Dx12* Tracked(ID3D12GraphicsCommandList* list)
+{
+    if (list == nullptr)
+        return nullptr;
+
+    return StateShadow_Dx12::Find(list);
+}
+
+static HRESULT hkReset(ID3D12GraphicsCommandList* list, ID3D12CommandAllocator* allocator,
+                       ID3D12PipelineState* initialState)
+{
+    auto result = o_Reset(list, allocator, initialState);
+
+    if (result == S_OK)
+    {
+        if (auto shadow = Tracked(list))
+            shadow->Reset(initialState);
+    }
+
+    return result;
+}
+
+static void hkClearState(ID3D12GraphicsCommandList* list, ID3D12PipelineState* pso)
+{
+    if (auto shadow = Tracked(list))
+        shadow->Reset(pso);
+
+    o_ClearState(list, pso);
+}
+
+static void hkSetDescriptorHeaps(ID3D12GraphicsCommandList* list, UINT count, ID3D12DescriptorHeap* const* heaps)
+{
+    if (auto shadow = Tracked(list))
+        shadow->SetDescriptorHeaps(count, heaps);
+
+    o_Writer.SetDescriptorHeaps(list, count, heaps);
+}
+
+static void hkSetPipelineState(ID3D12GraphicsCommandList* list, ID3D12PipelineState* pso)
+{
+    if (auto shadow = Tracked(list))
+        shadow->SetPipelineState(pso);
+
+    o_Writer.SetPipelineState(list, pso);
+}
+
+static void hkIASetPrimitiveTopology(ID3D12GraphicsCommandList* list, D3D12_PRIMITIVE_TOPOLOGY topology)
+{
+    if (auto shadow = Tracked(list))
+        shadow->SetPrimitiveTopology(topology);
+
+    o_Writer.IASetPrimitiveTopology(list, topology);
+}
+
+template <StateShadow_Dx12::Pipeline P>
+static void hkSetRootSignature(ID3D12GraphicsCommandList* list, ID3D12RootSignature* signature)
+{
+    if (auto shadow = Tracked(list))
+        shadow->SetRootSignature(P, signature);
+
+    o_Writer.SetRootSignature[P](list, signature);
+}
+
+template <StateShadow_Dx12::Pipeline P>
+static void hkSetRootDescriptorTable(ID3D12GraphicsCommandList* list, UINT index, D3D12_GPU_DESCRIPTOR_HANDLE table)
+{
+    if (auto shadow = Tracked(list))
+        shadow->SetRootDescriptorTable(P, index, table);
+
+    o_Writer.SetRootDescriptorTable[P](list, index, table);
+}
+
+template <StateShadow_Dx12::Pipeline P>
+static void hkSetRoot32BitConstant(ID3D12GraphicsCommandList* list, UINT index, UINT data, UINT offset)
+{
+    if (auto shadow = Tracked(list))
+        shadow->SetRoot32BitConstants(P, index, 1, &data, offset);
+
+    if constexpr (P == StateShadow_Dx12::Compute)
+        o_SetComputeRoot32BitConstant(list, index, data, offset);
+    else
+        o_SetGraphicsRoot32BitConstant(list, index, data, offset);
+}
+
+template <StateShadow_Dx12::Pipeline P>
+static void hkSetRoot32BitConstants(ID3D12GraphicsCommandList* list, UINT index, UINT count, const void* data,
+                                    UINT offset)
+{
+    if (auto shadow = Tracked(list))
+        shadow->SetRoot32BitConstants(P, index, count, data, offset);
+
+    o_Writer.SetRoot32BitConstants[P](list, index, count, data, offset);
+}
+
+template <StateShadow_Dx12::Pipeline P>
+static void hkSetRootConstantBufferView(ID3D12GraphicsCommandList* list, UINT index, D3D12_GPU_VIRTUAL_ADDRESS va)
+{
+    if (auto shadow = Tracked(list))
+        shadow->SetRootView(P, index, StateShadow_Dx12::ArgumentType::CBV, va);
+
+    o_Writer.SetRootConstantBufferView[P](list, index, va);
+}
+
+template <StateShadow_Dx12::Pipeline P>
+static void hkSetRootShaderResourceView(ID3D12GraphicsCommandList* list, UINT index, D3D12_GPU_VIRTUAL_ADDRESS va)
+{
+    if (auto shadow = Tracked(list))
+        shadow->SetRootView(P, index, StateShadow_Dx12::ArgumentType::SRV, va);
+
+    o_Writer.SetRootShaderResourceView[P](list, index, va);
+}
+
+template <StateShadow_Dx12::Pipeline P>
+static void hkSetRootUnorderedAccessView(ID3D12GraphicsCommandList* list, UINT index, D3D12_GPU_VIRTUAL_ADDRESS va)
+{
+    if (auto shadow = Tracked(list))
+        shadow->SetRootView(P, index, StateShadow_Dx12::ArgumentType::UAV, va);
+
+    o_Writer.SetRootUnorderedAccessView[P](list, index, va);
+}
+
+StateShadow_Dx12* StateShadow_Dx12::Get(ID3D12GraphicsCommandList* list)
+{
+    auto slot = CommandListSlots_Dx12::Get<StateShadowSlot_Dx12>(list, CommandListSlot::StateShadow);
+    return slot != nullptr ? &slot->shadow : nullptr;
+}
+
+StateShadow_Dx12* StateShadow_Dx12::Find(ID3D12GraphicsCommandList* list)
+{
+    auto slot = CommandListSlots_Dx12::Find<StateShadowSlot_Dx12>(list, CommandListSlot::StateShadow);
+    return slot != nullptr ? &slot->shadow : nullptr;
+}
+
+uint32_t StateShadow_Dx12::RestoreMask()
+{
+    uint32_t mask = StateShadowRestore_None;
+
+    if (Config::Instance()->RestoreComputeSignature.value_or_default())
+        mask |= StateShadowRestore_Compute;
+
+    if (Config::Instance()->RestoreGraphicSignature.value_or_default())
+        mask |= StateShadowRestore_Graphics;
+
+    return mask;
+}
+
+void StateShadow_Dx12::Hook(ID3D12GraphicsCommandList* list)
+{
+    if (o_Reset != nullptr || list == nullptr)
+        return;
+
+    PVOID* pVTable = *(PVOID**) list;
+
+    o_Reset = (PFN_Reset) pVTable[10];
+    o_ClearState = (PFN_ClearState) pVTable[11];
+    AssignOriginal(o_Writer.IASetPrimitiveTopology, pVTable[20]);
+    AssignOriginal(o_Writer.SetPipelineState, pVTable[25]);
+    AssignOriginal(o_Writer.SetDescriptorHeaps, pVTable[28]);
+
+    // Compute and graphics versions are next to each other
+    for (auto pipeline : { Compute, Graphics })
+    {
+        AssignOriginal(o_Writer.SetRootSignature[pipeline], pVTable[29 + pipeline]);
+        AssignOriginal(o_Writer.SetRootDescriptorTable[pipeline], pVTable[31 + pipeline]);
+        AssignOriginal(o_Writer.SetRoot32BitConstants[pipeline], pVTable[35 + pipeline]);
+        AssignOriginal(o_Writer.SetRootConstantBufferView[pipeline], pVTable[37 + pipeline]);
+        AssignOriginal(o_Writer.SetRootShaderResourceView[pipeline], pVTable[39 + pipeline]);
+        AssignOriginal(o_Writer.SetRootUnorderedAccessView[pipeline], pVTable[41 + pipeline]);
+    }
+
+    o_SetComputeRoot32BitConstant = (PFN_SetRoot32BitConstant) pVTable[33];
+    o_SetGraphicsRoot32BitConstant = (PFN_SetRoot32BitConstant) pVTable[34];
+
+    DetourTransactionBegin();
+    DetourUpdateThread(GetCurrentThread());
+
+    DetourAttach(&(PVOID&) o_Reset, hkReset);
+    DetourAttach(&(PVOID&) o_ClearState, hkClearState);
+    DetourAttach(&(PVOID&) o_Writer.IASetPrimitiveTopology, hkIASetPrimitiveTopology);
+    DetourAttach(&(PVOID&) o_Writer.SetPipelineState, hkSetPipelineState);
+    DetourAttach(&(PVOID&) o_Writer.SetDescriptorHeaps, hkSetDescriptorHeaps);
+
+    DetourAttach(&(PVOID&) o_Writer.SetRootSignature[Compute], hkSetRootSignature<Compute>);
+    DetourAttach(&(PVOID&) o_Writer.SetRootSignature[Graphics], hkSetRootSignature<Graphics>);
+    DetourAttach(&(PVOID&) o_Writer.SetRootDescriptorTable[Compute], hkSetRootDescriptorTable<Compute>);
+    DetourAttach(&(PVOID&) o_Writer.SetRootDescriptorTable[Graphics], hkSetRootDescriptorTable<Graphics>);
+    DetourAttach(&(PVOID&) o_SetComputeRoot32BitConstant, hkSetRoot32BitConstant<Compute>);
+    DetourAttach(&(PVOID&) o_SetGraphicsRoot32BitConstant, hkSetRoot32BitConstant<Graphics>);
+    DetourAttach(&(PVOID&) o_Writer.SetRoot32BitConstants[Compute], hkSetRoot32BitConstants<Compute>);
+    DetourAttach(&(PVOID&) o_Writer.SetRoot32BitConstants[Graphics], hkSetRoot32BitConstants<Graphics>);
+    DetourAttach(&(PVOID&) o_Writer.SetRootConstantBufferView[Compute], hkSetRootConstantBufferView<Compute>);
+    DetourAttach(&(PVOID&) o_Writer.SetRootConstantBufferView[Graphics], hkSetRootConstantBufferView<Graphics>);
+    DetourAttach(&(PVOID&) o_Writer.SetRootShaderResourceView[Compute], hkSetRootShaderResourceView<Compute>);
+    DetourAttach(&(PVOID&) o_Writer.SetRootShaderResourceView[Graphics], hkSetRootShaderResourceView<Graphics>);
+    DetourAttach(&(PVOID&) o_Writer.SetRootUnorderedAccessView[Compute], hkSetRootUnorderedAccessView<Compute>);
+    DetourAttach(&(PVOID&) o_Writer.SetRootUnorderedAccessView[Graphics], hkSetRootUnorderedAccessView<Graphics>);
+
+    DetourTransactionCommit();
+
+    LOG_DEBUG("Hooked command list state functions");
+}
+
+void StateShadow_Dx12::Unhook()
+{
+    if (o_Reset == nullptr)
+        return;
+
+    DetourTransactionBegin();
+    DetourUpdateThread(GetCurrentThread());
+
+    DetourDetach(&(PVOID&) o_Reset, hkReset);
+    DetourDetach(&(PVOID&) o_ClearState, hkClearState);
+    DetourDetach(&(PVOID&) o_Writer.IASetPrimitiveTopology, hkIASetPrimitiveTopology);
+    DetourDetach(&(PVOID&) o_Writer.SetPipelineState, hkSetPipelineState);
+    DetourDetach(&(PVOID&) o_Writer.SetDescriptorHeaps, hkSetDescriptorHeaps);
+
+    DetourDetach(&(PVOID&) o_Writer.SetRootSignature[Compute], hkSetRootSignature<Compute>);
+    DetourDetach(&(PVOID&) o_Writer.SetRootSignature[Graphics], hkSetRootSignature<Graphics>);
+    DetourDetach(&(PVOID&) o_Writer.SetRootDescriptorTable[Compute], hkSetRootDescriptorTable<Compute>);
+    DetourDetach(&(PVOID&) o_Writer.SetRootDescriptorTable[Graphics], hkSetRootDescriptorTable<Graphics>);
+    DetourDetach(&(PVOID&) o_SetComputeRoot32BitConstant, hkSetRoot32BitConstant<Compute>);
+    DetourDetach(&(PVOID&) o_SetGraphicsRoot32BitConstant, hkSetRoot32BitConstant<Graphics>);
+    DetourDetach(&(PVOID&) o_Writer.SetRoot32BitConstants[Compute], hkSetRoot32BitConstants<Compute>);
+    DetourDetach(&(PVOID&) o_Writer.SetRoot32BitConstants[Graphics], hkSetRoot32BitConstants<Graphics>);
+    DetourDetach(&(PVOID&) o_Writer.SetRootConstantBufferView[Compute], hkSetRootConstantBufferView<Compute>);
+    DetourDetach(&(PVOID&) o_Writer.SetRootConstantBufferView[Graphics], hkSetRootConstantBufferView<Graphics>);
+    DetourDetach(&(PVOID&) o_Writer.SetRootShaderResourceView[Compute], hkSetRootShaderResourceView<Compute>);
+    DetourDetach(&(PVOID&) o_Writer.SetRootShaderResourceView[Graphics], hkSetRootShaderResourceView<Graphics>);
+    DetourDetach(&(PVOID&) o_Writer.SetRootUnorderedAccessView[Compute], hkSetRootUnorderedAccessView<Compute>);
+    DetourDetach(&(PVOID&) o_Writer.SetRootUnorderedAccessView[Graphics], hkSetRootUnorderedAccessView<Graphics>);
+
+    DetourTransactionCommit();
+
+    o_Reset = nullptr;
+    o_ClearState = nullptr;
+    o_SetComputeRoot32BitConstant = nullptr;
+    o_SetGraphicsRoot32BitConstant = nullptr;
+    o_Writer = {};
+}
+
+bool StateShadow_Dx12::IsHooked() { return o_Reset != nullptr; }
+
+const StateShadowWriter& StateShadow_Dx12::OriginalWriter() { return o_Writer; }
+
+#pragma endregion
+
+StateShadowScope_Dx12::StateShadowScope_Dx12(ID3D12GraphicsCommandList* list, uint32_t restoreMask)
+{
+    if (list == nullptr || restoreMask == StateShadowRestore_None || !StateShadow_Dx12::IsHooked())
+        return;
+
+    _shadow = StateShadow_Dx12::Get(list);
+
+    if (_shadow == nullptr)
+        return;
+
+    _list = list;
+    _restoreMask = restoreMask;
+    _shadow->BeginWork();
+}
+
+StateShadowScope_Dx12::~StateShadowScope_Dx12()
+{
+    if (_shadow == nullptr)
+        return;
+
+    auto calls = _shadow->EndWork(_list, StateShadow_Dx12::OriginalWriter(), _restoreMask);
+
+    if (calls > 0)
+        LOG_TRACE("Restored game state on {:X} with {} calls", (size_t) _list, calls);
+}
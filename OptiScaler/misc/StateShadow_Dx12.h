@@ -0,0 +1,167 @@
+#pragma once
+#include <pch.h>
+
+#include "CommandListSlots_Dx12.h"
+
+#include <d3d12.h>
+
+#include <array>
+#include <vector>
+
+enum StateShadowRestore : uint32_t
+{
+    StateShadowRestore_None = 0,
+    StateShadowRestore_Compute = 1 << 0,  // Compute root signature and arguments
+    StateShadowRestore_Graphics = 1 << 1, // Graphics root signature, arguments and topology
+};
+
+// Calls used to put the game's state back, the hooks pass the original functions
+// so restoring doesn't go through the shadow again. Can be pointed to a recording
+// fake to check what a restore does without a device.
+struct StateShadowWriter
+{
+    void (*SetDescriptorHeaps)(ID3D12GraphicsCommandList* list, UINT count, ID3D12DescriptorHeap* const* heaps);
+    void (*SetPipelineState)(ID3D12GraphicsCommandList* list, ID3D12PipelineState* pso);
+    void (*IASetPrimitiveTopology)(ID3D12GraphicsCommandList* list, D3D12_PRIMITIVE_TOPOLOGY topology);
+
+    // Index 0 is compute, 1 is graphics
+    void (*SetRootSignature[2])(ID3D12GraphicsCommandList* list, ID3D12RootSignature* signature);
+    void (*SetRootDescriptorTable[2])(ID3D12GraphicsCommandList* list, UINT index, D3D12_GPU_DESCRIPTOR_HANDLE table);
+    void (*SetRoot32BitConstants[2])(ID3D12GraphicsCommandList* list, UINT index, UINT count, const void* data,
+                                     UINT offset);
+    void (*SetRootConstantBufferView[2])(ID3D12GraphicsCommandList* list, UINT index, D3D12_GPU_VIRTUAL_ADDRESS va);
+    void (*SetRootShaderResourceView[2])(ID3D12GraphicsCommandList* list, UINT index, D3D12_GPU_VIRTUAL_ADDRESS va);
+    void (*SetRootUnorderedAccessView[2])(ID3D12GraphicsCommandList* list, UINT index, D3D12_GPU_VIRTUAL_ADDRESS va);
+};
+
+// Last state the game set on a command list and what OptiScaler changed on top of it.
+// Calls made between BeginWork and EndWork only mark the state dirty, Restore then
+// sets back just the dirty parts. One shadow is kept in the slot storage of each
+// command list, so it goes away with the list.
+class StateShadow_Dx12
+{
+  public:
+    enum Pipeline : uint8_t
+    {
+        Compute = 0,
+        Graphics = 1,
+    };
+
+    enum class ArgumentType : uint8_t
+    {
+        None,
+        Table,
+        Constants,
+        CBV,
+        SRV,
+        UAV,
+    };
+
+    static constexpr UINT MaxRootParameters = 64;
+    static constexpr UINT MaxRootConstants = 64;
+
+    struct Argument
+    {
+        ArgumentType type = ArgumentType::None;
+        UINT64 value = 0;               // Table handle or buffer address
+        uint64_t constantsMask = 0;     // Which of the 32 bit values are known
+        std::vector<UINT> constants {}; // Indexed by the destination offset
+    };
+
+    struct PipelineState
+    {
+        ID3D12RootSignature* rootSignature = nullptr;
+        std::array<Argument, MaxRootParameters> arguments {};
+        uint64_t boundMask = 0; // Arguments the game set since its root signature
+
+        // What is bound now, differs from the game's values while OptiScaler is working
+        ID3D12RootSignature* currentSignature = nullptr;
+        bool argumentsLost = false; // Root signature was changed, every argument is gone
+        uint64_t dirtyMask = 0;     // Arguments OptiScaler set
+    };
+
+  private:
+    struct Heaps
+    {
+        std::array<ID3D12DescriptorHeap*, 2> heaps {};
+        UINT count = 0;
+
+        bool operator==(const Heaps&) const = default;
+    };
+
+    // Game's values, null or undefined when not known
+    Heaps _heaps {};
+    bool _heapsKnown = false;
+    ID3D12PipelineState* _pso = nullptr;
+    D3D12_PRIMITIVE_TOPOLOGY _topology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+
+    // What is bound now
+    Heaps _currentHeaps {};
+    ID3D12PipelineState* _currentPso = nullptr;
+    D3D12_PRIMITIVE_TOPOLOGY _currentTopology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+
+    std::array<PipelineState, 2> _pipelines {};
+
+    uint32_t _workDepth = 0;
+
+    Argument* BeginArgument(Pipeline pipeline, UINT index);
+    uint32_t RestoreArgument(ID3D12GraphicsCommandList* list, const StateShadowWriter& writer, Pipeline pipeline,
+                             UINT index, const Argument& argument) const;
+
+  public:
+    // Reset and ClearState, everything but the initial pipeline state is cleared
+    void Reset(ID3D12PipelineState* initialState);
+
+    void SetDescriptorHeaps(UINT count, ID3D12DescriptorHeap* const* heaps);
+    void SetPipelineState(ID3D12PipelineState* pso);
+    void SetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY topology);
+    void SetRootSignature(Pipeline pipeline, ID3D12RootSignature* signature);
+    void SetRootDescriptorTable(Pipeline pipeline, UINT index, D3D12_GPU_DESCRIPTOR_HANDLE table);
+    void SetRoot32BitConstants(Pipeline pipeline, UINT index, UINT count, const void* data, UINT offset);
+    void SetRootView(Pipeline pipeline, UINT index, ArgumentType type, D3D12_GPU_VIRTUAL_ADDRESS va);
+
+    void BeginWork() { _workDepth++; }
+    bool InWork() const { return _workDepth > 0; }
+
+    // Ends OptiScaler's work, the outermost one restores what was changed and returns the number of calls made
+    uint32_t EndWork(ID3D12GraphicsCommandList* list, const StateShadowWriter& writer, uint32_t restoreMask);
+
+    // Sets back the changed state which is known and in the restore mask, dirty flags are cleared
+    uint32_t Restore(ID3D12GraphicsCommandList* list, const StateShadowWriter& writer, uint32_t restoreMask);
+
+    const PipelineState& GetPipeline(Pipeline pipeline) const { return _pipelines[pipeline]; }
+
+    // Shadow attached to the list, created on first use
+    static StateShadow_Dx12* Get(ID3D12GraphicsCommandList* list);
+
+    // Shadow of the list if OptiScaler worked on it before, the setter hooks only update existing ones
+    static StateShadow_Dx12* Find(ID3D12GraphicsCommandList* list);
+
+    // Restore mask picked by RestoreComputeSignature and RestoreGraphicSignature
+    static uint32_t RestoreMask();
+
+    // Hooks the state setters of the command list vtable
+    static void Hook(ID3D12GraphicsCommandList* list);
+    static void Unhook();
+
+    static bool IsHooked();
+    static const StateShadowWriter& OriginalWriter();
+};
+
+// Marks the OptiScaler work recorded on a game command list, restores the
+// state the game had when it goes out of scope. Does nothing if the mask is none
+// or the hooks aren't installed. The shadow of a list is created by its first
+// scope, state the game set on the list before that is not known and not restored.
+class StateShadowScope_Dx12
+{
+    ID3D12GraphicsCommandList* _list = nullptr;
+    StateShadow_Dx12* _shadow = nullptr;
+    uint32_t _restoreMask = StateShadowRestore_None;
+
+  public:
+    StateShadowScope_Dx12(ID3D12GraphicsCommandList* list, uint32_t restoreMask);
+    ~StateShadowScope_Dx12();
+
+    StateShadowScope_Dx12(const StateShadowScope_Dx12&) = delete;
+    StateShadowScope_Dx12& operator=(const StateShadowScope_Dx12&) = delete;
+};
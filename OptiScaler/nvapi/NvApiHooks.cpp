@@ -5,6 +5,7 @@
 #include <Config.h>
 
 #include <proxies/KernelBase_Proxy.h>
+#include <hooks/Vulkan_Hooks.h>
 
 #include <detours/detours.h>
 
@@ -24,6 +25,7 @@ NvAPI_Status __stdcall NvApiHooks::hkNvAPI_GPU_GetArchInfo(NvPhysicalGpuHandle h
         if (pGpuArchInfo->architecture_id <= NV_GPU_ARCHITECTURE_GP100)
         {
             State::Instance().isPascalOrOlder = true;
+            VulkanHooks::UpdateBarrierRules();
 
             // Check if values were volatile, override them if so
             // if (!Config::Instance()->StreamlineSpoofing.value_for_config().has_value())
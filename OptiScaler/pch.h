@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <libloaderapi.h>
 #include <ranges>
+#include <atomic>
 
 #include <winternl.h>
 #include <d3dkmthk.h>
@@ -65,31 +66,54 @@ inline HMODULE d3d12AgilityModule = nullptr;
 inline HMODULE slInterposerModule = nullptr;
 inline DWORD processId;
 
-#define LOG_TRACE(msg, ...) spdlog::trace(__FUNCTION__ " " msg, ##__VA_ARGS__)
+#include "LogGate.h"
 
-#define LOG_DEBUG(msg, ...) spdlog::debug(__FUNCTION__ " " msg, ##__VA_ARGS__)
+#define LOG_CATEGORY LogCategory::General
+
+#define LOG_AT(logLevel, msg, ...)                                                                                     \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (LogGate::Enabled(LOG_CATEGORY, logLevel))                                                                  \
+            LogGate::Logger()->log((spdlog::level::level_enum) logLevel, __FUNCTION__ " " msg, ##__VA_ARGS__);         \
+    } while (false)
+
+// Compiles trace logs out completely
+// #define LOG_STRIP_TRACE
+
+#ifdef LOG_STRIP_TRACE
+#define LOG_TRACE(msg, ...)
+#define LOG_FUNC()
+#define LOG_FUNC_RESULT(result)
+#else
+#define LOG_TRACE(msg, ...) LOG_AT(SPDLOG_LEVEL_TRACE, msg, ##__VA_ARGS__)
+#define LOG_FUNC()                                                                                                     \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (LogGate::Enabled(LOG_CATEGORY, SPDLOG_LEVEL_TRACE))                                                        \
+            LogGate::Logger()->trace(__FUNCTION__);                                                                    \
+    } while (false)
+#define LOG_FUNC_RESULT(result) LOG_AT(SPDLOG_LEVEL_TRACE, "result: {0:X}", (UINT64) result)
+#endif
+
+#define LOG_DEBUG(msg, ...) LOG_AT(SPDLOG_LEVEL_DEBUG, msg, ##__VA_ARGS__)
 
 #ifdef DETAILED_DEBUG_LOGS
-#define LOG_DEBUG_ONLY(msg, ...) spdlog::debug(__FUNCTION__ " " msg, ##__VA_ARGS__)
+#define LOG_DEBUG_ONLY(msg, ...) LOG_AT(SPDLOG_LEVEL_DEBUG, msg, ##__VA_ARGS__)
 #else
 #define LOG_DEBUG_ONLY(msg, ...)
 #endif
 
 #ifdef LOG_ASYNC
-#define LOG_DEBUG_ASYNC(msg, ...) spdlog::debug(__FUNCTION__ " " msg, ##__VA_ARGS__)
+#define LOG_DEBUG_ASYNC(msg, ...) LOG_AT(SPDLOG_LEVEL_DEBUG, msg, ##__VA_ARGS__)
 #else
 #define LOG_DEBUG_ASYNC(msg, ...)
 #endif
 
-#define LOG_INFO(msg, ...) spdlog::info(__FUNCTION__ " " msg, ##__VA_ARGS__)
-
-#define LOG_WARN(msg, ...) spdlog::warn(__FUNCTION__ " " msg, ##__VA_ARGS__)
-
-#define LOG_ERROR(msg, ...) spdlog::error(__FUNCTION__ " " msg, ##__VA_ARGS__)
+#define LOG_INFO(msg, ...) LOG_AT(SPDLOG_LEVEL_INFO, msg, ##__VA_ARGS__)
 
-#define LOG_FUNC() spdlog::trace(__FUNCTION__)
+#define LOG_WARN(msg, ...) LOG_AT(SPDLOG_LEVEL_WARN, msg, ##__VA_ARGS__)
 
-#define LOG_FUNC_RESULT(result) spdlog::trace(__FUNCTION__ " result: {0:X}", (UINT64) result)
+#define LOG_ERROR(msg, ...) LOG_AT(SPDLOG_LEVEL_ERROR, msg, ##__VA_ARGS__)
 
 // #define TRACKING_LOGS
 
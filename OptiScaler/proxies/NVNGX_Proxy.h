@@ -10,6 +10,9 @@
 
 #include "nvapi/NvApiHooks.h"
 
+#include <misc/ModuleVersionCache.h>
+#include <misc/StartupScheduler.h>
+
 #include "detours/detours.h"
 
 #include <filesystem>
@@ -162,9 +165,40 @@ inline static void UnhookApis()
 typedef uint32_t (*PFN_NVSDK_NGX_GetSnippetVersion)(void);
 static feature_version GetVersionUsingNGXSnippet(const std::vector<std::string>& dlls)
 {
+    static constexpr std::string_view SnippetVersionKey = "NGXSnippetVersion";
+
     uint32_t highestVersion = 0;
     for (const auto& dll : dlls)
     {
+        // Loaded module or the full path of an OTA snippet, the version of a known file is
+        // taken from the cache and files without the export aren't loaded at all
+        std::filesystem::path path;
+
+        if (auto module = GetModuleHandleA(dll.c_str()); module != nullptr)
+        {
+            wchar_t modulePath[MAX_PATH];
+
+            if (GetModuleFileNameW(module, modulePath, MAX_PATH) != 0)
+                path = modulePath;
+        }
+        else if (std::filesystem::path(dll).is_absolute())
+        {
+            path = string_to_wstring(dll);
+        }
+
+        if (!path.empty())
+        {
+            if (auto cached = ModuleVersionCache::Value(path, SnippetVersionKey); cached.has_value())
+            {
+                LOG_TRACE("Snippet version of {} from cache: {:X}", dll, cached.value());
+                highestVersion = std::max((uint32_t) cached.value(), highestVersion);
+                continue;
+            }
+
+            if (!ModuleVersionCache::HasExport(path, "NVSDK_NGX_GetSnippetVersion"))
+                continue;
+        }
+
         PFN_NVSDK_NGX_GetSnippetVersion _GetSnippetVersion =
             (PFN_NVSDK_NGX_GetSnippetVersion) DetourFindFunction(dll.c_str(), "NVSDK_NGX_GetSnippetVersion");
         if (_GetSnippetVersion)
@@ -172,6 +206,9 @@ static feature_version GetVersionUsingNGXSnippet(const std::vector<std::string>&
             LOG_TRACE("_GetSnippetVersion ptr from {}: {:X}", dll, (ULONG64) _GetSnippetVersion);
             uint32_t version = _GetSnippetVersion();
             highestVersion = std::max(version, highestVersion);
+
+            if (!path.empty())
+                ModuleVersionCache::SetValue(path, SnippetVersionKey, version);
         }
     }
 
@@ -673,6 +710,9 @@ class NVNGXProxy
 
     static bool IsNVNGXInited()
     {
+        // DLSSEnabled is decided on the startup worker
+        StartupScheduler::Instance().Wait(StartupSteps::DlssFiles);
+
         return _dll != nullptr && (_dx11Inited || _dx12Inited || _vulkanInited) &&
                Config::Instance()->DLSSEnabled.value_or_default();
     }
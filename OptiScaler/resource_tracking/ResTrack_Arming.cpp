@@ -0,0 +1,77 @@
+#include "ResTrack_Arming.h"
+
+uint32_t ResTrackArming::Wanted(const ResTrackArmingInputs& inputs)
+{
+    uint32_t wanted = ResTrackHook_None;
+
+    auto fgRunning = inputs.fgEnabled && inputs.fgOutputActive;
+
+    if (fgRunning)
+        wanted |= ResTrackHook_Submission;
+
+    auto hudfix = fgRunning && inputs.upscalerInput && inputs.hudfix;
+
+    if (hudfix || inputs.alwaysTrackHeaps)
+        wanted |= ResTrackHook_CopyDescriptors;
+
+    if (!hudfix)
+        return wanted;
+
+    if (!inputs.disableOM)
+        wanted |= ResTrackHook_OMSetRenderTargets;
+
+    if (!inputs.disableSGR)
+        wanted |= ResTrackHook_SetGraphicsRootDescriptorTable;
+
+    if (!inputs.disableSCR)
+        wanted |= ResTrackHook_SetComputeRootDescriptorTable;
+
+    // Draws and dispatches only check what the hooks above recorded
+    auto tracking = (wanted & (ResTrackHook_OMSetRenderTargets | ResTrackHook_SetGraphicsRootDescriptorTable |
+                               ResTrackHook_SetComputeRootDescriptorTable)) != 0;
+
+    if (!tracking)
+        return wanted;
+
+    if (!inputs.disableDI)
+        wanted |= ResTrackHook_DrawInstanced;
+
+    if (!inputs.disableDII)
+        wanted |= ResTrackHook_DrawIndexedInstanced;
+
+    if (!inputs.disableDispatch)
+        wanted |= ResTrackHook_Dispatch;
+
+    return wanted;
+}
+
+ResTrackArmingPlan ResTrackArming::Update(const ResTrackArmingInputs& inputs)
+{
+    ResTrackArmingPlan plan {};
+
+    auto wanted = Wanted(inputs);
+    auto armed = Armed();
+
+    plan.arm = wanted & ~armed;
+
+    auto unneeded = armed & ~wanted;
+
+    if (unneeded == ResTrackHook_None)
+        _unneededFrames = 0;
+    else if (++_unneededFrames >= SettleFrames)
+    {
+        plan.disarm = unneeded;
+        _unneededFrames = 0;
+    }
+
+    if (!plan.Empty())
+        _armed.store((armed | plan.arm) & ~plan.disarm, std::memory_order_relaxed);
+
+    return plan;
+}
+
+void ResTrackArming::Reset()
+{
+    _armed.store(ResTrackHook_None, std::memory_order_relaxed);
+    _unneededFrames = 0;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <pch.h>
+
+// Resource tracking hooks which only do their work while something needs them
+enum ResTrackHook : uint32_t
+{
+    ResTrackHook_None = 0,
+    ResTrackHook_CopyDescriptors = 1 << 0, // CopyDescriptors and CopyDescriptorsSimple
+    ResTrackHook_Submission = 1 << 1,      // ExecuteCommandLists, Close and ExecuteBundle
+    ResTrackHook_OMSetRenderTargets = 1 << 2,
+    ResTrackHook_SetGraphicsRootDescriptorTable = 1 << 3,
+    ResTrackHook_SetComputeRootDescriptorTable = 1 << 4,
+    ResTrackHook_DrawInstanced = 1 << 5,
+    ResTrackHook_DrawIndexedInstanced = 1 << 6,
+    ResTrackHook_Dispatch = 1 << 7,
+
+    ResTrackHook_All = (1 << 8) - 1,
+};
+
+struct ResTrackArmingInputs
+{
+    bool fgEnabled = false;
+    bool fgOutputActive = false; // An FG output is created
+    bool upscalerInput = false;  // OptiFG inputs, the only ones using hudfix
+    bool hudfix = false;
+    bool alwaysTrackHeaps = false;
+
+    bool disableOM = false;
+    bool disableSGR = false;
+    bool disableSCR = false;
+    bool disableDI = false;
+    bool disableDII = false;
+    bool disableDispatch = false;
+};
+
+struct ResTrackArmingPlan
+{
+    uint32_t arm = ResTrackHook_None;
+    uint32_t disarm = ResTrackHook_None;
+
+    bool Empty() const { return arm == ResTrackHook_None && disarm == ResTrackHook_None; }
+};
+
+// Decides which hooks are armed. The hooks stay attached and pass through to the original while
+// disarmed, Detours only suspends the calling thread so patching at runtime could catch another
+// render thread inside the patched code. Hooks are armed as soon as they are needed and disarmed
+// only after they weren't needed for a few frames, so a short FG pause doesn't stop following
+// the descriptor copies. Has no hooks of its own.
+class ResTrackArming
+{
+    std::atomic<uint32_t> _armed = ResTrackHook_None;
+    uint32_t _unneededFrames = 0;
+
+  public:
+    static constexpr uint32_t SettleFrames = 30;
+
+    static uint32_t Wanted(const ResTrackArmingInputs& inputs);
+
+    // Called once per frame from the present thread, applies the plan to the armed mask
+    ResTrackArmingPlan Update(const ResTrackArmingInputs& inputs);
+    void Reset();
+
+    // Read by the hooks on any thread
+    bool IsArmed(ResTrackHook hook) const { return (_armed.load(std::memory_order_relaxed) & hook) != 0; }
+    uint32_t Armed() const { return _armed.load(std::memory_order_relaxed); }
+};
@@ -5,6 +5,9 @@
 #include <Util.h>
 
 #include <menu/menu_overlay_dx.h>
+#include <misc/CommandListSlots_Dx12.h>
+#include <hooks/HookRegistry.h>
+#include <upscalers/FeatureProvider_Dx12.h>
 
 #include <algorithm>
 #include <future>
@@ -17,6 +20,9 @@
 #include <Unknwn.h> // or <objbase.h> to get STDMETHODCALLTYPE
 #endif
 
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::ResTrack
+
 // Device hooks for FG
 typedef void(STDMETHODCALLTYPE* PFN_CreateRenderTargetView)(ID3D12Device* This, ID3D12Resource* pResource,
                                                             D3D12_RENDER_TARGET_VIEW_DESC* pDesc,
@@ -80,7 +86,6 @@ typedef HRESULT(STDMETHODCALLTYPE* PFN_Close)(ID3D12GraphicsCommandList* This);
 typedef void(STDMETHODCALLTYPE* PFN_ExecuteCommandLists)(ID3D12CommandQueue* This, UINT NumCommandLists,
                                                          ID3D12CommandList* const* ppCommandLists);
 
-typedef ULONG(STDMETHODCALLTYPE* PFN_Release)(ID3D12Resource* This);
 
 // Original method calls for device
 static PFN_CreateRenderTargetView o_CreateRenderTargetView = nullptr;
@@ -103,7 +108,52 @@ static PFN_ExecuteBundle o_ExecuteBundle = nullptr;
 static PFN_Close o_Close = nullptr;
 
 static PFN_ExecuteCommandLists o_ExecuteCommandLists = nullptr;
-static PFN_Release o_Release = nullptr;
+
+// Hook registry groups, all of them are attached once with the device. The armed groups pass through
+// while disarmed.
+static constexpr std::string_view DeviceHooks = "ResTrack.Device";
+static constexpr std::string_view HeapHooks = "ResTrack.Heap";
+
+struct ArmedGroup
+{
+    ResTrackHook hook;
+    std::string_view group;
+};
+
+static constexpr ArmedGroup ArmedGroups[] = {
+    { ResTrackHook_CopyDescriptors, "ResTrack.CopyDescriptors" },
+    { ResTrackHook_Submission, "ResTrack.Submission" },
+    { ResTrackHook_OMSetRenderTargets, "ResTrack.OMSetRenderTargets" },
+    { ResTrackHook_SetGraphicsRootDescriptorTable, "ResTrack.SetGraphicsRootDescriptorTable" },
+    { ResTrackHook_SetComputeRootDescriptorTable, "ResTrack.SetComputeRootDescriptorTable" },
+    { ResTrackHook_DrawInstanced, "ResTrack.DrawInstanced" },
+    { ResTrackHook_DrawIndexedInstanced, "ResTrack.DrawIndexedInstanced" },
+    { ResTrackHook_Dispatch, "ResTrack.Dispatch" },
+};
+
+static constexpr std::string_view ArmedGroupName(ResTrackHook hook)
+{
+    for (auto& armed : ArmedGroups)
+    {
+        if (armed.hook == hook)
+            return armed.group;
+    }
+
+    return {};
+}
+
+static std::vector<std::string_view> ArmedGroupNames(uint32_t hooks)
+{
+    std::vector<std::string_view> result;
+
+    for (auto& armed : ArmedGroups)
+    {
+        if ((hooks & armed.hook) != 0)
+            result.push_back(armed.group);
+    }
+
+    return result;
+}
 
 static PFN_OMSetRenderTargets o_OMSetRenderTargets = nullptr;
 static PFN_SetGraphicsRootDescriptorTable o_SetGraphicsRootDescriptorTable = nullptr;
@@ -114,6 +164,19 @@ static ankerl::unordered_dense::map<ID3D12GraphicsCommandList*,
                                     ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo>>
     fgPossibleHudless[BUFFER_COUNT];
 
+// Possible hudless resources a command list used, kept in the list's slot storage. Frames are
+// stamped with their present frame instead of being cleared, so only the recording thread touches them.
+struct PossibleHudlessSlot final : CommandListSlotData
+{
+    struct Frame
+    {
+        UINT64 presentFrame = 0;
+        ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> resources;
+    };
+
+    std::array<Frame, BUFFER_COUNT> frames {};
+};
+
 // heaps section
 
 // #define USE_SPINLOCK_MUTEX_FOR_HEAP_CREATION
@@ -562,6 +625,145 @@ bool ResTrack_Dx12::IsHudFixActive()
     return true;
 }
 
+void ResTrack_Dx12::TrackPossibleHudless(ID3D12GraphicsCommandList* cmdList, size_t fIndex,
+                                         const ResourceInfo& resource)
+{
+    if (auto slot = CommandListSlots_Dx12::Get<PossibleHudlessSlot>(cmdList, CommandListSlot::PossibleHudless))
+    {
+        auto& frame = slot->frames[fIndex];
+        auto presentFrame = Hudfix_Dx12::ActivePresentFrame();
+
+        if (frame.presentFrame != presentFrame)
+        {
+            frame.resources.clear();
+            frame.resources.reserve(32);
+            frame.presentFrame = presentFrame;
+        }
+
+        frame.resources.insert_or_assign(resource.buffer, resource);
+        return;
+    }
+
+    // List storage couldn't be attached, use the shared maps
+    if (!_useShards)
+    {
+        std::lock_guard<std::mutex> lock(_hudlessTrackMutex);
+
+        if (!fgPossibleHudless[fIndex].contains(cmdList))
+        {
+            ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> newMap;
+            newMap.reserve(32);
+            fgPossibleHudless[fIndex].insert_or_assign(cmdList, std::move(newMap));
+        }
+
+        fgPossibleHudless[fIndex][cmdList].insert_or_assign(resource.buffer, resource);
+    }
+    else
+    {
+        size_t shardIdx = GetShardIndex(cmdList);
+        auto& shard = _hudlessShards[fIndex][shardIdx];
+
+#ifdef USE_SPINLOCK_MUTEX
+        std::lock_guard<SpinLock> lock(shard.mutex);
+#else
+        std::lock_guard<std::mutex> lock(shard.mutex);
+#endif
+
+        if (!shard.map.contains(cmdList))
+        {
+            ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> newMap;
+            newMap.reserve(32);
+            shard.map.insert_or_assign(cmdList, std::move(newMap));
+        }
+
+        shard.map[cmdList].insert_or_assign(resource.buffer, resource);
+    }
+}
+
+bool ResTrack_Dx12::TakePossibleHudless(ID3D12GraphicsCommandList* cmdList, size_t fIndex,
+                                        ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo>& resources)
+{
+    // Lists which never tracked anything don't get storage attached, the maps are only used when it failed
+    if (auto slot = CommandListSlots_Dx12::Find<PossibleHudlessSlot>(cmdList, CommandListSlot::PossibleHudless))
+    {
+        auto& frame = slot->frames[fIndex];
+
+        if (frame.presentFrame != Hudfix_Dx12::ActivePresentFrame() || frame.resources.empty())
+            return false;
+
+        resources = std::move(frame.resources);
+        frame.resources.clear();
+        return true;
+    }
+
+    if (!_useShards)
+    {
+        if (fgPossibleHudless[fIndex].size() == 0)
+            return false;
+
+        std::lock_guard<std::mutex> lock(_hudlessTrackMutex);
+
+        if (!fgPossibleHudless[fIndex].contains(cmdList))
+            return false;
+
+        resources = std::move(fgPossibleHudless[fIndex][cmdList]);
+        fgPossibleHudless[fIndex].erase(cmdList);
+        return true;
+    }
+
+    size_t shardIdx = GetShardIndex(cmdList);
+    auto& shard = _hudlessShards[fIndex][shardIdx];
+
+    // if can't find output skip
+    if (shard.map.size() == 0)
+    {
+        LOG_DEBUG_ONLY("Early exit");
+        return false;
+    }
+
+#ifdef USE_SPINLOCK_MUTEX
+    std::lock_guard<SpinLock> lock(shard.mutex);
+#else
+    std::lock_guard<std::mutex> lock(shard.mutex);
+#endif
+
+    if (!shard.map.contains(cmdList))
+        return false;
+
+    resources = std::move(shard.map[cmdList]);
+    shard.map.erase(cmdList);
+    return true;
+}
+
+void ResTrack_Dx12::DropPossibleHudless(ID3D12GraphicsCommandList* cmdList, size_t fIndex)
+{
+    if (auto slot = CommandListSlots_Dx12::Find<PossibleHudlessSlot>(cmdList, CommandListSlot::PossibleHudless))
+    {
+        slot->frames[fIndex].resources.clear();
+        return;
+    }
+
+    if (!_useShards)
+    {
+        std::lock_guard<std::mutex> lock(_hudlessTrackMutex);
+        fgPossibleHudless[fIndex].erase(cmdList);
+        return;
+    }
+
+    auto& shard = _hudlessShards[fIndex][GetShardIndex(cmdList)];
+
+    if (shard.map.contains(cmdList))
+    {
+#ifdef USE_SPINLOCK_MUTEX
+        std::lock_guard<SpinLock> lock(shard.mutex);
+#else
+        std::lock_guard<std::mutex> lock(shard.mutex);
+#endif
+
+        shard.map.erase(cmdList);
+    }
+}
+
 #pragma endregion
 
 #pragma region Resource input hooks
@@ -736,6 +938,14 @@ void ResTrack_Dx12::hkCreateUnorderedAccessView(ID3D12Device* This, ID3D12Resour
 void ResTrack_Dx12::hkExecuteCommandLists(ID3D12CommandQueue* This, UINT NumCommandLists,
                                           ID3D12CommandList* const* ppCommandLists)
 {
+    FeatureProvider_Dx12::OnExecute(This, NumCommandLists, ppCommandLists);
+
+    if (!_arming.IsArmed(ResTrackHook_Submission))
+    {
+        o_ExecuteCommandLists(This, NumCommandLists, ppCommandLists);
+        return;
+    }
+
     auto fg = State::Instance().currentFG;
 
     if (fg != nullptr && fg->IsActive() && !fg->IsPaused())
@@ -837,28 +1047,7 @@ static ULONG STDMETHODCALLTYPE hkHeapRelease(ID3D12DescriptorHeap* This)
             LOG_INFO("Heap released: {:X}", (size_t) This);
 
             // detach all slots from _trackedResources
-            {
-                std::scoped_lock lk(_trackedResourcesMutex);
-
-                for (UINT j = 0; j < up->numDescriptors; ++j)
-                {
-                    auto& slot = up->info[j];
-
-                    if (slot.buffer == nullptr)
-                        continue;
-
-                    if (auto it = _trackedResources.find(slot.buffer); it != _trackedResources.end())
-                    {
-                        auto& vec = it->second;
-                        vec.erase(std::remove(vec.begin(), vec.end(), &slot), vec.end());
-                        if (vec.empty())
-                            _trackedResources.erase(it);
-                    }
-
-                    slot.buffer = nullptr;
-                    slot.lastUsedFrame = 0;
-                }
-            }
+            up->DetachAll();
 
             gHeapGeneration.fetch_add(1, std::memory_order_release); // invalidate caches
         }
@@ -887,10 +1076,10 @@ HRESULT ResTrack_Dx12::hkCreateDescriptorHeap(ID3D12Device* This, D3D12_DESCRIPT
         {
             PVOID* vtbl = *(PVOID**) heap;
             o_HeapRelease = (PFN_HeapRelease) vtbl[2];
-            DetourTransactionBegin();
-            DetourUpdateThread(GetCurrentThread());
-            DetourAttach(&(PVOID&) o_HeapRelease, hkHeapRelease);
-            DetourTransactionCommit();
+
+            auto& registry = HookRegistry::Instance();
+            registry.Declare(HeapHooks, "Release", &(PVOID&) o_HeapRelease, hkHeapRelease);
+            registry.Install(HeapHooks);
         }
 
         auto increment = This->GetDescriptorHandleIncrementSize(pDescriptorHeapDesc->Type);
@@ -954,37 +1143,33 @@ HRESULT ResTrack_Dx12::hkCreateDescriptorHeap(ID3D12Device* This, D3D12_DESCRIPT
     return result;
 }
 
-ULONG ResTrack_Dx12::hkRelease(ID3D12Resource* This)
+void ResTrack_Dx12::OnResourceDestroyed(ID3D12Resource* resource)
 {
     if (State::Instance().isShuttingDown)
-        return o_Release(This);
+        return;
 
     std::vector<ResourceInfo*> toClean;
     {
         std::lock_guard lock(_trackedResourcesMutex);
 
-        This->AddRef();
-        auto refCount = o_Release(This);
+        auto it = _trackedResources.find(resource);
 
-        if (refCount <= 1 && _trackedResources.contains(This))
-        {
-            toClean = _trackedResources[This]; // Copy vector
-            _trackedResources.erase(This);
-        }
+        if (it == _trackedResources.end())
+            return;
+
+        toClean = std::move(it->second);
+        _trackedResources.erase(it);
     }
 
     // Clean up outside lock
     for (auto* info : toClean)
     {
-        if (info->buffer == This)
+        if (info->buffer == resource)
         {
             info->buffer = nullptr;
             info->lastUsedFrame = 0;
         }
     }
-
-    State::Instance().CapturedHudlesses.erase(This);
-    return o_Release(This);
 }
 
 void ResTrack_Dx12::hkCopyDescriptors(ID3D12Device* This, UINT NumDestDescriptorRanges,
@@ -996,6 +1181,9 @@ void ResTrack_Dx12::hkCopyDescriptors(ID3D12Device* This, UINT NumDestDescriptor
     o_CopyDescriptors(This, NumDestDescriptorRanges, pDestDescriptorRangeStarts, pDestDescriptorRangeSizes,
                       NumSrcDescriptorRanges, pSrcDescriptorRangeStarts, pSrcDescriptorRangeSizes, DescriptorHeapsType);
 
+    if (!_arming.IsArmed(ResTrackHook_CopyDescriptors))
+        return;
+
     // Early exit conditions - consistent validation
     if (DescriptorHeapsType != D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV &&
         DescriptorHeapsType != D3D12_DESCRIPTOR_HEAP_TYPE_RTV)
@@ -1102,6 +1290,9 @@ void ResTrack_Dx12::hkCopyDescriptorsSimple(ID3D12Device* This, UINT NumDescript
     o_CopyDescriptorsSimple(This, NumDescriptors, DestDescriptorRangeStart, SrcDescriptorRangeStart,
                             DescriptorHeapsType);
 
+    if (!_arming.IsArmed(ResTrackHook_CopyDescriptors))
+        return;
+
     if (DescriptorHeapsType != D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV &&
         DescriptorHeapsType != D3D12_DESCRIPTOR_HEAP_TYPE_RTV)
         return;
@@ -1156,7 +1347,8 @@ void ResTrack_Dx12::hkSetGraphicsRootDescriptorTable(ID3D12GraphicsCommandList*
                                                      D3D12_GPU_DESCRIPTOR_HANDLE BaseDescriptor)
 {
     // Consistent early exit - always call original function
-    auto shouldTrack = !Config::Instance()->FGHudfixDisableSGR.value_or_default() && BaseDescriptor.ptr != 0 &&
+    auto shouldTrack = _arming.IsArmed(ResTrackHook_SetGraphicsRootDescriptorTable) &&
+                       !Config::Instance()->FGHudfixDisableSGR.value_or_default() && BaseDescriptor.ptr != 0 &&
                        IsHudFixActive() && !Hudfix_Dx12::SkipHudlessChecks() &&
                        This != MenuOverlayDx::MenuCommandList();
 
@@ -1200,43 +1392,10 @@ void ResTrack_Dx12::hkSetGraphicsRootDescriptorTable(ID3D12GraphicsCommandList*
     {
         auto fIndex = Hudfix_Dx12::ActivePresentFrame() % BUFFER_COUNT;
 
-        if (!_useShards)
-        {
-            std::lock_guard<std::mutex> lock(_hudlessTrackMutex);
-
-            if (!fgPossibleHudless[fIndex].contains(This))
-            {
-                ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> newMap;
-                newMap.reserve(32);
-                fgPossibleHudless[fIndex].insert_or_assign(This, std::move(newMap));
-            }
+        LOG_TRACK("CmdList: {:X}, Tracking Resource: {:X}, Desc: {:X}, Format: {}", (size_t) This,
+                  (size_t) capturedBuffer->buffer, BaseDescriptor.ptr, (UINT) capturedBuffer->format);
 
-            LOG_TRACK("Tracking Resource: {:X}, Desc: {:X}", (size_t) capturedBuffer->buffer, BaseDescriptor.ptr);
-            fgPossibleHudless[fIndex][This].insert_or_assign(capturedBuffer->buffer, *capturedBuffer);
-        }
-        else
-        {
-            size_t shardIdx = GetShardIndex(This);
-            auto& shard = _hudlessShards[fIndex][shardIdx];
-
-#ifdef USE_SPINLOCK_MUTEX
-            std::lock_guard<SpinLock> lock(shard.mutex);
-#else
-            std::lock_guard<std::mutex> lock(shard.mutex);
-#endif
-
-            if (!shard.map.contains(This))
-            {
-                ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> newMap;
-                newMap.reserve(32);
-                shard.map.insert_or_assign(This, std::move(newMap));
-            }
-
-            LOG_TRACK("CmdList: {:X}, Tracking Resource: {:X}, Desc: {:X}, Format: {}", (size_t) This,
-                      (size_t) capturedBuffer->buffer, BaseDescriptor.ptr, (UINT) capturedBuffer->format);
-
-            shard.map[This].insert_or_assign(capturedBuffer->buffer, *capturedBuffer);
-        }
+        TrackPossibleHudless(This, fIndex, *capturedBuffer);
     }
 
     o_SetGraphicsRootDescriptorTable(This, RootParameterIndex, BaseDescriptor);
@@ -1252,7 +1411,8 @@ void ResTrack_Dx12::hkOMSetRenderTargets(ID3D12GraphicsCommandList* This, UINT N
                                          D3D12_CPU_DESCRIPTOR_HANDLE* pDepthStencilDescriptor)
 {
     // Consistent early exit validation
-    auto shouldTrack = !Config::Instance()->FGHudfixDisableOM.value_or_default() && NumRenderTargetDescriptors > 0 &&
+    auto shouldTrack = _arming.IsArmed(ResTrackHook_OMSetRenderTargets) &&
+                       !Config::Instance()->FGHudfixDisableOM.value_or_default() && NumRenderTargetDescriptors > 0 &&
                        pRenderTargetDescriptors != nullptr && IsHudFixActive() && !Hudfix_Dx12::SkipHudlessChecks() &&
                        This != MenuOverlayDx::MenuCommandList();
 
@@ -1320,45 +1480,11 @@ void ResTrack_Dx12::hkOMSetRenderTargets(ID3D12GraphicsCommandList* This, UINT N
         // Track for later processing
         if (!capturedImmediately)
         {
-            if (!_useShards)
-            {
-                std::lock_guard<std::mutex> lock(_hudlessTrackMutex);
-
-                if (!fgPossibleHudless[fIndex].contains(This))
-                {
-                    ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> newMap;
-                    newMap.reserve(32);
-                    fgPossibleHudless[fIndex].insert_or_assign(This, std::move(newMap));
-                }
-
-                LOG_TRACK("Tracking Resource: {:X}, Desc: {:X}", (size_t) capturedBuffer->buffer, handle.ptr);
-                fgPossibleHudless[fIndex][This].insert_or_assign(capturedBuffer->buffer, *capturedBuffer);
-                anyResourceTracked = true;
-            }
-            else
-            {
-                size_t shardIdx = GetShardIndex(This);
-                auto& shard = _hudlessShards[fIndex][shardIdx];
-
-#ifdef USE_SPINLOCK_MUTEX
-                std::lock_guard<SpinLock> lock(shard.mutex);
-#else
-                std::lock_guard<std::mutex> lock(shard.mutex);
-#endif
-
-                if (!shard.map.contains(This))
-                {
-                    ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> newMap;
-                    newMap.reserve(32);
-                    shard.map.insert_or_assign(This, std::move(newMap));
-                }
-
-                LOG_TRACK("CmdList: {:X}, Tracking Resource: {:X}, Desc: {:X}, Format: {}", (size_t) This,
-                          (size_t) capturedBuffer->buffer, handle.ptr, (UINT) capturedBuffer->format);
+            LOG_TRACK("CmdList: {:X}, Tracking Resource: {:X}, Desc: {:X}, Format: {}", (size_t) This,
+                      (size_t) capturedBuffer->buffer, handle.ptr, (UINT) capturedBuffer->format);
 
-                shard.map[This].insert_or_assign(capturedBuffer->buffer, *capturedBuffer);
-                anyResourceTracked = true;
-            }
+            TrackPossibleHudless(This, fIndex, *capturedBuffer);
+            anyResourceTracked = true;
         }
     }
 
@@ -1374,7 +1500,8 @@ void ResTrack_Dx12::hkSetComputeRootDescriptorTable(ID3D12GraphicsCommandList* T
                                                     D3D12_GPU_DESCRIPTOR_HANDLE BaseDescriptor)
 {
     // Consistent early exit - always call original function
-    auto shouldTrack = !Config::Instance()->FGHudfixDisableSCR.value_or_default() && BaseDescriptor.ptr != 0 &&
+    auto shouldTrack = _arming.IsArmed(ResTrackHook_SetComputeRootDescriptorTable) &&
+                       !Config::Instance()->FGHudfixDisableSCR.value_or_default() && BaseDescriptor.ptr != 0 &&
                        IsHudFixActive() && !Hudfix_Dx12::SkipHudlessChecks() &&
                        This != MenuOverlayDx::MenuCommandList();
 
@@ -1422,43 +1549,10 @@ void ResTrack_Dx12::hkSetComputeRootDescriptorTable(ID3D12GraphicsCommandList* T
     {
         auto fIndex = Hudfix_Dx12::ActivePresentFrame() % BUFFER_COUNT;
 
-        if (!_useShards)
-        {
-            std::lock_guard<std::mutex> lock(_hudlessTrackMutex);
-
-            if (!fgPossibleHudless[fIndex].contains(This))
-            {
-                ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> newMap;
-                newMap.reserve(32);
-                fgPossibleHudless[fIndex].insert_or_assign(This, std::move(newMap));
-            }
-
-            LOG_TRACK("Tracking Resource: {:X}, Desc: {:X}", (size_t) capturedBuffer->buffer, BaseDescriptor.ptr);
-            fgPossibleHudless[fIndex][This].insert_or_assign(capturedBuffer->buffer, *capturedBuffer);
-        }
-        else
-        {
-            size_t shardIdx = GetShardIndex(This);
-            auto& shard = _hudlessShards[fIndex][shardIdx];
-
-#ifdef USE_SPINLOCK_MUTEX
-            std::lock_guard<SpinLock> lock(shard.mutex);
-#else
-            std::lock_guard<std::mutex> lock(shard.mutex);
-#endif
-
-            if (!shard.map.contains(This))
-            {
-                ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> newMap;
-                newMap.reserve(32);
-                shard.map.insert_or_assign(This, std::move(newMap));
-            }
-
-            LOG_TRACK("CmdList: {:X}, Tracking Resource: {:X}, Desc: {:X}, Format: {}", (size_t) This,
-                      (size_t) capturedBuffer->buffer, BaseDescriptor.ptr, (UINT) capturedBuffer->format);
+        LOG_TRACK("CmdList: {:X}, Tracking Resource: {:X}, Desc: {:X}, Format: {}", (size_t) This,
+                  (size_t) capturedBuffer->buffer, BaseDescriptor.ptr, (UINT) capturedBuffer->format);
 
-            shard.map[This].insert_or_assign(capturedBuffer->buffer, *capturedBuffer);
-        }
+        TrackPossibleHudless(This, fIndex, *capturedBuffer);
     }
 
     o_SetComputeRootDescriptorTable(This, RootParameterIndex, BaseDescriptor);
@@ -1474,7 +1568,7 @@ void ResTrack_Dx12::hkDrawInstanced(ID3D12GraphicsCommandList* This, UINT Vertex
 {
     o_DrawInstanced(This, VertexCountPerInstance, InstanceCount, StartVertexLocation, StartInstanceLocation);
 
-    if (!IsHudFixActive())
+    if (!_arming.IsArmed(ResTrackHook_DrawInstanced) || !IsHudFixActive())
     {
         LOG_TRACK("Skipping {:X}", (size_t) This);
         return;
@@ -1484,111 +1578,37 @@ void ResTrack_Dx12::hkDrawInstanced(ID3D12GraphicsCommandList* This, UINT Vertex
 
     auto fIndex = Hudfix_Dx12::ActivePresentFrame() % BUFFER_COUNT;
 
-    if (!_useShards)
+    if (This == MenuOverlayDx::MenuCommandList())
     {
-        if (This == MenuOverlayDx::MenuCommandList())
-        {
-            std::lock_guard<std::mutex> lock(_hudlessTrackMutex);
-            fgPossibleHudless[fIndex].erase(This);
-            return;
-        }
-
-        if (fgPossibleHudless[fIndex].size() == 0)
-            return;
-
-        ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> val0;
-        {
-            std::lock_guard<std::mutex> lock(_hudlessTrackMutex);
-
-            if (!fgPossibleHudless[fIndex].contains(This))
-                return;
-
-            val0 = std::move(fgPossibleHudless[fIndex][This]);
-            fgPossibleHudless[fIndex].erase(This);
-        }
-
-        do
-        {
-            // if this command list does not have entries skip
-            if (val0.size() == 0)
-                break;
-
-            if (Config::Instance()->FGHudfixDisableDI.value_or_default())
-                break;
-
-            for (auto& [key, val] : val0)
-            {
-                std::lock_guard<std::mutex> lock(_drawMutex);
+        DropPossibleHudless(This, fIndex);
+        return;
+    }
 
-                val.captureInfo |= CaptureInfo::DrawInstanced;
+    ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> val0;
 
-                if (Hudfix_Dx12::CheckForHudless(This, &val, val.state))
-                    break;
-            }
+    if (!TakePossibleHudless(This, fIndex, val0))
+        return;
 
-        } while (false);
-    }
-    else
+    do
     {
-        size_t shardIdx = GetShardIndex(This);
-        auto& shard = _hudlessShards[fIndex][shardIdx];
+        // if this command list does not have entries skip
+        if (val0.size() == 0)
+            break;
 
-        if (This == MenuOverlayDx::MenuCommandList() && shard.map.contains(This))
-        {
-#ifdef USE_SPINLOCK_MUTEX
-            std::lock_guard<SpinLock> lock(shard.mutex);
-#else
-            std::lock_guard<std::mutex> lock(shard.mutex);
-#endif
-
-            shard.map.erase(This);
-            return;
-        }
+        if (Config::Instance()->FGHudfixDisableDI.value_or_default())
+            break;
 
-        // if can't find output skip
-        if (shard.map.size() == 0)
+        for (auto& [key, val] : val0)
         {
-            LOG_DEBUG_ONLY("Early exit");
-            return;
-        }
+            std::lock_guard<std::mutex> lock(_drawMutex);
 
-        ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> val0;
-        {
+            val.captureInfo |= CaptureInfo::DrawInstanced;
 
-#ifdef USE_SPINLOCK_MUTEX
-            std::lock_guard<SpinLock> lock(shard.mutex);
-#else
-            std::lock_guard<std::mutex> lock(shard.mutex);
-#endif
-
-            if (!shard.map.contains(This))
-                return;
-
-            val0 = std::move(shard.map[This]);
-            shard.map.erase(This);
-        }
-
-        do
-        {
-            // if this command list does not have entries skip
-            if (val0.size() == 0)
-                break;
-
-            if (Config::Instance()->FGHudfixDisableDI.value_or_default())
+            if (Hudfix_Dx12::CheckForHudless(This, &val, val.state))
                 break;
+        }
 
-            for (auto& [key, val] : val0)
-            {
-                std::lock_guard<std::mutex> lock(_drawMutex);
-
-                val.captureInfo |= CaptureInfo::DrawInstanced;
-
-                if (Hudfix_Dx12::CheckForHudless(This, &val, val.state))
-                    break;
-            }
-
-        } while (false);
-    }
+    } while (false);
 }
 
 void ResTrack_Dx12::hkDrawIndexedInstanced(ID3D12GraphicsCommandList* This, UINT IndexCountPerInstance,
@@ -1598,7 +1618,7 @@ void ResTrack_Dx12::hkDrawIndexedInstanced(ID3D12GraphicsCommandList* This, UINT
     o_DrawIndexedInstanced(This, IndexCountPerInstance, InstanceCount, StartIndexLocation, BaseVertexLocation,
                            StartInstanceLocation);
 
-    if (!IsHudFixActive())
+    if (!_arming.IsArmed(ResTrackHook_DrawIndexedInstanced) || !IsHudFixActive())
     {
         LOG_TRACK("Skipping CmdList: {:X}", (size_t) This);
         return;
@@ -1608,117 +1628,48 @@ void ResTrack_Dx12::hkDrawIndexedInstanced(ID3D12GraphicsCommandList* This, UINT
 
     auto fIndex = Hudfix_Dx12::ActivePresentFrame() % BUFFER_COUNT;
 
-    if (!_useShards)
+    if (This == MenuOverlayDx::MenuCommandList())
     {
-        if (This == MenuOverlayDx::MenuCommandList())
-        {
-            std::lock_guard<std::mutex> lock(_hudlessTrackMutex);
-            fgPossibleHudless[fIndex].erase(This);
-            return;
-        }
-
-        if (fgPossibleHudless[fIndex].size() == 0)
-            return;
-
-        ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> val0;
-        {
-            std::lock_guard<std::mutex> lock(_hudlessTrackMutex);
-
-            if (!fgPossibleHudless[fIndex].contains(This))
-                return;
-
-            val0 = std::move(fgPossibleHudless[fIndex][This]);
-            fgPossibleHudless[fIndex].erase(This);
-        }
-
-        do
-        {
-            // if this command list does not have entries skip
-            if (val0.size() == 0)
-                break;
-
-            if (Config::Instance()->FGHudfixDisableDII.value_or_default())
-                break;
-
-            for (auto& [key, val] : val0)
-            {
-                // LOG_DEBUG("Waiting _drawMutex {:X}", (size_t)val.buffer);
-                std::lock_guard<std::mutex> lock(_drawMutex);
+        DropPossibleHudless(This, fIndex);
+        return;
+    }
 
-                val.captureInfo |= CaptureInfo::DrawIndexedInstanced;
+    ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> val0;
 
-                if (Hudfix_Dx12::CheckForHudless(This, &val, val.state))
-                    break;
-            }
+    if (!TakePossibleHudless(This, fIndex, val0))
+        return;
 
-        } while (false);
-    }
-    else
+    do
     {
-        size_t shardIdx = GetShardIndex(This);
-        auto& shard = _hudlessShards[fIndex][shardIdx];
-
-        if (This == MenuOverlayDx::MenuCommandList() && shard.map.contains(This))
-        {
-#ifdef USE_SPINLOCK_MUTEX
-            std::lock_guard<SpinLock> lock(shard.mutex);
-#else
-            std::lock_guard<std::mutex> lock(shard.mutex);
-#endif
-
-            shard.map.erase(This);
-            return;
-        }
+        // if this command list does not have entries skip
+        if (val0.size() == 0)
+            break;
 
-        // if can't find output skip
-        if (shard.map.size() == 0)
-        {
-            LOG_DEBUG_ONLY("Early exit");
-            return;
-        }
+        if (Config::Instance()->FGHudfixDisableDII.value_or_default())
+            break;
 
-        ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> val0;
+        for (auto& [key, val] : val0)
         {
+            // LOG_DEBUG("Waiting _drawMutex {:X}", (size_t)val.buffer);
+            std::lock_guard<std::mutex> lock(_drawMutex);
 
-#ifdef USE_SPINLOCK_MUTEX
-            std::lock_guard<SpinLock> lock(shard.mutex);
-#else
-            std::lock_guard<std::mutex> lock(shard.mutex);
-#endif
-
-            if (!shard.map.contains(This))
-                return;
-
-            val0 = std::move(shard.map[This]);
-            shard.map.erase(This);
-        }
-
-        do
-        {
-            // if this command list does not have entries skip
-            if (val0.size() == 0)
-                break;
+            val.captureInfo |= CaptureInfo::DrawIndexedInstanced;
 
-            if (Config::Instance()->FGHudfixDisableDII.value_or_default())
+            if (Hudfix_Dx12::CheckForHudless(This, &val, val.state))
                 break;
+        }
 
-            for (auto& [key, val] : val0)
-            {
-                // LOG_DEBUG("Waiting _drawMutex {:X}", (size_t)val.buffer);
-                std::lock_guard<std::mutex> lock(_drawMutex);
-
-                val.captureInfo |= CaptureInfo::DrawIndexedInstanced;
-
-                if (Hudfix_Dx12::CheckForHudless(This, &val, val.state))
-                    break;
-            }
-
-        } while (false);
-    }
+    } while (false);
 }
 
 void ResTrack_Dx12::hkExecuteBundle(ID3D12GraphicsCommandList* This, ID3D12GraphicsCommandList* pCommandList)
 {
+    if (!_arming.IsArmed(ResTrackHook_Submission))
+    {
+        o_ExecuteBundle(This, pCommandList);
+        return;
+    }
+
     LOG_WARN();
 
     IFGFeature_Dx12* fg = State::Instance().currentFG;
@@ -1754,6 +1705,9 @@ void ResTrack_Dx12::hkExecuteBundle(ID3D12GraphicsCommandList* This, ID3D12Graph
 
 HRESULT ResTrack_Dx12::hkClose(ID3D12GraphicsCommandList* This)
 {
+    if (!_arming.IsArmed(ResTrackHook_Submission))
+        return o_Close(This);
+
     auto fg = State::Instance().currentFG;
     auto index = fg != nullptr ? fg->GetIndex() : 0;
 
@@ -1795,7 +1749,7 @@ void ResTrack_Dx12::hkDispatch(ID3D12GraphicsCommandList* This, UINT ThreadGroup
 {
     o_Dispatch(This, ThreadGroupCountX, ThreadGroupCountY, ThreadGroupCountZ);
 
-    if (!IsHudFixActive())
+    if (!_arming.IsArmed(ResTrackHook_Dispatch) || !IsHudFixActive())
     {
         LOG_TRACK("Skipping {:X}", (size_t) This);
         return;
@@ -1805,150 +1759,42 @@ void ResTrack_Dx12::hkDispatch(ID3D12GraphicsCommandList* This, UINT ThreadGroup
 
     auto fIndex = Hudfix_Dx12::ActivePresentFrame() % BUFFER_COUNT;
 
-    if (!_useShards)
+    if (This == MenuOverlayDx::MenuCommandList())
     {
-        if (This == MenuOverlayDx::MenuCommandList())
-        {
-            std::lock_guard<std::mutex> lock(_hudlessTrackMutex);
-            fgPossibleHudless[fIndex].erase(This);
-            return;
-        }
-
-        if (fgPossibleHudless[fIndex].size() == 0)
-            return;
-
-        ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> val0;
-        {
-            std::lock_guard<std::mutex> lock(_hudlessTrackMutex);
-
-            if (!fgPossibleHudless[fIndex].contains(This))
-                return;
-
-            val0 = std::move(fgPossibleHudless[fIndex][This]);
-            fgPossibleHudless[fIndex].erase(This);
-        }
-
-        do
-        {
-            // if this command list does not have entries skip
-            if (val0.size() == 0)
-                break;
-
-            if (Config::Instance()->FGHudfixDisableDispatch.value_or_default())
-                break;
-
-            for (auto& [key, val] : val0)
-            {
-                // LOG_DEBUG("Waiting _drawMutex {:X}", (size_t)val.buffer);
-                std::lock_guard<std::mutex> lock(_drawMutex);
-
-                val.captureInfo |= CaptureInfo::Dispatch;
-                if (Hudfix_Dx12::CheckForHudless(This, &val, val.state))
-                {
-                    break;
-                }
-            }
-        } while (false);
+        DropPossibleHudless(This, fIndex);
+        return;
     }
-    else
-    {
-        size_t shardIdx = GetShardIndex(This);
-        auto& shard = _hudlessShards[fIndex][shardIdx];
 
-        if (This == MenuOverlayDx::MenuCommandList() && shard.map.contains(This))
-        {
-#ifdef USE_SPINLOCK_MUTEX
-            std::lock_guard<SpinLock> lock(shard.mutex);
-#else
-            std::lock_guard<std::mutex> lock(shard.mutex);
-#endif
-
-            shard.map.erase(This);
-            return;
-        }
-
-        // if can't find output skip
-        if (shard.map.size() == 0)
-        {
-            LOG_DEBUG_ONLY("Early exit");
-            return;
-        }
-
-        ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> val0;
-        {
+    ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo> val0;
 
-#ifdef USE_SPINLOCK_MUTEX
-            std::lock_guard<SpinLock> lock(shard.mutex);
-#else
-            std::lock_guard<std::mutex> lock(shard.mutex);
-#endif
+    if (!TakePossibleHudless(This, fIndex, val0))
+        return;
 
-            if (!shard.map.contains(This))
-                return;
+    do
+    {
+        // if this command list does not have entries skip
+        if (val0.size() == 0)
+            break;
 
-            val0 = std::move(shard.map[This]);
-            shard.map.erase(This);
-        }
+        if (Config::Instance()->FGHudfixDisableDispatch.value_or_default())
+            break;
 
-        do
+        for (auto& [key, val] : val0)
         {
-            // if this command list does not have entries skip
-            if (val0.size() == 0)
-                break;
-
-            if (Config::Instance()->FGHudfixDisableDispatch.value_or_default())
-                break;
+            // LOG_DEBUG("Waiting _drawMutex {:X}", (size_t)val.buffer);
+            std::lock_guard<std::mutex> lock(_drawMutex);
 
-            for (auto& [key, val] : val0)
+            val.captureInfo |= CaptureInfo::Dispatch;
+            if (Hudfix_Dx12::CheckForHudless(This, &val, val.state))
             {
-                // LOG_DEBUG("Waiting _drawMutex {:X}", (size_t)val.buffer);
-                std::lock_guard<std::mutex> lock(_drawMutex);
-
-                val.captureInfo |= CaptureInfo::Dispatch;
-                if (Hudfix_Dx12::CheckForHudless(This, &val, val.state))
-                {
-                    break;
-                }
+                break;
             }
-        } while (false);
-    }
+        }
+    } while (false);
 }
 
 #pragma endregion
 
-void ResTrack_Dx12::HookResource(ID3D12Device* InDevice)
-{
-    if (o_Release != nullptr)
-        return;
-
-    ID3D12Resource* tmp = nullptr;
-    auto d = CD3DX12_RESOURCE_DESC::Buffer(4);
-    auto heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-
-    HRESULT hr = InDevice->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &d,
-                                                   D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&tmp));
-
-    if (hr == S_OK)
-    {
-        PVOID* pVTable = *(PVOID**) tmp;
-        o_Release = (PFN_Release) pVTable[2];
-
-        if (o_Release != nullptr)
-        {
-            DetourTransactionBegin();
-            DetourUpdateThread(GetCurrentThread());
-            DetourAttach(&(PVOID&) o_Release, hkRelease);
-            DetourTransactionCommit();
-
-            o_Release(tmp); // drop temp
-        }
-        else
-        {
-            tmp->Release();
-        }
-    }
-}
-
 void ResTrack_Dx12::HookCommandList(ID3D12Device* InDevice)
 {
 
@@ -1986,38 +1832,27 @@ void ResTrack_Dx12::HookCommandList(ID3D12Device* InDevice)
 
             if (o_OMSetRenderTargets != nullptr)
             {
-                DetourTransactionBegin();
-                DetourUpdateThread(GetCurrentThread());
-
-                // Only needed for hudfix
-                if (State::Instance().activeFgInput == FGInput::Upscaler)
-                {
-                    if (o_OMSetRenderTargets != nullptr)
-                        DetourAttach(&(PVOID&) o_OMSetRenderTargets, hkOMSetRenderTargets);
-
-                    if (o_SetGraphicsRootDescriptorTable != nullptr)
-                        DetourAttach(&(PVOID&) o_SetGraphicsRootDescriptorTable, hkSetGraphicsRootDescriptorTable);
-
-                    if (o_SetComputeRootDescriptorTable != nullptr)
-                        DetourAttach(&(PVOID&) o_SetComputeRootDescriptorTable, hkSetComputeRootDescriptorTable);
-
-                    if (o_DrawIndexedInstanced != nullptr)
-                        DetourAttach(&(PVOID&) o_DrawIndexedInstanced, hkDrawIndexedInstanced);
-
-                    if (o_DrawInstanced != nullptr)
-                        DetourAttach(&(PVOID&) o_DrawInstanced, hkDrawInstanced);
-
-                    if (o_Dispatch != nullptr)
-                        DetourAttach(&(PVOID&) o_Dispatch, hkDispatch);
-                }
-
-                if (o_Close != nullptr)
-                    DetourAttach(&(PVOID&) o_Close, hkClose);
-
-                if (o_ExecuteBundle != nullptr)
-                    DetourAttach(&(PVOID&) o_ExecuteBundle, hkExecuteBundle);
-
-                DetourTransactionCommit();
+                auto& registry = HookRegistry::Instance();
+
+                // Hudfix only, armed by UpdateArming
+                registry.Declare(ArmedGroupName(ResTrackHook_OMSetRenderTargets), "OMSetRenderTargets",
+                                 &(PVOID&) o_OMSetRenderTargets, hkOMSetRenderTargets);
+                registry.Declare(ArmedGroupName(ResTrackHook_SetGraphicsRootDescriptorTable),
+                                 "SetGraphicsRootDescriptorTable", &(PVOID&) o_SetGraphicsRootDescriptorTable,
+                                 hkSetGraphicsRootDescriptorTable);
+                registry.Declare(ArmedGroupName(ResTrackHook_SetComputeRootDescriptorTable),
+                                 "SetComputeRootDescriptorTable", &(PVOID&) o_SetComputeRootDescriptorTable,
+                                 hkSetComputeRootDescriptorTable);
+                registry.Declare(ArmedGroupName(ResTrackHook_DrawIndexedInstanced), "DrawIndexedInstanced",
+                                 &(PVOID&) o_DrawIndexedInstanced, hkDrawIndexedInstanced);
+                registry.Declare(ArmedGroupName(ResTrackHook_DrawInstanced), "DrawInstanced",
+                                 &(PVOID&) o_DrawInstanced, hkDrawInstanced);
+                registry.Declare(ArmedGroupName(ResTrackHook_Dispatch), "Dispatch", &(PVOID&) o_Dispatch,
+                                 hkDispatch);
+
+                auto submission = ArmedGroupName(ResTrackHook_Submission);
+                registry.Declare(submission, "Close", &(PVOID&) o_Close, hkClose);
+                registry.Declare(submission, "ExecuteBundle", &(PVOID&) o_ExecuteBundle, hkExecuteBundle);
             }
 
             commandList->Close();
@@ -2054,13 +1889,8 @@ void ResTrack_Dx12::HookToQueue(ID3D12Device* InDevice)
 
         o_ExecuteCommandLists = (PFN_ExecuteCommandLists) pVTable[10];
 
-        DetourTransactionBegin();
-        DetourUpdateThread(GetCurrentThread());
-
-        if (o_ExecuteCommandLists != nullptr)
-            DetourAttach(&(PVOID&) o_ExecuteCommandLists, hkExecuteCommandLists);
-
-        DetourTransactionCommit();
+        HookRegistry::Instance().Declare(ArmedGroupName(ResTrackHook_Submission), "ExecuteCommandLists",
+                                         &(PVOID&) o_ExecuteCommandLists, hkExecuteCommandLists);
 
         queue->Release();
     }
@@ -2102,98 +1932,75 @@ void ResTrack_Dx12::HookDevice(ID3D12Device* device)
     // o_CreateDepthStencilView = (PFN_CreateDepthStencilView) pVTable[21];
     // o_CreateConstantBufferView = (PFN_CreateConstantBufferView) pVTable[17];
 
-    // Apply the detour
-
-    if (o_CreateDescriptorHeap != nullptr)
-    {
-        DetourTransactionBegin();
-        DetourUpdateThread(GetCurrentThread());
+    auto& registry = HookRegistry::Instance();
+    registry.Declare(DeviceHooks, "CreateDescriptorHeap", &(PVOID&) o_CreateDescriptorHeap, hkCreateDescriptorHeap);
+    registry.Declare(DeviceHooks, "CreateRenderTargetView", &(PVOID&) o_CreateRenderTargetView,
+                     hkCreateRenderTargetView);
+    registry.Declare(DeviceHooks, "CreateShaderResourceView", &(PVOID&) o_CreateShaderResourceView,
+                     hkCreateShaderResourceView);
+    registry.Declare(DeviceHooks, "CreateUnorderedAccessView", &(PVOID&) o_CreateUnorderedAccessView,
+                     hkCreateUnorderedAccessView);
 
-        if (o_CreateDescriptorHeap != nullptr)
-            DetourAttach(&(PVOID&) o_CreateDescriptorHeap, hkCreateDescriptorHeap);
+    auto copies = ArmedGroupName(ResTrackHook_CopyDescriptors);
+    registry.Declare(copies, "CopyDescriptors", &(PVOID&) o_CopyDescriptors, hkCopyDescriptors);
+    registry.Declare(copies, "CopyDescriptorsSimple", &(PVOID&) o_CopyDescriptorsSimple, hkCopyDescriptorsSimple);
 
-        if (o_CreateRenderTargetView != nullptr)
-            DetourAttach(&(PVOID&) o_CreateRenderTargetView, hkCreateRenderTargetView);
+    HookToQueue(device);
+    HookCommandList(device);
 
-        if (o_CreateShaderResourceView != nullptr)
-            DetourAttach(&(PVOID&) o_CreateShaderResourceView, hkCreateShaderResourceView);
+    // Everything is attached now while the game is still creating its device, patching later could
+    // catch a render thread inside the patched code. Views are followed from the start, descriptor
+    // contents can't be read back later.
+    auto groups = ArmedGroupNames(ResTrackHook_All);
+    groups.push_back(DeviceHooks);
 
-        if (o_CreateUnorderedAccessView != nullptr)
-            DetourAttach(&(PVOID&) o_CreateUnorderedAccessView, hkCreateUnorderedAccessView);
+    if (!registry.Install(groups))
+        LOG_WARN("Some hooks couldn't be attached");
 
-        if (o_CopyDescriptors != nullptr)
-            DetourAttach(&(PVOID&) o_CopyDescriptors, hkCopyDescriptors);
+    ResourceLifetime_Dx12::SetCallback(OnResourceDestroyed);
 
-        if (o_CopyDescriptorsSimple != nullptr)
-            DetourAttach(&(PVOID&) o_CopyDescriptorsSimple, hkCopyDescriptorsSimple);
+    _arming.Reset();
+    UpdateArming();
+}
 
-        DetourTransactionCommit();
-    }
+void ResTrack_Dx12::UpdateArming()
+{
+    if (o_CreateDescriptorHeap == nullptr)
+        return;
 
-    HookToQueue(device);
-    HookCommandList(device);
-    HookResource(device);
+    auto config = Config::Instance();
+    auto& state = State::Instance();
+
+    ResTrackArmingInputs inputs {};
+    inputs.fgEnabled = config->FGEnabled.value_or_default();
+    inputs.fgOutputActive = state.currentFG != nullptr;
+    inputs.upscalerInput = state.activeFgInput == FGInput::Upscaler;
+    inputs.hudfix = config->FGHUDFix.value_or_default();
+    inputs.alwaysTrackHeaps = config->FGAlwaysTrackHeaps.value_or_default();
+    inputs.disableOM = config->FGHudfixDisableOM.value_or_default();
+    inputs.disableSGR = config->FGHudfixDisableSGR.value_or_default();
+    inputs.disableSCR = config->FGHudfixDisableSCR.value_or_default();
+    inputs.disableDI = config->FGHudfixDisableDI.value_or_default();
+    inputs.disableDII = config->FGHudfixDisableDII.value_or_default();
+    inputs.disableDispatch = config->FGHudfixDisableDispatch.value_or_default();
+
+    // Only the mask changes, the hooks stay attached. Heap contents are kept when copies are armed
+    // again, games copy into their shader visible heaps every frame and destroyed resources are
+    // cleared by the lifetime callback.
+    auto plan = _arming.Update(inputs);
+
+    if (!plan.Empty())
+        LOG_INFO("Armed: {:X}, armed now: {:X}, disarmed now: {:X}", _arming.Armed(), plan.arm, plan.disarm);
 }
 
 void ResTrack_Dx12::ReleaseDeviceHooks()
 {
     LOG_DEBUG("");
 
-    DetourTransactionBegin();
-    DetourUpdateThread(GetCurrentThread());
-
-    if (o_CreateDescriptorHeap != nullptr)
-        DetourDetach(&(PVOID&) o_CreateDescriptorHeap, hkCreateDescriptorHeap);
-
-    if (o_CreateRenderTargetView != nullptr)
-        DetourDetach(&(PVOID&) o_CreateRenderTargetView, hkCreateRenderTargetView);
-
-    if (o_CreateShaderResourceView != nullptr)
-        DetourDetach(&(PVOID&) o_CreateShaderResourceView, hkCreateShaderResourceView);
-
-    if (o_CreateUnorderedAccessView != nullptr)
-        DetourDetach(&(PVOID&) o_CreateUnorderedAccessView, hkCreateUnorderedAccessView);
-
-    if (o_CopyDescriptors != nullptr)
-        DetourDetach(&(PVOID&) o_CopyDescriptors, hkCopyDescriptors);
-
-    if (o_CopyDescriptorsSimple != nullptr)
-        DetourDetach(&(PVOID&) o_CopyDescriptorsSimple, hkCopyDescriptorsSimple);
-
-    // Queue
-    if (o_ExecuteCommandLists != nullptr)
-        DetourDetach(&(PVOID&) o_ExecuteCommandLists, hkExecuteCommandLists);
-
-    // CommandList
-    if (o_OMSetRenderTargets != nullptr)
-        DetourDetach(&(PVOID&) o_OMSetRenderTargets, hkOMSetRenderTargets);
-
-    if (o_SetGraphicsRootDescriptorTable != nullptr)
-        DetourDetach(&(PVOID&) o_SetGraphicsRootDescriptorTable, hkSetGraphicsRootDescriptorTable);
-
-    if (o_SetComputeRootDescriptorTable != nullptr)
-        DetourDetach(&(PVOID&) o_SetComputeRootDescriptorTable, hkSetComputeRootDescriptorTable);
-
-    if (o_DrawIndexedInstanced != nullptr)
-        DetourDetach(&(PVOID&) o_DrawIndexedInstanced, hkDrawIndexedInstanced);
-
-    if (o_DrawInstanced != nullptr)
-        DetourDetach(&(PVOID&) o_DrawInstanced, hkDrawInstanced);
-
-    if (o_Dispatch != nullptr)
-        DetourDetach(&(PVOID&) o_Dispatch, hkDispatch);
-
-    if (o_Close != nullptr)
-        DetourDetach(&(PVOID&) o_Close, hkClose);
-
-    if (o_ExecuteBundle != nullptr)
-        DetourDetach(&(PVOID&) o_ExecuteBundle, hkExecuteBundle);
-
-    // Resource
-    if (o_Release != nullptr)
-        DetourDetach(&(PVOID&) o_Release, hkRelease);
-
-    DetourTransactionCommit();
+    auto groups = ArmedGroupNames(ResTrackHook_All);
+    groups.push_back(DeviceHooks);
+    HookRegistry::Instance().Remove(groups, true);
+    _arming.Reset();
 
     // Device
     o_CreateDescriptorHeap = nullptr;
@@ -2216,75 +2023,16 @@ void ResTrack_Dx12::ReleaseDeviceHooks()
     o_Close = nullptr;
     o_ExecuteBundle = nullptr;
 
-    // Resource
-    o_Release = nullptr;
+    ResourceLifetime_Dx12::SetCallback(nullptr);
 }
 
 void ResTrack_Dx12::ReleaseHooks()
 {
     LOG_DEBUG("");
 
-    DetourTransactionBegin();
-    DetourUpdateThread(GetCurrentThread());
-
-    // if (o_CreateDescriptorHeap != nullptr)
-    //     DetourDetach(&(PVOID&) o_CreateDescriptorHeap, hkCreateDescriptorHeap);
-
-    // if (o_CreateRenderTargetView != nullptr)
-    //     DetourDetach(&(PVOID&) o_CreateRenderTargetView, hkCreateRenderTargetView);
-
-    // if (o_CreateShaderResourceView != nullptr)
-    //     DetourDetach(&(PVOID&) o_CreateShaderResourceView, hkCreateShaderResourceView);
-
-    // if (o_CreateUnorderedAccessView != nullptr)
-    //     DetourDetach(&(PVOID&) o_CreateUnorderedAccessView, hkCreateUnorderedAccessView);
-
-    // if (o_CopyDescriptors != nullptr)
-    //     DetourDetach(&(PVOID&) o_CopyDescriptors, hkCopyDescriptors);
-
-    // if (o_CopyDescriptorsSimple != nullptr)
-    //     DetourDetach(&(PVOID&) o_CopyDescriptorsSimple, hkCopyDescriptorsSimple);
-
-    // o_CreateDescriptorHeap = nullptr;
-    // o_CreateRenderTargetView = nullptr;
-    // o_CreateShaderResourceView = nullptr;
-    // o_CreateUnorderedAccessView = nullptr;
-    // o_CopyDescriptors = nullptr;
-    // o_CopyDescriptorsSimple = nullptr;
-
-    // if (o_ExecuteCommandLists != nullptr)
-    //     DetourAttach(&(PVOID&) o_ExecuteCommandLists, hkExecuteCommandLists);
-
-    // o_ExecuteCommandLists = nullptr;
-
-    // if (o_Release != nullptr)
-    //     DetourAttach(&(PVOID&) o_Release, hkRelease);
-
-    // o_Release = nullptr;
-
-    if (o_OMSetRenderTargets != nullptr)
-        DetourDetach(&(PVOID&) o_OMSetRenderTargets, hkOMSetRenderTargets);
-
-    if (o_SetGraphicsRootDescriptorTable != nullptr)
-        DetourDetach(&(PVOID&) o_SetGraphicsRootDescriptorTable, hkSetGraphicsRootDescriptorTable);
-
-    if (o_SetComputeRootDescriptorTable != nullptr)
-        DetourDetach(&(PVOID&) o_SetComputeRootDescriptorTable, hkSetComputeRootDescriptorTable);
-
-    if (o_DrawIndexedInstanced != nullptr)
-        DetourDetach(&(PVOID&) o_DrawIndexedInstanced, hkDrawIndexedInstanced);
-
-    if (o_DrawInstanced != nullptr)
-        DetourDetach(&(PVOID&) o_DrawInstanced, hkDrawInstanced);
-
-    if (o_Dispatch != nullptr)
-        DetourDetach(&(PVOID&) o_Dispatch, hkDispatch);
-
-    if (o_Close != nullptr)
-        DetourDetach(&(PVOID&) o_Close, hkClose);
-
-    if (o_ExecuteBundle != nullptr)
-        DetourDetach(&(PVOID&) o_ExecuteBundle, hkExecuteBundle);
+    // Command list and queue hooks
+    auto groups = ArmedGroupNames(ResTrackHook_All & ~ResTrackHook_CopyDescriptors);
+    HookRegistry::Instance().Remove(groups, true);
 
     o_OMSetRenderTargets = nullptr;
     o_SetGraphicsRootDescriptorTable = nullptr;
@@ -2294,8 +2042,6 @@ void ResTrack_Dx12::ReleaseHooks()
     o_Dispatch = nullptr;
     o_Close = nullptr;
     o_ExecuteBundle = nullptr;
-
-    DetourTransactionCommit();
 }
 
 void ResTrack_Dx12::ClearPossibleHudless()
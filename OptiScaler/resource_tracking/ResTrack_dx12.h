@@ -3,6 +3,8 @@
 #include <pch.h>
 
 #include <hudfix/Hudfix_Dx12.h>
+#include "ResourceLifetime_Dx12.h"
+#include "ResTrack_Arming.h"
 #include <framegen/IFGFeature_Dx12.h>
 
 #include <ankerl/unordered_dense.h>
@@ -177,13 +179,47 @@ struct HeapInfo
     }
 
     void AttachToNewResource(SIZE_T index) const
+    {
+        bool firstSlot = false;
+
+        {
+            std::scoped_lock lock(_trackedResourcesMutex);
+            LOG_TRACK("Heap: {:X}, Index: {}, Resource: {:X}, Res: {}x{}, Format: {}", (size_t) this, index,
+                      (size_t) info[index].buffer, info[index].width, info[index].height, (UINT) info[index].format);
+            auto& vec = _trackedResources[info[index].buffer];
+            firstSlot = vec.empty();
+            if (std::find(vec.begin(), vec.end(), &info[index]) == vec.end())
+                vec.push_back(&info[index]);
+        }
+
+        // Slots are cleaned up when the resource is destroyed, see ResTrack_Dx12::OnResourceDestroyed
+        if (firstSlot)
+            ResourceLifetime_Dx12::Watch(info[index].buffer);
+    }
+
+    // Clears every slot, used when the heap is released
+    void DetachAll() const
     {
         std::scoped_lock lock(_trackedResourcesMutex);
-        LOG_TRACK("Heap: {:X}, Index: {}, Resource: {:X}, Res: {}x{}, Format: {}", (size_t) this, index,
-                  (size_t) info[index].buffer, info[index].width, info[index].height, (UINT) info[index].format);
-        auto& vec = _trackedResources[info[index].buffer];
-        if (std::find(vec.begin(), vec.end(), &info[index]) == vec.end())
-            vec.push_back(&info[index]);
+
+        for (UINT i = 0; i < numDescriptors; ++i)
+        {
+            auto& slot = info[i];
+
+            if (slot.buffer == nullptr)
+                continue;
+
+            if (auto it = _trackedResources.find(slot.buffer); it != _trackedResources.end())
+            {
+                auto& vec = it->second;
+                vec.erase(std::remove(vec.begin(), vec.end(), &slot), vec.end());
+                if (vec.empty())
+                    _trackedResources.erase(it);
+            }
+
+            slot.buffer = nullptr;
+            slot.lastUsedFrame = 0;
+        }
     }
 
     ResourceInfo* GetByCpuHandle(SIZE_T cpuHandle) const
@@ -343,6 +379,7 @@ class ResTrack_Dx12
     inline static bool _presentDone = true;
     inline static std::mutex _drawMutex;
     inline static bool _useShards = false;
+    inline static ResTrackArming _arming {};
 
     inline static std::mutex _resourceCommandListMutex;
     inline static std::unordered_map<FG_ResourceType, ID3D12GraphicsCommandList*> _resourceCommandList[BUFFER_COUNT];
@@ -401,11 +438,10 @@ class ResTrack_Dx12
     static HRESULT hkCreateDescriptorHeap(ID3D12Device* This, D3D12_DESCRIPTOR_HEAP_DESC* pDescriptorHeapDesc,
                                           REFIID riid, void** ppvHeap);
 
-    static ULONG hkRelease(ID3D12Resource* This);
+    static void OnResourceDestroyed(ID3D12Resource* resource);
 
     static void HookCommandList(ID3D12Device* InDevice);
     static void HookToQueue(ID3D12Device* InDevice);
-    static void HookResource(ID3D12Device* InDevice);
 
     static bool CheckResource(ID3D12Resource* resource);
 
@@ -430,6 +466,13 @@ class ResTrack_Dx12
 
     static void FillResourceInfo(ID3D12Resource* resource, ResourceInfo* info);
 
+    // Possible hudless resources recorded on a command list, kept in the list's slot storage.
+    // The shared maps below are only used for lists which the storage couldn't be attached to.
+    static void TrackPossibleHudless(ID3D12GraphicsCommandList* cmdList, size_t fIndex, const ResourceInfo& resource);
+    static bool TakePossibleHudless(ID3D12GraphicsCommandList* cmdList, size_t fIndex,
+                                    ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo>& resources);
+    static void DropPossibleHudless(ID3D12GraphicsCommandList* cmdList, size_t fIndex);
+
     // Sharding
     inline static constexpr size_t SHARD_COUNT = 16;
     inline static CommandListShard _hudlessShards[BUFFER_COUNT][SHARD_COUNT];
@@ -445,5 +488,8 @@ class ResTrack_Dx12
     static void ReleaseHooks();
     static void ReleaseDeviceHooks();
     static void ClearPossibleHudless();
+
+    // Arms or disarms the per draw and per copy hooks to match what FG and hudfix need, once per frame
+    static void UpdateArming();
     static void SetResourceCmdList(FG_ResourceType type, ID3D12GraphicsCommandList* cmdList);
 };
@@ -0,0 +1,124 @@
+#include "ResourceLifetime_Dx12.h"
+
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::ResTrack
+
+// {0E6D4B8F-2A71-4C39-B5E2-7F18C9A3D604}
+static const GUID SentinelGuid = { 0x0e6d4b8f, 0x2a71, 0x4c39, { 0xb5, 0xe2, 0x7f, 0x18, 0xc9, 0xa3, 0xd6, 0x04 } };
+
+// Private data of a watched resource, last reference is dropped when the resource is destroyed
+class ResourceSentinel_Dx12 final : public IUnknown
+{
+    std::atomic<ULONG> _refCount = 1;
+    ID3D12Resource* _resource = nullptr;
+
+  public:
+    const uint64_t watchId;
+    std::atomic<bool> queue = false;
+
+    explicit ResourceSentinel_Dx12(ID3D12Resource* resource)
+        : _resource(resource), watchId(ResourceLifetime_Dx12::_nextWatchId.fetch_add(1, std::memory_order_relaxed))
+    {
+        ResourceLifetime_Dx12::_watchedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ~ResourceSentinel_Dx12()
+    {
+        ResourceLifetime_Dx12::_watchedCount.fetch_sub(1, std::memory_order_relaxed);
+        ResourceLifetime_Dx12::OnDestroyed(_resource, watchId, queue.load(std::memory_order_acquire));
+    }
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override
+    {
+        if (ppvObject == nullptr)
+            return E_POINTER;
+
+        if (riid == __uuidof(IUnknown))
+        {
+            AddRef();
+            *ppvObject = this;
+            return S_OK;
+        }
+
+        *ppvObject = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() override { return ++_refCount; }
+
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        auto count = --_refCount;
+
+        if (count == 0)
+            delete this;
+
+        return count;
+    }
+};
+
+void ResourceLifetime_Dx12::SetCallback(DestroyedCallback callback)
+{
+    _callback.store(callback, std::memory_order_release);
+}
+
+uint64_t ResourceLifetime_Dx12::Watch(ID3D12Resource* resource, bool queue)
+{
+    if (resource == nullptr)
+        return 0;
+
+    // Replacing a sentinel would report the resource as destroyed, check and attach as one step
+    std::scoped_lock lock(_watchMutex);
+
+    IUnknown* data = nullptr;
+    UINT size = sizeof(data);
+
+    if (resource->GetPrivateData(SentinelGuid, &size, &data) == S_OK && data != nullptr)
+    {
+        auto existing = static_cast<ResourceSentinel_Dx12*>(data);
+
+        if (queue)
+            existing->queue.store(true, std::memory_order_release);
+
+        // Resource keeps its own reference
+        auto watchId = existing->watchId;
+        data->Release();
+        return watchId;
+    }
+
+    auto sentinel = new ResourceSentinel_Dx12(resource);
+    sentinel->queue.store(queue, std::memory_order_relaxed);
+
+    auto watchId = sentinel->watchId;
+    auto result = resource->SetPrivateDataInterface(SentinelGuid, sentinel);
+    sentinel->Release();
+
+    if (result != S_OK)
+    {
+        LOG_WARN("SetPrivateDataInterface error: {:X}", (UINT) result);
+        return 0;
+    }
+
+    LOG_TRACE("Resource: {:X}, id: {}", (size_t) resource, watchId);
+
+    return watchId;
+}
+
+uint32_t ResourceLifetime_Dx12::WatchedCount() { return _watchedCount.load(std::memory_order_relaxed); }
+
+void ResourceLifetime_Dx12::OnDestroyed(ID3D12Resource* resource, uint64_t watchId, bool queue)
+{
+    auto callback = _callback.load(std::memory_order_acquire);
+
+    if (callback != nullptr)
+        callback(resource);
+
+    if (!queue)
+        return;
+
+    auto node = new DestroyedNode { resource, watchId, _destroyed.load(std::memory_order_relaxed) };
+
+    while (!_destroyed.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+}
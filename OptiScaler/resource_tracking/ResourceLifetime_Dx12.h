@@ -0,0 +1,63 @@
+#pragma once
+#include <pch.h>
+
+#include <d3d12.h>
+
+#include <atomic>
+#include <mutex>
+
+// Destruction notifications for the resources the trackers record. A sentinel is attached to
+// the resource as private data and the runtime releases it when the resource is destroyed,
+// so resources which were never watched don't pay anything on Release.
+class ResourceLifetime_Dx12
+{
+  public:
+    // Called on the thread which destroyed the resource, the pointer is only valid as a key
+    using DestroyedCallback = void (*)(ID3D12Resource* resource);
+
+    static void SetCallback(DestroyedCallback callback);
+
+    // Attaches the sentinel once, later calls for the same resource only check for it.
+    // When queue is set the resource is also reported to DrainDestroyed after it's destroyed.
+    // Returns the id of the sentinel, 0 on failure. Ids are never reused, unlike the addresses.
+    static uint64_t Watch(ID3D12Resource* resource, bool queue = false);
+
+    // Hands out the queued resources destroyed since the last call with the id Watch returned.
+    // Lets state which is only touched from one thread drop its entries there instead of from
+    // the releasing thread. A new resource can be at the same address by then, entries should
+    // be tagged with the id and only dropped when it matches.
+    template <typename F> static void DrainDestroyed(F&& fn)
+    {
+        // The whole list is taken at once, nodes are never read by anyone else after this
+        auto node = _destroyed.exchange(nullptr, std::memory_order_acquire);
+
+        while (node != nullptr)
+        {
+            auto next = node->next;
+            fn(node->resource, node->watchId);
+            delete node;
+            node = next;
+        }
+    }
+
+    // Resources with a sentinel attached
+    static uint32_t WatchedCount();
+
+  private:
+    struct DestroyedNode
+    {
+        ID3D12Resource* resource = nullptr;
+        uint64_t watchId = 0;
+        DestroyedNode* next = nullptr;
+    };
+
+    inline static std::atomic<DestroyedNode*> _destroyed = nullptr;
+    inline static std::atomic<DestroyedCallback> _callback = nullptr;
+    inline static std::atomic<uint32_t> _watchedCount = 0;
+    inline static std::atomic<uint64_t> _nextWatchId = 1;
+    inline static std::mutex _watchMutex;
+
+    static void OnDestroyed(ID3D12Resource* resource, uint64_t watchId, bool queue);
+
+    friend class ResourceSentinel_Dx12;
+};
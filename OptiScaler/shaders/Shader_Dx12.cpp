@@ -133,17 +133,17 @@ bool Shader_Dx12::CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* I
 
 void Shader_Dx12::SetBufferState(ID3D12GraphicsCommandList* InCommandList, D3D12_RESOURCE_STATES InState,
                                  ID3D12Resource* Buffer, D3D12_RESOURCE_STATES* BufferState)
+{
+    BarrierBatch_Dx12 barriers(InCommandList);
+    SetBufferState(barriers, InState, Buffer, BufferState);
+}
+
+void Shader_Dx12::SetBufferState(BarrierBatch_Dx12& Barriers, D3D12_RESOURCE_STATES InState, ID3D12Resource* Buffer,
+                                 D3D12_RESOURCE_STATES* BufferState)
 {
     if (BufferState == nullptr || *BufferState == InState)
         return;
 
-    D3D12_RESOURCE_BARRIER barrier = {};
-    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Transition.pResource = Buffer;
-    barrier.Transition.StateBefore = *BufferState;
-    barrier.Transition.StateAfter = InState;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    InCommandList->ResourceBarrier(1, &barrier);
-
+    Barriers.Transition(Buffer, *BufferState, InState);
     *BufferState = InState;
 }
@@ -3,6 +3,8 @@
 #include <pch.h>
 #include <d3d12.h>
 
+#include <misc/BarrierBatch_Dx12.h>
+
 class Shader_Dx12
 {
   protected:
@@ -26,6 +28,10 @@ class Shader_Dx12
     static void SetBufferState(ID3D12GraphicsCommandList* InCommandList, D3D12_RESOURCE_STATES InState,
                                ID3D12Resource* Buffer, D3D12_RESOURCE_STATES* BufferState);
 
+    // Recorded into the batch, goes out together with the caller's transitions at its next flush
+    static void SetBufferState(BarrierBatch_Dx12& Barriers, D3D12_RESOURCE_STATES InState, ID3D12Resource* Buffer,
+                               D3D12_RESOURCE_STATES* BufferState);
+
   public:
     bool IsInit() const { return _init; }
 
@@ -28,6 +28,7 @@ class Bias_Dx12 : public Shader_Dx12
   public:
     bool CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InSource, D3D12_RESOURCE_STATES InState);
     void SetBufferState(ID3D12GraphicsCommandList* InCommandList, D3D12_RESOURCE_STATES InState);
+    void SetBufferState(BarrierBatch_Dx12& Barriers, D3D12_RESOURCE_STATES InState);
     bool Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdList, ID3D12Resource* InResource,
                   float InBias, ID3D12Resource* OutResource);
 
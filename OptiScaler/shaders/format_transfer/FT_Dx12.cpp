@@ -63,6 +63,11 @@ void FT_Dx12::SetBufferState(ID3D12GraphicsCommandList* InCommandList, D3D12_RES
     return Shader_Dx12::SetBufferState(InCommandList, InState, _buffer, &_bufferState);
 }
 
+void FT_Dx12::SetBufferState(BarrierBatch_Dx12& Barriers, D3D12_RESOURCE_STATES InState)
+{
+    return Shader_Dx12::SetBufferState(Barriers, InState, _buffer, &_bufferState);
+}
+
 bool FT_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdList, ID3D12Resource* InResource,
                        ID3D12Resource* OutResource)
 {
@@ -0,0 +1,57 @@
+#include "Dxgi_SpoofedDescs.h"
+
+#include <State.h>
+
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::Spoofing
+
+const DxgiSpoofedDescs::Entry* DxgiSpoofedDescs::Find(const LUID& luid)
+{
+    auto count = _count.load(std::memory_order_acquire);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        auto entry = _entries[i].load(std::memory_order_acquire);
+
+        if (entry->luid.LowPart == luid.LowPart && entry->luid.HighPart == luid.HighPart)
+            return entry;
+    }
+
+    return nullptr;
+}
+
+const DxgiSpoofedDesc& DxgiSpoofedDescs::Add(const LUID& luid, UINT vendorId, UINT deviceId,
+                                             SIZE_T dedicatedVideoMemory, const WCHAR* description,
+                                             const DxgiSpoofedDesc& spoofed)
+{
+    std::scoped_lock lock(_addMutex);
+
+    // Another thread could have added it while waiting
+    if (auto entry = Find(luid); entry != nullptr)
+        return entry->spoofed;
+
+    if (vendorId != VendorId::Microsoft)
+    {
+        auto descStr = std::format("Adapter: {}, VRAM: {} MB, VendorId: {:#x}, DeviceId: {:#x}",
+                                   wstring_to_string(description), dedicatedVideoMemory / (1024 * 1024), vendorId,
+                                   deviceId);
+        LOG_INFO("{}", descStr);
+
+        State::Instance().adapterDescs.insert_or_assign(luid.HighPart | luid.LowPart, descStr);
+    }
+
+    auto count = _count.load();
+
+    if (count == MaxAdapters)
+    {
+        LOG_WARN("More than {} adapters, not caching", MaxAdapters);
+        _overflow = spoofed;
+        return _overflow;
+    }
+
+    auto entry = new Entry { luid, spoofed };
+    _entries[count].store(entry, std::memory_order_release);
+    _count.store(count + 1, std::memory_order_release);
+
+    return entry->spoofed;
+}
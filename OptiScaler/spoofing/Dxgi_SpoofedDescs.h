@@ -0,0 +1,74 @@
+#pragma once
+
+#include <pch.h>
+
+#include <hooks/DxgiFactory_AdapterTopology.h>
+
+#include <dxgi1_6.h>
+
+#include <atomic>
+#include <mutex>
+
+// Spoofed descs per adapter LUID, built once when the adapter is first queried.
+// Spoofing options need a restart, only the DxgiSpoofing toggle and skipSpoofing
+// can change while running and those are checked on every call.
+class DxgiSpoofedDescs
+{
+  public:
+    template <typename T> static void Overlay(const DxgiSpoofedDesc& spoofed, T* pDesc, bool identity)
+    {
+        if (spoofed.vram)
+            pDesc->DedicatedVideoMemory = spoofed.dedicatedVideoMemory;
+
+        if (!identity || !spoofed.identity)
+            return;
+
+        pDesc->VendorId = spoofed.vendorId;
+        pDesc->DeviceId = spoofed.deviceId;
+        std::memcpy(pDesc->Description, spoofed.description, sizeof(pDesc->Description));
+    }
+
+    // Entry of the adapter, built from the real desc the first time
+    template <typename T> static const DxgiSpoofedDesc& Get(const T* pDesc)
+    {
+        if (auto entry = Find(pDesc->AdapterLuid); entry != nullptr)
+            return entry->spoofed;
+
+        auto spoofed = DxgiSpoofingTables::Build(pDesc->VendorId, pDesc->DeviceId, pDesc->DedicatedVideoMemory,
+                                                 DxgiAdapterTopology::CurrentSpoofingPolicy());
+
+        return Add(pDesc->AdapterLuid, pDesc->VendorId, pDesc->DeviceId, pDesc->DedicatedVideoMemory,
+                   pDesc->Description, spoofed);
+    }
+
+    // Entry of an adapter snapshot, GetDesc finds it ready instead of building it again
+    static void Prepare(const AdapterTopologyEntry& entry)
+    {
+        if (Find(entry.luid) == nullptr)
+        {
+            Add(entry.luid, entry.vendorId, entry.deviceId, entry.dedicatedVideoMemory, entry.description.c_str(),
+                entry.spoofed);
+        }
+    }
+
+  private:
+    struct Entry
+    {
+        LUID luid {};
+        DxgiSpoofedDesc spoofed;
+    };
+
+    static constexpr size_t MaxAdapters = 16;
+
+    // Entries are immutable once published, readers don't lock
+    inline static std::atomic<Entry*> _entries[MaxAdapters] {};
+    inline static std::atomic<size_t> _count = 0;
+    inline static std::mutex _addMutex;
+
+    // Used when there are more adapters than entries, never happens in practice
+    inline static thread_local DxgiSpoofedDesc _overflow {};
+
+    static const Entry* Find(const LUID& luid);
+    static const DxgiSpoofedDesc& Add(const LUID& luid, UINT vendorId, UINT deviceId, SIZE_T dedicatedVideoMemory,
+                                      const WCHAR* description, const DxgiSpoofedDesc& spoofed);
+};
@@ -1,9 +1,13 @@
 #include "Dxgi_Spoofing.h"
+#include "Dxgi_SpoofedDescs.h"
 
 #include <Config.h>
 
 #include <detours/detours.h>
 
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::Spoofing
+
 typedef HRESULT (*PFN_GetDesc)(IDXGIAdapter* This, DXGI_ADAPTER_DESC* pDesc);
 typedef HRESULT (*PFN_GetDesc1)(IDXGIAdapter1* This, DXGI_ADAPTER_DESC1* pDesc);
 typedef HRESULT (*PFN_GetDesc2)(IDXGIAdapter2* This, DXGI_ADAPTER_DESC2* pDesc);
@@ -29,6 +33,20 @@ inline static bool SkipSpoofing()
     return skip;
 }
 
+// Real desc is only read the first time an adapter is seen, after that it's a copy
+template <typename T> static void SpoofDesc(T* pDesc)
+{
+    auto& spoofed = DxgiSpoofedDescs::Get(pDesc);
+    auto identity = spoofed.identity && Config::Instance()->DxgiSpoofing.value_or_default() && !SkipSpoofing();
+
+    DxgiSpoofedDescs::Overlay(spoofed, pDesc, identity);
+
+#ifdef _DEBUG
+    if (identity)
+        LOG_DEBUG("spoofing");
+#endif
+}
+
 HRESULT DxgiSpoofing::hkGetDesc3(IDXGIAdapter4* This, DXGI_ADAPTER_DESC3* pDesc)
 {
     auto result = o_GetDesc3(This, pDesc);
@@ -38,41 +56,7 @@ HRESULT DxgiSpoofing::hkGetDesc3(IDXGIAdapter4* This, DXGI_ADAPTER_DESC3* pDesc)
 #endif
 
     if (result == S_OK)
-    {
-        if (pDesc->VendorId != VendorId::Microsoft &&
-            !State::Instance().adapterDescs.contains(pDesc->AdapterLuid.HighPart | pDesc->AdapterLuid.LowPart))
-        {
-            std::wstring szName(pDesc->Description);
-            std::string descStr =
-                std::format("Adapter: {}, VRAM: {} MB, VendorId: {:#x}, DeviceId: {:#x}", wstring_to_string(szName),
-                            pDesc->DedicatedVideoMemory / (1024 * 1024), pDesc->VendorId, pDesc->DeviceId);
-            LOG_INFO("{}", descStr);
-            State::Instance().adapterDescs.insert_or_assign(pDesc->AdapterLuid.HighPart | pDesc->AdapterLuid.LowPart,
-                                                            descStr);
-        }
-
-        if (Config::Instance()->DxgiVRAM.has_value())
-            pDesc->DedicatedVideoMemory = (UINT64) Config::Instance()->DxgiVRAM.value() * 1024 * 1024 * 1024;
-
-        if (pDesc->VendorId != VendorId::Microsoft &&
-            (!Config::Instance()->TargetVendorId.has_value() ||
-             Config::Instance()->TargetVendorId.value() == pDesc->VendorId) &&
-            (!Config::Instance()->TargetDeviceId.has_value() ||
-             Config::Instance()->TargetDeviceId.value() == pDesc->DeviceId) &&
-            Config::Instance()->DxgiSpoofing.value_or_default() && !SkipSpoofing())
-        {
-            pDesc->VendorId = Config::Instance()->SpoofedVendorId.value_or_default();
-            pDesc->DeviceId = Config::Instance()->SpoofedDeviceId.value_or_default();
-
-            auto szName = Config::Instance()->SpoofedGPUName.value_or_default();
-            std::memset(pDesc->Description, 0, sizeof(pDesc->Description));
-            std::wcscpy(pDesc->Description, szName.c_str());
-
-#ifdef _DEBUG
-            LOG_DEBUG("spoofing");
-#endif
-        }
-    }
+        SpoofDesc(pDesc);
 
     AttachToAdapter(This);
 
@@ -88,41 +72,7 @@ HRESULT DxgiSpoofing::hkGetDesc2(IDXGIAdapter2* This, DXGI_ADAPTER_DESC2* pDesc)
 #endif
 
     if (result == S_OK)
-    {
-        if (pDesc->VendorId != VendorId::Microsoft &&
-            !State::Instance().adapterDescs.contains(pDesc->AdapterLuid.HighPart | pDesc->AdapterLuid.LowPart))
-        {
-            std::wstring szName(pDesc->Description);
-            std::string descStr =
-                std::format("Adapter: {}, VRAM: {} MB, VendorId: {:#x}, DeviceId: {:#x}", wstring_to_string(szName),
-                            pDesc->DedicatedVideoMemory / (1024 * 1024), pDesc->VendorId, pDesc->DeviceId);
-            LOG_INFO("{}", descStr);
-            State::Instance().adapterDescs.insert_or_assign(pDesc->AdapterLuid.HighPart | pDesc->AdapterLuid.LowPart,
-                                                            descStr);
-        }
-
-        if (Config::Instance()->DxgiVRAM.has_value())
-            pDesc->DedicatedVideoMemory = (UINT64) Config::Instance()->DxgiVRAM.value() * 1024 * 1024 * 1024;
-
-        if (pDesc->VendorId != VendorId::Microsoft &&
-            (!Config::Instance()->TargetVendorId.has_value() ||
-             Config::Instance()->TargetVendorId.value() == pDesc->VendorId) &&
-            (!Config::Instance()->TargetDeviceId.has_value() ||
-             Config::Instance()->TargetDeviceId.value() == pDesc->DeviceId) &&
-            Config::Instance()->DxgiSpoofing.value_or_default() && !SkipSpoofing())
-        {
-            pDesc->VendorId = Config::Instance()->SpoofedVendorId.value_or_default();
-            pDesc->DeviceId = Config::Instance()->SpoofedDeviceId.value_or_default();
-
-            auto szName = Config::Instance()->SpoofedGPUName.value_or_default();
-            std::memset(pDesc->Description, 0, sizeof(pDesc->Description));
-            std::wcscpy(pDesc->Description, szName.c_str());
-
-#ifdef _DEBUG
-            LOG_DEBUG("spoofing");
-#endif
-        }
-    }
+        SpoofDesc(pDesc);
 
     AttachToAdapter(This);
 
@@ -138,41 +88,7 @@ HRESULT DxgiSpoofing::hkGetDesc1(IDXGIAdapter1* This, DXGI_ADAPTER_DESC1* pDesc)
 #endif
 
     if (result == S_OK)
-    {
-        if (pDesc->VendorId != VendorId::Microsoft &&
-            !State::Instance().adapterDescs.contains(pDesc->AdapterLuid.HighPart | pDesc->AdapterLuid.LowPart))
-        {
-            std::wstring szName(pDesc->Description);
-            std::string descStr =
-                std::format("Adapter: {}, VRAM: {} MB, VendorId: {:#x}, DeviceId: {:#x}", wstring_to_string(szName),
-                            pDesc->DedicatedVideoMemory / (1024 * 1024), pDesc->VendorId, pDesc->DeviceId);
-            LOG_INFO("{}", descStr);
-            State::Instance().adapterDescs.insert_or_assign(pDesc->AdapterLuid.HighPart | pDesc->AdapterLuid.LowPart,
-                                                            descStr);
-        }
-
-        if (Config::Instance()->DxgiVRAM.has_value())
-            pDesc->DedicatedVideoMemory = (UINT64) Config::Instance()->DxgiVRAM.value() * 1024 * 1024 * 1024;
-
-        if (pDesc->VendorId != VendorId::Microsoft &&
-            (!Config::Instance()->TargetVendorId.has_value() ||
-             Config::Instance()->TargetVendorId.value() == pDesc->VendorId) &&
-            (!Config::Instance()->TargetDeviceId.has_value() ||
-             Config::Instance()->TargetDeviceId.value() == pDesc->DeviceId) &&
-            Config::Instance()->DxgiSpoofing.value_or_default() && !SkipSpoofing())
-        {
-            pDesc->VendorId = Config::Instance()->SpoofedVendorId.value_or_default();
-            pDesc->DeviceId = Config::Instance()->SpoofedDeviceId.value_or_default();
-
-            auto szName = Config::Instance()->SpoofedGPUName.value_or_default();
-            std::memset(pDesc->Description, 0, sizeof(pDesc->Description));
-            std::wcscpy(pDesc->Description, szName.c_str());
-
-#ifdef _DEBUG
-            LOG_DEBUG("spoofing");
-#endif
-        }
-    }
+        SpoofDesc(pDesc);
 
     AttachToAdapter(This);
 
@@ -188,41 +104,7 @@ HRESULT DxgiSpoofing::hkGetDesc(IDXGIAdapter* This, DXGI_ADAPTER_DESC* pDesc)
 #endif
 
     if (result == S_OK)
-    {
-        if (pDesc->VendorId != VendorId::Microsoft &&
-            !State::Instance().adapterDescs.contains(pDesc->AdapterLuid.HighPart | pDesc->AdapterLuid.LowPart))
-        {
-            std::wstring szName(pDesc->Description);
-            std::string descStr =
-                std::format("Adapter: {}, VRAM: {} MB, VendorId: {:#x}, DeviceId: {:#x}", wstring_to_string(szName),
-                            pDesc->DedicatedVideoMemory / (1024 * 1024), pDesc->VendorId, pDesc->DeviceId);
-            LOG_INFO("{}", descStr);
-            State::Instance().adapterDescs.insert_or_assign(pDesc->AdapterLuid.HighPart | pDesc->AdapterLuid.LowPart,
-                                                            descStr);
-        }
-
-        if (Config::Instance()->DxgiVRAM.has_value())
-            pDesc->DedicatedVideoMemory = (UINT64) Config::Instance()->DxgiVRAM.value() * 1024 * 1024 * 1024;
-
-        if (pDesc->VendorId != VendorId::Microsoft &&
-            (!Config::Instance()->TargetVendorId.has_value() ||
-             Config::Instance()->TargetVendorId.value() == pDesc->VendorId) &&
-            (!Config::Instance()->TargetDeviceId.has_value() ||
-             Config::Instance()->TargetDeviceId.value() == pDesc->DeviceId) &&
-            Config::Instance()->DxgiSpoofing.value_or_default() && !SkipSpoofing())
-        {
-            pDesc->VendorId = Config::Instance()->SpoofedVendorId.value_or_default();
-            pDesc->DeviceId = Config::Instance()->SpoofedDeviceId.value_or_default();
-
-            auto szName = Config::Instance()->SpoofedGPUName.value_or_default();
-            std::memset(pDesc->Description, 0, sizeof(pDesc->Description));
-            std::wcscpy(pDesc->Description, szName.c_str());
-
-#ifdef _DEBUG
-            LOG_DEBUG("spoofing");
-#endif
-        }
-    }
+        SpoofDesc(pDesc);
 
     AttachToAdapter(This);
 
@@ -0,0 +1,35 @@
+#include "Dxgi_SpoofingTables.h"
+
+#include <cwchar>
+
+DxgiSpoofedDesc DxgiSpoofingTables::Build(UINT vendorId, UINT deviceId, SIZE_T dedicatedVideoMemory,
+                                          const AdapterSpoofingPolicy& policy)
+{
+    DxgiSpoofedDesc spoofed {};
+    spoofed.dedicatedVideoMemory = dedicatedVideoMemory;
+
+    if (policy.vramGB.has_value())
+    {
+        spoofed.vram = true;
+        spoofed.dedicatedVideoMemory = (SIZE_T) policy.vramGB.value() * 1024 * 1024 * 1024;
+    }
+
+    if (vendorId == VendorId::Microsoft)
+        return spoofed;
+
+    if (policy.targetVendorId.has_value() && policy.targetVendorId.value() != vendorId)
+        return spoofed;
+
+    if (policy.targetDeviceId.has_value() && policy.targetDeviceId.value() != deviceId)
+        return spoofed;
+
+    spoofed.identity = true;
+    spoofed.vendorId = policy.vendorId;
+    spoofed.deviceId = policy.deviceId;
+
+    // Keep the terminator
+    auto length = (std::min)(policy.name.size(), std::size(spoofed.description) - 1);
+    std::wmemcpy(spoofed.description, policy.name.c_str(), length);
+
+    return spoofed;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <pch.h>
+
+#include <optional>
+#include <string>
+
+struct AdapterSpoofingPolicy
+{
+    bool enabled = false;
+    std::optional<UINT> targetVendorId;
+    std::optional<UINT> targetDeviceId;
+    UINT vendorId = 0;
+    UINT deviceId = 0;
+    std::wstring name;
+    std::optional<int> vramGB;
+};
+
+// Everything GetDesc* overlays on the real desc of an adapter
+struct DxgiSpoofedDesc
+{
+    // Vendor, device and description, only applied while spoofing isn't skipped
+    bool identity = false;
+    UINT vendorId = 0;
+    UINT deviceId = 0;
+    WCHAR description[128] {};
+
+    bool vram = false;
+    SIZE_T dedicatedVideoMemory = 0;
+};
+
+struct AdapterTopologyEntry
+{
+    // Position in the high performance order, adapters are enumerated again when returned.
+    // Holding them would keep their factory alive
+    UINT index = 0;
+
+    LUID luid {};
+    UINT vendorId = 0;
+    UINT deviceId = 0;
+    SIZE_T dedicatedVideoMemory = 0;
+    bool software = false;
+    std::wstring description;
+
+    // What GetDesc will report, built once with the snapshot
+    DxgiSpoofedDesc spoofed;
+};
+
+// What an adapter reports with the spoofing settings. Nothing here calls DXGI or reads the config,
+// the topology and the desc cache live in their own files.
+class DxgiSpoofingTables
+{
+  public:
+    // VRAM is overridden for every adapter, the identity only for matching non software ones.
+    // Policy's enabled flag is ignored, it is checked by the caller on every call
+    static DxgiSpoofedDesc Build(UINT vendorId, UINT deviceId, SIZE_T dedicatedVideoMemory,
+                                 const AdapterSpoofingPolicy& policy);
+};
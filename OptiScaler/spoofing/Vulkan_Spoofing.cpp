@@ -1,6 +1,8 @@
 #include "Vulkan_Spoofing.h"
+#include "Vulkan_SpoofingTables.h"
 
 #include <Config.h>
+#include <misc/StartupScheduler.h>
 
 #include <proxies/KernelBase_Proxy.h>
 
@@ -8,8 +10,31 @@
 
 #include <vulkan/vulkan_core.h>
 
-static std::map<std::string, bool> vkDeviceExtensions;
-static std::map<std::string, bool> vkInstanceExtensions;
+#include <ankerl/unordered_dense.h>
+
+#undef LOG_CATEGORY
+#define LOG_CATEGORY LogCategory::Spoofing
+
+struct DeviceSpoofing
+{
+    // Driver ids the entry was built for
+    uint32_t vendorId = 0;
+    uint32_t deviceId = 0;
+
+    bool hasProperties = false;
+    bool spoofed = false;
+    VkPhysicalDeviceProperties reported {};
+
+    bool hasExtensions = false;
+    uint32_t driverExtensionCount = 0;
+    VulkanExtensionSet driverExtensions;
+    std::vector<VkExtensionProperties> advertisedExtensions;
+};
+
+static std::mutex spoofingMutex;
+static ankerl::unordered_dense::map<VkPhysicalDevice, DeviceSpoofing> deviceSpoofing;
+static std::optional<VulkanSpoofingPolicy> spoofingPolicy;
+static VulkanExtensionSet vkInstanceExtensions;
 
 // #define VULKAN_DEBUG_LAYER
 
@@ -32,9 +57,6 @@ static PFN_vkEnumerateInstanceExtensionProperties o_vkEnumerateInstanceExtension
 static PFN_vkGetInstanceProcAddr o_vkGetInstanceProcAddr = nullptr;
 static PFN_vkGetDeviceProcAddr o_vkGetDeviceProcAddr = nullptr;
 
-static uint32_t vkEnumerateInstanceExtensionPropertiesCount = 0;
-static uint32_t vkEnumerateDeviceExtensionPropertiesCount = 0;
-static bool vkEnumerateDeviceExtensionPropertiesListed = false;
 static bool vkEnumerateInstanceExtensionPropertiesListed = false;
 
 inline static void hkvkGetPhysicalDeviceMemoryProperties(VkPhysicalDevice physicalDevice,
@@ -93,167 +115,211 @@ inline static void hkvkGetPhysicalDeviceMemoryProperties2KHR(VkPhysicalDevice ph
     }
 }
 
-inline static void hkvkGetPhysicalDeviceProperties(VkPhysicalDevice physical_device,
-                                                   VkPhysicalDeviceProperties* properties)
+static VulkanSpoofingPolicy CurrentSpoofingPolicy()
 {
-    o_vkGetPhysicalDeviceProperties(physical_device, properties);
+    auto config = Config::Instance();
+
+    VulkanSpoofingPolicy policy {};
+    policy.enabled = config->VulkanSpoofing.value_or_default();
+    policy.vendorId = config->SpoofedVendorId.value_or_default();
+    policy.deviceId = config->SpoofedDeviceId.value_or_default();
+    policy.name = wstring_to_string(config->SpoofedGPUName.value_or_default());
+
+    if (config->TargetVendorId.has_value())
+        policy.targetVendorId = config->TargetVendorId.value();
+
+    if (config->TargetDeviceId.has_value())
+        policy.targetDeviceId = config->TargetDeviceId.value();
+
+    return policy;
+}
+
+// Spoofing options are only read at startup, the reported properties are built once per device
+static DeviceSpoofing& GetDeviceSpoofing(VkPhysicalDevice physicalDevice, const VkPhysicalDeviceProperties& original)
+{
+    auto& entry = deviceSpoofing[physicalDevice];
+
+    // Handle can be reused by a new instance for another GPU
+    if (entry.hasProperties && entry.vendorId == original.vendorID && entry.deviceId == original.deviceID)
+        return entry;
+
+    if (!spoofingPolicy.has_value())
+        spoofingPolicy = CurrentSpoofingPolicy();
+
+    entry.vendorId = original.vendorID;
+    entry.deviceId = original.deviceID;
+    entry.reported = VulkanSpoofingTables::SpoofProperties(original, spoofingPolicy.value());
+    entry.spoofed = VulkanSpoofingTables::PolicyMatches(spoofingPolicy.value(), original.vendorID, original.deviceID);
+    entry.hasProperties = true;
 
     // Report adapter info
-    auto uniqueId = properties->vendorID | properties->deviceID;
-    if (properties->vendorID != VendorId::Microsoft && !State::Instance().adapterDescs.contains(uniqueId))
+    auto uniqueId = original.vendorID | original.deviceID;
+    if (original.vendorID != VendorId::Microsoft && !State::Instance().adapterDescs.contains(uniqueId))
     {
-        std::string szName(properties->deviceName);
-        std::string descStr = std::format("Adapter: {}, VendorId: {:#x}, DeviceId: {:#x}", szName, properties->vendorID,
-                                          properties->deviceID);
+        std::string descStr = std::format("Adapter: {}, VendorId: {:#x}, DeviceId: {:#x}", original.deviceName,
+                                          original.vendorID, original.deviceID);
         LOG_INFO("{}", descStr);
         State::Instance().adapterDescs.insert_or_assign(uniqueId, descStr);
     }
 
-    auto targetVendorIdMatches = !Config::Instance()->TargetVendorId.has_value() ||
-                                 Config::Instance()->TargetVendorId.value() == properties->vendorID;
+    LOG_DEBUG("{} {}", entry.spoofed ? "Spoofing" : "Not spoofing", original.deviceName);
+
+    return entry;
+}
 
-    auto targetDeviceIdMatches = !Config::Instance()->TargetDeviceId.has_value() ||
-                                 Config::Instance()->TargetDeviceId.value() == properties->deviceID;
+// Returns true when the properties were replaced with the spoofed ones
+static bool ApplySpoofedProperties(VkPhysicalDevice physicalDevice, VkPhysicalDeviceProperties* properties)
+{
+    if (properties == nullptr || State::Instance().skipSpoofing)
+        return false;
 
-    // Spoof
-    if (!State::Instance().skipSpoofing && targetVendorIdMatches && targetDeviceIdMatches)
-    {
-        auto deviceName = wstring_to_string(Config::Instance()->SpoofedGPUName.value_or_default());
-        std::strcpy(properties->deviceName, deviceName.c_str());
+    std::scoped_lock lock(spoofingMutex);
+    auto& entry = GetDeviceSpoofing(physicalDevice, *properties);
 
-        properties->vendorID = Config::Instance()->SpoofedVendorId.value_or_default();
-        properties->deviceID = Config::Instance()->SpoofedDeviceId.value_or_default();
-        properties->driverVersion = VK_MAKE_API_VERSION(999, 99, 0, 0);
+    if (!entry.spoofed)
+        return false;
 
-        LOG_DEBUG("Spoofed");
-    }
-    else
+    std::memcpy(properties, &entry.reported, sizeof(VkPhysicalDeviceProperties));
+    return true;
+}
+
+static void SpoofDriverProperties(VkPhysicalDeviceProperties2* properties2)
+{
+    // If spoofing Nvidia
+    if (spoofingPolicy.value().vendorId != VendorId::Nvidia)
+        return;
+
+    auto next = (VkDummyProps*) properties2->pNext;
+
+    while (next != nullptr)
     {
-        LOG_DEBUG("Skipping spoofing");
+        if (next->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DRIVER_PROPERTIES)
+        {
+            auto ddp = (VkPhysicalDeviceDriverProperties*) (void*) next;
+            ddp->driverID = VK_DRIVER_ID_NVIDIA_PROPRIETARY;
+            std::strcpy(ddp->driverName, "NVIDIA");
+            std::strcpy(ddp->driverInfo, "999.99");
+        }
+
+        next = (VkDummyProps*) next->pNext;
     }
 }
 
+inline static void hkvkGetPhysicalDeviceProperties(VkPhysicalDevice physical_device,
+                                                   VkPhysicalDeviceProperties* properties)
+{
+    o_vkGetPhysicalDeviceProperties(physical_device, properties);
+    ApplySpoofedProperties(physical_device, properties);
+}
+
 inline static void hkvkGetPhysicalDeviceProperties2(VkPhysicalDevice phys_dev, VkPhysicalDeviceProperties2* properties2)
 {
     o_vkGetPhysicalDeviceProperties2(phys_dev, properties2);
 
-    // Report adapter info
-    auto uniqueId = properties2->properties.vendorID | properties2->properties.deviceID;
-    if (properties2->properties.vendorID != VendorId::Microsoft && !State::Instance().adapterDescs.contains(uniqueId))
-    {
-        std::string szName(properties2->properties.deviceName);
-        std::string descStr = std::format("Adapter: {}, VendorId: {:#x}, DeviceId: {:#x}", szName,
-                                          properties2->properties.vendorID, properties2->properties.deviceID);
-        LOG_INFO("{}", descStr);
-        State::Instance().adapterDescs.insert_or_assign(uniqueId, descStr);
-    }
+    if (properties2 != nullptr && ApplySpoofedProperties(phys_dev, &properties2->properties))
+        SpoofDriverProperties(properties2);
+}
+
+inline static void hkvkGetPhysicalDeviceProperties2KHR(VkPhysicalDevice phys_dev,
+                                                       VkPhysicalDeviceProperties2* properties2)
+{
+    o_vkGetPhysicalDeviceProperties2KHR(phys_dev, properties2);
+
+    if (properties2 != nullptr && ApplySpoofedProperties(phys_dev, &properties2->properties))
+        SpoofDriverProperties(properties2);
+}
+
+inline static VKAPI_ATTR VkBool32 VKAPI_CALL VulkanDebugCallback(
+    VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity, VkDebugUtilsMessageTypeFlagsEXT messageTypes,
+    const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData, void* pUserData)
+{
+    LOG_TRACE("{}", pCallbackData->pMessage);
+    return VK_FALSE; // return VK_TRUE to abort calls that triggered validation errors
+}
 
-    auto targetVendorIdMatches = !Config::Instance()->TargetVendorId.has_value() ||
-                                 Config::Instance()->TargetVendorId.value() == properties2->properties.vendorID;
+// Lists the driver extensions of the device once, spoofed list is served from it afterwards
+static DeviceSpoofing* GetDeviceExtensions(VkPhysicalDevice physicalDevice, bool checkCount)
+{
+    if (o_vkEnumerateDeviceExtensionProperties == nullptr)
+        return nullptr;
 
-    auto targetDeviceIdMatches = !Config::Instance()->TargetDeviceId.has_value() ||
-                                 Config::Instance()->TargetDeviceId.value() == properties2->properties.deviceID;
+    auto& entry = deviceSpoofing[physicalDevice];
 
-    // Spoof
-    if (!State::Instance().skipSpoofing && targetVendorIdMatches && targetDeviceIdMatches)
+    uint32_t count = 0;
+
+    if (entry.hasExtensions)
     {
-        auto deviceName = wstring_to_string(Config::Instance()->SpoofedGPUName.value_or_default());
-        std::strcpy(properties2->properties.deviceName, deviceName.c_str());
-        properties2->properties.vendorID = Config::Instance()->SpoofedVendorId.value_or_default();
-        properties2->properties.deviceID = Config::Instance()->SpoofedDeviceId.value_or_default();
-        properties2->properties.driverVersion = VK_MAKE_API_VERSION(999, 99, 0, 0);
+        if (!checkCount)
+            return &entry;
 
-        // If spoofing Nvidia
-        if (Config::Instance()->SpoofedVendorId.value_or_default() == VendorId::Nvidia)
+        // Count changes when the handle was reused for another GPU
+        if (o_vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &count, nullptr) == VK_SUCCESS &&
+            count == entry.driverExtensionCount)
         {
-            auto next = (VkDummyProps*) properties2->pNext;
-
-            while (next != nullptr)
-            {
-                if (next->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DRIVER_PROPERTIES)
-                {
-                    auto ddp = (VkPhysicalDeviceDriverProperties*) (void*) next;
-                    ddp->driverID = VK_DRIVER_ID_NVIDIA_PROPRIETARY;
-                    std::strcpy(ddp->driverName, "NVIDIA");
-                    std::strcpy(ddp->driverInfo, "999.99");
-                }
-
-                next = (VkDummyProps*) next->pNext;
-            }
+            return &entry;
         }
-
-        LOG_DEBUG("Spoofed");
     }
-    else
+
+    std::vector<VkExtensionProperties> extensions;
+    VkResult result;
+
+    do
     {
-        LOG_DEBUG("Skipping spoofing");
-    }
-}
+        result = o_vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &count, nullptr);
 
-inline static void hkvkGetPhysicalDeviceProperties2KHR(VkPhysicalDevice phys_dev,
-                                                       VkPhysicalDeviceProperties2* properties2)
-{
-    o_vkGetPhysicalDeviceProperties2KHR(phys_dev, properties2);
+        if (result != VK_SUCCESS)
+            break;
 
-    // Report adapter info
-    auto uniqueId = properties2->properties.vendorID | properties2->properties.deviceID;
-    if (properties2->properties.vendorID != VendorId::Microsoft && !State::Instance().adapterDescs.contains(uniqueId))
+        extensions.resize(count);
+        result = o_vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &count, extensions.data());
+    } while (result == VK_INCOMPLETE);
+
+    if (result != VK_SUCCESS)
     {
-        std::string szName(properties2->properties.deviceName);
-        std::string descStr = std::format("Adapter: {}, VendorId: {:#x}, DeviceId: {:#x}", szName,
-                                          properties2->properties.vendorID, properties2->properties.deviceID);
-        LOG_INFO("{}", descStr);
-        State::Instance().adapterDescs.insert_or_assign(uniqueId, descStr);
+        LOG_ERROR("o_vkEnumerateDeviceExtensionProperties result: {:X}", (UINT) result);
+        entry.hasExtensions = false;
+        return nullptr;
     }
 
-    auto targetVendorIdMatches = !Config::Instance()->TargetVendorId.has_value() ||
-                                 Config::Instance()->TargetVendorId.value() == properties2->properties.vendorID;
+    extensions.resize(count);
+
+    LOG_DEBUG("Extensions returned:");
+    for (auto& extension : extensions)
+        LOG_DEBUG("  {}", extension.extensionName);
+
+    entry.driverExtensionCount = count;
+    entry.driverExtensions.Assign(extensions);
+    entry.advertisedExtensions = VulkanSpoofingTables::BuildAdvertisedExtensions(extensions);
+    entry.hasExtensions = true;
+
+    LOG_DEBUG("Advertising {} extensions, {} from driver", entry.advertisedExtensions.size(), count);
 
-    auto targetDeviceIdMatches = !Config::Instance()->TargetDeviceId.has_value() ||
-                                 Config::Instance()->TargetDeviceId.value() == properties2->properties.deviceID;
+    return &entry;
+}
+
+static VulkanExtensionSet GetInstanceExtensions()
+{
+    std::scoped_lock lock(spoofingMutex);
 
-    // Spoof
-    if (!State::Instance().skipSpoofing && targetVendorIdMatches && targetDeviceIdMatches)
+    // Game didn't list them before creating the instance
+    if (vkInstanceExtensions.Empty() && o_vkEnumerateInstanceExtensionProperties != nullptr)
     {
-        auto deviceName = wstring_to_string(Config::Instance()->SpoofedGPUName.value_or_default());
-        std::strcpy(properties2->properties.deviceName, deviceName.c_str());
-        properties2->properties.vendorID = Config::Instance()->SpoofedVendorId.value_or_default();
-        properties2->properties.deviceID = Config::Instance()->SpoofedDeviceId.value_or_default();
-        properties2->properties.driverVersion = VK_MAKE_API_VERSION(999, 99, 0, 0);
+        uint32_t count = 0;
+        std::vector<VkExtensionProperties> extensions;
 
-        // If spoofing Nvidia
-        if (Config::Instance()->SpoofedVendorId.value_or_default() == VendorId::Nvidia)
+        if (o_vkEnumerateInstanceExtensionProperties(nullptr, &count, nullptr) == VK_SUCCESS)
         {
-            auto next = (VkDummyProps*) properties2->pNext;
+            extensions.resize(count);
 
-            while (next != nullptr)
+            if (o_vkEnumerateInstanceExtensionProperties(nullptr, &count, extensions.data()) == VK_SUCCESS)
             {
-                if (next->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DRIVER_PROPERTIES)
-                {
-                    auto ddp = (VkPhysicalDeviceDriverProperties*) (void*) next;
-                    ddp->driverID = VK_DRIVER_ID_NVIDIA_PROPRIETARY;
-                    std::strcpy(ddp->driverName, "NVIDIA");
-                    std::strcpy(ddp->driverInfo, "999.99");
-                }
-
-                next = (VkDummyProps*) next->pNext;
+                extensions.resize(count);
+                vkInstanceExtensions.Assign(extensions);
             }
         }
-
-        LOG_DEBUG("Spoofed");
-    }
-    else
-    {
-        LOG_DEBUG("Skipping spoofing");
     }
-}
 
-inline static VKAPI_ATTR VkBool32 VKAPI_CALL VulkanDebugCallback(
-    VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity, VkDebugUtilsMessageTypeFlagsEXT messageTypes,
-    const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData, void* pUserData)
-{
-    LOG_TRACE("{}", pCallbackData->pMessage);
-    return VK_FALSE; // return VK_TRUE to abort calls that triggered validation errors
+    return vkInstanceExtensions;
 }
 
 inline static VkResult hkvkCreateInstance(VkInstanceCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator,
@@ -262,31 +328,25 @@ inline static VkResult hkvkCreateInstance(VkInstanceCreateInfo* pCreateInfo, con
     if (pCreateInfo->pApplicationInfo->pApplicationName != nullptr)
         LOG_DEBUG("ApplicationName: {}", pCreateInfo->pApplicationInfo->pApplicationName);
 
-    std::vector<const char*> newExtensionList;
+    std::span<const char* const> requested(pCreateInfo->ppEnabledExtensionNames, pCreateInfo->enabledExtensionCount);
 
-    LOG_DEBUG("Extensions ({}):", pCreateInfo->enabledExtensionCount);
-    for (size_t i = 0; i < pCreateInfo->enabledExtensionCount; i++)
-    {
-        LOG_DEBUG("  {}", pCreateInfo->ppEnabledExtensionNames[i]);
-        newExtensionList.push_back(pCreateInfo->ppEnabledExtensionNames[i]);
-    }
+    LOG_DEBUG("Extensions ({}):", requested.size());
+    for (auto name : requested)
+        LOG_DEBUG("  {}", name);
+
+    StartupScheduler::Instance().Wait(StartupSteps::DlssFiles);
+
+    uint32_t needs = VulkanExtension_Ffx;
 
     if (State::Instance().isRunningOnNvidia && Config::Instance()->DLSSEnabled.value_or_default())
     {
         LOG_INFO("Adding NVNGX Vulkan extensions");
-        if (vkInstanceExtensions.contains(std::string(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME)))
-            newExtensionList.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
-
-        if (vkInstanceExtensions.contains(std::string(VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME)))
-            newExtensionList.push_back(VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME);
-
-        if (vkInstanceExtensions.contains(std::string(VK_KHR_EXTERNAL_SEMAPHORE_CAPABILITIES_EXTENSION_NAME)))
-            newExtensionList.push_back(VK_KHR_EXTERNAL_SEMAPHORE_CAPABILITIES_EXTENSION_NAME);
+        needs |= VulkanExtension_Nvngx;
     }
 
     LOG_INFO("Adding FFX Vulkan extensions");
-    if (vkInstanceExtensions.contains(std::string(VK_EXT_DEBUG_UTILS_EXTENSION_NAME)))
-        newExtensionList.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+    auto newExtensionList = VulkanSpoofingTables::BuildExtensionList(
+        requested, VulkanSpoofingTables::InstanceExtensionRules(), GetInstanceExtensions(), needs, false);
 
     LOG_DEBUG("Layer count: {}", pCreateInfo->enabledLayerCount);
     for (size_t i = 0; i < pCreateInfo->enabledLayerCount; i++)
@@ -362,74 +422,43 @@ inline static VkResult hkvkCreateDevice(VkPhysicalDevice physicalDevice, VkDevic
 {
     LOG_FUNC();
 
-    std::vector<const char*> newExtensionList;
+    std::span<const char* const> requested(pCreateInfo->ppEnabledExtensionNames, pCreateInfo->enabledExtensionCount);
 
-    LOG_DEBUG("Checking extensions and removing Streamline ones");
-    for (size_t i = 0; i < pCreateInfo->enabledExtensionCount; i++)
-    {
-        auto extName = pCreateInfo->ppEnabledExtensionNames[i];
-
-        if (Config::Instance()->VulkanExtensionSpoofing.value_or_default() && !State::Instance().isRunningOnNvidia)
-        {
-            auto binaryImport = std::strcmp(extName, VK_NVX_BINARY_IMPORT_EXTENSION_NAME) == 0;
-            auto imgViewHandle = std::strcmp(extName, VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME) == 0;
-            auto bufferDeviceAddr = std::strcmp(extName, VK_EXT_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME) == 0;
-            auto mvPerViewAttr = std::strcmp(extName, VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_EXTENSION_NAME) == 0;
-            auto nvLowLatency = std::strcmp(extName, VK_NV_LOW_LATENCY_EXTENSION_NAME) == 0;
+    VulkanExtensionSet available;
 
-            if (binaryImport || imgViewHandle || bufferDeviceAddr || mvPerViewAttr || nvLowLatency)
-            {
-                LOG_DEBUG("Removing {}", extName);
-                continue;
-            }
-        }
+    {
+        std::scoped_lock lock(spoofingMutex);
 
-        // LOG_DEBUG("Adding {}", extName);
-        newExtensionList.push_back(extName);
+        if (auto entry = GetDeviceExtensions(physicalDevice, false); entry != nullptr)
+            available = entry->driverExtensions;
     }
 
-    const bool isPascalOrOlder = State::Instance().isPascalOrOlder;
+    uint32_t needs = VulkanExtension_Ffx;
+
     if (State::Instance().isRunningOnNvidia)
     {
         LOG_INFO("Adding NVNGX Vulkan extensions");
-        if (vkDeviceExtensions.contains(std::string(VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_EXTENSION_NAME)))
-            newExtensionList.push_back(VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_EXTENSION_NAME);
-
-        if (vkDeviceExtensions.contains(std::string(VK_NV_LOW_LATENCY_EXTENSION_NAME)))
-            newExtensionList.push_back(VK_NV_LOW_LATENCY_EXTENSION_NAME);
-
-        if (vkDeviceExtensions.contains(std::string(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME)))
-            newExtensionList.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
-
-        if (vkDeviceExtensions.contains(std::string(VK_EXT_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME)))
-            newExtensionList.push_back(VK_EXT_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME);
-
-        if (!isPascalOrOlder)
-        {
-            if (vkDeviceExtensions.contains(std::string(VK_NVX_BINARY_IMPORT_EXTENSION_NAME)))
-                newExtensionList.push_back(VK_NVX_BINARY_IMPORT_EXTENSION_NAME);
+        needs |= VulkanExtension_Nvngx;
 
-            if (vkDeviceExtensions.contains(std::string(VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME)))
-                newExtensionList.push_back(VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME);
-        }
+        if (!State::Instance().isPascalOrOlder)
+            needs |= VulkanExtension_NvngxTuring;
     }
 
     LOG_INFO("Adding FFX Vulkan extensions");
-    if (vkDeviceExtensions.contains(std::string(VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME)))
-        newExtensionList.push_back(VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME);
 
     if (State::Instance().libxessExists)
     {
         LOG_INFO("Adding XeSS Vulkan extensions");
-        if (vkDeviceExtensions.contains(std::string(VK_KHR_SHADER_FLOAT16_INT8_EXTENSION_NAME)))
-            newExtensionList.push_back(VK_KHR_SHADER_FLOAT16_INT8_EXTENSION_NAME);
+        needs |= VulkanExtension_XeSS;
+    }
 
-        if (vkDeviceExtensions.contains(std::string(VK_KHR_SHADER_INTEGER_DOT_PRODUCT_EXTENSION_NAME)))
-            newExtensionList.push_back(VK_KHR_SHADER_INTEGER_DOT_PRODUCT_EXTENSION_NAME);
+    // Streamline ones are advertised by us, driver doesn't have them when not running on Nvidia
+    LOG_DEBUG("Checking extensions and removing Streamline ones");
+    auto stripSpoofed =
+        Config::Instance()->VulkanExtensionSpoofing.value_or_default() && !State::Instance().isRunningOnNvidia;
 
-        if (vkDeviceExtensions.contains(std::string(VK_EXT_MUTABLE_DESCRIPTOR_TYPE_EXTENSION_NAME)))
-            newExtensionList.push_back(VK_EXT_MUTABLE_DESCRIPTOR_TYPE_EXTENSION_NAME);
-    }
+    auto newExtensionList = VulkanSpoofingTables::BuildExtensionList(
+        requested, VulkanSpoofingTables::DeviceExtensionRules(), available, needs, stripSpoofed);
 
     pCreateInfo->enabledExtensionCount = static_cast<uint32_t>(newExtensionList.size());
     pCreateInfo->ppEnabledExtensionNames = newExtensionList.data();
@@ -457,81 +486,22 @@ inline static VkResult hkvkEnumerateDeviceExtensionProperties(VkPhysicalDevice p
 {
     LOG_FUNC();
 
-    uint32_t count = 0;
-
-    if (pPropertyCount != nullptr)
-        count = *pPropertyCount;
-
-    if (pProperties == nullptr)
-        count = 0;
-
-    auto result = o_vkEnumerateDeviceExtensionProperties(physicalDevice, pLayerName, pPropertyCount, pProperties);
+    // Layer lists and our own queries are passed through
+    if (pLayerName != nullptr || pPropertyCount == nullptr || State::Instance().skipSpoofing)
+        return o_vkEnumerateDeviceExtensionProperties(physicalDevice, pLayerName, pPropertyCount, pProperties);
 
-    if (result != VK_SUCCESS)
-    {
-        LOG_ERROR("o_vkEnumerateDeviceExtensionProperties({}) result: {:X}", count, (UINT) result);
-        return result;
-    }
+    VkResult result;
 
-    if (!State::Instance().skipSpoofing)
     {
-        // Count query, modify and add 5 to final count
-        if (pProperties == nullptr && pPropertyCount != nullptr && count == 0)
-        {
-            *pPropertyCount += 5;
-            vkEnumerateDeviceExtensionPropertiesCount = *pPropertyCount;
-            LOG_TRACE("vkEnumerateDeviceExtensionProperties count: {}", *pPropertyCount);
-            return result;
-        }
-
-        // If this is request of our modified count query (count == vkEnumerateDeviceExtensionPropertiesCount)
-        if (pProperties != nullptr && pPropertyCount != nullptr && *pPropertyCount > 0 &&
-            count == vkEnumerateDeviceExtensionPropertiesCount)
-        {
-            // Set back modified extension count
-            *pPropertyCount = count;
-
-            // And fill extension info at the end
-            VkExtensionProperties bi { VK_NVX_BINARY_IMPORT_EXTENSION_NAME, VK_NVX_BINARY_IMPORT_SPEC_VERSION };
-            memcpy(&pProperties[*pPropertyCount - 1], &bi, sizeof(VkExtensionProperties));
-
-            VkExtensionProperties ivh { VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME,
-                                        VK_NVX_IMAGE_VIEW_HANDLE_SPEC_VERSION };
-            memcpy(&pProperties[*pPropertyCount - 2], &ivh, sizeof(VkExtensionProperties));
-
-            VkExtensionProperties mpva { VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_EXTENSION_NAME,
-                                         VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_SPEC_VERSION };
-            memcpy(&pProperties[*pPropertyCount - 3], &mpva, sizeof(VkExtensionProperties));
+        std::scoped_lock lock(spoofingMutex);
 
-            VkExtensionProperties ll { VK_NV_LOW_LATENCY_EXTENSION_NAME, VK_NV_LOW_LATENCY_SPEC_VERSION };
-            memcpy(&pProperties[*pPropertyCount - 4], &ll, sizeof(VkExtensionProperties));
+        // Count query starts a new listing, make sure the list still belongs to this device
+        auto entry = GetDeviceExtensions(physicalDevice, pProperties == nullptr);
 
-            VkExtensionProperties bda { VK_EXT_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME,
-                                        VK_EXT_BUFFER_DEVICE_ADDRESS_SPEC_VERSION };
-            memcpy(&pProperties[*pPropertyCount - 5], &bda, sizeof(VkExtensionProperties));
+        if (entry == nullptr)
+            return o_vkEnumerateDeviceExtensionProperties(physicalDevice, pLayerName, pPropertyCount, pProperties);
 
-            if (!vkEnumerateDeviceExtensionPropertiesListed)
-            {
-                vkEnumerateDeviceExtensionPropertiesListed = true;
-
-                LOG_DEBUG("Extensions returned:");
-                for (uint32_t i = 0; i < *pPropertyCount; i++)
-                {
-                    LOG_DEBUG("  {}", pProperties[i].extensionName);
-
-                    if (i < (*pPropertyCount - 5))
-                        vkDeviceExtensions.insert_or_assign(std::string(pProperties[i].extensionName), true);
-                }
-            }
-            else
-            {
-                LOG_DEBUG("Modified extension list returned");
-            }
-        }
-        else
-        {
-            LOG_DEBUG("Not adding any extensions!");
-        }
+        result = VulkanSpoofingTables::CopyExtensions(entry->advertisedExtensions, pPropertyCount, pProperties);
     }
 
     LOG_FUNC_RESULT(result);
@@ -544,46 +514,32 @@ inline static VkResult hkvkEnumerateInstanceExtensionProperties(const char* pLay
 {
     LOG_FUNC();
 
-    auto count = *pPropertyCount;
-
-    if (pProperties == nullptr)
-        count = 0;
-
     auto result = o_vkEnumerateInstanceExtensionProperties(pLayerName, pPropertyCount, pProperties);
 
     if (result != VK_SUCCESS)
     {
-        LOG_ERROR("o_vkEnumerateInstanceExtensionProperties({}) result: {:X}", count, (UINT) result);
+        LOG_ERROR("o_vkEnumerateInstanceExtensionProperties result: {:X}", (UINT) result);
         return result;
     }
 
-    if (!State::Instance().skipSpoofing)
+    if (!State::Instance().skipSpoofing && pLayerName == nullptr && pPropertyCount != nullptr &&
+        pProperties != nullptr)
     {
-        if (pLayerName == nullptr && pProperties == nullptr && count == 0)
+        std::scoped_lock lock(spoofingMutex);
+
+        if (!vkEnumerateInstanceExtensionPropertiesListed)
         {
-            LOG_TRACE("hkvkEnumerateDeviceExtensionProperties({0}) count: {1}", pLayerName,
-                      vkEnumerateDeviceExtensionPropertiesCount);
+            vkEnumerateInstanceExtensionPropertiesListed = true;
 
-            return result;
-        }
+            LOG_DEBUG("Extensions returned:");
+            for (size_t i = 0; i < *pPropertyCount; i++)
+                LOG_DEBUG("  {}", pProperties[i].extensionName);
 
-        if (pPropertyCount != nullptr && pProperties != nullptr)
+            vkInstanceExtensions.Assign(std::span<const VkExtensionProperties>(pProperties, *pPropertyCount));
+        }
+        else
         {
-            if (!vkEnumerateInstanceExtensionPropertiesListed)
-            {
-                vkEnumerateInstanceExtensionPropertiesListed = true;
-
-                LOG_DEBUG("Extensions returned:");
-                for (size_t i = 0; i < *pPropertyCount; i++)
-                {
-                    LOG_DEBUG("  {}", pProperties[i].extensionName);
-                    vkInstanceExtensions.insert_or_assign(std::string(pProperties[i].extensionName), true);
-                }
-            }
-            else
-            {
-                LOG_DEBUG("Modified extension list returned");
-            }
+            LOG_DEBUG("Modified extension list returned");
         }
     }
 
@@ -594,38 +550,38 @@ inline static VkResult hkvkEnumerateInstanceExtensionProperties(const char* pLay
 
 inline static PFN_vkVoidFunction hkvkGetInstanceProcAddr(VkInstance instance, const char* pName)
 {
-    auto procName = std::string(pName);
+    std::string_view procName(pName);
 
     LOG_DEBUG("{}", procName);
 
-    if (procName == std::string("vkGetPhysicalDeviceProperties"))
+    if (procName == "vkGetPhysicalDeviceProperties")
     {
         return (PFN_vkVoidFunction) hkvkGetPhysicalDeviceProperties;
     }
-    else if (procName == std::string("vkGetPhysicalDeviceProperties2"))
+    else if (procName == "vkGetPhysicalDeviceProperties2")
     {
         return (PFN_vkVoidFunction) hkvkGetPhysicalDeviceProperties2;
     }
-    else if (procName == std::string("vkGetPhysicalDeviceProperties2KHR"))
+    else if (procName == "vkGetPhysicalDeviceProperties2KHR")
     {
         return (PFN_vkVoidFunction) hkvkGetPhysicalDeviceProperties2KHR;
     }
 
     if (Config::Instance()->VulkanExtensionSpoofing.value_or_default())
     {
-        if (procName == std::string("vkCreateInstance"))
+        if (procName == "vkCreateInstance")
         {
             return (PFN_vkVoidFunction) hkvkCreateInstance;
         }
-        else if (procName == std::string("vkCreateDevice"))
+        else if (procName == "vkCreateDevice")
         {
             return (PFN_vkVoidFunction) hkvkCreateDevice;
         }
-        else if (procName == std::string("vkEnumerateInstanceExtensionProperties"))
+        else if (procName == "vkEnumerateInstanceExtensionProperties")
         {
             return (PFN_vkVoidFunction) hkvkEnumerateInstanceExtensionProperties;
         }
-        else if (procName == std::string("vkEnumerateDeviceExtensionProperties"))
+        else if (procName == "vkEnumerateDeviceExtensionProperties")
         {
             return (PFN_vkVoidFunction) hkvkEnumerateDeviceExtensionProperties;
         }
@@ -633,15 +589,15 @@ inline static PFN_vkVoidFunction hkvkGetInstanceProcAddr(VkInstance instance, co
 
     if (Config::Instance()->VulkanVRAM.has_value())
     {
-        if (procName == std::string("vkGetPhysicalDeviceMemoryProperties"))
+        if (procName == "vkGetPhysicalDeviceMemoryProperties")
         {
             return (PFN_vkVoidFunction) hkvkGetPhysicalDeviceMemoryProperties;
         }
-        else if (procName == std::string("vkGetPhysicalDeviceMemoryProperties2"))
+        else if (procName == "vkGetPhysicalDeviceMemoryProperties2")
         {
             return (PFN_vkVoidFunction) hkvkGetPhysicalDeviceMemoryProperties2;
         }
-        else if (procName == std::string("vkGetPhysicalDeviceMemoryProperties2KHR"))
+        else if (procName == "vkGetPhysicalDeviceMemoryProperties2KHR")
         {
             return (PFN_vkVoidFunction) hkvkGetPhysicalDeviceMemoryProperties2KHR;
         }
@@ -652,38 +608,38 @@ inline static PFN_vkVoidFunction hkvkGetInstanceProcAddr(VkInstance instance, co
 
 inline static PFN_vkVoidFunction hkvkGetDeviceProcAddr(VkDevice device, const char* pName)
 {
-    auto procName = std::string(pName);
+    std::string_view procName(pName);
 
     LOG_DEBUG("{}", procName);
 
-    if (procName == std::string("vkGetPhysicalDeviceProperties"))
+    if (procName == "vkGetPhysicalDeviceProperties")
     {
         return (PFN_vkVoidFunction) hkvkGetPhysicalDeviceProperties;
     }
-    else if (procName == std::string("vkGetPhysicalDeviceProperties2"))
+    else if (procName == "vkGetPhysicalDeviceProperties2")
     {
         return (PFN_vkVoidFunction) hkvkGetPhysicalDeviceProperties2;
     }
-    else if (procName == std::string("vkGetPhysicalDeviceProperties2KHR"))
+    else if (procName == "vkGetPhysicalDeviceProperties2KHR")
     {
         return (PFN_vkVoidFunction) hkvkGetPhysicalDeviceProperties2KHR;
     }
 
     if (Config::Instance()->VulkanExtensionSpoofing.value_or_default())
     {
-        if (procName == std::string("vkCreateInstance"))
+        if (procName == "vkCreateInstance")
         {
             return (PFN_vkVoidFunction) hkvkCreateInstance;
         }
-        else if (procName == std::string("vkCreateDevice"))
+        else if (procName == "vkCreateDevice")
         {
             return (PFN_vkVoidFunction) hkvkCreateDevice;
         }
-        else if (procName == std::string("vkEnumerateInstanceExtensionProperties"))
+        else if (procName == "vkEnumerateInstanceExtensionProperties")
         {
             return (PFN_vkVoidFunction) hkvkEnumerateInstanceExtensionProperties;
         }
-        else if (procName == std::string("vkEnumerateDeviceExtensionProperties"))
+        else if (procName == "vkEnumerateDeviceExtensionProperties")
         {
             return (PFN_vkVoidFunction) hkvkEnumerateDeviceExtensionProperties;
         }
@@ -691,15 +647,15 @@ inline static PFN_vkVoidFunction hkvkGetDeviceProcAddr(VkDevice device, const ch
 
     if (Config::Instance()->VulkanVRAM.has_value())
     {
-        if (procName == std::string("vkGetPhysicalDeviceMemoryProperties"))
+        if (procName == "vkGetPhysicalDeviceMemoryProperties")
         {
             return (PFN_vkVoidFunction) hkvkGetPhysicalDeviceMemoryProperties;
         }
-        else if (procName == std::string("vkGetPhysicalDeviceMemoryProperties2"))
+        else if (procName == "vkGetPhysicalDeviceMemoryProperties2")
         {
             return (PFN_vkVoidFunction) hkvkGetPhysicalDeviceMemoryProperties2;
         }
-        else if (procName == std::string("vkGetPhysicalDeviceMemoryProperties2KHR"))
+        else if (procName == "vkGetPhysicalDeviceMemoryProperties2KHR")
         {
             return (PFN_vkVoidFunction) hkvkGetPhysicalDeviceMemoryProperties2KHR;
         }
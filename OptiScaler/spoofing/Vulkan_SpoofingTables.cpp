@@ -0,0 +1,218 @@
+#include "Vulkan_SpoofingTables.h"
+
+#include <algorithm>
+#include <cstring>
+
+static bool NameLess(const char* a, const char* b) { return std::strcmp(a, b) < 0; }
+
+static bool NameBefore(const char* element, std::string_view value) { return std::string_view(element) < value; }
+
+static const VkExtensionProperties SpoofedExtensions[] = {
+    { VK_EXT_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME, VK_EXT_BUFFER_DEVICE_ADDRESS_SPEC_VERSION },
+    { VK_NV_LOW_LATENCY_EXTENSION_NAME, VK_NV_LOW_LATENCY_SPEC_VERSION },
+    { VK_NVX_BINARY_IMPORT_EXTENSION_NAME, VK_NVX_BINARY_IMPORT_SPEC_VERSION },
+    { VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME, VK_NVX_IMAGE_VIEW_HANDLE_SPEC_VERSION },
+    { VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_EXTENSION_NAME, VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_SPEC_VERSION },
+};
+
+static const VulkanExtensionRule DeviceRules[] = {
+    { VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_EXTENSION_NAME, VulkanExtension_Nvngx },
+    { VK_NV_LOW_LATENCY_EXTENSION_NAME, VulkanExtension_Nvngx },
+    { VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME, VulkanExtension_Nvngx },
+    { VK_EXT_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME, VulkanExtension_Nvngx },
+    { VK_NVX_BINARY_IMPORT_EXTENSION_NAME, VulkanExtension_NvngxTuring },
+    { VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME, VulkanExtension_NvngxTuring },
+    { VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME, VulkanExtension_Ffx },
+    { VK_KHR_SHADER_FLOAT16_INT8_EXTENSION_NAME, VulkanExtension_XeSS },
+    { VK_KHR_SHADER_INTEGER_DOT_PRODUCT_EXTENSION_NAME, VulkanExtension_XeSS },
+    { VK_EXT_MUTABLE_DESCRIPTOR_TYPE_EXTENSION_NAME, VulkanExtension_XeSS },
+};
+
+static const VulkanExtensionRule InstanceRules[] = {
+    { VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME, VulkanExtension_Nvngx },
+    { VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME, VulkanExtension_Nvngx },
+    { VK_KHR_EXTERNAL_SEMAPHORE_CAPABILITIES_EXTENSION_NAME, VulkanExtension_Nvngx },
+    { VK_EXT_DEBUG_UTILS_EXTENSION_NAME, VulkanExtension_Ffx },
+};
+
+const char* VulkanExtensionSet::Intern(std::string_view name)
+{
+    std::scoped_lock lock(_internMutex);
+
+    // Few dozen names per process, a linear search is enough
+    for (auto& interned : _interned)
+    {
+        if (interned == name)
+            return interned.c_str();
+    }
+
+    return _interned.emplace_back(name).c_str();
+}
+
+void VulkanExtensionSet::Assign(std::span<const VkExtensionProperties> properties)
+{
+    _names.clear();
+    _names.reserve(properties.size());
+
+    for (auto& property : properties)
+    {
+        auto length = strnlen(property.extensionName, VK_MAX_EXTENSION_NAME_SIZE);
+        _names.push_back(Intern(std::string_view(property.extensionName, length)));
+    }
+
+    std::sort(_names.begin(), _names.end(), NameLess);
+    _names.erase(std::unique(_names.begin(), _names.end()), _names.end());
+}
+
+void VulkanExtensionSet::Assign(std::span<const char* const> names)
+{
+    _names.clear();
+    _names.reserve(names.size());
+
+    for (auto name : names)
+    {
+        if (name != nullptr)
+            _names.push_back(Intern(name));
+    }
+
+    std::sort(_names.begin(), _names.end(), NameLess);
+    _names.erase(std::unique(_names.begin(), _names.end()), _names.end());
+}
+
+bool VulkanExtensionSet::Contains(std::string_view name) const
+{
+    auto it = std::lower_bound(_names.begin(), _names.end(), name, NameBefore);
+
+    return it != _names.end() && *it == name;
+}
+
+std::span<const VkExtensionProperties> VulkanSpoofingTables::SpoofedDeviceExtensions() { return SpoofedExtensions; }
+
+bool VulkanSpoofingTables::IsSpoofedDeviceExtension(std::string_view name)
+{
+    for (auto& extension : SpoofedExtensions)
+    {
+        if (name == extension.extensionName)
+            return true;
+    }
+
+    return false;
+}
+
+std::span<const VulkanExtensionRule> VulkanSpoofingTables::DeviceExtensionRules() { return DeviceRules; }
+
+std::span<const VulkanExtensionRule> VulkanSpoofingTables::InstanceExtensionRules() { return InstanceRules; }
+
+std::vector<const char*> VulkanSpoofingTables::BuildExtensionList(std::span<const char* const> requested,
+                                                                  std::span<const VulkanExtensionRule> rules,
+                                                                  const VulkanExtensionSet& available, uint32_t needs,
+                                                                  bool stripSpoofed)
+{
+    std::vector<const char*> result;
+    result.reserve(requested.size() + rules.size());
+
+    VulkanExtensionSet inList;
+    inList.Assign(requested);
+
+    for (auto name : requested)
+    {
+        if (name == nullptr)
+            continue;
+
+        if (stripSpoofed && IsSpoofedDeviceExtension(name))
+        {
+            LOG_DEBUG("Removing {}", name);
+            continue;
+        }
+
+        result.push_back(name);
+    }
+
+    for (auto& rule : rules)
+    {
+        if ((rule.needs & needs) == 0 || !available.Contains(rule.name))
+            continue;
+
+        // A stripped name is added back here when the driver really has it and it's needed
+        if (inList.Contains(rule.name) && !(stripSpoofed && IsSpoofedDeviceExtension(rule.name)))
+            continue;
+
+        result.push_back(rule.name);
+    }
+
+    return result;
+}
+
+std::vector<VkExtensionProperties>
+VulkanSpoofingTables::BuildAdvertisedExtensions(std::span<const VkExtensionProperties> driverExtensions)
+{
+    VulkanExtensionSet driverSet;
+    driverSet.Assign(driverExtensions);
+
+    std::vector<VkExtensionProperties> result(driverExtensions.begin(), driverExtensions.end());
+
+    for (auto& extension : SpoofedExtensions)
+    {
+        if (!driverSet.Contains(extension.extensionName))
+            result.push_back(extension);
+    }
+
+    return result;
+}
+
+VkResult VulkanSpoofingTables::CopyExtensions(std::span<const VkExtensionProperties> extensions,
+                                              uint32_t* pPropertyCount, VkExtensionProperties* pProperties)
+{
+    if (pPropertyCount == nullptr)
+        return VK_ERROR_INITIALIZATION_FAILED;
+
+    auto available = static_cast<uint32_t>(extensions.size());
+
+    if (pProperties == nullptr)
+    {
+        *pPropertyCount = available;
+        return VK_SUCCESS;
+    }
+
+    auto copied = std::min(*pPropertyCount, available);
+
+    if (copied > 0)
+        std::memcpy(pProperties, extensions.data(), copied * sizeof(VkExtensionProperties));
+
+    *pPropertyCount = copied;
+
+    return copied < available ? VK_INCOMPLETE : VK_SUCCESS;
+}
+
+bool VulkanSpoofingTables::PolicyMatches(const VulkanSpoofingPolicy& policy, uint32_t vendorId, uint32_t deviceId)
+{
+    if (!policy.enabled)
+        return false;
+
+    if (policy.targetVendorId.has_value() && policy.targetVendorId.value() != vendorId)
+        return false;
+
+    if (policy.targetDeviceId.has_value() && policy.targetDeviceId.value() != deviceId)
+        return false;
+
+    return true;
+}
+
+VkPhysicalDeviceProperties VulkanSpoofingTables::SpoofProperties(const VkPhysicalDeviceProperties& original,
+                                                                 const VulkanSpoofingPolicy& policy)
+{
+    VkPhysicalDeviceProperties result = original;
+
+    if (!PolicyMatches(policy, original.vendorID, original.deviceID))
+        return result;
+
+    auto length = std::min(policy.name.size(), static_cast<size_t>(VK_MAX_PHYSICAL_DEVICE_NAME_SIZE - 1));
+    std::memcpy(result.deviceName, policy.name.data(), length);
+    result.deviceName[length] = '\0';
+
+    result.vendorID = policy.vendorId;
+    result.deviceID = policy.deviceId;
+    result.driverVersion = VK_MAKE_API_VERSION(999, 99, 0, 0);
+
+    return result;
+}
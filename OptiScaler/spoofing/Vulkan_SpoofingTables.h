@@ -0,0 +1,92 @@
+#pragma once
+
+#include <pch.h>
+
+#include <vulkan/vulkan_core.h>
+
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Extensions OptiScaler adds to the create infos, a rule is used when one of its needs is set
+enum VulkanExtensionNeeds : uint32_t
+{
+    VulkanExtension_None = 0,
+    VulkanExtension_Nvngx = 1 << 0,       // NVNGX on any Nvidia GPU
+    VulkanExtension_NvngxTuring = 1 << 1, // NVNGX on Turing and newer
+    VulkanExtension_Ffx = 1 << 2,
+    VulkanExtension_XeSS = 1 << 3,
+};
+
+struct VulkanExtensionRule
+{
+    const char* name;
+    uint32_t needs;
+};
+
+// Sorted interned names, lookups are a binary search without building strings.
+// Interned names live until the process ends so they can be handed to create infos.
+class VulkanExtensionSet
+{
+    std::vector<const char*> _names;
+
+    inline static std::mutex _internMutex;
+    inline static std::deque<std::string> _interned;
+
+  public:
+    static const char* Intern(std::string_view name);
+
+    void Assign(std::span<const VkExtensionProperties> properties);
+    void Assign(std::span<const char* const> names);
+
+    bool Contains(std::string_view name) const;
+    bool Empty() const { return _names.empty(); }
+    size_t Size() const { return _names.size(); }
+};
+
+struct VulkanSpoofingPolicy
+{
+    bool enabled = false;
+    std::optional<uint32_t> targetVendorId;
+    std::optional<uint32_t> targetDeviceId;
+    uint32_t vendorId = 0;
+    uint32_t deviceId = 0;
+    std::string name;
+};
+
+// Pure helpers behind the Vulkan spoofing hooks, nothing here calls Vulkan
+class VulkanSpoofingTables
+{
+  public:
+    // Advertised on every device, removed again from device create infos when not running on Nvidia
+    static std::span<const VkExtensionProperties> SpoofedDeviceExtensions();
+    static bool IsSpoofedDeviceExtension(std::string_view name);
+
+    static std::span<const VulkanExtensionRule> DeviceExtensionRules();
+    static std::span<const VulkanExtensionRule> InstanceExtensionRules();
+
+    // Requested names minus the spoofed ones when stripSpoofed, plus the rules matching needs which
+    // are available. Names already in the list aren't added again.
+    static std::vector<const char*> BuildExtensionList(std::span<const char* const> requested,
+                                                       std::span<const VulkanExtensionRule> rules,
+                                                       const VulkanExtensionSet& available, uint32_t needs,
+                                                       bool stripSpoofed);
+
+    // Driver list with the spoofed extensions it doesn't have appended
+    static std::vector<VkExtensionProperties> BuildAdvertisedExtensions(
+        std::span<const VkExtensionProperties> driverExtensions);
+
+    // vkEnumerate*ExtensionProperties semantics over a prepared list
+    static VkResult CopyExtensions(std::span<const VkExtensionProperties> extensions, uint32_t* pPropertyCount,
+                                   VkExtensionProperties* pProperties);
+
+    static bool PolicyMatches(const VulkanSpoofingPolicy& policy, uint32_t vendorId, uint32_t deviceId);
+
+    // Returns the properties to report, original when the policy doesn't match the device
+    static VkPhysicalDeviceProperties SpoofProperties(const VkPhysicalDeviceProperties& original,
+                                                      const VulkanSpoofingPolicy& policy);
+};
@@ -2,6 +2,8 @@
 
 #include <State.h>
 
+#include <misc/DynamicResolution.h>
+
 void UpscalerTimeDx11::Init(ID3D11Device* device)
 {
     // Create Disjoint Query
@@ -58,6 +60,19 @@ void UpscalerTimeDx11::ReadUpscalingTime(ID3D11DeviceContext* devieContext)
                     State::Instance().upscaleTimes.push_back(elapsedTimeMs);
                     State::Instance().upscaleTimes.pop_front();
                     State::Instance().frameTimeMutex.unlock();
+
+                    // Upscale ends of consecutive frames on the GPU clock
+                    if (_lastEndTime != 0 && endTime > _lastEndTime)
+                    {
+                        double frameTimeMs =
+                            (endTime - _lastEndTime) / static_cast<double>(disjointData.Frequency) * 1000.0;
+
+                        if (frameTimeMs < 1000.0)
+                            DynamicResolution::OnGpuFrame(frameTimeMs, elapsedTimeMs);
+                    }
+
+                    if (endTime > _lastEndTime)
+                        _lastEndTime = endTime;
                 }
             }
         }
@@ -21,4 +21,5 @@ class UpscalerTimeDx11
     inline static bool _dx11UpscaleTrig[QUERY_BUFFER_COUNT] = { false, false, false };
     inline static int _currentFrameIndex = 0;
     inline static int _previousFrameIndex = 0;
+    inline static UINT64 _lastEndTime = 0;
 };
@@ -2,6 +2,8 @@
 
 #include <State.h>
 
+#include <misc/DynamicResolution.h>
+
 #include <include/d3dx/d3dx12.h>
 
 void UpscalerTimeDx12::Init(ID3D12Device* device)
@@ -82,6 +84,18 @@ void UpscalerTimeDx12::ReadUpscalingTime(ID3D12CommandQueue* commandQueue)
             State::Instance().upscaleTimes.push_back(elapsedTimeMs);
             State::Instance().upscaleTimes.pop_front();
             State::Instance().frameTimeMutex.unlock();
+
+            // Upscale ends of consecutive frames, the same timestamp again is a readback which isn't done yet
+            if (_lastEndTime != 0 && endTime > _lastEndTime)
+            {
+                double frameTimeMs = (endTime - _lastEndTime) / static_cast<double>(gpuFrequency) * 1000.0;
+
+                if (frameTimeMs < 1000.0)
+                    DynamicResolution::OnGpuFrame(frameTimeMs, elapsedTimeMs);
+            }
+
+            if (endTime > _lastEndTime)
+                _lastEndTime = endTime;
         }
     }
     else
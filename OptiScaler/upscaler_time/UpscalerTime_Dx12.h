@@ -16,4 +16,5 @@ class UpscalerTimeDx12
     static inline ID3D12QueryHeap* _queryHeap = nullptr;
     static inline ID3D12Resource* _readbackBuffer = nullptr;
     static inline bool _dx12UpscaleTrig = false;
+    static inline UINT64 _lastEndTime = 0;
 };
@@ -2,6 +2,8 @@
 
 #include <State.h>
 
+#include <misc/DynamicResolution.h>
+
 void UpscalerTimeVk::Init(VkDevice device, VkPhysicalDevice pd)
 {
     VkQueryPoolCreateInfo queryPoolInfo = {};
@@ -39,11 +41,12 @@ void UpscalerTimeVk::ReadUpscalingTime(VkDevice device)
     {
         // Retrieve timestamps
         uint64_t timestamps[2];
-        vkGetQueryPoolResults(device, _queryPool, 0, 2, sizeof(timestamps), timestamps, sizeof(uint64_t),
-                              VK_QUERY_RESULT_64_BIT);
+        auto result = vkGetQueryPoolResults(device, _queryPool, 0, 2, sizeof(timestamps), timestamps,
+                                            sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
 
         // Calculate elapsed time in milliseconds
-        double elapsedTimeMs = (timestamps[1] - timestamps[0]) * _timeStampPeriod / 1e6;
+        auto endTime = timestamps[1];
+        double elapsedTimeMs = (endTime - timestamps[0]) * _timeStampPeriod / 1e6;
 
         if (elapsedTimeMs > 0.0 && elapsedTimeMs < 5000.0)
         {
@@ -51,6 +54,18 @@ void UpscalerTimeVk::ReadUpscalingTime(VkDevice device)
             State::Instance().upscaleTimes.push_back(elapsedTimeMs);
             State::Instance().upscaleTimes.pop_front();
             State::Instance().frameTimeMutex.unlock();
+
+            // Upscale ends of consecutive frames, results which aren't ready yet are skipped
+            if (result == VK_SUCCESS && _lastEndTime != 0 && endTime > _lastEndTime)
+            {
+                double frameTimeMs = (endTime - _lastEndTime) * _timeStampPeriod / 1e6;
+
+                if (frameTimeMs < 1000.0)
+                    DynamicResolution::OnGpuFrame(frameTimeMs, elapsedTimeMs);
+            }
+
+            if (result == VK_SUCCESS && endTime > _lastEndTime)
+                _lastEndTime = endTime;
         }
     }
 
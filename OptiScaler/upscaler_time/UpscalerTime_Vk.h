@@ -16,4 +16,5 @@ class UpscalerTimeVk
     static inline VkQueryPool _queryPool = VK_NULL_HANDLE;
     static inline double _timeStampPeriod = 1.0;
     static inline bool _vkUpscaleTrig = false;
+    static inline uint64_t _lastEndTime = 0;
 };
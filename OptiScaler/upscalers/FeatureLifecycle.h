@@ -0,0 +1,279 @@
+#pragma once
+
+#include <pch.h>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// GPU progress marker for retired features.
+// Signal is called once per present for everything retired since the last one,
+// features are released when CompletedValue of the fence they were signaled on reaches the value.
+class IRetireFence
+{
+  public:
+    virtual bool Signal(uint64_t* value) = 0;
+    virtual uint64_t CompletedValue() = 0;
+
+    virtual ~IRetireFence() {}
+};
+
+struct FeatureStandbyKey
+{
+    std::string backend;
+    UINT handleId = 0;
+    int featureFlags = 0;
+    unsigned int renderWidth = 0;
+    unsigned int renderHeight = 0;
+    unsigned int displayWidth = 0;
+    unsigned int displayHeight = 0;
+
+    bool operator==(const FeatureStandbyKey& other) const = default;
+
+    // Rough size of an upscaler's internal resources, only used for the standby budget
+    size_t EstimatedBytes() const
+    {
+        return (size_t) renderWidth * renderHeight * 48 + (size_t) displayWidth * displayHeight * 32;
+    }
+};
+
+// Replaces the fixed sleep before releasing a feature on backend change.
+// Retired features go to a graveyard and are released once a fence shows the GPU
+// is done with their last Evaluate, or after a number of presents without a fence.
+// Optionally the last few inited features are kept in standby so switching back
+// to them doesn't need a new create/init.
+template <typename TFeature> class FeatureLifecycle
+{
+  public:
+    // Presents to wait before releasing when there is no fence to check
+    static constexpr uint32_t FramesWithoutFence = 8;
+
+    // Upper limit in case the fence was replaced or never completes
+    static constexpr uint32_t MaxFramesInGraveyard = 240;
+
+  private:
+    struct RetiredFeature
+    {
+        std::unique_ptr<TFeature> feature;
+        IRetireFence* fence = nullptr; // Kept alive by the owner while UsesFence returns true
+        uint64_t fenceValue = 0;       // 0 until the next present signals the fence
+        uint32_t presents = 0;
+    };
+
+    struct StandbyFeature
+    {
+        FeatureStandbyKey key;
+        std::unique_ptr<TFeature> feature;
+        size_t estimatedBytes = 0;
+    };
+
+    std::deque<RetiredFeature> _graveyard;
+    std::deque<StandbyFeature> _standby; // Most recently parked at the back
+
+    size_t _standbyBytes = 0;
+    uint64_t _releasedCount = 0;
+
+    mutable std::mutex _mutex;
+
+    void RetireLocked(std::unique_ptr<TFeature> feature)
+    {
+        if (feature == nullptr)
+            return;
+
+        RetiredFeature retired {};
+        retired.feature = std::move(feature);
+        _graveyard.push_back(std::move(retired));
+    }
+
+    void EvictStandbyLocked(size_t maxCount, size_t budgetBytes)
+    {
+        while (!_standby.empty() && (_standby.size() > maxCount || _standbyBytes > budgetBytes))
+        {
+            auto& oldest = _standby.front();
+            LOG_DEBUG("Evicting {} from standby", oldest.key.backend);
+
+            _standbyBytes -= oldest.estimatedBytes;
+            RetireLocked(std::move(oldest.feature));
+            _standby.pop_front();
+        }
+    }
+
+  public:
+    void Retire(std::unique_ptr<TFeature> feature)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        RetireLocked(std::move(feature));
+    }
+
+    // Keeps an inited feature for a later switch back, retires it when standby is disabled or over budget
+    void Park(const FeatureStandbyKey& key, std::unique_ptr<TFeature> feature, size_t estimatedBytes, size_t maxCount,
+              size_t budgetBytes)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (maxCount == 0 || estimatedBytes > budgetBytes)
+        {
+            RetireLocked(std::move(feature));
+            return;
+        }
+
+        // Only one feature per key, the older one can go
+        for (auto it = _standby.begin(); it != _standby.end(); it++)
+        {
+            if (it->key == key)
+            {
+                _standbyBytes -= it->estimatedBytes;
+                RetireLocked(std::move(it->feature));
+                _standby.erase(it);
+                break;
+            }
+        }
+
+        StandbyFeature standby {};
+        standby.key = key;
+        standby.feature = std::move(feature);
+        standby.estimatedBytes = estimatedBytes;
+
+        _standbyBytes += estimatedBytes;
+        _standby.push_back(std::move(standby));
+
+        EvictStandbyLocked(maxCount, budgetBytes);
+    }
+
+    std::unique_ptr<TFeature> TakeStandby(const FeatureStandbyKey& key)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (auto it = _standby.begin(); it != _standby.end(); it++)
+        {
+            if (it->key == key)
+            {
+                auto feature = std::move(it->feature);
+                _standbyBytes -= it->estimatedBytes;
+                _standby.erase(it);
+                return feature;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Moves standby features of a handle to the graveyard, for ReleaseFeature
+    void RetireStandby(UINT handleId)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (auto it = _standby.begin(); it != _standby.end();)
+        {
+            if (it->key.handleId == handleId)
+            {
+                _standbyBytes -= it->estimatedBytes;
+                RetireLocked(std::move(it->feature));
+                it = _standby.erase(it);
+            }
+            else
+            {
+                it++;
+            }
+        }
+    }
+
+    void RetireAllStandby()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        EvictStandbyLocked(0, 0);
+    }
+
+    // Called once per present with the fence of the queue that last executed the features,
+    // can be null when the API has none available
+    void OnPresent(IRetireFence* fence)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_graveyard.empty())
+            return;
+
+        bool needsSignal = false;
+        for (auto& retired : _graveyard)
+        {
+            retired.presents++;
+
+            if (retired.fenceValue == 0)
+                needsSignal = true;
+        }
+
+        uint64_t signaled = 0;
+        if (needsSignal && fence != nullptr && fence->Signal(&signaled))
+        {
+            for (auto& retired : _graveyard)
+            {
+                if (retired.fenceValue == 0)
+                {
+                    retired.fence = fence;
+                    retired.fenceValue = signaled;
+                }
+            }
+        }
+
+        while (!_graveyard.empty())
+        {
+            auto& oldest = _graveyard.front();
+
+            bool done = oldest.fenceValue != 0 ? oldest.fence->CompletedValue() >= oldest.fenceValue
+                                               : oldest.presents >= FramesWithoutFence;
+
+            if (!done && oldest.presents >= MaxFramesInGraveyard)
+            {
+                LOG_WARN("Fence didn't complete in {} presents, releasing anyway", oldest.presents);
+                done = true;
+            }
+
+            // Graveyard is in retire order, a newer feature can't finish before an older one
+            if (!done)
+                break;
+
+            oldest.feature.reset();
+            _graveyard.pop_front();
+            _releasedCount++;
+        }
+    }
+
+    // True while retired features wait for the fence, it and its queue have to be kept until then
+    bool UsesFence(const IRetireFence* fence) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (const auto& retired : _graveyard)
+        {
+            if (retired.fence == fence)
+                return true;
+        }
+
+        return false;
+    }
+
+    size_t GraveyardSize() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _graveyard.size();
+    }
+
+    size_t StandbySize() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _standby.size();
+    }
+
+    size_t StandbyBytes() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _standbyBytes;
+    }
+
+    uint64_t ReleasedCount() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _releasedCount;
+    }
+};
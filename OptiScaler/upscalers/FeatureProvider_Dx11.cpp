@@ -3,6 +3,8 @@
 #include "Util.h"
 #include "Config.h"
 
+#include <misc/StartupScheduler.h>
+
 #include "NVNGX_Parameter.h"
 
 #include "upscalers/dlss/DLSSFeature_Dx11.h"
@@ -56,6 +58,8 @@ bool FeatureProvider_Dx11::GetFeature(std::string upscalerName, UINT handleId, N
             break;
         }
 
+        StartupScheduler::Instance().Wait(StartupSteps::DlssFiles);
+
         if (Config::Instance()->DLSSEnabled.value_or_default())
         {
             if (upscalerName == "dlss" && State::Instance().NVNGX_DLSS_Path.has_value())
@@ -135,10 +139,8 @@ bool FeatureProvider_Dx11::ChangeFeature(std::string upscalerName, ID3D11Device*
             contextData->createParams->Set(NVSDK_NGX_Parameter_OutHeight, dc->DisplayHeight());
             contextData->createParams->Set(NVSDK_NGX_Parameter_PerfQualityValue, dc->PerfQualityValue());
 
-            LOG_TRACE("sleeping before reset of current feature for 1000ms");
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-
-            contextData->feature.reset();
+            // GPU might still be using the old feature, it's released after a few presents
+            _lifecycle.Retire(std::move(contextData->feature));
             contextData->feature = nullptr;
 
             State::Instance().currentFeature = nullptr;
@@ -228,3 +230,5 @@ bool FeatureProvider_Dx11::ChangeFeature(std::string upscalerName, ID3D11Device*
 
     return true;
 }
+
+void FeatureProvider_Dx11::OnPresent() { _lifecycle.OnPresent(nullptr); }
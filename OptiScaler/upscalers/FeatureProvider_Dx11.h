@@ -3,6 +3,7 @@
 #include <pch.h>
 
 #include "IFeature_Dx11.h"
+#include "FeatureLifecycle.h"
 
 #include <inputs/NVNGX_DLSS.h>
 
@@ -14,4 +15,10 @@ class FeatureProvider_Dx11
 
     static bool ChangeFeature(std::string upscalerName, ID3D11Device* device, ID3D11DeviceContext* cmdList,
                               UINT handleId, NVSDK_NGX_Parameter* parameters, ContextData<IFeature_Dx11>* contextData);
+
+    // Retired features are released after a few presents, called once per present
+    static void OnPresent();
+
+  private:
+    inline static FeatureLifecycle<IFeature_Dx11> _lifecycle;
 };
@@ -3,6 +3,8 @@
 #include "Util.h"
 #include "Config.h"
 
+#include <misc/StartupScheduler.h>
+
 #include "NVNGX_Parameter.h"
 
 #include "upscalers/dlss/DLSSFeature_Dx12.h"
@@ -13,6 +15,24 @@
 #include "upscalers/xess/XeSSFeature_Dx12.h"
 #include "FeatureProvider_Dx11.h"
 
+static FeatureStandbyKey StandbyKey(std::string backend, UINT handleId, NVSDK_NGX_Parameter* parameters)
+{
+    FeatureStandbyKey key {};
+    key.backend = backend;
+    key.handleId = handleId;
+
+    if (parameters != nullptr)
+    {
+        parameters->Get(NVSDK_NGX_Parameter_DLSS_Feature_Create_Flags, &key.featureFlags);
+        parameters->Get(NVSDK_NGX_Parameter_Width, &key.renderWidth);
+        parameters->Get(NVSDK_NGX_Parameter_Height, &key.renderHeight);
+        parameters->Get(NVSDK_NGX_Parameter_OutWidth, &key.displayWidth);
+        parameters->Get(NVSDK_NGX_Parameter_OutHeight, &key.displayHeight);
+    }
+
+    return key;
+}
+
 bool FeatureProvider_Dx12::GetFeature(std::string upscalerName, UINT handleId, NVSDK_NGX_Parameter* parameters,
                                       std::unique_ptr<IFeature_Dx12>* feature)
 {
@@ -41,6 +61,8 @@ bool FeatureProvider_Dx12::GetFeature(std::string upscalerName, UINT handleId, N
             break;
         }
 
+        StartupScheduler::Instance().Wait(StartupSteps::DlssFiles);
+
         if (Config::Instance()->DLSSEnabled.value_or_default())
         {
             if (upscalerName == "dlss" && State::Instance().NVNGX_DLSS_Path.has_value())
@@ -133,20 +155,26 @@ bool FeatureProvider_Dx12::ChangeFeature(std::string upscalerName, ID3D12Device*
             contextData->createParams->Set(NVSDK_NGX_Parameter_OutHeight, dc->DisplayHeight());
             contextData->createParams->Set(NVSDK_NGX_Parameter_PerfQualityValue, dc->PerfQualityValue());
 
-            dc = nullptr;
-
-            if (State::Instance().gameQuirks & GameQuirk::FastFeatureReset)
+            // GPU might still be using the old feature, it's released after a fence shows its last Evaluate is done
+            if (dc->IsInited())
             {
-                LOG_DEBUG("sleeping before reset of current feature for 100ms (Fast Feature Reset)");
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                // Config keeps dlss for DLSSD too
+                auto backend = dc->Name() == "DLSSD" ? "dlssd" : Config::Instance()->Dx12Upscaler.value_or_default();
+                auto key = StandbyKey(backend, handleId, contextData->createParams);
+
+                // Menu can set values the schema didn't clamp
+                auto standbyCount = std::max(Config::Instance()->UpscalerStandbyCount.value_or_default(), 0);
+                auto standbyBudget = std::max(Config::Instance()->UpscalerStandbyBudget.value_or_default(), 0);
+
+                _lifecycle.Park(key, std::move(contextData->feature), key.EstimatedBytes(), (size_t) standbyCount,
+                                (size_t) standbyBudget * 1024 * 1024);
             }
             else
             {
-                LOG_DEBUG("sleeping before reset of current feature for 1000ms");
-                std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+                _lifecycle.Retire(std::move(contextData->feature));
             }
 
-            contextData->feature.reset();
+            dc = nullptr;
             contextData->feature = nullptr;
 
             State::Instance().currentFeature = nullptr;
@@ -177,6 +205,17 @@ bool FeatureProvider_Dx12::ChangeFeature(std::string upscalerName, ID3D12Device*
 
         contextData->feature.reset();
 
+        auto key = StandbyKey(State::Instance().newBackend, handleId, contextData->createParams);
+
+        if (auto standby = _lifecycle.TakeStandby(key); standby != nullptr)
+        {
+            LOG_INFO("Using {} from standby", State::Instance().newBackend);
+            contextData->feature = std::move(standby);
+            Config::Instance()->Dx12Upscaler =
+                State::Instance().newBackend == "dlssd" ? "dlss" : State::Instance().newBackend;
+            return true;
+        }
+
         if (!GetFeature(State::Instance().newBackend, handleId, contextData->createParams, &contextData->feature))
         {
             LOG_ERROR("Upscaler can't created");
@@ -189,7 +228,9 @@ bool FeatureProvider_Dx12::ChangeFeature(std::string upscalerName, ID3D12Device*
     // init feature
     if (contextData->changeBackendCounter == 3)
     {
-        auto initResult = contextData->feature->Init(device, cmdList, contextData->createParams);
+        // Features from standby are already inited
+        auto initResult = contextData->feature->IsInited() ||
+                          contextData->feature->Init(device, cmdList, contextData->createParams);
 
         contextData->changeBackendCounter = 0;
 
@@ -237,3 +278,82 @@ bool FeatureProvider_Dx12::ChangeFeature(std::string upscalerName, ID3D12Device*
 
     return true;
 }
+
+void FeatureProvider_Dx12::OnEvaluate(ID3D12CommandList* cmdList)
+{
+    _evaluateList.store(cmdList, std::memory_order_relaxed);
+}
+
+void FeatureProvider_Dx12::OnExecute(ID3D12CommandQueue* queue, UINT numCommandLists,
+                                     ID3D12CommandList* const* ppCommandLists)
+{
+    auto list = _evaluateList.load(std::memory_order_relaxed);
+
+    if (list == nullptr)
+        return;
+
+    for (UINT i = 0; i < numCommandLists; i++)
+    {
+        if (ppCommandLists[i] == list)
+        {
+            SetEvaluateQueue(queue);
+            _evaluateList.compare_exchange_strong(list, nullptr, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+void FeatureProvider_Dx12::SetEvaluateQueue(ID3D12CommandQueue* queue)
+{
+    std::lock_guard<std::mutex> lock(_queueMutex);
+
+    if (queue == _evaluateQueue)
+        return;
+
+    // Game might release the queue while it's still needed for the next present
+    queue->AddRef();
+
+    if (_evaluateQueue != nullptr)
+        _evaluateQueue->Release();
+
+    _evaluateQueue = queue;
+}
+
+void FeatureProvider_Dx12::OnPresent(ID3D12CommandQueue* queue)
+{
+    std::lock_guard<std::mutex> lock(_queueMutex);
+
+    // Features are done on the queue that executed their last Evaluate, present queue until it's known
+    if (_evaluateQueue != nullptr)
+        queue = _evaluateQueue;
+
+    if (queue == nullptr)
+    {
+        _lifecycle.OnPresent(nullptr);
+        return;
+    }
+
+    // Values of different queues' fences can't be compared, each queue gets its own
+    auto& fence = _retireFences[queue];
+
+    if (fence == nullptr)
+    {
+        fence = std::make_unique<RetireFence_Dx12>();
+        fence->SetQueue(queue);
+    }
+
+    _lifecycle.OnPresent(fence.get());
+
+    // Fences hold a reference to their queue, drop the ones of old queues once nothing waits for them
+    for (auto it = _retireFences.begin(); it != _retireFences.end();)
+    {
+        if (it->first != queue && !_lifecycle.UsesFence(it->second.get()))
+            it = _retireFences.erase(it);
+        else
+            it++;
+    }
+}
+
+void FeatureProvider_Dx12::ReleaseStandby(UINT handleId) { _lifecycle.RetireStandby(handleId); }
+
+void FeatureProvider_Dx12::ReleaseAllStandby() { _lifecycle.RetireAllStandby(); }
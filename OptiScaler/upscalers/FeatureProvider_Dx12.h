@@ -3,9 +3,13 @@
 #include <pch.h>
 
 #include "IFeature_Dx12.h"
+#include "FeatureLifecycle.h"
+#include "RetireFence_Dx12.h"
 
 #include <inputs/NVNGX_DLSS.h>
 
+#include <ankerl/unordered_dense.h>
+
 class FeatureProvider_Dx12
 {
   public:
@@ -14,4 +18,26 @@ class FeatureProvider_Dx12
 
     static bool ChangeFeature(std::string upscalerName, ID3D12Device* device, ID3D12GraphicsCommandList* cmdList,
                               UINT handleId, NVSDK_NGX_Parameter* parameters, ContextData<IFeature_Dx12>* contextData);
+
+    // Command list of the last Evaluate, the queue executing it is used for the retire fence
+    static void OnEvaluate(ID3D12CommandList* cmdList);
+    static void OnExecute(ID3D12CommandQueue* queue, UINT numCommandLists, ID3D12CommandList* const* ppCommandLists);
+
+    // Releases retired features the GPU is done with, called once per present
+    static void OnPresent(ID3D12CommandQueue* queue);
+    static void ReleaseStandby(UINT handleId);
+    static void ReleaseAllStandby();
+
+  private:
+    inline static FeatureLifecycle<IFeature_Dx12> _lifecycle;
+    inline static std::atomic<ID3D12CommandList*> _evaluateList = nullptr;
+
+    // Queue and fences are referenced, guarded by _queueMutex
+    inline static std::mutex _queueMutex;
+    inline static ID3D12CommandQueue* _evaluateQueue = nullptr;
+
+    // Fence of the current queue and the ones retired features still wait for
+    inline static ankerl::unordered_dense::map<ID3D12CommandQueue*, std::unique_ptr<RetireFence_Dx12>> _retireFences;
+
+    static void SetEvaluateQueue(ID3D12CommandQueue* queue);
 };
@@ -3,6 +3,8 @@
 #include "Util.h"
 #include "Config.h"
 
+#include <misc/StartupScheduler.h>
+
 #include "NVNGX_Parameter.h"
 
 #include "upscalers/fsr2/FSR2Feature_Vk.h"
@@ -38,6 +40,8 @@ bool FeatureProvider_Vk::GetFeature(std::string upscalerName, UINT handleId, NVS
             break;
         }
 
+        StartupScheduler::Instance().Wait(StartupSteps::DlssFiles);
+
         if (Config::Instance()->DLSSEnabled.value_or_default())
         {
             if (upscalerName == "dlss" && State::Instance().NVNGX_DLSS_Path.has_value())
@@ -122,10 +126,8 @@ bool FeatureProvider_Vk::ChangeFeature(std::string upscalerName, VkInstance inst
 
             dc = nullptr;
 
-            LOG_DEBUG("sleeping before reset of current feature for 1000ms");
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-
-            contextData->feature.reset();
+            // GPU might still be using the old feature, it's released after a few presents
+            _lifecycle.Retire(std::move(contextData->feature));
             contextData->feature = nullptr;
 
             State::Instance().currentFeature = nullptr;
@@ -222,3 +224,5 @@ bool FeatureProvider_Vk::ChangeFeature(std::string upscalerName, VkInstance inst
 
     return true;
 }
+
+void FeatureProvider_Vk::OnPresent() { _lifecycle.OnPresent(nullptr); }
@@ -3,6 +3,7 @@
 #include <pch.h>
 
 #include "IFeature_Vk.h"
+#include "FeatureLifecycle.h"
 
 #include <inputs/NVNGX_DLSS.h>
 
@@ -15,4 +16,10 @@ class FeatureProvider_Vk
     static bool ChangeFeature(std::string upscalerName, VkInstance instance, VkPhysicalDevice pd, VkDevice device,
                               VkCommandBuffer cmdBuffer, PFN_vkGetInstanceProcAddr gipa, PFN_vkGetDeviceProcAddr gdpa,
                               UINT handleId, NVSDK_NGX_Parameter* parameters, ContextData<IFeature_Vk>* contextData);
+
+    // Retired features are released after a few presents, called once per present
+    static void OnPresent();
+
+  private:
+    inline static FeatureLifecycle<IFeature_Vk> _lifecycle;
 };
@@ -243,6 +243,39 @@ void IFeature::GetRenderResolution(NVSDK_NGX_Parameter* InParameters, unsigned i
     }
 }
 
+void IFeature::TrackJitter(NVSDK_NGX_Parameter* InParameters)
+{
+    float x = 0.0f;
+    float y = 0.0f;
+
+    if (InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_X, &x) != NVSDK_NGX_Result_Success ||
+        InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_Y, &y) != NVSDK_NGX_Result_Success)
+    {
+        return;
+    }
+
+    auto previous = _jitterTracker.Report();
+
+    if (_jitterTracker.Add(x, y, _renderWidth, _renderHeight, _displayWidth))
+        _jitterTracker.LogReport(Name(), previous);
+}
+
+void IFeature::GetJitterOffset(NVSDK_NGX_Parameter* InParameters, float* x, float* y) const
+{
+    if (InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_X, x) != NVSDK_NGX_Result_Success ||
+        InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_Y, y) != NVSDK_NGX_Result_Success)
+    {
+        return;
+    }
+
+    if (!Config::Instance()->JitterAutoCorrect.value_or_default())
+        return;
+
+    auto corrected = _jitterTracker.Correct(*x, *y);
+    *x = corrected.x;
+    *y = corrected.y;
+}
+
 float IFeature::GetSharpness(const NVSDK_NGX_Parameter* InParameters)
 {
     if (Config::Instance()->OverrideSharpness.value_or_default())
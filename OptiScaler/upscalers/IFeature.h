@@ -6,6 +6,7 @@
 
 #include <unordered_set>
 #include <Util.h>
+#include <misc/JitterAnalyzer.h>
 
 #define DLSS_MOD_ID_OFFSET 1000000
 
@@ -47,6 +48,7 @@ class IFeature
     };
 
     std::unordered_set<std::pair<float, float>, hashFunction> _jitterInfo;
+    JitterTracker _jitterTracker;
 
   protected:
     bool _initParameters = false;
@@ -89,6 +91,14 @@ class IFeature
     virtual std::string Name() const = 0;
 
     size_t JitterCount() { return _jitterInfo.size(); }
+    const JitterReport& JitterState() const { return _jitterTracker.Report(); }
+
+    // Records the jitter offsets of this frame
+    void TrackJitter(NVSDK_NGX_Parameter* InParameters);
+
+    // Jitter offsets for the backend, rescaled to render pixels when JitterAutoCorrect is enabled and the
+    // unit is known. The game's parameters are left as they are
+    void GetJitterOffset(NVSDK_NGX_Parameter* InParameters, float* x, float* y) const;
 
     void TickFrozenCheck();
     bool IsFrozen() const { return _featureFrozen; };
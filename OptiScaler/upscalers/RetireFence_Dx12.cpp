@@ -0,0 +1,80 @@
+#include "RetireFence_Dx12.h"
+
+void RetireFence_Dx12::SetQueue(ID3D12CommandQueue* queue)
+{
+    if (queue == _queue)
+        return;
+
+    // Values of the old fence can't be compared with a new one
+    if (_queue != nullptr)
+        Release();
+
+    _queue = queue;
+
+    if (_queue == nullptr)
+        return;
+
+    ID3D12Device* device = nullptr;
+    if (_queue->GetDevice(IID_PPV_ARGS(&device)) != S_OK || device == nullptr)
+    {
+        LOG_ERROR("Can't get device of the queue");
+        _queue = nullptr;
+        return;
+    }
+
+    auto result = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&_fence));
+    device->Release();
+
+    if (result != S_OK)
+    {
+        LOG_ERROR("CreateFence error: {:X}", (UINT) result);
+        _fence = nullptr;
+        _queue = nullptr;
+        return;
+    }
+
+    // Signaled at present, the queue has to stay alive as long as the fence is used
+    _queue->AddRef();
+}
+
+void RetireFence_Dx12::Release()
+{
+    if (_fence != nullptr)
+    {
+        _fence->Release();
+        _fence = nullptr;
+    }
+
+    if (_queue != nullptr)
+    {
+        _queue->Release();
+        _queue = nullptr;
+    }
+
+    _lastValue = 0;
+}
+
+bool RetireFence_Dx12::Signal(uint64_t* value)
+{
+    if (_fence == nullptr || _queue == nullptr)
+        return false;
+
+    auto result = _queue->Signal(_fence, _lastValue + 1);
+
+    if (result != S_OK)
+    {
+        LOG_WARN("Signal error: {:X}", (UINT) result);
+        return false;
+    }
+
+    *value = ++_lastValue;
+    return true;
+}
+
+uint64_t RetireFence_Dx12::CompletedValue()
+{
+    if (_fence == nullptr)
+        return 0;
+
+    return _fence->GetCompletedValue();
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <pch.h>
+
+#include "FeatureLifecycle.h"
+
+#include <d3d12.h>
+
+// Fence signaled on a game queue at present, everything submitted to the queue before is done when it completes
+class RetireFence_Dx12 : public IRetireFence
+{
+  private:
+    ID3D12Fence* _fence = nullptr;
+    ID3D12CommandQueue* _queue = nullptr;
+    uint64_t _lastValue = 0;
+
+  public:
+    // Fence is created on the queue's device the first time a queue is set
+    void SetQueue(ID3D12CommandQueue* queue);
+    void Release();
+
+    bool Signal(uint64_t* value) override;
+    uint64_t CompletedValue() override;
+
+    ~RetireFence_Dx12() override { Release(); }
+};
@@ -288,8 +288,7 @@ bool FSR2FeatureDx11::Evaluate(ID3D11DeviceContext* InContext, NVSDK_NGX_Paramet
     FfxFsr2DispatchDescription params {};
     params.commandList = InContext;
 
-    InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_X, &params.jitterOffset.x);
-    InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_Y, &params.jitterOffset.y);
+    GetJitterOffset(InParameters, &params.jitterOffset.x, &params.jitterOffset.y);
 
     unsigned int reset;
     InParameters->Get(NVSDK_NGX_Parameter_Reset, &reset);
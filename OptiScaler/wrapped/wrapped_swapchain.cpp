@@ -2,6 +2,7 @@
 
 #include <Util.h>
 #include <Config.h>
+#include <ConfigReload.h>
 
 #include <nvapi/fakenvapi.h>
 #include <hooks/Reflex_Hooks.h>
@@ -10,8 +11,11 @@
 #include <menu/menu_overlay_dx.h>
 
 #include <misc/FrameLimit.h>
+#include <misc/DynamicResolution.h>
 #include <upscaler_time/UpscalerTime_Dx11.h>
 #include <upscaler_time/UpscalerTime_Dx12.h>
+#include <upscalers/FeatureProvider_Dx11.h>
+#include <upscalers/FeatureProvider_Dx12.h>
 
 #include <d3d11.h>
 #include <d3d12.h>
@@ -180,6 +184,23 @@ static HRESULT LocalPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT
         }
     }
 
+    // Apply the ini changes made while running
+    if (willPresent)
+        ConfigReload::OnPresent();
+
+    // Frame time of the finished frame drives the dynamic resolution ratio
+    if (willPresent)
+        DynamicResolution::OnPresent();
+
+    // Release upscalers retired by a backend change
+    if (willPresent)
+    {
+        if (cq != nullptr)
+            FeatureProvider_Dx12::OnPresent(cq);
+        else if (device != nullptr)
+            FeatureProvider_Dx11::OnPresent();
+    }
+
     // Fallback when FGPresent is not hooked for V-sync
     if (willPresent && Config::Instance()->ForceVsync.has_value())
     {
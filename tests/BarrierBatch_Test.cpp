@@ -0,0 +1,141 @@
+#include "Test.h"
+
+#include <misc/BarrierBatch_Dx12.h>
+
+using Batch = BarrierBatch_Dx12;
+using Result = Batch::RecordResult;
+using Transition = Batch::PendingTransition;
+using Pending = std::vector<Transition>;
+
+// Only compared by address, never touched
+static ID3D12Resource* Fake(uintptr_t id) { return reinterpret_cast<ID3D12Resource*>(id * 0x100); }
+
+static bool Is(const Transition& transition, ID3D12Resource* resource, D3D12_RESOURCE_STATES before,
+               D3D12_RESOURCE_STATES after)
+{
+    return transition.resource == resource && transition.before == before && transition.after == after;
+}
+
+TEST_CASE(NoOpsAreDropped)
+{
+    Pending pending;
+
+    CHECK(Batch::Record(pending, { Fake(1), D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_COPY_SOURCE }) ==
+          Result::Dropped);
+    CHECK(Batch::Record(pending, { nullptr, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST }) ==
+          Result::Dropped);
+    CHECK(pending.empty());
+}
+
+TEST_CASE(ChainsAreMerged)
+{
+    Pending pending;
+    auto a = Fake(1);
+    auto b = Fake(2);
+
+    CHECK(Batch::Record(pending, { a, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_COPY_SOURCE }) ==
+          Result::Added);
+    CHECK(Batch::Record(pending, { b, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST }) ==
+          Result::Added);
+    CHECK(Batch::Record(pending, { a, D3D12_RESOURCE_STATE_COPY_SOURCE,
+                                   D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE }) == Result::Merged);
+
+    CHECK_EQ(pending.size(), 2u);
+    CHECK(Is(pending[0], a, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE));
+    CHECK(Is(pending[1], b, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST));
+}
+
+TEST_CASE(RoundTripCancels)
+{
+    Pending pending;
+    auto a = Fake(1);
+    auto b = Fake(2);
+
+    Batch::Record(pending, { b, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST });
+    Batch::Record(pending, { a, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_COPY_SOURCE });
+    Batch::Record(pending, { a, D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS });
+
+    // Back to where it started through the merged chain
+    CHECK(Batch::Record(pending, { a, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_RENDER_TARGET }) ==
+          Result::Cancelled);
+
+    CHECK_EQ(pending.size(), 1u);
+    CHECK(Is(pending[0], b, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST));
+
+    // Cancelled transition is gone, the next one starts a new entry
+    CHECK(Batch::Record(pending, { a, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_COPY_SOURCE }) ==
+          Result::Added);
+}
+
+// Caller thinks the resource is in another state than the pending transition leaves it in
+TEST_CASE(DisagreementKeepsBoth)
+{
+    Pending pending;
+    auto a = Fake(1);
+
+    Batch::Record(pending, { a, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_COPY_SOURCE });
+
+    CHECK(Batch::Record(pending, { a, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_RENDER_TARGET }) ==
+          Result::Added);
+
+    CHECK_EQ(pending.size(), 2u);
+    CHECK(Is(pending[0], a, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_COPY_SOURCE));
+    CHECK(Is(pending[1], a, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_RENDER_TARGET));
+
+    // Only the newest one is chained onto, an older entry isn't merged past the break
+    CHECK(Batch::Record(pending, { a, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_COPY_DEST }) ==
+          Result::Merged);
+    CHECK(Is(pending[1], a, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_DEST));
+
+    CHECK(Batch::Record(pending, { a, D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_COMMON }) ==
+          Result::Added);
+    CHECK_EQ(pending.size(), 3u);
+}
+
+TEST_CASE(ReadStateFold)
+{
+    // Combined read state already covers the read
+    CHECK_EQ(Batch::ReadState(D3D12_RESOURCE_STATE_GENERIC_READ, D3D12_RESOURCE_STATE_COPY_SOURCE),
+             D3D12_RESOURCE_STATE_GENERIC_READ);
+    CHECK_EQ(Batch::ReadState(D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE,
+                              D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE),
+             D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE);
+
+    // Partly covered or write states need the transition
+    CHECK_EQ(Batch::ReadState(D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE),
+             D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE);
+    CHECK_EQ(Batch::ReadState(D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_COPY_SOURCE),
+             D3D12_RESOURCE_STATE_COPY_SOURCE);
+    CHECK_EQ(Batch::ReadState(D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_SOURCE),
+             D3D12_RESOURCE_STATE_COPY_SOURCE);
+
+    // Common isn't a read bit, it's never folded
+    CHECK_EQ(Batch::ReadState(D3D12_RESOURCE_STATE_GENERIC_READ, D3D12_RESOURCE_STATE_COMMON),
+             D3D12_RESOURCE_STATE_COMMON);
+
+    // Transition to the folded state and the restore are both dropped
+    Pending pending;
+    auto a = Fake(1);
+    auto readState = Batch::ReadState(D3D12_RESOURCE_STATE_GENERIC_READ, D3D12_RESOURCE_STATE_COPY_SOURCE);
+
+    CHECK(Batch::Record(pending, { a, D3D12_RESOURCE_STATE_GENERIC_READ, readState }) == Result::Dropped);
+    CHECK(Batch::Record(pending, { a, readState, D3D12_RESOURCE_STATE_GENERIC_READ }) == Result::Dropped);
+    CHECK(pending.empty());
+}
+
+TEST_CASE(LegacyStateMapping)
+{
+    D3D12_BARRIER_SYNC sync;
+    D3D12_BARRIER_ACCESS access;
+    D3D12_BARRIER_LAYOUT layout;
+
+    CHECK(Batch::MapLegacyState(D3D12_RESOURCE_STATE_COPY_SOURCE, &sync, &access, &layout));
+    CHECK(sync == D3D12_BARRIER_SYNC_COPY && access == D3D12_BARRIER_ACCESS_COPY_SOURCE &&
+          layout == D3D12_BARRIER_LAYOUT_COPY_SOURCE);
+
+    CHECK(Batch::MapLegacyState(D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, &sync, &access, &layout));
+    CHECK(sync == D3D12_BARRIER_SYNC_NON_PIXEL_SHADING && layout == D3D12_BARRIER_LAYOUT_SHADER_RESOURCE);
+
+    // Combined states have no single layout
+    CHECK(!Batch::MapLegacyState(D3D12_RESOURCE_STATE_GENERIC_READ, &sync, &access, &layout));
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// Benchmarks run as tests with a short workload and only check their results, timings are printed.
+// OPTI_BENCH_SCALE multiplies the workload for a real measurement.
+inline unsigned BenchScale()
+{
+    static unsigned scale = []()
+    {
+        auto value = std::getenv("OPTI_BENCH_SCALE");
+        auto parsed = value != nullptr ? std::strtoul(value, nullptr, 10) : 0;
+        return parsed > 0 ? static_cast<unsigned>(parsed) : 1u;
+    }();
+
+    return scale;
+}
+
+class BenchTimer
+{
+    std::chrono::steady_clock::time_point _start = std::chrono::steady_clock::now();
+
+  public:
+    double Seconds() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+    }
+};
+
+inline void BenchReport(const char* name, double seconds, unsigned long long operations)
+{
+    std::printf("  %-40s %8.2f ms %8.2f ns/op\n", name, seconds * 1000.0,
+                operations > 0 ? seconds * 1e9 / operations : 0.0);
+}
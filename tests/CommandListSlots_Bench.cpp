@@ -0,0 +1,186 @@
+#include "Bench.h"
+#include "Test.h"
+
+#include <misc/CommandListSlots_Dx12.h>
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+// Per list state of a subsystem, what the hooks touch on each recorded call
+struct BenchState : CommandListSlotData
+{
+    uint64_t calls = 0;
+};
+
+// Shape of the maps the slots replaced, a global map keyed on the list behind one lock.
+// Entries of released lists are never removed.
+class LockedMap
+{
+    std::mutex _mutex;
+    std::unordered_map<ID3D12GraphicsCommandList*, BenchState> _map;
+
+  public:
+    void Record(ID3D12GraphicsCommandList* list)
+    {
+        std::scoped_lock lock(_mutex);
+        _map[list].calls++;
+    }
+
+    uint64_t Calls(ID3D12GraphicsCommandList* list)
+    {
+        std::scoped_lock lock(_mutex);
+        auto it = _map.find(list);
+        return it != _map.end() ? it->second.calls : 0;
+    }
+
+    size_t Size()
+    {
+        std::scoped_lock lock(_mutex);
+        return _map.size();
+    }
+};
+
+struct Workload
+{
+    unsigned threads;
+    unsigned frames;
+    unsigned listsPerThread;
+    unsigned callsPerList; // Recorded in runs like the game does, a list at a time
+
+    unsigned long long Operations() const
+    {
+        return 1ull * threads * frames * listsPerThread * callsPerList;
+    }
+};
+
+// Each thread records its own lists every frame. With churn the lists are released and
+// created again each frame, like games that pool allocators but not lists.
+template <typename Record, typename Check>
+static double Run(const Workload& workload, bool churn, Record record, Check check)
+{
+    BenchTimer timer;
+    std::vector<std::thread> threads;
+
+    for (unsigned t = 0; t < workload.threads; t++)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                std::vector<std::unique_ptr<ID3D12GraphicsCommandList>> lists(workload.listsPerThread);
+
+                for (auto& list : lists)
+                    list = std::make_unique<ID3D12GraphicsCommandList>();
+
+                for (unsigned frame = 0; frame < workload.frames; frame++)
+                {
+                    if (churn && frame > 0)
+                    {
+                        for (auto& list : lists)
+                            list = std::make_unique<ID3D12GraphicsCommandList>();
+                    }
+
+                    for (auto& list : lists)
+                    {
+                        for (unsigned call = 0; call < workload.callsPerList; call++)
+                            record(list.get());
+                    }
+
+                    check(lists, churn ? workload.callsPerList : (frame + 1ull) * workload.callsPerList);
+                }
+            });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    return timer.Seconds();
+}
+
+static void Compare(const char* name, const Workload& workload, bool churn)
+{
+    std::printf("%s, %u threads\n", name, workload.threads);
+
+    auto before = CommandListSlots_Dx12::LiveCount();
+    std::atomic<unsigned> slotErrors = 0;
+
+    auto slotsSeconds = Run(
+        workload, churn,
+        [](ID3D12GraphicsCommandList* list)
+        {
+            if (auto state = CommandListSlots_Dx12::Get<BenchState>(list, CommandListSlot::StateShadow))
+                state->calls++;
+        },
+        [&](auto& lists, uint64_t expected)
+        {
+            for (auto& list : lists)
+            {
+                auto state = CommandListSlots_Dx12::Find<BenchState>(list.get(), CommandListSlot::StateShadow);
+
+                if (state == nullptr || state->calls != expected)
+                    slotErrors++;
+            }
+        });
+
+    BenchReport("slots", slotsSeconds, workload.Operations());
+
+    CHECK_EQ(slotErrors.load(), 0u);
+
+    // Storage left with the lists
+    CHECK_EQ(CommandListSlots_Dx12::LiveCount(), before);
+
+    LockedMap map;
+    std::atomic<unsigned> mapErrors = 0;
+
+    auto mapSeconds = Run(
+        workload, churn, [&map](ID3D12GraphicsCommandList* list) { map.Record(list); },
+        [&](auto& lists, uint64_t expected)
+        {
+            // A released list's address can be reused by a new one, its stale count is picked up then
+            for (auto& list : lists)
+            {
+                if (map.Calls(list.get()) < expected)
+                    mapErrors++;
+            }
+        });
+
+    BenchReport("locked map", mapSeconds, workload.Operations());
+    std::printf("  locked map entries left: %zu\n", map.Size());
+
+    CHECK_EQ(mapErrors.load(), 0u);
+}
+
+TEST_CASE(SteadyLists)
+{
+    auto scale = BenchScale();
+
+    for (unsigned threads : { 1u, 4u, 8u })
+        Compare("Steady lists", { threads, 20 * scale, 32, 200 }, false);
+}
+
+TEST_CASE(ChurningLists)
+{
+    auto scale = BenchScale();
+
+    for (unsigned threads : { 1u, 4u, 8u })
+        Compare("Churning lists", { threads, 20 * scale, 32, 200 }, true);
+}
+
+TEST_CASE(IndexIsReused)
+{
+    uint32_t first = UINT32_MAX;
+
+    {
+        ID3D12GraphicsCommandList list;
+        CommandListSlots_Dx12::Get<BenchState>(&list, CommandListSlot::StateShadow);
+        first = CommandListSlots_Dx12::Index(&list);
+    }
+
+    ID3D12GraphicsCommandList list;
+
+    CHECK_EQ(CommandListSlots_Dx12::Index(&list), UINT32_MAX);
+
+    CommandListSlots_Dx12::Get<BenchState>(&list, CommandListSlot::StateShadow);
+    CHECK_EQ(CommandListSlots_Dx12::Index(&list), first);
+}
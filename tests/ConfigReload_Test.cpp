@@ -0,0 +1,155 @@
+#include "Test.h"
+
+#include <ConfigReload.h>
+
+static const ConfigChange* FindChange(const ConfigChangeSet& changeSet, std::string_view key)
+{
+    for (const auto& change : changeSet.changes)
+    {
+        if (key == change.key)
+            return &change;
+    }
+
+    return nullptr;
+}
+
+TEST_CASE(SameIniHasNoChanges)
+{
+    const char* ini = "[Sharpness]\nSharpness=0.5\n[Upscalers]\nDx12Upscaler=fsr31\n";
+
+    auto changeSet = ConfigReload::Diff(ini, ini);
+
+    CHECK(changeSet.empty());
+    CHECK_EQ(changeSet.actions, (uint32_t) ConfigReload_None);
+}
+
+TEST_CASE(FormattingOnlyEditsAreIgnored)
+{
+    auto changeSet = ConfigReload::Diff("[Spoofing]\nSpoofedVendorId=0x10DE\n[FrameGen]\nEnabled=true\n",
+                                        "[Spoofing]\nSpoofedVendorId=0x10de\n[FrameGen]\nEnabled=TRUE\n");
+
+    CHECK(changeSet.empty());
+}
+
+TEST_CASE(MissingKeyIsAuto)
+{
+    auto changeSet = ConfigReload::Diff("[Sharpness]\n", "[Sharpness]\nSharpness=auto\n");
+
+    CHECK(changeSet.empty());
+}
+
+TEST_CASE(LiveChange)
+{
+    auto changeSet = ConfigReload::Diff("[Sharpness]\nSharpness=0.3\n", "[Sharpness]\nSharpness=0.5\n");
+
+    CHECK_EQ(changeSet.changes.size(), 1u);
+    CHECK_EQ(changeSet.actions, (uint32_t) ConfigReload_Constants);
+
+    auto change = FindChange(changeSet, "Sharpness");
+    CHECK(change != nullptr && change->option != nullptr && change->newValue.has_value());
+}
+
+TEST_CASE(ScopesAddTheirActions)
+{
+    auto changeSet = ConfigReload::Diff("[Upscalers]\nDx12Upscaler=xess\n[FSRFG]\nAllowAsync=false\n"
+                                        "[FrameGen]\nFGInput=nofg\n",
+                                        "[Upscalers]\nDx12Upscaler=fsr31\n[FSRFG]\nAllowAsync=true\n"
+                                        "[FrameGen]\nFGInput=fsrfg\n");
+
+    CHECK_EQ(changeSet.changes.size(), 3u);
+    CHECK(changeSet.actions & ConfigReload_Upscaler);
+    CHECK(changeSet.actions & ConfigReload_FrameGen);
+    CHECK(changeSet.actions & ConfigReload_Swapchain);
+    CHECK(changeSet.actions & ConfigReload_Restart);
+
+    // Parsed by Config, not the schema
+    auto fgInput = FindChange(changeSet, "FGInput");
+    CHECK(fgInput != nullptr && fgInput->option == nullptr && fgInput->scope == ConfigScope::Restart);
+}
+
+TEST_CASE(MergeDropsRevertedChanges)
+{
+    auto pending = ConfigReload::Diff("[Sharpness]\nSharpness=0.3\n[Upscalers]\nDx12Upscaler=xess\n",
+                                      "[Sharpness]\nSharpness=0.5\n[Upscalers]\nDx12Upscaler=fsr31\n");
+
+    auto newer = ConfigReload::Diff("[Sharpness]\nSharpness=0.5\n[Upscalers]\nDx12Upscaler=fsr31\n",
+                                    "[Sharpness]\nSharpness=0.5\n[Upscalers]\nDx12Upscaler=xess\n");
+
+    ConfigReload::Merge(pending, newer);
+
+    CHECK_EQ(pending.changes.size(), 1u);
+    CHECK(FindChange(pending, "Sharpness") != nullptr);
+    CHECK_EQ(pending.actions, (uint32_t) ConfigReload_Constants);
+}
+
+TEST_CASE(MergeKeepsOldestValue)
+{
+    auto pending = ConfigReload::Diff("[Sharpness]\nSharpness=0.3\n", "[Sharpness]\nSharpness=0.5\n");
+    auto newer = ConfigReload::Diff("[Sharpness]\nSharpness=0.5\n", "[Sharpness]\nSharpness=0.7\n");
+
+    ConfigReload::Merge(pending, newer);
+
+    auto change = FindChange(pending, "Sharpness");
+    CHECK(change != nullptr);
+
+    if (change != nullptr)
+    {
+        CHECK(change->oldValue == ConfigSchema::Normalize(*change->option, "0.3"));
+        CHECK(change->newValue == ConfigSchema::Normalize(*change->option, "0.7"));
+    }
+}
+
+TEST_CASE(ApplyOnlyReportsRealChanges)
+{
+    Config config;
+    config.Sharpness = 0.5f;
+
+    // Re-saving the current value
+    auto same = ConfigReload::Diff("[Sharpness]\nSharpness=0.3\n", "[Sharpness]\nSharpness=0.5\n");
+    CHECK_EQ(ConfigReload::Apply(&config, same), (uint32_t) ConfigReload_None);
+
+    auto changed = ConfigReload::Diff("[Sharpness]\nSharpness=0.5\n", "[Sharpness]\nSharpness=0.8\n");
+    CHECK_EQ(ConfigReload::Apply(&config, changed), (uint32_t) ConfigReload_Constants);
+    CHECK_EQ(config.Sharpness.value_or_default(), 0.8f);
+}
+
+// Same as Config::Reload, PQ wins over sRGB and either one turns on the non-linear color space
+TEST_CASE(ApplyKeepsOneNonLinearInput)
+{
+    Config config;
+
+    auto srgb = ConfigReload::Diff("[FSR]\n", "[FSR]\nFsrNonLinearSRGB=true\n");
+    CHECK_EQ(ConfigReload::Apply(&config, srgb), (uint32_t) ConfigReload_Upscaler);
+    CHECK(config.FsrNonLinearSRGB.value_or_default());
+    CHECK(config.FsrNonLinearColorSpace.value_or_default());
+
+    // Only set for the session, not saved to the ini
+    CHECK(!config.FsrNonLinearColorSpace.value_for_config().has_value());
+
+    auto pq = ConfigReload::Diff("[FSR]\nFsrNonLinearSRGB=true\n",
+                                 "[FSR]\nFsrNonLinearSRGB=true\nFsrNonLinearPQ=true\n");
+    ConfigReload::Apply(&config, pq);
+    CHECK(config.FsrNonLinearPQ.value_or_default());
+    CHECK(!config.FsrNonLinearSRGB.value_or_default());
+    CHECK(config.FsrNonLinearColorSpace.value_or_default());
+
+    // Disabled inputs leave the color space alone
+    Config other;
+    auto disabled = ConfigReload::Diff("[FSR]\n", "[FSR]\nFsrNonLinearPQ=false\n");
+    ConfigReload::Apply(&other, disabled);
+    CHECK(!other.FsrNonLinearColorSpace.value_or_default());
+}
+
+TEST_CASE(OtherApiUpscalerNeedsNoRecreate)
+{
+    Config config;
+    State::Instance().api = DX12;
+
+    auto other = ConfigReload::Diff("[Upscalers]\n", "[Upscalers]\nVulkanUpscaler=fsr31\n");
+    CHECK_EQ(ConfigReload::Apply(&config, other), (uint32_t) ConfigReload_None);
+
+    auto current = ConfigReload::Diff("[Upscalers]\n", "[Upscalers]\nDx12Upscaler=fsr31\n");
+    CHECK_EQ(ConfigReload::Apply(&config, current), (uint32_t) ConfigReload_Upscaler);
+
+    State::Instance().api = NotSelected;
+}
@@ -0,0 +1,225 @@
+#include "Test.h"
+
+#include <ConfigSchema.h>
+
+#include <SimpleIni.h>
+
+#include <map>
+
+typedef std::map<std::string, std::string> IniMap;
+
+static ConfigSchema::ReadFunction Reader(const IniMap& ini)
+{
+    return [&ini](const char* section, const char* key) -> std::optional<std::string>
+    {
+        auto it = ini.find(std::string(section) + "." + key);
+
+        if (it == ini.end() || _stricmp(it->second.c_str(), "auto") == 0)
+            return std::nullopt;
+
+        return it->second;
+    };
+}
+
+static ConfigSchema::WriteFunction Writer(IniMap& ini)
+{
+    return [&ini](const char* section, const char* key, const std::string& value)
+    { ini[std::string(section) + "." + key] = value; };
+}
+
+TEST_CASE(ParseIntMatchesStoi)
+{
+    CHECK_EQ(ConfigSchema::ParseInt("42"), 42);
+    CHECK_EQ(ConfigSchema::ParseInt("-42"), -42);
+    CHECK_EQ(ConfigSchema::ParseInt("+42"), 42);
+    CHECK_EQ(ConfigSchema::ParseInt(" 7"), 7);
+    CHECK_EQ(ConfigSchema::ParseInt("0x1F"), 31);
+    CHECK_EQ(ConfigSchema::ParseInt("0X10"), 16);
+    CHECK_EQ(ConfigSchema::ParseInt("-2147483648"), INT32_MIN);
+
+    CHECK(!ConfigSchema::ParseInt("7 ").has_value());
+    CHECK(!ConfigSchema::ParseInt("-0x10").has_value());
+    CHECK(!ConfigSchema::ParseInt("0x-5").has_value());
+    CHECK(!ConfigSchema::ParseInt("0x").has_value());
+    CHECK(!ConfigSchema::ParseInt("2147483648").has_value());
+    CHECK(!ConfigSchema::ParseInt("0xFFFFFFFF").has_value());
+    CHECK(!ConfigSchema::ParseInt("+-1").has_value());
+    CHECK(!ConfigSchema::ParseInt("1.5").has_value());
+    CHECK(!ConfigSchema::ParseInt("").has_value());
+}
+
+TEST_CASE(ParseUIntWrapsLikeStoi)
+{
+    CHECK_EQ(ConfigSchema::ParseUInt("0x10de"), 0x10deu);
+    CHECK_EQ(ConfigSchema::ParseUInt("-1"), 0xFFFFFFFFu);
+    CHECK(!ConfigSchema::ParseUInt("0xFFFFFFFF").has_value());
+}
+
+TEST_CASE(ParseFloatMatchesStream)
+{
+    CHECK_EQ(ConfigSchema::ParseFloat("1.5"), 1.5f);
+    CHECK_EQ(ConfigSchema::ParseFloat("+1.5"), 1.5f);
+    CHECK_EQ(ConfigSchema::ParseFloat("-.5"), -0.5f);
+    CHECK_EQ(ConfigSchema::ParseFloat("5."), 5.0f);
+    CHECK_EQ(ConfigSchema::ParseFloat("1e3"), 1000.0f);
+    CHECK_EQ(ConfigSchema::ParseFloat(" 2"), 2.0f);
+
+    CHECK(!ConfigSchema::ParseFloat("2 ").has_value());
+    CHECK(!ConfigSchema::ParseFloat("inf").has_value());
+    CHECK(!ConfigSchema::ParseFloat("nan").has_value());
+    CHECK(!ConfigSchema::ParseFloat("1e").has_value());
+    CHECK(!ConfigSchema::ParseFloat("1.5f").has_value());
+    CHECK(!ConfigSchema::ParseFloat("+-1").has_value());
+    CHECK(!ConfigSchema::ParseFloat("1e50").has_value());
+}
+
+TEST_CASE(ParseBoolIgnoresCase)
+{
+    CHECK_EQ(ConfigSchema::ParseBool("TRUE"), true);
+    CHECK_EQ(ConfigSchema::ParseBool("False"), false);
+    CHECK(!ConfigSchema::ParseBool("1").has_value());
+}
+
+TEST_CASE(RoundTrip)
+{
+    IniMap ini = {
+        { "Upscalers.Dx12Upscaler", "FSR31" },
+        { "Upscalers.StandbyCount", "-3" },
+        { "FrameGen.Enabled", "TRUE" },
+        { "Spoofing.SpoofedGPUName", "Custom GPU Name" },
+        { "Spoofing.SpoofedVendorId", "0x1002" },
+        { "Sharpness.Sharpness", "0.5" },
+        { "V-Sync.SyncInterval", "7" },
+    };
+
+    Config first;
+    ConfigSchema::Load(&first, Reader(ini));
+
+    // Only flagged options are lowercased
+    CHECK(first.Dx12Upscaler.value_or_default() == "fsr31");
+    CHECK(first.SpoofedGPUName.value_or_default() == L"Custom GPU Name");
+
+    CHECK_EQ(first.UpscalerStandbyCount.value_or_default(), 0);
+    CHECK_EQ(first.FGEnabled.value_or_default(), true);
+    CHECK_EQ(first.SpoofedVendorId.value_or_default(), 0x1002u);
+    CHECK(!first.VsyncInterval.has_value());
+
+    IniMap saved;
+    ConfigSchema::Save(&first, Writer(saved));
+
+    CHECK(saved["Spoofing.SpoofedVendorId"] == "0x1002");
+    CHECK(saved["Upscalers.StandbyCount"] == "auto");
+    CHECK(saved["V-Sync.SyncInterval"] == "auto");
+
+    Config second;
+    ConfigSchema::Load(&second, Reader(saved));
+
+    IniMap resaved;
+    ConfigSchema::Save(&second, Writer(resaved));
+
+    CHECK(saved == resaved);
+
+    for (const auto& option : ConfigSchema::Options())
+        CHECK(ConfigSchema::CurrentValue(&first, option) == ConfigSchema::CurrentValue(&second, option));
+}
+
+// Every option set to a value other than its default, saved to ini text and loaded back
+TEST_CASE(EveryOptionRoundTrips)
+{
+    static const char* Candidates[] = { "true", "false", "2", "1", "3", "0", "0.5", "custom" };
+
+    Config defaults;
+    Config first;
+    std::map<const ConfigOption*, std::string> expected;
+
+    for (const auto& option : ConfigSchema::Options())
+    {
+        if (option.flags & ConfigOption_NotSaved)
+            continue;
+
+        auto current = ConfigSchema::CurrentValue(&defaults, option);
+
+        for (auto candidate : Candidates)
+        {
+            auto value = ConfigSchema::Normalize(option, candidate);
+
+            if (!value.has_value() || value == current)
+                continue;
+
+            ConfigSchema::Apply(&first, option, value);
+            expected[&option] = ConfigSchema::CurrentValue(&first, option);
+            break;
+        }
+
+        if (!expected.contains(&option))
+            std::printf("  no candidate for %s.%s\n", option.section, option.key);
+
+        CHECK(expected.contains(&option));
+    }
+
+    CSimpleIniA saved;
+    ConfigSchema::Save(&first, [&saved](const char* section, const char* key, const std::string& value)
+                       { saved.SetValue(section, key, value.c_str()); });
+
+    std::string text;
+    CHECK(saved.Save(text) == SI_OK);
+
+    CSimpleIniA loaded;
+    CHECK(loaded.LoadData(text.data(), text.size()) == SI_OK);
+
+    Config second;
+    ConfigSchema::Load(&second,
+                       [&loaded](const char* section, const char* key) -> std::optional<std::string>
+                       {
+                           auto value = loaded.GetValue(section, key, "auto");
+
+                           if (_stricmp(value, "auto") == 0)
+                               return std::nullopt;
+
+                           return value;
+                       });
+
+    for (const auto& option : ConfigSchema::Options())
+    {
+        auto value = ConfigSchema::CurrentValue(&second, option);
+        auto it = expected.find(&option);
+        auto ok = it == expected.end() ? value == ConfigSchema::CurrentValue(&defaults, option) : value == it->second;
+
+        if (!ok)
+            std::printf("  %s.%s reloaded as %s\n", option.section, option.key, value.c_str());
+
+        CHECK(ok);
+    }
+}
+
+TEST_CASE(ChangedSinceLoad)
+{
+    IniMap ini = { { "Upscalers.Dx12Upscaler", "xess" } };
+
+    Config config;
+    ConfigSchema::Load(&config, Reader(ini));
+
+    CHECK(ConfigSchema::ChangedSinceLoad(&config, ConfigScope::Reinit).empty());
+
+    config.Dx12Upscaler = "fsr31";
+
+    auto changed = ConfigSchema::ChangedSinceLoad(&config, ConfigScope::Reinit);
+    CHECK_EQ(changed.size(), 1u);
+    CHECK(!changed.empty() && std::string_view(changed[0]->key) == "Dx12Upscaler");
+
+    CHECK(ConfigSchema::ChangedSinceLoad(&config, ConfigScope::Live).empty());
+}
+
+TEST_CASE(Normalize)
+{
+    auto standby = ConfigSchema::Find("Upscalers", "StandbyCount");
+    CHECK(standby != nullptr);
+
+    if (standby == nullptr)
+        return;
+
+    CHECK(!ConfigSchema::Normalize(*standby, "AUTO").has_value());
+    CHECK(ConfigSchema::Normalize(*standby, "-3") == "0");
+    CHECK(ConfigSchema::Normalize(*standby, "0x2") == "2");
+    CHECK(!ConfigSchema::Normalize(*standby, "two").has_value());
+}
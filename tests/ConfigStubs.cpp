@@ -0,0 +1,13 @@
+// Config.cpp isn't linked into the config tests, these are the parts they reach
+
+#include <Config.h>
+
+Config::Config() {}
+
+Config* Config::Instance()
+{
+    if (!_config)
+        _config = new Config();
+
+    return _config;
+}
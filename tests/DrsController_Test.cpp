@@ -0,0 +1,234 @@
+#include "Test.h"
+
+#include <misc/DrsController.h>
+
+#include <cmath>
+#include <deque>
+
+// GPU cost of a frame, fixed + scalable * render pixels relative to display, limited by the CPU
+struct CostModel
+{
+    double fixedMs = 2.0;
+    double scalableMs = 20.0;
+    double cpuMs = 0.0;
+    double noise = 0.02; // Relative, deterministic
+
+    double FrameMs(float ratio, uint32_t frame) const
+    {
+        auto pixels = 1.0 / (static_cast<double>(ratio) * ratio);
+        auto gpu = fixedMs + scalableMs * pixels;
+        auto wobble = 1.0 + noise * std::sin(frame * 1.7);
+
+        return std::max(gpu, cpuMs) * wobble;
+    }
+};
+
+struct Simulation
+{
+    DrsController controller;
+    CostModel model;
+
+    // Frames the game takes to render at a new ratio
+    uint32_t lag = 0;
+
+    uint32_t frame = 0;
+    uint32_t changes = 0;
+    float largestStep = 0.0f;
+    double lastFrameMs = 0.0;
+
+    std::deque<float> pending;
+
+    Simulation(const DrsControllerSettings& settings, float initialRatio) : controller(settings, initialRatio) {}
+
+    void Run(uint32_t frames)
+    {
+        for (uint32_t i = 0; i < frames; i++, frame++)
+        {
+            pending.push_back(controller.Ratio());
+
+            auto rendered = pending.front();
+
+            if (pending.size() > lag)
+                pending.pop_front();
+
+            lastFrameMs = model.FrameMs(rendered, frame);
+
+            auto before = controller.Ratio();
+            auto after = controller.Update(lastFrameMs, model.fixedMs, lastFrameMs, rendered);
+
+            if (after != before)
+            {
+                auto step = std::abs(after - before);
+                changes++;
+                largestStep = std::max(largestStep, step);
+            }
+        }
+    }
+};
+
+static DrsControllerSettings Settings(double targetMs = 16.667)
+{
+    DrsControllerSettings settings {};
+    settings.targetMs = targetMs;
+    settings.minRatio = 1.0f;
+    settings.maxRatio = 3.0f;
+
+    return settings;
+}
+
+static bool WithinTarget(const Simulation& simulation, double tolerance)
+{
+    auto target = simulation.controller.Settings().targetMs;
+    return std::abs(simulation.controller.AverageFrameTime() - target) <= target * tolerance;
+}
+
+// Largest step the rate limit allows after the credit cap
+static float MaxStep(const DrsControllerSettings& settings)
+{
+    return static_cast<float>(settings.maxRatePerSecond * DrsController::MaxRateCreditMs / 1000.0) + 1e-4f;
+}
+
+TEST_CASE(HeadroomIsSpentOnResolution)
+{
+    auto settings = Settings();
+    Simulation simulation(settings, 2.0f);
+
+    simulation.Run(3000);
+
+    // 2 + 20 / r^2 = 16.667 at r = 1.168
+    CHECK(simulation.controller.Ratio() < 1.3f);
+    CHECK(WithinTarget(simulation, 0.1));
+}
+
+TEST_CASE(OverBudgetLowersResolution)
+{
+    auto settings = Settings();
+    Simulation simulation(settings, 1.0f);
+    simulation.model.scalableMs = 40.0;
+
+    simulation.Run(3000);
+
+    // 2 + 40 / r^2 = 16.667 at r = 1.652
+    CHECK(simulation.controller.Ratio() > 1.5f);
+    CHECK(simulation.controller.Ratio() < 1.8f);
+    CHECK(WithinTarget(simulation, 0.1));
+}
+
+TEST_CASE(StepsAreRateLimited)
+{
+    auto settings = Settings();
+    Simulation simulation(settings, 1.0f);
+    simulation.model.scalableMs = 60.0;
+
+    simulation.Run(2000);
+
+    CHECK(simulation.changes > 0);
+    CHECK(simulation.largestStep <= MaxStep(settings));
+}
+
+TEST_CASE(SteadyStretchDoesNotJump)
+{
+    auto settings = Settings();
+    Simulation simulation(settings, 1.5f);
+
+    // Right on the target for a long while, the rate credit must not pile up
+    simulation.model.fixedMs = 2.0;
+    simulation.model.scalableMs = (settings.targetMs - 2.0) * 1.5 * 1.5;
+    simulation.model.noise = 0.0;
+    simulation.Run(1000);
+
+    CHECK_EQ(simulation.changes, 0u);
+
+    // Scene gets much heavier
+    simulation.model.scalableMs *= 3.0;
+    simulation.Run(500);
+
+    CHECK(simulation.changes > 0);
+    CHECK(simulation.largestStep <= MaxStep(settings));
+}
+
+TEST_CASE(CpuBoundDoesNotLowerResolution)
+{
+    auto settings = Settings();
+    Simulation simulation(settings, 1.5f);
+    simulation.model.cpuMs = 25.0;
+
+    simulation.Run(3000);
+
+    // Frame time doesn't follow the ratio, going lower only costs quality
+    CHECK(simulation.controller.Ratio() < 2.0f);
+}
+
+TEST_CASE(InsensitiveHeadroomStepsGradually)
+{
+    auto settings = Settings();
+    Simulation simulation(settings, 2.0f);
+
+    // CPU limited well under the target, GPU cost hidden behind it
+    simulation.model.cpuMs = 8.0;
+    simulation.model.scalableMs = 4.0;
+
+    // Until the ratio moved the model has no fit and follows the upscaler time estimate
+    simulation.Run(50);
+    simulation.largestStep = 0.0f;
+
+    simulation.Run(200);
+
+    // No jump straight to the limit, every move is a single minimum step
+    CHECK(simulation.changes > 0);
+    CHECK(simulation.controller.Ratio() > settings.minRatio);
+    CHECK(simulation.largestStep <= settings.minStep + 1e-4f);
+
+    simulation.Run(3000);
+
+    CHECK_EQ(simulation.controller.Ratio(), settings.minRatio);
+}
+
+TEST_CASE(RenderRatioLagIsFollowed)
+{
+    auto settings = Settings();
+    Simulation simulation(settings, 1.0f);
+    simulation.model.scalableMs = 40.0;
+    simulation.lag = 5;
+
+    simulation.Run(4000);
+
+    CHECK(simulation.controller.Ratio() > 1.5f);
+    CHECK(simulation.controller.Ratio() < 1.8f);
+    CHECK(WithinTarget(simulation, 0.1));
+}
+
+TEST_CASE(WorkloadChangeIsFollowed)
+{
+    auto settings = Settings();
+    Simulation simulation(settings, 1.5f);
+
+    simulation.Run(3000);
+    auto light = simulation.controller.Ratio();
+
+    simulation.model.scalableMs = 40.0;
+    simulation.Run(3000);
+
+    CHECK(simulation.controller.Ratio() > light + 0.3f);
+    CHECK(WithinTarget(simulation, 0.1));
+}
+
+TEST_CASE(RatioStaysInLimits)
+{
+    auto settings = Settings(5.0);
+    settings.maxRatio = 2.0f;
+
+    // Target can't be met even at the lowest resolution
+    Simulation simulation(settings, 1.0f);
+    simulation.model.scalableMs = 80.0;
+
+    simulation.Run(3000);
+
+    CHECK_EQ(simulation.controller.Ratio(), settings.maxRatio);
+
+    // Limits changed while running
+    settings.maxRatio = 1.5f;
+    simulation.controller.Configure(settings);
+
+    CHECK_EQ(simulation.controller.Ratio(), 1.5f);
+}
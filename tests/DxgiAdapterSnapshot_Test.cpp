@@ -0,0 +1,183 @@
+#include "Test.h"
+
+#include <hooks/DxgiFactory_AdapterSnapshot.h>
+
+#include <cwchar>
+
+static constexpr SIZE_T GB = 1024ull * 1024 * 1024;
+
+// What the driver's high performance enumeration hands out, in its order
+struct MockAdapter
+{
+    UINT vendorId;
+    UINT deviceId;
+    SIZE_T vram;
+    bool software;
+    const WCHAR* description;
+    DWORD luid;
+};
+
+static constexpr MockAdapter Radeon = { VendorId::AMD, 0x744C, 24 * GB, false, L"AMD Radeon RX 7900 XTX", 0x100 };
+static constexpr MockAdapter Arc = { VendorId::Intel, 0x56A0, 16 * GB, false, L"Intel(R) Arc(TM) A770 Graphics",
+                                     0x200 };
+static constexpr MockAdapter Igpu = { VendorId::Intel, 0xA780, 128 * 1024 * 1024, false, L"Intel(R) UHD Graphics 770",
+                                      0x300 };
+static constexpr MockAdapter Warp = { VendorId::Microsoft, 0x8C, 0, true, L"Microsoft Basic Render Driver", 0x400 };
+
+// Same steps as DxgiAdapterTopology::BuildSnapshot with the descs of the mock adapters
+static DxgiAdapterSnapshot Build(std::vector<MockAdapter> adapters, const AdapterSpoofingPolicy& policy,
+                                 bool firstOnly)
+{
+    DxgiAdapterSnapshot snapshot;
+
+    for (auto& adapter : adapters)
+    {
+        AdapterTopologyEntry entry {};
+        entry.luid.LowPart = adapter.luid;
+        entry.vendorId = adapter.vendorId;
+        entry.deviceId = adapter.deviceId;
+        entry.dedicatedVideoMemory = adapter.vram;
+        entry.software = adapter.software;
+        entry.description = adapter.description;
+
+        snapshot.Add(std::move(entry), policy);
+    }
+
+    snapshot.Finish(firstOnly);
+    return snapshot;
+}
+
+// Spoofs everything but software adapters as a 4090
+static AdapterSpoofingPolicy Policy()
+{
+    AdapterSpoofingPolicy policy {};
+    policy.enabled = true;
+    policy.vendorId = VendorId::Nvidia;
+    policy.deviceId = 0x2684;
+    policy.name = L"NVIDIA GeForce RTX 4090";
+    return policy;
+}
+
+TEST_CASE(KeepsDriverOrder)
+{
+    auto snapshot = Build({ Arc, Radeon, Igpu, Warp }, {}, false);
+
+    CHECK_EQ(snapshot.Adapters().size(), 4u);
+
+    const MockAdapter expected[] = { Arc, Radeon, Igpu, Warp };
+
+    for (UINT i = 0; i < 4; i++)
+    {
+        auto visible = snapshot.Find(i, true);
+        auto any = snapshot.Find(i, false);
+
+        CHECK(visible != nullptr && visible == any);
+        CHECK_EQ(any->index, i);
+        CHECK_EQ(any->luid.LowPart, expected[i].luid);
+        CHECK(any->description == expected[i].description);
+    }
+
+    CHECK(snapshot.Find(4, true) == nullptr);
+    CHECK(snapshot.Find(4, false) == nullptr);
+}
+
+// PreferFirstDedicatedGpu shows the driver's first choice, EnumAdapterByGpuPreference still sees all of them
+TEST_CASE(FirstOnlyHidesTheRest)
+{
+    auto snapshot = Build({ Radeon, Igpu, Warp }, {}, true);
+
+    CHECK(snapshot.FirstOnly());
+    CHECK(snapshot.Find(0, true) != nullptr);
+    CHECK_EQ(snapshot.Find(0, true)->luid.LowPart, Radeon.luid);
+    CHECK(snapshot.Find(1, true) == nullptr);
+
+    CHECK(snapshot.Find(2, false) != nullptr);
+    CHECK_EQ(snapshot.Find(2, false)->index, 2u);
+    CHECK(snapshot.Find(3, false) == nullptr);
+}
+
+TEST_CASE(VisibleAdaptersTable)
+{
+    CHECK(DxgiAdapterSnapshot::VisibleAdapters({}, false).empty());
+    CHECK(DxgiAdapterSnapshot::VisibleAdapters({}, true).empty());
+
+    std::vector<AdapterTopologyEntry> adapters(3);
+    CHECK(DxgiAdapterSnapshot::VisibleAdapters(adapters, false) == (std::vector<size_t> { 0, 1, 2 }));
+    CHECK(DxgiAdapterSnapshot::VisibleAdapters(adapters, true) == (std::vector<size_t> { 0 }));
+}
+
+TEST_CASE(EmptyAndCleared)
+{
+    auto snapshot = Build({}, {}, false);
+
+    CHECK(snapshot.Empty());
+    CHECK(snapshot.Find(0, true) == nullptr);
+    CHECK(snapshot.Find(0, false) == nullptr);
+
+    snapshot = Build({ Radeon }, {}, false);
+    snapshot.Clear();
+
+    CHECK(snapshot.Empty());
+    CHECK(snapshot.Find(0, true) == nullptr);
+}
+
+// Descs GetDesc reports are built with the snapshot, real values stay for the visibility rules
+TEST_CASE(SpoofedDescsBuiltOnce)
+{
+    auto policy = Policy();
+    policy.vramGB = 12;
+
+    auto snapshot = Build({ Radeon, Arc, Warp }, policy, false);
+    auto& adapters = snapshot.Adapters();
+
+    auto& radeon = adapters[0].spoofed;
+    CHECK(radeon.identity);
+    CHECK_EQ(radeon.vendorId, (UINT) VendorId::Nvidia);
+    CHECK_EQ(radeon.deviceId, 0x2684u);
+    CHECK(std::wcscmp(radeon.description, L"NVIDIA GeForce RTX 4090") == 0);
+    CHECK(radeon.vram);
+    CHECK_EQ(radeon.dedicatedVideoMemory, 12 * GB);
+
+    CHECK_EQ(adapters[0].vendorId, (UINT) VendorId::AMD);
+    CHECK_EQ(adapters[0].dedicatedVideoMemory, 24 * GB);
+    CHECK(adapters[0].description == Radeon.description);
+
+    CHECK(adapters[1].spoofed.identity);
+
+    // Software adapters keep their identity, VRAM still applies
+    CHECK(!adapters[2].spoofed.identity);
+    CHECK(adapters[2].spoofed.vram);
+    CHECK_EQ(adapters[2].spoofed.dedicatedVideoMemory, 12 * GB);
+}
+
+TEST_CASE(SpoofingTargetsOneVendor)
+{
+    auto policy = Policy();
+    policy.targetVendorId = VendorId::AMD;
+
+    auto snapshot = Build({ Arc, Radeon, Igpu }, policy, false);
+    auto& adapters = snapshot.Adapters();
+
+    CHECK(!adapters[0].spoofed.identity);
+    CHECK(adapters[1].spoofed.identity);
+    CHECK(!adapters[2].spoofed.identity);
+
+    // Without a VRAM override the real size is reported
+    CHECK(!adapters[0].spoofed.vram);
+    CHECK_EQ(adapters[0].spoofed.dedicatedVideoMemory, Arc.vram);
+
+    // Order is not changed by spoofing
+    CHECK_EQ(snapshot.Find(1, true)->luid.LowPart, Radeon.luid);
+}
+
+// Enabled flag is checked by the GetDesc hooks on every call, the desc is built as if enabled
+TEST_CASE(DisabledPolicyStillBuildsIdentity)
+{
+    auto policy = Policy();
+    policy.enabled = false;
+
+    auto snapshot = Build({ Radeon }, policy, false);
+
+    CHECK(snapshot.Adapters()[0].spoofed.identity);
+    CHECK(!snapshot.Adapters()[0].spoofed.vram);
+}
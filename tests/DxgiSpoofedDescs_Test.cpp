@@ -0,0 +1,127 @@
+#include "Test.h"
+
+#include <spoofing/Dxgi_SpoofingTables.h>
+
+#include <cwchar>
+
+static constexpr SIZE_T GB = 1024ull * 1024 * 1024;
+
+struct Adapter
+{
+    UINT vendorId;
+    UINT deviceId;
+    SIZE_T vram;
+    const WCHAR* description;
+};
+
+static constexpr Adapter Radeon = { VendorId::AMD, 0x744C, 24 * GB, L"AMD Radeon RX 7900 XTX" };
+static constexpr Adapter Arc = { VendorId::Intel, 0x56A0, 16 * GB, L"Intel(R) Arc(TM) A770 Graphics" };
+static constexpr Adapter Geforce = { VendorId::Nvidia, 0x2684, 24 * GB, L"NVIDIA GeForce RTX 4090" };
+static constexpr Adapter Warp = { VendorId::Microsoft, 0x8C, 0, L"Microsoft Basic Render Driver" };
+
+// Default spoofing, a 4090
+static AdapterSpoofingPolicy Policy()
+{
+    AdapterSpoofingPolicy policy {};
+    policy.enabled = true;
+    policy.vendorId = VendorId::Nvidia;
+    policy.deviceId = 0x2684;
+    policy.name = L"NVIDIA GeForce RTX 4090";
+    return policy;
+}
+
+struct Row
+{
+    const char* name;
+    Adapter adapter;
+    AdapterSpoofingPolicy policy;
+
+    bool identity;
+    UINT vendorId;
+    UINT deviceId;
+    const WCHAR* description;
+
+    bool vram;
+    SIZE_T dedicatedVideoMemory;
+};
+
+static std::vector<Row> Rows()
+{
+    auto targetAmd = Policy();
+    targetAmd.targetVendorId = VendorId::AMD;
+
+    auto targetDevice = Policy();
+    targetDevice.targetVendorId = VendorId::AMD;
+    targetDevice.targetDeviceId = 0x73BF;
+
+    auto vram = Policy();
+    vram.vramGB = 8;
+
+    auto disabled = Policy();
+    disabled.enabled = false;
+
+    auto custom = Policy();
+    custom.vendorId = 0x10DE;
+    custom.deviceId = 0x1234;
+    custom.name = L"Custom GPU";
+    custom.vramGB = 0;
+
+    return {
+        { "Spoofed", Radeon, Policy(), true, VendorId::Nvidia, 0x2684, L"NVIDIA GeForce RTX 4090", false, 24 * GB },
+        { "Already Nvidia", Geforce, Policy(), true, VendorId::Nvidia, 0x2684, L"NVIDIA GeForce RTX 4090", false,
+          24 * GB },
+        { "Software adapter", Warp, Policy(), false, 0, 0, L"", false, 0 },
+        { "Target vendor", Radeon, targetAmd, true, VendorId::Nvidia, 0x2684, L"NVIDIA GeForce RTX 4090", false,
+          24 * GB },
+        { "Other vendor", Arc, targetAmd, false, 0, 0, L"", false, 16 * GB },
+        { "Other device", Radeon, targetDevice, false, 0, 0, L"", false, 24 * GB },
+        { "VRAM", Arc, vram, true, VendorId::Nvidia, 0x2684, L"NVIDIA GeForce RTX 4090", true, 8 * GB },
+        { "VRAM of software adapter", Warp, vram, false, 0, 0, L"", true, 8 * GB },
+
+        // Enabled flag is checked on every call, the desc is built as if enabled
+        { "Disabled policy", Radeon, disabled, true, VendorId::Nvidia, 0x2684, L"NVIDIA GeForce RTX 4090", false,
+          24 * GB },
+        { "Custom", Arc, custom, true, 0x10DE, 0x1234, L"Custom GPU", true, 0 },
+    };
+}
+
+TEST_CASE(BuildTable)
+{
+    for (auto& row : Rows())
+    {
+        auto desc =
+            DxgiSpoofingTables::Build(row.adapter.vendorId, row.adapter.deviceId, row.adapter.vram, row.policy);
+
+        auto ok = desc.identity == row.identity && desc.vendorId == row.vendorId && desc.deviceId == row.deviceId &&
+                  std::wcscmp(desc.description, row.description) == 0 && desc.vram == row.vram &&
+                  desc.dedicatedVideoMemory == row.dedicatedVideoMemory;
+
+        if (!ok)
+            std::printf("  row failed: %s\n", row.name);
+
+        CHECK(ok);
+    }
+}
+
+TEST_CASE(LongNameKeepsTerminator)
+{
+    auto policy = Policy();
+    policy.name = std::wstring(200, L'X');
+
+    auto desc = DxgiSpoofingTables::Build(Radeon.vendorId, Radeon.deviceId, Radeon.vram, policy);
+
+    CHECK(desc.identity);
+    CHECK_EQ(std::wcslen(desc.description), std::size(desc.description) - 1);
+    CHECK_EQ(desc.description[0], L'X');
+}
+
+TEST_CASE(EmptyNameClearsDescription)
+{
+    auto policy = Policy();
+    policy.name.clear();
+
+    auto desc = DxgiSpoofingTables::Build(Radeon.vendorId, Radeon.deviceId, Radeon.vram, policy);
+
+    CHECK(desc.identity);
+    CHECK_EQ(desc.description[0], L'\0');
+}
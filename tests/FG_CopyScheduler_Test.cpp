@@ -0,0 +1,261 @@
+#include "Test.h"
+
+#include <framegen/FG_CopyScheduler.h>
+
+#include <functional>
+
+using Validity = FG_ResourceValidity;
+using Path = FG_CopyPath;
+
+// Content of a resource is the frame that last wrote it, -1 once the game reused it for something else
+struct MockResource
+{
+    int content = 0;
+};
+
+// Command lists are recorded as callbacks, executing one signals the queue's fence
+struct MockQueue
+{
+    uint64_t fence = 0;
+    std::vector<std::function<void()>> list;
+
+    uint64_t Execute()
+    {
+        for (auto& command : list)
+            command();
+
+        list.clear();
+        return ++fence;
+    }
+
+    // GPU side wait, the model runs queues one after the other so the value has to be reached already
+    void Wait(const MockQueue& other, uint64_t value) const { CHECK(other.fence >= value); }
+};
+
+struct Input
+{
+    MockResource* resource;
+    FG_ResourceType type;
+    Validity validity;
+    bool hasCmdList = true;
+    uint64_t bytes = 10;
+};
+
+struct FrameResult
+{
+    uint32_t wrongReads = 0;
+    uint32_t optionalDeferred = 0;
+};
+
+// One frame of the game's queue and our list at present. Inputs are rendered, tagged and
+// planned on the game's list, ValidNow content is overwritten right after tagging. Our list
+// waits for the game's fence and runs the deferred work, every read has to see this frame.
+static FrameResult RunFrame(FGCopyScheduler& scheduler, int frame, std::vector<Input> inputs)
+{
+    auto index = frame % BUFFER_COUNT;
+    scheduler.FinishFrame(index);
+
+    MockQueue game;
+    MockQueue ours;
+    FrameResult result;
+    std::vector<int> seen(inputs.size(), 0);
+
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        auto& input = inputs[i];
+        auto resource = input.resource;
+
+        game.list.push_back([=]() { resource->content = frame; });
+
+        auto path = scheduler.Plan(index, input.type, input.validity, input.hasCmdList, resource);
+        scheduler.Record(index, input.type, path, resource, input.bytes);
+
+        if (path != Path::Inline && input.validity == Validity::ValidButMakeCopy)
+            result.optionalDeferred++;
+
+        switch (path)
+        {
+        case Path::Inline:
+            game.list.push_back([&seen, i, resource]() { seen[i] = resource->content; });
+            break;
+
+        case Path::Deferred:
+            ours.list.push_back([&seen, i, resource]() { seen[i] = resource->content; });
+            break;
+
+        case Path::Merged:
+            // Output of the earlier deferred work of the same source
+            ours.list.push_back([&seen, i, &inputs, resource]()
+                                {
+                                    for (size_t j = 0; j < i; j++)
+                                    {
+                                        if (inputs[j].resource == resource)
+                                        {
+                                            seen[i] = seen[j];
+                                            break;
+                                        }
+                                    }
+                                });
+            break;
+        }
+
+        if (input.validity == Validity::ValidNow)
+            game.list.push_back([=]() { resource->content = -1; });
+    }
+
+    auto gameSubmission = game.Execute();
+
+    // Our list waits on the game's last submission
+    ours.Wait(game, gameSubmission);
+    ours.Execute();
+
+    for (auto value : seen)
+    {
+        if (value != frame)
+            result.wrongReads++;
+    }
+
+    return result;
+}
+
+TEST_CASE(ClassifyTable)
+{
+    CHECK(FGCopyScheduler::Classify(Validity::ValidNow, true) == Path::Inline);
+    CHECK(FGCopyScheduler::Classify(Validity::ValidButMakeCopy, true) == Path::Inline);
+    CHECK(FGCopyScheduler::Classify(Validity::UntilPresent, true) == Path::Deferred);
+    CHECK(FGCopyScheduler::Classify(Validity::UntilPresentFromDispatch, true) == Path::Deferred);
+    CHECK(FGCopyScheduler::Classify(Validity::JustTrackCmdlist, true) == Path::Deferred);
+
+    // Nothing to copy on without the game's list
+    CHECK(FGCopyScheduler::Classify(Validity::ValidNow, false) == Path::Deferred);
+    CHECK(FGCopyScheduler::Classify(Validity::ValidButMakeCopy, false) == Path::Deferred);
+}
+
+TEST_CASE(ReadsSeeTheTaggedFrame)
+{
+    FGCopyScheduler scheduler(1000);
+    MockResource depth, velocity, hudless, ui;
+
+    for (int frame = 1; frame < 40; frame++)
+    {
+        auto result = RunFrame(scheduler, frame,
+                               { { &depth, Depth, Validity::ValidNow },
+                                 { &velocity, Velocity, Validity::ValidButMakeCopy },
+                                 { &hudless, HudlessColor, Validity::UntilPresent },
+                                 { &hudless, HudlessColor, Validity::UntilPresent },
+                                 { &ui, UIColor, Validity::JustTrackCmdlist } });
+
+        CHECK_EQ(result.wrongReads, 0u);
+        CHECK_EQ(result.optionalDeferred, 0u);
+
+        auto& stats = scheduler.Stats(frame % BUFFER_COUNT);
+        CHECK_EQ(stats.inlineCopies, 2u);
+        CHECK_EQ(stats.deferredCopies, 2u);
+        CHECK_EQ(stats.mergedCopies, 1u);
+        CHECK_EQ(stats.mergedBytes, 10u);
+    }
+
+    CHECK(!scheduler.OverBudget());
+}
+
+TEST_CASE(MergesOnlyWithinTheSlotAndType)
+{
+    FGCopyScheduler scheduler;
+    MockResource hudless;
+
+    scheduler.Record(3, HudlessColor, Path::Deferred, &hudless, 1);
+    CHECK(scheduler.Plan(3, HudlessColor, Validity::UntilPresent, true, &hudless) == Path::Merged);
+
+    // Another type or slot with the same source
+    CHECK(scheduler.Plan(3, UIColor, Validity::UntilPresent, true, &hudless) == Path::Deferred);
+    CHECK(scheduler.Plan(2, HudlessColor, Validity::UntilPresent, true, &hudless) == Path::Deferred);
+
+    // Inline copies are never merged
+    scheduler.Record(3, Depth, Path::Inline, &hudless, 1);
+    CHECK(scheduler.Plan(3, Depth, Validity::ValidNow, true, &hudless) == Path::Inline);
+
+    // Cleared with the slot
+    scheduler.FinishFrame(3);
+    CHECK(scheduler.Plan(3, HudlessColor, Validity::UntilPresent, true, &hudless) == Path::Deferred);
+}
+
+// Over budget the optional copies move to our list, required ones stay inline
+TEST_CASE(BudgetDefersOptionalCopies)
+{
+    FGCopyScheduler scheduler(15);
+    MockResource depth, velocity;
+
+    std::vector<Input> inputs { { &depth, Depth, Validity::ValidNow, true, 10 },
+                                { &velocity, Velocity, Validity::ValidButMakeCopy, true, 10 } };
+
+    // Frame 1 copies both and goes over, noticed when its slot is finished
+    auto result = RunFrame(scheduler, 1, inputs);
+    CHECK_EQ(result.optionalDeferred, 0u);
+
+    for (int frame = 2; frame < 1 + BUFFER_COUNT; frame++)
+        RunFrame(scheduler, frame, inputs);
+
+    CHECK(!scheduler.OverBudget());
+
+    result = RunFrame(scheduler, 1 + BUFFER_COUNT, inputs);
+    CHECK(scheduler.OverBudget());
+    CHECK_EQ(result.optionalDeferred, 1u);
+    CHECK_EQ(result.wrongReads, 0u);
+    CHECK_EQ(scheduler.Stats((1 + BUFFER_COUNT) % BUFFER_COUNT).inlineBytes, 10u);
+
+    CHECK(scheduler.Plan(0, Depth, Validity::ValidNow, true, &depth) == Path::Inline);
+    CHECK(scheduler.Plan(0, Velocity, Validity::ValidButMakeCopy, true, &velocity) == Path::Deferred);
+}
+
+// Within budget again only after the hold, not every other frame
+TEST_CASE(BudgetHoldsBeforeRetrying)
+{
+    FGCopyScheduler scheduler(15);
+    MockResource depth, velocity;
+
+    std::vector<Input> inputs { { &depth, Depth, Validity::ValidNow, true, 10 },
+                                { &velocity, Velocity, Validity::ValidButMakeCopy, true, 10 } };
+
+    uint32_t switches = 0;
+    uint32_t deferredFrames = 0;
+    bool over = false;
+    int frames = 10 * FGCopyScheduler::HoldFrames;
+
+    for (int frame = 1; frame <= frames; frame++)
+    {
+        auto result = RunFrame(scheduler, frame, inputs);
+        CHECK_EQ(result.wrongReads, 0u);
+
+        deferredFrames += result.optionalDeferred;
+
+        if (scheduler.OverBudget() != over)
+        {
+            switches++;
+            over = scheduler.OverBudget();
+        }
+    }
+
+    // Copying both only lasts until the slots come around, then the hold runs out again
+    CHECK(switches <= 2u * (frames / FGCopyScheduler::HoldFrames) + 2);
+    CHECK(deferredFrames > (uint32_t) frames * 9 / 10);
+}
+
+TEST_CASE(RequiredCopiesAloneKeepItOver)
+{
+    FGCopyScheduler scheduler(15);
+    MockResource depth, velocity;
+    int frames = 3 * FGCopyScheduler::HoldFrames;
+
+    for (int frame = 1; frame < frames; frame++)
+    {
+        auto result = RunFrame(scheduler, frame,
+                               { { &depth, Depth, Validity::ValidNow, true, 20 },
+                                 { &velocity, Velocity, Validity::ValidButMakeCopy, true, 20 } });
+
+        CHECK_EQ(result.wrongReads, 0u);
+    }
+
+    // Over the whole time, required copies are never dropped
+    CHECK(scheduler.OverBudget());
+    CHECK(scheduler.Plan(0, Depth, Validity::ValidNow, true, &depth) == Path::Inline);
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <framegen/FG_FrameCounter.h>
+
+#include <cstdio>
+
+// Headless stand-in for IFGFeature, keeps the same counter calls and per slot state but no D3D.
+// Every step checks the invariants the FG backends rely on and counts the violations.
+class FGFrameCounterSim
+{
+    FGFrameCounter _frames;
+
+    // Frame whose resources are in each slot and whether depth was set for it
+    uint64_t _slotFrame[BUFFER_COUNT] {};
+    bool _depth[BUFFER_COUNT] {};
+
+    uint64_t _lastDispatch = 0;
+
+    // Frame numbers start over after Restart
+    bool _restarted = false;
+
+  public:
+    uint32_t allowedAhead = 1;
+    uint32_t violations = 0;
+    uint32_t dispatches = 0;
+
+    const FGFrameCounter& Frames() const { return _frames; }
+
+    void Violation(const char* what)
+    {
+        if (violations++ < 8)
+            std::printf("  invariant: %s, frame: %llu, last dispatched: %llu\n", what,
+                        (unsigned long long) _frames.FrameCount(), (unsigned long long) _frames.LastDispatchedFrame());
+    }
+
+    // IFGFeature::StartNewFrame, the slot is taken over by the new frame
+    void StartNewFrame()
+    {
+        _frames.StartNewFrame();
+
+        auto index = _frames.Index();
+        _slotFrame[index] = _frames.FrameCount();
+        _depth[index] = false;
+
+        auto last = _frames.LastDispatchedFrame();
+
+        if (last >= _frames.FrameCount() || _frames.FrameCount() - last > FGFrameCounter::MaxFramesBehind)
+            Violation("dispatch lags too far behind");
+    }
+
+    void SetDepth() { _depth[_frames.Index()] = true; }
+
+    // IFGFeature::NextDispatchFrame, skips to the current frame once it has depth
+    uint64_t NextDispatchFrame() const
+    {
+        return _frames.NextDispatchFrame(_frames.IsBehind(allowedAhead) && _depth[_frames.Index()]);
+    }
+
+    int GetIndexWillBeDispatched() const { return FGFrameCounter::IndexOf(NextDispatchFrame()); }
+
+    // IFGFeature::GetDispatchIndex followed by the backend reading the slot
+    int Dispatch()
+    {
+        if (_frames.IsDispatched())
+            return -1;
+
+        auto predicted = GetIndexWillBeDispatched();
+        auto frame = NextDispatchFrame();
+
+        // Any frame is taken when nothing was dispatched since a reset
+        auto afterReset = _frames.LastDispatchedFrame() == 0;
+
+        if (!_frames.Dispatched(frame))
+        {
+            if (afterReset)
+                Violation("frame rejected after reset");
+
+            return -1;
+        }
+
+        auto index = FGFrameCounter::IndexOf(frame);
+        dispatches++;
+
+        if (index != predicted)
+            Violation("dispatched index differs from the predicted one");
+
+        if (_frames.LastDispatchedFrame() != frame)
+            Violation("dispatched frame not recorded");
+
+        if (!afterReset)
+        {
+            if (frame <= _lastDispatch && !_restarted)
+                Violation("dispatch went backwards");
+
+            if (frame > _frames.FrameCount())
+                Violation("dispatched a frame which didn't start");
+
+            if (_slotFrame[index] != frame)
+                Violation("slot holds another frame");
+        }
+
+        if (_frames.IsDispatched() && _frames.Dispatched(_frames.FrameCount()))
+            Violation("dispatched twice in a frame");
+
+        _lastDispatch = frame;
+        _restarted = false;
+        return index;
+    }
+
+    void ResetDispatched() { _frames.ResetDispatched(); }
+
+    // IFGFeature::RestartFrames
+    void Restart()
+    {
+        _frames.Restart();
+
+        for (size_t i = 0; i < BUFFER_COUNT; i++)
+            _depth[i] = false;
+
+        _restarted = true;
+    }
+
+    // Pause holds FG for PauseFrames frames after the current one
+    void PauseAndRun(uint32_t frames)
+    {
+        _frames.Pause();
+        auto target = _frames.TargetFrame();
+
+        for (uint32_t i = 0; i < frames; i++)
+        {
+            StartNewFrame();
+
+            if (_frames.IsPaused() != (_frames.FrameCount() <= target))
+                Violation("pause length");
+        }
+    }
+};
+
+// Replays one op per byte, returns the violations. Shared by the test and the libFuzzer entry.
+inline uint32_t FuzzFrameCounter(const uint8_t* data, size_t size)
+{
+    FGFrameCounterSim sim;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        auto op = data[i];
+
+        switch (op % 8)
+        {
+        case 0:
+        case 1:
+            sim.StartNewFrame();
+            break;
+        case 2:
+            sim.SetDepth();
+            break;
+        case 3:
+        case 4:
+            sim.Dispatch();
+            break;
+        case 5:
+            if (op & 0x80)
+                sim.Restart();
+            else
+                sim.ResetDispatched();
+            break;
+        case 6:
+            sim.PauseAndRun(op >> 3);
+            break;
+        case 7:
+            sim.allowedAhead = (op >> 3) % 4;
+            break;
+        }
+    }
+
+    return sim.violations;
+}
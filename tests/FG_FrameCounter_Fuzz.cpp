@@ -0,0 +1,12 @@
+#include "FG_FrameCounterSim.h"
+
+#include <cstdlib>
+
+// libFuzzer entry, built with -DOPTI_FUZZ=ON and clang
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    if (FuzzFrameCounter(data, size) != 0)
+        std::abort();
+
+    return 0;
+}
@@ -0,0 +1,214 @@
+#include "Test.h"
+#include "FG_FrameCounterSim.h"
+
+#include <random>
+
+// Upscaler sets depth, FG dispatches at present, every frame
+TEST_CASE(SteadyCadence)
+{
+    FGFrameCounterSim sim;
+
+    for (int i = 0; i < 100; i++)
+    {
+        sim.StartNewFrame();
+        sim.SetDepth();
+
+        auto index = sim.Dispatch();
+        CHECK_EQ(index, sim.Frames().Index());
+        CHECK_EQ(sim.Dispatch(), -1);
+    }
+
+    CHECK_EQ(sim.dispatches, 100u);
+    CHECK_EQ(sim.violations, 0u);
+}
+
+// Upscaler runs a frame ahead of present, the previous frame is dispatched while it's allowed
+TEST_CASE(FrameAhead)
+{
+    FGFrameCounterSim sim;
+    sim.allowedAhead = 2;
+
+    sim.StartNewFrame();
+    sim.SetDepth();
+    sim.Dispatch();
+
+    for (int i = 0; i < 50; i++)
+    {
+        sim.StartNewFrame();
+        sim.SetDepth();
+        sim.StartNewFrame();
+        sim.SetDepth();
+
+        auto expected = sim.Frames().FrameCount() - 1;
+        CHECK_EQ(sim.Dispatch(), FGFrameCounter::IndexOf(expected));
+        CHECK_EQ(sim.Frames().LastDispatchedFrame(), expected);
+
+        // Catches up on the next present
+        sim.Dispatch();
+        CHECK(sim.Frames().IsDispatched());
+    }
+
+    CHECK_EQ(sim.violations, 0u);
+}
+
+// Same cadence with nothing allowed ahead skips to the current frame
+TEST_CASE(SkipsToCurrent)
+{
+    FGFrameCounterSim sim;
+    sim.allowedAhead = 0;
+
+    for (int i = 0; i < 50; i++)
+    {
+        sim.StartNewFrame();
+        sim.SetDepth();
+        sim.StartNewFrame();
+        sim.SetDepth();
+
+        CHECK_EQ(sim.Dispatch(), sim.Frames().Index());
+        CHECK_EQ(sim.Dispatch(), -1);
+    }
+
+    CHECK_EQ(sim.violations, 0u);
+}
+
+// Frames without dispatch resync to the previous frame instead of handing out reused slots
+TEST_CASE(SkipsWhenFarBehind)
+{
+    FGFrameCounterSim sim;
+
+    sim.StartNewFrame();
+    sim.Dispatch();
+
+    for (int i = 0; i < 6; i++)
+    {
+        sim.StartNewFrame();
+        CHECK(sim.Frames().FrameCount() - sim.Frames().LastDispatchedFrame() <= FGFrameCounter::MaxFramesBehind);
+    }
+
+    sim.SetDepth();
+    CHECK_EQ(sim.Dispatch(), sim.Frames().Index());
+    CHECK_EQ(sim.violations, 0u);
+}
+
+// Frame 1 is taken right after a reset like it always was, the next frame resyncs
+TEST_CASE(DispatchAfterReset)
+{
+    FGFrameCounterSim sim;
+
+    for (int i = 0; i < 20; i++)
+    {
+        sim.StartNewFrame();
+        sim.SetDepth();
+        sim.Dispatch();
+    }
+
+    sim.StartNewFrame();
+    sim.ResetDispatched();
+
+    // No depth yet, dispatch starts from the first frame
+    CHECK_EQ(sim.Dispatch(), FGFrameCounter::IndexOf(1));
+    CHECK_EQ(sim.Frames().LastDispatchedFrame(), 1u);
+
+    sim.StartNewFrame();
+    CHECK_EQ(sim.Frames().LastDispatchedFrame(), sim.Frames().FrameCount() - 1);
+
+    // With depth the current frame is taken
+    sim.ResetDispatched();
+    sim.SetDepth();
+    CHECK_EQ(sim.Dispatch(), sim.Frames().Index());
+    CHECK(sim.Frames().IsDispatched());
+
+    CHECK_EQ(sim.violations, 0u);
+}
+
+TEST_CASE(RestartStartsOver)
+{
+    FGFrameCounterSim sim;
+
+    for (int i = 0; i < 20; i++)
+    {
+        sim.StartNewFrame();
+        sim.SetDepth();
+        sim.Dispatch();
+    }
+
+    sim.Restart();
+    CHECK_EQ(sim.Frames().FrameCount(), 1u);
+
+    // Old dispatch is ahead of the new frames, nothing until the next frame resyncs
+    CHECK_EQ(sim.Dispatch(), -1);
+
+    sim.StartNewFrame();
+    sim.SetDepth();
+    CHECK_EQ(sim.Dispatch(), sim.Frames().Index());
+    CHECK_EQ(sim.violations, 0u);
+}
+
+TEST_CASE(PauseLength)
+{
+    FGFrameCounterSim sim;
+    sim.StartNewFrame();
+
+    CHECK(!sim.Frames().IsPaused());
+
+    sim.PauseAndRun(FGFrameCounter::PauseFrames + 3);
+    CHECK(!sim.Frames().IsPaused());
+    CHECK_EQ(sim.violations, 0u);
+}
+
+// Random interleavings of the upscaler, present and config changes
+TEST_CASE(RandomRuns)
+{
+    std::mt19937 random(47);
+    uint32_t violations = 0;
+    uint32_t dispatches = 0;
+
+    for (int run = 0; run < 200; run++)
+    {
+        FGFrameCounterSim sim;
+        sim.allowedAhead = random() % 3;
+
+        for (int step = 0; step < 2000; step++)
+        {
+            auto roll = random() % 100;
+
+            if (roll < 35)
+                sim.StartNewFrame();
+            else if (roll < 60)
+                sim.SetDepth();
+            else if (roll < 95)
+                sim.Dispatch();
+            else if (roll < 98)
+                sim.ResetDispatched();
+            else if (roll < 99)
+                sim.Restart();
+            else
+                sim.PauseAndRun(random() % 16);
+        }
+
+        violations += sim.violations;
+        dispatches += sim.dispatches;
+    }
+
+    CHECK_EQ(violations, 0u);
+    CHECK(dispatches > 10000);
+}
+
+TEST_CASE(FuzzCorpus)
+{
+    std::mt19937 random(4747);
+    std::vector<uint8_t> data;
+    uint32_t violations = 0;
+
+    for (int i = 0; i < 2000; i++)
+    {
+        data.resize(random() % 512);
+
+        for (auto& byte : data)
+            byte = (uint8_t) random();
+
+        violations += FuzzFrameCounter(data.data(), data.size());
+    }
+
+    CHECK_EQ(violations, 0u);
+}
@@ -0,0 +1,215 @@
+#include "Test.h"
+
+#include <upscalers/FeatureLifecycle.h>
+
+// Fence of a queue the test advances by hand
+struct MockFence : IRetireFence
+{
+    uint64_t signaled = 0;
+    uint64_t completed = 0;
+    bool failSignal = false;
+
+    bool Signal(uint64_t* value) override
+    {
+        if (failSignal)
+            return false;
+
+        *value = ++signaled;
+        return true;
+    }
+
+    uint64_t CompletedValue() override { return completed; }
+};
+
+// Counts its releases, the GPU would still be using it if that happened early
+struct MockFeature
+{
+    uint32_t* released;
+
+    explicit MockFeature(uint32_t* released) : released(released) {}
+    ~MockFeature() { (*released)++; }
+};
+
+using Lifecycle = FeatureLifecycle<MockFeature>;
+
+static FeatureStandbyKey Key(std::string backend, UINT handleId, unsigned int width = 1920)
+{
+    FeatureStandbyKey key {};
+    key.backend = backend;
+    key.handleId = handleId;
+    key.displayWidth = width;
+    return key;
+}
+
+TEST_CASE(ReleasedWhenFenceCompletes)
+{
+    Lifecycle lifecycle;
+    MockFence fence;
+    uint32_t released = 0;
+
+    lifecycle.Retire(std::make_unique<MockFeature>(&released));
+
+    // Present signals the fence, the GPU isn't there yet
+    lifecycle.OnPresent(&fence);
+    CHECK_EQ(fence.signaled, 1u);
+    CHECK_EQ(released, 0u);
+    CHECK(lifecycle.UsesFence(&fence));
+
+    // Nothing new to signal for
+    lifecycle.OnPresent(&fence);
+    CHECK_EQ(fence.signaled, 1u);
+    CHECK_EQ(released, 0u);
+
+    fence.completed = 1;
+    lifecycle.OnPresent(&fence);
+    CHECK_EQ(released, 1u);
+    CHECK_EQ(lifecycle.GraveyardSize(), 0u);
+    CHECK_EQ(lifecycle.ReleasedCount(), 1u);
+    CHECK(!lifecycle.UsesFence(&fence));
+}
+
+TEST_CASE(ReleasedInRetireOrder)
+{
+    Lifecycle lifecycle;
+    MockFence fence;
+    uint32_t first = 0;
+    uint32_t second = 0;
+
+    lifecycle.Retire(std::make_unique<MockFeature>(&first));
+    lifecycle.OnPresent(&fence);
+
+    lifecycle.Retire(std::make_unique<MockFeature>(&second));
+    lifecycle.OnPresent(&fence);
+    CHECK_EQ(fence.signaled, 2u);
+
+    fence.completed = 1;
+    lifecycle.OnPresent(&fence);
+    CHECK_EQ(first, 1u);
+    CHECK_EQ(second, 0u);
+
+    fence.completed = 2;
+    lifecycle.OnPresent(&fence);
+    CHECK_EQ(second, 1u);
+}
+
+// Retired on one queue's fence, later presents use another one
+TEST_CASE(KeepsTheFenceItWasSignaledOn)
+{
+    Lifecycle lifecycle;
+    MockFence oldFence;
+    MockFence newFence;
+    uint32_t released = 0;
+
+    lifecycle.Retire(std::make_unique<MockFeature>(&released));
+    lifecycle.OnPresent(&oldFence);
+
+    newFence.completed = 100;
+    lifecycle.OnPresent(&newFence);
+    CHECK_EQ(released, 0u);
+    CHECK(lifecycle.UsesFence(&oldFence));
+    CHECK(!lifecycle.UsesFence(&newFence));
+
+    oldFence.completed = 1;
+    lifecycle.OnPresent(&newFence);
+    CHECK_EQ(released, 1u);
+    CHECK(!lifecycle.UsesFence(&oldFence));
+}
+
+TEST_CASE(WithoutFenceWaitsForPresents)
+{
+    Lifecycle lifecycle;
+    MockFence failing;
+    failing.failSignal = true;
+    uint32_t released = 0;
+
+    lifecycle.Retire(std::make_unique<MockFeature>(&released));
+
+    // No fence and one which can't be signaled both fall back to counting presents
+    for (uint32_t i = 1; i < Lifecycle::FramesWithoutFence; i++)
+    {
+        lifecycle.OnPresent(i % 2 == 0 ? nullptr : &failing);
+        CHECK_EQ(released, 0u);
+    }
+
+    lifecycle.OnPresent(nullptr);
+    CHECK_EQ(released, 1u);
+}
+
+TEST_CASE(FenceNeverCompletes)
+{
+    Lifecycle lifecycle;
+    MockFence fence;
+    uint32_t released = 0;
+
+    lifecycle.Retire(std::make_unique<MockFeature>(&released));
+
+    for (uint32_t i = 1; i < Lifecycle::MaxFramesInGraveyard; i++)
+        lifecycle.OnPresent(&fence);
+
+    CHECK_EQ(released, 0u);
+
+    lifecycle.OnPresent(&fence);
+    CHECK_EQ(released, 1u);
+}
+
+TEST_CASE(StandbyIsTakenBack)
+{
+    Lifecycle lifecycle;
+    uint32_t released = 0;
+
+    lifecycle.Park(Key("xess", 1), std::make_unique<MockFeature>(&released), 100, 2, 1000);
+    CHECK_EQ(lifecycle.StandbySize(), 1u);
+    CHECK_EQ(lifecycle.StandbyBytes(), 100u);
+
+    // Another size is another feature
+    CHECK(lifecycle.TakeStandby(Key("xess", 1, 1280)) == nullptr);
+
+    auto feature = lifecycle.TakeStandby(Key("xess", 1));
+    CHECK(feature != nullptr);
+    CHECK_EQ(lifecycle.StandbySize(), 0u);
+    CHECK_EQ(lifecycle.StandbyBytes(), 0u);
+    CHECK_EQ(lifecycle.GraveyardSize(), 0u);
+}
+
+TEST_CASE(StandbyLimitsRetireTheOldest)
+{
+    Lifecycle lifecycle;
+    MockFence fence;
+    uint32_t first = 0;
+    uint32_t second = 0;
+    uint32_t third = 0;
+
+    lifecycle.Park(Key("xess", 1), std::make_unique<MockFeature>(&first), 100, 2, 250);
+    lifecycle.Park(Key("fsr31", 1), std::make_unique<MockFeature>(&second), 100, 2, 250);
+    CHECK_EQ(lifecycle.GraveyardSize(), 0u);
+
+    // Over the budget, the oldest goes through the graveyard like any retired feature
+    lifecycle.Park(Key("dlss", 1), std::make_unique<MockFeature>(&third), 100, 2, 250);
+    CHECK_EQ(lifecycle.StandbySize(), 2u);
+    CHECK_EQ(lifecycle.GraveyardSize(), 1u);
+    CHECK(lifecycle.TakeStandby(Key("xess", 1)) == nullptr);
+
+    lifecycle.OnPresent(&fence);
+    fence.completed = fence.signaled;
+    lifecycle.OnPresent(&fence);
+    CHECK_EQ(first, 1u);
+    CHECK_EQ(second, 0u);
+
+    // Disabled standby and features larger than the budget are retired right away
+    uint32_t disabled = 0;
+    lifecycle.Park(Key("fsr2", 2), std::make_unique<MockFeature>(&disabled), 100, 0, 250);
+    lifecycle.Park(Key("fsr2", 3), std::make_unique<MockFeature>(&disabled), 300, 2, 250);
+    CHECK_EQ(lifecycle.GraveyardSize(), 2u);
+    CHECK_EQ(lifecycle.StandbySize(), 2u);
+
+    lifecycle.RetireStandby(1);
+    CHECK_EQ(lifecycle.StandbySize(), 0u);
+    CHECK_EQ(lifecycle.StandbyBytes(), 0u);
+
+    lifecycle.OnPresent(&fence);
+    fence.completed = fence.signaled;
+    lifecycle.OnPresent(&fence);
+    CHECK_EQ(disabled, 2u);
+    CHECK_EQ(second, 1u);
+    CHECK_EQ(third, 1u);
+}
@@ -0,0 +1,137 @@
+#include "Test.h"
+
+#include <misc/GpuRules.h>
+
+static GpuRecord Gpu(uint32_t vendorId, uint32_t deviceId, const wchar_t* description = L"",
+                     uint64_t driverVersion = 0x0020001F000D1234)
+{
+    GpuRecord gpu;
+    gpu.vendorId = vendorId;
+    gpu.deviceId = deviceId;
+    gpu.description = description;
+    gpu.driverVersion = driverVersion;
+    return gpu;
+}
+
+static const GpuRecord Rtx4090 = Gpu(VendorId::Nvidia, 0x2684, L"NVIDIA GeForce RTX 4090");
+static const GpuRecord Gtx1080 = Gpu(VendorId::Nvidia, 0x1B80, L"NVIDIA GeForce GTX 1080");
+static const GpuRecord Rx9070 = Gpu(VendorId::AMD, 0x7550, L"AMD Radeon RX 9070 XT");
+static const GpuRecord Rx9060 = Gpu(VendorId::AMD, 0x7590, L"AMD Radeon RX 9060 XT");
+static const GpuRecord Rx7900 = Gpu(VendorId::AMD, 0x744C, L"AMD Radeon RX 7900 XTX");
+static const GpuRecord Arc = Gpu(VendorId::Intel, 0x56A0, L"Intel(R) Arc(TM) A770 Graphics");
+static const GpuRecord Warp = Gpu(VendorId::Microsoft, 0x8C, L"Microsoft Basic Render Driver");
+
+struct Row
+{
+    const char* name;
+    std::vector<GpuRecord> gpus;
+
+    bool known;
+    bool nvidiaPresent;
+    bool pascalOrOlder;
+    bool fsr4Eligible;
+};
+
+static std::vector<Row> Rows()
+{
+    return {
+        { "No adapters", {}, false, false, false, false },
+        { "Software only", { Warp }, false, false, false, false },
+        { "Invalid vendor", { Gpu(VendorId::Invalid, 0x1234) }, false, false, false, false },
+        { "Ada", { Rtx4090 }, true, true, false, false },
+        { "Pascal", { Gtx1080 }, true, true, true, false },
+        { "Pascal and Ada", { Gtx1080, Rtx4090 }, true, true, false, false },
+        { "Pascal and software", { Warp, Gtx1080 }, true, true, true, false },
+        { "RDNA4", { Rx9070 }, true, false, false, true },
+        { "RDNA4 Navi 44", { Rx9060 }, true, false, false, true },
+        { "RDNA3", { Rx7900 }, true, false, false, false },
+        { "RDNA4 by name", { Gpu(VendorId::AMD, 0x1234, L"AMD Radeon RX 9070 GRE") }, true, false, false, true },
+        { "RDNA4 on Linux", { Gpu(VendorId::AMD, 0x1234, L"AMD Radeon Graphics GFX12") }, true, false, false, true },
+        { "Intel", { Arc }, true, false, false, false },
+        { "Intel and RDNA4", { Arc, Rx9070 }, true, false, false, true },
+
+        // Names are only checked for AMD
+        { "Nvidia with RDNA4 like name", { Gpu(VendorId::Nvidia, 0x2684, L"Test 90") }, true, true, false, false },
+
+        // Unknown device id is not taken as Pascal
+        { "Nvidia without device id", { Gpu(VendorId::Nvidia, 0) }, true, true, false, false },
+    };
+}
+
+TEST_CASE(EvaluateTable)
+{
+    for (auto& row : Rows())
+    {
+        auto caps = GpuRules::Evaluate(row.gpus);
+
+        auto ok = caps.known == row.known && caps.nvidiaPresent == row.nvidiaPresent &&
+                  caps.pascalOrOlder == row.pascalOrOlder && caps.fsr4Eligible == row.fsr4Eligible;
+
+        if (!ok)
+            std::printf("  row failed: %s\n", row.name);
+
+        CHECK(ok);
+    }
+}
+
+TEST_CASE(PascalBoundary)
+{
+    CHECK(GpuRules::IsPascalOrOlder(Gpu(VendorId::Nvidia, 0x1D7F)));
+    CHECK(!GpuRules::IsPascalOrOlder(Gpu(VendorId::Nvidia, 0x1D80)));
+    CHECK(!GpuRules::IsPascalOrOlder(Gpu(VendorId::AMD, 0x1000)));
+}
+
+TEST_CASE(CacheKey)
+{
+    CHECK(GpuRules::HasCacheKey(Rtx4090));
+    CHECK(!GpuRules::HasCacheKey(Gpu(VendorId::Nvidia, 0x2684, L"", 0)));
+    CHECK(!GpuRules::HasCacheKey(Gpu(VendorId::Nvidia, 0)));
+    CHECK(!GpuRules::HasCacheKey(Gpu(VendorId::Invalid, 0x2684)));
+}
+
+struct CacheRow
+{
+    const char* name;
+    std::vector<GpuRecord> cached;
+    std::vector<GpuRecord> current;
+    bool matches;
+};
+
+static std::vector<CacheRow> CacheRows()
+{
+    // Same driver version on another card, like a swap within a vendor
+    auto rtx4080 = Gpu(VendorId::Nvidia, 0x2704, L"NVIDIA GeForce RTX 4080");
+    auto updated = Rtx4090;
+    updated.driverVersion++;
+
+    // Only the keys are compared, the rest comes from the cache
+    auto queried = Gpu(VendorId::Nvidia, 0x2684);
+
+    return {
+        { "Same adapters", { Rtx4090, Warp }, { Rtx4090, Warp }, true },
+        { "Only keys queried", { Rtx4090 }, { queried }, true },
+        { "Driver updated", { Rtx4090 }, { updated }, false },
+        { "Card swapped, same driver", { Rtx4090 }, { rtx4080 }, false },
+        { "Vendor swapped", { Rx7900 }, { Gpu(VendorId::Nvidia, Rx7900.deviceId) }, false },
+        { "Adapter added", { Rtx4090 }, { Rtx4090, Arc }, false },
+        { "Adapter removed", { Rtx4090, Arc }, { Rtx4090 }, false },
+        { "Order changed", { Rtx4090, Arc }, { Arc, Rtx4090 }, false },
+        { "Version unknown", { Gpu(VendorId::Nvidia, 0x2684, L"", 0) }, { Gpu(VendorId::Nvidia, 0x2684, L"", 0) },
+          false },
+        { "Ids unknown", { Gpu(VendorId::Invalid, 0) }, { Gpu(VendorId::Invalid, 0) }, false },
+        { "Nothing enumerated", {}, {}, true },
+    };
+}
+
+TEST_CASE(MatchesCacheTable)
+{
+    for (auto& row : CacheRows())
+    {
+        auto ok = GpuRules::MatchesCache(row.cached, row.current) == row.matches;
+
+        if (!ok)
+            std::printf("  row failed: %s\n", row.name);
+
+        CHECK(ok);
+    }
+}
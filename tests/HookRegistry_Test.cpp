@@ -0,0 +1,355 @@
+#include "MockHookBackend.h"
+#include "Test.h"
+
+// Registry singleton isn't used, the game backend is replaced
+IHookBackend* DetoursHookBackend()
+{
+    static MockHookBackend backend;
+    return &backend;
+}
+
+static const void* Address(uintptr_t value) { return reinterpret_cast<const void*>(value); }
+static void* Pointer(uintptr_t value) { return reinterpret_cast<void*>(value); }
+
+// mov [rsp+8], rbx; push rdi; sub rsp, 20h
+static const std::vector<uint8_t> Prologue = { 0x48, 0x89, 0x5C, 0x24, 0x08, 0x57, 0x48, 0x83,
+                                               0xEC, 0x20, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90 };
+
+static std::vector<uint8_t> Code(std::vector<uint8_t> bytes)
+{
+    bytes.resize(std::max<size_t>(bytes.size(), 16), 0x90);
+    return bytes;
+}
+
+static std::vector<uint8_t> JmpRel32(uintptr_t from, uintptr_t to)
+{
+    auto offset = static_cast<int32_t>(to - (from + 5));
+    std::vector<uint8_t> bytes = { 0xE9, 0, 0, 0, 0 };
+    std::memcpy(bytes.data() + 1, &offset, sizeof(offset));
+    return Code(bytes);
+}
+
+// Registry over a mock with plain functions at 0x10000, 0x11000 and 0x12000
+struct Fixture
+{
+    MockHookBackend backend;
+    HookRegistry registry { &backend };
+
+    void* oFirst = Pointer(0x10000);
+    void* oSecond = Pointer(0x11000);
+    void* oThird = Pointer(0x12000);
+
+    void* detourFirst = Pointer(0xD0010);
+    void* detourSecond = Pointer(0xD0020);
+    void* detourThird = Pointer(0xD0030);
+
+    Fixture()
+    {
+        backend.code[0x10000] = Prologue;
+        backend.code[0x11000] = Prologue;
+        backend.code[0x12000] = Prologue;
+        backend.modules[0x10000] = "d3d12.dll";
+        backend.modules[0x900000] = "overlay.dll";
+    }
+
+    HookInfo Info(void** original) const
+    {
+        for (auto& hook : registry.Hooks())
+        {
+            if (hook.original == original)
+                return hook;
+        }
+
+        return {};
+    }
+};
+
+TEST_CASE(DecodeJumpRel8)
+{
+    bool indirect = true;
+    const uint8_t forward[] = { 0xEB, 0x10 };
+    const uint8_t backward[] = { 0xEB, 0xFE };
+
+    CHECK(HookRegistry::DecodeJump(forward, sizeof(forward), Address(0x1000), indirect) == Address(0x1012));
+    CHECK(!indirect);
+
+    // jmp $ jumps to itself
+    CHECK(HookRegistry::DecodeJump(backward, sizeof(backward), Address(0x1000), indirect) == Address(0x1000));
+
+    // Truncated
+    CHECK(HookRegistry::DecodeJump(forward, 1, Address(0x1000), indirect) == nullptr);
+}
+
+TEST_CASE(DecodeJumpRel32)
+{
+    bool indirect = true;
+    auto forward = JmpRel32(0x10000, 0x900000);
+    auto backward = JmpRel32(0x900000, 0x10000);
+
+    CHECK(HookRegistry::DecodeJump(forward.data(), 5, Address(0x10000), indirect) == Address(0x900000));
+    CHECK(!indirect);
+    CHECK(HookRegistry::DecodeJump(backward.data(), 5, Address(0x900000), indirect) == Address(0x10000));
+    CHECK(HookRegistry::DecodeJump(forward.data(), 4, Address(0x10000), indirect) == nullptr);
+}
+
+TEST_CASE(DecodeJumpRipIndirect)
+{
+    bool indirect = false;
+
+    // jmp [rip+0x100], pointer after the 6 byte instruction
+    const uint8_t code[] = { 0xFF, 0x25, 0x00, 0x01, 0x00, 0x00 };
+
+    CHECK(HookRegistry::DecodeJump(code, sizeof(code), Address(0x2000), indirect) == Address(0x2106));
+    CHECK(indirect);
+
+    // call [rip+x] isn't a jump
+    const uint8_t call[] = { 0xFF, 0x15, 0x00, 0x01, 0x00, 0x00 };
+    CHECK(HookRegistry::DecodeJump(call, sizeof(call), Address(0x2000), indirect) == nullptr);
+}
+
+TEST_CASE(DecodeJumpMovRax)
+{
+    bool indirect = true;
+    uint8_t code[12] = { 0x48, 0xB8, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xE0 };
+    uint64_t destination = 0x7ffe12345678ull;
+    std::memcpy(code + 2, &destination, sizeof(destination));
+
+    CHECK(HookRegistry::DecodeJump(code, sizeof(code), Address(0x3000), indirect) == Address(destination));
+    CHECK(!indirect);
+
+    // mov rax, imm64 followed by something else
+    code[11] = 0xD0;
+    CHECK(HookRegistry::DecodeJump(code, sizeof(code), Address(0x3000), indirect) == nullptr);
+}
+
+TEST_CASE(DecodeJumpPlainPrologue)
+{
+    bool indirect = true;
+
+    CHECK(HookRegistry::DecodeJump(Prologue.data(), Prologue.size(), Address(0x10000), indirect) == nullptr);
+    CHECK(!indirect);
+    CHECK(HookRegistry::DecodeJump(Prologue.data(), 0, Address(0x10000), indirect) == nullptr);
+}
+
+TEST_CASE(GroupInstallsInOneTransaction)
+{
+    Fixture f;
+
+    f.registry.Declare("Dx12", "First", &f.oFirst, f.detourFirst);
+    f.registry.Declare("Dx12", "Second", &f.oSecond, f.detourSecond);
+    f.registry.Declare("Dxgi", "Third", &f.oThird, f.detourThird);
+
+    CHECK(f.registry.Install("Dx12"));
+    CHECK_EQ(f.backend.Count("begin"), 1u);
+    CHECK_EQ(f.backend.Count("commit"), 1u);
+    CHECK(f.registry.IsInstalled("Dx12"));
+    CHECK(!f.registry.IsInstalled("Dxgi"));
+
+    // Originals hold the trampolines, the targets jump to the detours
+    CHECK(f.backend.trampolines[f.oFirst] == Pointer(0x10000));
+    CHECK(f.backend.patched[Pointer(0x11000)] == f.detourSecond);
+    CHECK(f.oThird == Pointer(0x12000));
+    CHECK(f.Info(&f.oFirst).state == HookState::Installed);
+
+    // Installed groups are left alone
+    CHECK(f.registry.Install("Dx12"));
+    CHECK_EQ(f.backend.Count("begin"), 1u);
+}
+
+TEST_CASE(MissingTargetAndPrologueAreSkipped)
+{
+    Fixture f;
+    void* oMissing = nullptr;
+    const uint8_t expected[] = { 0x40, 0x53 }; // push rbx
+
+    f.registry.Declare("Dx12", "Missing", &oMissing, f.detourFirst);
+    f.registry.Declare("Dx12", "Mismatch", &f.oSecond, f.detourSecond, expected);
+    f.registry.Declare("Dx12", "Match", &f.oThird, f.detourThird, std::span(Prologue.data(), 5));
+
+    CHECK(f.registry.Install("Dx12"));
+    CHECK(f.Info(&oMissing).state == HookState::Skipped);
+    CHECK(f.Info(&f.oSecond).state == HookState::Skipped);
+    CHECK(f.Info(&f.oThird).state == HookState::Installed);
+    CHECK(f.oSecond == Pointer(0x11000));
+
+    // Skipped hooks don't keep the group from counting as installed
+    CHECK(f.registry.IsInstalled("Dx12"));
+}
+
+TEST_CASE(UnreadableTargetIsSkipped)
+{
+    Fixture f;
+    void* oUnmapped = Pointer(0x50000);
+
+    f.registry.Declare("Dx12", "Unmapped", &oUnmapped, f.detourFirst);
+
+    CHECK(f.registry.Install("Dx12"));
+    CHECK(f.Info(&oUnmapped).state == HookState::Skipped);
+    CHECK_EQ(f.backend.Count("begin"), 0u);
+}
+
+TEST_CASE(ChainedHookIsDetected)
+{
+    Fixture f;
+    const uint8_t expected[] = { 0x40, 0x53 };
+
+    // Overlay hooked the first function already, its prologue is a jump now
+    f.backend.code[0x10000] = JmpRel32(0x10000, 0x900100);
+    f.backend.code[0x900100] = Prologue;
+
+    // Second goes through a pointer, jmp [rip+0x1000] with the pointer in the overlay
+    f.backend.code[0x11000] = Code({ 0xFF, 0x25, 0xFA, 0x0F, 0x00, 0x00 });
+    uint64_t pointer = 0x900200;
+    std::vector<uint8_t> slot(8);
+    std::memcpy(slot.data(), &pointer, sizeof(pointer));
+    f.backend.code[0x12000] = slot;
+
+    f.registry.Declare("Dx12", "First", &f.oFirst, f.detourFirst, expected);
+    f.registry.Declare("Dx12", "Second", &f.oSecond, f.detourSecond);
+
+    CHECK(f.registry.Install("Dx12"));
+
+    // Expected prologue is behind the jump, it isn't compared
+    auto first = f.Info(&f.oFirst);
+    CHECK(first.state == HookState::Installed);
+    CHECK(first.chained);
+    CHECK(first.chainedModule == "overlay.dll");
+
+    auto second = f.Info(&f.oSecond);
+    CHECK(second.chained);
+    CHECK(second.chainedModule == "overlay.dll");
+}
+
+TEST_CASE(FailedAttachIsRetriedWithoutIt)
+{
+    Fixture f;
+    f.backend.failAttach = f.detourSecond;
+
+    f.registry.Declare("Dx12", "First", &f.oFirst, f.detourFirst);
+    f.registry.Declare("Dx12", "Second", &f.oSecond, f.detourSecond);
+    f.registry.Declare("Dx12", "Third", &f.oThird, f.detourThird);
+
+    CHECK(!f.registry.Install("Dx12"));
+
+    // First transaction aborted, the second one commits the others
+    CHECK_EQ(f.backend.Count("abort"), 1u);
+    CHECK_EQ(f.backend.Count("begin"), 2u);
+    CHECK_EQ(f.backend.Count("commit"), 1u);
+
+    CHECK(f.Info(&f.oFirst).state == HookState::Installed);
+    CHECK(f.Info(&f.oSecond).state == HookState::Failed);
+    CHECK(f.Info(&f.oThird).state == HookState::Installed);
+    CHECK(f.oSecond == Pointer(0x11000));
+    CHECK(!f.registry.IsInstalled("Dx12"));
+}
+
+TEST_CASE(FailedCommitRestoresOriginals)
+{
+    Fixture f;
+    f.backend.failCommit = true;
+
+    f.registry.Declare("Dx12", "First", &f.oFirst, f.detourFirst);
+    f.registry.Declare("Dx12", "Second", &f.oSecond, f.detourSecond);
+
+    CHECK(!f.registry.Install("Dx12"));
+    CHECK(f.Info(&f.oFirst).state == HookState::Failed);
+    CHECK(f.oFirst == Pointer(0x10000));
+    CHECK(f.oSecond == Pointer(0x11000));
+    CHECK(f.backend.patched.empty());
+}
+
+TEST_CASE(BeginFailureInstallsNothing)
+{
+    Fixture f;
+    f.backend.failBegin = true;
+
+    f.registry.Declare("Dx12", "First", &f.oFirst, f.detourFirst);
+
+    CHECK(!f.registry.Install("Dx12"));
+    CHECK(f.Info(&f.oFirst).state == HookState::Declared);
+    CHECK(!f.registry.IsInstalled("Dx12"));
+}
+
+TEST_CASE(RemoveRestoresOriginals)
+{
+    Fixture f;
+
+    f.registry.Declare("Dx12", "First", &f.oFirst, f.detourFirst);
+    f.registry.Declare("Dx12", "Second", &f.oSecond, f.detourSecond);
+    f.registry.Install("Dx12");
+    f.backend.calls.clear();
+
+    CHECK(f.registry.Remove("Dx12"));
+    CHECK((f.backend.calls == std::vector<std::string> { "begin", "detach", "detach", "commit" }));
+    CHECK(f.oFirst == Pointer(0x10000));
+    CHECK(f.oSecond == Pointer(0x11000));
+    CHECK(f.backend.patched.empty());
+    CHECK(f.Info(&f.oFirst).state == HookState::Declared);
+
+    // Declarations are kept, the group can be installed again
+    CHECK(f.registry.Install("Dx12"));
+    CHECK(f.registry.IsInstalled("Dx12"));
+
+    CHECK(f.registry.Remove("Dx12", true));
+    CHECK(f.registry.Hooks().empty());
+}
+
+TEST_CASE(RemoveAllInReverseInstallOrder)
+{
+    Fixture f;
+
+    f.registry.Declare("Dxgi", "First", &f.oFirst, f.detourFirst);
+    f.registry.Declare("Dx12", "Second", &f.oSecond, f.detourSecond);
+    f.registry.Declare("Vulkan", "Third", &f.oThird, f.detourThird);
+
+    f.registry.Install("Dx12");
+    f.registry.Install("Dxgi");
+    f.registry.Install("Vulkan");
+
+    f.backend.calls.clear();
+    f.registry.RemoveAll();
+
+    // Detached in reverse install order, one transaction
+    CHECK_EQ(f.backend.Count("begin"), 1u);
+    CHECK((f.backend.detached == std::vector<void*> { f.detourThird, f.detourFirst, f.detourSecond }));
+    CHECK(!f.registry.IsInstalled("Dx12"));
+    CHECK(!f.registry.IsInstalled("Dxgi"));
+    CHECK(!f.registry.IsInstalled("Vulkan"));
+    CHECK(f.backend.patched.empty());
+}
+
+TEST_CASE(RedeclareWhileInstalledIsIgnored)
+{
+    Fixture f;
+
+    f.registry.Declare("Dx12", "First", &f.oFirst, f.detourFirst);
+    f.registry.Install("Dx12");
+
+    auto trampoline = f.oFirst;
+    f.registry.Declare("Dx12", "First", &f.oFirst, f.detourSecond);
+
+    auto info = f.Info(&f.oFirst);
+    CHECK(info.detour == f.detourFirst);
+    CHECK(info.target == Pointer(0x10000));
+    CHECK(f.oFirst == trampoline);
+
+    // After removal the new target is taken
+    f.registry.Remove("Dx12");
+    f.oFirst = Pointer(0x11000);
+    f.registry.Declare("Dx12", "First", &f.oFirst, f.detourSecond);
+
+    info = f.Info(&f.oFirst);
+    CHECK(info.detour == f.detourSecond);
+    CHECK(info.target == Pointer(0x11000));
+}
+
+TEST_CASE(InvalidDeclarationsAreDropped)
+{
+    Fixture f;
+
+    f.registry.Declare("Dx12", "NoOriginal", nullptr, f.detourFirst);
+    f.registry.Declare("Dx12", "NoDetour", &f.oFirst, nullptr);
+
+    CHECK(f.registry.Hooks().empty());
+    CHECK(!f.registry.IsInstalled("Dx12"));
+}
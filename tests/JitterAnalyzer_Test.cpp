@@ -0,0 +1,301 @@
+#include "Test.h"
+
+#include <misc/JitterAnalyzer.h>
+
+#include <cmath>
+
+static constexpr uint32_t RenderWidth = 1280;
+static constexpr uint32_t RenderHeight = 720;
+static constexpr uint32_t DisplayWidth = 2560;
+
+// Roberts R2, the plastic number
+static constexpr double R2G = 1.32471795724474602596;
+
+struct Convention
+{
+    float signX = 1.0f;
+    float signY = 1.0f;
+    float scaleX = 1.0f;
+    float scaleY = 1.0f;
+    bool swapped = false;
+};
+
+static JitterSample HaltonSample(uint32_t index, const Convention& convention)
+{
+    auto x = JitterAnalyzer::Halton(index, convention.swapped ? 3 : 2) - 0.5f;
+    auto y = JitterAnalyzer::Halton(index, convention.swapped ? 2 : 3) - 0.5f;
+
+    return { convention.signX * x * convention.scaleX, convention.signY * y * convention.scaleY };
+}
+
+static std::vector<JitterSample> Halton(uint32_t count, uint32_t phases, uint32_t start = 1,
+                                        const Convention& convention = {})
+{
+    std::vector<JitterSample> samples;
+
+    for (uint32_t i = 0; i < count; i++)
+        samples.push_back(HaltonSample(i % phases + start, convention));
+
+    return samples;
+}
+
+static std::vector<JitterSample> R2(uint32_t count, uint32_t phases, float signY = 1.0f)
+{
+    std::vector<JitterSample> samples;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        auto n = phases > 0 ? i % phases : i;
+        auto x = std::fmod(0.5 + n / R2G, 1.0) - 0.5;
+        auto y = std::fmod(0.5 + n / (R2G * R2G), 1.0) - 0.5;
+
+        samples.push_back({ static_cast<float>(x), signY * static_cast<float>(y) });
+    }
+
+    return samples;
+}
+
+static JitterReport Analyze(const std::vector<JitterSample>& samples)
+{
+    return JitterAnalyzer::Analyze(samples, RenderWidth, RenderHeight, DisplayWidth);
+}
+
+TEST_CASE(HaltonInPixels)
+{
+    auto report = Analyze(Halton(256, 32));
+
+    CHECK(report.sequence == JitterSequence::Halton);
+    CHECK(report.unit == JitterUnit::Pixels);
+    CHECK_EQ(report.period, 32u);
+    CHECK_EQ(report.haltonStart, 1u);
+    CHECK_EQ(report.restarts, 0u);
+    CHECK(!report.stalled);
+    CHECK(report.IsConfident());
+
+    // 8 * 2^2 for a 2x upscale
+    CHECK_EQ(report.expectedPhases, 32u);
+}
+
+TEST_CASE(HaltonFromZero)
+{
+    auto report = Analyze(Halton(256, 16, 0));
+
+    CHECK(report.sequence == JitterSequence::Halton);
+    CHECK_EQ(report.period, 16u);
+    CHECK_EQ(report.haltonStart, 0u);
+}
+
+TEST_CASE(NegatedAxis)
+{
+    auto report = Analyze(Halton(256, 8, 1, { -1.0f, 1.0f }));
+
+    CHECK(report.sequence == JitterSequence::Halton);
+    CHECK_EQ(report.signX, -1);
+    CHECK_EQ(report.signY, 1);
+    CHECK_EQ(report.period, 8u);
+}
+
+TEST_CASE(SwappedBases)
+{
+    Convention swapped {};
+    swapped.swapped = true;
+
+    auto report = Analyze(Halton(256, 12, 1, swapped));
+
+    CHECK(report.sequence == JitterSequence::Halton);
+    CHECK(report.swappedAxes);
+    CHECK_EQ(report.period, 12u);
+}
+
+TEST_CASE(UvAndNdcUnits)
+{
+    auto uv = Analyze(Halton(256, 16, 1, { 1.0f, 1.0f, 1.0f / RenderWidth, 1.0f / RenderHeight }));
+
+    CHECK(uv.sequence == JitterSequence::Halton);
+    CHECK(uv.unit == JitterUnit::Uv);
+    CHECK_EQ(uv.scaleX, static_cast<float>(RenderWidth));
+    CHECK_EQ(uv.scaleY, static_cast<float>(RenderHeight));
+
+    auto ndc = Analyze(Halton(256, 16, 1, { 1.0f, 1.0f, 2.0f / RenderWidth, 2.0f / RenderHeight }));
+
+    CHECK(ndc.sequence == JitterSequence::Halton);
+    CHECK(ndc.unit == JitterUnit::Ndc);
+    CHECK_EQ(ndc.scaleX, RenderWidth * 0.5f);
+    CHECK_EQ(ndc.scaleY, RenderHeight * 0.5f);
+}
+
+TEST_CASE(OutputPixelsAreRescaled)
+{
+    auto report = Analyze(Halton(256, 16, 1, { 1.0f, 1.0f, 2.0f, 2.0f }));
+
+    CHECK(report.sequence == JitterSequence::Halton);
+    CHECK(report.unit == JitterUnit::OutOfRange);
+    CHECK_EQ(report.scaleX, 0.5f);
+    CHECK(report.IsConfident());
+}
+
+TEST_CASE(RestartsAreCounted)
+{
+    std::vector<JitterSample> samples;
+    uint32_t index = 1;
+
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        // Game resets the sequence on a camera cut, mid cycle
+        if (i == 40 || i == 150)
+            index = 1;
+
+        samples.push_back(HaltonSample(index, {}));
+        index = index == 16 ? 1 : index + 1;
+    }
+
+    auto report = Analyze(samples);
+
+    CHECK(report.sequence == JitterSequence::Halton);
+    CHECK_EQ(report.period, 16u);
+    CHECK_EQ(report.restarts, 2u);
+    CHECK_EQ(report.lastRestart, 150);
+}
+
+TEST_CASE(StallIsDetected)
+{
+    auto samples = Halton(100, 8);
+
+    for (int i = 0; i < 5; i++)
+        samples.push_back(samples.back());
+
+    auto report = Analyze(samples);
+
+    CHECK(report.sequence == JitterSequence::Halton);
+    CHECK_EQ(report.stalledFrames, 5u);
+    CHECK(report.stalled);
+}
+
+TEST_CASE(R2Sequence)
+{
+    auto report = Analyze(R2(256, 0, -1.0f));
+
+    CHECK(report.sequence == JitterSequence::R2);
+    CHECK(report.unit == JitterUnit::Pixels);
+    CHECK_EQ(report.signX, 1);
+    CHECK_EQ(report.signY, -1);
+    CHECK_EQ(report.period, 0u);
+    CHECK_EQ(report.restarts, 0u);
+    CHECK(report.IsConfident());
+}
+
+TEST_CASE(R2WrapsIsNotRestart)
+{
+    auto report = Analyze(R2(256, 24));
+
+    CHECK(report.sequence == JitterSequence::R2);
+    CHECK_EQ(report.period, 24u);
+    CHECK_EQ(report.restarts, 0u);
+}
+
+TEST_CASE(BrokenSequenceIsNotTrusted)
+{
+    std::vector<JitterSample> samples;
+    uint32_t state = 1;
+
+    auto next = [&state]()
+    {
+        state = state * 1103515245u + 12345u;
+        return ((state >> 8) & 0xffff) / 65536.0f - 0.5f;
+    };
+
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        auto x = next();
+        samples.push_back({ x, next() });
+    }
+
+    auto report = Analyze(samples);
+
+    CHECK(report.sequence != JitterSequence::Halton);
+    CHECK(report.sequence != JitterSequence::R2);
+    CHECK(!report.IsConfident());
+}
+
+TEST_CASE(ZeroJitter)
+{
+    std::vector<JitterSample> samples(64);
+    auto report = Analyze(samples);
+
+    CHECK(report.sequence == JitterSequence::None);
+    CHECK(!report.IsConfident());
+}
+
+TEST_CASE(TooFewSamples)
+{
+    auto report = Analyze(Halton(JitterAnalyzer::MinSamples - 1, 32));
+
+    CHECK(report.sequence == JitterSequence::Unknown);
+}
+
+TEST_CASE(TrackerAnalyzesOnInterval)
+{
+    JitterTracker tracker;
+    uint32_t analyzed = 0;
+
+    for (const auto& sample : Halton(300, 32))
+        analyzed += tracker.Add(sample.x, sample.y, RenderWidth, RenderHeight, DisplayWidth) ? 1 : 0;
+
+    // First one at 32 samples, then every 64
+    CHECK_EQ(analyzed, 5u);
+    CHECK(tracker.Report().sequence == JitterSequence::Halton);
+    CHECK_EQ(tracker.Report().period, 32u);
+    CHECK_EQ(tracker.Samples().size(), static_cast<size_t>(JitterTracker::HistorySize));
+
+    tracker.Reset();
+
+    CHECK(tracker.Samples().empty());
+    CHECK(tracker.Report().sequence == JitterSequence::Unknown);
+}
+
+TEST_CASE(CorrectOnlyKnownUnits)
+{
+    JitterTracker uv;
+
+    for (const auto& sample : Halton(64, 16, 1, { 1.0f, 1.0f, 1.0f / RenderWidth, 1.0f / RenderHeight }))
+        uv.Add(sample.x, sample.y, RenderWidth, RenderHeight, DisplayWidth);
+
+    auto corrected = uv.Correct(0.25f / RenderWidth, -0.125f / RenderHeight);
+
+    CHECK(std::abs(corrected.x - 0.25f) < 1e-5f);
+    CHECK(std::abs(corrected.y + 0.125f) < 1e-5f);
+
+    // Pixels are left alone
+    JitterTracker pixels;
+
+    for (const auto& sample : Halton(64, 16))
+        pixels.Add(sample.x, sample.y, RenderWidth, RenderHeight, DisplayWidth);
+
+    corrected = pixels.Correct(0.25f, -0.125f);
+    CHECK_EQ(corrected.x, 0.25f);
+    CHECK_EQ(corrected.y, -0.125f);
+
+    // So is a sequence which isn't recognized
+    JitterTracker empty;
+
+    corrected = empty.Correct(0.25f, -0.125f);
+    CHECK_EQ(corrected.x, 0.25f);
+}
+
+TEST_CASE(SameConventionIgnoresCounters)
+{
+    auto report = Analyze(Halton(256, 16));
+    auto other = report;
+
+    other.samples++;
+    other.stalledFrames = 3;
+    other.restarts = 1;
+    CHECK(report.SameConvention(other));
+
+    other.signX = -1;
+    CHECK(!report.SameConvention(other));
+
+    other = report;
+    other.period = 32;
+    CHECK(!report.SameConvention(other));
+}
@@ -0,0 +1,130 @@
+#include "Bench.h"
+#include "Test.h"
+
+#include <misc/ModuleRanges.h>
+
+#if defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+// spdlog levels
+static constexpr int LevelDebug = 1;
+static constexpr int LevelInfo = 2;
+
+// Stand-in for the spdlog logger, the level is checked inside the call after the arguments were evaluated
+class MockLogger
+{
+    std::atomic<int> _level = LevelInfo;
+
+  public:
+    uint64_t written = 0;
+
+    void SetLevel(int level) { _level.store(level); }
+
+    BENCH_NOINLINE void Log(int level, const char* msg, const std::string& argument)
+    {
+        if (level < _level.load(std::memory_order_relaxed))
+            return;
+
+        written += std::strlen(msg) + argument.size();
+    }
+};
+
+static MockLogger logger;
+static uint64_t lookups = 0;
+
+// Util::WhoIsTheCaller with the module map, a binary search and a string copy of the name
+static std::string WhoIsTheCaller(const ModuleRanges& modules, uintptr_t returnAddress)
+{
+    lookups++;
+
+    if (auto range = modules.Find(returnAddress); range != nullptr)
+        return std::string(range->name);
+
+    return "";
+}
+
+// Module layout of a game with the usual overlays and drivers loaded
+static ModuleRanges Modules()
+{
+    static const char* Paths[] = { "D:\\Games\\Game\\Game.exe",
+                                   "D:\\Games\\Game\\sl.interposer.dll",
+                                   "C:\\Windows\\System32\\d3d12.dll",
+                                   "C:\\Windows\\System32\\D3D12Core.dll",
+                                   "C:\\Windows\\System32\\dxgi.dll",
+                                   "C:\\Windows\\System32\\DriverStore\\FileRepository\\nv_dispi.inf\\nvwgf2umx.dll",
+                                   "C:\\Program Files (x86)\\Steam\\GameOverlayRenderer64.dll",
+                                   "C:\\Windows\\System32\\kernel32.dll" };
+
+    ModuleRanges modules;
+    uintptr_t base = 0x7ff800000000;
+
+    for (auto path : Paths)
+    {
+        modules.Add(ModuleRanges::Make(base, 0x400000, path));
+        base += 0x1000000;
+    }
+
+    return modules;
+}
+
+static double RunGated(const ModuleRanges& modules, uint64_t count)
+{
+    BenchTimer timer;
+
+    for (uint64_t i = 0; i < count; i++)
+    {
+        auto returnAddress = 0x7ff800000000 + (i % 8) * 0x1000000 + 0x1234;
+
+        // LOG_AT of pch.h with LOG_CATEGORY ResTrack
+        if (LogGate::Enabled(LogCategory::ResTrack, LevelDebug))
+            logger.Log(LevelDebug, "Caller: {}", WhoIsTheCaller(modules, returnAddress));
+    }
+
+    return timer.Seconds();
+}
+
+// spdlog::debug as the call sites used it before the gate
+static double RunDirect(const ModuleRanges& modules, uint64_t count)
+{
+    BenchTimer timer;
+
+    for (uint64_t i = 0; i < count; i++)
+    {
+        auto returnAddress = 0x7ff800000000 + (i % 8) * 0x1000000 + 0x1234;
+        logger.Log(LevelDebug, "Caller: {}", WhoIsTheCaller(modules, returnAddress));
+    }
+
+    return timer.Seconds();
+}
+
+TEST_CASE(DisabledDebugLog)
+{
+    auto modules = Modules();
+    uint64_t count = 2000000ull * BenchScale();
+
+    // Default levels are info, debug is off for every category
+    CHECK(!LogGate::Enabled(LogCategory::ResTrack, LevelDebug));
+    CHECK(LogGate::Enabled(LogCategory::ResTrack, LevelInfo));
+
+    lookups = 0;
+    logger.written = 0;
+    BenchReport("gated LOG_DEBUG", RunGated(modules, count), count);
+
+    // Arguments aren't evaluated for a disabled call site
+    CHECK_EQ(lookups, 0u);
+    CHECK_EQ(logger.written, 0u);
+
+    BenchReport("direct spdlog::debug", RunDirect(modules, count), count);
+
+    CHECK_EQ(lookups, count);
+    CHECK_EQ(logger.written, 0u);
+
+    // Written once the logger lets it through
+    logger.SetLevel(LevelDebug);
+    RunDirect(modules, 8);
+    CHECK(logger.written > 0);
+    logger.SetLevel(LevelInfo);
+}
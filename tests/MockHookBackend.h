@@ -0,0 +1,155 @@
+#pragma once
+
+#include <hooks/HookRegistry.h>
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+// Hook backend over a fake address space. Attaches are applied on commit like Detours does,
+// the original pointer gets a trampoline address then. Every call is recorded.
+class MockHookBackend final : public IHookBackend
+{
+    struct Pending
+    {
+        void** original;
+        void* detour;
+        bool attach;
+    };
+
+    std::vector<Pending> _pending;
+    bool _inTransaction = false;
+    uintptr_t _nextTrampoline = 0x7f0000;
+
+  public:
+    // Code at fake addresses, reads outside of them fail
+    std::map<uintptr_t, std::vector<uint8_t>> code;
+    std::map<uintptr_t, std::string> modules; // Start address of each module
+
+    // Target of the hook -> detour, what the patched code jumps to
+    std::map<void*, void*> patched;
+    std::map<void*, void*> trampolines; // Trampoline -> target
+
+    std::vector<std::string> calls;
+    std::vector<void*> detached; // Detours in detach order
+
+    // Failure injection
+    void* failAttach = nullptr; // Detour which fails to attach
+    bool failBegin = false;
+    bool failCommit = false;
+
+    bool Begin() override
+    {
+        calls.push_back("begin");
+
+        if (failBegin || _inTransaction)
+            return false;
+
+        _inTransaction = true;
+        return true;
+    }
+
+    bool Attach(void** original, void* detour) override
+    {
+        calls.push_back("attach");
+
+        if (!_inTransaction || detour == failAttach)
+            return false;
+
+        _pending.push_back({ original, detour, true });
+        return true;
+    }
+
+    bool Detach(void** original, void* detour) override
+    {
+        calls.push_back("detach");
+
+        if (!_inTransaction)
+            return false;
+
+        detached.push_back(detour);
+
+        _pending.push_back({ original, detour, false });
+        return true;
+    }
+
+    bool Commit() override
+    {
+        calls.push_back("commit");
+
+        if (!_inTransaction)
+            return false;
+
+        _inTransaction = false;
+
+        if (failCommit)
+        {
+            _pending.clear();
+            return false;
+        }
+
+        for (auto& pending : _pending)
+        {
+            if (pending.attach)
+            {
+                auto target = *pending.original;
+                auto trampoline = reinterpret_cast<void*>(_nextTrampoline += 0x40);
+
+                patched[target] = pending.detour;
+                trampolines[trampoline] = target;
+                *pending.original = trampoline;
+            }
+            else
+            {
+                auto it = trampolines.find(*pending.original);
+
+                if (it == trampolines.end())
+                    continue;
+
+                patched.erase(it->second);
+                *pending.original = it->second;
+                trampolines.erase(it);
+            }
+        }
+
+        _pending.clear();
+        return true;
+    }
+
+    void Abort() override
+    {
+        calls.push_back("abort");
+        _inTransaction = false;
+        _pending.clear();
+    }
+
+    bool ReadCode(const void* address, uint8_t* bytes, size_t count) override
+    {
+        auto start = reinterpret_cast<uintptr_t>(address);
+
+        for (auto& [base, data] : code)
+        {
+            if (start >= base && start + count <= base + data.size())
+            {
+                std::memcpy(bytes, data.data() + (start - base), count);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    std::string ModuleName(const void* address) override
+    {
+        auto start = reinterpret_cast<uintptr_t>(address);
+        auto it = modules.upper_bound(start);
+
+        if (it == modules.begin())
+            return {};
+
+        return std::prev(it)->second;
+    }
+
+    size_t Count(const char* call) const { return std::count(calls.begin(), calls.end(), call); }
+};
@@ -0,0 +1,211 @@
+#include "Test.h"
+
+#include <misc/ModuleRanges.h>
+
+#include <random>
+
+static ModuleRange Range(uintptr_t base, size_t size, const char* path, uint32_t categories = 0)
+{
+    return ModuleRanges::Make(base, size, path, categories);
+}
+
+// Game exe, a gap, then a few DLLs packed against each other like the loader does
+static ModuleRanges GameLayout()
+{
+    ModuleRanges ranges;
+    ranges.Add(Range(0x7ff800000000, 0x200000, "C:\\Windows\\System32\\KERNEL32.DLL"));
+    ranges.Add(Range(0x140000000, 0x4000000, "D:\\Games\\Game\\Game.exe"));
+    ranges.Add(Range(0x7ff800200000, 0x100000, "C:\\Windows\\System32\\ntdll.dll"));
+    ranges.Add(Range(0x7ff700000000, 0x80000, "D:\\Games\\Game\\sl.interposer.dll"));
+    return ranges;
+}
+
+static const char* NameAt(const ModuleRanges& ranges, uintptr_t address)
+{
+    auto range = ranges.Find(address);
+    return range != nullptr ? range->name : nullptr;
+}
+
+TEST_CASE(RangesAreSorted)
+{
+    auto ranges = GameLayout();
+
+    CHECK_EQ(ranges.Size(), 4u);
+
+    for (size_t i = 1; i < ranges.Size(); i++)
+        CHECK(ranges.Ranges()[i - 1].end <= ranges.Ranges()[i].base);
+}
+
+TEST_CASE(FindsBoundaries)
+{
+    auto ranges = GameLayout();
+
+    CHECK(std::string_view(NameAt(ranges, 0x140000000)) == "game.exe");
+    CHECK(std::string_view(NameAt(ranges, 0x143ffffff)) == "game.exe");
+    CHECK(NameAt(ranges, 0x144000000) == nullptr); // End is exclusive
+
+    // Touching ranges, the end of one is the base of the next
+    CHECK(std::string_view(NameAt(ranges, 0x7ff8001fffff)) == "kernel32.dll");
+    CHECK(std::string_view(NameAt(ranges, 0x7ff800200000)) == "ntdll.dll");
+
+    CHECK(NameAt(ranges, 0) == nullptr);
+    CHECK(NameAt(ranges, 0x13fffffff) == nullptr);
+    CHECK(NameAt(ranges, 0x7ff6ffffffff) == nullptr);
+    CHECK(NameAt(ranges, 0x7ff800300000) == nullptr);
+    CHECK(NameAt(ranges, UINTPTR_MAX) == nullptr);
+}
+
+TEST_CASE(EmptyRangesAreIgnored)
+{
+    ModuleRanges ranges;
+
+    CHECK(ranges.Find(0x1000) == nullptr);
+
+    ranges.Add(Range(0x1000, 0, "empty.dll"));
+    CHECK_EQ(ranges.Size(), 0u);
+}
+
+TEST_CASE(StaleOverlapsAreReplaced)
+{
+    auto ranges = GameLayout();
+
+    // Unloads of kernel32 and ntdll were missed, a new module was mapped over both
+    ranges.Add(Range(0x7ff8001f0000, 0x20000, "D:\\Games\\Game\\new.dll"));
+
+    CHECK_EQ(ranges.Size(), 3u);
+    CHECK(std::string_view(NameAt(ranges, 0x7ff800200000)) == "new.dll");
+    CHECK(NameAt(ranges, 0x7ff800000000) == nullptr);
+    CHECK(NameAt(ranges, 0x7ff800250000) == nullptr);
+
+    // Same base again
+    ranges.Add(Range(0x140000000, 0x1000, "D:\\Games\\Game\\Game2.exe"));
+
+    CHECK_EQ(ranges.Size(), 3u);
+    CHECK(std::string_view(NameAt(ranges, 0x140000000)) == "game2.exe");
+    CHECK(NameAt(ranges, 0x140001000) == nullptr);
+}
+
+TEST_CASE(TouchingRangesAreKept)
+{
+    ModuleRanges ranges;
+    ranges.Add(Range(0x10000, 0x1000, "a.dll"));
+    ranges.Add(Range(0x12000, 0x1000, "c.dll"));
+    ranges.Add(Range(0x11000, 0x1000, "b.dll"));
+
+    CHECK_EQ(ranges.Size(), 3u);
+    CHECK(std::string_view(NameAt(ranges, 0x10fff)) == "a.dll");
+    CHECK(std::string_view(NameAt(ranges, 0x11000)) == "b.dll");
+    CHECK(std::string_view(NameAt(ranges, 0x12000)) == "c.dll");
+}
+
+TEST_CASE(RemoveByBase)
+{
+    auto ranges = GameLayout();
+
+    // Only the base identifies a module
+    CHECK(!ranges.Remove(0x140001000));
+    CHECK(!ranges.Remove(0x100000000));
+    CHECK_EQ(ranges.Size(), 4u);
+
+    CHECK(ranges.Remove(0x140000000));
+    CHECK_EQ(ranges.Size(), 3u);
+    CHECK(NameAt(ranges, 0x140000000) == nullptr);
+    CHECK(!ranges.Remove(0x140000000));
+
+    CHECK(ranges.Remove(0x7ff800200000));
+    CHECK(std::string_view(NameAt(ranges, 0x7ff800000000)) == "kernel32.dll");
+}
+
+TEST_CASE(NamesAreInterned)
+{
+    auto upper = ModuleRanges::Intern("DXGI.DLL");
+    auto lower = ModuleRanges::Intern("dxgi.dll");
+
+    CHECK(upper == lower);
+    CHECK(std::string_view(upper) == "dxgi.dll");
+    CHECK(ModuleRanges::Intern("d3d12.dll") != upper);
+
+    auto a = Range(0x1000, 0x100, "C:\\Windows\\System32\\DXGI.dll");
+    auto b = Range(0x2000, 0x100, "D:\\Games\\dxgi.dll");
+    CHECK(a.name == b.name);
+}
+
+TEST_CASE(Categories)
+{
+    CHECK_EQ(Range(0, 1, "C:\\Windows\\System32\\d3d12.dll").categories, (uint32_t) ModuleCategory_System);
+    CHECK_EQ(Range(0, 1, "C:\\Windows\\SysWOW64\\d3d12.dll").categories, (uint32_t) ModuleCategory_System);
+
+    // Driver store is under System32
+    CHECK_EQ(Range(0, 1, "C:\\Windows\\System32\\DriverStore\\FileRepository\\nv.inf_amd64\\nvwgf2umx.dll")
+                 .categories,
+             (uint32_t) (ModuleCategory_System | ModuleCategory_Driver));
+
+    CHECK_EQ(Range(0, 1, "D:\\Games\\nvngx_dlss.dll").categories, (uint32_t) ModuleCategory_Driver);
+    CHECK_EQ(Range(0, 1, "D:\\Games\\amdxcffx64.dll").categories, (uint32_t) ModuleCategory_Driver);
+    CHECK_EQ(Range(0, 1, "C:\\Program Files\\RTSS\\RTSSHooks64.dll").categories, (uint32_t) ModuleCategory_Overlay);
+    CHECK_EQ(Range(0, 1, "D:/Games/sl.dlss_g.dll").categories, (uint32_t) ModuleCategory_Streamline);
+    CHECK_EQ(Range(0, 1, "D:\\Games\\Game.exe", ModuleCategory_Executable).categories,
+             (uint32_t) ModuleCategory_Executable);
+
+    // Names are compared whole
+    CHECK_EQ(Range(0, 1, "D:\\Games\\mysl.dll").categories, (uint32_t) ModuleCategory_None);
+    CHECK_EQ(Range(0, 1, "D:\\Games\\reshade64.dll.bak").categories, (uint32_t) ModuleCategory_None);
+}
+
+// Few hundred modules loaded in random order, lookups match a linear search
+TEST_CASE(RandomLayoutMatchesLinearSearch)
+{
+    std::mt19937_64 random(44);
+    std::vector<ModuleRange> expected;
+    uintptr_t base = 0x7ff000000000;
+
+    for (int i = 0; i < 400; i++)
+    {
+        base += 0x1000 * (random() % 16); // Sometimes touching
+        auto size = 0x1000 * (1 + random() % 64);
+        expected.push_back(Range(base, size, ("module" + std::to_string(i) + ".dll").c_str()));
+        base += size;
+    }
+
+    auto shuffled = expected;
+    std::shuffle(shuffled.begin(), shuffled.end(), random);
+
+    ModuleRanges ranges;
+
+    for (auto& range : shuffled)
+        ranges.Add(range);
+
+    CHECK_EQ(ranges.Size(), expected.size());
+
+    auto first = expected.front().base - 0x10000;
+    auto last = expected.back().end + 0x10000;
+    size_t mismatches = 0;
+
+    for (int i = 0; i < 20000; i++)
+    {
+        auto address = first + random() % (last - first);
+
+        const char* linear = nullptr;
+
+        for (auto& range : expected)
+        {
+            if (range.Contains(address))
+                linear = range.name;
+        }
+
+        if (NameAt(ranges, address) != linear)
+            mismatches++;
+    }
+
+    CHECK_EQ(mismatches, 0u);
+
+    // Every other module unloaded
+    for (size_t i = 0; i < expected.size(); i += 2)
+        CHECK(ranges.Remove(expected[i].base));
+
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        auto found = ranges.Find(expected[i].base);
+        CHECK((found != nullptr) == (i % 2 == 1));
+    }
+}
@@ -0,0 +1,107 @@
+#include "Test.h"
+
+#include <menu/OverlaySchedule.h>
+
+static constexpr float RefreshRate = 10.0f; // 100 ms
+
+// Visible passive overlay, a cached frame with the given content built at the given time
+static OverlaySchedule Cached(uint64_t contentHash, double nowMs)
+{
+    OverlaySchedule schedule;
+    CHECK(schedule.Next(true, false, false, contentHash, nowMs, RefreshRate) == OverlayFrame::Rebuild);
+    schedule.Stored(contentHash, nowMs);
+    return schedule;
+}
+
+TEST_CASE(FirstFrameIsBuilt)
+{
+    OverlaySchedule schedule;
+
+    CHECK(!schedule.HasFrame());
+    CHECK(schedule.Next(true, false, false, 1, 0.0, RefreshRate) == OverlayFrame::Rebuild);
+
+    // Not stored yet, still has to be built
+    CHECK(schedule.Next(true, false, false, 1, 10.0, RefreshRate) == OverlayFrame::Rebuild);
+}
+
+TEST_CASE(ReusedUntilContentChanges)
+{
+    auto schedule = Cached(1, 0.0);
+
+    CHECK(schedule.HasFrame());
+    CHECK(schedule.Next(true, false, false, 1, 10.0, RefreshRate) == OverlayFrame::Reuse);
+    CHECK(schedule.Next(true, false, false, 2, 20.0, RefreshRate) == OverlayFrame::Rebuild);
+
+    schedule.Stored(2, 20.0);
+    CHECK(schedule.Next(true, false, false, 2, 30.0, RefreshRate) == OverlayFrame::Reuse);
+}
+
+TEST_CASE(RebuiltOnRefreshInterval)
+{
+    auto schedule = Cached(1, 1000.0);
+
+    CHECK(schedule.Next(true, false, false, 1, 1099.0, RefreshRate) == OverlayFrame::Reuse);
+    CHECK(schedule.Next(true, false, false, 1, 1100.0, RefreshRate) == OverlayFrame::Rebuild);
+
+    // Interval starts again from the new build
+    schedule.Stored(1, 1100.0);
+    CHECK(schedule.Next(true, false, false, 1, 1150.0, RefreshRate) == OverlayFrame::Reuse);
+
+    // Faster rate, shorter interval
+    CHECK(schedule.Next(true, false, false, 1, 1150.0, 30.0f) == OverlayFrame::Rebuild);
+}
+
+TEST_CASE(NoRefreshRateDrawsEveryFrame)
+{
+    for (auto rate : { 0.0f, -1.0f })
+    {
+        auto schedule = Cached(1, 0.0);
+
+        CHECK(schedule.Next(true, false, false, 1, 1.0, rate) == OverlayFrame::Draw);
+        CHECK(!schedule.HasFrame());
+    }
+}
+
+TEST_CASE(InteractiveOrFadingDraws)
+{
+    auto schedule = Cached(1, 0.0);
+
+    // Menu open
+    CHECK(schedule.Next(true, true, false, 1, 1.0, RefreshRate) == OverlayFrame::Draw);
+    CHECK(!schedule.HasFrame());
+
+    // Closed again, the old frame isn't used
+    CHECK(schedule.Next(true, false, false, 1, 2.0, RefreshRate) == OverlayFrame::Rebuild);
+    schedule.Stored(1, 2.0);
+
+    // Splash fading
+    CHECK(schedule.Next(true, false, true, 1, 3.0, RefreshRate) == OverlayFrame::Draw);
+    CHECK(!schedule.HasFrame());
+}
+
+TEST_CASE(HiddenClears)
+{
+    auto schedule = Cached(1, 0.0);
+
+    CHECK(schedule.Next(false, false, false, 1, 1.0, RefreshRate) == OverlayFrame::Hidden);
+    CHECK(!schedule.HasFrame());
+
+    // Hidden wins over the menu state
+    CHECK(schedule.Next(false, true, true, 1, 2.0, RefreshRate) == OverlayFrame::Hidden);
+
+    CHECK(schedule.Next(true, false, false, 1, 3.0, RefreshRate) == OverlayFrame::Rebuild);
+}
+
+TEST_CASE(HashCoversEveryByte)
+{
+    auto seed = OverlaySchedule::HashSeed;
+
+    CHECK(OverlaySchedule::Hash(seed, 1.0f) == OverlaySchedule::Hash(seed, 1.0f));
+    CHECK(OverlaySchedule::Hash(seed, 1.0f) != OverlaySchedule::Hash(seed, 1.5f));
+    CHECK(OverlaySchedule::Hash(seed, (uint32_t) 1) != OverlaySchedule::Hash(seed, (uint32_t) 1 << 24));
+
+    // Order of the values matters
+    auto ab = OverlaySchedule::Hash(OverlaySchedule::Hash(seed, true), false);
+    auto ba = OverlaySchedule::Hash(OverlaySchedule::Hash(seed, false), true);
+    CHECK(ab != ba);
+}
@@ -0,0 +1,329 @@
+#include "Test.h"
+
+#include <misc/PeImage.h>
+
+#include <random>
+
+// Builds a small module in memory, one section holding the export table, the resource tree
+// and the version block
+class PeBuilder
+{
+    std::vector<uint8_t> _bytes;
+
+    template <typename T> void Put(size_t offset, T value)
+    {
+        if (_bytes.size() < offset + sizeof(T))
+            _bytes.resize(offset + sizeof(T));
+
+        std::memcpy(_bytes.data() + offset, &value, sizeof(T));
+    }
+
+    void PutString(size_t offset, std::string_view text)
+    {
+        for (size_t i = 0; i < text.size(); i++)
+            Put<char>(offset + i, text[i]);
+
+        Put<char>(offset + text.size(), '\0');
+    }
+
+  public:
+    static constexpr uint32_t NtOffset = 0x80;
+    static constexpr uint32_t SectionRva = 0x1000;
+    static constexpr uint32_t SectionRaw = 0x400;
+
+    static constexpr uint32_t ExportOffset = 0x000;
+    static constexpr uint32_t NamesOffset = 0x040;
+    static constexpr uint32_t StringsOffset = 0x080;
+    static constexpr uint32_t ResourceOffset = 0x200;
+    static constexpr uint32_t VersionOffset = 0x300;
+
+    bool is64Bit = true;
+    bool withVersion = true;
+    std::vector<std::string> exports { "NVSDK_NGX_D3D12_Init", "NVSDK_NGX_GetSnippetVersion" };
+    uint32_t fileMS = (3 << 16) | 7;
+    uint32_t fileLS = (20 << 16) | 1;
+
+    std::vector<uint8_t> Build()
+    {
+        _bytes.clear();
+
+        Put<uint16_t>(0, 0x5A4D);
+        Put<uint32_t>(0x3C, NtOffset);
+        Put<uint32_t>(NtOffset, 0x00004550);
+
+        // IMAGE_FILE_HEADER
+        size_t fileHeader = NtOffset + 4;
+        uint16_t optionalSize = is64Bit ? 240 : 224;
+        Put<uint16_t>(fileHeader, is64Bit ? 0x8664 : 0x14C);
+        Put<uint16_t>(fileHeader + 2, 1);
+        Put<uint16_t>(fileHeader + 16, optionalSize);
+
+        size_t optionalHeader = fileHeader + 20;
+        size_t directoryCount = optionalHeader + (is64Bit ? 108 : 92);
+        Put<uint16_t>(optionalHeader, is64Bit ? 0x20B : 0x10B);
+        Put<uint32_t>(directoryCount, 16);
+
+        // Export and resource directories
+        Put<uint32_t>(directoryCount + 4, SectionRva + ExportOffset);
+        Put<uint32_t>(directoryCount + 8, 40);
+
+        if (withVersion)
+        {
+            Put<uint32_t>(directoryCount + 4 + 2 * 8, SectionRva + ResourceOffset);
+            Put<uint32_t>(directoryCount + 8 + 2 * 8, 0x100);
+        }
+
+        size_t section = optionalHeader + optionalSize;
+        uint32_t sectionSize = 0x400;
+        Put<uint32_t>(section + 8, sectionSize);
+        Put<uint32_t>(section + 12, SectionRva);
+        Put<uint32_t>(section + 16, sectionSize);
+        Put<uint32_t>(section + 20, SectionRaw);
+
+        // IMAGE_EXPORT_DIRECTORY, NumberOfNames and AddressOfNames
+        Put<uint32_t>(SectionRaw + ExportOffset + 24, (uint32_t) exports.size());
+        Put<uint32_t>(SectionRaw + ExportOffset + 32, SectionRva + NamesOffset);
+
+        uint32_t strings = StringsOffset;
+
+        for (size_t i = 0; i < exports.size(); i++)
+        {
+            Put<uint32_t>(SectionRaw + NamesOffset + i * 4, SectionRva + strings);
+            PutString(SectionRaw + strings, exports[i]);
+            strings += (uint32_t) exports[i].size() + 1;
+        }
+
+        if (withVersion)
+            PutVersion();
+
+        _bytes.resize(SectionRaw + sectionSize);
+        return _bytes;
+    }
+
+  private:
+    // RT_VERSION -> id 1 -> language 0x409 -> data entry -> VS_VERSIONINFO
+    void PutVersion()
+    {
+        size_t root = SectionRaw + ResourceOffset;
+        auto directory = [&](size_t offset, uint32_t id, uint32_t child)
+        {
+            Put<uint16_t>(offset + 12, 0);
+            Put<uint16_t>(offset + 14, 1);
+            Put<uint32_t>(offset + 16, id);
+            Put<uint32_t>(offset + 20, child);
+        };
+
+        directory(root, 16, 0x80000000 | 0x18);
+        directory(root + 0x18, 1, 0x80000000 | 0x30);
+        directory(root + 0x30, 0x409, 0x48);
+
+        Put<uint32_t>(root + 0x48, SectionRva + VersionOffset);
+        Put<uint32_t>(root + 0x4C, 92);
+
+        std::vector<uint8_t> block = VersionBlock(fileMS, fileLS);
+
+        for (size_t i = 0; i < block.size(); i++)
+            Put<uint8_t>(SectionRaw + VersionOffset + i, block[i]);
+    }
+
+  public:
+    static std::vector<uint8_t> VersionBlock(uint32_t ms, uint32_t ls, uint16_t valueLength = 52)
+    {
+        static constexpr char16_t Key[] = u"VS_VERSION_INFO";
+
+        std::vector<uint8_t> block(92);
+        auto put16 = [&](size_t offset, uint16_t value) { std::memcpy(block.data() + offset, &value, 2); };
+        auto put32 = [&](size_t offset, uint32_t value) { std::memcpy(block.data() + offset, &value, 4); };
+
+        put16(0, (uint16_t) block.size());
+        put16(2, valueLength);
+
+        for (size_t i = 0; i < std::size(Key); i++)
+            put16(6 + i * 2, Key[i]);
+
+        // VS_FIXEDFILEINFO, product version is the file version with the build cleared
+        put32(40, 0xFEEF04BD);
+        put32(48, ms);
+        put32(52, ls);
+        put32(56, ms);
+        put32(60, ls & 0xFFFF0000);
+
+        return block;
+    }
+};
+
+TEST_CASE(Parses64Bit)
+{
+    auto info = PeImage::Parse(PeBuilder().Build());
+
+    CHECK(info.has_value());
+    CHECK(info->is64Bit);
+    CHECK_EQ(info->machine, 0x8664);
+
+    CHECK(info->fileVersion.has_value());
+    CHECK(info->fileVersion == (PeVersion { 3, 7, 20, 1 }));
+    CHECK(info->productVersion == (PeVersion { 3, 7, 20, 0 }));
+
+    CHECK_EQ(info->exports.size(), 2u);
+    CHECK(info->exports[0] == "NVSDK_NGX_D3D12_Init");
+    CHECK(info->HasExport("NVSDK_NGX_GetSnippetVersion"));
+    CHECK(!info->HasExport("NVSDK_NGX_GetSnippet"));
+}
+
+TEST_CASE(Parses32Bit)
+{
+    PeBuilder builder;
+    builder.is64Bit = false;
+
+    auto info = PeImage::Parse(builder.Build());
+
+    CHECK(info.has_value());
+    CHECK(!info->is64Bit);
+    CHECK_EQ(info->machine, 0x14C);
+    CHECK(info->fileVersion == (PeVersion { 3, 7, 20, 1 }));
+    CHECK_EQ(info->exports.size(), 2u);
+}
+
+TEST_CASE(NoVersionResource)
+{
+    PeBuilder builder;
+    builder.withVersion = false;
+    builder.exports = {};
+
+    auto info = PeImage::Parse(builder.Build());
+
+    CHECK(info.has_value());
+    CHECK(!info->fileVersion.has_value());
+    CHECK(info->exports.empty());
+}
+
+TEST_CASE(NotPeFiles)
+{
+    CHECK(!PeImage::Parse({}).has_value());
+
+    std::vector<uint8_t> text(4096, 'A');
+    CHECK(!PeImage::Parse(text).has_value());
+
+    auto bytes = PeBuilder().Build();
+    bytes[PeBuilder::NtOffset] = 'X';
+    CHECK(!PeImage::Parse(bytes).has_value());
+
+    // NT header offset past the end
+    bytes = PeBuilder().Build();
+    bytes[0x3F] = 0x7F;
+    CHECK(!PeImage::Parse(bytes).has_value());
+
+    // Unknown optional header
+    bytes = PeBuilder().Build();
+    bytes[PeBuilder::NtOffset + 24] = 0x07;
+    CHECK(!PeImage::Parse(bytes).has_value());
+}
+
+TEST_CASE(SectionOutsideTheFile)
+{
+    auto bytes = PeBuilder().Build();
+
+    // PointerToRawData of the only section
+    uint32_t rawPointer = 0x10000000;
+    std::memcpy(bytes.data() + PeBuilder::NtOffset + 24 + 240 + 20, &rawPointer, 4);
+
+    auto info = PeImage::Parse(bytes);
+
+    CHECK(info.has_value());
+    CHECK(!info->fileVersion.has_value());
+    CHECK(info->exports.empty());
+}
+
+TEST_CASE(UnterminatedExportName)
+{
+    PeBuilder builder;
+    builder.withVersion = false;
+    builder.exports = { "First", std::string(PeBuilder::SectionRaw, 'X') };
+
+    // Name runs to the end of the section and file without a terminator
+    auto bytes = builder.Build();
+    bytes.resize(PeBuilder::SectionRaw + 0x400);
+    bytes.back() = 'X';
+
+    auto info = PeImage::Parse(bytes);
+
+    CHECK(info.has_value());
+    CHECK_EQ(info->exports.size(), 1u);
+    CHECK(info->exports[0] == "First");
+}
+
+// Every length of a cut off download, nothing is read past the end and what is found is right
+TEST_CASE(TruncatedFiles)
+{
+    auto bytes = PeBuilder().Build();
+    size_t parsed = 0;
+
+    for (size_t size = 0; size < bytes.size(); size++)
+    {
+        std::vector<uint8_t> truncated(bytes.begin(), bytes.begin() + size);
+        auto info = PeImage::Parse(truncated);
+
+        if (!info.has_value())
+            continue;
+
+        parsed++;
+
+        CHECK(!info->fileVersion.has_value() || info->fileVersion == (PeVersion { 3, 7, 20, 1 }));
+        CHECK(info->exports.size() <= 2);
+    }
+
+    CHECK(parsed > 0);
+}
+
+// Random bytes flipped in the headers and the section
+TEST_CASE(CorruptedFiles)
+{
+    std::mt19937 random(48);
+    auto original = PeBuilder().Build();
+    size_t parsed = 0;
+
+    for (int i = 0; i < 20000; i++)
+    {
+        auto bytes = original;
+        auto flips = 1 + random() % 8;
+
+        for (uint32_t f = 0; f < flips; f++)
+            bytes[random() % bytes.size()] = (uint8_t) random();
+
+        if (auto info = PeImage::Parse(bytes); info.has_value())
+        {
+            parsed++;
+            CHECK(info->exports.size() <= 1 << 16);
+        }
+    }
+
+    CHECK(parsed > 0);
+}
+
+TEST_CASE(VersionInfoBlock)
+{
+    PeInfo info;
+
+    CHECK(PeImage::ParseVersionInfo(PeBuilder::VersionBlock((1 << 16) | 2, (3 << 16) | 4), info));
+    CHECK(info.fileVersion == (PeVersion { 1, 2, 3, 4 }));
+
+    // Value too short for VS_FIXEDFILEINFO
+    PeInfo shortValue;
+    CHECK(!PeImage::ParseVersionInfo(PeBuilder::VersionBlock(1, 1, 20), shortValue));
+    CHECK(!shortValue.fileVersion.has_value());
+
+    // Another key
+    auto block = PeBuilder::VersionBlock(1, 1);
+    block[6] = 'X';
+    CHECK(!PeImage::ParseVersionInfo(block, shortValue));
+
+    // Length claims more than there is
+    block = PeBuilder::VersionBlock(1, 1);
+    block.resize(60);
+    CHECK(!PeImage::ParseVersionInfo(block, shortValue));
+
+    // Bad signature
+    block = PeBuilder::VersionBlock(1, 1);
+    block[40] = 0;
+    CHECK(!PeImage::ParseVersionInfo(block, shortValue));
+}
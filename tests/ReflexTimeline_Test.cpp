@@ -0,0 +1,232 @@
+#include "Test.h"
+
+#include <hooks/Reflex_Timeline.h>
+
+#include <cmath>
+#include <memory>
+
+static constexpr uint64_t Ms = 1000000; // marker timestamps are in ns
+
+static bool Near(double a, double b) { return std::fabs(a - b) < 0.0001; }
+
+static const ReflexStageStats& Stage(const ReflexTimelineStats& stats, ReflexStage stage)
+{
+    return stats.stages[(size_t) stage];
+}
+
+// Sim, submit and present markers of a frame starting at start, sent in the order the game sends them
+static void SendFrame(ReflexTimeline& timeline, uint64_t frameId, uint64_t start, uint64_t simMs = 2)
+{
+    auto simEnd = start + simMs * Ms;
+
+    timeline.RecordMarker(frameId, ReflexMarker::SimulationStart, start);
+    timeline.RecordMarker(frameId, ReflexMarker::SimulationEnd, simEnd);
+    timeline.RecordMarker(frameId, ReflexMarker::RenderSubmitStart, simEnd + 1 * Ms);
+    timeline.RecordMarker(frameId, ReflexMarker::RenderSubmitEnd, simEnd + 4 * Ms);
+    timeline.RecordMarker(frameId, ReflexMarker::PresentStart, simEnd + 5 * Ms);
+    timeline.RecordMarker(frameId, ReflexMarker::PresentEnd, simEnd + 6 * Ms);
+}
+
+TEST_CASE(CompleteFrames)
+{
+    auto timeline = std::make_unique<ReflexTimeline>();
+
+    // Simulation takes 1..10 ms
+    for (uint64_t frame = 1; frame <= 10; frame++)
+        SendFrame(*timeline, frame, frame * 16 * Ms, frame);
+
+    auto stats = timeline->Analyze();
+    auto& sim = Stage(stats, ReflexStage::Simulation);
+
+    CHECK_EQ(stats.frames, 10u);
+    CHECK_EQ(sim.count, 10u);
+    CHECK(Near(sim.min, 1.0) && Near(sim.max, 10.0) && Near(sim.avg, 5.5));
+    CHECK(Near(sim.p50, 6.0) && Near(sim.p95, 10.0));
+
+    CHECK_EQ(Stage(stats, ReflexStage::RenderSubmit).count, 10u);
+    CHECK(Near(Stage(stats, ReflexStage::RenderSubmit).avg, 3.0));
+    CHECK(Near(Stage(stats, ReflexStage::Present).max, 1.0));
+
+    // Nothing from the driver without reports
+    CHECK_EQ(Stage(stats, ReflexStage::PcLatency).count, 0u);
+    CHECK_EQ(stats.fgFrames, 0u);
+
+    CHECK_EQ(stats.outOfOrderMarkers + stats.duplicateMarkers + stats.droppedMarkers + stats.lateFrameIds, 0u);
+
+    for (auto& record : timeline->Snapshot())
+        CHECK_EQ(record.flags, (uint32_t) ReflexFrame_None);
+}
+
+TEST_CASE(OutOfOrderMarkers)
+{
+    auto timeline = std::make_unique<ReflexTimeline>();
+
+    // Simulation end arrives after the submit started, the spans still come from the timestamps
+    timeline->RecordMarker(1, ReflexMarker::SimulationStart, 100 * Ms);
+    timeline->RecordMarker(1, ReflexMarker::RenderSubmitStart, 103 * Ms);
+    timeline->RecordMarker(1, ReflexMarker::SimulationEnd, 102 * Ms);
+    timeline->RecordMarker(1, ReflexMarker::RenderSubmitEnd, 105 * Ms);
+
+    // Present end stamped before its start, that span is unusable
+    timeline->RecordMarker(2, ReflexMarker::PresentStart, 210 * Ms);
+    timeline->RecordMarker(2, ReflexMarker::PresentEnd, 209 * Ms);
+
+    auto stats = timeline->Analyze();
+    auto frames = timeline->Snapshot();
+
+    CHECK_EQ(stats.outOfOrderMarkers, 2u);
+    CHECK_EQ(frames.size(), 2u);
+    CHECK((frames[0].flags & ReflexFrame_OutOfOrder) != 0);
+    CHECK((frames[1].flags & ReflexFrame_OutOfOrder) != 0);
+
+    CHECK_EQ(Stage(stats, ReflexStage::Simulation).count, 1u);
+    CHECK(Near(Stage(stats, ReflexStage::Simulation).avg, 2.0));
+    CHECK(Near(Stage(stats, ReflexStage::RenderSubmit).avg, 2.0));
+    CHECK_EQ(Stage(stats, ReflexStage::Present).count, 0u);
+}
+
+TEST_CASE(MissingMarkers)
+{
+    auto timeline = std::make_unique<ReflexTimeline>();
+
+    // No simulation end for frame 1, no simulation start for frame 2
+    timeline->RecordMarker(1, ReflexMarker::SimulationStart, 100 * Ms);
+    timeline->RecordMarker(1, ReflexMarker::RenderSubmitStart, 103 * Ms);
+    timeline->RecordMarker(1, ReflexMarker::RenderSubmitEnd, 106 * Ms);
+    timeline->RecordMarker(1, ReflexMarker::PresentStart, 107 * Ms);
+    timeline->RecordMarker(1, ReflexMarker::PresentEnd, 108 * Ms);
+
+    timeline->RecordMarker(2, ReflexMarker::SimulationEnd, 118 * Ms);
+    timeline->RecordMarker(2, ReflexMarker::RenderSubmitStart, 119 * Ms);
+    timeline->RecordMarker(2, ReflexMarker::RenderSubmitEnd, 121 * Ms);
+
+    SendFrame(*timeline, 3, 132 * Ms, 4);
+
+    auto stats = timeline->Analyze();
+
+    CHECK_EQ(stats.frames, 3u);
+    CHECK_EQ(Stage(stats, ReflexStage::Simulation).count, 1u);
+    CHECK(Near(Stage(stats, ReflexStage::Simulation).avg, 4.0));
+    CHECK_EQ(Stage(stats, ReflexStage::RenderSubmit).count, 3u);
+    CHECK(Near(Stage(stats, ReflexStage::RenderSubmit).min, 2.0));
+    CHECK_EQ(Stage(stats, ReflexStage::Present).count, 2u);
+
+    // Only counted once the frames leave the ring
+    CHECK_EQ(stats.droppedMarkers, 0u);
+
+    SendFrame(*timeline, 1 + ReflexTimeline::RingSize, 1000 * Ms);
+    SendFrame(*timeline, 2 + ReflexTimeline::RingSize, 1016 * Ms);
+    SendFrame(*timeline, 3 + ReflexTimeline::RingSize, 1032 * Ms);
+
+    stats = timeline->Analyze();
+    CHECK_EQ(stats.droppedMarkers, 4u);
+    CHECK_EQ(stats.frames, 3u);
+    CHECK_EQ(Stage(stats, ReflexStage::Simulation).count, 3u);
+}
+
+TEST_CASE(ReportsFillTheDriverSide)
+{
+    auto timeline = std::make_unique<ReflexTimeline>();
+
+    // Microseconds
+    ReflexLatencyReport report {};
+    report.frameId = 5;
+    report.inputSampleTime = 1000;
+    report.simStartTime = 1500;
+    report.simEndTime = 4500;
+    report.driverStartTime = 10000;
+    report.driverEndTime = 12000;
+    report.osRenderQueueStartTime = 12000;
+    report.osRenderQueueEndTime = 13000;
+    report.gpuRenderStartTime = 13000;
+    report.gpuRenderEndTime = 41000;
+    timeline->RecordReport(report);
+
+    // Simulation start is used without an input sample, markers win over the report
+    report.frameId = 6;
+    report.inputSampleTime = 0;
+    timeline->RecordReport(report);
+    SendFrame(*timeline, 6, 50 * Ms, 7);
+
+    auto stats = timeline->Analyze();
+    auto& latency = Stage(stats, ReflexStage::PcLatency);
+
+    CHECK_EQ(latency.count, 2u);
+    CHECK(Near(latency.min, 39.5) && Near(latency.max, 40.0));
+    CHECK(Near(Stage(stats, ReflexStage::Driver).avg, 2.0));
+    CHECK(Near(Stage(stats, ReflexStage::OsRenderQueue).avg, 1.0));
+    CHECK(Near(Stage(stats, ReflexStage::GpuRender).avg, 28.0));
+    CHECK(Near(Stage(stats, ReflexStage::Simulation).min, 3.0));
+    CHECK(Near(Stage(stats, ReflexStage::Simulation).max, 7.0));
+
+    // Reports without markers never count as dropped markers
+    CHECK_EQ(stats.droppedMarkers, 0u);
+
+    // Other driver time units
+    timeline->SetReportUnitsPerMs(1000000.0);
+    stats = timeline->Analyze();
+    CHECK(Near(Stage(stats, ReflexStage::Driver).avg, 0.002));
+}
+
+TEST_CASE(DuplicateAndLateFrames)
+{
+    auto timeline = std::make_unique<ReflexTimeline>();
+
+    SendFrame(*timeline, 10, 100 * Ms);
+
+    // Second start is ignored, the first timestamp stays
+    timeline->RecordMarker(10, ReflexMarker::SimulationStart, 101 * Ms);
+
+    // Older frame id after a newer one still gets its own record
+    SendFrame(*timeline, 8, 90 * Ms);
+
+    auto frames = timeline->Snapshot();
+    CHECK_EQ(frames.size(), 2u);
+    CHECK_EQ(frames[0].frameId, 8u);
+    CHECK((frames[0].flags & ReflexFrame_LateFrameId) != 0);
+    CHECK((frames[1].flags & ReflexFrame_DuplicateMarker) != 0);
+    CHECK_EQ(frames[1].markers[(size_t) ReflexMarker::SimulationStart], 100 * Ms);
+
+    // A frame a ring later takes the slot of frame 10, frame 9 is too old to get one
+    timeline->RecordMarker(10 + ReflexTimeline::RingSize, ReflexMarker::SimulationStart, 200 * Ms);
+    timeline->RecordMarker(9, ReflexMarker::SimulationStart, 95 * Ms);
+
+    auto stats = timeline->Analyze();
+    frames = timeline->Snapshot();
+
+    CHECK_EQ(stats.duplicateMarkers, 1u);
+    CHECK_EQ(stats.lateFrameIds, 2u);
+    CHECK_EQ(frames.size(), 2u);
+    CHECK_EQ(frames[1].frameId, 10u + ReflexTimeline::RingSize);
+
+    timeline->Reset();
+    stats = timeline->Analyze();
+    CHECK_EQ(stats.frames, 0u);
+    CHECK_EQ(stats.duplicateMarkers + stats.lateFrameIds, 0u);
+}
+
+TEST_CASE(FrameGenerationHoldback)
+{
+    auto timeline = std::make_unique<ReflexTimeline>();
+
+    // Real frame and two generated ones presented 4 ms apart
+    SendFrame(*timeline, 1, 100 * Ms);
+    for (uint64_t i = 0; i < 3; i++)
+    {
+        timeline->RecordMarker(1, ReflexMarker::OutOfBandPresentStart, (110 + i * 4) * Ms);
+        timeline->RecordMarker(1, ReflexMarker::OutOfBandPresentEnd, (111 + i * 4) * Ms);
+    }
+
+    // Single out of band present, no frame generation
+    SendFrame(*timeline, 2, 116 * Ms);
+    timeline->RecordMarker(2, ReflexMarker::OutOfBandPresentStart, 126 * Ms);
+
+    auto stats = timeline->Analyze();
+
+    CHECK_EQ(stats.fgFrames, 1u);
+    CHECK_EQ(Stage(stats, ReflexStage::FGHoldback).count, 1u);
+    CHECK(Near(Stage(stats, ReflexStage::FGHoldback).avg, 8.0));
+
+    // Repeated out of band markers aren't duplicates
+    CHECK_EQ(stats.duplicateMarkers, 0u);
+}
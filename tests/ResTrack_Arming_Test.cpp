@@ -0,0 +1,223 @@
+#include "Test.h"
+
+#include <resource_tracking/ResTrack_Arming.h>
+
+#include <thread>
+
+static constexpr uint32_t Hudfix = ResTrackHook_Submission | ResTrackHook_CopyDescriptors |
+                                   ResTrackHook_OMSetRenderTargets | ResTrackHook_SetGraphicsRootDescriptorTable |
+                                   ResTrackHook_SetComputeRootDescriptorTable | ResTrackHook_DrawInstanced |
+                                   ResTrackHook_DrawIndexedInstanced | ResTrackHook_Dispatch;
+
+static ResTrackArmingInputs FGRunning(bool hudfix = false)
+{
+    ResTrackArmingInputs inputs {};
+    inputs.fgEnabled = true;
+    inputs.fgOutputActive = true;
+    inputs.upscalerInput = true;
+    inputs.hudfix = hudfix;
+    return inputs;
+}
+
+TEST_CASE(NothingWithoutFG)
+{
+    ResTrackArmingInputs inputs {};
+    CHECK_EQ(ResTrackArming::Wanted(inputs), (uint32_t) ResTrackHook_None);
+
+    // Enabled but no output created yet
+    inputs.fgEnabled = true;
+    inputs.hudfix = true;
+    inputs.upscalerInput = true;
+    CHECK_EQ(ResTrackArming::Wanted(inputs), (uint32_t) ResTrackHook_None);
+
+    // Heaps can be followed without FG
+    inputs.alwaysTrackHeaps = true;
+    CHECK_EQ(ResTrackArming::Wanted(inputs), (uint32_t) ResTrackHook_CopyDescriptors);
+}
+
+TEST_CASE(SubmissionWhileFGRuns)
+{
+    CHECK_EQ(ResTrackArming::Wanted(FGRunning()), (uint32_t) ResTrackHook_Submission);
+
+    // Hudfix is only used by the upscaler inputs
+    auto inputs = FGRunning(true);
+    inputs.upscalerInput = false;
+    CHECK_EQ(ResTrackArming::Wanted(inputs), (uint32_t) ResTrackHook_Submission);
+
+    CHECK_EQ(ResTrackArming::Wanted(FGRunning(true)), Hudfix);
+}
+
+TEST_CASE(HudfixDisableFlags)
+{
+    auto inputs = FGRunning(true);
+    inputs.disableOM = true;
+    inputs.disableDispatch = true;
+
+    CHECK_EQ(ResTrackArming::Wanted(inputs), Hudfix & ~(ResTrackHook_OMSetRenderTargets | ResTrackHook_Dispatch));
+
+    // Draws only check what the tracking hooks recorded, nothing to check without them
+    inputs.disableSGR = true;
+    inputs.disableSCR = true;
+    CHECK_EQ(ResTrackArming::Wanted(inputs), (uint32_t) (ResTrackHook_Submission | ResTrackHook_CopyDescriptors));
+}
+
+TEST_CASE(ArmedAtOnce)
+{
+    ResTrackArming arming;
+
+    CHECK(!arming.IsArmed(ResTrackHook_CopyDescriptors));
+
+    auto plan = arming.Update(FGRunning(true));
+
+    CHECK_EQ(plan.arm, Hudfix);
+    CHECK_EQ(plan.disarm, (uint32_t) ResTrackHook_None);
+    CHECK_EQ(arming.Armed(), Hudfix);
+    CHECK(arming.IsArmed(ResTrackHook_CopyDescriptors));
+    CHECK(arming.IsArmed(ResTrackHook_Dispatch));
+
+    // Nothing to do while the inputs stay the same
+    CHECK(arming.Update(FGRunning(true)).Empty());
+}
+
+TEST_CASE(DisarmedAfterSettling)
+{
+    ResTrackArming arming;
+    arming.Update(FGRunning(true));
+
+    for (uint32_t i = 1; i < ResTrackArming::SettleFrames; i++)
+    {
+        CHECK(arming.Update(FGRunning()).Empty());
+        CHECK(arming.IsArmed(ResTrackHook_DrawInstanced));
+    }
+
+    auto plan = arming.Update(FGRunning());
+
+    CHECK_EQ(plan.disarm, Hudfix & ~ResTrackHook_Submission);
+    CHECK_EQ(arming.Armed(), (uint32_t) ResTrackHook_Submission);
+    CHECK(!arming.IsArmed(ResTrackHook_CopyDescriptors));
+}
+
+TEST_CASE(ShortPauseKeepsHooksArmed)
+{
+    ResTrackArming arming;
+    arming.Update(FGRunning(true));
+
+    // Paused for almost the settle time a few times in a row, the count starts over each time
+    for (int pause = 0; pause < 3; pause++)
+    {
+        for (uint32_t i = 1; i < ResTrackArming::SettleFrames; i++)
+            CHECK(arming.Update({}).Empty());
+
+        CHECK(arming.Update(FGRunning(true)).Empty());
+    }
+
+    CHECK_EQ(arming.Armed(), Hudfix);
+}
+
+TEST_CASE(RearmOnlyArmsTheMissing)
+{
+    ResTrackArming arming;
+    arming.Update(FGRunning(true));
+
+    for (uint32_t i = 0; i < ResTrackArming::SettleFrames; i++)
+        arming.Update(FGRunning());
+
+    auto plan = arming.Update(FGRunning(true));
+
+    CHECK_EQ(plan.arm, Hudfix & ~ResTrackHook_Submission);
+    CHECK_EQ(plan.disarm, (uint32_t) ResTrackHook_None);
+    CHECK_EQ(arming.Armed(), Hudfix);
+}
+
+TEST_CASE(ArmingWhileDisarmPending)
+{
+    ResTrackArming arming;
+    arming.Update(FGRunning(true));
+
+    // Hudfix goes away and heap tracking is turned on at the same time
+    auto inputs = FGRunning();
+    inputs.alwaysTrackHeaps = true;
+
+    for (uint32_t i = 1; i < ResTrackArming::SettleFrames; i++)
+        arming.Update(inputs);
+
+    auto plan = arming.Update(inputs);
+
+    CHECK_EQ(plan.arm, (uint32_t) ResTrackHook_None);
+    CHECK_EQ(arming.Armed(), (uint32_t) (ResTrackHook_Submission | ResTrackHook_CopyDescriptors));
+}
+
+TEST_CASE(ResetDisarmsEverything)
+{
+    ResTrackArming arming;
+    arming.Update(FGRunning(true));
+
+    for (uint32_t i = 1; i < ResTrackArming::SettleFrames; i++)
+        arming.Update({});
+
+    arming.Reset();
+
+    CHECK_EQ(arming.Armed(), (uint32_t) ResTrackHook_None);
+
+    // Settle count was dropped too, arming again starts a fresh count
+    arming.Update(FGRunning(true));
+
+    for (uint32_t i = 1; i < ResTrackArming::SettleFrames; i++)
+        CHECK(arming.Update({}).Empty());
+}
+
+// Hooks stay attached, render threads keep calling them while the present thread flips the mask.
+// Every call reaches the original exactly once, armed or not.
+TEST_CASE(HooksPassThroughWhileToggled)
+{
+    ResTrackArming arming;
+    std::atomic<bool> done = false;
+    std::atomic<uint64_t> originals = 0;
+    std::atomic<uint64_t> tracked = 0;
+
+    constexpr unsigned threadCount = 4;
+    constexpr uint64_t callsPerThread = 200000;
+
+    std::vector<std::thread> threads;
+
+    for (unsigned t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                for (uint64_t i = 0; i < callsPerThread; i++)
+                {
+                    originals.fetch_add(1, std::memory_order_relaxed);
+
+                    if (!arming.IsArmed(ResTrackHook_DrawInstanced))
+                        continue;
+
+                    tracked.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+    }
+
+    std::thread present(
+        [&]()
+        {
+            auto frame = 0u;
+
+            while (!done.load())
+            {
+                // Hudfix on for a while, then off long enough to settle
+                arming.Update(frame++ % (4 * ResTrackArming::SettleFrames) < ResTrackArming::SettleFrames
+                                  ? FGRunning(true)
+                                  : FGRunning());
+                std::this_thread::yield();
+            }
+        });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    done = true;
+    present.join();
+
+    CHECK_EQ(originals.load(), threadCount * callsPerThread);
+    CHECK(tracked.load() <= originals.load());
+}
@@ -0,0 +1,287 @@
+#include "Bench.h"
+#include "Test.h"
+
+#include <resource_tracking/ResourceLifetime_Dx12.h>
+
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+// What the tracker keeps per resource, cleaned when the resource goes away
+struct TrackedEntry
+{
+    std::vector<int> slots;
+};
+
+static std::mutex trackedMutex;
+static std::unordered_map<ID3D12Resource*, TrackedEntry> tracked;
+static std::atomic<uint64_t> cleaned = 0;
+
+static void Track(ID3D12Resource* resource)
+{
+    std::scoped_lock lock(trackedMutex);
+    tracked[resource].slots = { 1, 2, 3 };
+}
+
+// Destruction callback of the sentinel path, same work as ResTrack_Dx12::OnResourceDestroyed
+static void OnDestroyed(ID3D12Resource* resource)
+{
+    std::vector<int> slots;
+
+    {
+        std::scoped_lock lock(trackedMutex);
+        auto it = tracked.find(resource);
+
+        if (it == tracked.end())
+            return;
+
+        slots = std::move(it->second.slots);
+        tracked.erase(it);
+    }
+
+    cleaned += slots.size() > 0 ? 1 : 0;
+}
+
+// Removed ID3D12Resource::Release hook, ran before every Release in the process: global lock,
+// refcount probe, lookup and a copy of the entry when the resource was about to go
+static void ReleaseHook(ID3D12Resource* resource)
+{
+    std::scoped_lock lock(trackedMutex);
+
+    resource->AddRef();
+    auto count = resource->refCount.load() - 1;
+    resource->refCount--;
+
+    auto it = tracked.find(resource);
+
+    if (it == tracked.end() || count != 1)
+        return;
+
+    auto slots = it->second.slots;
+    tracked.erase(it);
+
+    cleaned += slots.size() > 0 ? 1 : 0;
+}
+
+struct Workload
+{
+    unsigned threads;
+    unsigned resources;         // Created and destroyed per thread
+    unsigned releasesPerObject; // AddRef / Release pairs during its life, views, barriers, residency
+    unsigned trackedPercent;
+
+    unsigned long long Releases() const { return 1ull * threads * resources * (releasesPerObject + 1); }
+    unsigned long long Tracked() const { return 1ull * threads * (resources * trackedPercent / 100); }
+};
+
+static double Run(const Workload& workload, bool hooked)
+{
+    BenchTimer timer;
+    std::vector<std::thread> threads;
+
+    for (unsigned t = 0; t < workload.threads; t++)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                auto trackedCount = workload.resources * workload.trackedPercent / 100;
+
+                for (unsigned i = 0; i < workload.resources; i++)
+                {
+                    auto resource = new ID3D12Resource();
+
+                    // Tracked ones spread evenly over the run
+                    if (trackedCount > 0 && i % (workload.resources / trackedCount) == 0 &&
+                        i / (workload.resources / trackedCount) < trackedCount)
+                    {
+                        Track(resource);
+
+                        if (!hooked)
+                            ResourceLifetime_Dx12::Watch(resource);
+                    }
+
+                    for (unsigned r = 0; r < workload.releasesPerObject; r++)
+                    {
+                        resource->AddRef();
+
+                        if (hooked)
+                            ReleaseHook(resource);
+
+                        resource->Release();
+                    }
+
+                    if (hooked)
+                        ReleaseHook(resource);
+
+                    resource->Release();
+                }
+            });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    return timer.Seconds();
+}
+
+static void Compare(const Workload& workload)
+{
+    std::printf("%u threads, %u%% tracked\n", workload.threads, workload.trackedPercent);
+
+    auto before = ResourceLifetime_Dx12::WatchedCount();
+
+    cleaned = 0;
+    ResourceLifetime_Dx12::SetCallback(OnDestroyed);
+    BenchReport("sentinel", Run(workload, false), workload.Releases());
+    ResourceLifetime_Dx12::SetCallback(nullptr);
+
+    CHECK_EQ(cleaned.load(), workload.Tracked());
+    CHECK_EQ(ResourceLifetime_Dx12::WatchedCount(), before);
+    CHECK(tracked.empty());
+
+    cleaned = 0;
+    BenchReport("release hook", Run(workload, true), workload.Releases());
+
+    CHECK_EQ(cleaned.load(), workload.Tracked());
+    CHECK(tracked.empty());
+}
+
+TEST_CASE(ReleaseMixes)
+{
+    auto scale = BenchScale();
+
+    for (unsigned threads : { 1u, 4u })
+    {
+        for (unsigned percent : { 0u, 1u, 10u, 50u })
+            Compare({ threads, 2000 * scale, 16, percent });
+    }
+}
+
+TEST_CASE(QueuedDestructionIsDrained)
+{
+    std::vector<ID3D12Resource*> resources;
+
+    for (int i = 0; i < 8; i++)
+    {
+        resources.push_back(new ID3D12Resource());
+        ResourceLifetime_Dx12::Watch(resources.back(), i % 2 == 0);
+    }
+
+    // Watching again only upgrades to queued, it doesn't replace the sentinel
+    ResourceLifetime_Dx12::Watch(resources[1], true);
+
+    std::vector<ID3D12Resource*> expected = { resources[0], resources[1], resources[2], resources[4],
+                                              resources[6] };
+
+    for (auto resource : resources)
+        resource->Release();
+
+    std::vector<ID3D12Resource*> drained;
+    ResourceLifetime_Dx12::DrainDestroyed([&drained](ID3D12Resource* resource, uint64_t)
+                                          { drained.push_back(resource); });
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(drained.begin(), drained.end());
+
+    CHECK(drained == expected);
+
+    // Taken as a whole, nothing is left for the next drain
+    size_t again = 0;
+    ResourceLifetime_Dx12::DrainDestroyed([&again](ID3D12Resource*, uint64_t) { again++; });
+
+    CHECK_EQ(again, 0u);
+}
+
+TEST_CASE(ConcurrentQueuedDestruction)
+{
+    constexpr unsigned threadCount = 4;
+    constexpr unsigned perThread = 500;
+
+    std::atomic<size_t> drained = 0;
+    std::atomic<bool> done = false;
+
+    // Drained on one thread while the others destroy
+    std::thread drainer(
+        [&]()
+        {
+            while (!done.load())
+                ResourceLifetime_Dx12::DrainDestroyed([&drained](ID3D12Resource*, uint64_t) { drained++; });
+
+            ResourceLifetime_Dx12::DrainDestroyed([&drained](ID3D12Resource*, uint64_t) { drained++; });
+        });
+
+    std::vector<std::thread> threads;
+
+    for (unsigned t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back(
+            []()
+            {
+                for (unsigned i = 0; i < perThread; i++)
+                {
+                    auto resource = new ID3D12Resource();
+                    ResourceLifetime_Dx12::Watch(resource, true);
+                    resource->Release();
+                }
+            });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    done = true;
+    drainer.join();
+
+    CHECK_EQ(drained.load(), static_cast<size_t>(threadCount * perThread));
+}
+
+// Hudfix keeps its captured list keyed by address, entries are tagged with the id and only dropped when it matches
+TEST_CASE(DrainedWithTheWatchId)
+{
+    auto first = new ID3D12Resource();
+    auto second = new ID3D12Resource();
+
+    auto firstId = ResourceLifetime_Dx12::Watch(first, true);
+    auto secondId = ResourceLifetime_Dx12::Watch(second);
+
+    CHECK(firstId != 0 && secondId != 0 && firstId != secondId);
+    CHECK_EQ(ResourceLifetime_Dx12::Watch(nullptr), 0u);
+
+    // Same sentinel, same id
+    CHECK_EQ(ResourceLifetime_Dx12::Watch(second, true), secondId);
+
+    std::unordered_map<ID3D12Resource*, uint64_t> captured { { first, firstId }, { second, secondId } };
+    const auto drain = [&captured]()
+    {
+        ResourceLifetime_Dx12::DrainDestroyed(
+            [&captured](ID3D12Resource* resource, uint64_t watchId)
+            {
+                if (auto it = captured.find(resource); it != captured.end() && it->second == watchId)
+                    captured.erase(it);
+            });
+    };
+
+    first->Release();
+
+    // List was cleared and a new resource at the freed address was captured before the drain.
+    // The allocator doesn't have to hand out the same address, the entry is put under the old key.
+    auto reused = new ID3D12Resource();
+    auto reusedId = ResourceLifetime_Dx12::Watch(reused, true);
+    CHECK(reusedId != firstId);
+
+    captured[first] = reusedId;
+
+    drain();
+    CHECK(captured.contains(first));
+    CHECK(captured.contains(second));
+
+    // Entry made for the new resource goes when that one is destroyed
+    captured.erase(first);
+    captured[reused] = reusedId;
+
+    second->Release();
+    reused->Release();
+
+    drain();
+    CHECK(captured.empty());
+}
@@ -0,0 +1,193 @@
+#include "Test.h"
+
+#include <misc/StagePipeline.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+// Stages write their names into the context so the run order can be checked
+struct MockContext
+{
+    std::vector<std::string> ran;
+};
+
+using Pipeline = StagePipeline<MockContext>;
+
+static Pipeline::StageFunction Mock(const char* name)
+{
+    return [name](MockContext& context) { context.ran.push_back(name); };
+}
+
+static std::vector<std::string> RunOnce(Pipeline& pipeline)
+{
+    MockContext context;
+    pipeline.Run(context);
+    return context.ran;
+}
+
+TEST_CASE(RunsInOrder)
+{
+    Pipeline pipeline;
+    CHECK(pipeline.Empty());
+
+    pipeline.AddStage("First", nullptr, Mock("First"));
+    pipeline.AddStage("Second", nullptr, Mock("Second"));
+    pipeline.AddStage("Third", nullptr, Mock("Third"));
+    CHECK_EQ(pipeline.StageCount(), 3u);
+
+    CHECK(RunOnce(pipeline) == std::vector<std::string>({ "First", "Second", "Third" }));
+
+    auto timings = pipeline.Timings();
+    CHECK_EQ(timings.size(), 3u);
+    CHECK(std::string(timings[0].name) == "First" && std::string(timings[2].name) == "Third");
+
+    for (auto& timing : timings)
+        CHECK(timing.enabled && timing.calls == 1);
+}
+
+TEST_CASE(PredicatesFollowStateKey)
+{
+    Pipeline pipeline;
+    bool enabled = true;
+    uint64_t key = 1;
+    uint32_t evaluations = 0;
+
+    pipeline.SetStateKey([&key]() { return key; });
+    pipeline.AddStage("Always", nullptr, Mock("Always"));
+    pipeline.AddStage("Optional",
+                      [&]()
+                      {
+                          evaluations++;
+                          return enabled;
+                      },
+                      Mock("Optional"));
+
+    CHECK_EQ(RunOnce(pipeline).size(), 2u);
+    CHECK_EQ(RunOnce(pipeline).size(), 2u);
+    CHECK_EQ(evaluations, 1u);
+
+    // Not seen until the key changes
+    enabled = false;
+    CHECK_EQ(RunOnce(pipeline).size(), 2u);
+
+    key = 2;
+    CHECK(RunOnce(pipeline) == std::vector<std::string>({ "Always" }));
+    CHECK_EQ(evaluations, 2u);
+
+    // Skipped stages show up disabled and aren't timed
+    auto timings = pipeline.Timings();
+    CHECK(!timings[1].enabled);
+    CHECK_EQ(timings[1].calls, 3u);
+    CHECK_EQ(timings[0].calls, 4u);
+
+    // Invalidate without a key change
+    enabled = true;
+    RunOnce(pipeline);
+    CHECK_EQ(evaluations, 2u);
+
+    pipeline.Invalidate();
+    CHECK_EQ(RunOnce(pipeline).size(), 2u);
+    CHECK_EQ(evaluations, 3u);
+    CHECK(pipeline.Timings()[1].enabled);
+
+    // Adding a stage re-evaluates too
+    pipeline.AddStage("Late", nullptr, Mock("Late"));
+    CHECK(RunOnce(pipeline) == std::vector<std::string>({ "Always", "Optional", "Late" }));
+    CHECK_EQ(evaluations, 4u);
+}
+
+TEST_CASE(TimingWindows)
+{
+    StageTimer timer;
+
+    // First window publishes every call
+    timer.Add(1.0);
+    CHECK(timer.Timing().avgMs == 1.0 && timer.Timing().maxMs == 1.0);
+    timer.Add(3.0);
+    CHECK(timer.Timing().avgMs == 2.0 && timer.Timing().maxMs == 3.0);
+
+    for (uint32_t i = 2; i < StageTimer::WindowSize; i++)
+        timer.Add(2.0);
+
+    CHECK_EQ(timer.Timing().calls, (uint64_t) StageTimer::WindowSize);
+    CHECK(timer.Timing().avgMs == 2.0 && timer.Timing().maxMs == 3.0);
+
+    // Later windows only publish once they are full
+    timer.Add(8.0);
+    CHECK(timer.Timing().lastMs == 8.0);
+    CHECK(timer.Timing().avgMs == 2.0 && timer.Timing().maxMs == 3.0);
+
+    for (uint32_t i = 1; i < StageTimer::WindowSize; i++)
+        timer.Add(4.0);
+
+    CHECK(timer.Timing().avgMs == (8.0 + 4.0 * (StageTimer::WindowSize - 1)) / StageTimer::WindowSize);
+    CHECK(timer.Timing().maxMs == 8.0);
+
+    timer.Timing().name = "Stage";
+    timer.Reset();
+    CHECK_EQ(timer.Timing().calls, 0u);
+    CHECK(std::string(timer.Timing().name) == "Stage");
+}
+
+TEST_CASE(TimingCanBeDisabled)
+{
+    Pipeline pipeline;
+    pipeline.AddStage("Stage", nullptr, Mock("Stage"));
+
+    pipeline.SetTimingEnabled(false);
+    CHECK_EQ(RunOnce(pipeline).size(), 1u);
+    CHECK_EQ(pipeline.Timings()[0].calls, 0u);
+
+    pipeline.SetTimingEnabled(true);
+    RunOnce(pipeline);
+    RunOnce(pipeline);
+    CHECK_EQ(pipeline.Timings()[0].calls, 2u);
+    CHECK(pipeline.Timings()[0].lastMs >= 0.0);
+
+    pipeline.ResetTimings();
+    CHECK_EQ(pipeline.Timings()[0].calls, 0u);
+    CHECK(std::string(pipeline.Timings()[0].name) == "Stage");
+}
+
+// Overlay reads the timings while the present thread is still building the list
+TEST_CASE(TimingsWhileAdding)
+{
+    static const char* Names[] = { "A", "B", "C", "D" };
+    static constexpr size_t StageCount = 2000;
+
+    Pipeline pipeline;
+    std::atomic<bool> done = false;
+    uint32_t badReads = 0;
+
+    std::thread reader(
+        [&]()
+        {
+            size_t last = 0;
+
+            while (!done.load())
+            {
+                auto timings = pipeline.Timings();
+
+                if (timings.size() < last)
+                    badReads++;
+
+                for (auto& timing : timings)
+                {
+                    if (timing.name == nullptr)
+                        badReads++;
+                }
+
+                last = timings.size();
+            }
+        });
+
+    for (size_t i = 0; i < StageCount; i++)
+        pipeline.AddStage(Names[i % 4], nullptr, nullptr);
+
+    done = true;
+    reader.join();
+
+    CHECK_EQ(badReads, 0u);
+    CHECK_EQ(pipeline.Timings().size(), StageCount);
+}
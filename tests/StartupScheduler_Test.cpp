@@ -0,0 +1,225 @@
+#include "Test.h"
+
+#include <misc/StartupScheduler.h>
+
+#include <thread>
+
+using namespace std::chrono_literals;
+
+static const StartupTimelineEntry* FindEntry(const std::vector<StartupTimelineEntry>& timeline, std::string_view name)
+{
+    for (const auto& entry : timeline)
+    {
+        if (name == entry.name)
+            return &entry;
+    }
+
+    return nullptr;
+}
+
+TEST_CASE(InvalidStepsAreRejected)
+{
+    StartupScheduler startup;
+
+    CHECK(startup.Add("Config", StartupPhase::LoaderLock, {}, []() {}));
+    CHECK(startup.Add("Files", StartupPhase::Worker, { "Config" }, []() {}));
+    CHECK(startup.IsValid());
+
+    CHECK(!startup.Add("Config", StartupPhase::LoaderLock, {}, []() {}));
+    CHECK(!startup.IsValid());
+
+    StartupScheduler missing;
+    CHECK(!missing.Add("Files", StartupPhase::Worker, { "Config" }, []() {}));
+    CHECK(!missing.IsValid());
+
+    StartupScheduler wrongPhase;
+    CHECK(wrongPhase.Add("Files", StartupPhase::Worker, {}, []() {}));
+    CHECK(!wrongPhase.Add("Hooks", StartupPhase::LoaderLock, { "Files" }, []() {}));
+    CHECK(!wrongPhase.IsValid());
+}
+
+TEST_CASE(LoaderLockStepsRunInAddOrder)
+{
+    StartupScheduler startup;
+    std::vector<int> order;
+
+    startup.Add("First", StartupPhase::LoaderLock, {}, [&]() { order.push_back(1); });
+    startup.Add("Files", StartupPhase::Worker, { "First" }, [&]() { order.push_back(3); });
+    startup.Add("Second", StartupPhase::LoaderLock, { "First" }, [&]() { order.push_back(2); });
+
+    // Not reached yet, it's never run out of DllMain's order
+    CHECK(!startup.Wait("Second"));
+    CHECK(!startup.IsDone("First"));
+
+    startup.RunLoaderLockSteps();
+
+    CHECK((order == std::vector<int> { 1, 2 }));
+    CHECK(startup.IsDone("Second"));
+    CHECK(!startup.IsDone("Files"));
+
+    // Running them again is a no-op
+    startup.RunLoaderLockSteps();
+    CHECK_EQ(order.size(), (size_t) 2);
+}
+
+TEST_CASE(UnknownStepCantBeWaitedOn)
+{
+    StartupScheduler startup;
+    startup.Add("Config", StartupPhase::LoaderLock, {}, []() {});
+    startup.RunLoaderLockSteps();
+
+    CHECK(!startup.Wait("Missing"));
+    CHECK(!startup.IsDone("Missing"));
+}
+
+TEST_CASE(WaiterRunsPendingWorkerStep)
+{
+    StartupScheduler startup;
+    int runs = 0;
+
+    startup.Add("Config", StartupPhase::LoaderLock, {}, []() {});
+    startup.Add("Files", StartupPhase::Worker, { "Config" }, [&]() { runs++; });
+
+    // Dependencies aren't done, the waiter can't take it
+    CHECK(!startup.Wait("Files", 0ms));
+    CHECK_EQ(runs, 0);
+
+    startup.RunLoaderLockSteps();
+
+    CHECK(startup.Wait("Files"));
+    CHECK_EQ(runs, 1);
+
+    // The worker finds it done and skips it
+    startup.RunWorkerSteps();
+    CHECK_EQ(runs, 1);
+
+    auto timeline = startup.Timeline();
+    auto entry = FindEntry(timeline, "Files");
+
+    CHECK(entry != nullptr);
+    CHECK(entry != nullptr && entry->ranByWaiter);
+    CHECK(entry != nullptr && entry->phase == StartupPhase::Worker);
+}
+
+TEST_CASE(WaitBlocksUntilWorkerFinishes)
+{
+    StartupScheduler startup;
+    std::atomic<bool> started = false;
+    std::atomic<bool> release = false;
+    std::atomic<int> runs = 0;
+
+    // Plain field written by the step, like the DLSS paths and DLSSEnabled
+    bool dlssEnabled = false;
+
+    startup.Add("Config", StartupPhase::LoaderLock, {}, []() {});
+    startup.Add("Files", StartupPhase::Worker, { "Config" },
+                [&]()
+                {
+                    started = true;
+
+                    while (!release)
+                        std::this_thread::yield();
+
+                    dlssEnabled = true;
+                    runs++;
+                });
+
+    startup.RunLoaderLockSteps();
+
+    std::thread worker([&]() { startup.RunWorkerSteps(); });
+
+    while (!started)
+        std::this_thread::yield();
+
+    // Step is running on the worker, a short wait times out instead of running it again
+    CHECK(!startup.Wait("Files", 1ms));
+    CHECK(!startup.IsDone("Files"));
+
+    bool waited = false;
+    bool seen = false;
+
+    std::thread reader(
+        [&]()
+        {
+            waited = startup.Wait("Files", std::chrono::milliseconds::max());
+            seen = dlssEnabled;
+        });
+
+    release = true;
+
+    reader.join();
+    worker.join();
+
+    CHECK(waited);
+    CHECK(seen);
+    CHECK_EQ(runs.load(), 1);
+
+    auto timeline = startup.Timeline();
+    auto entry = FindEntry(timeline, "Files");
+
+    CHECK(entry != nullptr && !entry->ranByWaiter);
+}
+
+TEST_CASE(ConcurrentWaitersRunStepOnce)
+{
+    StartupScheduler startup;
+    std::atomic<int> runs = 0;
+
+    startup.Add("Config", StartupPhase::LoaderLock, {}, []() {});
+    startup.Add("Files", StartupPhase::Worker, { "Config" },
+                [&]()
+                {
+                    runs++;
+                    std::this_thread::sleep_for(5ms);
+                });
+    startup.Add("Hooks", StartupPhase::Worker, { "Files" }, [&]() { runs++; });
+
+    startup.RunLoaderLockSteps();
+
+    std::vector<std::thread> waiters;
+    std::atomic<int> succeeded = 0;
+
+    for (int i = 0; i < 8; i++)
+    {
+        waiters.emplace_back(
+            [&]()
+            {
+                if (startup.Wait("Files", std::chrono::milliseconds::max()))
+                    succeeded++;
+            });
+    }
+
+    std::thread worker([&]() { startup.RunWorkerSteps(); });
+
+    for (auto& waiter : waiters)
+        waiter.join();
+
+    worker.join();
+
+    CHECK_EQ(succeeded.load(), 8);
+    CHECK_EQ(runs.load(), 2);
+    CHECK(startup.IsDone("Hooks"));
+}
+
+TEST_CASE(TimelineIsOrderedByStart)
+{
+    StartupScheduler startup;
+
+    startup.Add("Config", StartupPhase::LoaderLock, {}, []() {});
+    startup.Add("Hooks", StartupPhase::LoaderLock, {}, []() { std::this_thread::sleep_for(1ms); });
+    startup.Add("Files", StartupPhase::Worker, {}, []() {});
+    startup.Add("Probe", StartupPhase::Worker, { "Files" }, []() {});
+
+    startup.RunLoaderLockSteps();
+    startup.RunWorkerSteps();
+
+    auto timeline = startup.Timeline();
+
+    CHECK_EQ(timeline.size(), (size_t) 4);
+
+    for (size_t i = 1; i < timeline.size(); i++)
+        CHECK(timeline[i - 1].startMs <= timeline[i].startMs);
+
+    auto hooks = FindEntry(timeline, "Hooks");
+    CHECK(hooks != nullptr && hooks->durationMs >= 1.0);
+}
@@ -0,0 +1,314 @@
+#include "Test.h"
+
+#include <misc/StateShadow_Dx12.h>
+
+#include <cstdarg>
+
+using Shadow = StateShadow_Dx12;
+
+static std::vector<std::string> calls;
+
+static void Record(const char* format, ...)
+{
+    char buffer[128];
+
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    calls.push_back(buffer);
+}
+
+static void SetDescriptorHeaps(ID3D12GraphicsCommandList*, UINT count, ID3D12DescriptorHeap* const* heaps)
+{
+    Record("heaps %u %zx", count, (size_t) heaps[0]);
+}
+
+static void SetPipelineState(ID3D12GraphicsCommandList*, ID3D12PipelineState* pso) { Record("pso %zx", (size_t) pso); }
+
+static void IASetPrimitiveTopology(ID3D12GraphicsCommandList*, D3D12_PRIMITIVE_TOPOLOGY topology)
+{
+    Record("topology %d", (int) topology);
+}
+
+template <int P> static void SetRootSignature(ID3D12GraphicsCommandList*, ID3D12RootSignature* signature)
+{
+    Record("signature%d %zx", P, (size_t) signature);
+}
+
+template <int P>
+static void SetRootDescriptorTable(ID3D12GraphicsCommandList*, UINT index, D3D12_GPU_DESCRIPTOR_HANDLE table)
+{
+    Record("table%d %u %llx", P, index, (unsigned long long) table.ptr);
+}
+
+template <int P>
+static void SetRoot32BitConstants(ID3D12GraphicsCommandList*, UINT index, UINT count, const void* data, UINT offset)
+{
+    auto values = (const UINT*) data;
+    std::string text;
+
+    for (UINT i = 0; i < count; i++)
+        text += (i == 0 ? "" : ",") + std::to_string(values[i]);
+
+    Record("constants%d %u @%u %s", P, index, offset, text.c_str());
+}
+
+template <int P> static void SetRootCBV(ID3D12GraphicsCommandList*, UINT index, D3D12_GPU_VIRTUAL_ADDRESS va)
+{
+    Record("cbv%d %u %llx", P, index, (unsigned long long) va);
+}
+
+template <int P> static void SetRootSRV(ID3D12GraphicsCommandList*, UINT index, D3D12_GPU_VIRTUAL_ADDRESS va)
+{
+    Record("srv%d %u %llx", P, index, (unsigned long long) va);
+}
+
+template <int P> static void SetRootUAV(ID3D12GraphicsCommandList*, UINT index, D3D12_GPU_VIRTUAL_ADDRESS va)
+{
+    Record("uav%d %u %llx", P, index, (unsigned long long) va);
+}
+
+static const StateShadowWriter writer {
+    SetDescriptorHeaps,
+    SetPipelineState,
+    IASetPrimitiveTopology,
+    { SetRootSignature<0>, SetRootSignature<1> },
+    { SetRootDescriptorTable<0>, SetRootDescriptorTable<1> },
+    { SetRoot32BitConstants<0>, SetRoot32BitConstants<1> },
+    { SetRootCBV<0>, SetRootCBV<1> },
+    { SetRootSRV<0>, SetRootSRV<1> },
+    { SetRootUAV<0>, SetRootUAV<1> },
+};
+
+static constexpr uint32_t RestoreAll = StateShadowRestore_Compute | StateShadowRestore_Graphics;
+
+static auto Heap(size_t value) { return (ID3D12DescriptorHeap*) value; }
+static auto Pso(size_t value) { return (ID3D12PipelineState*) value; }
+static auto Signature(size_t value) { return (ID3D12RootSignature*) value; }
+
+static bool Calls(std::initializer_list<const char*> expected)
+{
+    std::vector<std::string> list(expected.begin(), expected.end());
+    auto same = calls == list;
+
+    if (!same)
+    {
+        for (const auto& call : calls)
+            std::printf("  recorded: %s\n", call.c_str());
+    }
+
+    calls.clear();
+    return same;
+}
+
+// Game state of the compute pipeline used by most cases
+static void SetGameCompute(Shadow& shadow)
+{
+    auto heap = Heap(0x10);
+    UINT constants[] = { 1, 2, 3, 4 };
+
+    shadow.Reset(Pso(0x20));
+    shadow.SetDescriptorHeaps(1, &heap);
+    shadow.SetRootSignature(Shadow::Compute, Signature(0x30));
+    shadow.SetRootDescriptorTable(Shadow::Compute, 0, { 0x100 });
+    shadow.SetRoot32BitConstants(Shadow::Compute, 1, 2, constants, 0);
+    shadow.SetRoot32BitConstants(Shadow::Compute, 1, 1, constants + 3, 3);
+    shadow.SetRootView(Shadow::Compute, 2, Shadow::ArgumentType::CBV, 0x500);
+}
+
+TEST_CASE(FindDoesNotCreateShadow)
+{
+    auto before = CommandListSlots_Dx12::LiveCount();
+
+    {
+        ID3D12GraphicsCommandList list;
+
+        CHECK(Shadow::Find(&list) == nullptr);
+        CHECK_EQ(CommandListSlots_Dx12::LiveCount(), before);
+
+        auto shadow = Shadow::Get(&list);
+
+        CHECK(shadow != nullptr);
+        CHECK(Shadow::Find(&list) == shadow);
+        CHECK(Shadow::Get(&list) == shadow);
+        CHECK_EQ(CommandListSlots_Dx12::LiveCount(), before + 1);
+    }
+
+    // Released with the list
+    CHECK_EQ(CommandListSlots_Dx12::LiveCount(), before);
+}
+
+TEST_CASE(OnlyOverwrittenArgumentIsRestored)
+{
+    Shadow shadow;
+    SetGameCompute(shadow);
+
+    shadow.BeginWork();
+    shadow.SetRootView(Shadow::Compute, 2, Shadow::ArgumentType::CBV, 0x900);
+
+    CHECK_EQ(shadow.EndWork(nullptr, writer, RestoreAll), 1u);
+    CHECK(Calls({ "cbv0 2 500" }));
+}
+
+TEST_CASE(SignatureChangeRebindsEveryArgument)
+{
+    Shadow shadow;
+    SetGameCompute(shadow);
+
+    shadow.BeginWork();
+    shadow.SetRootSignature(Shadow::Compute, Signature(0x31));
+    shadow.SetRootDescriptorTable(Shadow::Compute, 0, { 0x200 });
+
+    // Constants go out as one call for each known range
+    CHECK_EQ(shadow.EndWork(nullptr, writer, RestoreAll), 5u);
+    CHECK(Calls({ "signature0 30", "table0 0 100", "constants0 1 @0 1,2", "constants0 1 @3 4", "cbv0 2 500" }));
+}
+
+TEST_CASE(SameSignatureAgainKeepsArguments)
+{
+    Shadow shadow;
+    SetGameCompute(shadow);
+
+    shadow.BeginWork();
+    shadow.SetRootSignature(Shadow::Compute, Signature(0x30));
+
+    CHECK_EQ(shadow.EndWork(nullptr, writer, RestoreAll), 0u);
+    CHECK(Calls({}));
+}
+
+TEST_CASE(HeapChangeRebindsTables)
+{
+    Shadow shadow;
+    SetGameCompute(shadow);
+
+    auto heap = Heap(0x11);
+
+    shadow.BeginWork();
+    shadow.SetDescriptorHeaps(1, &heap);
+    shadow.SetPipelineState(Pso(0x21));
+
+    CHECK_EQ(shadow.EndWork(nullptr, writer, StateShadowRestore_Compute), 3u);
+    CHECK(Calls({ "heaps 1 10", "pso 20", "table0 0 100" }));
+}
+
+TEST_CASE(TopologyOnlyWithGraphicsMask)
+{
+    Shadow shadow;
+    shadow.Reset(nullptr);
+    shadow.SetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+    shadow.BeginWork();
+    shadow.SetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_POINTLIST);
+    CHECK_EQ(shadow.EndWork(nullptr, writer, StateShadowRestore_Compute), 0u);
+    CHECK(Calls({}));
+
+    shadow.BeginWork();
+    shadow.SetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_POINTLIST);
+    CHECK_EQ(shadow.EndWork(nullptr, writer, StateShadowRestore_Graphics), 1u);
+    CHECK(Calls({ "topology 4" }));
+}
+
+TEST_CASE(MaskSkipsOtherPipelineAndClearsIt)
+{
+    Shadow shadow;
+    shadow.Reset(nullptr);
+    shadow.SetRootSignature(Shadow::Graphics, Signature(0x40));
+    shadow.SetRootView(Shadow::Graphics, 0, Shadow::ArgumentType::SRV, 0x700);
+
+    shadow.BeginWork();
+    shadow.SetRootView(Shadow::Graphics, 0, Shadow::ArgumentType::SRV, 0x800);
+    CHECK_EQ(shadow.EndWork(nullptr, writer, StateShadowRestore_Compute), 0u);
+
+    // Dirty flags are cleared either way, the next restore doesn't repeat it
+    shadow.BeginWork();
+    CHECK_EQ(shadow.EndWork(nullptr, writer, RestoreAll), 0u);
+    CHECK(Calls({}));
+
+    CHECK_EQ(shadow.GetPipeline(Shadow::Graphics).dirtyMask, 0ull);
+}
+
+TEST_CASE(OutermostWorkRestores)
+{
+    Shadow shadow;
+    SetGameCompute(shadow);
+
+    shadow.BeginWork();
+    shadow.BeginWork();
+    shadow.SetRootView(Shadow::Compute, 2, Shadow::ArgumentType::UAV, 0x900);
+
+    CHECK_EQ(shadow.EndWork(nullptr, writer, RestoreAll), 0u);
+    CHECK(shadow.InWork());
+    CHECK(Calls({}));
+
+    CHECK_EQ(shadow.EndWork(nullptr, writer, RestoreAll), 1u);
+    CHECK(!shadow.InWork());
+    CHECK(Calls({ "cbv0 2 500" }));
+}
+
+TEST_CASE(UnknownGameStateIsNotRestored)
+{
+    // Shadow created by the first work on the list, the game's earlier calls were not seen
+    Shadow shadow;
+    auto heap = Heap(0x11);
+
+    shadow.BeginWork();
+    shadow.SetDescriptorHeaps(1, &heap);
+    shadow.SetPipelineState(Pso(0x21));
+    shadow.SetRootSignature(Shadow::Compute, Signature(0x31));
+    shadow.SetRootView(Shadow::Compute, 0, Shadow::ArgumentType::CBV, 0x900);
+
+    CHECK_EQ(shadow.EndWork(nullptr, writer, RestoreAll), 0u);
+    CHECK(Calls({}));
+}
+
+TEST_CASE(ArgumentsOfOldSignatureAreDropped)
+{
+    Shadow shadow;
+    SetGameCompute(shadow);
+
+    // New signature, only the table is set for it
+    shadow.SetRootSignature(Shadow::Compute, Signature(0x32));
+    shadow.SetRootDescriptorTable(Shadow::Compute, 0, { 0x300 });
+
+    shadow.BeginWork();
+    shadow.SetRootSignature(Shadow::Compute, Signature(0x31));
+
+    CHECK_EQ(shadow.EndWork(nullptr, writer, RestoreAll), 2u);
+    CHECK(Calls({ "signature0 32", "table0 0 300" }));
+}
+
+TEST_CASE(ResetForgetsGameState)
+{
+    Shadow shadow;
+    SetGameCompute(shadow);
+
+    shadow.Reset(Pso(0x22));
+
+    auto heap = Heap(0x11);
+
+    shadow.BeginWork();
+    shadow.SetDescriptorHeaps(1, &heap);
+    shadow.SetPipelineState(Pso(0x21));
+    shadow.SetRootSignature(Shadow::Compute, Signature(0x31));
+
+    // Only the initial pipeline state of the reset is known
+    CHECK_EQ(shadow.EndWork(nullptr, writer, RestoreAll), 1u);
+    CHECK(Calls({ "pso 22" }));
+}
+
+TEST_CASE(NoneMaskRestoresNothing)
+{
+    Shadow shadow;
+    SetGameCompute(shadow);
+
+    auto heap = Heap(0x11);
+
+    shadow.BeginWork();
+    shadow.SetDescriptorHeaps(1, &heap);
+    shadow.SetRootSignature(Shadow::Compute, Signature(0x31));
+
+    CHECK_EQ(shadow.EndWork(nullptr, writer, StateShadowRestore_None), 0u);
+    CHECK(Calls({}));
+}
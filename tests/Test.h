@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+// Minimal self registering test cases, each test file is linked with TestMain.cpp into its own executable
+struct TestCase
+{
+    const char* name;
+    void (*function)();
+};
+
+inline std::vector<TestCase>& TestCases()
+{
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+inline int& TestFailures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+struct TestRegistrar
+{
+    TestRegistrar(const char* name, void (*function)()) { TestCases().push_back({ name, function }); }
+};
+
+#define TEST_CASE(name)                                                                                                \
+    static void name();                                                                                                \
+    static TestRegistrar name##_Registrar(#name, name);                                                                \
+    static void name()
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr);                                       \
+            TestFailures()++;                                                                                          \
+        }                                                                                                              \
+    } while (false)
+
+#define CHECK_EQ(a, b) CHECK((a) == (b))
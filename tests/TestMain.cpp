@@ -0,0 +1,15 @@
+#include "Test.h"
+
+int main()
+{
+    for (const auto& test : TestCases())
+    {
+        auto before = TestFailures();
+        test.function();
+
+        std::printf("%s %s\n", TestFailures() == before ? "[ OK ]" : "[FAIL]", test.name);
+    }
+
+    std::printf("%zu tests, %d failed checks\n", TestCases().size(), TestFailures());
+    return TestFailures() == 0 ? 0 : 1;
+}
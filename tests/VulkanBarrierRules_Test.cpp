@@ -0,0 +1,206 @@
+#include "Test.h"
+
+#include <hooks/Vulkan_BarrierRules.h>
+
+static constexpr int DlssgPresentRule = 0;
+static constexpr int DlssRule = 1;
+
+static VkImageMemoryBarrier Barrier(VkImageLayout oldLayout, VkImageLayout newLayout,
+                                    VkAccessFlags srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+                                    VkAccessFlags dstAccessMask = VK_ACCESS_SHADER_READ_BIT)
+{
+    VkImageMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = srcAccessMask;
+    barrier.dstAccessMask = dstAccessMask;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.image = reinterpret_cast<VkImage>(0x1000);
+
+    return barrier;
+}
+
+static flag_set<GameQuirk> BarrierFixup()
+{
+    flag_set<GameQuirk> quirks;
+    quirks |= GameQuirk::VulkanDLSSBarrierFixup;
+    return quirks;
+}
+
+static int Match(VkBarrierMatcher& matcher, const std::vector<VkImageMemoryBarrier>& barriers,
+                 VkPipelineStageFlags srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
+                 VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT)
+{
+    return matcher.Match(srcStageMask, dstStageMask, (uint32_t) barriers.size(), barriers.data());
+}
+
+// Copy of the DLSS-G output to the swapchain image
+static std::vector<VkImageMemoryBarrier> DlssgPresentBarriers()
+{
+    return { Barrier(VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL),
+             Barrier(VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) };
+}
+
+static std::vector<VkImageMemoryBarrier> DlssBarriers()
+{
+    return { Barrier(VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL),
+             Barrier(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_GENERAL),
+             Barrier(VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL),
+             Barrier(VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL) };
+}
+
+TEST_CASE(DlssgPresentIsRewritten)
+{
+    VkBarrierMatcher matcher(VkBarrierMatcher::DefaultRules());
+    matcher.Compile(BarrierFixup(), false, false);
+
+    auto barriers = DlssgPresentBarriers();
+    CHECK(matcher.MightMatch(2));
+    CHECK_EQ(Match(matcher, barriers), DlssgPresentRule);
+    CHECK_EQ(matcher.HitCount(DlssgPresentRule), 1u);
+
+    auto& rule = matcher.Rule(DlssgPresentRule);
+    CHECK(rule.action == VkBarrierRuleAction::Rewrite);
+
+    // Only the old layout of the second barrier changes
+    VkImageMemoryBarrier result[VkBarrierRule::MaxBarriers] {};
+    VkBarrierMatcher::ApplyRewrite(rule, barriers.data(), result);
+
+    CHECK(result[0].oldLayout == VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+    CHECK(result[0].newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    CHECK(result[1].oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    CHECK(result[1].newLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+    CHECK(result[1].srcAccessMask == barriers[1].srcAccessMask && result[1].image == barriers[1].image);
+
+    // Another layout in either barrier isn't this copy
+    barriers[1].oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+    CHECK_EQ(Match(matcher, barriers), -1);
+
+    barriers = DlssgPresentBarriers();
+    barriers[0].newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    CHECK_EQ(Match(matcher, barriers), -1);
+    CHECK_EQ(matcher.HitCount(DlssgPresentRule), 1u);
+}
+
+TEST_CASE(DlssBarriersAreDropped)
+{
+    VkBarrierMatcher matcher(VkBarrierMatcher::DefaultRules());
+    matcher.Compile(BarrierFixup(), false, false);
+
+    auto barriers = DlssBarriers();
+    CHECK_EQ(Match(matcher, barriers), DlssRule);
+    CHECK(matcher.Rule(DlssRule).action == VkBarrierRuleAction::Drop);
+
+    // Second barrier isn't checked, any stage matches
+    barriers[1].oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    CHECK_EQ(Match(matcher, barriers, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT),
+             DlssRule);
+
+    // All others have to come from undefined
+    barriers[3].oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+    CHECK_EQ(Match(matcher, barriers), -1);
+    CHECK_EQ(matcher.HitCount(DlssRule), 2u);
+}
+
+TEST_CASE(RulesFollowQuirksAndGpu)
+{
+    VkBarrierMatcher matcher(VkBarrierMatcher::DefaultRules());
+
+    // Nothing active before the first compile
+    CHECK_EQ(matcher.ActiveRuleCount(), 0u);
+    CHECK_EQ(Match(matcher, DlssBarriers()), -1);
+
+    // Without the quirk
+    matcher.Update({}, false, false);
+    CHECK_EQ(matcher.ActiveRuleCount(), 0u);
+    CHECK(!matcher.MightMatch(2) && !matcher.MightMatch(4));
+
+    // Turing and newer handle undefined layouts like the games expect
+    matcher.Update(BarrierFixup(), true, false);
+    CHECK_EQ(matcher.ActiveRuleCount(), 0u);
+    CHECK_EQ(Match(matcher, DlssgPresentBarriers()), -1);
+
+    matcher.Update(BarrierFixup(), true, true);
+    CHECK_EQ(matcher.ActiveRuleCount(), 2u);
+    CHECK_EQ(Match(matcher, DlssgPresentBarriers()), DlssgPresentRule);
+
+    matcher.Update(BarrierFixup(), false, false);
+    CHECK_EQ(matcher.ActiveRuleCount(), 2u);
+    CHECK(matcher.MightMatch(2) && matcher.MightMatch(4));
+}
+
+TEST_CASE(NoMatchFastPath)
+{
+    VkBarrierMatcher matcher(VkBarrierMatcher::DefaultRules());
+    matcher.Compile(BarrierFixup(), false, false);
+
+    // Barrier counts no rule has are rejected by the mask
+    for (uint32_t count : { 0u, 1u, 3u, 5u, 8u, 63u, 64u, 1000u })
+        CHECK(!matcher.MightMatch(count));
+
+    std::vector<VkImageMemoryBarrier> barriers(3, Barrier(VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL));
+    CHECK_EQ(Match(matcher, barriers), -1);
+    CHECK_EQ(Match(matcher, {}), -1);
+
+    // Counts past the mask and missing barriers
+    CHECK_EQ(matcher.Match(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 100, barriers.data()), -1);
+    CHECK_EQ(matcher.Match(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 2, nullptr), -1);
+
+    CHECK_EQ(matcher.HitCount(DlssgPresentRule) + matcher.HitCount(DlssRule), 0u);
+}
+
+// Stage and access patterns aren't used by the default rules
+static const VkBarrierRule TestRules[] = {
+    {
+        .name = "Invalid",
+        .imageBarrierCount = 0,
+        .action = VkBarrierRuleAction::Drop,
+    },
+    {
+        .name = "Compute to fragment",
+        .imageBarrierCount = 1,
+        .srcStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        .dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        .match = { { { .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT } } },
+        .action = VkBarrierRuleAction::Rewrite,
+        .rewrite = { { { .dstAccessMask = VK_ACCESS_MEMORY_READ_BIT } } },
+    },
+    {
+        .name = "Any single barrier",
+        .imageBarrierCount = 1,
+        .action = VkBarrierRuleAction::PassThrough,
+    },
+    {
+        .name = "Too many",
+        .imageBarrierCount = VkBarrierRule::MaxBarriers + 1,
+        .action = VkBarrierRuleAction::Drop,
+    },
+};
+
+TEST_CASE(StageAndAccessPatterns)
+{
+    VkBarrierMatcher matcher(TestRules);
+    matcher.Compile({}, true, false);
+
+    // Rules with invalid barrier counts are skipped
+    CHECK_EQ(matcher.ActiveRuleCount(), 2u);
+    CHECK(!matcher.MightMatch(0) && !matcher.MightMatch(VkBarrierRule::MaxBarriers + 1));
+
+    std::vector<VkImageMemoryBarrier> barriers { Barrier(VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL) };
+
+    CHECK_EQ(Match(matcher, barriers, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT), 1);
+
+    VkImageMemoryBarrier result {};
+    VkBarrierMatcher::ApplyRewrite(matcher.Rule(1), barriers.data(), &result);
+    CHECK(result.srcAccessMask == VK_ACCESS_SHADER_WRITE_BIT && result.dstAccessMask == VK_ACCESS_MEMORY_READ_BIT);
+    CHECK(result.oldLayout == VK_IMAGE_LAYOUT_GENERAL);
+
+    // First rule that matches wins, the catch all only gets the rest
+    CHECK_EQ(Match(matcher, barriers, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT), 2);
+
+    barriers[0].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    CHECK_EQ(Match(matcher, barriers, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT), 2);
+
+    CHECK_EQ(matcher.HitCount(1), 1u);
+    CHECK_EQ(matcher.HitCount(2), 2u);
+}
@@ -0,0 +1,285 @@
+#include "Test.h"
+
+#include <spoofing/Vulkan_SpoofingTables.h>
+
+#include <string_view>
+
+static VkExtensionProperties Extension(const char* name, uint32_t version = 1)
+{
+    VkExtensionProperties properties {};
+    std::strncpy(properties.extensionName, name, VK_MAX_EXTENSION_NAME_SIZE - 1);
+    properties.specVersion = version;
+
+    return properties;
+}
+
+static bool Same(const std::vector<const char*>& names, std::initializer_list<std::string_view> expected)
+{
+    if (names.size() != expected.size())
+        return false;
+
+    size_t i = 0;
+
+    for (auto name : expected)
+    {
+        if (name != names[i++])
+            return false;
+    }
+
+    return true;
+}
+
+static size_t CountOf(const std::vector<const char*>& names, std::string_view name)
+{
+    return std::ranges::count_if(names, [name](const char* entry) { return name == entry; });
+}
+
+TEST_CASE(InternReturnsSamePointer)
+{
+    std::string first = "VK_KHR_swapchain";
+    std::string second = "VK_KHR_swapchain";
+
+    auto a = VulkanExtensionSet::Intern(first);
+    auto b = VulkanExtensionSet::Intern(second);
+
+    CHECK(a == b);
+    CHECK(a != first.c_str());
+    CHECK(std::string_view(a) == "VK_KHR_swapchain");
+}
+
+TEST_CASE(SetIsSortedAndUnique)
+{
+    const char* names[] = { "VK_B", "VK_A", nullptr, "VK_C", "VK_A" };
+
+    VulkanExtensionSet set;
+    set.Assign(names);
+
+    CHECK_EQ(set.Size(), 3u);
+    CHECK(set.Contains("VK_A"));
+    CHECK(set.Contains("VK_B"));
+    CHECK(set.Contains("VK_C"));
+    CHECK(!set.Contains("VK_"));
+    CHECK(!set.Contains("VK_AA"));
+    CHECK(!set.Contains(""));
+
+    VulkanExtensionSet empty;
+    CHECK(empty.Empty());
+    CHECK(!empty.Contains("VK_A"));
+}
+
+TEST_CASE(SetFromPropertiesIsBounded)
+{
+    // Driver gave a name which fills the whole array without a terminator
+    VkExtensionProperties properties[2] {};
+    std::memset(properties[0].extensionName, 'x', VK_MAX_EXTENSION_NAME_SIZE);
+    properties[1] = Extension("VK_KHR_swapchain");
+
+    VulkanExtensionSet set;
+    set.Assign(std::span<const VkExtensionProperties>(properties));
+
+    CHECK_EQ(set.Size(), 2u);
+    CHECK(set.Contains("VK_KHR_swapchain"));
+    CHECK(set.Contains(std::string(VK_MAX_EXTENSION_NAME_SIZE, 'x')));
+}
+
+TEST_CASE(RulesAreAddedByNeeds)
+{
+    const char* available[] = { VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_EXTENSION_NAME,
+                                VK_NV_LOW_LATENCY_EXTENSION_NAME,
+                                VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME,
+                                VK_EXT_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME,
+                                VK_NVX_BINARY_IMPORT_EXTENSION_NAME,
+                                VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME,
+                                VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME };
+
+    VulkanExtensionSet set;
+    set.Assign(available);
+
+    const char* requested[] = { "VK_KHR_swapchain" };
+    auto rules = VulkanSpoofingTables::DeviceExtensionRules();
+
+    auto none = VulkanSpoofingTables::BuildExtensionList(requested, rules, set, VulkanExtension_None, false);
+    CHECK(Same(none, { "VK_KHR_swapchain" }));
+
+    // Pre Turing, the NVX handle extensions are left out
+    auto nvngx = VulkanSpoofingTables::BuildExtensionList(requested, rules, set, VulkanExtension_Nvngx, false);
+    CHECK(Same(nvngx, { "VK_KHR_swapchain", VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_EXTENSION_NAME,
+                        VK_NV_LOW_LATENCY_EXTENSION_NAME, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME,
+                        VK_EXT_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME }));
+
+    auto turing = VulkanSpoofingTables::BuildExtensionList(requested, rules, set,
+                                                           VulkanExtension_Nvngx | VulkanExtension_NvngxTuring, false);
+    CHECK_EQ(turing.size(), 7u);
+    CHECK_EQ(CountOf(turing, VK_NVX_BINARY_IMPORT_EXTENSION_NAME), 1u);
+
+    // XeSS extensions aren't available on this driver
+    auto xess = VulkanSpoofingTables::BuildExtensionList(requested, rules, set, VulkanExtension_XeSS, false);
+    CHECK(Same(xess, { "VK_KHR_swapchain" }));
+}
+
+TEST_CASE(RequestedNamesAreNotDuplicated)
+{
+    const char* available[] = { VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME };
+
+    VulkanExtensionSet set;
+    set.Assign(available);
+
+    const char* requested[] = { VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME };
+
+    auto list = VulkanSpoofingTables::BuildExtensionList(requested, VulkanSpoofingTables::DeviceExtensionRules(),
+                                                         set, VulkanExtension_Ffx, false);
+
+    CHECK(Same(list, { VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME }));
+}
+
+TEST_CASE(SpoofedNamesAreStripped)
+{
+    // Game asked for what we advertised, the driver doesn't have it
+    const char* requested[] = { "VK_KHR_swapchain", VK_NVX_BINARY_IMPORT_EXTENSION_NAME,
+                                VK_NV_LOW_LATENCY_EXTENSION_NAME };
+
+    const char* available[] = { "VK_KHR_swapchain", VK_NV_LOW_LATENCY_EXTENSION_NAME };
+
+    VulkanExtensionSet set;
+    set.Assign(available);
+
+    auto rules = VulkanSpoofingTables::DeviceExtensionRules();
+
+    auto stripped = VulkanSpoofingTables::BuildExtensionList(requested, rules, set, VulkanExtension_None, true);
+    CHECK(Same(stripped, { "VK_KHR_swapchain" }));
+
+    // Stripped name comes back once when it is needed and the driver has it
+    auto needed = VulkanSpoofingTables::BuildExtensionList(requested, rules, set, VulkanExtension_Nvngx, true);
+    CHECK(Same(needed, { "VK_KHR_swapchain", VK_NV_LOW_LATENCY_EXTENSION_NAME }));
+
+    // Without stripping the request is passed as is
+    auto kept = VulkanSpoofingTables::BuildExtensionList(requested, rules, set, VulkanExtension_Nvngx, false);
+    CHECK(Same(kept, { "VK_KHR_swapchain", VK_NVX_BINARY_IMPORT_EXTENSION_NAME, VK_NV_LOW_LATENCY_EXTENSION_NAME }));
+}
+
+TEST_CASE(InstanceRules)
+{
+    const char* available[] = { VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME,
+                                VK_EXT_DEBUG_UTILS_EXTENSION_NAME };
+
+    VulkanExtensionSet set;
+    set.Assign(available);
+
+    auto list = VulkanSpoofingTables::BuildExtensionList({}, VulkanSpoofingTables::InstanceExtensionRules(), set,
+                                                         VulkanExtension_Nvngx | VulkanExtension_Ffx, false);
+
+    CHECK(Same(list, { VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME, VK_EXT_DEBUG_UTILS_EXTENSION_NAME }));
+}
+
+TEST_CASE(AdvertisedListAppendsMissing)
+{
+    VkExtensionProperties driver[] = { Extension("VK_KHR_swapchain"),
+                                       Extension(VK_NV_LOW_LATENCY_EXTENSION_NAME, 7) };
+
+    auto advertised = VulkanSpoofingTables::BuildAdvertisedExtensions(driver);
+    auto spoofed = VulkanSpoofingTables::SpoofedDeviceExtensions();
+
+    // Driver entries first and unchanged, the one it has isn't added again
+    CHECK_EQ(advertised.size(), 2 + spoofed.size() - 1);
+    CHECK(std::string_view(advertised[0].extensionName) == "VK_KHR_swapchain");
+    CHECK_EQ(advertised[1].specVersion, 7u);
+
+    size_t lowLatency = 0;
+
+    for (auto& extension : advertised)
+    {
+        if (std::string_view(extension.extensionName) == VK_NV_LOW_LATENCY_EXTENSION_NAME)
+            lowLatency++;
+    }
+
+    CHECK_EQ(lowLatency, 1u);
+    CHECK(VulkanSpoofingTables::IsSpoofedDeviceExtension(VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME));
+    CHECK(!VulkanSpoofingTables::IsSpoofedDeviceExtension("VK_KHR_swapchain"));
+}
+
+TEST_CASE(CopyFollowsEnumerateSemantics)
+{
+    VkExtensionProperties list[] = { Extension("VK_A"), Extension("VK_B"), Extension("VK_C") };
+
+    uint32_t count = 0;
+    CHECK_EQ(VulkanSpoofingTables::CopyExtensions(list, &count, nullptr), VK_SUCCESS);
+    CHECK_EQ(count, 3u);
+
+    VkExtensionProperties output[3] {};
+
+    count = 2;
+    CHECK_EQ(VulkanSpoofingTables::CopyExtensions(list, &count, output), VK_INCOMPLETE);
+    CHECK_EQ(count, 2u);
+    CHECK(std::string_view(output[1].extensionName) == "VK_B");
+    CHECK_EQ(output[2].extensionName[0], '\0');
+
+    count = 5;
+    CHECK_EQ(VulkanSpoofingTables::CopyExtensions(list, &count, output), VK_SUCCESS);
+    CHECK_EQ(count, 3u);
+    CHECK(std::string_view(output[2].extensionName) == "VK_C");
+
+    CHECK_EQ(VulkanSpoofingTables::CopyExtensions(list, nullptr, output), VK_ERROR_INITIALIZATION_FAILED);
+}
+
+TEST_CASE(PolicyTargets)
+{
+    VulkanSpoofingPolicy policy {};
+
+    CHECK(!VulkanSpoofingTables::PolicyMatches(policy, 0x1002, 0x73bf));
+
+    policy.enabled = true;
+    CHECK(VulkanSpoofingTables::PolicyMatches(policy, 0x1002, 0x73bf));
+
+    policy.targetVendorId = 0x8086;
+    CHECK(!VulkanSpoofingTables::PolicyMatches(policy, 0x1002, 0x73bf));
+    CHECK(VulkanSpoofingTables::PolicyMatches(policy, 0x8086, 0x56a0));
+
+    policy.targetDeviceId = 0x56a1;
+    CHECK(!VulkanSpoofingTables::PolicyMatches(policy, 0x8086, 0x56a0));
+    CHECK(VulkanSpoofingTables::PolicyMatches(policy, 0x8086, 0x56a1));
+}
+
+TEST_CASE(PropertiesAreSpoofed)
+{
+    VkPhysicalDeviceProperties original {};
+    original.vendorID = 0x1002;
+    original.deviceID = 0x73bf;
+    original.driverVersion = 123;
+    original.apiVersion = VK_MAKE_API_VERSION(0, 1, 3, 0);
+    std::strcpy(original.deviceName, "AMD Radeon RX 6800 XT");
+
+    VulkanSpoofingPolicy policy {};
+    policy.enabled = true;
+    policy.vendorId = 0x10de;
+    policy.deviceId = 0x2684;
+    policy.name = "NVIDIA GeForce RTX 4090";
+
+    auto spoofed = VulkanSpoofingTables::SpoofProperties(original, policy);
+
+    CHECK_EQ(spoofed.vendorID, 0x10deu);
+    CHECK_EQ(spoofed.deviceID, 0x2684u);
+    CHECK_EQ(spoofed.driverVersion, VK_MAKE_API_VERSION(999, 99, 0, 0));
+    CHECK_EQ(spoofed.apiVersion, original.apiVersion);
+    CHECK(std::string_view(spoofed.deviceName) == "NVIDIA GeForce RTX 4090");
+
+    // Other GPU in the system is left alone
+    policy.targetVendorId = 0x8086;
+    auto untouched = VulkanSpoofingTables::SpoofProperties(original, policy);
+
+    CHECK_EQ(untouched.vendorID, 0x1002u);
+    CHECK(std::string_view(untouched.deviceName) == "AMD Radeon RX 6800 XT");
+}
+
+TEST_CASE(LongNameIsTruncated)
+{
+    VkPhysicalDeviceProperties original {};
+
+    VulkanSpoofingPolicy policy {};
+    policy.enabled = true;
+    policy.name = std::string(VK_MAX_PHYSICAL_DEVICE_NAME_SIZE + 10, 'n');
+
+    auto spoofed = VulkanSpoofingTables::SpoofProperties(original, policy);
+    auto length = strnlen(spoofed.deviceName, VK_MAX_PHYSICAL_DEVICE_NAME_SIZE);
+
+    CHECK_EQ(length, static_cast<size_t>(VK_MAX_PHYSICAL_DEVICE_NAME_SIZE - 1));
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+// Stand-in for the simpleini submodule with the calls the config code makes.
+// Sections and keys are case insensitive and keep their order like CSimpleIniA.
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <strings.h>
+#include <utility>
+#include <vector>
+
+enum SI_Error
+{
+    SI_OK = 0,
+    SI_FAIL = -1,
+};
+
+class CSimpleIniA
+{
+    struct Section
+    {
+        std::string name;
+        std::vector<std::pair<std::string, std::string>> values;
+    };
+
+    std::vector<Section> _sections;
+
+    static std::string_view Trim(std::string_view text)
+    {
+        while (!text.empty() && (text.front() == ' ' || text.front() == '\t' || text.front() == '\r'))
+            text.remove_prefix(1);
+
+        while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r'))
+            text.remove_suffix(1);
+
+        return text;
+    }
+
+    Section* FindSection(const char* name)
+    {
+        for (auto& section : _sections)
+        {
+            if (strcasecmp(section.name.c_str(), name) == 0)
+                return &section;
+        }
+
+        return nullptr;
+    }
+
+    const Section* FindSection(const char* name) const { return const_cast<CSimpleIniA*>(this)->FindSection(name); }
+
+  public:
+    SI_Error LoadData(const char* data, size_t size)
+    {
+        std::string_view text(data, size);
+        Section* current = nullptr;
+
+        while (!text.empty())
+        {
+            auto end = text.find('\n');
+            auto line = Trim(text.substr(0, end));
+            text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+            if (line.empty() || line.front() == ';' || line.front() == '#')
+                continue;
+
+            if (line.front() == '[')
+            {
+                auto close = line.find(']');
+
+                if (close == std::string_view::npos)
+                    return SI_FAIL;
+
+                auto name = std::string(Trim(line.substr(1, close - 1)));
+                current = FindSection(name.c_str());
+
+                if (current == nullptr)
+                    current = &_sections.emplace_back(Section { name, {} });
+
+                continue;
+            }
+
+            auto equals = line.find('=');
+
+            if (equals == std::string_view::npos || current == nullptr)
+                continue;
+
+            auto key = std::string(Trim(line.substr(0, equals)));
+            SetValue(current->name.c_str(), key.c_str(), std::string(Trim(line.substr(equals + 1))).c_str());
+        }
+
+        return SI_OK;
+    }
+
+    const char* GetValue(const char* section, const char* key, const char* defaultValue = nullptr) const
+    {
+        auto found = FindSection(section);
+
+        if (found == nullptr)
+            return defaultValue;
+
+        for (const auto& [name, value] : found->values)
+        {
+            if (strcasecmp(name.c_str(), key) == 0)
+                return value.c_str();
+        }
+
+        return defaultValue;
+    }
+
+    SI_Error SetValue(const char* section, const char* key, const char* value)
+    {
+        auto found = FindSection(section);
+
+        if (found == nullptr)
+            found = &_sections.emplace_back(Section { section, {} });
+
+        for (auto& [name, existing] : found->values)
+        {
+            if (strcasecmp(name.c_str(), key) == 0)
+            {
+                existing = value;
+                return SI_OK;
+            }
+        }
+
+        found->values.emplace_back(key, value);
+        return SI_OK;
+    }
+
+    SI_Error Save(std::string& output) const
+    {
+        for (const auto& section : _sections)
+        {
+            output += "[" + section.name + "]\n";
+
+            for (const auto& [name, value] : section.values)
+                output += name + " = " + value + "\n";
+
+            output += "\n";
+        }
+
+        return SI_OK;
+    }
+};
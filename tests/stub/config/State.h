@@ -0,0 +1,45 @@
+#pragma once
+
+// Stand-in for OptiScaler/State.h, only the enums Config.h uses and the api the reload checks
+
+#include <cstdint>
+
+enum class FGInput : uint32_t
+{
+    NoFG,
+    Nukems,
+    FSRFG,
+    DLSSG,
+    XeFG,
+    Upscaler,
+    FSRFG30
+};
+
+enum class FGOutput : uint32_t
+{
+    NoFG,
+    Nukems,
+    FSRFG,
+    DLSSG,
+    XeFG
+};
+
+typedef enum API
+{
+    NotSelected = 0,
+    DX11,
+    DX12,
+    Vulkan,
+} API;
+
+class State
+{
+  public:
+    static State& Instance()
+    {
+        static State instance;
+        return instance;
+    }
+
+    API api = API::NotSelected;
+};
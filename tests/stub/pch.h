@@ -0,0 +1,86 @@
+#pragma once
+
+// Stand-in for OptiScaler/pch.h so the pure pieces build without the Windows SDK and submodules.
+// Only what those pieces use is declared, logging is compiled out.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#define BUFFER_COUNT 4
+
+// Real gate, only the macros are compiled out
+#include <LogGate.h>
+
+#define LOG_CATEGORY LogCategory::General
+
+#define LOG_TRACE(msg, ...) ((void) 0)
+#define LOG_DEBUG(msg, ...) ((void) 0)
+#define LOG_DEBUG_ONLY(msg, ...) ((void) 0)
+#define LOG_DEBUG_ASYNC(msg, ...) ((void) 0)
+#define LOG_INFO(msg, ...) ((void) 0)
+#define LOG_WARN(msg, ...) ((void) 0)
+#define LOG_ERROR(msg, ...) ((void) 0)
+#define LOG_FUNC() ((void) 0)
+#define LOG_FUNC_RESULT(result) ((void) 0)
+
+#ifndef _WIN32
+#include <strings.h>
+
+typedef uint32_t UINT;
+typedef uint64_t UINT64;
+typedef uint32_t DWORD;
+typedef int32_t HRESULT;
+typedef int32_t LONG;
+typedef size_t SIZE_T;
+typedef wchar_t WCHAR;
+typedef void* HANDLE;
+
+struct LUID
+{
+    DWORD LowPart;
+    LONG HighPart;
+};
+
+// Menu shortcut defaults in Config.h
+#define VK_PRIOR 0x21
+#define VK_NEXT 0x22
+#define VK_END 0x23
+#define VK_INSERT 0x2D
+
+inline int _stricmp(const char* a, const char* b) { return strcasecmp(a, b); }
+inline int _strnicmp(const char* a, const char* b, size_t count) { return strncasecmp(a, b, count); }
+#endif
+
+namespace VendorId
+{
+enum Value : uint32_t
+{
+    Invalid = 0,
+    Microsoft = 0x1414, // Software Render Adapter
+    Nvidia = 0x10DE,
+    AMD = 0x1002,
+    Intel = 0x8086,
+};
+};
+
+// Real ones convert through UTF-8, the tests only use ASCII
+inline static std::string wstring_to_string(const std::wstring& wide_str)
+{
+    std::string result;
+
+    for (auto c : wide_str)
+        result += (char) c;
+
+    return result;
+}
+
+inline static std::wstring string_to_wstring(const std::string& str) { return std::wstring(str.begin(), str.end()); }
+
+inline static void to_lower_in_place(std::string& string)
+{
+    std::transform(string.begin(), string.end(), string.begin(), ::tolower);
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+// Real one only adds the platform headers on top of the core API
+#include "vulkan_core.h"
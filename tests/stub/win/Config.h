@@ -0,0 +1,23 @@
+#pragma once
+
+// Options read by the pieces under test, set directly by the tests
+
+struct FakeOption
+{
+    bool value;
+
+    bool value_or_default() const { return value; }
+};
+
+class Config
+{
+  public:
+    FakeOption RestoreComputeSignature { true };
+    FakeOption RestoreGraphicSignature { true };
+
+    static Config* Instance()
+    {
+        static Config instance;
+        return &instance;
+    }
+};
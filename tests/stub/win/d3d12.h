@@ -0,0 +1,167 @@
+#pragma once
+
+// Just enough of d3d12.h for the command list, barrier and resource lifetime pieces. Objects only keep private
+// data like the runtime does, state calls are recorded by the tests through their own writers.
+
+#include "win_types.h"
+
+#include <utility>
+#include <vector>
+
+struct ID3D12DescriptorHeap;
+struct ID3D12PipelineState;
+struct ID3D12RootSignature;
+struct ID3D12CommandAllocator;
+
+typedef UINT64 D3D12_GPU_VIRTUAL_ADDRESS;
+
+struct D3D12_GPU_DESCRIPTOR_HANDLE
+{
+    UINT64 ptr;
+};
+
+enum D3D12_PRIMITIVE_TOPOLOGY
+{
+    D3D_PRIMITIVE_TOPOLOGY_UNDEFINED = 0,
+    D3D_PRIMITIVE_TOPOLOGY_POINTLIST = 1,
+    D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST = 4,
+};
+
+enum D3D12_RESOURCE_STATES
+{
+    D3D12_RESOURCE_STATE_COMMON = 0,
+    D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER = 0x1,
+    D3D12_RESOURCE_STATE_INDEX_BUFFER = 0x2,
+    D3D12_RESOURCE_STATE_RENDER_TARGET = 0x4,
+    D3D12_RESOURCE_STATE_UNORDERED_ACCESS = 0x8,
+    D3D12_RESOURCE_STATE_DEPTH_WRITE = 0x10,
+    D3D12_RESOURCE_STATE_DEPTH_READ = 0x20,
+    D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE = 0x40,
+    D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE = 0x80,
+    D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT = 0x200,
+    D3D12_RESOURCE_STATE_COPY_DEST = 0x400,
+    D3D12_RESOURCE_STATE_COPY_SOURCE = 0x800,
+    D3D12_RESOURCE_STATE_GENERIC_READ = 0x1 | 0x2 | 0x40 | 0x80 | 0x200 | 0x800,
+    D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE = 0x40 | 0x80,
+    D3D12_RESOURCE_STATE_PRESENT = 0,
+};
+
+// DEFINE_ENUM_FLAG_OPERATORS of the SDK
+inline D3D12_RESOURCE_STATES operator&(D3D12_RESOURCE_STATES a, D3D12_RESOURCE_STATES b)
+{
+    return (D3D12_RESOURCE_STATES) ((int) a & (int) b);
+}
+
+inline D3D12_RESOURCE_STATES operator|(D3D12_RESOURCE_STATES a, D3D12_RESOURCE_STATES b)
+{
+    return (D3D12_RESOURCE_STATES) ((int) a | (int) b);
+}
+
+enum D3D12_BARRIER_SYNC
+{
+    D3D12_BARRIER_SYNC_NONE = 0,
+    D3D12_BARRIER_SYNC_ALL = 0x1,
+    D3D12_BARRIER_SYNC_PIXEL_SHADING = 0x10,
+    D3D12_BARRIER_SYNC_DEPTH_STENCIL = 0x20,
+    D3D12_BARRIER_SYNC_RENDER_TARGET = 0x40,
+    D3D12_BARRIER_SYNC_COPY = 0x200,
+    D3D12_BARRIER_SYNC_ALL_SHADING = 0x1000,
+    D3D12_BARRIER_SYNC_NON_PIXEL_SHADING = 0x2000,
+};
+
+enum D3D12_BARRIER_ACCESS
+{
+    D3D12_BARRIER_ACCESS_COMMON = 0,
+    D3D12_BARRIER_ACCESS_RENDER_TARGET = 0x8,
+    D3D12_BARRIER_ACCESS_UNORDERED_ACCESS = 0x10,
+    D3D12_BARRIER_ACCESS_DEPTH_STENCIL_WRITE = 0x20,
+    D3D12_BARRIER_ACCESS_DEPTH_STENCIL_READ = 0x40,
+    D3D12_BARRIER_ACCESS_SHADER_RESOURCE = 0x80,
+    D3D12_BARRIER_ACCESS_COPY_DEST = 0x400,
+    D3D12_BARRIER_ACCESS_COPY_SOURCE = 0x800,
+};
+
+enum D3D12_BARRIER_LAYOUT
+{
+    D3D12_BARRIER_LAYOUT_COMMON = 0,
+    D3D12_BARRIER_LAYOUT_RENDER_TARGET = 2,
+    D3D12_BARRIER_LAYOUT_UNORDERED_ACCESS = 3,
+    D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_WRITE = 4,
+    D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_READ = 5,
+    D3D12_BARRIER_LAYOUT_SHADER_RESOURCE = 6,
+    D3D12_BARRIER_LAYOUT_COPY_SOURCE = 7,
+    D3D12_BARRIER_LAYOUT_COPY_DEST = 8,
+};
+
+// Private data store of the runtime objects, interfaces are released with the object
+struct FakePrivateData
+{
+    std::vector<std::pair<GUID, IUnknown*>> privateData;
+
+    FakePrivateData() = default;
+    FakePrivateData(const FakePrivateData&) = delete;
+    FakePrivateData& operator=(const FakePrivateData&) = delete;
+
+    virtual ~FakePrivateData()
+    {
+        for (auto& [guid, data] : privateData)
+            data->Release();
+    }
+
+    HRESULT GetPrivateData(REFGUID guid, UINT* size, void* data)
+    {
+        for (auto& [key, value] : privateData)
+        {
+            if (key == guid)
+            {
+                value->AddRef();
+                *(IUnknown**) data = value;
+                *size = sizeof(IUnknown*);
+                return S_OK;
+            }
+        }
+
+        return DXGI_ERROR_NOT_FOUND;
+    }
+
+    HRESULT SetPrivateDataInterface(REFGUID guid, IUnknown* data)
+    {
+        if (data != nullptr)
+            data->AddRef();
+
+        for (auto& [key, value] : privateData)
+        {
+            if (key == guid)
+            {
+                value->Release();
+                value = data;
+                return S_OK;
+            }
+        }
+
+        privateData.emplace_back(guid, data);
+        return S_OK;
+    }
+};
+
+struct ID3D12GraphicsCommandList : FakePrivateData
+{
+};
+
+// Reference counted like the runtime's, destroyed with its private data on the last Release
+struct ID3D12Resource : FakePrivateData
+{
+    std::atomic<ULONG> refCount = 1;
+
+    ULONG AddRef() { return ++refCount; }
+
+    ULONG Release()
+    {
+        auto count = --refCount;
+
+        if (count == 0)
+            delete this;
+
+        return count;
+    }
+};
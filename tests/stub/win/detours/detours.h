@@ -0,0 +1,11 @@
+#pragma once
+
+// Hooks are never installed in the tests, only the calls are kept
+
+#include "../win_types.h"
+
+inline long DetourTransactionBegin() { return 0; }
+inline long DetourTransactionCommit() { return 0; }
+inline long DetourUpdateThread(HANDLE) { return 0; }
+template <typename T> inline long DetourAttach(PVOID*, T) { return 0; }
+template <typename T> inline long DetourDetach(PVOID*, T) { return 0; }
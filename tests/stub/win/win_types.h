@@ -0,0 +1,46 @@
+#pragma once
+
+// Windows and COM basics used by the D3D12 pieces, only on the include path off Windows
+
+#include <atomic>
+#include <cstdint>
+
+typedef uint32_t UINT;
+typedef uint64_t UINT64;
+typedef uint32_t ULONG;
+typedef uint32_t DWORD;
+typedef int32_t HRESULT;
+typedef void* PVOID;
+typedef void* HANDLE;
+
+#define S_OK ((HRESULT) 0)
+#define E_POINTER ((HRESULT) 0x80004003)
+#define E_NOINTERFACE ((HRESULT) 0x80004002)
+#define DXGI_ERROR_NOT_FOUND ((HRESULT) 0x887A0002)
+#define STDMETHODCALLTYPE
+
+struct GUID
+{
+    uint32_t Data1;
+    uint16_t Data2;
+    uint16_t Data3;
+    uint8_t Data4[8];
+
+    bool operator==(const GUID&) const = default;
+};
+
+typedef const GUID& REFIID;
+typedef const GUID& REFGUID;
+
+struct IUnknown
+{
+    virtual HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) = 0;
+    virtual ULONG STDMETHODCALLTYPE AddRef() = 0;
+    virtual ULONG STDMETHODCALLTYPE Release() = 0;
+};
+
+// Only IUnknown is ever asked for
+template <typename T> constexpr GUID FakeUuidOf() { return { 0, 0, 0, { 0xC0, 0, 0, 0, 0, 0, 0, 0x46 } }; }
+#define __uuidof(type) FakeUuidOf<type>()
+
+inline HANDLE GetCurrentThread() { return nullptr; }